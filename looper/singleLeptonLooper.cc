@@ -9,6 +9,9 @@
 #include "../Tools/msugraCrossSection.h"
 #include "BtagFuncs.h"
 #include "../Tools/pfjetMVAtools.h"
+#include "../macros/Core/MassDB.h"
+#include "../macros/Core/NormCache.h"
+#include "../macros/Core/BinnedTable.h"
 
 //#include "stopUtils.h"
 
@@ -29,6 +32,7 @@ struct SUSYGenParticle { // To be filled with status-3 genParticles
       double pt; // pt [GeV]
       double eta; // eta
       double phi; // phi
+      double mass; // mass [GeV], sqrt(|m^2|)
 };
 
 //--------------------------------------------------------------------
@@ -41,6 +45,55 @@ int getMotherIndex(int motherid){
   return -1;
 }
 
+// status-3 gen particles, as used for the stop polarization reweighting
+std::vector<SUSYGenParticle> getSUSYGenParticles(){
+  std::vector<SUSYGenParticle> genParticles;
+  for (unsigned int ig=0; ig<genps_id().size(); ++ig) {
+    if( genps_status().at(ig) != 3 ) continue;
+    SUSYGenParticle part;
+    part.pdgId       = genps_id().at(ig);
+    part.energy      = genps_p4().at(ig).E();
+    part.pt          = genps_p4().at(ig).pt();
+    part.eta         = genps_p4().at(ig).eta();
+    part.phi         = genps_p4().at(ig).phi();
+    part.firstMother = getMotherIndex( genps_id_mother().at(ig) );
+    float mass2 = genps_p4().at(ig).mass2();
+    part.mass        = mass2 > 0.0 ? sqrt(mass2) : sqrt(-1*mass2);
+    genParticles.push_back(part);
+  }
+  return genParticles;
+}
+
+// mass point of a signal scan event for the mass database: stop or
+// chargino and LSP mass from the sparms, x for T2bw only (-1 otherwise),
+// the model number (run) for pMSSM
+MassPoint getScanPoint(const TString& prefix){
+  MassPoint point = { -9999, -9999, -1 };
+
+  if( prefix.Contains("T2") ){
+    point.mg = point.ml = -999;
+  }
+  if( prefix.Contains("T2tt") || prefix.Contains("T2bw") ){
+    for (int i=0; i<(int)sparm_values().size(); ++i) {
+      if (sparm_names().at(i).Contains("mstop")) point.mg = sparm_values().at(i);
+      if (sparm_names().at(i).Contains("mlsp")) point.ml = sparm_values().at(i);
+      if (prefix.Contains("T2bw") && sparm_names().at(i).Contains("x")) point.x = (sparm_values().at(i)/100 - point.ml)/(point.mg-point.ml) ;
+    }
+  }
+  else if( prefix.Contains("TChiWH") ){
+    for (int i=0; i<(int)sparm_values().size(); ++i) {
+      if (sparm_names().at(i).Contains("mchargino")) point.mg = sparm_values().at(i);
+      if (sparm_names().at(i).Contains("mlsp")) point.ml = sparm_values().at(i);
+    }
+  }
+  else if( prefix.Contains("pMSSM") ){
+    point.mg = evt_run();
+    point.ml = -1;
+  }
+
+  return point;
+}
+
 // The following reweighting only makes sense for on-shell stop, top and chi0
 // In the off-shell case top and anti-top may get very different polarizations
 double Reweight_Stop_to_TopChi0 (std::vector<SUSYGenParticle> genParticles, double referenceTopPolarization, double requestedTopPolarization, const TString& prefix) {
@@ -655,8 +708,7 @@ void singleLeptonLooper::closeTree()
 
 float singleLeptonLooper::stopPairCrossSection( float stopmass ){
 
-  int   bin  = stop_xsec_hist->FindBin(stopmass);
-  float xsec = stop_xsec_hist->GetBinContent(bin);
+  float xsec = stop_xsec_->value(stopmass);
   return xsec;
 
 }
@@ -665,8 +717,7 @@ float singleLeptonLooper::stopPairCrossSection( float stopmass ){
 
 float singleLeptonLooper::c1n2CrossSection( float c1mass ){
 
-  int   bin  = c1n2_xsec_hist->FindBin(c1mass);
-  float xsec = c1n2_xsec_hist->GetBinContent(bin);
+  float xsec = c1n2_xsec_->value(c1mass);
   return xsec;
 
 }
@@ -675,8 +726,7 @@ float singleLeptonLooper::c1n2CrossSection( float c1mass ){
 
 float singleLeptonLooper::pmssmCrossSection( int run ){
 
-  int   bin  = pmssm_xsec_hist->FindBin(run);
-  float xsec = pmssm_xsec_hist->GetBinContent(bin);
+  float xsec = pmssm_xsec_->value(run);
   return xsec;
 
 }
@@ -878,16 +928,11 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
   // set stop cross section file
   //------------------------------------------------
 
-  stop_xsec_file = TFile::Open("stop_xsec.root");
+  // the cross section hists are copied into flat tables, the per-event
+  //  lookups go through them
+  stop_xsec_ = new BinnedTable(BinnedTable::load("stop_xsec.root", "h_stop_xsec"));
   
-  if( !stop_xsec_file->IsOpen() ){
-    cout << "Error, could not open stop cross section TFile, quitting" << endl;
-    exit(0);
-  }
-  
-  stop_xsec_hist        = (TH1D*) stop_xsec_file->Get("h_stop_xsec");
-  
-  if( stop_xsec_hist == 0 ){
+  if( stop_xsec_->empty() ){
     cout << "Error, could not retrieve stop cross section hist, quitting" << endl;
     exit(0);
   }
@@ -896,16 +941,9 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
   // set c1n2 cross section file
   //------------------------------------------------
 
-  c1n2_xsec_file = TFile::Open("c1n2_xsec.root");
-  
-  if( !c1n2_xsec_file->IsOpen() ){
-    cout << "Error, could not open c1n2 cross section TFile, quitting" << endl;
-    exit(0);
-  }
+  c1n2_xsec_ = new BinnedTable(BinnedTable::load("c1n2_xsec.root", "h_c1n2_xsec"));
   
-  c1n2_xsec_hist        = (TH1F*) c1n2_xsec_file->Get("h_c1n2_xsec");
-  
-  if( c1n2_xsec_hist == 0 ){
+  if( c1n2_xsec_->empty() ){
     cout << "Error, could not retrieve c1n2 cross section hist, quitting" << endl;
     exit(0);
   }
@@ -914,16 +952,9 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
   // set pmssm cross section file
   //------------------------------------------------
 
-  pmssm_xsec_file = TFile::Open("pmssm_xsec.root");
-  
-  if( !pmssm_xsec_file->IsOpen() ){
-    cout << "Error, could not open pmssm cross section TFile, quitting" << endl;
-    exit(0);
-  }
-  
-  pmssm_xsec_hist        = (TH1F*) pmssm_xsec_file->Get("h_pmssm_xsec");
+  pmssm_xsec_ = new BinnedTable(BinnedTable::load("pmssm_xsec.root", "h_pmssm_xsec"));
   
-  if( pmssm_xsec_hist == 0 ){
+  if( pmssm_xsec_->empty() ){
     cout << "Error, could not retrieve pmssm cross section hist, quitting" << endl;
     exit(0);
   }
@@ -999,6 +1030,16 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
 
   if(g_createTree) makeTree(prefix, doFakeApp, frmode);
 
+  // generated events (and polarization weight sums) per mass point of a
+  // signal scan, counted before any selection and stored with the baby
+  bool isScan = prefix.Contains("T2") || prefix.Contains("TChiWH") || prefix.Contains("pMSSM");
+  vector<string> polarizationSums;
+  polarizationSums.push_back("weightleft");
+  polarizationSums.push_back("weightright");
+  MassDB massdb(polarizationSums);
+  // cross section per mass point, looked up on its first event
+  NormCache normCache(prefix.Data());
+
   while((currentFile = (TChainElement*)fileIter.Next())) {
     TFile* f = new TFile(currentFile->GetTitle());
 
@@ -1048,6 +1089,32 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
 
       cms2.GetEntry(z);
 
+      // stop polarization weights, once per event for the mass database
+      // and the baby; 1 for all but T2tt, which is always a scan
+      std::vector<SUSYGenParticle> genParticles;
+      double polarizationLeft = 1.0, polarizationRight = 1.0;
+
+      MassPoint scanPoint = { -9999, -9999, -1 };
+      if( isScan ){
+	scanPoint = getScanPoint(prefix);
+	double ngen = doTenPercent ? 10. : 1.;
+	if( prefix.Contains("T2tt") ){
+	  genParticles = getSUSYGenParticles();
+	  polarizationLeft  = Reweight_Stop_to_TopChi0 (genParticles, 0., -1, prefix);
+	  polarizationRight = Reweight_Stop_to_TopChi0 (genParticles, 0.,  1, prefix);
+	}
+	double polarization[2] = { ngen * polarizationLeft, ngen * polarizationRight };
+	massdb.fill(scanPoint, ngen, polarization);
+      }
+
+      PointNorm* norm = isScan ? normCache.find(scanPoint) : 0;
+      if( isScan && !norm ){
+	norm = &normCache.insert(scanPoint);
+	if     ( prefix.Contains("T2")     && scanPoint.mg > 0. ) norm->xsec = stopPairCrossSection(scanPoint.mg);
+	else if( prefix.Contains("TChiWH") && scanPoint.mg > 0. ) norm->xsec = c1n2CrossSection(scanPoint.mg);
+	else if( prefix.Contains("pMSSM")  && evt_run() >= 0 )    norm->xsec = pmssmCrossSection(evt_run());
+      }
+
       if( evt_ww_rho_vor() != evt_ww_rho_vor() ){
 	cout << "Skipping event with rho = nan!!!" << endl;
 	continue;
@@ -1923,39 +1990,22 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
 	// stop reweighting code
 	//------------------------------------------
 
-	std::vector<SUSYGenParticle> genParticles;
-
-	
-	for (unsigned int ig=0; ig<genps_id().size(); ++ig) {
-
-	  if( genps_status().at(ig) != 3 ) continue;
-
-	  SUSYGenParticle part;
-	  part.pdgId       = genps_id().at(ig);
-	  part.energy      = genps_p4().at(ig).E();
-	  part.pt          = genps_p4().at(ig).pt();
-	  part.eta         = genps_p4().at(ig).eta();
-	  part.phi         = genps_p4().at(ig).phi();
-	  part.firstMother = getMotherIndex( genps_id_mother().at(ig) );
-	  genParticles.push_back(part);
+	// status-3 gen particles; the T2tt scans have them from the mass database fill
+	if( !prefix.Contains("T2tt") ) genParticles = getSUSYGenParticles();
 
+	for (unsigned int ig=0; ig<genParticles.size(); ++ig) {
+	  const SUSYGenParticle& part = genParticles[ig];
 	  genps_pdgId_      .push_back(part.pdgId);
 	  genps_firstMother_.push_back(part.firstMother);
 	  genps_energy_     .push_back(part.energy);
 	  genps_pt_         .push_back(part.pt);
 	  genps_eta_        .push_back(part.eta);
 	  genps_phi_        .push_back(part.phi);
-
-	  float mass = genps_p4().at(ig).mass2();
-
-	  if( mass > 0.0 ) mass = sqrt(mass);
-	  else             mass = sqrt(-1*mass);
-
-	  genps_mass_ .push_back(mass);	  
+	  genps_mass_       .push_back(part.mass);
 	}
 
-	weightleft_  = Reweight_Stop_to_TopChi0 (genParticles, 0., -1, prefix);
-	weightright_ = Reweight_Stop_to_TopChi0 (genParticles, 0.,  1, prefix);
+	weightleft_  = polarizationLeft;
+	weightright_ = polarizationRight;
       }
 
       /*
@@ -3354,36 +3404,12 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
       weight_ = -1.;
 
       if( prefix.Contains("T2") ){
-	mG_ = -999; //sparm_mG();
-        mL_ = -999; //sparm_mL();
-        x_  = -999; //sparm_mf();
-
-	if( prefix.Contains("T2tt") ){
-	  for (int i=0; i<(int)sparm_values().size(); ++i) {
-	    if (sparm_names().at(i).Contains("mstop")) mG_ = sparm_values().at(i);
-	    if (sparm_names().at(i).Contains("mlsp")) mL_ = sparm_values().at(i);
-	  }
-	}
-	
-	if( prefix.Contains("T2bw") ){
-	  for (int i=0; i<(int)sparm_values().size(); ++i) {
-	    if (sparm_names().at(i).Contains("mstop")) mG_ = sparm_values().at(i);
-	    if (sparm_names().at(i).Contains("mlsp")) mL_ = sparm_values().at(i);
-	    if (sparm_names().at(i).Contains("x")) x_ = (sparm_values().at(i)/100 - mL_)/(mG_-mL_) ;
-
-	    // this was for phythia
-	    /*
-	    if (sparm_names().at(i).Contains("x")) x_ = sparm_values().at(i);
-	    if (sparm_names().at(i).Contains("mstop")) mG_ = sparm_values().at(i);
-	    if (sparm_names().at(i).Contains("mlsp")) mL_ = sparm_values().at(i);
-	    */
-	  }
-
-	  //	  cout << "stop " << mG_ << " lsp " << mL_ << " x " << x_ << endl;
-
-        }
+	// sparm masses (for T2bw also x), see getScanPoint
+	mG_ = scanPoint.mg;
+        mL_ = scanPoint.ml;
+        x_  = prefix.Contains("T2bw") ? scanPoint.x : -999;
 	
-        xsecsusy_  = mG_ > 0. ? stopPairCrossSection(mG_) : -999;
+        xsecsusy_  = mG_ > 0. ? norm->xsec : -999;
         weight_ = xsecsusy_ > 0. ? lumi * xsecsusy_ * (1000./50000.) : -999.;
 
 	if( doTenPercent )	  weight_ *= 10;
@@ -3396,13 +3422,11 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
       }
 
       else if(prefix.Contains("TChiWH")) {
-	  for (int i=0; i<(int)sparm_values().size(); ++i) {
-	    if (sparm_names().at(i).Contains("mchargino")) mG_ = sparm_values().at(i);
-	    if (sparm_names().at(i).Contains("mlsp")) mL_ = sparm_values().at(i);
-	  }
+	  mG_ = scanPoint.mg;
+	  mL_ = scanPoint.ml;
 
 	// factor in braching ratios here: br(w->lv) 0.33 * br(h->bb) 0.56
-        xsecsusy_  = mG_ > 0. ? c1n2CrossSection(mG_) * 0.33 * 0.56 : -999;
+        xsecsusy_  = mG_ > 0. ? norm->xsec * 0.33 * 0.56 : -999;
 	// note: number of events needs to be included in weight (later)
         weight_ = xsecsusy_ > 0. ? lumi * xsecsusy_ * 1000. : -999.;
 
@@ -3411,7 +3435,7 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
       else if(prefix.Contains("pMSSM")) {
 
 	// use run number to look up xsec
-        xsecsusy_  = evt_run() >= 0 ? pmssmCrossSection(evt_run()) : -999;
+        xsecsusy_  = evt_run() >= 0 ? norm->xsec : -999;
 	// note: number of events needs to be included in weight (later)
         weight_ = xsecsusy_ > 0. ? lumi * xsecsusy_ * 1000. : -999.;
 
@@ -3818,6 +3842,11 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
   cout << "tot " << nepass+nmpass << endl;
   cout << endl;
 
+  if(g_createTree && isScan){
+    massdb.write(outFile);
+    cout << "[singleLeptonLooper] mass database with " << massdb.nPoints() << " points" << endl;
+    normCache.printSummary();
+  }
   if(g_createTree) closeTree();
   
   already_seen.clear();
@@ -3826,7 +3855,9 @@ int singleLeptonLooper::ScanChain(TChain* chain, const TString& prefix, float kF
     std::cout << "ERROR: number of events from files (" << nEventsChain 
 	      << ") is not equal to total number of processed events (" << nEventsTotal << ")" << std::endl;
   
-  stop_xsec_file->Close();
+  delete stop_xsec_;
+  delete c1n2_xsec_;
+  delete pmssm_xsec_;
 
   //delete d_llsol; //REPLACETOPMASS
 
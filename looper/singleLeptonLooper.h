@@ -16,6 +16,8 @@
 #include "../macros/Core/mt2bl_bisect.h"
 #include "../macros/Core/mt2w_bisect.h"
 //#include "Candidate.h"                                                                                                                                                                 
+class BinnedTable;
+
 class Candidate : public TObject {
  public:
   float chi2, mt2w, mt2bl, mt2b;
@@ -122,12 +124,10 @@ class singleLeptonLooper
 	//	pair<float,float> getPhiCorrMET( float met, float metphi, int nvtx, bool ismc);
 	//	pair<float,float> getTrackerMET( P4 *lep, double deltaZCut = 0.1, bool dolepcorr = true );
 	bool initialized;
-	TH1D*   stop_xsec_hist;
-	TFile*  stop_xsec_file;
-	TH1F*   c1n2_xsec_hist;
-	TFile*  c1n2_xsec_file;
-	TH1F*   pmssm_xsec_hist;
-	TFile*  pmssm_xsec_file;
+	// cross sections vs stop mass, chargino mass and pMSSM model
+	BinnedTable*  stop_xsec_;
+	BinnedTable*  c1n2_xsec_;
+	BinnedTable*  pmssm_xsec_;
 	//3D Vertex weight
 	//	double Weight3D[50][50][50];
 
@@ -0,0 +1,274 @@
+//
+// Code generation and benchmark for the BDTs of the analysis.
+//
+//   bdtBench gen   <weights.xml> [outdir]                   compiled model
+//   bdtBench list                                           compiled models
+//   bdtBench bench <weights.xml> [-n events] [-r repeat] [-seed s] [-data trainingset.root]
+//   bdtBench check [weights.xml ...]                        against TMVA::Reader
+//
+// gen writes <outdir>/<name>.cc (outdir ../BDTModels by default), which
+// registers itself with BDTRegistry once it is linked in; rerun make in
+// MiniBabyMaker and WHLooper to pick it up. bench evaluates random inputs,
+// uniform in the training range of each variable, with TMVA::Reader, the
+// flattened BDTForest (one event at a time and in batches) and the
+// compiled model if this binary has it (generated from the same weight
+// file contents), reports ns/event, counts the values that are not
+// bit-identical to TMVA::Reader and exits nonzero if there are any. With
+// -data the inputs are the events of a training set (../Core/TrainingSet.h)
+// instead, up to -n of them. check compares BDTForest and the compiled model with
+// TMVA::Reader on random inputs, half of them on a 1/8 grid so that cuts
+// on it are hit exactly, and exits nonzero on any value that is not
+// bit-identical; without arguments it checks the synthetic forests in
+// fixtures/ (AdaBoost with node type and with purity leaves, Grad).
+//
+
+#include "../Core/BDTForest.h"
+#include "../Core/BDTRegistry.h"
+#include "../Core/TrainingSet.h"
+
+#include "TMVA/Reader.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+using namespace std;
+
+//--------------------------------------------------------------------
+static double now(){
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static const int BATCH = 64;
+
+//--------------------------------------------------------------------
+static int generate(const char* weightfile, const string& outdir){
+  const BDTForest* forest = BDTForest::get(weightfile);
+  if (!forest) return 1;
+  string name = BDTForest::modelName(weightfile);
+  return forest->generate(name, outdir + "/" + name + ".cc") ? 0 : 1;
+}
+
+//--------------------------------------------------------------------
+// inputs a bit beyond the training range, to get the outer bins too
+static void randomInputs(const BDTForest* forest, int nev, int seed, vector<float>& x){
+  const int nvars = forest->nVariables();
+  TRandom3 rnd(seed);
+  x.resize(nev * nvars);
+  for (int k = 0; k < nev; ++k)
+    for (int j = 0; j < nvars; ++j) {
+      float lo = forest->min(j), hi = forest->max(j), margin = 0.1 * (hi - lo);
+      x[k * nvars + j] = rnd.Uniform(lo - margin, hi + margin);
+    }
+}
+
+//--------------------------------------------------------------------
+static int report(const char* what, double dt, int nev, const vector<double>& out, const vector<double>& ref){
+  int nbad = 0;
+  for (int k = 0; k < nev; ++k)
+    if (memcmp(&out[k], &ref[k], sizeof(double))) ++nbad;
+  printf("  %-20s %12.1f %12d\n", what, 1e9 * dt / nev, nbad);
+  return nbad;
+}
+
+static int mismatches(int nbad){
+  if (!nbad) return 0;
+  printf("[bdtBench] FAILED: %d values differ from TMVA::Reader\n", nbad);
+  return 1;
+}
+
+static int runBenchmark(const char* weightfile, int nev, int nrepeat, int seed, const char* data){
+
+  const BDTForest* forest = BDTForest::get(weightfile);
+  if (!forest) return 1;
+  const BDTModel* model = BDTForest::compiled(weightfile);
+  const int nvars = forest->nVariables();
+
+  vector<float> x;
+  if (data) {
+    TrainingSet set;
+    if (!set.read(data)) return 1;
+    int nrows = set.rows(forest->variables(), x);
+    if (nrows == 0) return 1;
+    nev = min(nev, nrows);
+  } else {
+    randomInputs(forest, nev, seed, x);
+  }
+
+  vector<float> vars(nvars);
+  TMVA::Reader reader("!Color:Silent");
+  for (int j = 0; j < nvars; ++j) reader.AddVariable(forest->variables()[j].c_str(), &vars[j]);
+  reader.BookMVA("BDT", weightfile);
+
+  vector<double> ref(nev), out(nev);
+  double t0, dt;
+
+  printf("  %-20s %12s %12s\n", "evaluator", "ns/event", "mismatches");
+
+  t0 = now();
+  for (int r = 0; r < nrepeat; ++r)
+    for (int k = 0; k < nev; ++k) {
+      for (int j = 0; j < nvars; ++j) vars[j] = x[k * nvars + j];
+      ref[k] = reader.EvaluateMVA("BDT");
+    }
+  dt = (now() - t0) / nrepeat;
+  report("TMVA::Reader", dt, nev, ref, ref);
+  int nbad = 0;
+
+  t0 = now();
+  for (int r = 0; r < nrepeat; ++r)
+    for (int k = 0; k < nev; ++k) out[k] = forest->evaluate(&x[k * nvars]);
+  dt = (now() - t0) / nrepeat;
+  nbad += report("BDTForest", dt, nev, out, ref);
+
+  t0 = now();
+  for (int r = 0; r < nrepeat; ++r)
+    for (int k = 0; k < nev; k += BATCH)
+      forest->evaluate(&x[k * nvars], min(BATCH, nev - k), &out[k]);
+  dt = (now() - t0) / nrepeat;
+  nbad += report("BDTForest batch", dt, nev, out, ref);
+
+  if (!model) {
+    printf("[bdtBench] no compiled model of this weight file in this binary\n");
+    return mismatches(nbad);
+  }
+
+  t0 = now();
+  for (int r = 0; r < nrepeat; ++r)
+    for (int k = 0; k < nev; ++k) out[k] = model->evaluate(&x[k * nvars]);
+  dt = (now() - t0) / nrepeat;
+  nbad += report("compiled", dt, nev, out, ref);
+
+  t0 = now();
+  for (int r = 0; r < nrepeat; ++r)
+    for (int k = 0; k < nev; k += BATCH)
+      model->evaluateBatch(&x[k * nvars], min(BATCH, nev - k), &out[k]);
+  dt = (now() - t0) / nrepeat;
+  nbad += report("compiled batch", dt, nev, out, ref);
+
+  return mismatches(nbad);
+}
+
+//--------------------------------------------------------------------
+// check: every evaluator against TMVA::Reader, bit for bit
+
+static const char* fixtures[] = {
+  "fixtures/synthetic_AdaBoost_BDT.weights.xml",
+  "fixtures/synthetic_AdaBoostPurity_BDT.weights.xml",
+  "fixtures/synthetic_Grad_BDT.weights.xml"
+};
+
+static int compare(const char* what, const vector<double>& out, const vector<double>& ref,
+                   const vector<float>& x, int nvars){
+  int nbad = 0;
+  for (unsigned int k = 0; k < ref.size(); ++k) {
+    if (!memcmp(&out[k], &ref[k], sizeof(double))) continue;
+    if (nbad++ < 5) {
+      printf("[bdtBench] %s: %.17g, TMVA::Reader gives %.17g for", what, out[k], ref[k]);
+      for (int j = 0; j < nvars; ++j) printf(" %.9g", x[k * nvars + j]);
+      printf("\n");
+    }
+  }
+  printf("  %-20s %8d different\n", what, nbad);
+  return nbad;
+}
+
+static int checkForest(const char* weightfile, int nev){
+
+  const BDTForest* forest = BDTForest::get(weightfile);
+  if (!forest) return 1;
+  const BDTModel* model = BDTForest::compiled(weightfile);
+  const int nvars = forest->nVariables();
+
+  vector<float> x;
+  randomInputs(forest, nev, 1, x);
+  for (int k = nev / 2; k < nev; ++k)
+    for (int j = 0; j < nvars; ++j) x[k * nvars + j] = floor(8 * x[k * nvars + j]) / 8;
+
+  vector<float> vars(nvars);
+  TMVA::Reader reader("!Color:Silent");
+  for (int j = 0; j < nvars; ++j) reader.AddVariable(forest->variables()[j].c_str(), &vars[j]);
+  reader.BookMVA("BDT", weightfile);
+
+  vector<double> ref(nev), out(nev);
+  for (int k = 0; k < nev; ++k) {
+    for (int j = 0; j < nvars; ++j) vars[j] = x[k * nvars + j];
+    ref[k] = reader.EvaluateMVA("BDT");
+  }
+
+  int nbad = 0;
+  for (int k = 0; k < nev; ++k) out[k] = forest->evaluate(&x[k * nvars]);
+  nbad += compare("BDTForest", out, ref, x, nvars);
+  for (int k = 0; k < nev; k += BATCH) forest->evaluate(&x[k * nvars], min(BATCH, nev - k), &out[k]);
+  nbad += compare("BDTForest batch", out, ref, x, nvars);
+  if (model) {
+    for (int k = 0; k < nev; ++k) out[k] = model->evaluate(&x[k * nvars]);
+    nbad += compare("compiled", out, ref, x, nvars);
+    for (int k = 0; k < nev; k += BATCH) model->evaluateBatch(&x[k * nvars], min(BATCH, nev - k), &out[k]);
+    nbad += compare("compiled batch", out, ref, x, nvars);
+  }
+  return nbad;
+}
+
+static int check(const vector<string>& weightfiles){
+  int nfailed = 0;
+  for (unsigned int i = 0; i < weightfiles.size(); ++i)
+    if (checkForest(weightfiles[i].c_str(), 100000)) ++nfailed;
+  if (nfailed) {
+    printf("[bdtBench] FAILED: %d of %u forests differ from TMVA::Reader\n", nfailed, (unsigned int)weightfiles.size());
+    return 1;
+  }
+  printf("[bdtBench] %u forests identical to TMVA::Reader\n", (unsigned int)weightfiles.size());
+  return 0;
+}
+
+//--------------------------------------------------------------------
+static void usage(){
+  cout << "usage: bdtBench gen   <weights.xml> [outdir]" << endl
+       << "       bdtBench list" << endl
+       << "       bdtBench bench <weights.xml> [-n events] [-r repeat] [-seed s] [-data trainingset.root]" << endl
+       << "       bdtBench check [weights.xml ...]" << endl;
+}
+
+int main(int argc, char** argv){
+
+  if (argc < 2) { usage(); return 1; }
+  string mode = argv[1];
+
+  if (mode == "gen" && (argc == 3 || argc == 4))
+    return generate(argv[2], argc == 4 ? argv[3] : "../BDTModels");
+
+  if (mode == "list" && argc == 2) {
+    BDTRegistry::list();
+    return 0;
+  }
+
+  if (mode == "check") {
+    vector<string> weightfiles(argv + 2, argv + argc);
+    if (weightfiles.empty()) weightfiles.assign(fixtures, fixtures + sizeof(fixtures) / sizeof(fixtures[0]));
+    return check(weightfiles);
+  }
+
+  if (mode == "bench" && argc >= 3) {
+    int nev = 100000, nrepeat = 5, seed = 1;
+    const char* data = 0;
+    for (int i = 3; i + 1 < argc; i += 2) {
+      if (!strcmp(argv[i], "-n")) nev = atoi(argv[i + 1]);
+      else if (!strcmp(argv[i], "-r")) nrepeat = atoi(argv[i + 1]);
+      else if (!strcmp(argv[i], "-seed")) seed = atoi(argv[i + 1]);
+      else if (!strcmp(argv[i], "-data")) data = argv[i + 1];
+    }
+    if (nev <= 0 || nrepeat <= 0) { usage(); return 1; }
+    return runBenchmark(argv[2], nev, nrepeat, seed, data);
+  }
+
+  usage();
+  return 1;
+}
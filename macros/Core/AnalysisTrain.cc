@@ -0,0 +1,331 @@
+#include "AnalysisTrain.h"
+
+#include "STOPT.h"
+
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <cmath>
+#include <cstdio>
+#include <csignal>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Stop;
+
+AnalysisTrain::AnalysisTrain()
+	: nWorkers_(1), watches_(1), nEventsChain_(0), nRead_(0), nAnalyzed_(0)
+{
+}
+
+void AnalysisTrain::add(TrainAnalyzer* analyzer){
+	analyzers_.push_back(analyzer);
+	watches_.push_back(TStopwatch());
+}
+
+//--------------------------------------------------------------------
+
+bool AnalysisTrain::run(TChain* chain, const TString& sample){
+
+	printf("[AnalysisTrain::run] %s, %u analyzers\n", sample.Data(), (unsigned int)analyzers_.size());
+
+	TObjArray *listOfFiles = chain->GetListOfFiles();
+	if (listOfFiles->GetEntries() == 0) {
+		printf("[AnalysisTrain::run] no files in chain\n");
+		return false;
+	}
+
+	if (eventsLaserCalib_.empty())
+		load_badlaserevents((char*)"../Core/badlaser_events.txt", eventsLaserCalib_);
+	if (eventsHcalLaserCalib_.empty())
+		load_badlaserevents((char*)"../Core/badhcallaser_events.txt", eventsHcalLaserCalib_);
+
+	bool isData = sample.Contains("data");
+
+	bool parallel = nWorkers_ > 1 && listOfFiles->GetEntries() > 1;
+	for (unsigned int a = 0; a < analyzers_.size(); ++a) {
+		if (parallel && !analyzers_[a]->mergeable()) {
+			printf("[AnalysisTrain::run] %s is not mergeable, running serially\n", analyzers_[a]->name().c_str());
+			parallel = false;
+		}
+	}
+
+	nRead_ = 0;
+	nAnalyzed_ = 0;
+	cpu_.assign(watches_.size(), 0.);
+	real_.assign(watches_.size(), 0.);
+	for (unsigned int w = 0; w < watches_.size(); ++w) watches_[w].Reset();
+
+	for (unsigned int a = 0; a < analyzers_.size(); ++a) {
+		analyzers_[a]->fileHists_.clear();
+		analyzers_[a]->hists_.clear();
+		watches_[a+1].Start(kFALSE);
+		gROOT->cd();
+		analyzers_[a]->begin(sample, isData);
+		watches_[a+1].Stop();
+	}
+
+	nEventsChain_ = chain->GetEntries();
+
+	if (parallel) {
+		if (!runWorkers(chain, isData)) {
+			printf("[AnalysisTrain::run] %s failed, end() not called, no output written\n", sample.Data());
+			alreadySeen_.clear();
+			return false;
+		}
+	} else {
+		TIter fileIter(listOfFiles);
+		while (TChainElement *currentFile = (TChainElement*)fileIter.Next()) {
+			readFile(currentFile->GetTitle(), isData, 0);
+			mergeFile();
+		}
+	}
+
+	for (unsigned int a = 0; a < analyzers_.size(); ++a) {
+		watches_[a+1].Start(kFALSE);
+		analyzers_[a]->end();
+		gROOT->cd();
+		watches_[a+1].Stop();
+	}
+
+	for (unsigned int w = 0; w < watches_.size(); ++w) {
+		cpu_[w] += watches_[w].CpuTime();
+		real_[w] += watches_[w].RealTime();
+	}
+
+	alreadySeen_.clear();
+
+	printTimes();
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void AnalysisTrain::readFile(const char* filename, bool isData, const vector<bool>* skip){
+
+	watches_[0].Start(kFALSE);
+	TFile *file = new TFile(filename);
+	TTree *tree = (TTree*)file->Get("t");
+	stopt.Init(tree);
+	watches_[0].Stop();
+
+	for (unsigned int a = 0; a < analyzers_.size(); ++a) {
+		watches_[a+1].Start(kFALSE);
+		analyzers_[a]->beginFile(tree);
+		watches_[a+1].Stop();
+	}
+
+	TrainEvent evt;
+	evt.isData = isData;
+
+	ULong64_t nEvents = tree->GetEntriesFast();
+	for (ULong64_t event = 0; event < nEvents; ++event) {
+
+		watches_[0].Start(kFALSE);
+		stopt.GetEntry(event);
+
+		++nRead_;
+		if (!skip && nRead_%10000==0) {
+			ULong64_t i_permille = (int)floor(1000 * nRead_ / float(nEventsChain_));
+			// xterm magic from L. Vacavant and A. Cerri
+			if (isatty(1)) {
+				printf("\015\033[32m ---> \033[1m\033[31m%4.1f%%"
+				       "\033[0m\033[32m <---\033[0m\015", i_permille/10.);
+				fflush(stdout);
+			}
+		}
+
+		if (skip) {
+			if ((*skip)[event]) {
+				watches_[0].Stop();
+				continue;
+			}
+		} else if (isData) {
+			DorkyEventIdentifier id = {stopt.run(), stopt.event(), stopt.lumi() };
+			if (is_duplicate(id, alreadySeen_)
+			    || is_badLaserEvent(id, eventsLaserCalib_)
+			    || is_badLaserEvent(id, eventsHcalLaserCalib_)) {
+				watches_[0].Stop();
+				continue;
+			}
+		}
+
+		evt.weight = isData ? 1. : ( stopt.weight() * 19.5 * stopt.nvtxweight() * stopt.mgcor() );
+		evt.entry = event;
+		watches_[0].Stop();
+
+		++nAnalyzed_;
+		for (unsigned int a = 0; a < analyzers_.size(); ++a) {
+			watches_[a+1].Start(kFALSE);
+			analyzers_[a]->analyze(evt);
+			watches_[a+1].Stop();
+		}
+	}
+
+	delete file;
+}
+
+void AnalysisTrain::mergeFile(){
+	for (unsigned int a = 0; a < analyzers_.size(); ++a) {
+		TrainAnalyzer* analyzer = analyzers_[a];
+		analyzer->hists_.add(analyzer->fileHists_);
+		analyzer->fileHists_.clear();
+	}
+}
+
+//--------------------------------------------------------------------
+
+void AnalysisTrain::findSkipped(TChain* chain, SkipLists& skip){
+	// the serial decision: the first copy of an event in chain order is kept
+	TIter fileIter(chain->GetListOfFiles());
+	while (TChainElement *currentFile = (TChainElement*)fileIter.Next()) {
+		TFile *file = new TFile( currentFile->GetTitle() );
+		TTree *tree = (TTree*)file->Get("t");
+		stopt.Init(tree);
+
+		ULong64_t nEvents = tree->GetEntriesFast();
+		skip.push_back(vector<bool>(nEvents, false));
+		for (ULong64_t event = 0; event < nEvents; ++event) {
+			stopt.GetEntry(event);
+			DorkyEventIdentifier id = {stopt.run(), stopt.event(), stopt.lumi() };
+			skip.back()[event] = is_duplicate(id, alreadySeen_)
+				|| is_badLaserEvent(id, eventsLaserCalib_)
+				|| is_badLaserEvent(id, eventsHcalLaserCalib_);
+		}
+		delete file;
+	}
+}
+
+static void removeShards(const vector<TString>& shards){
+	for (unsigned int f = 0; f < shards.size(); ++f) remove(shards[f].Data());
+}
+
+bool AnalysisTrain::runWorkers(TChain* chain, bool isData){
+
+	vector<const char*> files;
+	TIter fileIter(chain->GetListOfFiles());
+	while (TChainElement *currentFile = (TChainElement*)fileIter.Next())
+		files.push_back(currentFile->GetTitle());
+
+	SkipLists skip;
+	if (isData) {
+		watches_[0].Start(kFALSE);
+		findSkipped(chain, skip);
+		watches_[0].Stop();
+	}
+
+	int nWorkers = nWorkers_ < int(files.size()) ? nWorkers_ : files.size();
+	printf("[AnalysisTrain::run] %u files on %d workers\n", (unsigned int)files.size(), nWorkers);
+
+	const char* tmpdir = getenv("TMPDIR");
+	if (!tmpdir) tmpdir = "/tmp";
+	vector<TString> shards;
+	for (unsigned int f = 0; f < files.size(); ++f)
+		shards.push_back(Form("%s/train_%d_%u.shard", tmpdir, getpid(), f));
+
+	fflush(stdout);
+	vector<pid_t> pids;
+	for (int w = 0; w < nWorkers; ++w) {
+		pid_t pid = fork();
+		if (pid < 0) {
+			printf("[AnalysisTrain::run] fork failed\n");
+			for (unsigned int i = 0; i < pids.size(); ++i) {
+				kill(pids[i], SIGKILL);
+				waitpid(pids[i], 0, 0);
+			}
+			removeShards(shards);
+			return false;
+		}
+		if (pid > 0) {
+			pids.push_back(pid);
+			continue;
+		}
+
+		// worker: files w, w + nWorkers, ...; one shard file per input file
+		for (unsigned int f = w; f < files.size(); f += nWorkers) {
+			for (unsigned int i = 0; i < watches_.size(); ++i) watches_[i].Reset();
+			nRead_ = 0;
+			nAnalyzed_ = 0;
+			readFile(files[f], isData, isData ? &skip[f] : 0);
+
+			FILE* out = fopen(shards[f].Data(), "wb");
+			bool ok = out != 0;
+			if (ok) ok = fwrite(&nRead_, sizeof(nRead_), 1, out) == 1
+				&& fwrite(&nAnalyzed_, sizeof(nAnalyzed_), 1, out) == 1;
+			for (unsigned int i = 0; ok && i < watches_.size(); ++i) {
+				double times[2] = { watches_[i].CpuTime(), watches_[i].RealTime() };
+				ok = fwrite(times, sizeof(double), 2, out) == 2;
+			}
+			for (unsigned int a = 0; ok && a < analyzers_.size(); ++a)
+				ok = analyzers_[a]->fileHists_.write(out);
+			if (out && fclose(out) != 0) ok = false;
+			if (!ok) {
+				printf("[AnalysisTrain::run] cannot write %s\n", shards[f].Data());
+				fflush(stdout);
+				_exit(1);
+			}
+			for (unsigned int a = 0; a < analyzers_.size(); ++a) analyzers_[a]->fileHists_.clear();
+		}
+		fflush(stdout);
+		_exit(0);
+	}
+
+	bool failed = false;
+	for (unsigned int w = 0; w < pids.size(); ++w) {
+		int status = 0;
+		if (waitpid(pids[w], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			failed = true;
+	}
+	if (failed) {
+		printf("[AnalysisTrain::run] a worker failed\n");
+		removeShards(shards);
+		return false;
+	}
+
+	// merge in file order
+	HistShard shard;
+	for (unsigned int f = 0; f < files.size(); ++f) {
+		FILE* in = fopen(shards[f].Data(), "rb");
+		ULong64_t nRead = 0, nAnalyzed = 0;
+		bool ok = in != 0;
+		if (ok) ok = fread(&nRead, sizeof(nRead), 1, in) == 1
+			&& fread(&nAnalyzed, sizeof(nAnalyzed), 1, in) == 1;
+		for (unsigned int i = 0; ok && i < watches_.size(); ++i) {
+			double times[2];
+			ok = fread(times, sizeof(double), 2, in) == 2;
+			cpu_[i] += times[0];
+			real_[i] += times[1];
+		}
+		for (unsigned int a = 0; ok && a < analyzers_.size(); ++a) {
+			ok = shard.read(in);
+			if (ok) analyzers_[a]->hists_.add(shard);
+		}
+		if (in) fclose(in);
+		if (!ok) {
+			printf("[AnalysisTrain::run] cannot read %s\n", shards[f].Data());
+			removeShards(shards);
+			return false;
+		}
+		remove(shards[f].Data());
+		nRead_ += nRead;
+		nAnalyzed_ += nAnalyzed;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void AnalysisTrain::printTimes() const {
+	printf("[AnalysisTrain] %llu events read, %llu analyzed\n", nRead_, nAnalyzed_);
+	printf("|  %-24s  | %10s | %10s | %10s |\n", "module", "cpu [s]", "real [s]", "us/event");
+	for (unsigned int w = 0; w < cpu_.size(); ++w) {
+		ULong64_t n = w == 0 ? nRead_ : nAnalyzed_;
+		printf("|  %-24s  | %10.2f | %10.2f | %10.2f |\n",
+		       w == 0 ? "read + filters" : analyzers_[w-1]->name().c_str(),
+		       cpu_[w], real_[w], n ? 1e6 * cpu_[w] / n : 0.);
+	}
+}
@@ -0,0 +1,129 @@
+#ifndef ANALYSISTRAIN_H
+#define ANALYSISTRAIN_H
+
+#include "TString.h"
+#include "TStopwatch.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "stopUtils.h"
+#include "../Plotting/HistShard.h"
+
+class TChain;
+class TTree;
+
+using namespace std;
+
+// what the train knows about the current event; the baby itself is in stopt
+struct TrainEvent {
+	bool isData;
+	// data: 1, MC: weight * 19.5/fb * nvtxweight * mgcor
+	float weight;
+	// entry in the current file
+	ULong64_t entry;
+};
+
+/* One analysis riding the train.
+ *
+ * begin() is called once per sample, beginFile() for every file of the
+ * chain (after stopt.Init), analyze() for every event that survives the
+ * duplicate and bad laser filters, end() once the chain is done.  Each
+ * analyzer books its own histograms and writes its own output file in end().
+ *
+ * Histograms filled through hists() are kept per file and summed into
+ * mergedHists() in file order.  An analyzer whose whole output is in
+ * hists() says so with mergeable(), and can then run in worker processes.
+ */
+class TrainAnalyzer {
+
+public:
+	TrainAnalyzer(const string& name) : name_(name) {}
+	virtual ~TrainAnalyzer() {}
+
+	const string& name() const { return name_; }
+
+	virtual void begin(const TString& sample, bool isData) {}
+	virtual void beginFile(TTree* tree) {}
+	virtual void analyze(const TrainEvent& evt) = 0;
+	virtual void end() {}
+
+	virtual bool mergeable() const { return false; }
+
+protected:
+	// current file
+	HistShard& hists() { return fileHists_; }
+	// all files up to the current one; complete in end()
+	const HistShard& mergedHists() const { return hists_; }
+
+private:
+	friend class AnalysisTrain;
+
+	string name_;
+	HistShard fileHists_, hists_;
+};
+
+/* Reads a chain of stop babies once and feeds every event to all the
+ * analyzers added to it.
+ *
+ * The train owns what every looper used to repeat: the file loop, the
+ * STOPT reader, the progress bar, the data duplicate and bad laser
+ * filters and the standard event weight.  The time spent in each analyzer
+ * is measured separately from the time spent reading, and printed at the
+ * end of run().
+ *
+ * With setWorkers(n), n > 1, and only mergeable analyzers, the files are
+ * dealt round robin to n forked worker processes.  Each worker sends back
+ * the hists() of every file it read, and the parent merges them in file
+ * order before calling end(), so the output is bit for bit the one of the
+ * serial run.  Data duplicates are found in a first pass over run, lumi
+ * and event only, so the same events are dropped as in the serial run.
+ * Workers are processes rather than threads because stopt and ROOT's
+ * histogram and file bookkeeping are global.
+ *
+ *   AnalysisTrain train;
+ *   train.add(&vtxPlots);
+ *   train.add(&cutflows);
+ *   train.run(chain, "ttsl_lmg");
+ */
+class AnalysisTrain {
+
+public:
+	AnalysisTrain();
+
+	// not owned; analyzers run in the order they were added
+	void add(TrainAnalyzer* analyzer);
+	// false if the chain is empty or a worker failed; end() is then not called
+	bool run(TChain* chain, const TString& sample);
+
+	void setWorkers(int n) { nWorkers_ = n; }
+
+	void printTimes() const;
+
+private:
+	// per file: the entries to skip
+	typedef vector< vector<bool> > SkipLists;
+
+	void readFile(const char* filename, bool isData, const vector<bool>* skip);
+	void mergeFile();
+	void findSkipped(TChain* chain, SkipLists& skip);
+	bool runWorkers(TChain* chain, bool isData);
+
+	int nWorkers_;
+	vector<TrainAnalyzer*> analyzers_;
+
+	// cpu and real seconds, reading first then one per analyzer
+	vector<TStopwatch> watches_;
+	vector<double> cpu_, real_;
+	// during run(): events of the chain, for the progress bar
+	ULong64_t nEventsChain_;
+
+	std::set<DorkyEventIdentifier> alreadySeen_;
+	std::set<DorkyEventIdentifier> eventsLaserCalib_;
+	std::set<DorkyEventIdentifier> eventsHcalLaserCalib_;
+
+	ULong64_t nRead_, nAnalyzed_;
+};
+
+#endif
@@ -0,0 +1,530 @@
+#include "BDTForest.h"
+#include "BDTRegistry.h"
+
+#include "TMVA/Reader.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+map<string, BDTForest*> BDTForest::forests_;
+
+//--------------------------------------------------------------------
+// just enough XML for TMVA weight files: tags, attributes, option text
+
+namespace {
+
+	struct Tag {
+		string name;
+		map<string, string> attrs;
+		bool closing, selfClosing;
+		string::size_type end;		// just after the '>'
+
+		const string& attr(const char* key) const {
+			static const string none;
+			map<string, string>::const_iterator it = attrs.find(key);
+			return it == attrs.end() ? none : it->second;
+		}
+	};
+
+	string unescape(const string& s){
+		static const char* from[] = { "&lt;", "&gt;", "&quot;", "&apos;", "&amp;" };
+		static const char* to[]   = { "<", ">", "\"", "'", "&" };
+		string out;
+		for (string::size_type i = 0; i < s.size(); ++i) {
+			int k = 0;
+			if (s[i] == '&')
+				for (k = 0; k < 5 && s.compare(i, strlen(from[k]), from[k]) != 0; ++k) ;
+			if (s[i] == '&' && k < 5) {
+				out += to[k];
+				i += strlen(from[k]) - 1;
+			} else {
+				out += s[i];
+			}
+		}
+		return out;
+	}
+
+	bool nextTag(const string& xml, string::size_type& pos, Tag& tag){
+		while (true) {
+			string::size_type open = xml.find('<', pos);
+			if (open == string::npos) return false;
+			if (xml.compare(open, 4, "<!--") == 0) {
+				pos = xml.find("-->", open);
+				if (pos == string::npos) return false;
+				continue;
+			}
+			string::size_type close = xml.find('>', open);
+			if (close == string::npos) return false;
+			pos = close + 1;
+			if (xml[open+1] == '?' || xml[open+1] == '!') continue;
+
+			tag.attrs.clear();
+			tag.end = pos;
+			tag.closing = xml[open+1] == '/';
+			tag.selfClosing = xml[close-1] == '/';
+
+			string::size_type i = open + (tag.closing ? 2 : 1);
+			string::size_type j = xml.find_first_of(" \t\r\n/>", i);
+			tag.name = xml.substr(i, j - i);
+
+			// name="value" pairs
+			while (true) {
+				string::size_type eq = xml.find('=', j);
+				if (eq == string::npos || eq > close) break;
+				string::size_type q1 = xml.find('"', eq);
+				string::size_type q2 = xml.find('"', q1 + 1);
+				if (q1 == string::npos || q2 == string::npos || q2 > close) break;
+				string::size_type k = xml.find_last_not_of(" \t\r\n", eq - 1);
+				string::size_type b = xml.find_last_of(" \t\r\n", k) + 1;
+				tag.attrs[xml.substr(b, k + 1 - b)] = unescape(xml.substr(q1 + 1, q2 - q1 - 1));
+				j = q2 + 1;
+			}
+			return true;
+		}
+	}
+
+	// 64 bit FNV-1a
+	unsigned long long fnv1a(const string& s){
+		unsigned long long h = 14695981039346656037ULL;
+		for (string::size_type i = 0; i < s.size(); ++i) {
+			h ^= (unsigned char)s[i];
+			h *= 1099511628211ULL;
+		}
+		return h;
+	}
+
+	// C string literal
+	string quote(const string& s){
+		string out = "\"";
+		for (string::size_type i = 0; i < s.size(); ++i) {
+			if (s[i] == '"' || s[i] == '\\') out += '\\';
+			out += s[i];
+		}
+		return out + "\"";
+	}
+
+}
+
+//--------------------------------------------------------------------
+
+const BDTForest* BDTForest::get(const string& weightfile){
+	map<string, BDTForest*>::iterator it = forests_.find(weightfile);
+	if (it != forests_.end()) return it->second;
+
+	BDTForest* forest = new BDTForest();
+	if (!forest->read(weightfile)) {
+		delete forest;
+		return 0;
+	}
+	forests_[weightfile] = forest;
+	return forest;
+}
+
+bool BDTForest::read(const string& weightfile){
+
+	ifstream in(weightfile.c_str());
+	if (!in) {
+		printf("[BDTForest] cannot open %s\n", weightfile.c_str());
+		return false;
+	}
+	string xml((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+	hash_ = fnv1a(xml);
+
+	bool useYesNoLeaf = true;
+	grad_ = false;
+	norm_ = 0.;
+	int analysisType = 0;
+	vector<int> parents;
+
+	Tag tag;
+	string::size_type pos = 0;
+	while (nextTag(xml, pos, tag)) {
+
+		if (tag.name == "Option" && !tag.closing) {
+			string text = xml.substr(tag.end, xml.find('<', tag.end) - tag.end);
+			if (tag.attr("name") == "BoostType") grad_ = text == "Grad";
+			if (tag.attr("name") == "UseYesNoLeaf") useYesNoLeaf = text == "True" || text == "true" || text == "1";
+		}
+		else if (tag.name == "Variable" && !tag.closing) {
+			variables_.push_back(tag.attr("Expression"));
+			min_.push_back(strtof(tag.attr("Min").c_str(), 0));
+			max_.push_back(strtof(tag.attr("Max").c_str(), 0));
+		}
+		else if (tag.name == "Transformations" && !tag.closing) {
+			if (atoi(tag.attr("NTransformations").c_str()) != 0) {
+				printf("[BDTForest] %s: input transformations are not supported\n", weightfile.c_str());
+				return false;
+			}
+		}
+		else if (tag.name == "Weights" && !tag.closing) {
+			// MethodBDT writes the tree type here, 1 for regression trees;
+			// Grad uses them for classification too, with the response as leaf value
+			const string& type = tag.attr("TreeType").empty() ? tag.attr("AnalysisType") : tag.attr("TreeType");
+			analysisType = atoi(type.c_str());
+		}
+		else if (tag.name == "BinaryTree" && !tag.closing) {
+			boostWeights_.push_back(strtod(tag.attr("boostWeight").c_str(), 0));
+			norm_ += boostWeights_.back();
+			roots_.push_back(nodes_.size());
+			parents.clear();
+		}
+		else if (tag.name == "Node" && !tag.closing) {
+			if (atoi(tag.attr("NCoef").c_str()) != 0) {
+				printf("[BDTForest] %s: Fisher cuts are not supported\n", weightfile.c_str());
+				return false;
+			}
+			Node node;
+			node.cut = strtof(tag.attr("Cut").c_str(), 0);
+			node.cutType = atoi(tag.attr("cType").c_str()) != 0;
+			node.left = node.right = -1;
+			// as DecisionTree::CheckEvent: a node type other than 0 is a leaf
+			int nType = atoi(tag.attr("nType").c_str());
+			node.var = nType == 0 ? atoi(tag.attr("IVar").c_str()) : -1;
+			if (analysisType == 1) node.value = strtof(tag.attr("res").c_str(), 0);
+			else if (useYesNoLeaf && !grad_) node.value = nType;
+			else node.value = strtof(tag.attr("purity").c_str(), 0);
+
+			int index = nodes_.size();
+			if (!parents.empty()) {
+				if (tag.attr("pos") == "l") nodes_[parents.back()].left = index;
+				else nodes_[parents.back()].right = index;
+			}
+			nodes_.push_back(node);
+			if (!tag.selfClosing) parents.push_back(index);
+		}
+		else if (tag.name == "Node" && tag.closing) {
+			if (!parents.empty()) parents.pop_back();
+		}
+	}
+
+	if (roots_.empty() || variables_.empty()) {
+		printf("[BDTForest] %s: no trees or no variables\n", weightfile.c_str());
+		return false;
+	}
+	for (unsigned int i = 0; i < nodes_.size(); ++i) {
+		const Node& node = nodes_[i];
+		if (node.var >= int(variables_.size()) || (node.var >= 0 && (node.left < 0 || node.right < 0))) {
+			printf("[BDTForest] %s: malformed tree\n", weightfile.c_str());
+			return false;
+		}
+	}
+
+	printf("[BDTForest] %s: %u trees, %u nodes, %s\n", weightfile.c_str(),
+	       (unsigned int)roots_.size(), (unsigned int)nodes_.size(), grad_ ? "Grad" : "weighted average");
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+double BDTForest::evaluate(const float* x) const {
+	double out;
+	evaluate(x, 1, &out);
+	return out;
+}
+
+void BDTForest::evaluate(const float* x, int n, double* out) const {
+
+	const int nvars = variables_.size();
+	const Node* nodes = &nodes_[0];
+
+	for (int k = 0; k < n; ++k) out[k] = 0.;
+
+	for (unsigned int t = 0; t < roots_.size(); ++t) {
+		for (int k = 0; k < n; ++k) {
+			const float* xk = x + k * nvars;
+			int i = roots_[t];
+			while (nodes[i].var >= 0) {
+				bool right = (xk[nodes[i].var] >= nodes[i].cut) == nodes[i].cutType;
+				i = right ? nodes[i].right : nodes[i].left;
+			}
+			// same terms in the same order as MethodBDT
+			if (grad_) out[k] += nodes[i].value;
+			else out[k] += boostWeights_[t] * nodes[i].value;
+		}
+	}
+
+	for (int k = 0; k < n; ++k) {
+		if (grad_) out[k] = 2.0 / (1.0 + exp(-2.0 * out[k])) - 1;
+		else out[k] = norm_ > std::numeric_limits<double>::epsilon() ? out[k] / norm_ : 0;
+	}
+}
+
+//--------------------------------------------------------------------
+// code generation
+
+string BDTForest::modelName(const string& weightfile){
+	string name = weightfile.substr(weightfile.find_last_of('/') + 1);
+	string::size_type ext = name.rfind(".weights.xml");
+	return ext == string::npos ? name : name.substr(0, ext);
+}
+
+unsigned long long BDTForest::fileHash(const string& weightfile){
+	ifstream in(weightfile.c_str());
+	if (!in) return 0;
+	return fnv1a(string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>()));
+}
+
+const BDTModel* BDTForest::compiled(const string& weightfile){
+	const BDTModel* model = BDTRegistry::find(modelName(weightfile));
+	if (!model) return 0;
+	unsigned long long hash = fileHash(weightfile);
+	if (model->hash != hash) {
+		printf("[BDTForest] WARNING: compiled %s was generated from another weight file (hash %016llx),\n"
+		       "[BDTForest] WARNING: %s has %016llx; regenerate it with bdtBench gen\n",
+		       model->name, model->hash, weightfile.c_str(), hash);
+		return 0;
+	}
+	return model;
+}
+
+void BDTForest::writeNode(FILE* out, int i, int depth) const {
+	const Node& node = nodes_[i];
+	if (node.var < 0) {
+		fprintf(out, "%*sreturn %.9ef;\n", 2*depth, "", node.value);
+		return;
+	}
+	// the cut goes to the right when (x >= cut) == cutType
+	int pass = node.cutType ? node.right : node.left;
+	int fail = node.cutType ? node.left : node.right;
+	fprintf(out, "%*sif (x[%d] >= %.9ef) {\n", 2*depth, "", node.var, node.cut);
+	writeNode(out, pass, depth + 1);
+	fprintf(out, "%*s} else {\n", 2*depth, "");
+	writeNode(out, fail, depth + 1);
+	fprintf(out, "%*s}\n", 2*depth, "");
+}
+
+bool BDTForest::generate(const string& name, const string& filename) const {
+
+	FILE* out = fopen(filename.c_str(), "w");
+	if (!out) {
+		printf("[BDTForest] cannot write %s\n", filename.c_str());
+		return false;
+	}
+
+	// literals are written with an exponent so that they are always
+	// floating point: 1 would be an int, 1f no number at all
+	fprintf(out, "// %s: %u trees, %u nodes, %s\n", name.c_str(),
+		(unsigned int)roots_.size(), (unsigned int)nodes_.size(), grad_ ? "Grad" : "weighted average");
+	fprintf(out, "// weight file hash %016llx\n", hash_);
+	fprintf(out, "// generated by BDTForest::generate, do not edit\n\n");
+	fprintf(out, "#include \"../Core/BDTRegistry.h\"\n\n#include <cmath>\n\n");
+	fprintf(out, "namespace {\n\n");
+
+	fprintf(out, "const char* variables[] = {\n");
+	for (unsigned int j = 0; j < variables_.size(); ++j)
+		fprintf(out, "  %s,\n", quote(variables_[j]).c_str());
+	fprintf(out, "};\n\n");
+
+	for (unsigned int t = 0; t < roots_.size(); ++t) {
+		fprintf(out, "inline float tree%u(const float* x){\n", t);
+		writeNode(out, roots_[t], 1);
+		fprintf(out, "}\n\n");
+	}
+
+	// same terms in the same order as evaluate()
+	fprintf(out, "double evaluate(const float* x){\n  double sum = 0.;\n");
+	for (unsigned int t = 0; t < roots_.size(); ++t) {
+		if (grad_) fprintf(out, "  sum += tree%u(x);\n", t);
+		else fprintf(out, "  sum += %.17e * tree%u(x);\n", boostWeights_[t], t);
+	}
+	if (grad_) fprintf(out, "  return 2.0 / (1.0 + exp(-2.0 * sum)) - 1;\n}\n\n");
+	else if (norm_ > std::numeric_limits<double>::epsilon()) fprintf(out, "  return sum / %.17e;\n}\n\n", norm_);
+	else fprintf(out, "  return 0;\n}\n\n");
+
+	fprintf(out, "void evaluateBatch(const float* x, int n, double* out){\n");
+	fprintf(out, "  for (int k = 0; k < n; ++k) out[k] = evaluate(x + k * %u);\n}\n\n", (unsigned int)variables_.size());
+
+	fprintf(out, "const BDTModel model = { %s, 0x%016llxULL, %u, %u, %u, variables, evaluate, evaluateBatch };\n",
+		quote(name).c_str(), hash_, (unsigned int)roots_.size(), (unsigned int)nodes_.size(),
+		(unsigned int)variables_.size());
+	fprintf(out, "BDTRegistration registration(&model);\n\n}\n");
+
+	bool ok = ferror(out) == 0;
+	fclose(out);
+	if (ok) printf("[BDTForest] wrote %s to %s\n", name.c_str(), filename.c_str());
+	else printf("[BDTForest] error writing %s\n", filename.c_str());
+	return ok;
+}
+
+//--------------------------------------------------------------------
+
+// the compiled model of the weight file if there is one generated from
+// its contents, its forest otherwise; exits if there is neither
+static void findModel(const string& weightfile, const BDTModel*& model, const BDTForest*& forest, vector<string>& variables){
+	forest = 0;
+	model = BDTForest::compiled(weightfile);
+	if (model) {
+		variables.assign(model->variables, model->variables + model->nVariables);
+		printf("[BDTForest] using compiled %s\n", model->name);
+	} else {
+		forest = BDTForest::get(weightfile);
+		if (!forest) exit(1);
+		variables = forest->variables();
+	}
+}
+
+//--------------------------------------------------------------------
+
+BDTReader::BDTReader(int nversions)
+	: debug(false), forest_(0), model_(0), nversions_(nversions), addresses_(nversions)
+{
+}
+
+void BDTReader::addVariable(const string& expression, float* const* addresses){
+	expressions_.push_back(expression);
+	for (int v = 0; v < nversions_; ++v) addresses_[v].push_back(addresses[v]);
+}
+
+void BDTReader::addVariable(const string& expression, float* address){
+	// the same input in every version
+	expressions_.push_back(expression);
+	for (int v = 0; v < nversions_; ++v) addresses_[v].push_back(address);
+}
+
+void BDTReader::book(const string& weightfile){
+
+	vector<string> variables;
+	findModel(weightfile, model_, forest_, variables);
+
+	if (expressions_ != variables) {
+		printf("[BDTReader] the variables do not match those of %s:\n", weightfile.c_str());
+		for (unsigned int j = 0; j < variables.size(); ++j)
+			printf("  %s\n", variables[j].c_str());
+		exit(1);
+	}
+	inputs_.resize(nversions_ * expressions_.size());
+
+	if (debug) {
+		for (int v = 0; v < nversions_; ++v) {
+			TMVA::Reader* reader = new TMVA::Reader("!Color:Silent");
+			for (unsigned int j = 0; j < expressions_.size(); ++j)
+				reader->AddVariable(expressions_[j].c_str(), addresses_[v][j]);
+			reader->BookMVA("BDT", weightfile.c_str());
+			readers_.push_back(reader);
+		}
+	}
+}
+
+void BDTReader::evaluate(double* out){
+
+	const int nvars = expressions_.size();
+	for (int v = 0; v < nversions_; ++v)
+		for (int j = 0; j < nvars; ++j)
+			inputs_[v * nvars + j] = *addresses_[v][j];
+
+	if (model_) model_->evaluateBatch(&inputs_[0], nversions_, out);
+	else forest_->evaluate(&inputs_[0], nversions_, out);
+
+	for (unsigned int v = 0; v < readers_.size(); ++v) {
+		double reference = readers_[v]->EvaluateMVA("BDT");
+		if (out[v] != reference) {
+			printf("[BDTReader] version %u: %.17g, TMVA::Reader gives %.17g\n", v, out[v], reference);
+			exit(1);
+		}
+	}
+}
+
+double BDTReader::evaluate(){
+	vector<double> out(nversions_);
+	evaluate(&out[0]);
+	return out[0];
+}
+
+//--------------------------------------------------------------------
+
+BDTBatch::BDTBatch(int nversions)
+	: debug(false), nversions_(nversions), addresses_(nversions)
+{
+}
+
+void BDTBatch::addVariable(const string& expression, float* const* addresses){
+	if (!models_.empty()) {
+		printf("[BDTBatch] %s: variables must be added before the models\n", expression.c_str());
+		exit(1);
+	}
+	for (unsigned int j = 0; j < expressions_.size(); ++j) {
+		if (expressions_[j] == expression) {
+			printf("[BDTBatch] %s added twice\n", expression.c_str());
+			exit(1);
+		}
+	}
+	expressions_.push_back(expression);
+	for (int v = 0; v < nversions_; ++v) addresses_[v].push_back(addresses[v]);
+}
+
+void BDTBatch::addVariable(const string& expression, float* address){
+	vector<float*> addresses(nversions_, address);
+	addVariable(expression, &addresses[0]);
+}
+
+int BDTBatch::book(const string& weightfile){
+
+	Model m;
+	vector<string> variables;
+	findModel(weightfile, m.compiled, m.forest, variables);
+
+	// where each input of the model is in the feature matrix
+	m.offset = gather_.size();
+	m.nvars = variables.size();
+	vector<int> index(variables.size());
+	for (unsigned int i = 0; i < variables.size(); ++i) {
+		unsigned int j = 0;
+		while (j < expressions_.size() && expressions_[j] != variables[i]) ++j;
+		if (j == expressions_.size()) {
+			printf("[BDTBatch] %s needs %s, which was not added\n", weightfile.c_str(), variables[i].c_str());
+			exit(1);
+		}
+		index[i] = j;
+	}
+	const int nfeatures = expressions_.size();
+	for (int v = 0; v < nversions_; ++v)
+		for (unsigned int i = 0; i < index.size(); ++i)
+			gather_.push_back(v * nfeatures + index[i]);
+
+	if (debug) {
+		for (int v = 0; v < nversions_; ++v) {
+			TMVA::Reader* reader = new TMVA::Reader("!Color:Silent");
+			for (unsigned int i = 0; i < index.size(); ++i)
+				reader->AddVariable(variables[i].c_str(), addresses_[v][index[i]]);
+			reader->BookMVA("BDT", weightfile.c_str());
+			m.readers.push_back(reader);
+		}
+	}
+
+	models_.push_back(m);
+	features_.resize(nversions_ * nfeatures);
+	inputs_.resize(gather_.size());
+	values_.resize(models_.size() * nversions_);
+	return models_.size() - 1;
+}
+
+void BDTBatch::evaluate(){
+
+	// every input of every version once
+	const int nfeatures = expressions_.size();
+	for (int v = 0; v < nversions_; ++v)
+		for (int j = 0; j < nfeatures; ++j)
+			features_[v * nfeatures + j] = *addresses_[v][j];
+
+	// the blocks of all models, then the models
+	for (unsigned int k = 0; k < gather_.size(); ++k) inputs_[k] = features_[gather_[k]];
+	for (unsigned int i = 0; i < models_.size(); ++i) {
+		const Model& m = models_[i];
+		if (m.compiled) m.compiled->evaluateBatch(&inputs_[m.offset], nversions_, &values_[i * nversions_]);
+		else m.forest->evaluate(&inputs_[m.offset], nversions_, &values_[i * nversions_]);
+
+		for (unsigned int v = 0; v < m.readers.size(); ++v) {
+			double reference = m.readers[v]->EvaluateMVA("BDT");
+			if (values_[i * nversions_ + v] != reference) {
+				printf("[BDTBatch] model %u version %u: %.17g, TMVA::Reader gives %.17g\n",
+				       i, v, values_[i * nversions_ + v], reference);
+				exit(1);
+			}
+		}
+	}
+}
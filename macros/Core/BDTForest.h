@@ -0,0 +1,189 @@
+#ifndef BDTFOREST_H
+#define BDTFOREST_H
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TMVA { class Reader; }
+struct BDTModel;
+
+using namespace std;
+
+/* A TMVA BDT read from its XML weight file into flat node arrays.
+ *
+ * The trees of the forest are stored one after the other, each node with
+ * its cut and the indices of its two children, and evaluated the way
+ * MethodBDT does it: AdaBoost, bagging etc. average the leaf values with
+ * the boost weights, Grad maps the sum of the leaf responses to (-1, 1).
+ * Cuts, leaf values and the order of the sums are those of TMVA, so the
+ * values are the ones TMVA::Reader::EvaluateMVA gives.  Input
+ * transformations and Fisher cuts are not supported.
+ *
+ * evaluate() on n input vectors walks each tree for all of them before
+ * going to the next tree.  generate() writes the forest out as C++, one
+ * nested if/else per tree with the cuts as constants, for BDTRegistry;
+ * the model carries the hash of the weight file it was made from, and
+ * compiled() only returns it for a file with the same contents.
+ */
+class BDTForest {
+
+public:
+	// shared forest of a weight file, parsed on first use, never deleted
+	static const BDTForest* get(const string& weightfile);
+
+	const vector<string>& variables() const { return variables_; }
+	int nVariables() const { return variables_.size(); }
+	// training range of a variable, from the weight file
+	float min(int var) const { return min_[var]; }
+	float max(int var) const { return max_[var]; }
+
+	double evaluate(const float* x) const;
+	// n input vectors of nVariables() values each
+	void evaluate(const float* x, int n, double* out) const;
+
+	// C++ source of a BDTModel called name, same values as evaluate()
+	bool generate(const string& name, const string& filename) const;
+
+	// weight file name without directory and .weights.xml
+	static string modelName(const string& weightfile);
+	// FNV-1a of the file contents, 0 if it cannot be read
+	static unsigned long long fileHash(const string& weightfile);
+	// the compiled model generated from this weight file; 0 if there is
+	// none, or if the one of the same name was generated from other contents
+	static const BDTModel* compiled(const string& weightfile);
+
+private:
+	BDTForest() {}
+	bool read(const string& weightfile);
+	void writeNode(FILE* out, int i, int depth) const;
+
+	struct Node {
+		float cut;
+		float value;	// leaf value: node type, purity or response
+		int var;	// -1 for leaves
+		int left, right;
+		bool cutType;	// false: the cut selects the left side
+	};
+
+	vector<string> variables_;
+	vector<float> min_, max_;
+	vector<Node> nodes_;
+	vector<int> roots_;
+	vector<double> boostWeights_;
+	double norm_;
+	bool grad_;
+	unsigned long long hash_;
+
+	static map<string, BDTForest*> forests_;
+};
+
+/* Drop-in for the TMVA::Readers of one BDT that is evaluated for several
+ * versions of its inputs (nominal, JES and b-tag variations, ...).
+ *
+ *   BDTReader* bdt = new BDTReader(3);
+ *   float* met[3] = { &met_, &metup_, &metdown_ };
+ *   bdt->addVariable("mini_met", met);
+ *   ...
+ *   bdt->book(weightfile);
+ *   double vals[3];
+ *   bdt->evaluate(vals);
+ *
+ * The variables must be added in the order of the weight file, like for
+ * TMVA::Reader.  book() uses the compiled model of the same name if there
+ * is one in BDTRegistry, the weight file otherwise.  With debug set before
+ * book(), a TMVA::Reader per version is booked as well and every value is
+ * compared with it.
+ */
+class BDTReader {
+
+public:
+	BDTReader(int nversions = 1);
+
+	// one address per version
+	void addVariable(const string& expression, float* const* addresses);
+	void addVariable(const string& expression, float* address);
+
+	void book(const string& weightfile);
+
+	// out[v] for every version
+	void evaluate(double* out);
+	double evaluate();
+
+	bool debug;
+
+private:
+	const BDTForest* forest_;
+	const BDTModel* model_;
+	int nversions_;
+	vector<string> expressions_;
+	vector< vector<float*> > addresses_;	// [version][variable]
+	vector<float> inputs_;
+	vector<TMVA::Reader*> readers_;
+};
+
+/* All the BDTs of a job, evaluated together on one matrix of inputs.
+ *
+ *   BDTBatch mva(3);
+ *   float* met[3] = { &met_, &metup_, &metdown_ };
+ *   mva.addVariable("mini_met", met);
+ *   ...
+ *   int t2tt = mva.book(weightfile);
+ *   ...
+ *   mva.evaluate();
+ *   const double* vals = mva.values(t2tt);
+ *
+ * Every input is added once, for all models.  book() comes after the
+ * inputs and takes the variables a model needs by expression, in the order
+ * of its weight file; the compiled model is used if there is one, like in
+ * BDTReader.  evaluate() reads every input of every version once into a
+ * [version][variable] matrix, copies out of it the [version][model
+ * variable] block of each model and runs each model on all versions of its
+ * block in one call.  The values are those of BDTReader; with debug set
+ * before book(), each model also gets a TMVA::Reader per version and every
+ * value is compared with it, as in BDTReader.
+ */
+class BDTBatch {
+
+public:
+	BDTBatch(int nversions = 1);
+
+	// one address per version
+	void addVariable(const string& expression, float* const* addresses);
+	void addVariable(const string& expression, float* address);
+
+	// index of the model for values(); exits if it needs an input not added
+	int book(const string& weightfile);
+
+	// all models, all versions
+	void evaluate();
+	// values[v] of the model for every version, after evaluate()
+	const double* values(int model) const { return &values_[model * nversions_]; }
+
+	int nVersions() const { return nversions_; }
+	int nModels() const { return models_.size(); }
+
+	bool debug;
+
+private:
+	struct Model {
+		const BDTForest* forest;
+		const BDTModel* compiled;
+		int offset;	// of the block in inputs_
+		int nvars;
+		vector<TMVA::Reader*> readers;	// one per version, with debug
+	};
+
+	int nversions_;
+	vector<string> expressions_;
+	vector< vector<float*> > addresses_;	// [version][variable]
+	vector<Model> models_;
+	vector<int> gather_;			// index in features_ of every entry of inputs_
+
+	vector<float> features_;		// [version][variable]
+	vector<float> inputs_;			// model blocks, [version][model variable] each
+	vector<double> values_;			// [model][version]
+};
+
+#endif
@@ -0,0 +1,30 @@
+#include "BDTRegistry.h"
+
+#include <cstdio>
+#include <map>
+
+using namespace std;
+
+// built on first use, so registrations from other files' static
+// initializers never see it unconstructed
+static map<string, const BDTModel*>& models(){
+	static map<string, const BDTModel*> m;
+	return m;
+}
+
+void BDTRegistry::add(const BDTModel* model){
+	models()[model->name] = model;
+}
+
+const BDTModel* BDTRegistry::find(const string& name){
+	map<string, const BDTModel*>::const_iterator it = models().find(name);
+	return it == models().end() ? 0 : it->second;
+}
+
+void BDTRegistry::list(){
+	printf("[BDTRegistry] %u compiled models\n", (unsigned int)models().size());
+	map<string, const BDTModel*>::const_iterator it;
+	for (it = models().begin(); it != models().end(); ++it)
+		printf("  %-40s %016llx %4d trees %6d nodes %3d variables\n", it->first.c_str(), it->second->hash,
+		       it->second->nTrees, it->second->nNodes, it->second->nVariables);
+}
@@ -0,0 +1,39 @@
+#ifndef BDTREGISTRY_H
+#define BDTREGISTRY_H
+
+#include <string>
+
+// one compiled BDT, as written by BDTForest::generate
+struct BDTModel {
+	const char* name;		// weight file name without .weights.xml
+	unsigned long long hash;	// BDTForest::fileHash of the weight file
+	int nTrees, nNodes;
+	int nVariables;
+	const char* const* variables;	// expressions, in input order
+	double (*evaluate)(const float* x);
+	// n input vectors of nVariables values each
+	void (*evaluateBatch)(const float* x, int n, double* out);
+};
+
+/* The BDTs compiled into the library, by name.
+ *
+ * Every generated translation unit registers its model from a static
+ * BDTRegistration, so linking the file in is all it takes to make the
+ * model available; BDTReader::book() looks here first (through
+ * BDTForest::compiled, which checks the hash) and falls back to reading
+ * the weight file.
+ */
+class BDTRegistry {
+
+public:
+	static void add(const BDTModel* model);
+	// 0 if no model of that name is compiled in
+	static const BDTModel* find(const std::string& name);
+	static void list();
+};
+
+struct BDTRegistration {
+	BDTRegistration(const BDTModel* model) { BDTRegistry::add(model); }
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include "BTagReshaper.h"
+
+#include "../../Tools/BTagReshaping/BTagReshaping.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+map<string, BTagReshaper*> BTagReshaper::instances_;
+
+// payload shifts (b/c, light) of each variation
+static const float shifts[BTagReshaper::NVARIATIONS][2] = {
+	{  0.0,  0.0 },
+	{  1.0,  0.0 },
+	{ -1.0,  0.0 },
+	{  0.0,  1.0 },
+	{  0.0, -1.0 }
+};
+
+BTagReshaper* BTagReshaper::get(const string& filename){
+	map<string, BTagReshaper*>::iterator it = instances_.find(filename);
+	if (it == instances_.end())
+		it = instances_.insert(make_pair(filename, new BTagReshaper(filename))).first;
+	return it->second;
+}
+
+BTagReshaper::BTagReshaper(const string& filename)
+	: debug(false), filename_(filename)
+{
+	for (int v = 0; v < NVARIATIONS; ++v) shapes_[v] = 0;
+}
+
+BTagShapeInterface* BTagReshaper::shape(Variation v){
+	if (!shapes_[v])
+		shapes_[v] = new BTagShapeInterface(filename_.c_str(), shifts[v][0], shifts[v][1]);
+	return shapes_[v];
+}
+
+//--------------------------------------------------------------------
+
+float BTagReshaper::reshape(float eta, float pt, float csv, int flavour){
+	return shape(NOMINAL)->reshape(eta, pt, csv, flavour);
+}
+
+void BTagReshaper::reshape(float eta, float pt, float csv, int flavour, float csvs[NVARIATIONS]){
+
+	bool bc = abs(flavour) == 5 || abs(flavour) == 4;
+	Variation up   = bc ? UPBC : UPL;
+	Variation down = bc ? DOWNBC : DOWNL;
+
+	for (int v = 0; v < NVARIATIONS; ++v) {
+		if (v == NOMINAL || v == up || v == down)
+			csvs[v] = shape(Variation(v))->reshape(eta, pt, csv, flavour);
+	}
+	for (int v = 0; v < NVARIATIONS; ++v) {
+		if (v != NOMINAL && v != up && v != down)
+			csvs[v] = csvs[NOMINAL];
+	}
+
+	if (debug) {
+		for (int v = 0; v < NVARIATIONS; ++v) {
+			float full = shape(Variation(v))->reshape(eta, pt, csv, flavour);
+			if (full != csvs[v]) {
+				printf("[BTagReshaper] variation %d of a jet with flavour %d: %f instead of %f\n",
+				       v, flavour, csvs[v], full);
+				exit(1);
+			}
+		}
+	}
+}
+
+void BTagReshaper::reshapeJets(const vector<LorentzVector>& jets, const vector<float>& csv,
+			       const vector<int>& flavour, vector<float> csvs[NVARIATIONS]){
+	for (int v = 0; v < NVARIATIONS; ++v) csvs[v].resize(jets.size());
+
+	float jetcsvs[NVARIATIONS];
+	for (unsigned int i = 0; i < jets.size(); ++i) {
+		reshape(jets.at(i).eta(), jets.at(i).pt(), csv.at(i), flavour.at(i), jetcsvs);
+		for (int v = 0; v < NVARIATIONS; ++v) csvs[v][i] = jetcsvs[v];
+	}
+}
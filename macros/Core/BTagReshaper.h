@@ -0,0 +1,57 @@
+#ifndef BTAGRESHAPER_H
+#define BTAGRESHAPER_H
+
+#include "Math/LorentzVector.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class BTagShapeInterface;
+
+using namespace std;
+
+/* CSV discriminator reshaping with all the payload variations in one call.
+ *
+ * The loopers used to build one BTagShapeInterface per variation (nominal,
+ * b/c up and down, light up and down) in every loop(), each parsing
+ * csvdiscr.root again, and to ask all five for every jet.  Here the shapes
+ * of a calibration file are built once per process and shared by every
+ * looper and sample that asks for the same file.
+ *
+ * The b/c payload shift only moves b and c jets and the light shift only
+ * the others, so a jet needs three evaluations (nominal, up and down of its
+ * own flavour); the variations of the other flavour are the nominal value.
+ * The variation shapes are only built when first needed.  Set debug to
+ * evaluate all five shapes for every jet and compare.
+ */
+class BTagReshaper {
+	typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
+
+public:
+	enum Variation { NOMINAL, UPBC, DOWNBC, UPL, DOWNL, NVARIATIONS };
+
+	// shared instance for a calibration file, never deleted
+	static BTagReshaper* get(const string& filename = "../../Tools/BTagReshaping/csvdiscr.root");
+
+	float reshape(float eta, float pt, float csv, int flavour);
+	// csvs[v] for every variation; flavour as in pfjets_mcflavorAlgo
+	void reshape(float eta, float pt, float csv, int flavour, float csvs[NVARIATIONS]);
+	// all jets of an event: csvs[v][i] for jet i
+	void reshapeJets(const vector<LorentzVector>& jets, const vector<float>& csv,
+			 const vector<int>& flavour, vector<float> csvs[NVARIATIONS]);
+
+	bool debug;
+
+private:
+	BTagReshaper(const string& filename);
+
+	BTagShapeInterface* shape(Variation v);
+
+	string filename_;
+	BTagShapeInterface* shapes_[NVARIATIONS];
+
+	static map<string, BTagReshaper*> instances_;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#include "BinnedTable.h"
+
+#include "TAxis.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TTree.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+//--------------------------------------------------------------------
+
+BinnedAxis::BinnedAxis()
+	: n_(0), min_(0.), max_(0.)
+{
+}
+
+BinnedAxis::BinnedAxis(const TAxis* axis)
+	: n_(axis->GetNbins()), min_(axis->GetXmin()), max_(axis->GetXmax())
+{
+	const TArrayD* edges = axis->GetXbins();
+	if (edges->GetSize()) edges_.assign(edges->GetArray(), edges->GetArray() + edges->GetSize());
+}
+
+//--------------------------------------------------------------------
+
+BinnedTable::BinnedTable()
+	: ny_(0)
+{
+}
+
+BinnedTable::BinnedTable(const TH1* h)
+	: x_(h->GetXaxis()), ny_(0)
+{
+	if (h->GetDimension() == 2) {
+		y_ = BinnedAxis(h->GetYaxis());
+		ny_ = y_.n_;
+	} else if (h->GetDimension() != 1) {
+		printf("[BinnedTable] %s: only TH1 and TH2\n", h->GetName());
+		return;
+	}
+	int nbins = (x_.n_ + 2) * (ny_ ? ny_ + 2 : 1);
+	content_.resize(nbins);
+	error_.resize(nbins);
+	for (int b = 0; b < nbins; ++b) {
+		content_[b] = h->GetBinContent(b);
+		error_[b] = h->GetBinError(b);
+	}
+}
+
+BinnedTable BinnedTable::load(const string& filename, const string& histname){
+	BinnedTable table;
+	TDirectory* old = gDirectory;
+	TFile* file = TFile::Open(filename.c_str());
+	TObject* obj = file ? file->Get(histname.c_str()) : 0;
+	if (obj && obj->InheritsFrom("TH1")) table = BinnedTable((TH1*)obj);
+	else if (obj && obj->InheritsFrom("TTree")) table.read(file, histname.c_str());
+	if (table.empty()) printf("[BinnedTable] no %s in %s\n", histname.c_str(), filename.c_str());
+	delete file;
+	old->cd();
+	return table;
+}
+
+void BinnedTable::emptyLookup() const {
+	printf("[BinnedTable] lookup in an empty table, its histogram was not loaded\n");
+	exit(1);
+}
+
+//--------------------------------------------------------------------
+
+void BinnedTable::write(TDirectory* dir, const char* name) const {
+	TDirectory* old = gDirectory;
+	dir->cd();
+
+	// uniform axes have no edges; min and max are kept as ROOT has them
+	int nx = x_.n_, ny = ny_;
+	double xmin = x_.min_, xmax = x_.max_, ymin = y_.min_, ymax = y_.max_;
+	vector<double> xedges = x_.edges_, yedges = y_.edges_;
+	vector<double> content = content_, error = error_;
+	vector<double>* pxedges = &xedges;
+	vector<double>* pyedges = &yedges;
+	vector<double>* pcontent = &content;
+	vector<double>* perror = &error;
+
+	TTree* t = new TTree(name, "BinnedTable");
+	t->Branch("nx", &nx, "nx/I");
+	t->Branch("xmin", &xmin, "xmin/D");
+	t->Branch("xmax", &xmax, "xmax/D");
+	t->Branch("xedges", &pxedges);
+	t->Branch("ny", &ny, "ny/I");
+	t->Branch("ymin", &ymin, "ymin/D");
+	t->Branch("ymax", &ymax, "ymax/D");
+	t->Branch("yedges", &pyedges);
+	t->Branch("content", &pcontent);
+	t->Branch("error", &perror);
+	t->Fill();
+	t->Write();
+	delete t;
+	old->cd();
+}
+
+bool BinnedTable::read(TDirectory* dir, const char* name){
+	TTree* t = dir ? (TTree*)dir->Get(name) : 0;
+	if (!t || t->GetEntries() != 1) return false;
+
+	vector<double>* xedges = 0;
+	vector<double>* yedges = 0;
+	vector<double>* content = 0;
+	vector<double>* error = 0;
+	t->SetBranchAddress("nx", &x_.n_);
+	t->SetBranchAddress("xmin", &x_.min_);
+	t->SetBranchAddress("xmax", &x_.max_);
+	t->SetBranchAddress("xedges", &xedges);
+	t->SetBranchAddress("ny", &ny_);
+	t->SetBranchAddress("ymin", &y_.min_);
+	t->SetBranchAddress("ymax", &y_.max_);
+	t->SetBranchAddress("yedges", &yedges);
+	t->SetBranchAddress("content", &content);
+	t->SetBranchAddress("error", &error);
+	t->GetEntry(0);
+	t->ResetBranchAddresses();
+
+	y_.n_ = ny_;
+	x_.edges_ = *xedges;
+	y_.edges_ = *yedges;
+	content_ = *content;
+	error_ = *error;
+	delete xedges;
+	delete yedges;
+	delete content;
+	delete error;
+	return true;
+}
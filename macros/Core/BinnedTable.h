@@ -0,0 +1,100 @@
+#ifndef BINNEDTABLE_H
+#define BINNEDTABLE_H
+
+#include <string>
+#include <vector>
+
+class TAxis;
+class TDirectory;
+class TH1;
+
+using namespace std;
+
+// one axis of a BinnedTable, bins numbered like TAxis: 0 underflow,
+// 1..n, n+1 overflow
+class BinnedAxis {
+
+public:
+	BinnedAxis();
+	BinnedAxis(const TAxis* axis);
+
+	// same bin as TAxis::FindFixBin
+	int find(double x) const;
+
+	int nBins() const { return n_; }
+	double min() const { return min_; }
+	double max() const { return max_; }
+	bool uniform() const { return edges_.empty(); }
+
+private:
+	friend class BinnedTable;
+
+	int n_;
+	double min_, max_;
+	vector<double> edges_;	// empty for uniform bins
+};
+
+/* A TH1 or TH2 copied into a flat array of bin contents and errors, for
+ * the per-event lookups of cross sections, generated events and scale
+ * factors.
+ *
+ * A lookup is one axis search per dimension, a multiply for uniform bins
+ * and a binary search on the edges otherwise, and one array access; bins
+ * and values are those of GetBinContent(FindBin(x, y)).  The table does
+ * not change after it is made, so one table can be read from any number
+ * of threads.  write() stores it as a one-entry tree; load() takes either
+ * that or the histogram itself, so a file of snapshots can stand in for
+ * the histogram files.
+ */
+class BinnedTable {
+
+public:
+	BinnedTable();
+	BinnedTable(const TH1* h);
+
+	// histname from filename, a histogram or a table written by write();
+	// an empty table if there is neither
+	static BinnedTable load(const string& filename, const string& histname);
+
+	bool empty() const { return content_.empty(); }
+	int dimension() const { return ny_ ? 2 : 1; }
+	const BinnedAxis& xaxis() const { return x_; }
+	const BinnedAxis& yaxis() const { return y_; }
+
+	int bin(double x, double y = 0.) const {
+		int b = x_.find(x);
+		if (ny_) b += (x_.n_ + 2) * y_.find(y);
+		return b;
+	}
+	// these exit on an empty table, which has no bins to look up
+	double content(int bin) const { check(); return content_[bin]; }
+	double error(int bin) const { check(); return error_[bin]; }
+	double value(double x, double y = 0.) const { check(); return content_[bin(x, y)]; }
+
+	void write(TDirectory* dir, const char* name) const;
+	bool read(TDirectory* dir, const char* name);
+
+private:
+	void check() const { if (content_.empty()) emptyLookup(); }
+	void emptyLookup() const;
+
+	BinnedAxis x_, y_;
+	int ny_;	// 0 for a TH1
+	vector<double> content_, error_;	// [binx + (nx+2)*biny]
+};
+
+inline int BinnedAxis::find(double x) const {
+	if (x < min_) return 0;
+	if (!(x < max_)) return n_ + 1;
+	if (edges_.empty()) return 1 + int(n_ * (x - min_) / (max_ - min_));
+	// first edge above x; the edges are 0..n, so that is the bin
+	int lo = 0, hi = n_;
+	while (hi - lo > 1) {
+		int mid = (lo + hi) / 2;
+		if (edges_[mid] <= x) lo = mid;
+		else hi = mid;
+	}
+	return hi;
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "CutScan.h"
+
+#include "TMath.h"
+#include "TTreeFormula.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+//--------------------------------------------------------------------
+
+CutScan::CutScan(const vector<double>& thresholds)
+	: thresholds_(thresholds), bins_(thresholds.size() + 1, 0.), dirty_(true)
+{
+}
+
+void CutScan::fill(double value, double weight){
+	// number of thresholds strictly below the value
+	int b = lower_bound(thresholds_.begin(), thresholds_.end(), value) - thresholds_.begin();
+	bins_[b] += weight;
+	dirty_ = true;
+}
+
+double CutScan::yield(int k) const {
+	if (dirty_) {
+		above_.assign(thresholds_.size(), 0.);
+		double sum = 0.;
+		for (int b = thresholds_.size(); b > 0; --b) {
+			sum += bins_[b];
+			above_[b-1] = sum;
+		}
+		dirty_ = false;
+	}
+	return above_[k];
+}
+
+double CutScan::total() const {
+	double sum = 0.;
+	for (unsigned int b = 0; b < bins_.size(); ++b) sum += bins_[b];
+	return sum;
+}
+
+//--------------------------------------------------------------------
+
+ChainScan::ChainScan(TChain* chain, const char* selection, const char* weight)
+	: chain_(chain), selection_(0), weightFormula_(0), weight_(0.), entry_(-1), tree_(-1)
+{
+	// an empty chain has no tree to compile the formulas against
+	nentries_ = chain_->GetEntries();
+	if (nentries_ == 0) return;
+	chain_->LoadTree(0);
+	selection_ = formula(selection);
+	weightFormula_ = formula(weight);
+}
+
+ChainScan::~ChainScan(){
+	delete selection_;
+	delete weightFormula_;
+	for (unsigned int i = 0; i < variables_.size(); ++i) delete variables_[i];
+}
+
+TTreeFormula* ChainScan::formula(const char* expression){
+	if (nentries_ == 0) return 0;
+	TTreeFormula* f = new TTreeFormula(Form("scan%u", (unsigned int)variables_.size()), expression, chain_);
+	if (f->GetNdim() == 0) {
+		printf("[ChainScan] cannot compile %s\n", expression);
+		exit(1);
+	}
+	return f;
+}
+
+int ChainScan::addVariable(const char* expression){
+	variables_.push_back(formula(expression));
+	values_.push_back(0.);
+	return variables_.size() - 1;
+}
+
+double ChainScan::eval(TTreeFormula* formula){
+	if (formula->GetNdata() == 0) return TMath::QuietNaN();
+	return formula->EvalInstance(0);
+}
+
+bool ChainScan::next(){
+	while (++entry_ < nentries_) {
+		if (chain_->LoadTree(entry_) < 0) return false;
+		if (chain_->GetTreeNumber() != tree_) {
+			// new file: the formulas must find their leaves again
+			tree_ = chain_->GetTreeNumber();
+			selection_->UpdateFormulaLeaves();
+			weightFormula_->UpdateFormulaLeaves();
+			for (unsigned int i = 0; i < variables_.size(); ++i) variables_[i]->UpdateFormulaLeaves();
+		}
+		if (selection_->GetNdata() == 0 || selection_->EvalInstance(0) == 0) continue;
+
+		weight_ = eval(weightFormula_);
+		for (unsigned int i = 0; i < variables_.size(); ++i) values_[i] = eval(variables_[i]);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,81 @@
+#ifndef CUTSCAN_H
+#define CUTSCAN_H
+
+#include "TChain.h"
+
+#include <vector>
+
+class TTreeFormula;
+
+using namespace std;
+
+/* Weighted yields above every threshold of a scan, from one pass.
+ *
+ * fill() puts the weight in the bin between the two thresholds around the
+ * value, yield(k) is the sum of the bins above threshold k, so a scan of
+ * any number of steps costs one binary search per entry instead of one
+ * TTree::Draw per step.  Cuts are strict, value > threshold, like
+ * "mini_bdt[1] > 0.2"; NaN passes none.
+ */
+class CutScan {
+
+public:
+	// in increasing order
+	CutScan(const vector<double>& thresholds);
+
+	void fill(double value, double weight);
+
+	int nThresholds() const { return thresholds_.size(); }
+	double threshold(int k) const { return thresholds_[k]; }
+	// sum of the weights with value > threshold(k)
+	double yield(int k) const;
+	// sum of all weights, including those below the first threshold
+	double total() const;
+
+private:
+	vector<double> thresholds_;
+	vector<double> bins_;	// bins_[b]: b thresholds below the value
+	mutable vector<double> above_;
+	mutable bool dirty_;
+};
+
+/* The entries of a chain passing a selection, with the values of a few
+ * expressions, in one pass.
+ *
+ *   ChainScan scan(ch, sel.GetTitle(), "mini_weight");
+ *   int bdt = scan.addVariable("mini_bdt[1]");
+ *   while (scan.next()) yields.fill(scan.value(bdt), scan.weight());
+ *
+ * Selection and expressions are TTree::Draw formulas; an expression with
+ * no value for an entry (index out of range) gives NaN.
+ */
+class ChainScan {
+
+public:
+	ChainScan(TChain* chain, const char* selection, const char* weight = "1");
+	~ChainScan();
+
+	int addVariable(const char* expression);
+
+	// next entry that passes the selection, false at the end of the chain
+	bool next();
+
+	double value(int var) const { return values_[var]; }
+	double weight() const { return weight_; }
+	Long64_t entry() const { return entry_; }
+
+private:
+	TTreeFormula* formula(const char* expression);
+	static double eval(TTreeFormula* formula);
+
+	TChain* chain_;
+	TTreeFormula* selection_;
+	TTreeFormula* weightFormula_;
+	vector<TTreeFormula*> variables_;
+	vector<double> values_;
+	double weight_;
+	Long64_t entry_, nentries_;
+	int tree_;
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "Cutflow.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+Cutflow::Cutflow(const string& name)
+	: name_(name), adaptEvery_(0), nReorders_(0), nEvents_(0), sumwEvents_(0.)
+{
+}
+
+void Cutflow::add(const string& name, Cut cut, float cost, int block){
+	assert(cut && cost > 0.);
+	assert(steps_.empty() || block >= steps_.back().block);
+
+	Step step;
+	step.name = name;
+	step.cut = cut;
+	step.cost = cost;
+	step.block = block;
+	step.nTested = 0;
+	step.nPassed = 0;
+	steps_.push_back(step);
+	order_.push_back(steps_.size() - 1);
+	nPassedAt_.push_back(0);
+	sumwPassedAt_.push_back(0.);
+}
+
+void Cutflow::add(const Cutflow& other){
+	int offset = steps_.empty() ? 0 : steps_.back().block + 1;
+	for (unsigned int i = 0; i < other.order_.size(); ++i) {
+		const Step& step = other.steps_[other.order_[i]];
+		add(step.name, step.cut, step.cost, step.block + offset);
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool Cutflow::pass(bool isData, double weight){
+	++nEvents_;
+	sumwEvents_ += weight;
+
+	bool passed = true;
+	for (unsigned int i = 0; i < order_.size(); ++i) {
+		Step& step = steps_[order_[i]];
+		++step.nTested;
+		if (!step.cut(isData)) { passed = false; break; }
+		++step.nPassed;
+		++nPassedAt_[i];
+		sumwPassedAt_[i] += weight;
+	}
+
+	if (adaptEvery_ && nEvents_ % adaptEvery_ == 0) reorder();
+	return passed;
+}
+
+bool Cutflow::test(bool isData) const {
+	for (unsigned int i = 0; i < order_.size(); ++i)
+		if (!steps_[order_[i]].cut(isData)) return false;
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+namespace {
+	struct ByRejectionPerCost {
+		const vector<double>* score;
+		bool operator()(int a, int b) const { return (*score)[a] > (*score)[b]; }
+	};
+}
+
+void Cutflow::reorder(){
+	// rejection of each step among the events that reached it; a step that
+	// was never reached counts as rejecting half
+	vector<double> score(steps_.size());
+	for (unsigned int s = 0; s < steps_.size(); ++s) {
+		const Step& step = steps_[s];
+		double rejection = (step.nTested - step.nPassed + 1.) / (step.nTested + 2.);
+		score[s] = rejection / step.cost;
+	}
+
+	ByRejectionPerCost cmp;
+	cmp.score = &score;
+	vector<int> before = order_;
+	unsigned int begin = 0;
+	while (begin < order_.size()) {
+		unsigned int end = begin;
+		while (end < order_.size() && steps_[order_[end]].block == steps_[order_[begin]].block) ++end;
+		std::stable_sort(order_.begin() + begin, order_.begin() + end, cmp);
+		begin = end;
+	}
+	if (order_ != before) ++nReorders_;
+}
+
+//--------------------------------------------------------------------
+
+void Cutflow::print(FILE* out) const {
+	fprintf(out, "[Cutflow] %s: %llu events", name_.c_str(), nEvents_);
+	if (adaptEvery_) fprintf(out, ", adaptive order (%u changes)", nReorders_);
+	fprintf(out, "\n");
+	fprintf(out, "|  %-24s  | %12s | %14s | %8s | %5s |\n", "step", "events", "weighted", "pass", "cost");
+	fprintf(out, "|  %-24s  | %12llu | %14.3f | %8s | %5s |\n", "all", nEvents_, sumwEvents_, "", "");
+
+	for (unsigned int i = 0; i < order_.size(); ++i) {
+		const Step& step = steps_[order_[i]];
+		double rate = step.nTested ? double(step.nPassed) / step.nTested : 0.;
+		bool blockEnd = (i + 1 == order_.size()) || (steps_[order_[i + 1]].block != step.block);
+		if (blockEnd || nReorders_ == 0)
+			fprintf(out, "|  %-24s  | %12llu | %14.3f | %8.4f | %5.1f |\n",
+			        step.name.c_str(), nPassedAt_[i], sumwPassedAt_[i], rate, step.cost);
+		else
+			fprintf(out, "|  %-24s  | %12s | %14s | %8.4f | %5.1f |\n",
+			        step.name.c_str(), "", "", rate, step.cost);
+	}
+}
@@ -0,0 +1,86 @@
+#ifndef CUTFLOW_H
+#define CUTFLOW_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* A selection written as a list of named steps.
+ *
+ * pass() evaluates the steps in order, stops at the first one that fails
+ * and counts the event (and its weight) in every step it got through, so
+ * the cutflow table of the selection comes out of the same single pass
+ * that makes the decision.  test() gives the decision without counting.
+ *
+ * Each step has a relative cost (roughly the number of branches it reads)
+ * and a block number.  Steps of a block may only rely on steps of earlier
+ * blocks (e.g. "lepton pt" needs "ngoodlep >= 1"), so the steps inside a
+ * block can be evaluated in any order.  With setAdaptive(n) the steps of
+ * each block are re-sorted every n events by measured rejection per cost,
+ * which makes the cheap, tight cuts go first.  The decision does not
+ * depend on the order, and neither do the cumulative counts after the last
+ * step of each block.  Once the order has changed, the cumulative counts
+ * inside a block are not printed, only the pass rate of each step among
+ * the events that reached it.
+ */
+class Cutflow {
+
+public:
+	typedef bool (*Cut)(bool isData);
+
+	Cutflow(const string& name);
+
+	// blocks must be added in increasing order
+	void add(const string& name, Cut cut, float cost = 1., int block = 0);
+	// appends the steps of another selection, after our last block
+	void add(const Cutflow& other);
+
+	bool pass(bool isData, double weight = 1.);
+	bool test(bool isData) const;
+
+	// 0 keeps the order of declaration
+	void setAdaptive(unsigned int nevents) { adaptEvery_ = nevents; }
+
+	// table in the |  name  | ... | format of the yield macros
+	void print(FILE* out = stdout) const;
+
+	const string& name() const { return name_; }
+	int nSteps() const { return steps_.size(); }
+
+	// the i-th step in evaluation order and the events (and weights) that
+	// got through it; inside a block these depend on the order, see above
+	const string& stepName(int i) const { return steps_[order_[i]].name; }
+	int stepBlock(int i) const { return steps_[order_[i]].block; }
+	unsigned long long nPassed(int i) const { return nPassedAt_[i]; }
+	double sumwPassed(int i) const { return sumwPassedAt_[i]; }
+	unsigned long long nEvents() const { return nEvents_; }
+	double sumwEvents() const { return sumwEvents_; }
+	unsigned int nReorders() const { return nReorders_; }
+
+private:
+	struct Step {
+		string name;
+		Cut cut;
+		float cost;
+		int block;
+		// among the events that reached the step
+		unsigned long long nTested, nPassed;
+	};
+
+	void reorder();
+
+	string name_;
+	vector<Step> steps_;
+	vector<int> order_;		// evaluation order, indices into steps_
+	vector<unsigned long long> nPassedAt_;	// [position in order_], cumulative
+	vector<double> sumwPassedAt_;
+
+	unsigned int adaptEvery_;
+	unsigned int nReorders_;
+	unsigned long long nEvents_;
+	double sumwEvents_;
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include "MassDB.h"
+
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <cstdio>
+
+//--------------------------------------------------------------------
+
+MassDB::MassDB(const vector<string>& sums)
+	: sums_(sums)
+{
+}
+
+vector<double>& MassDB::row(const MassPoint& point){
+	vector<double>& r = points_[point];
+	r.resize(sums_.size() + 1, 0.);
+	return r;
+}
+
+int MassDB::column(const string& name){
+	for (unsigned int k = 0; k < sums_.size(); ++k)
+		if (sums_[k] == name) return k + 1;
+	// a sum only the other table has: zero for the points we have so far
+	sums_.push_back(name);
+	map<MassPoint, vector<double> >::iterator it;
+	for (it = points_.begin(); it != points_.end(); ++it) it->second.resize(sums_.size() + 1, 0.);
+	return sums_.size();
+}
+
+void MassDB::fill(const MassPoint& point, double weight, const double* sums){
+	vector<double>& r = row(point);
+	r[0] += weight;
+	for (unsigned int k = 0; sums && k < sums_.size(); ++k) r[k+1] += sums[k];
+}
+
+void MassDB::add(const MassDB& other){
+	vector<int> columns;
+	columns.push_back(0);
+	for (unsigned int k = 0; k < other.sums_.size(); ++k) columns.push_back(column(other.sums_[k]));
+
+	map<MassPoint, vector<double> >::const_iterator it;
+	for (it = other.points_.begin(); it != other.points_.end(); ++it) {
+		vector<double>& r = row(it->first);
+		for (unsigned int k = 0; k < columns.size(); ++k) r[columns[k]] += it->second[k];
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool MassDB::read(TFile* file){
+	TTree* t = file ? (TTree*)file->Get("massdb") : 0;
+	if (!t) return false;
+
+	MassPoint point;
+	double nevents;
+	t->SetBranchAddress("mg", &point.mg);
+	t->SetBranchAddress("ml", &point.ml);
+	t->SetBranchAddress("x", &point.x);
+	t->SetBranchAddress("nevents", &nevents);
+
+	// every other branch is a weight sum
+	vector<string> names;
+	TObjArray* branches = t->GetListOfBranches();
+	for (int i = 0; i < branches->GetEntries(); ++i) {
+		string name = branches->At(i)->GetName();
+		if (name != "mg" && name != "ml" && name != "x" && name != "nevents") names.push_back(name);
+	}
+	vector<int> columns(names.size());
+	vector<double> sums(names.size());
+	for (unsigned int k = 0; k < names.size(); ++k) {
+		columns[k] = column(names[k]);
+		t->SetBranchAddress(names[k].c_str(), &sums[k]);
+	}
+
+	for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+		t->GetEntry(i);
+		vector<double>& r = row(point);
+		r[0] += nevents;
+		for (unsigned int k = 0; k < columns.size(); ++k) r[columns[k]] += sums[k];
+	}
+	t->ResetBranchAddresses();
+	return true;
+}
+
+int MassDB::read(TChain* chain){
+	int nfound = 0;
+	TIter fileIter(chain->GetListOfFiles());
+	while (TChainElement* element = (TChainElement*)fileIter.Next()) {
+		TFile* file = TFile::Open(element->GetTitle());
+		if (read(file)) ++nfound;
+		delete file;
+	}
+	if (nfound) printf("[MassDB] %d points from %d files\n", nPoints(), nfound);
+	return nfound;
+}
+
+void MassDB::write(TDirectory* dir) const {
+	TDirectory* old = gDirectory;
+	dir->cd();
+
+	MassPoint point;
+	double nevents;
+	vector<double> sums(sums_.size());
+	TTree* t = new TTree("massdb", "generated events per mass point");
+	t->Branch("mg", &point.mg, "mg/F");
+	t->Branch("ml", &point.ml, "ml/F");
+	t->Branch("x", &point.x, "x/F");
+	t->Branch("nevents", &nevents, "nevents/D");
+	for (unsigned int k = 0; k < sums_.size(); ++k)
+		t->Branch(sums_[k].c_str(), &sums[k], (sums_[k] + "/D").c_str());
+
+	map<MassPoint, vector<double> >::const_iterator it;
+	for (it = points_.begin(); it != points_.end(); ++it) {
+		point = it->first;
+		nevents = it->second[0];
+		for (unsigned int k = 0; k < sums_.size(); ++k) sums[k] = it->second[k+1];
+		t->Fill();
+	}
+	t->Write();
+	delete t;
+	old->cd();
+}
+
+//--------------------------------------------------------------------
+
+double MassDB::nevents(const MassPoint& point) const {
+	map<MassPoint, vector<double> >::const_iterator it = points_.find(point);
+	return it == points_.end() ? 0. : it->second[0];
+}
+
+double MassDB::sum(const MassPoint& point, const string& name) const {
+	map<MassPoint, vector<double> >::const_iterator it = points_.find(point);
+	if (it == points_.end()) return 0.;
+	for (unsigned int k = 0; k < sums_.size(); ++k)
+		if (sums_[k] == name) return it->second[k+1];
+	return 0.;
+}
+
+void MassDB::sums(const MassPoint& point, vector<double>& values) const {
+	values.assign(sums_.size(), 0.);
+	map<MassPoint, vector<double> >::const_iterator it = points_.find(point);
+	if (it == points_.end()) return;
+	for (unsigned int k = 0; k < sums_.size(); ++k) values[k] = it->second[k+1];
+}
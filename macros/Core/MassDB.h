@@ -0,0 +1,60 @@
+#ifndef MASSDB_H
+#define MASSDB_H
+
+#include "MassIndex.h"
+
+#include "TChain.h"
+#include "TDirectory.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* Generated events per mass point of a signal scan, with sums of event
+ * weights (top polarization, chirality) per point next to the count.
+ *
+ * The baby maker fills one entry per generated event and writes the table
+ * as a tree "massdb" (one row per point) into its output; the tables of
+ * several jobs add up, whether they are read file by file, from a chain or
+ * from hadd-ed files with repeated points.  The minibaby maker takes the
+ * normalization of its input babies from there instead of the myMassDB
+ * files.
+ */
+class MassDB {
+
+public:
+	// names of the weight sums kept per point
+	MassDB(const vector<string>& sums = vector<string>());
+
+	// sums[k] for the weight sums, in the order of the names
+	void fill(const MassPoint& point, double weight = 1., const double* sums = 0);
+	void add(const MassDB& other);
+
+	// adds the table of the file, false if it has none
+	bool read(TFile* file);
+	// adds the tables of all files of the chain, returns the number found
+	int read(TChain* chain);
+	void write(TDirectory* dir) const;
+
+	bool empty() const { return points_.empty(); }
+	int nPoints() const { return points_.size(); }
+	const vector<string>& sumNames() const { return sums_; }
+
+	// 0 for unknown points
+	double nevents(const MassPoint& point) const;
+	double sum(const MassPoint& point, const string& name) const;
+	// all sums of the point, in the order of sumNames(); zeros for unknown points
+	void sums(const MassPoint& point, vector<double>& values) const;
+
+private:
+	// [0]: events, [1+k]: sum k
+	vector<double>& row(const MassPoint& point);
+	int column(const string& name);
+
+	vector<string> sums_;
+	map<MassPoint, vector<double> > points_;
+};
+
+#endif
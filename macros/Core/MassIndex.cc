@@ -0,0 +1,113 @@
+#include "MassIndex.h"
+
+#include "TKey.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+
+//--------------------------------------------------------------------
+
+MassIndex::MassIndex(TFile* file){
+	TTree* index = file ? (TTree*)file->Get("massindex") : 0;
+	if (!index) return;
+
+	MassRange r;
+	index->SetBranchAddress("mg", &r.point.mg);
+	index->SetBranchAddress("ml", &r.point.ml);
+	index->SetBranchAddress("x", &r.point.x);
+	index->SetBranchAddress("first", &r.first);
+	index->SetBranchAddress("n", &r.n);
+	index->SetBranchAddress("ngen", &r.ngen);
+	for (Long64_t i = 0; i < index->GetEntries(); ++i) {
+		index->GetEntry(i);
+		ranges_.push_back(r);
+	}
+	index->ResetBranchAddresses();
+}
+
+namespace {
+	bool pointLess(const MassRange& r, const MassPoint& p) { return r.point < p; }
+}
+
+const MassRange* MassIndex::find(float mg, float ml, float x) const {
+	MassPoint p = { mg, ml, x };
+	vector<MassRange>::const_iterator it = lower_bound(ranges_.begin(), ranges_.end(), p, pointLess);
+	if (it == ranges_.end() || p < it->point) return 0;
+	return &*it;
+}
+
+//--------------------------------------------------------------------
+
+bool MassIndex::cluster(const char* filename, const vector<MassPoint>& points, const vector<int>& ngen){
+
+	TFile* in = TFile::Open(filename);
+	TTree* t = in ? (TTree*)in->Get("t") : 0;
+	if (!t || t->GetEntries() != (Long64_t)points.size()) {
+		printf("[MassIndex] %s: no tree or not %u entries, not clustered\n", filename, (unsigned int)points.size());
+		delete in;
+		return false;
+	}
+
+	// entries of each point, in their original order
+	map<MassPoint, vector<Long64_t> > entries;
+	map<MassPoint, int> generated;
+	for (unsigned int i = 0; i < points.size(); ++i) {
+		entries[points[i]].push_back(i);
+		generated[points[i]] = ngen[i];
+	}
+
+	string tmpname = string(filename) + ".clustering";
+	TFile* out = new TFile(tmpname.c_str(), "RECREATE");
+	TTree* sorted = t->CloneTree(0);
+
+	MassRange r;
+	TTree* index = new TTree("massindex", "entry ranges of the mass points");
+	index->Branch("mg", &r.point.mg, "mg/F");
+	index->Branch("ml", &r.point.ml, "ml/F");
+	index->Branch("x", &r.point.x, "x/F");
+	index->Branch("first", &r.first, "first/L");
+	index->Branch("n", &r.n, "n/L");
+	index->Branch("ngen", &r.ngen, "ngen/I");
+
+	map<MassPoint, vector<Long64_t> >::const_iterator it;
+	for (it = entries.begin(); it != entries.end(); ++it) {
+		r.point = it->first;
+		r.first = sorted->GetEntries();
+		r.n = it->second.size();
+		r.ngen = generated[it->first];
+		for (unsigned int k = 0; k < it->second.size(); ++k) {
+			t->GetEntry(it->second[k]);
+			sorted->Fill();
+		}
+		index->Fill();
+	}
+
+	out->cd();
+	sorted->Write();
+	index->Write();
+
+	// anything else the baby holds (the massdb table) goes along as it is
+	TIter keys(in->GetListOfKeys());
+	while (TKey* key = (TKey*)keys.Next()) {
+		string keyname = key->GetName();
+		if (keyname == "t" || keyname == "massindex" || string(key->GetClassName()) != "TTree") continue;
+		TTree* other = (TTree*)in->Get(keyname.c_str());
+		out->cd();
+		other->CloneTree(-1, "fast")->Write();
+	}
+	out->Close();
+	delete out;
+	in->Close();
+	delete in;
+
+	if (gSystem->Rename(tmpname.c_str(), filename) != 0) {
+		printf("[MassIndex] cannot move %s to %s\n", tmpname.c_str(), filename);
+		return false;
+	}
+	printf("[MassIndex] %s: %u entries in %u mass points\n", filename, (unsigned int)points.size(), (unsigned int)entries.size());
+	return true;
+}
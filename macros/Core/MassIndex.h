@@ -0,0 +1,58 @@
+#ifndef MASSINDEX_H
+#define MASSINDEX_H
+
+#include "TFile.h"
+
+#include <vector>
+
+using namespace std;
+
+// a signal model point: stop or chargino mass, LSP mass and the T2bw x
+// (-1 if the scan has none); pMSSM points have the model number in mg
+struct MassPoint {
+	float mg, ml, x;
+	bool operator<(const MassPoint& other) const {
+		if (mg != other.mg) return mg < other.mg;
+		if (ml != other.ml) return ml < other.ml;
+		return x < other.x;
+	}
+};
+
+// the entries of one point in a clustered minibaby
+struct MassRange {
+	MassPoint point;
+	Long64_t first, n;
+	int ngen;	// generated events, as used for the normalization
+};
+
+/* Minibabies of signal scans with the events of each mass point stored
+ * together, and the entry range of every point in a tree "massindex".
+ *
+ * cluster() rewrites the tree "t" of a finished minibaby in point order
+ * (keeping the order of the events inside a point) and adds the index;
+ * the reader side then reads one point without going through the others:
+ *
+ *   MassIndex index(file);
+ *   const MassRange* r = index.find(500, 100);
+ *   t->Draw("mini_met", "mini_weight", "", r->n, r->first);
+ *
+ * Trees without an index give an empty MassIndex.
+ */
+class MassIndex {
+
+public:
+	MassIndex(TFile* file);
+
+	// points[i], ngen[i]: point and generated events of entry i of the tree
+	static bool cluster(const char* filename, const vector<MassPoint>& points, const vector<int>& ngen);
+
+	bool empty() const { return ranges_.empty(); }
+	const vector<MassRange>& ranges() const { return ranges_; }
+	// 0 if the point is not in the file
+	const MassRange* find(float mg, float ml, float x = -1) const;
+
+private:
+	vector<MassRange> ranges_;	// in point order
+};
+
+#endif
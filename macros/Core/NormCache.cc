@@ -0,0 +1,41 @@
+#include "NormCache.h"
+
+#include <cstdio>
+
+//--------------------------------------------------------------------
+
+NormCache::NormCache(const string& name)
+	: name_(name), last_(0), nCalls_(0), nLast_(0), nMap_(0)
+{
+}
+
+bool NormCache::same(const MassPoint& a, const MassPoint& b){
+	return a.mg == b.mg && a.ml == b.ml && a.x == b.x;
+}
+
+PointNorm* NormCache::find(const MassPoint& point){
+	++nCalls_;
+	if (last_ && same(point, lastPoint_)) {
+		++nLast_;
+		return last_;
+	}
+	map<MassPoint, PointNorm>::iterator it = points_.find(point);
+	if (it == points_.end()) return 0;
+	++nMap_;
+	lastPoint_ = point;
+	last_ = &it->second;
+	return last_;
+}
+
+PointNorm& NormCache::insert(const MassPoint& point){
+	lastPoint_ = point;
+	last_ = &points_[point];
+	return *last_;
+}
+
+void NormCache::printSummary() const {
+	unsigned long long nMiss = nCalls_ - nLast_ - nMap_;
+	printf("[NormCache] %s: %d points, %llu lookups, %llu same as the last, %llu from the map, %llu computed (%.2f%% hits)\n",
+	       name_.c_str(), nPoints(), nCalls_, nLast_, nMap_, nMiss,
+	       nCalls_ ? 100. * (nLast_ + nMap_) / nCalls_ : 0.);
+}
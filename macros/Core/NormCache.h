@@ -0,0 +1,56 @@
+#ifndef NORMCACHE_H
+#define NORMCACHE_H
+
+#include "MassIndex.h"
+
+#include <map>
+#include <string>
+
+using namespace std;
+
+// the normalization of one mass point of a signal scan
+struct PointNorm {
+	PointNorm() : xsec(-999.), nevents(0.) {}
+
+	double xsec;		// pb, -999 where there is none
+	double nevents;		// generated events
+};
+
+/* Normalization of the mass points of a signal scan: worked out on the
+ * first event of a point and reused for every other event of the point.
+ *
+ *   PointNorm* norm = cache.find(point);
+ *   if (!norm) {
+ *     norm = &cache.insert(point);
+ *     norm->xsec = ...;
+ *   }
+ *
+ * The events of a point mostly come one after another (always so in the
+ * clustered minibabies), so the last point found is checked before the
+ * map.  printSummary() gives how often each was hit.
+ */
+class NormCache {
+
+public:
+	NormCache(const string& name);
+
+	// 0 on the first event of the point
+	PointNorm* find(const MassPoint& point);
+	// a new entry for the point, to be filled by the caller
+	PointNorm& insert(const MassPoint& point);
+
+	int nPoints() const { return points_.size(); }
+	void printSummary() const;
+
+private:
+	static bool same(const MassPoint& a, const MassPoint& b);
+
+	string name_;
+	map<MassPoint, PointNorm> points_;
+	MassPoint lastPoint_;
+	PointNorm* last_;
+
+	unsigned long long nCalls_, nLast_, nMap_;
+};
+
+#endif
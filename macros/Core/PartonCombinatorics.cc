@@ -1,41 +1,75 @@
 #include "PartonCombinatorics.h"
 
 #include "TFitter.h"
+
+#include <cstring>
 #include "../Core/MT2Utility.h"
 #include "../Core/mt2bl_bisect.h"
 #include "../Core/mt2w_bisect.h"
 
-PartonCombinatorics::PartonCombinatorics(vector<LorentzVector> jets, vector<float> btag, vector<float> sigma_jets,
-		vector<float> mc, LorentzVector lep, float met, float metphi, bool isData){
-        vector<int> new_mc;
+PartonCombinatorics::PartonCombinatorics()
+	: isData_(false), n_jets(0), jets_(0), btag_(0), sigma_jets_(0), mc_(0),
+	  met_(0.), metphi_(0.), n_jets_(0)
+{
+}
+
+PartonCombinatorics::PartonCombinatorics(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+		const vector<float>& mc, const LorentzVector& lep, float met, float metphi, bool isData)
+	: isData_(false), n_jets(0), jets_(0), btag_(0), sigma_jets_(0), mc_(0),
+	  met_(0.), metphi_(0.), n_jets_(0)
+{
+	compute(jets, btag, sigma_jets, mc, lep, met, metphi, isData);
+}
+
+PartonCombinatorics::PartonCombinatorics(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+		const vector<int>& mc, const LorentzVector& lep, float met, float metphi, bool isData)
+	: isData_(false), n_jets(0), jets_(0), btag_(0), sigma_jets_(0), mc_(0),
+	  met_(0.), metphi_(0.), n_jets_(0)
+{
+	compute(jets, btag, sigma_jets, mc, lep, met, metphi, isData);
+}
+
+void PartonCombinatorics::compute(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+		const vector<float>& mc, const LorentzVector& lep, float met, float metphi, bool isData){
+        mc_buffer_.resize(mc.size());
         for (unsigned int i =0; i < mc.size(); ++i)
-           new_mc.push_back((int) mc.at(i));
+           mc_buffer_[i] = (int) mc.at(i);
 
-        PartonCombinatorics(jets, btag, sigma_jets, new_mc, lep, met, metphi, isData);
+        compute(jets, btag, sigma_jets, mc_buffer_, lep, met, metphi, isData);
 }
 
-PartonCombinatorics::PartonCombinatorics(vector<LorentzVector> jets, vector<float> btag, vector<float> sigma_jets,
-		vector<int> mc, LorentzVector lep, float met, float metphi, bool isData){
-        if ( __debug ) cout << "PartonCombinatorics::Constructor " << endl;
+void PartonCombinatorics::compute(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+		const vector<int>& mc, const LorentzVector& lep, float met, float metphi, bool isData){
+        if ( __debug ) cout << "PartonCombinatorics::compute " << endl;
 	isData_ = isData;
-	jets_ = jets;
-	btag_ = btag;
-	sigma_jets_ = sigma_jets;
-	mc_ = mc;
+	jets_ = &jets;
+	btag_ = &btag;
+	sigma_jets_ = &sigma_jets;
+	mc_ = &mc;
 	lep_ = lep;
 	met_ = met;
 	metphi_ = metphi;
         n_jets_ = jets.size();
 
-        assert( jets_.size() == btag_.size() );
-//        assert( jets_.size() == mc_.size() );
-        assert( jets_.size() == sigma_jets_.size() );
+        assert( jets.size() == btag.size() );
+//        assert( jets.size() == mc.size() );
+        assert( jets.size() == sigma_jets.size() );
+
+        if ( __debug ) cout << "PartonCombinatorics::compute isData = " << isData << endl;
 
-        if ( __debug ) cout << "PartonCombinatorics::Constructor isData = " << isData << endl;
+	candidates_.clear();
+	b_candidates_.clear();
 
 	recoHadronicTop();
 	applyBConsistency(BTAG_MED);
 	MT2CHI2Calculator();
+
+	if ( __debug ) assert( checkMT2CHI2Calculator() );
+
+	jets_ = 0;
+	btag_ = 0;
+	sigma_jets_ = 0;
+	mc_ = 0;
 }
 
 MT2CHI2 PartonCombinatorics::getMt2Chi2(){
@@ -43,54 +77,25 @@ MT2CHI2 PartonCombinatorics::getMt2Chi2(){
 }
 
 //--------------------------------------------------------------------
-bool PartonCombinatorics::compare_in_chi2( Candidate &x, Candidate &y ){
+bool PartonCombinatorics::compare_in_chi2( const Candidate &x, const Candidate &y ){
   return x.chi2 < y.chi2;
 }
 
 //--------------------------------------------------------------------
-bool PartonCombinatorics::compare_in_mt2b( Candidate &x, Candidate &y ){
+bool PartonCombinatorics::compare_in_mt2b( const Candidate &x, const Candidate &y ){
   return x.mt2b < y.mt2b;
 }
 
 //--------------------------------------------------------------------
-bool PartonCombinatorics::compare_in_mt2bl( Candidate &x, Candidate &y ){
+bool PartonCombinatorics::compare_in_mt2bl( const Candidate &x, const Candidate &y ){
   return x.mt2bl < y.mt2bl;
 }
 
 //--------------------------------------------------------------------
-bool PartonCombinatorics::compare_in_mt2w( Candidate &x, Candidate &y ){
+bool PartonCombinatorics::compare_in_mt2w( const Candidate &x, const Candidate &y ){
   return x.mt2w < y.mt2w;
 }
 
-float PartonCombinatorics::min_with_value(list<Candidate> &candidates, float value, const char* fix, const char* var){
-  float min_value = 9999.0;
-
-  for(list<Candidate>::iterator it = candidates.begin(); it != candidates.end(); it++){
-	  if (strcmp(fix, "chi2") == 0 && it->chi2 == value ){
-		     if ( strcmp(var, "mt2b")  == 0  && it->mt2b  < min_value ) min_value = it->mt2b;
-		     if ( strcmp(var, "mt2bl") == 0  && it->mt2bl < min_value ) min_value = it->mt2bl;
-		     if ( strcmp(var, "mt2w")  == 0  && it->mt2w  < min_value ) min_value = it->mt2w;
-	  }
-	  if (strcmp(fix, "mt2b") == 0 && it->mt2b == value ){
-		     if ( strcmp(var, "chi2")  == 0  && it->chi2  < min_value ) min_value = it->chi2;
-		     if ( strcmp(var, "mt2bl") == 0  && it->mt2bl < min_value ) min_value = it->mt2bl;
-		     if ( strcmp(var, "mt2w")  == 0  && it->mt2w  < min_value ) min_value = it->mt2w;
-	  }
-	  if (strcmp(fix, "mt2bl") == 0 && it->mt2bl == value ){
-		     if ( strcmp(var, "chi2")  == 0  && it->chi2  < min_value ) min_value = it->chi2;
-		     if ( strcmp(var, "mt2b")  == 0  && it->mt2b  < min_value ) min_value = it->mt2b;
-		     if ( strcmp(var, "mt2w")  == 0  && it->mt2w  < min_value ) min_value = it->mt2w;
-	  }
-	  if (strcmp(fix, "mt2w") == 0 && it->mt2w == value ){
-		     if ( strcmp(var, "chi2")  == 0  && it->chi2  < min_value ) min_value = it->chi2;
-		     if ( strcmp(var, "mt2b")  == 0  && it->mt2b  < min_value ) min_value = it->mt2b;
-		     if ( strcmp(var, "mt2bl") == 0  && it->mt2bl < min_value ) min_value = it->mt2bl;
-	  }
-  }
-
-  if ( min_value > 9998.0 ) return -0.999;
-  return min_value;
-}
 //--------------------------------------------------------------------
 double PartonCombinatorics::fc2 (double c1, double m12, double m22, double m02, bool verbose = false)
 {
@@ -146,11 +151,16 @@ void PartonCombinatorics::minuitFunction(int&, double* , double &result, double
  * btag - b-tagging information of the jets
  * jets_ - qgjet montecarlo match number for the jets
  *
- * returns a list of candidates sorted by chi2 ( if __sort = true in .h );
+ * fills candidates_, sorted by chi2 when __SORT = true in .h (the default;
+ * stable_sort keeps the order list::sort gave).
  */
 void PartonCombinatorics::recoHadronicTop(){
   if ( __debug ) cout << "PartonCombinatorics::recoHadronicTop " << endl;
 
+  const vector<LorentzVector>& jets = *jets_;
+  const vector<float>& sigma_jets = *sigma_jets_;
+  const vector<int>& mc = *mc_;
+
   float metx = met_ * cos( metphi_ );
   float mety = met_ * sin( metphi_ );
 
@@ -169,10 +179,10 @@ void PartonCombinatorics::recoHadronicTop(){
       for (int jb=0; jb<n_jets_; ++jb )
         for (int jw1=0; jw1<n_jets_; ++jw1 )
           for (int jw2=jw1+1; jw2<n_jets_; ++jw2 )
-            if ( (mc_.at(jw2)==2 && mc_.at(jw1)==2 && mc_.at(jb)==1 && mc_.at(jbl)==-1) ||
-                 (mc_.at(jw2)==-2 && mc_.at(jw1)==-2 && mc_.at(jb)==-1 && mc_.at(jbl)==1) ||
-		 (mc_.at(jw2)==5 && mc_.at(jw1)==5 && mc_.at(jb)==1 && mc_.at(jbl)==-1) ||
-                 (mc_.at(jw2)==-5 && mc_.at(jw1)==-5 && mc_.at(jb)==-1 && mc_.at(jbl)==1) ) {
+            if ( (mc.at(jw2)==2 && mc.at(jw1)==2 && mc.at(jb)==1 && mc.at(jbl)==-1) ||
+                 (mc.at(jw2)==-2 && mc.at(jw1)==-2 && mc.at(jb)==-1 && mc.at(jbl)==1) ||
+		 (mc.at(jw2)==5 && mc.at(jw1)==5 && mc.at(jb)==1 && mc.at(jbl)==-1) ||
+                 (mc.at(jw2)==-5 && mc.at(jw1)==-5 && mc.at(jb)==-1 && mc.at(jbl)==1) ) {
 	      if ( match == 5 ) break;
               if ( __debug ) cout << "PartonCombinatorics::recoHadronicTop MC found:" << match << endl;
 	      ibl[match] = jbl;
@@ -186,19 +196,23 @@ void PartonCombinatorics::recoHadronicTop(){
   if ( __debug ) cout << "PartonCombinatorics::recoHadronicTop MC done" << endl;
   ////////    * Combinatorics. j_1 Pt must be > PTMIN_W1 and so on.
 
-  vector<int> v_i, v_j;
-  vector<double> v_k1, v_k2;
+  vector<int>& v_i = w_i_;
+  vector<int>& v_j = w_j_;
+  vector<double>& v_k1 = w_k1_;
+  vector<double>& v_k2 = w_k2_;
+  v_i.clear(); v_j.clear();
+  v_k1.clear(); v_k2.clear();
   for ( int i=0; i<n_jets_; ++i )
     for ( int j=i+1; j<n_jets_; ++j ){
-      double pt_w1 = jets_[i].Pt();
-      double pt_w2 = jets_[j].Pt();
-      if ( pt_w1 < PTMIN_J1 || fabs(jets_[i].Eta()) > JET_ETA ) continue;
-      if ( pt_w2 < PTMIN_J2 || fabs(jets_[j].Eta()) > JET_ETA ) continue;
+      double pt_w1 = jets[i].Pt();
+      double pt_w2 = jets[j].Pt();
+      if ( pt_w1 < PTMIN_J1 || fabs(jets[i].Eta()) > JET_ETA ) continue;
+      if ( pt_w2 < PTMIN_J2 || fabs(jets[j].Eta()) > JET_ETA ) continue;
 
       //
       //  W
       //
-      LorentzVector hadW = jets_[i] + jets_[j];
+      LorentzVector hadW = jets[i] + jets[j];
 
       //
       //  W Mass Constraint.
@@ -210,11 +224,11 @@ void PartonCombinatorics::recoHadronicTop(){
       minimizer->SetFCN(minuitFunction);
       minimizer->SetParameter(0 , "c1"     , 1.1             , 1 , 0 , 0);
       minimizer->SetParameter(1 , "pt1"    , 1.0             , 1 , 0 , 0);
-      minimizer->SetParameter(2 , "sigma1" , sigma_jets_[i]   , 1 , 0 , 0);
+      minimizer->SetParameter(2 , "sigma1" , sigma_jets[i]   , 1 , 0 , 0);
       minimizer->SetParameter(3 , "pt2"    , 1.0             , 1 , 0 , 0);
-      minimizer->SetParameter(4 , "sigma2" , sigma_jets_[j]   , 1 , 0 , 0);
-      minimizer->SetParameter(5 , "m12"    , jets_[i].mass2() , 1 , 0 , 0);
-      minimizer->SetParameter(6 , "m22"    , jets_[j].mass2() , 1 , 0 , 0);
+      minimizer->SetParameter(4 , "sigma2" , sigma_jets[j]   , 1 , 0 , 0);
+      minimizer->SetParameter(5 , "m12"    , jets[i].mass2() , 1 , 0 , 0);
+      minimizer->SetParameter(6 , "m22"    , jets[j].mass2() , 1 , 0 , 0);
       minimizer->SetParameter(7 , "m02"    , hadW.mass2()    , 1 , 0 , 0);
 
       for (unsigned int k = 1; k < 8; k++)
@@ -229,7 +243,7 @@ void PartonCombinatorics::recoHadronicTop(){
 	    <<endl;
         continue;
       }
-      double c2 = fc2(c1, jets_[i].mass2(), jets_[j].mass2(), hadW.mass2());
+      double c2 = fc2(c1, jets[i].mass2(), jets[j].mass2(), hadW.mass2());
 
       delete minimizer;
 
@@ -239,7 +253,7 @@ void PartonCombinatorics::recoHadronicTop(){
       //      *  - Steve Wozniak
 
       //      cout << "c1 = " <<  c1 << "  c1 = " << c2 << "   M_jj = "
-      //           << ((jets_[i] * c1) + (jets_[j] * c2)).mass() << endl;
+      //           << ((jets[i] * c1) + (jets[j] * c2)).mass() << endl;
 
       v_i.push_back(i);
       v_j.push_back(j);
@@ -249,8 +263,6 @@ void PartonCombinatorics::recoHadronicTop(){
 
   if ( __debug ) cout << "PartonCombinatorics::recoHadronicTop W done" << endl;
 
-  list<Candidate> chi2candidates;
-
   mt2_bisect::mt2 mt2_event;
   mt2bl_bisect::mt2bl mt2bl_event;
   mt2w_bisect::mt2w mt2w_event;
@@ -260,10 +272,10 @@ void PartonCombinatorics::recoHadronicTop(){
 
       if ( b == o ) continue;
       //apply pt and eta requirements
-      double pt_b = jets_[b].Pt();
-      double pt_o = jets_[o].Pt();
-      if ( pt_b < PTMIN_B || fabs(jets_[b].Eta()) > JET_ETA ) continue;
-      if ( pt_o < PTMIN_O || fabs(jets_[o].Eta()) > JET_ETA ) continue;
+      double pt_b = jets[b].Pt();
+      double pt_o = jets[o].Pt();
+      if ( pt_b < PTMIN_B || fabs(jets[b].Eta()) > JET_ETA ) continue;
+      if ( pt_o < PTMIN_O || fabs(jets[o].Eta()) > JET_ETA ) continue;
 
       ///
       //  MT2 Variables
@@ -274,22 +286,22 @@ void PartonCombinatorics::recoHadronicTop(){
       double pb2[4];    // other bottom, paired with the invisible W
       double pmiss[3];  // <unused>, pmx, pmy   missing pT
       pl[0]= lep_.E(); pl[1]= lep_.Px(); pl[2]= lep_.Py(); pl[3]= lep_.Pz();
-      pb1[1] = jets_[o].Px();  pb1[2] = jets_[o].Py();   pb1[3] = jets_[o].Pz();
-      pb2[1] = jets_[b].Px();  pb2[2] = jets_[b].Py();   pb2[3] = jets_[b].Pz();
+      pb1[1] = jets[o].Px();  pb1[2] = jets[o].Py();   pb1[3] = jets[o].Pz();
+      pb2[1] = jets[b].Px();  pb2[2] = jets[b].Py();   pb2[3] = jets[b].Pz();
       pmiss[0] = 0.; pmiss[1] = metx; pmiss[2] = mety;
 
       double pmiss_lep[3];
       pmiss_lep[0] = 0.;
       pmiss_lep[1] = pmiss[1]+pl[1]; pmiss_lep[2] = pmiss[2]+pl[2];
 
-      pb1[0] = jets_[o].mass();
-      pb2[0] = jets_[b].mass();
+      pb1[0] = jets[o].mass();
+      pb2[0] = jets[b].mass();
       mt2_event.set_momenta( pb1, pb2, pmiss_lep );
       mt2_event.set_mn( 80.385 );   // Invisible particle mass
       double c_mt2b = mt2_event.get_mt2();
 
-      pb1[0] = jets_[o].E();
-      pb2[0] = jets_[b].E();
+      pb1[0] = jets[o].E();
+      pb2[0] = jets[b].E();
       mt2bl_event.set_momenta(pl, pb1, pb2, pmiss);
       double c_mt2bl = mt2bl_event.get_mt2bl();
 
@@ -303,13 +315,13 @@ void PartonCombinatorics::recoHadronicTop(){
         int j = v_j[w];
         if ( i==o || i==b || j==o || j==b ) continue;
 
-        double pt_w1 = jets_[i].Pt();
-        double pt_w2 = jets_[j].Pt();
+        double pt_w1 = jets[i].Pt();
+        double pt_w2 = jets[j].Pt();
 
 	///
 	//  W Mass.
 	///
-	LorentzVector hadW = jets_[i] + jets_[j];
+	LorentzVector hadW = jets[i] + jets[j];
 	double massW = hadW.mass();
 
 	double c1 = v_k1[w];
@@ -318,17 +330,17 @@ void PartonCombinatorics::recoHadronicTop(){
 	///
 	// Top Mass.
 	///
-        LorentzVector hadT = (jets_[i] * c1) + (jets_[j] * c2) + jets_[b];
+        LorentzVector hadT = (jets[i] * c1) + (jets[j] * c2) + jets[b];
         double massT = hadT.mass();
 
         double pt_w = hadW.Pt();
-        double sigma_w2 = pt_w1*sigma_jets_[i] * pt_w1*sigma_jets_[i]
-	  + pt_w2*sigma_jets_[j] * pt_w2*sigma_jets_[j];
+        double sigma_w2 = pt_w1*sigma_jets[i] * pt_w1*sigma_jets[i]
+	  + pt_w2*sigma_jets[j] * pt_w2*sigma_jets[j];
         double smw2 = (1.+2.*pt_w*pt_w/massW/massW)*sigma_w2;
         double pt_t = hadT.Pt();
-        double sigma_t2 = c1*pt_w1*sigma_jets_[i] * c1*pt_w1*sigma_jets_[i]
-	  + c2*pt_w2*sigma_jets_[j] * c2*pt_w2*sigma_jets_[j]
-	  + pt_b*sigma_jets_[b] * pt_b*sigma_jets_[b];
+        double sigma_t2 = c1*pt_w1*sigma_jets[i] * c1*pt_w1*sigma_jets[i]
+	  + c2*pt_w2*sigma_jets[j] * c2*pt_w2*sigma_jets[j]
+	  + pt_b*sigma_jets[b] * pt_b*sigma_jets[b];
         double smtop2 = (1.+2.*pt_t*pt_t/massT/massT)*sigma_t2;
 
         double c_chi2 = (massT-PDG_TOP_MASS)*(massT-PDG_TOP_MASS)/smtop2
@@ -354,29 +366,32 @@ void PartonCombinatorics::recoHadronicTop(){
     }
 
   if (__SORT)
-    candidates_.sort(compare_in_chi2);
+    stable_sort(candidates_.begin(), candidates_.end(), compare_in_chi2);
 
 }
 
 //--------------------------------------------------------------------
 void PartonCombinatorics::applyBConsistency(float btagcut){
+	const vector<float>& btag = *btag_;
+
 	int n_btag = 0;
-	vector<int> non_bjets;
+	vector<int>& non_bjets = non_bjets_;
+	non_bjets.clear();
 	for( int i = 0 ; i < n_jets_ ; i++ ){
-		if( btag_.at(i) > btagcut )
+		if( btag.at(i) > btagcut )
 			n_btag++;
 		else
 			non_bjets.push_back(i);
 	}
 
-	for(list<Candidate>::iterator c_it = candidates_.begin() ; c_it != candidates_.end() ; c_it++ ){
+	for(CANDIDATES::const_iterator c_it = candidates_.begin() ; c_it != candidates_.end() ; ++c_it ){
 		int bi = c_it->bi;
 		int oi = c_it->oi;
 
 //		cout << "CCC: " << bi << "  " << oi << endl;
 
-		bool b_btag  = (btag_.at(bi)  > btagcut);
-		bool o_btag  = (btag_.at(oi)  > btagcut);
+		bool b_btag  = (btag.at(bi)  > btagcut);
+		bool o_btag  = (btag.at(oi)  > btagcut);
 
 		if (n_btag == 0){
 			if ( bi > (NUM_LEAD_JETS_0B - 1) ||
@@ -416,6 +431,10 @@ void PartonCombinatorics::applyBConsistency(float btagcut){
 }
 
 //--------------------------------------------------------------------
+/* Single pass per variable over the flat candidate array: the minimum of a
+ * field is what the front of the old sorted list was, so no sorting is
+ * needed at all.
+ */
 void PartonCombinatorics::MT2CHI2Calculator(){
 	mt2chi2_.one_chi2    = -0.999;
 	mt2chi2_.two_mt2b    = -0.999;
@@ -431,14 +450,86 @@ void PartonCombinatorics::MT2CHI2Calculator(){
   if (b_candidates_.size() == 0)
     return;
 
+  // Calculate Variable 1
+  mt2chi2_.one_chi2 = min_of<&Candidate::chi2>(b_candidates_);
+
+  //Calculate Variable 2b, 2bl, 2bw
+  mt2chi2_.two_mt2b  = min_with_value<&Candidate::chi2, &Candidate::mt2b>(b_candidates_, mt2chi2_.one_chi2);
+  mt2chi2_.two_mt2bl = min_with_value<&Candidate::chi2, &Candidate::mt2bl>(b_candidates_, mt2chi2_.one_chi2);
+  mt2chi2_.two_mt2w  = min_with_value<&Candidate::chi2, &Candidate::mt2w>(b_candidates_, mt2chi2_.one_chi2);
+
+  //Calculate Variable 3b, 3bl, 3bw
+  mt2chi2_.three_mt2b  = min_of<&Candidate::mt2b>(b_candidates_);
+  mt2chi2_.three_mt2bl = min_of<&Candidate::mt2bl>(b_candidates_);
+  mt2chi2_.three_mt2w  = min_of<&Candidate::mt2w>(b_candidates_);
+
+  //Calculate Variable 4b, 4bl, 4w
+  mt2chi2_.four_chi2b  = min_with_value<&Candidate::mt2b, &Candidate::chi2>(b_candidates_, mt2chi2_.three_mt2b);
+  mt2chi2_.four_chi2bl = min_with_value<&Candidate::mt2bl, &Candidate::chi2>(b_candidates_, mt2chi2_.three_mt2bl);
+  mt2chi2_.four_chi2w  = min_with_value<&Candidate::mt2w, &Candidate::chi2>(b_candidates_, mt2chi2_.three_mt2w);
+}
+
+//--------------------------------------------------------------------
+/* Reference for the regression check: the MT2CHI2 calculation as it was
+ * before the single pass, kept verbatim (sorts of a list<Candidate>, the
+ * front of each, and the string-keyed min_with_value).
+ */
+float PartonCombinatorics::min_with_value_reference(list<Candidate> &candidates, float value, const char* fix, const char* var){
+  float min_value = 9999.0;
+
+  for(list<Candidate>::iterator it = candidates.begin(); it != candidates.end(); it++){
+	  if (strcmp(fix, "chi2") == 0 && it->chi2 == value ){
+		     if ( strcmp(var, "mt2b")  == 0  && it->mt2b  < min_value ) min_value = it->mt2b;
+		     if ( strcmp(var, "mt2bl") == 0  && it->mt2bl < min_value ) min_value = it->mt2bl;
+		     if ( strcmp(var, "mt2w")  == 0  && it->mt2w  < min_value ) min_value = it->mt2w;
+	  }
+	  if (strcmp(fix, "mt2b") == 0 && it->mt2b == value ){
+		     if ( strcmp(var, "chi2")  == 0  && it->chi2  < min_value ) min_value = it->chi2;
+		     if ( strcmp(var, "mt2bl") == 0  && it->mt2bl < min_value ) min_value = it->mt2bl;
+		     if ( strcmp(var, "mt2w")  == 0  && it->mt2w  < min_value ) min_value = it->mt2w;
+	  }
+	  if (strcmp(fix, "mt2bl") == 0 && it->mt2bl == value ){
+		     if ( strcmp(var, "chi2")  == 0  && it->chi2  < min_value ) min_value = it->chi2;
+		     if ( strcmp(var, "mt2b")  == 0  && it->mt2b  < min_value ) min_value = it->mt2b;
+		     if ( strcmp(var, "mt2w")  == 0  && it->mt2w  < min_value ) min_value = it->mt2w;
+	  }
+	  if (strcmp(fix, "mt2w") == 0 && it->mt2w == value ){
+		     if ( strcmp(var, "chi2")  == 0  && it->chi2  < min_value ) min_value = it->chi2;
+		     if ( strcmp(var, "mt2b")  == 0  && it->mt2b  < min_value ) min_value = it->mt2b;
+		     if ( strcmp(var, "mt2bl") == 0  && it->mt2bl < min_value ) min_value = it->mt2bl;
+	  }
+  }
+
+  if ( min_value > 9998.0 ) return -0.999;
+  return min_value;
+}
+
+MT2CHI2 PartonCombinatorics::MT2CHI2Reference(const CANDIDATES &candidates){
+	list<Candidate> b_candidates_(candidates.begin(), candidates.end());
+	MT2CHI2 mt2chi2_;
+
+	mt2chi2_.one_chi2    = -0.999;
+	mt2chi2_.two_mt2b    = -0.999;
+	mt2chi2_.two_mt2bl   = -0.999;
+	mt2chi2_.two_mt2w    = -0.999;
+	mt2chi2_.three_mt2b  = -0.999;
+	mt2chi2_.three_mt2bl = -0.999;
+	mt2chi2_.three_mt2w  = -0.999;
+	mt2chi2_.four_chi2b  = -0.999;
+	mt2chi2_.four_chi2bl = -0.999;
+	mt2chi2_.four_chi2w  = -0.999;
+
+  if (b_candidates_.size() == 0)
+    return mt2chi2_;
+
   // Calculate Variable 1
   b_candidates_.sort(compare_in_chi2);
   mt2chi2_.one_chi2 = b_candidates_.front().chi2;
 
   //Calculate Variable 2b, 2bl, 2bw
-  mt2chi2_.two_mt2b = min_with_value(b_candidates_, mt2chi2_.one_chi2, "chi2", "mt2b");
-  mt2chi2_.two_mt2bl = min_with_value(b_candidates_, mt2chi2_.one_chi2, "chi2", "mt2bl");
-  mt2chi2_.two_mt2w = min_with_value(b_candidates_, mt2chi2_.one_chi2, "chi2", "mt2w");
+  mt2chi2_.two_mt2b = min_with_value_reference(b_candidates_, mt2chi2_.one_chi2, "chi2", "mt2b");
+  mt2chi2_.two_mt2bl = min_with_value_reference(b_candidates_, mt2chi2_.one_chi2, "chi2", "mt2bl");
+  mt2chi2_.two_mt2w = min_with_value_reference(b_candidates_, mt2chi2_.one_chi2, "chi2", "mt2w");
 
   //Calculate Variable 3b, 3bl, 3bw
   b_candidates_.sort(compare_in_mt2b);
@@ -451,7 +542,23 @@ void PartonCombinatorics::MT2CHI2Calculator(){
   mt2chi2_.three_mt2w = b_candidates_.front().mt2w;
 
   //Calculate Variable 4b, 4bl, 4w
-  mt2chi2_.four_chi2b  = min_with_value(b_candidates_, mt2chi2_.three_mt2b, "mt2b", "chi2");
-  mt2chi2_.four_chi2bl = min_with_value(b_candidates_, mt2chi2_.three_mt2bl, "mt2bl", "chi2");
-  mt2chi2_.four_chi2w  = min_with_value(b_candidates_, mt2chi2_.three_mt2w,  "mt2w", "chi2");
+  mt2chi2_.four_chi2b  = min_with_value_reference(b_candidates_, mt2chi2_.three_mt2b, "mt2b", "chi2");
+  mt2chi2_.four_chi2bl = min_with_value_reference(b_candidates_, mt2chi2_.three_mt2bl, "mt2bl", "chi2");
+  mt2chi2_.four_chi2w  = min_with_value_reference(b_candidates_, mt2chi2_.three_mt2w,  "mt2w", "chi2");
+
+  return mt2chi2_;
+}
+
+//--------------------------------------------------------------------
+/* Regression check of the last compute(): MT2CHI2Reference() on the same
+ * b candidates, compared with mt2chi2_ bit by bit.  Run by solverBench on
+ * its fixtures, and from compute() when __debug is set.
+ */
+bool PartonCombinatorics::checkMT2CHI2Calculator(){
+  MT2CHI2 ref = MT2CHI2Reference(b_candidates_);
+
+  bool same = ( memcmp(&ref, &mt2chi2_, sizeof(MT2CHI2)) == 0 );
+  if ( !same )
+    cout << "[PartonCombinatorics::checkMT2CHI2Calculator] ERROR: single pass and sorted results differ!" << endl;
+  return same;
 }
@@ -19,48 +19,85 @@
 
 using namespace std;
 
+/* Hadronic top / MT2 combinatorics.
+ *
+ * The inputs are taken by const reference and only referenced while the
+ * candidates are being built, so nothing is copied per event.  Candidates
+ * live in a flat array (CANDIDATES) that keeps its capacity between calls:
+ * keep one PartonCombinatorics around and call compute() once per event to
+ * avoid any allocation after the first few events.
+ *
+ * candidates_ is sorted in chi2 as before.  b_candidates_ keeps that order
+ * too; the old MT2CHI2Calculator() left it sorted in mt2w as a side effect
+ * of its sorts (StopLooperTop, the only reader, only fills histograms from
+ * it).
+ */
 class PartonCombinatorics {
 	typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
 
 public:
-	PartonCombinatorics(vector<LorentzVector> jets, vector<float> btag, vector<float> sigma_jets,
-			vector<float> mc, LorentzVector lep, float met, float metphi, bool isData);
-	PartonCombinatorics(vector<LorentzVector> jets, vector<float> btag, vector<float> sigma_jets,
-			vector<int> mc, LorentzVector lep, float met, float metphi, bool isData);
+	PartonCombinatorics();
+	PartonCombinatorics(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+			const vector<float>& mc, const LorentzVector& lep, float met, float metphi, bool isData);
+	PartonCombinatorics(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+			const vector<int>& mc, const LorentzVector& lep, float met, float metphi, bool isData);
+
+	void compute(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+			const vector<float>& mc, const LorentzVector& lep, float met, float metphi, bool isData);
+	void compute(const vector<LorentzVector>& jets, const vector<float>& btag, const vector<float>& sigma_jets,
+			const vector<int>& mc, const LorentzVector& lep, float met, float metphi, bool isData);
 
 	MT2CHI2 getMt2Chi2();
 
 	bool isData_;
 	int n_jets;
-	vector<LorentzVector> jets_;
-	vector<float> btag_;
-	vector<float> sigma_jets_;
-	vector<int> mc_;
+	// non-owning views, valid only inside compute()
+	const vector<LorentzVector>* jets_;
+	const vector<float>* btag_;
+	const vector<float>* sigma_jets_;
+	const vector<int>* mc_;
 	LorentzVector lep_;
 	double met_;
 	double metphi_;
         int n_jets_;
 
-	list<Candidate> candidates_;
-	list<Candidate> b_candidates_;
+	CANDIDATES candidates_;
+	CANDIDATES b_candidates_;
 	MT2CHI2 mt2chi2_;
 
-	static bool compare_in_chi2( Candidate &x, Candidate &y );
-	static bool compare_in_mt2b( Candidate &x, Candidate &y );
-	static bool compare_in_mt2bl( Candidate &x, Candidate &y );
-	static bool compare_in_mt2w( Candidate &x, Candidate &y );
+	// per-event scratch, reused between events
+	vector<int> mc_buffer_;
+	vector<int> w_i_, w_j_;
+	vector<double> w_k1_, w_k2_;
+	vector<int> non_bjets_;
+
+	static bool compare_in_chi2( const Candidate &x, const Candidate &y );
+	static bool compare_in_mt2b( const Candidate &x, const Candidate &y );
+	static bool compare_in_mt2bl( const Candidate &x, const Candidate &y );
+	static bool compare_in_mt2w( const Candidate &x, const Candidate &y );
 
 	static double fc2 (double c1, double m12, double m22, double m02, bool verbose);
 	static double fchi2 (double c1, double pt1, double sigma1, double pt2, double sigma2, double m12, double m22, double m02);
 	static void minuitFunction(int&, double* , double &result, double par[], int);
 
+	// smallest Candidate::*Var, -0.999 if there are no candidates
+	template <float Candidate::*Var>
+	static float min_of(const CANDIDATES &candidates);
 
-	static float min_with_value(list<Candidate> &candidates, float value, const char* fix, const char* var);
+	// smallest Candidate::*Var among the candidates with Candidate::*Fix == value
+	template <float Candidate::*Fix, float Candidate::*Var>
+	static float min_with_value(const CANDIDATES &candidates, float value);
 
 	void recoHadronicTop();
 	void applyBConsistency(float btagcut);
 	void MT2CHI2Calculator();
 
+	// the sorted-list calculation MT2CHI2Calculator() replaced, and the
+	// comparison of the two for the last compute()
+	static float min_with_value_reference(list<Candidate> &candidates, float value, const char* fix, const char* var);
+	static MT2CHI2 MT2CHI2Reference(const CANDIDATES &candidates);
+	bool checkMT2CHI2Calculator();
+
 	static const float PTMIN_J1 = 30;
 	static const float PTMIN_J2 = 30;
 	static const float PTMIN_B = 30;
@@ -81,4 +118,26 @@ public:
 
 };
 
+template <float Candidate::*Var>
+float PartonCombinatorics::min_of(const CANDIDATES &candidates){
+  if ( candidates.empty() ) return -0.999;
+
+  float min_value = candidates.front().*Var;
+  for(CANDIDATES::const_iterator it = candidates.begin()+1; it != candidates.end(); ++it)
+	  if ( (*it).*Var < min_value ) min_value = (*it).*Var;
+
+  return min_value;
+}
+
+template <float Candidate::*Fix, float Candidate::*Var>
+float PartonCombinatorics::min_with_value(const CANDIDATES &candidates, float value){
+  float min_value = 9999.0;
+
+  for(CANDIDATES::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+	  if ( (*it).*Fix == value && (*it).*Var < min_value ) min_value = (*it).*Var;
+
+  if ( min_value > 9998.0 ) return -0.999;
+  return min_value;
+}
+
 #endif
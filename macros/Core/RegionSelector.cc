@@ -0,0 +1,128 @@
+#include "RegionSelector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <cstdio>
+#include <cstdlib>
+
+RegionSelector::RegionSelector()
+	: bits_(0),
+	  nEvents_(0), nGroupTests_(0), nRegionTests_(0), nChecks_(0), nMismatches_(0)
+{
+}
+
+int RegionSelector::addCut(const string& name){
+	if (std::find(cuts_.begin(), cuts_.end(), name) != cuts_.end()) {
+		printf("[RegionSelector] cut %s declared twice\n", name.c_str());
+		exit(1);
+	}
+	if (int(cuts_.size()) == MAXCUTS) {
+		printf("[RegionSelector] more than %d cuts, cannot add %s\n", MAXCUTS, name.c_str());
+		exit(1);
+	}
+	cuts_.push_back(name);
+	return cuts_.size() - 1;
+}
+
+RegionSelector::Mask RegionSelector::mask(const string& cuts) const {
+	Mask m = 0;
+	size_t begin = 0;
+	while (begin < cuts.size()) {
+		size_t end = cuts.find(',', begin);
+		if (end == string::npos) end = cuts.size();
+		string cut = cuts.substr(begin, end - begin);
+		begin = end + 1;
+		if (cut.empty()) continue;
+
+		vector<string>::const_iterator it = std::find(cuts_.begin(), cuts_.end(), cut);
+		if (it == cuts_.end()) {
+			printf("[RegionSelector] unknown cut %s in \"%s\"\n", cut.c_str(), cuts.c_str());
+			exit(1);
+		}
+		m |= Mask(1) << (it - cuts_.begin());
+	}
+	return m;
+}
+
+int RegionSelector::addGroup(const string& cuts){
+	// families with the same preselection share one group test
+	Mask m = mask(cuts);
+	for (unsigned int g = 0; g < groups_.size(); ++g)
+		if (groups_[g].mask == m) return g;
+
+	Group group;
+	group.mask = m;
+	groups_.push_back(group);
+	return groups_.size() - 1;
+}
+
+int RegionSelector::addRegion(int group, const string& name, const string& cuts){
+	Region region;
+	region.name = name;
+	region.mask = groups_.at(group).mask | mask(cuts);
+	region.nPassed = 0;
+	regions_.push_back(region);
+	groups_[group].regions.push_back(regions_.size() - 1);
+	return regions_.size() - 1;
+}
+
+int RegionSelector::find(const string& name) const {
+	for (int r = 0; r < nRegions(); ++r)
+		if (regions_[r].name == name) return r;
+	return -1;
+}
+
+//--------------------------------------------------------------------
+
+const vector<int>& RegionSelector::select(){
+	++nEvents_;
+	passed_.clear();
+
+	for (unsigned int g = 0; g < groups_.size(); ++g) {
+		++nGroupTests_;
+		const Group& group = groups_[g];
+		if ((bits_ & group.mask) != group.mask) continue;
+		for (unsigned int i = 0; i < group.regions.size(); ++i) {
+			++nRegionTests_;
+			int r = group.regions[i];
+			if (passed(r)) passed_.push_back(r);
+		}
+	}
+	// groups may be declared in any order relative to their regions
+	std::sort(passed_.begin(), passed_.end());
+	for (unsigned int i = 0; i < passed_.size(); ++i) ++regions_[passed_[i]].nPassed;
+
+	return passed_;
+}
+
+bool RegionSelector::check(vector<int> expected){
+	++nChecks_;
+	std::sort(expected.begin(), expected.end());
+	expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+	if (expected == passed_) return true;
+
+	++nMismatches_;
+	vector<int> diff;
+	std::set_difference(passed_.begin(), passed_.end(), expected.begin(), expected.end(), std::back_inserter(diff));
+	for (unsigned int i = 0; i < diff.size(); ++i)
+		printf("[RegionSelector] event %llu: %s selected, not expected\n", nEvents_, name(diff[i]).c_str());
+	diff.clear();
+	std::set_difference(expected.begin(), expected.end(), passed_.begin(), passed_.end(), std::back_inserter(diff));
+	for (unsigned int i = 0; i < diff.size(); ++i)
+		printf("[RegionSelector] event %llu: %s expected, not selected\n", nEvents_, name(diff[i]).c_str());
+	return false;
+}
+
+//--------------------------------------------------------------------
+
+void RegionSelector::printSummary() const {
+	printf("[RegionSelector] %d cuts, %u groups, %d regions, %llu events\n",
+	       int(cuts_.size()), (unsigned int)groups_.size(), nRegions(), nEvents_);
+	if (nEvents_)
+		printf("[RegionSelector] per event: %.2f group and %.2f region tests\n",
+		       double(nGroupTests_) / nEvents_, double(nRegionTests_) / nEvents_);
+	for (int r = 0; r < nRegions(); ++r)
+		printf("[RegionSelector]   %-32s %llu\n", regions_[r].name.c_str(), regions_[r].nPassed);
+	if (nChecks_)
+		printf("[RegionSelector] checked %llu events, %llu with a selection mismatch\n", nChecks_, nMismatches_);
+}
@@ -0,0 +1,93 @@
+#ifndef REGIONSELECTOR_H
+#define REGIONSELECTOR_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* Signal / control regions declared as conjunctions of named cuts.
+ *
+ * Every cut is a bit.  The looper evaluates each predicate once per event
+ * with set(), and a region passes when all the bits of its mask are set.
+ * Regions are declared inside groups that share a preselection mask
+ * (e.g. "lep1,isotrk,nb2,metpresel,mtpresel"): select() tests the group
+ * mask first and only looks at the regions of the groups that pass, so the
+ * work per event follows the number of passing groups and regions rather
+ * than the number declared.
+ *
+ *   RegionSelector regions;
+ *   int c_nj2 = regions.addCut("nj2");
+ *   ...
+ *   int g = regions.addGroup("lep1,isotrk,nb2");
+ *   regions.addRegion(g, "sig_presel");
+ *   regions.addRegion(g, "sig_final", "nj2,met,mt,mt2bl");
+ *
+ *   regions.newEvent();
+ *   regions.set(c_nj2, njetsall_ == 2);
+ *   ...
+ *   const vector<int>& passed = regions.select();
+ *
+ * To validate the declarations, call check() after select() with the
+ * regions an independent selection (e.g. the cut flow the masks replaced)
+ * passed; printSummary() reports the events where the two differ.
+ */
+class RegionSelector {
+
+public:
+	typedef unsigned long long Mask;
+	static const int MAXCUTS = 64;
+
+	RegionSelector();
+
+	// returns the bit of the cut
+	int addCut(const string& name);
+	// comma separated cut names; an unknown name is fatal
+	Mask mask(const string& cuts) const;
+
+	// returns the group index
+	int addGroup(const string& cuts);
+	// cuts on top of those of the group; returns the region index
+	int addRegion(int group, const string& name, const string& cuts = "");
+
+	void newEvent() { bits_ = 0; }
+	void set(int cut, bool pass) { if (pass) bits_ |= Mask(1) << cut; }
+
+	// indices of the passing regions, in declaration order
+	const vector<int>& select();
+	bool passed(int region) const { return (bits_ & regions_[region].mask) == regions_[region].mask; }
+
+	int nRegions() const { return regions_.size(); }
+	const string& name(int region) const { return regions_[region].name; }
+	// -1 if there is no region of that name
+	int find(const string& name) const;
+
+	// compare the last select() with the expected regions (any order);
+	// prints the regions that differ and returns false on a mismatch
+	bool check(vector<int> expected);
+
+	void printSummary() const;
+
+private:
+	struct Group {
+		Mask mask;
+		vector<int> regions;
+	};
+
+	struct Region {
+		string name;
+		Mask mask;
+		unsigned long long nPassed;
+	};
+
+	vector<string> cuts_;
+	vector<Group> groups_;
+	vector<Region> regions_;
+
+	Mask bits_;
+	vector<int> passed_;
+
+	unsigned long long nEvents_, nGroupTests_, nRegionTests_, nChecks_, nMismatches_;
+};
+
+#endif
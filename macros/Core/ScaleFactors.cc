@@ -0,0 +1,273 @@
+#include "ScaleFactors.h"
+
+#include "stopUtils.h"
+
+#include "TFile.h"
+#include "TH2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+SFTable::SFTable()
+	: ncoefs_(1), outside_(1.), lowEdgeOpen_(false)
+{
+}
+
+SFTable::SFTable(int neta, const double* etaEdges, int npt, const double* ptEdges,
+		 int ncoefs, const double* coefs, double outside, bool lowEdgeOpen)
+	: etaEdges_(etaEdges, etaEdges + neta + 1), ptEdges_(ptEdges, ptEdges + npt + 1),
+	  ncoefs_(ncoefs), coefs_(coefs, coefs + neta * npt * ncoefs), unc_(neta * npt, 0.),
+	  outside_(outside), lowEdgeOpen_(lowEdgeOpen)
+{
+}
+
+SFTable::SFTable(const TH2* h, double outside)
+	: ncoefs_(1), outside_(outside), lowEdgeOpen_(false)
+{
+	const TAxis* xaxis = h->GetXaxis();
+	const TAxis* yaxis = h->GetYaxis();
+	for (int i = 1; i <= xaxis->GetNbins() + 1; ++i) etaEdges_.push_back(xaxis->GetBinLowEdge(i));
+	for (int j = 1; j <= yaxis->GetNbins() + 1; ++j) ptEdges_.push_back(yaxis->GetBinLowEdge(j));
+	for (int i = 1; i <= xaxis->GetNbins(); ++i) {
+		for (int j = 1; j <= yaxis->GetNbins(); ++j) {
+			coefs_.push_back(h->GetBinContent(i, j));
+			unc_.push_back(h->GetBinError(i, j));
+		}
+	}
+}
+
+int SFTable::find(const vector<double>& edges, float x, bool lowEdgeOpen){
+	// NaN fails every comparison and ends up outside
+	int i = lowEdgeOpen
+		? std::lower_bound(edges.begin(), edges.end(), x) - edges.begin() - 1
+		: std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+	return (i < 0 || i >= int(edges.size()) - 1) ? -1 : i;
+}
+
+int SFTable::bin(float pt, float eta) const {
+	if (etaEdges_.empty()) return -1;
+	int ieta = find(etaEdges_, fabs(eta), lowEdgeOpen_);
+	int ipt = find(ptEdges_, pt, lowEdgeOpen_);
+	if (ieta < 0 || ipt < 0) return -1;
+	return ieta * (ptEdges_.size() - 1) + ipt;
+}
+
+float SFTable::eval(int b, float pt) const {
+	// same operations as the hand-written c0 + c1*pt + c2*(pt*pt) + ... forms
+	const double* c = &coefs_[b * ncoefs_];
+	double value = 0.;
+	float power = 1.;
+	for (int k = 0; k < ncoefs_; ++k) {
+		value += c[k] * power;
+		power = pt * power;
+	}
+	return value;
+}
+
+float SFTable::nominal(float pt, float eta) const {
+	int b = bin(pt, eta);
+	return b < 0 ? outside_ : eval(b, pt);
+}
+
+SFValue SFTable::get(float pt, float eta) const {
+	SFValue sf;
+	int b = bin(pt, eta);
+	if (b < 0) {
+		sf.nominal = sf.up = sf.down = outside_;
+		return sf;
+	}
+	sf.nominal = eval(b, pt);
+	sf.up = sf.nominal + unc_[b];
+	sf.down = sf.nominal - unc_[b];
+	return sf;
+}
+
+//--------------------------------------------------------------------
+// built-in tables: the 2012 numbers of stopUtils
+
+namespace {
+
+	const double inf = std::numeric_limits<double>::infinity();
+
+	// HLT_Ele27_WP80 and HLT_IsoMu24, Z tag-and-probe
+	const double trigPtEdges[] = {20, 22, 24, 26, 28, 30, 32, 34, 36, 38, 40, 50, 60, 80, 100, 150, 200, inf};
+	const double trigElEtaEdges[] = {0, 1.5, 2.1};
+	const double trigEl[] = {
+		0.00, 0.00, 0.00, 0.07, 0.57, 0.85, 0.88, 0.89, 0.91, 0.92, 0.94, 0.95, 0.96, 0.96, 0.97, 0.97, 0.97,
+		0.00, 0.00, 0.03, 0.22, 0.52, 0.65, 0.70, 0.72, 0.74, 0.75, 0.77, 0.79, 0.79, 0.80, 0.82, 0.83, 0.85
+	};
+	const double trigMuEtaEdges[] = {0, 0.8, 1.5, 2.1};
+	const double trigMu[] = {
+		0.00, 0.02, 0.87, 0.90, 0.91, 0.91, 0.92, 0.93, 0.93, 0.93, 0.94, 0.95, 0.95, 0.94, 0.94, 0.93, 0.92,
+		0.00, 0.05, 0.78, 0.80, 0.81, 0.82, 0.82, 0.82, 0.83, 0.83, 0.84, 0.84, 0.84, 0.84, 0.84, 0.83, 0.83,
+		0.00, 0.10, 0.76, 0.78, 0.79, 0.80, 0.81, 0.81, 0.82, 0.82, 0.83, 0.83, 0.84, 0.84, 0.84, 0.82, 0.83
+	};
+
+	// ID and isolation, Z tag-and-probe; 0 below 20 GeV
+	const double effPtEdges[] = {-inf, 20, 30, 40, 50, 60, 80, 100, 150, 200, 300, inf};
+	const double effElEtaEdges[] = {0, 0.8, 1.4442};
+	const double effMuEtaEdges[] = {0, 0.8, 1.5, 2.1};
+	const double idEl[] = {
+		0., 0.9923, 0.9883, 0.9900, 0.9880, 0.9847, 0.9924, 0.9892, 1.0216, 0.9869, 1.0789,
+		0., 0.9632, 0.9707, 0.9755, 0.9777, 0.9797, 0.9687, 0.9813, 0.9940, 0.8853, 1.0286
+	};
+	const double idMu[] = {
+		0., 0.9839, 0.9850, 0.9865, 0.9829, 0.9835, 0.9785, 0.9847, 0.9958, 0.9937, 0.9754,
+		0., 0.9850, 0.9846, 0.9866, 0.9834, 0.9818, 0.9803, 0.9765, 1.0064, 0.9867, 1.0348,
+		0., 0.9876, 0.9890, 0.9902, 0.9864, 0.9909, 0.9995, 0.9884, 0.9613, 0.9652, 0.4286
+	};
+	const double isoEl[] = {
+		0., 0.9938, 0.9968, 0.9973, 0.9957, 0.9962, 0.9992, 0.9964, 0.9861, 1.0025, 1.1525,
+		0., 0.9939, 0.9963, 0.9965, 0.9963, 0.9952, 1.0013, 0.9882, 1.0068, 1.0076, 1.0084
+	};
+	const double isoMu[] = {
+		0., 0.9934, 0.9969, 0.9979, 0.9985, 0.9989, 0.9999, 1.0014, 0.9802, 1.0016, 0.9923,
+		0., 0.9974, 1.0004, 1.0001, 1.0007, 0.9997, 1.0075, 1.0056, 1.0203, 1.0059, 0.9822,
+		0., 1.0068, 1.0039, 1.0023, 1.0042, 1.0046, 1.0086, 1.0071, 0.9582, 1.0261, 1.0000
+	};
+
+	// fastsim correction for b, bins are (low, high]; the last one is open
+	const double anyEtaEdges[] = {-inf, inf};
+	const double fastsimPtEdges[] = {30, 40, 50, 60, 70, 80, 100, 120, 160, 210, 260, 320, 400, 500, 670, inf};
+	const float fastsimB[] = {0.982194, 0.980998, 0.992014, 0.994472, 0.996825, 0.999822, 1.00105, 1.00023,
+				  0.991994, 0.979123, 0.947207, 0.928006, 0.874260, 0.839610, 0.839610};
+
+	// SFlight_Moriond2013, CSVM: cubic in pt per |eta| bin
+	const double lightEtaEdges[] = {0, 0.8, 1.6, 2.4};
+	const double lightPtEdges[] = {-inf, inf};
+	const double light[] = {
+		1.06238, 0.00198635,  -4.89082e-06, 3.29312e-09,
+		1.08048, 0.00110831,  -2.96189e-06, 2.16266e-09,
+		1.09145, 0.000687171, -2.45054e-06, 1.7844e-09
+	};
+
+}
+
+#define NBINS(edges) (int(sizeof(edges)/sizeof(edges[0])) - 1)
+
+ScaleFactors::ScaleFactors()
+	: debug(false), btagBC_(0.963), fastsimTwiceAt670_(true)
+{
+	tables_[SLTRIG_EL] = SFTable(NBINS(trigElEtaEdges), trigElEtaEdges, NBINS(trigPtEdges), trigPtEdges, 1, trigEl);
+	tables_[SLTRIG_MU] = SFTable(NBINS(trigMuEtaEdges), trigMuEtaEdges, NBINS(trigPtEdges), trigPtEdges, 1, trigMu);
+	tables_[IDEFF_EL]  = SFTable(NBINS(effElEtaEdges), effElEtaEdges, NBINS(effPtEdges), effPtEdges, 1, idEl);
+	tables_[IDEFF_MU]  = SFTable(NBINS(effMuEtaEdges), effMuEtaEdges, NBINS(effPtEdges), effPtEdges, 1, idMu);
+	tables_[ISOEFF_EL] = SFTable(NBINS(effElEtaEdges), effElEtaEdges, NBINS(effPtEdges), effPtEdges, 1, isoEl);
+	tables_[ISOEFF_MU] = SFTable(NBINS(effMuEtaEdges), effMuEtaEdges, NBINS(effPtEdges), effPtEdges, 1, isoMu);
+
+	// stored as the floats getBtagSF multiplies with
+	vector<double> fastsim(fastsimB, fastsimB + NBINS(fastsimPtEdges));
+	tables_[BTAG_FASTSIM_B] = SFTable(NBINS(anyEtaEdges), anyEtaEdges, NBINS(fastsimPtEdges), fastsimPtEdges,
+					  1, &fastsim[0], 1., true);
+	tables_[BTAG_LIGHT] = SFTable(NBINS(lightEtaEdges), lightEtaEdges, NBINS(lightPtEdges), lightPtEdges, 4, light);
+}
+
+#undef NBINS
+
+bool ScaleFactors::load(Table table, const char* filename, const char* histname){
+	TFile* file = TFile::Open(filename);
+	if (!file || file->IsZombie()) {
+		printf("[ScaleFactors::load] cannot open %s\n", filename);
+		return false;
+	}
+	TH2* h = dynamic_cast<TH2*>(file->Get(histname));
+	if (!h) {
+		printf("[ScaleFactors::load] no TH2 %s in %s\n", histname, filename);
+		file->Close();
+		return false;
+	}
+	tables_[table] = SFTable(h);
+	if (table == BTAG_FASTSIM_B) fastsimTwiceAt670_ = false;
+	file->Close();
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void ScaleFactors::check(const char* what, float value, float reference) const {
+	if (value != reference) {
+		printf("[ScaleFactors] %s: %f, stopUtils gives %f\n", what, value, reference);
+		exit(1);
+	}
+}
+
+SFValue ScaleFactors::lepton(Table el, Table mu, int id, float pt, float eta) const {
+	if (abs(id) == 11) return tables_[el].get(pt, eta);
+	if (abs(id) == 13) return tables_[mu].get(pt, eta);
+	SFValue sf = {1., 1., 1.};
+	return sf;
+}
+
+SFValue ScaleFactors::slTrigWeight(int id, float pt, float eta) const {
+	if (abs(id) != 11 && abs(id) != 13)
+		std::cout << "WARNING: unrecognized lepton id " << id << ". Return trigger efficiency = 1" << std::endl;
+	SFValue sf = lepton(SLTRIG_EL, SLTRIG_MU, id, pt, eta);
+	if (debug) check("slTrigWeight", sf.nominal, getsltrigweight(id, pt, eta));
+	return sf;
+}
+
+float ScaleFactors::dlTrigWeight(int id1, int id2) const {
+	float sf = -999.;
+	if (abs(id1) == 11 && abs(id2) == 11) sf = 0.95;
+	else if (abs(id1) == 13 && abs(id2) == 13) sf = 0.88;
+	else if (abs(id1) != abs(id2)) sf = 0.92;
+	if (debug) check("dlTrigWeight", sf, getdltrigweight(id1, id2));
+	return sf;
+}
+
+SFValue ScaleFactors::idEffWeight(int id, float pt, float eta) const {
+	SFValue sf = lepton(IDEFF_EL, IDEFF_MU, id, pt, eta);
+	if (debug) check("idEffWeight", sf.nominal, getideffweight(id, pt, eta));
+	return sf;
+}
+
+SFValue ScaleFactors::isoEffWeight(int id, float pt, float eta) const {
+	SFValue sf = lepton(ISOEFF_EL, ISOEFF_MU, id, pt, eta);
+	if (debug) check("isoEffWeight", sf.nominal, getisoeffweight(id, pt, eta));
+	return sf;
+}
+
+//--------------------------------------------------------------------
+
+SFValue ScaleFactors::btagSF(float pt, float eta, int flavour, bool fastsim) const {
+	SFValue sf;
+	if (abs(flavour) == 4 || abs(flavour) == 5) {
+		sf.nominal = sf.up = sf.down = btagBC_;
+		if (abs(flavour) == 5 && fastsim) {
+			SFValue corr = tables_[BTAG_FASTSIM_B].get(pt, eta);
+			sf.nominal *= corr.nominal;
+			sf.up *= corr.up;
+			sf.down *= corr.down;
+			// getBtagSF applies the 500-670 bin twice at exactly 670 GeV,
+			// once in its bin loop and once as overflow; kept for parity
+			if (fastsimTwiceAt670_ && pt == 670.f) {
+				sf.nominal *= corr.nominal;
+				sf.up *= corr.up;
+				sf.down *= corr.down;
+			}
+		}
+	} else {
+		sf = tables_[BTAG_LIGHT].get(pt, eta);
+		if (fabs(eta) >= 2.4 || !(fabs(eta) >= 0.))
+			std::cout << __FILE__ << " " << __LINE__ << ":btagSF: invalid eta: " << eta << ", or invalid id: " << flavour << std::endl;
+	}
+	if (debug) check("btagSF", sf.nominal, getBtagSF(pt, eta, flavour, fastsim));
+	return sf;
+}
+
+SFValue ScaleFactors::btagWeight(const vector<LorentzVector>& jets, const vector<int>& flavour,
+				 const vector<int>& idx, bool fastsim) const {
+	SFValue weight = {1., 1., 1.};
+	for (unsigned int i = 0; i < idx.size(); ++i) {
+		int j = idx.at(i);
+		SFValue sf = btagSF(jets.at(j).pt(), jets.at(j).eta(), flavour.at(j), fastsim);
+		weight.nominal *= sf.nominal;
+		weight.up *= sf.up;
+		weight.down *= sf.down;
+	}
+	return weight;
+}
@@ -0,0 +1,100 @@
+#ifndef SCALEFACTORS_H
+#define SCALEFACTORS_H
+
+#include "Math/LorentzVector.h"
+
+#include <vector>
+
+class TH2;
+
+using namespace std;
+
+// a scale factor and its +-1 sigma values
+struct SFValue {
+	float nominal, up, down;
+};
+
+/* Scale factor binned in |eta| and pt.
+ *
+ * Each bin holds up to four coefficients of a cubic in pt (one for a
+ * constant) and an absolute uncertainty.  A lookup is two binary searches
+ * on the bin edges and one array access.  Bins are [low, high), or
+ * (low, high] for tables made with lowEdgeOpen; outside the table the
+ * value is `outside'.
+ */
+class SFTable {
+
+public:
+	SFTable();
+	// neta+1 and npt+1 edges; coefs[(ieta*npt + ipt)*ncoefs + k]
+	SFTable(int neta, const double* etaEdges, int npt, const double* ptEdges,
+		int ncoefs, const double* coefs, double outside = 1., bool lowEdgeOpen = false);
+	// x: |eta|, y: pt, bin error: uncertainty; overflow bins are outside
+	SFTable(const TH2* h, double outside = 1.);
+
+	SFValue get(float pt, float eta) const;
+	float nominal(float pt, float eta) const;
+
+	bool empty() const { return etaEdges_.empty(); }
+
+private:
+	// -1 outside
+	int bin(float pt, float eta) const;
+	static int find(const vector<double>& edges, float x, bool lowEdgeOpen);
+	float eval(int bin, float pt) const;
+
+	vector<double> etaEdges_, ptEdges_;
+	int ncoefs_;
+	vector<double> coefs_, unc_;
+	double outside_;
+	bool lowEdgeOpen_;
+};
+
+/* Lepton and b-tag scale factors of the 2012 analysis as lookup tables.
+ *
+ * The built-in tables hold the numbers of getsltrigweight, getideffweight,
+ * getisoeffweight, getdltrigweight and getBtagSF in stopUtils; any of them
+ * can be replaced by a TH2 from a ROOT file with load().  Every lookup gives
+ * the nominal value and its up and down variations together (equal to the
+ * nominal for tables without uncertainties), and btagWeight() gives the
+ * product over the tagged jets of an event.
+ *
+ * Set debug to compare every nominal value with the stopUtils function it
+ * replaces; only meaningful while the built-in tables are in use.
+ */
+class ScaleFactors {
+	typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
+
+public:
+	enum Table { SLTRIG_EL, SLTRIG_MU, IDEFF_EL, IDEFF_MU, ISOEFF_EL, ISOEFF_MU,
+		     BTAG_FASTSIM_B, BTAG_LIGHT, NTABLES };
+
+	ScaleFactors();
+
+	bool load(Table table, const char* filename, const char* histname);
+
+	SFValue slTrigWeight(int id, float pt, float eta) const;
+	float dlTrigWeight(int id1, int id2) const;
+	SFValue idEffWeight(int id, float pt, float eta) const;
+	SFValue isoEffWeight(int id, float pt, float eta) const;
+
+	// CSVM; b and c share one flat value, fastsim corrects b jets (twice
+	// at pt == 670 with the built-in table, as getBtagSF does)
+	SFValue btagSF(float pt, float eta, int flavour, bool fastsim = false) const;
+	// product over jets[idx[i]]
+	SFValue btagWeight(const vector<LorentzVector>& jets, const vector<int>& flavour,
+			   const vector<int>& idx, bool fastsim = false) const;
+
+	bool debug;
+
+private:
+	SFValue lepton(Table el, Table mu, int id, float pt, float eta) const;
+	void check(const char* what, float value, float reference) const;
+
+	SFTable tables_[NTABLES];
+	double btagBC_;
+	// built-in fastsim table only, see btagSF()
+	bool fastsimTwiceAt670_;
+};
+
+#endif
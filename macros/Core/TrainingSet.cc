@@ -0,0 +1,353 @@
+#include "TrainingSet.h"
+#include "CutScan.h"
+
+#include "TCut.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TParameter.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+#include "TMVA/DataSetInfo.h"
+#include "TMVA/Factory.h"
+#include "TMVA/VariableInfo.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+//--------------------------------------------------------------------
+
+TrainingSet::TrainingSet(double trainFraction)
+	: trainFraction_(trainFraction),
+	  run_("run"), lumi_("lumi"), event_("event"),
+	  mg_("mg"), ml_("ml"), x_("x"),
+	  tree_(0)
+{
+}
+
+TrainingSet::~TrainingSet(){
+	delete tree_;
+}
+
+void TrainingSet::addVariable(const string& expression){
+	variables_.push_back(expression);
+}
+
+void TrainingSet::addVariables(TMVA::Factory* factory){
+	TMVA::DataSetInfo& info = factory->DefaultDataSetInfo();
+	for (unsigned int i = 0; i < info.GetNVariables(); ++i)
+		addVariable(info.GetVariableInfo(i).GetExpression().Data());
+}
+
+void TrainingSet::setEventId(const string& run, const string& lumi, const string& event){
+	run_ = run;
+	lumi_ = lumi;
+	event_ = event;
+}
+
+void TrainingSet::setPoint(const string& mg, const string& ml, const string& x){
+	mg_ = mg;
+	ml_ = ml;
+	x_ = x;
+}
+
+int TrainingSet::findLeaf(const string& name) const {
+	for (unsigned int i = 0; i < leaves_.size(); ++i)
+		if (leaves_[i] == name) return i;
+	return -1;
+}
+
+// splitmix64 finalizer
+static unsigned long long mix(unsigned long long h){
+	h ^= h >> 30;
+	h *= 0xbf58476d1ce4e5b9ULL;
+	h ^= h >> 27;
+	h *= 0x94d049bb133111ebULL;
+	h ^= h >> 31;
+	return h;
+}
+
+bool TrainingSet::inTraining(unsigned int run, unsigned int lumi, unsigned int event, double fraction){
+	unsigned long long h = mix(mix(((unsigned long long)run << 32) | lumi) ^ event);
+	// top 53 bits as a number in [0, 1)
+	return (h >> 11) * (1. / 9007199254740992.) < fraction;
+}
+
+//--------------------------------------------------------------------
+
+bool TrainingSet::addLeaves(TChain* chain, const string& expression){
+	TTreeFormula f("leaves", expression.c_str(), chain);
+	if (f.GetNdim() == 0) {
+		printf("[TrainingSet] cannot compile %s\n", expression.c_str());
+		return false;
+	}
+	for (int i = 0; i < f.GetNcodes(); ++i) {
+		TLeaf* leaf = f.GetLeaf(i);
+		if (!leaf) continue;
+		if (leaf->GetLeafCount() || leaf->GetLenStatic() > 1 || leaf->InheritsFrom("TLeafElement") || leaf->InheritsFrom("TLeafObject")) {
+			printf("[TrainingSet] %s: %s is not a scalar leaf\n", expression.c_str(), leaf->GetName());
+			return false;
+		}
+		string name = leaf->GetBranch()->GetName();
+		if (findLeaf(name) >= 0) continue;
+		if (size() > 0) {
+			printf("[TrainingSet] %s: %s is not in the events extracted so far\n", expression.c_str(), name.c_str());
+			return false;
+		}
+		leaves_.push_back(name);
+		columns_.push_back(vector<float>());
+	}
+	return true;
+}
+
+Long64_t TrainingSet::extract(TChain* chain, int label, const char* selection, const char* weight){
+	if (chain->GetEntries() == 0) return 0;
+	chain->LoadTree(0);
+	for (unsigned int i = 0; i < variables_.size(); ++i)
+		if (!addLeaves(chain, variables_[i])) exit(1);
+	clearTree();
+
+	// recorded for checkSelection()
+	string& sel = selections_[label];
+	string& w = weights_[label];
+	if (sel.empty() && w.empty()) {
+		sel = selection;
+		w = weight;
+	} else if (sel != selection || w != weight) {
+		sel += string("; ") + selection;
+		w += string("; ") + weight;
+	}
+
+	ChainScan scan(chain, selection, weight);
+	vector<int> vars(leaves_.size());
+	for (unsigned int i = 0; i < leaves_.size(); ++i) vars[i] = scan.addVariable(leaves_[i].c_str());
+	int run = scan.addVariable(run_.c_str());
+	int lumi = scan.addVariable(lumi_.c_str());
+	int event = scan.addVariable(event_.c_str());
+	int mg = scan.addVariable(mg_.c_str());
+	int ml = scan.addVariable(ml_.c_str());
+	int x = scan.addVariable(x_.c_str());
+
+	Long64_t n = 0, ntrain = 0;
+	while (scan.next()) {
+		for (unsigned int i = 0; i < vars.size(); ++i) columns_[i].push_back(scan.value(vars[i]));
+		weight_.push_back(scan.weight());
+		label_.push_back(label);
+		bool train = inTraining(scan.value(run), scan.value(lumi), scan.value(event), trainFraction_);
+		train_.push_back(train);
+		MassPoint p = { float(scan.value(mg)), float(scan.value(ml)), float(scan.value(x)) };
+		point_.push_back(p);
+		++n;
+		if (train) ++ntrain;
+	}
+	printf("[TrainingSet] class %d: %lld events, %lld for training\n", label, n, ntrain);
+	return n;
+}
+
+//--------------------------------------------------------------------
+
+void TrainingSet::fillTree(TTree* t) const {
+	vector<float> row(leaves_.size());
+	float w;
+	char label, train;
+	MassPoint p;
+	for (unsigned int i = 0; i < leaves_.size(); ++i)
+		t->Branch(leaves_[i].c_str(), &row[i], (leaves_[i] + "/F").c_str());
+	t->Branch("ts_weight", &w, "ts_weight/F");
+	t->Branch("ts_label", &label, "ts_label/B");
+	t->Branch("ts_train", &train, "ts_train/B");
+	t->Branch("ts_mg", &p.mg, "ts_mg/F");
+	t->Branch("ts_ml", &p.ml, "ts_ml/F");
+	t->Branch("ts_x", &p.x, "ts_x/F");
+
+	for (Long64_t k = 0; k < size(); ++k) {
+		for (unsigned int i = 0; i < leaves_.size(); ++i) row[i] = columns_[i][k];
+		w = weight_[k];
+		label = label_[k];
+		train = train_[k];
+		p = point_[k];
+		t->Fill();
+	}
+	t->ResetBranchAddresses();
+}
+
+TTree* TrainingSet::tree() const {
+	if (!tree_) {
+		tree_ = new TTree("trainingset", "training and testing events");
+		tree_->SetDirectory(0);
+		fillTree(tree_);
+	}
+	return tree_;
+}
+
+void TrainingSet::clearTree(){
+	delete tree_;
+	tree_ = 0;
+}
+
+bool TrainingSet::write(const char* filename) const {
+	TDirectory* old = gDirectory;
+	TFile* file = TFile::Open(filename, "RECREATE");
+	if (!file || file->IsZombie()) {
+		printf("[TrainingSet] cannot write %s\n", filename);
+		delete file;
+		return false;
+	}
+
+	TTree* t = new TTree("trainingset", "training and testing events");
+	fillTree(t);
+	t->GetUserInfo()->Add(new TParameter<double>("trainFraction", trainFraction_));
+	map<int, string>::const_iterator it;
+	for (it = selections_.begin(); it != selections_.end(); ++it)
+		t->GetUserInfo()->Add(new TNamed(Form("selection_%d", it->first), it->second.c_str()));
+	for (it = weights_.begin(); it != weights_.end(); ++it)
+		t->GetUserInfo()->Add(new TNamed(Form("weight_%d", it->first), it->second.c_str()));
+	t->Write();
+	file->Close();
+	delete file;
+	old->cd();
+	printf("[TrainingSet] %lld events, %u leaves written to %s\n", size(), (unsigned int)leaves_.size(), filename);
+	return true;
+}
+
+bool TrainingSet::read(const char* filename){
+	TDirectory* old = gDirectory;
+	TFile* file = TFile::Open(filename);
+	TTree* t = file ? (TTree*)file->Get("trainingset") : 0;
+	if (!t) {
+		printf("[TrainingSet] no training set in %s\n", filename);
+		delete file;
+		old->cd();
+		return false;
+	}
+
+	clearTree();
+	TParameter<double>* fraction = (TParameter<double>*)t->GetUserInfo()->FindObject("trainFraction");
+	if (fraction) trainFraction_ = fraction->GetVal();
+	selections_.clear();
+	weights_.clear();
+	for (int label = 0; label <= 1; ++label) {
+		TNamed* sel = (TNamed*)t->GetUserInfo()->FindObject(Form("selection_%d", label));
+		TNamed* w = (TNamed*)t->GetUserInfo()->FindObject(Form("weight_%d", label));
+		if (sel) selections_[label] = sel->GetTitle();
+		if (w) weights_[label] = w->GetTitle();
+	}
+
+	// every branch but the ts_ ones is a leaf of the babies
+	leaves_.clear();
+	TObjArray* branches = t->GetListOfBranches();
+	for (int i = 0; i < branches->GetEntries(); ++i) {
+		string name = branches->At(i)->GetName();
+		if (name.compare(0, 3, "ts_") != 0) leaves_.push_back(name);
+	}
+
+	const Long64_t n = t->GetEntries();
+	vector<float> row(leaves_.size());
+	float w;
+	char label, train;
+	MassPoint p;
+	for (unsigned int i = 0; i < leaves_.size(); ++i) t->SetBranchAddress(leaves_[i].c_str(), &row[i]);
+	t->SetBranchAddress("ts_weight", &w);
+	t->SetBranchAddress("ts_label", &label);
+	t->SetBranchAddress("ts_train", &train);
+	t->SetBranchAddress("ts_mg", &p.mg);
+	t->SetBranchAddress("ts_ml", &p.ml);
+	t->SetBranchAddress("ts_x", &p.x);
+
+	columns_.assign(leaves_.size(), vector<float>(n));
+	weight_.resize(n);
+	label_.resize(n);
+	train_.resize(n);
+	point_.resize(n);
+	for (Long64_t k = 0; k < n; ++k) {
+		t->GetEntry(k);
+		for (unsigned int i = 0; i < leaves_.size(); ++i) columns_[i][k] = row[i];
+		weight_[k] = w;
+		label_[k] = label;
+		train_[k] = train;
+		point_[k] = p;
+	}
+	delete file;
+	old->cd();
+	printf("[TrainingSet] %lld events, %u leaves read from %s\n", n, (unsigned int)leaves_.size(), filename);
+	return true;
+}
+
+bool TrainingSet::checkSelection(int label, const char* selection, const char* weight) const {
+	map<int, string>::const_iterator sel = selections_.find(label);
+	map<int, string>::const_iterator w = weights_.find(label);
+	if (sel == selections_.end() || w == weights_.end()) {
+		printf("[TrainingSet] class %d: the file does not record its selection, extract again\n", label);
+		return false;
+	}
+	if (sel->second != selection || w->second != weight) {
+		printf("[TrainingSet] class %d was extracted with another selection or weight, extract again\n", label);
+		printf("  file:      %s\n  weight:    %s\n", sel->second.c_str(), w->second.c_str());
+		printf("  requested: %s\n  weight:    %s\n", selection, weight);
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+Long64_t TrainingSet::rows(const vector<string>& expressions, vector<float>& x, const char* selection, vector<Long64_t>* index) const {
+	x.clear();
+	if (index) index->clear();
+	TTree* t = tree();
+	if (t->GetEntries() == 0) return 0;
+	t->LoadTree(0);
+
+	TTreeFormula sel("rowsel", selection, t);
+	vector<TTreeFormula*> f(expressions.size());
+	for (unsigned int i = 0; i < expressions.size(); ++i) {
+		f[i] = new TTreeFormula(Form("row%u", i), expressions[i].c_str(), t);
+		if (f[i]->GetNdim() == 0) {
+			printf("[TrainingSet] cannot compile %s\n", expressions[i].c_str());
+			exit(1);
+		}
+	}
+
+	Long64_t n = 0;
+	for (Long64_t k = 0; k < t->GetEntries(); ++k) {
+		t->LoadTree(k);
+		if (sel.EvalInstance(0) == 0) continue;
+		for (unsigned int i = 0; i < f.size(); ++i) x.push_back(f[i]->EvalInstance(0));
+		if (index) index->push_back(k);
+		++n;
+	}
+	for (unsigned int i = 0; i < f.size(); ++i) delete f[i];
+	return n;
+}
+
+bool TrainingSet::fill(TMVA::Factory* factory, const char* signalCut) const {
+	TTree* t = tree();
+	if (t->GetEntries() == 0) {
+		printf("[TrainingSet] no events\n");
+		return false;
+	}
+	t->LoadTree(0);
+
+	// the variables of the factory must be expressions of the leaves we have
+	TMVA::DataSetInfo& info = factory->DefaultDataSetInfo();
+	for (unsigned int i = 0; i < info.GetNVariables(); ++i) {
+		TString expression = info.GetVariableInfo(i).GetExpression();
+		TTreeFormula f("check", expression, t);
+		if (f.GetNdim() == 0) {
+			printf("[TrainingSet] %s needs leaves the set does not have, extract again\n", expression.Data());
+			return false;
+		}
+	}
+
+	TCut signal = TCut("ts_label==1") && TCut(signalCut);
+	TCut background("ts_label==0");
+	factory->AddTree(t, "Signal", 1., signal && "ts_train==1", "train");
+	factory->AddTree(t, "Signal", 1., signal && "ts_train==0", "test");
+	factory->AddTree(t, "Background", 1., background && "ts_train==1", "train");
+	factory->AddTree(t, "Background", 1., background && "ts_train==0", "test");
+	factory->SetSignalWeightExpression("ts_weight");
+	factory->SetBackgroundWeightExpression("ts_weight");
+	return true;
+}
@@ -0,0 +1,118 @@
+#ifndef TRAININGSET_H
+#define TRAININGSET_H
+
+#include "MassIndex.h"
+
+#include "TChain.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class TTree;
+namespace TMVA { class Factory; }
+
+using namespace std;
+
+/* Training and testing events of a classifier, taken from the minibabies
+ * in one pass and kept in memory as columns: one float array per leaf the
+ * input variables read, and per event the weight, the class (1 signal, 0
+ * background), the mass point and whether it is a training or a testing
+ * event.
+ *
+ *   TrainingSet set;
+ *   set.addVariable("mini_met");
+ *   set.addVariable("mini_htssm/(mini_htosm+mini_htssm)");
+ *   set.extract(chSignal, 1, sel.GetTitle());
+ *   set.extract(chBackground, 0, sel.GetTitle());
+ *   set.write("train_T2tt_1.root");
+ *   ...
+ *   set.read("train_T2tt_1.root");
+ *   if (!set.checkSelection(1, sel.GetTitle()) || !set.checkSelection(0, sel.GetTitle())) ...
+ *   set.fill(factory);
+ *
+ * Keeping leaves rather than the values of the expressions lets TMVA see
+ * the same expressions as with the babies (the weight files do not change)
+ * and lets any expression of the extracted leaves be trained on without
+ * going back to the babies.  tree() gives the columns as an in-memory tree
+ * with the leaves under their own names and the rest as ts_weight,
+ * ts_label, ts_train, ts_mg, ts_ml and ts_x; rows() evaluates expressions
+ * on it for BDTForest::evaluate().
+ *
+ * The split goes by a hash of run, lumi and event, so an event lands on
+ * the same side in every extraction, whatever the selection and the order
+ * of the files.
+ */
+class TrainingSet {
+
+public:
+	// fraction of the events used for training
+	TrainingSet(double trainFraction = 0.5);
+	~TrainingSet();
+
+	// TTree::Draw expressions of scalar leaves, before extract()
+	void addVariable(const string& expression);
+	// the input variables of a factory
+	void addVariables(TMVA::Factory* factory);
+	// expressions of the event id and of the mass point tags
+	void setEventId(const string& run, const string& lumi, const string& event);
+	void setPoint(const string& mg, const string& ml, const string& x);
+
+	// adds the entries of the chain passing the selection, returns how many
+	Long64_t extract(TChain* chain, int label, const char* selection, const char* weight = "mini_weight");
+
+	// the selections and weights of the extractions go along
+	bool write(const char* filename) const;
+	// replaces the content with that of a file written by write()
+	bool read(const char* filename);
+	// false, with a message, if the class was not extracted with this
+	// selection and weight; for reusing a file, after read()
+	bool checkSelection(int label, const char* selection, const char* weight = "mini_weight") const;
+
+	Long64_t size() const { return weight_.size(); }
+	const vector<string>& leaves() const { return leaves_; }
+	// -1 if the set does not have it
+	int findLeaf(const string& name) const;
+	const float* column(int leaf) const { return &columns_[leaf][0]; }
+	float weight(Long64_t i) const { return weight_[i]; }
+	int label(Long64_t i) const { return label_[i]; }
+	bool isTraining(Long64_t i) const { return train_[i]; }
+	const MassPoint& point(Long64_t i) const { return point_[i]; }
+
+	// the columns as a tree in memory, owned by the set
+	TTree* tree() const;
+
+	// the expressions for the events passing the selection (on tree()), one
+	// row of expressions.size() values per event; returns the number of rows
+	Long64_t rows(const vector<string>& expressions, vector<float>& x, const char* selection = "1", vector<Long64_t>* index = 0) const;
+
+	// gives tree() to the factory, training and testing as split here, and
+	// sets its weight expressions; signalCut (on tree()) picks the signal
+	// mass points to use.  False if a variable of the factory needs a leaf
+	// the set does not have.  The set must live until the training is done.
+	bool fill(TMVA::Factory* factory, const char* signalCut = "") const;
+
+	// the side of an event, by its id
+	static bool inTraining(unsigned int run, unsigned int lumi, unsigned int event, double fraction);
+
+private:
+	bool addLeaves(TChain* chain, const string& expression);
+	void fillTree(TTree* t) const;
+	void clearTree();
+
+	double trainFraction_;
+	map<int, string> selections_, weights_;	// by label, "; " between extractions that differ
+	vector<string> variables_;
+	string run_, lumi_, event_;
+	string mg_, ml_, x_;
+
+	vector<string> leaves_;
+	vector< vector<float> > columns_;	// [leaf][event]
+	vector<float> weight_;
+	vector<char> label_, train_;
+	vector<MassPoint> point_;
+
+	mutable TTree* tree_;
+};
+
+#endif
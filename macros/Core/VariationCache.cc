@@ -0,0 +1,177 @@
+#include "VariationCache.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+VariationCache::VariationCache()
+	: debug(false), nChi2Entries_(0), nMT2Entries_(0),
+	  nChi2Calls_(0), nChi2Reused_(0), nWFitsReused_(0),
+	  nMT2Calls_(0), nMT2Reused_(0), nPairCalls_(0), nPairsReused_(0),
+	  nMismatches_(0)
+{
+}
+
+void VariationCache::newEvent(const LorentzVector& lep){
+	lep_ = lep;
+	// entries are recycled to keep their capacity
+	nChi2Entries_ = 0;
+	nMT2Entries_ = 0;
+}
+
+//--------------------------------------------------------------------
+
+void VariationCache::jetsKey(const vector<LorentzVector>& jets, const vector<float>* sigma_jets, unsigned int n, vector<float>& key){
+	key.clear();
+	for (unsigned int i = 0; i < n; ++i) {
+		key.push_back(jets[i].Px());
+		key.push_back(jets[i].Py());
+		key.push_back(jets[i].Pz());
+		key.push_back(jets[i].E());
+		if (sigma_jets) key.push_back(sigma_jets->at(i));
+	}
+}
+
+void VariationCache::tagKey(const vector<float>& btag, unsigned int n, vector<char>& key){
+	// calculateChi2SNT tests both btag > BTAG_MED and btag < BTAG_MED,
+	// so a value exactly on the threshold is a decision of its own
+	key.clear();
+	for (unsigned int i = 0; i < n; ++i)
+		key.push_back(btag[i] > BTAG_MED ? 2 : (btag[i] < BTAG_MED ? 0 : 1));
+}
+
+bool VariationCache::sameBits(const vector<float>& a, const vector<float>& b){
+	return a.size() == b.size() && (a.empty() || !memcmp(&a[0], &b[0], a.size() * sizeof(float)));
+}
+
+int VariationCache::find(const vector< vector<char> >& keys, const vector<char>& key){
+	for (unsigned int i = 0; i < keys.size(); ++i)
+		if (keys[i] == key) return i;
+	return -1;
+}
+
+void VariationCache::check(const char* what, double cached, double direct){
+	if (!memcmp(&cached, &direct, sizeof(double))) return;
+	++nMismatches_;
+	printf("[VariationCache] %s mismatch: cached %.9g direct %.9g\n", what, cached, direct);
+}
+
+//--------------------------------------------------------------------
+
+double VariationCache::getChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<float>& btag){
+
+	assert(jets.size() == sigma_jets.size());
+	assert(jets.size() == btag.size());
+	++nChi2Calls_;
+
+	unsigned int n_jets = jets.size() > 6 ? 6 : jets.size();
+	jetsKey(jets, &sigma_jets, n_jets, key_);
+	tagKey(btag, n_jets, tags_);
+
+	Chi2Entry* entry = 0;
+	for (unsigned int e = 0; e < nChi2Entries_; ++e)
+		if (sameBits(chi2Entries_[e].jetsKey, key_)) { entry = &chi2Entries_[e]; break; }
+
+	if (entry) {
+		int r = find(entry->tagKeys, tags_);
+		if (r >= 0) {
+			++nChi2Reused_;
+			if (debug) check("chi2", entry->results[r], calculateChi2SNT(jets, sigma_jets, btag));
+			return entry->results[r];
+		}
+		++nWFitsReused_;
+	} else {
+		if (nChi2Entries_ == chi2Entries_.size()) chi2Entries_.push_back(Chi2Entry());
+		entry = &chi2Entries_[nChi2Entries_++];
+		entry->jetsKey = key_;
+		entry->tagKeys.clear();
+		entry->results.clear();
+		fitChi2SNTWPairs(jets, sigma_jets, entry->wfits);
+	}
+
+	double chi2 = chi2SNTFromWFits(jets, sigma_jets, btag, entry->wfits);
+	entry->tagKeys.push_back(tags_);
+	entry->results.push_back(chi2);
+	if (debug) check("chi2", chi2, calculateChi2SNT(jets, sigma_jets, btag));
+	return chi2;
+}
+
+//--------------------------------------------------------------------
+
+double VariationCache::getMT2w(vector<LorentzVector>& jets, vector<float>& btag, float met, float metphi, MT2Type mt2type){
+
+	assert(jets.size() == btag.size());
+	++nMT2Calls_;
+
+	// require at least 2 jets
+	if ( jets.size()<2 ) return 99999.;
+
+	unsigned int n = jets.size();
+	jetsKey(jets, 0, n, key_);
+	key_.push_back(met);
+	key_.push_back(metphi);
+	tags_.clear();
+	for (unsigned int i = 0; i < n; ++i) tags_.push_back(btag[i] > BTAG_MED);
+	tags_.push_back(mt2type);
+
+	MT2Entry* entry = 0;
+	for (unsigned int e = 0; e < nMT2Entries_; ++e)
+		if (sameBits(mt2Entries_[e].jetsKey, key_)) { entry = &mt2Entries_[e]; break; }
+
+	if (entry) {
+		int r = find(entry->tagKeys, tags_);
+		if (r >= 0) {
+			++nMT2Reused_;
+			if (debug) check("MT2", entry->results[r], calculateMT2w(jets, btag, lep_, met, metphi, mt2type));
+			return entry->results[r];
+		}
+	} else {
+		if (nMT2Entries_ == mt2Entries_.size()) mt2Entries_.push_back(MT2Entry());
+		entry = &mt2Entries_[nMT2Entries_++];
+		entry->jetsKey = key_;
+		entry->pairs.clear();
+		entry->tagKeys.clear();
+		entry->results.clear();
+	}
+
+	// same minimisation as calculateMT2w, with the pairs shared between
+	// tag variations
+	getMT2wCombinations(btag, combinations_);
+
+	float min_mt2w = 9999;
+	for (unsigned int c = 0; c < combinations_.size(); c++){
+		int o = combinations_[c].first, b = combinations_[c].second;
+		int pairKey = (mt2type * n + o) * n + b;
+		++nPairCalls_;
+
+		float c_mt2w;
+		map<int, double>::const_iterator it = entry->pairs.find(pairKey);
+		if (it != entry->pairs.end()) {
+			++nPairsReused_;
+			c_mt2w = it->second;
+		} else {
+			double value = mt2wWrapper(lep_, jets[o], jets[b], met, metphi, mt2type);
+			entry->pairs[pairKey] = value;
+			c_mt2w = value;
+		}
+		if (c_mt2w < min_mt2w)
+			min_mt2w = c_mt2w;
+	}
+
+	double result = min_mt2w;
+	entry->tagKeys.push_back(tags_);
+	entry->results.push_back(result);
+	if (debug) check("MT2", result, calculateMT2w(jets, btag, lep_, met, metphi, mt2type));
+	return result;
+}
+
+//--------------------------------------------------------------------
+
+void VariationCache::printSummary() const {
+	printf("[VariationCache] chi2: %llu calls, %llu reused, %llu W fits shared\n",
+	       nChi2Calls_, nChi2Reused_, nWFitsReused_);
+	printf("[VariationCache] MT2 : %llu calls, %llu reused, %llu of %llu pairs shared\n",
+	       nMT2Calls_, nMT2Reused_, nPairsReused_, nPairCalls_);
+	if (debug)
+		printf("[VariationCache] debug: %llu mismatches with the direct calculation\n", nMismatches_);
+}
@@ -0,0 +1,81 @@
+#ifndef VARIATIONCACHE_H
+#define VARIATIONCACHE_H
+
+#include "../Core/stopUtils.h"
+
+#include <map>
+#include <vector>
+
+using namespace std;
+
+/* Event-level chi2 / MT2 for systematic variations.
+ *
+ * Most JES and b-tag variations leave the inputs the solvers actually look at
+ * unchanged: the b-tag shape variations rarely move a jet across BTAG_MED,
+ * and a variation that does only changes the b assignment, not the W pair
+ * fits.  Each call is fingerprinted by its effective inputs
+ *
+ *   chi2: p4 and sigma of the 6 leading jets (W fits), plus their tag
+ *         decisions (b assignment)
+ *   MT2 : p4 of all jets and the MET (per pair), plus the tag decisions
+ *         (combinations) and MT2 type
+ *
+ * and anything already computed for the same fingerprint in this event is
+ * reused.  Results are bit for bit those of calculateChi2SNT and
+ * calculateMT2w; set debug to recompute every reused value and compare.
+ *
+ * Call newEvent() before the first evaluation of each event.
+ */
+class VariationCache {
+	typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
+
+public:
+	VariationCache();
+
+	void newEvent(const LorentzVector& lep);
+
+	double getChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<float>& btag);
+	double getMT2w(vector<LorentzVector>& jets, vector<float>& btag, float met, float metphi, MT2Type mt2type = MT2w);
+
+	void printSummary() const;
+
+	bool debug;
+
+private:
+	struct Chi2Entry {
+		vector<float> jetsKey;			// p4 and sigma of the fitted jets
+		vector<Chi2WFit> wfits;
+		vector< vector<char> > tagKeys;
+		vector<double> results;
+	};
+
+	struct MT2Entry {
+		vector<float> jetsKey;			// p4 of all jets, met, metphi
+		map<int, double> pairs;			// (type, jet_o, jet_b) -> mt2wWrapper
+		vector< vector<char> > tagKeys;		// tag decisions and type
+		vector<double> results;
+	};
+
+	static void jetsKey(const vector<LorentzVector>& jets, const vector<float>* sigma_jets, unsigned int n, vector<float>& key);
+	static void tagKey(const vector<float>& btag, unsigned int n, vector<char>& key);
+	static bool sameBits(const vector<float>& a, const vector<float>& b);
+	static int find(const vector< vector<char> >& keys, const vector<char>& key);
+	void check(const char* what, double cached, double direct);
+
+	LorentzVector lep_;
+	vector<Chi2Entry> chi2Entries_;
+	vector<MT2Entry> mt2Entries_;
+	unsigned int nChi2Entries_;
+	unsigned int nMT2Entries_;
+
+	// scratch
+	vector<float> key_;
+	vector<char> tags_;
+	vector< pair<int, int> > combinations_;
+
+	unsigned long long nChi2Calls_, nChi2Reused_, nWFitsReused_;
+	unsigned long long nMT2Calls_, nMT2Reused_, nPairCalls_, nPairsReused_;
+	unsigned long long nMismatches_;
+};
+
+#endif
@@ -793,46 +793,117 @@ bool passIsoTrkVeto_v4()
 
 
 //-------------------------------------------
-// >=1 selected lepton and trigger
+// selection steps, see singleLeptonCutflow,
+// dileptonCutflow and lepPlusIsoTrkCutflow
 //-------------------------------------------
 
-bool passSingleLeptonSelection(bool isData) 
-{
-  //single lepton selection for 8 TeV 53 analysis
-
-  //at least one lepton
-  if ( stopt.ngoodlep() < 1 ) return false;
-
-  //lepton flavor - trigger, pt and eta requirements
-  if ( stopt.leptype() == 0 && stopt.lep1().Pt() < 30 )          return false;
-  if ( stopt.leptype() == 1 && stopt.lep1().Pt() < 25 )          return false;
+namespace {
+
+  // single lepton
+  bool cutNGoodLep1(bool)  { return stopt.ngoodlep() >= 1; }
+  bool cutLep1Pt(bool)     { return !( stopt.leptype() == 0 && stopt.lep1().Pt() < 30 )
+                                 && !( stopt.leptype() == 1 && stopt.lep1().Pt() < 25 ); }
+  bool cutLep1PFMatch(bool){ return !( fabs( stopt.pflep1().Pt() - stopt.lep1().Pt() ) > 10. ); }
+  bool cutLep1Iso(bool)    { return !( ( stopt.isopf1() * stopt.lep1().Pt() ) > 5. ); }
+  bool cutLep1Trigger(bool isData) {
+    //single electron / single muon trigger if data
+    if ( stopt.leptype() == 0 ) return !( isData && stopt.ele27wp80() != 1 );
+    if ( stopt.leptype() == 1 ) return !( isData && stopt.isomu24() != 1 );
+    return true;
+  }
+  bool cutLep1Eta(bool) {
+    //barrel only electrons
+    if ( stopt.leptype() == 0 ) return !( fabs(stopt.lep1().Eta() ) > 1.4442 );
+    if ( stopt.leptype() == 1 ) return !( fabs(stopt.lep1().Eta() ) > 2.1 );
+    return true;
+  }
+  bool cutLep1EOverP(bool) { return !( stopt.leptype() == 0 && stopt.eoverpin() > 4. ); }
+
+  // dilepton OS
+  bool cutNGoodLep2(bool)  { return stopt.ngoodlep() == 2; }
+  bool cutOS(bool)         { return !( stopt.id1()*stopt.id2()>0 ); }
+  bool cutDilTrigger(bool isData) { return !( isData && stopt.mm() != 1 && stopt.me() != 1
+                                              && stopt.em() != 1 && stopt.ee() != 1 ); }
+  bool cutDilPt(bool)      { return !( stopt.lep1().Pt() < 20 ) && !( stopt.lep2().Pt() < 20 ); }
+  bool cutDilEta(bool)     { return !( fabs(stopt.lep1().Eta() ) > 2.4) && !( fabs(stopt.lep2().Eta() ) > 2.4); }
+  bool cutDilPFMatch(bool) { return !( fabs( stopt.pflep1().Pt() - stopt.lep1().Pt() ) > 10. )
+                                 && !( fabs( stopt.pflep2().Pt() - stopt.lep2().Pt() ) > 10. ); }
+  bool cutDilIso(bool)     { return !( ( stopt.isopf1() * stopt.lep1().Pt() ) > 5. )
+                                 && !( ( stopt.isopf2() * stopt.lep2().Pt() ) > 5. ); }
+  bool cutDilEOverP(bool)  { return !( fabs(stopt.id1())==11 && stopt.eoverpin() > 4. )
+                                 && !( fabs(stopt.id2())==11 && stopt.eoverpin2() > 4. ); }
+  bool cutDilBarrelEl(bool){ return !( fabs(stopt.id1())==11 && fabs(stopt.lep1().Eta() ) > 1.4442 )
+                                 && !( fabs(stopt.id2())==11 && fabs(stopt.lep2().Eta() ) > 1.4442 ); }
+  bool cutDilDR(bool)      { return !( stopt.ngoodlep() > 1 &&
+                                       dRbetweenVectors( stopt.lep1() ,  stopt.lep2() )<0.1 ); }
+
+  // isolated track
+  bool cutIsoTrk(bool)     { return !passIsoTrkVeto_v4(); }
+  bool cutLooseTrk5(bool)  { return !( stopt.pfcandpt5looseZ()  > 9990.); }
+  bool cutLooseTrk10(bool) { return !( stopt.pfcandptOS10looseZ()  > 9990.); }
+
+  // costs: roughly the number of branches read
+  Cutflow makeSingleLeptonCutflow() {
+    Cutflow cutflow("single lepton");
+    cutflow.add("ngoodlep >= 1",    cutNGoodLep1,   1., 0);
+    cutflow.add("lepton pt",        cutLep1Pt,      2., 1);
+    cutflow.add("pf lepton match",  cutLep1PFMatch, 2., 1);
+    cutflow.add("isolation",        cutLep1Iso,     2., 1);
+    cutflow.add("trigger",          cutLep1Trigger, 2., 1);
+    cutflow.add("lepton eta",       cutLep1Eta,     2., 1);
+    cutflow.add("electron E/p",     cutLep1EOverP,  2., 1);
+    return cutflow;
+  }
 
-  if ( fabs( stopt.pflep1().Pt() - stopt.lep1().Pt() ) > 10. )  return false;
-  if ( ( stopt.isopf1() * stopt.lep1().Pt() ) > 5. )  return false; 
+  Cutflow makeDileptonCutflow() {
+    Cutflow cutflow("dilepton OS");
+    cutflow.add("ngoodlep == 2",    cutNGoodLep2,   1., 0);
+    cutflow.add("opposite sign",    cutOS,          2., 1);
+    cutflow.add("trigger",          cutDilTrigger,  4., 1);
+    cutflow.add("lepton pt",        cutDilPt,       2., 1);
+    cutflow.add("lepton eta",       cutDilEta,      2., 1);
+    cutflow.add("pf lepton match",  cutDilPFMatch,  4., 1);
+    cutflow.add("isolation",        cutDilIso,      4., 1);
+    cutflow.add("electron E/p",     cutDilEOverP,   4., 1);
+    cutflow.add("barrel electrons", cutDilBarrelEl, 4., 1);
+    cutflow.add("lepton dR",        cutDilDR,       3., 1);
+    return cutflow;
+  }
 
-  if ( stopt.leptype() == 0 ) {
+  Cutflow makeLepPlusIsoTrkCutflow() {
+    Cutflow cutflow("lepton + isolated track");
+    cutflow.add(makeSingleLeptonCutflow());
+    cutflow.add("isolated track",      cutIsoTrk,     6., 2);
+    cutflow.add("loose track pt > 5",  cutLooseTrk5,  1., 2);
+    cutflow.add("loose OS track pt > 10", cutLooseTrk10, 1., 2);
+    return cutflow;
+  }
 
-    //pass trigger if data - single electron
-    if ( isData && stopt.ele27wp80() != 1 ) return false;
-    //    if ( isData && stopt.trgel1() != 1 )  return false;
- 
-    //barrel only electrons
-    if ( fabs(stopt.lep1().Eta() ) > 1.4442) return false;
-    if ( stopt.eoverpin() > 4. ) return false;
- 
+}
 
-  } else if ( stopt.leptype() == 1 ) {
+Cutflow& singleLeptonCutflow() {
+  static Cutflow cutflow = makeSingleLeptonCutflow();
+  return cutflow;
+}
 
-    //pass trigger if data - single muon
-    if ( isData && stopt.isomu24() != 1 ) return false;
-    //    if ( isData && stopt.trgmu1() != 1 )  return false;
- 
-    if ( fabs(stopt.lep1().Eta() ) > 2.1)  return false;
+Cutflow& dileptonCutflow() {
+  static Cutflow cutflow = makeDileptonCutflow();
+  return cutflow;
+}
 
-  }
+Cutflow& lepPlusIsoTrkCutflow() {
+  static Cutflow cutflow = makeLepPlusIsoTrkCutflow();
+  return cutflow;
+}
 
-  return true;
+//-------------------------------------------
+// >=1 selected lepton and trigger
+//-------------------------------------------
 
+bool passSingleLeptonSelection(bool isData) 
+{
+  //single lepton selection for 8 TeV 53 analysis
+  return singleLeptonCutflow().test(isData);
 }
 
 //-------------------------------------------
@@ -842,45 +913,7 @@ bool passSingleLeptonSelection(bool isData)
 bool passDileptonSelection(bool isData) 
 {
   //two lepton selection for 8 TeV 53 analysis
-
-  //exactly 2 leptons
-  if ( stopt.ngoodlep() != 2 ) return false;
-
-  //opposite sign
-  if ( stopt.id1()*stopt.id2()>0 ) return false;
-
-  //pass trigger if data - dilepton
-  if ( isData && stopt.mm() != 1 && stopt.me() != 1 
-       && stopt.em() != 1 && stopt.ee() != 1 ) return false;
-
-  //passes pt and eta requirements
-  if ( stopt.lep1().Pt() < 20 )          return false;
-  if ( stopt.lep2().Pt() < 20 )          return false;
-  if ( fabs(stopt.lep1().Eta() ) > 2.4)  return false;
-  if ( fabs(stopt.lep2().Eta() ) > 2.4)  return false;
-
-  //consistency with pf leptons
-  if ( fabs( stopt.pflep1().Pt() - stopt.lep1().Pt() ) > 10. )  return false;
-  if ( fabs( stopt.pflep2().Pt() - stopt.lep2().Pt() ) > 10. )  return false;
-
-  //requirement for leading lepton
-  if ( ( stopt.isopf1() * stopt.lep1().Pt() ) > 5. )  return false; 
-  if ( fabs(stopt.id1())==11 && stopt.eoverpin() > 4. ) return false;
-
-  //requirement for trailing lepton
-  if ( ( stopt.isopf2() * stopt.lep2().Pt() ) > 5. )  return false; 
-  if ( fabs(stopt.id2())==11 && stopt.eoverpin2() > 4. ) return false;
-
-  //barrel only electrons
-  if (fabs(stopt.id1())==11 && fabs(stopt.lep1().Eta() ) > 1.4442) return false;
-  if (fabs(stopt.id2())==11 && fabs(stopt.lep2().Eta() ) > 1.4442) return false;
-
-  //if have more than 1 lepton, remove cases where have 2 close together
-  if ( stopt.ngoodlep() > 1 && 
-       dRbetweenVectors( stopt.lep1() ,  stopt.lep2() )<0.1 ) return false;
-
-  return true;
-
+  return dileptonCutflow().test(isData);
 }
 
 //-------------------------------------------
@@ -1043,19 +1076,7 @@ bool passLepPlusSSPionTrkSelection(bool isData)
 bool passLepPlusIsoTrkSelection(bool isData) 
 {
   //single lepton plus iso trk selection for 8 TeV 53 analysis
-
-  //at least one lepton
-  if ( !passSingleLeptonSelection(isData) ) return false;
-
-  //pass isolated track requirement
-  //unfortunately changed default value to 9999.
-  //  if ( pfcandpt10() > 9990. || pfcandiso10() > 0.1 ) return false;
-  if ( passIsoTrkVeto_v4() ) return false;
-  if ( stopt.pfcandpt5looseZ()  > 9990.) return false;
-  if ( stopt.pfcandptOS10looseZ()  > 9990.) return false;
-
-  return true;
-
+  return lepPlusIsoTrkCutflow().test(isData);
 }
 
 //-------------------------------------------
@@ -1512,10 +1533,28 @@ double calculateMT2w(vector<LorentzVector>& jets, vector<float>& btag, LorentzVe
 	// require at least 2 jets
 	if ( jets.size()<2 ) return 99999.; 
 
+	vector< pair<int, int> > combinations;
+	getMT2wCombinations(btag, combinations);
+
+	float min_mt2w = 9999;
+	for (unsigned int c = 0; c < combinations.size(); c++){
+	  float c_mt2w = mt2wWrapper(lep, 
+				     jets[combinations[c].first],
+				     jets[combinations[c].second], met, metphi, mt2type);
+	  if (c_mt2w < min_mt2w)
+	    min_mt2w = c_mt2w;
+	}
+	return min_mt2w;
+}
+
+void getMT2wCombinations(const vector<float>& btag, vector< pair<int, int> >& combinations){
+
+	combinations.clear();
+
 	// First we count the number of b-tagged jets, and separate those non b-tagged
 	std::vector<int> bjets;
 	std::vector<int> non_bjets;
-	for( unsigned int i = 0 ; i < jets.size() ; i++ ){
+	for( unsigned int i = 0 ; i < btag.size() ; i++ ){
 	  if( btag.at(i) > BTAG_MED ) {
 	    bjets.push_back(i);
 	  } else {
@@ -1524,62 +1563,37 @@ double calculateMT2w(vector<LorentzVector>& jets, vector<float>& btag, LorentzVe
 	}	
 
 	int n_btag = (int) bjets.size();
-	//	cout << "n_btag = " << n_btag << endl;
 
 	// We do different things depending on the number of b-tagged jets
 	// arXiv:1203.4813 recipe
 
 	int nMax=-1;
-	if(jets.size()<=3) nMax=non_bjets.size();
+	if(btag.size()<=3) nMax=non_bjets.size();
 	else nMax=3;
 
 	if (n_btag == 0){
 	  // If no b-jets select the minimum of the mt2w from all combinations with 
 	  // the three leading jets
-	  float min_mt2w = 9999;
-
 	  for (int i=0; i<nMax; i++)
 	    for (int j=0; j<nMax; j++){
 	      if (i == j) continue;
-	      float c_mt2w = mt2wWrapper(lep, 
-					 jets[non_bjets[i]],
-					 jets[non_bjets[j]], met, metphi, mt2type);
-	      if (c_mt2w < min_mt2w)
-		min_mt2w = c_mt2w;
+	      combinations.push_back(make_pair(non_bjets[i], non_bjets[j]));
 	    }
-	  return min_mt2w;
 	} else if (n_btag == 1 ){
 	  // if only one b-jet choose the three non-b leading jets and choose the smaller
-	  float min_mt2w = 9999;
-
-	  for (int i=0; i<nMax; i++){
-	    float c_mt2w = mt2wWrapper(lep, jets[bjets[0]], jets[non_bjets[i]], met, metphi, mt2type);
-	    if (c_mt2w < min_mt2w)
-	      min_mt2w = c_mt2w;
-	  }
-	  for (int i=0; i<nMax; i++){
-	    float c_mt2w = mt2wWrapper(lep, jets[non_bjets[i]], jets[bjets[0]], met, metphi, mt2type);
-	    if (c_mt2w < min_mt2w)
-	      min_mt2w = c_mt2w;
-	  }
-	  return min_mt2w;
+	  for (int i=0; i<nMax; i++)
+	    combinations.push_back(make_pair(bjets[0], non_bjets[i]));
+	  for (int i=0; i<nMax; i++)
+	    combinations.push_back(make_pair(non_bjets[i], bjets[0]));
 	} else if (n_btag >= 2) {
 	  // if 3 or more b-jets the paper says ignore b-tag and do like 0-bjets 
 	  // but we are going to make the combinations with the b-jets
-	  float min_mt2w = 9999;
 	  for (int i=0; i<n_btag; i++)
 	    for (int j=0; j<n_btag; j++){
 	      if (i == j) continue;
-	      float c_mt2w = mt2wWrapper(lep, 
-					 jets[bjets[i]],
-					 jets[bjets[j]], met, metphi, mt2type);
-	      if (c_mt2w < min_mt2w)
-		min_mt2w = c_mt2w;
+	      combinations.push_back(make_pair(bjets[i], bjets[j]));
 	    }
-	  return min_mt2w;
 	}
-
-	return -1.;
 }
 
 
@@ -1796,14 +1810,23 @@ double calculateChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets,
   assert(jets.size() == sigma_jets.size());
   assert(jets.size() == btag.size());
 
+  vector<Chi2WFit> wfits;
+  fitChi2SNTWPairs(jets, sigma_jets, wfits);
+  return chi2SNTFromWFits(jets, sigma_jets, btag, wfits);
+}
+
+// W mass constrained fits of all pairs among the 6 leading jets.
+// Independent of the b-tagging, so can be shared between b-tag variations.
+void fitChi2SNTWPairs(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<Chi2WFit>& wfits){
+
+  wfits.clear();
+
   //check at most first 6 jets
   int n_jets = jets.size();
   if (n_jets>6) n_jets = 6;
   //consider at least 3 jets
-  if (n_jets<3) return 999999.;
+  if (n_jets<3) return;
   
-  vector<int> v_i, v_j;
-  vector<double> v_k1, v_k2;
   for ( int i=0; i<n_jets; ++i )
     for ( int j=i+1; j<n_jets; ++j ){
 
@@ -1853,12 +1876,24 @@ double calculateChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets,
       // cout << "c1 = " <<  c1 << "  c1 = " << c2 << "   M_jj = "
       // 	   << ((jets[i] * c1) + (jets[j] * c2)).mass() << endl;
 
-      v_i.push_back(i);
-      v_j.push_back(j);
-      v_k1.push_back(c1);
-      v_k2.push_back(c2);
+      Chi2WFit wfit;
+      wfit.i = i;
+      wfit.j = j;
+      wfit.c1 = c1;
+      wfit.c2 = c2;
+      wfits.push_back(wfit);
     }
-  
+}
+
+// b-jet assignment given the W pair fits from fitChi2SNTWPairs
+double chi2SNTFromWFits(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<float>& btag, const vector<Chi2WFit>& wfits){
+
+  //check at most first 6 jets
+  int n_jets = jets.size();
+  if (n_jets>6) n_jets = 6;
+  //consider at least 3 jets
+  if (n_jets<3) return 999999.;
+
   //Apply b-consistency requirement
   int n_btag = 0;
   for( int i = 0 ; i < n_jets ; i++ )
@@ -1876,9 +1911,9 @@ double calculateChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets,
     if( n_btag>1 && btag.at(b) < BTAG_MED ) continue;
     double pt_b = jets[b].Pt();
       
-    for (unsigned int w = 0; w < v_i.size() ; ++w ) {
-      int i = v_i[w];
-      int j = v_j[w];
+    for (unsigned int w = 0; w < wfits.size() ; ++w ) {
+      int i = wfits[w].i;
+      int j = wfits[w].j;
       if ( i==b || j==b ) continue;
       //count number of b-tagged Ws
       int nwb = 0;
@@ -1899,8 +1934,8 @@ double calculateChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets,
       LorentzVector hadW = jets[i] + jets[j];
       double massW = hadW.mass();
       
-      double c1 = v_k1[w];
-      double c2 = v_k2[w];
+      double c1 = wfits[w].c1;
+      double c2 = wfits[w].c2;
       
       ///
       // Top Mass.
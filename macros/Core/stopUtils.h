@@ -83,6 +83,15 @@ bool pass_T2tt_LM(bool isData, TString name);
 bool pass_T2tt_HM(bool isData, TString name);
 bool pass_T2bw_HM(bool isData, TString name);
 
+#ifndef __CINT__
+#include "../Core/Cutflow.h"
+// the selections above as named steps: pass(isData, weight) also fills
+// their cutflow table, see Cutflow.h
+Cutflow& singleLeptonCutflow();
+Cutflow& dileptonCutflow();
+Cutflow& lepPlusIsoTrkCutflow();
+#endif
+
 pair<float,float> getPhiCorrMET( float met, float metphi, int nvtx, bool ismc);
 
 float getDataMCRatio(float eta);
@@ -107,9 +116,13 @@ bool is_badLaserEvent (const DorkyEventIdentifier &id, std::set<DorkyEventIdenti
 
 enum MT2Type { MT2b, MT2bl, MT2w };
 double calculateMT2w(vector<LorentzVector>& jets, vector<float>& btag, LorentzVector& lep, float met, float metphi, MT2Type mt2type = MT2w);
+void getMT2wCombinations(const vector<float>& btag, vector< pair<int, int> >& combinations);
 double mt2wWrapper(LorentzVector& lep, LorentzVector& jet_o, LorentzVector& jet_b, float met, float metphi, MT2Type mt2type = MT2w);
 double calculateChi2(vector<LorentzVector>& jets, vector<float>& sigma_jets);
 double calculateChi2SNT(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<float>& btag);
+struct Chi2WFit { int i, j; double c1, c2; };
+void fitChi2SNTWPairs(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<Chi2WFit>& wfits);
+double chi2SNTFromWFits(vector<LorentzVector>& jets, vector<float>& sigma_jets, vector<float>& btag, const vector<Chi2WFit>& wfits);
 double fc2 (double c1, double m12, double m22, double m02, bool verbose);
 double fchi2 (double c1, double pt1, double sigma1, double pt2, double sigma2, double m12, double m22, double m02);
 void minuitFunction(int&, double* , double &result, double par[], int);
@@ -0,0 +1,229 @@
+//
+// Parity check of the Cutflow selections of Core/stopUtils
+// (singleLeptonCutflow, dileptonCutflow, lepPlusIsoTrkCutflow) against the
+// hand-written chains they replaced (oldSelections.h), on the events of a
+// fixture read through stopt.
+//
+//   cutflowCheck [events] [-adapt n]
+//
+// For every event, test() and pass() of each Cutflow, in the order of
+// declaration and with setAdaptive(n) (default 100), must give the old
+// decision.  At the end the events and weighted yields after each step must
+// be the ones the old chain let through at the same point: every step in
+// the order of declaration, and the last step of each block with the
+// adaptive order.  Exits nonzero on any difference.
+//
+
+#include "../Core/STOPT.h"
+#include "../Core/stopUtils.h"
+
+#include "TTree.h"
+
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
+
+// steps the old chain got through for the current event
+static unsigned int oldReached;
+static void reached(int step) { oldReached |= 1u << step; }
+
+#include "oldSelections.h"
+
+//--------------------------------------------------------------------
+// fixture: one event per line, see makeEvents.py for the columns
+
+static int ngoodlep_, leptype_, id1_, id2_, ele27wp80_, isomu24_, mm_, me_, em_, ee_, pfcandid5looseZ_;
+static float isopf1_, isopf2_, eoverpin_, eoverpin2_;
+static float pfcandpt5looseZ_, pfcandptOS10looseZ_, pfcandiso5looseZ_, pfcandisoOS10looseZ_;
+static LorentzVector *lep1_ = new LorentzVector, *lep2_ = new LorentzVector;
+static LorentzVector *pflep1_ = new LorentzVector, *pflep2_ = new LorentzVector;
+
+static TTree* readEvents(const char* filename, vector<bool>& isData, vector<double>& weights) {
+  FILE* f = fopen(filename, "r");
+  if (!f) {
+    cout << "[cutflowCheck] cannot open " << filename << endl;
+    return 0;
+  }
+
+  // branches as the baby makers write them
+  TTree* tree = new TTree("t", "cutflowCheck events");
+  tree->SetDirectory(0);
+  tree->Branch("ngoodlep",            &ngoodlep_,            "ngoodlep/I");
+  tree->Branch("leptype",             &leptype_,             "leptype/I");
+  tree->Branch("id1",                 &id1_,                 "id1/I");
+  tree->Branch("id2",                 &id2_,                 "id2/I");
+  tree->Branch("lep1"    , "ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> >", &lep1_  );
+  tree->Branch("lep2"    , "ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> >", &lep2_  );
+  tree->Branch("pflep1"  , "ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> >", &pflep1_);
+  tree->Branch("pflep2"  , "ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> >", &pflep2_);
+  tree->Branch("isopf1",              &isopf1_,              "isopf1/F");
+  tree->Branch("isopf2",              &isopf2_,              "isopf2/F");
+  tree->Branch("eoverpin",            &eoverpin_,            "eoverpin/F");
+  tree->Branch("eoverpin2",           &eoverpin2_,           "eoverpin2/F");
+  tree->Branch("ele27wp80",           &ele27wp80_,           "ele27wp80/I");
+  tree->Branch("isomu24",             &isomu24_,             "isomu24/I");
+  tree->Branch("mm",                  &mm_,                  "mm/I");
+  tree->Branch("me",                  &me_,                  "me/I");
+  tree->Branch("em",                  &em_,                  "em/I");
+  tree->Branch("ee",                  &ee_,                  "ee/I");
+  tree->Branch("pfcandpt5looseZ",     &pfcandpt5looseZ_,     "pfcandpt5looseZ/F");
+  tree->Branch("pfcandptOS10looseZ",  &pfcandptOS10looseZ_,  "pfcandptOS10looseZ/F");
+  tree->Branch("pfcandid5looseZ",     &pfcandid5looseZ_,     "pfcandid5looseZ/I");
+  tree->Branch("pfcandiso5looseZ",    &pfcandiso5looseZ_,    "pfcandiso5looseZ/F");
+  tree->Branch("pfcandisoOS10looseZ", &pfcandisoOS10looseZ_, "pfcandisoOS10looseZ/F");
+
+  LorentzVector* p4s[4] = { lep1_, lep2_, pflep1_, pflep2_ };
+  char line[4096];
+  while (fgets(line, sizeof(line), f)) {
+    if (line[0] == '#' || strspn(line, " \t\n") == strlen(line)) continue;
+    istringstream in(line);
+    int data;
+    double weight;
+    in >> data >> weight >> ngoodlep_ >> leptype_ >> id1_ >> id2_;
+    for (int i = 0; i < 4; ++i) {
+      float px, py, pz, e;
+      in >> px >> py >> pz >> e;
+      p4s[i]->SetPxPyPzE(px, py, pz, e);
+    }
+    in >> isopf1_ >> isopf2_ >> eoverpin_ >> eoverpin2_ >> ele27wp80_ >> isomu24_ >> mm_ >> me_ >> em_ >> ee_
+       >> pfcandpt5looseZ_ >> pfcandptOS10looseZ_ >> pfcandid5looseZ_ >> pfcandiso5looseZ_ >> pfcandisoOS10looseZ_;
+    if (in.fail()) {
+      cout << "[cutflowCheck] bad event " << isData.size() << " in " << filename << endl;
+      fclose(f);
+      delete tree;
+      return 0;
+    }
+    isData.push_back(data != 0);
+    weights.push_back(weight);
+    tree->Fill();
+  }
+  fclose(f);
+
+  cout << "[cutflowCheck] " << tree->GetEntries() << " events from " << filename << endl;
+  return tree;
+}
+
+//--------------------------------------------------------------------
+
+struct Selection {
+  Selection(bool (*o)(bool), const Cutflow& c, unsigned int adaptEvery)
+    : old(o), declared(c), adaptive(c), nOld(c.nSteps(), 0), sumwOld(c.nSteps(), 0.), marked(0) {
+    adaptive.setAdaptive(adaptEvery);
+  }
+
+  bool (*old)(bool isData);
+  Cutflow declared, adaptive;
+  // what the old chain let through after each step that has a marker
+  vector<unsigned long long> nOld;
+  vector<double> sumwOld;
+  unsigned int marked;
+};
+
+static bool sameCounts(const Selection& s, const Cutflow& c, int i, int step) {
+  if (c.nPassed(i) == s.nOld[step] && c.sumwPassed(i) == s.sumwOld[step]) return true;
+  printf("[cutflowCheck] %s%s: after \"%s\" %llu events, %.6f weighted; the old chain %llu, %.6f\n",
+         c.name().c_str(), (&c == &s.adaptive) ? " (adaptive)" : "", c.stepName(i).c_str(),
+         c.nPassed(i), c.sumwPassed(i), s.nOld[step], s.sumwOld[step]);
+  return false;
+}
+
+//--------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  const char* eventfile = "fixtures/events.txt";
+  unsigned int adaptEvery = 100;
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    if (!strcmp(argv[iarg], "-adapt") && iarg + 1 < argc) adaptEvery = atoi(argv[++iarg]);
+    else if (argv[iarg][0] != '-') eventfile = argv[iarg];
+    else {
+      cout << "usage: cutflowCheck [events] [-adapt n]" << endl;
+      return 1;
+    }
+  }
+
+  vector<bool> isData;
+  vector<double> weights;
+  TTree* tree = readEvents(eventfile, isData, weights);
+  if (!tree || isData.empty()) return 1;
+  stopt.Init(tree);
+
+  vector<Selection> selections;
+  selections.push_back(Selection(oldPassSingleLeptonSelection, singleLeptonCutflow(), adaptEvery));
+  selections.push_back(Selection(oldPassDileptonSelection, dileptonCutflow(), adaptEvery));
+  selections.push_back(Selection(oldPassLepPlusIsoTrkSelection, lepPlusIsoTrkCutflow(), adaptEvery));
+
+  int ndiff = 0;
+  for (unsigned int ievt = 0; ievt < isData.size(); ++ievt) {
+    stopt.GetEntry(ievt);
+    bool data = isData[ievt];
+    double weight = weights[ievt];
+
+    for (unsigned int is = 0; is < selections.size(); ++is) {
+      Selection& s = selections[is];
+      oldReached = 0;
+      bool old = s.old(data);
+      for (int step = 0; step < s.declared.nSteps(); ++step) {
+        if (!(oldReached & (1u << step))) continue;
+        ++s.nOld[step];
+        s.sumwOld[step] += weight;
+      }
+      s.marked |= oldReached;
+
+      bool decisions[4] = { s.declared.test(data), s.declared.pass(data, weight),
+                            s.adaptive.test(data), s.adaptive.pass(data, weight) };
+      for (int i = 0; i < 4; ++i) {
+        if (decisions[i] == old) continue;
+        if (ndiff < 10)
+          printf("[cutflowCheck] event %u: %s %s%s gives %d, the old chain %d\n", ievt, s.declared.name().c_str(),
+                 (i % 2) ? "pass()" : "test()", (i < 2) ? "" : " (adaptive)", decisions[i], old);
+        ++ndiff;
+      }
+    }
+  }
+
+  bool ok = ndiff == 0;
+  for (unsigned int is = 0; is < selections.size(); ++is) {
+    const Selection& s = selections[is];
+    s.declared.print();
+    s.adaptive.print();
+
+    // every step in the order of declaration that has a marker, which the
+    // last step of each block must have
+    for (int i = 0; i < s.declared.nSteps(); ++i) {
+      bool blockEnd = (i + 1 == s.declared.nSteps()) || (s.declared.stepBlock(i + 1) != s.declared.stepBlock(i));
+      if (!(s.marked & (1u << i))) {
+        if (!blockEnd) continue;
+        printf("[cutflowCheck] %s: the old chain never got through \"%s\"\n", s.declared.name().c_str(),
+               s.declared.stepName(i).c_str());
+        ok = false;
+        continue;
+      }
+      ok = sameCounts(s, s.declared, i, i) && ok;
+    }
+
+    // with the adaptive order only the block totals are comparable
+    for (int i = 0; i < s.adaptive.nSteps(); ++i) {
+      if (i + 1 < s.adaptive.nSteps() && s.adaptive.stepBlock(i + 1) == s.adaptive.stepBlock(i)) continue;
+      int step = 0;
+      while (step + 1 < s.declared.nSteps() && s.declared.stepBlock(step + 1) <= s.adaptive.stepBlock(i)) ++step;
+      ok = sameCounts(s, s.adaptive, i, step) && ok;
+    }
+    if (s.adaptive.nReorders() == 0) {
+      printf("[cutflowCheck] %s: the adaptive order never changed, try a smaller -adapt\n", s.adaptive.name().c_str());
+      ok = false;
+    }
+  }
+
+  if (ndiff) cout << "[cutflowCheck] " << ndiff << " decisions differ" << endl;
+  cout << "[cutflowCheck] " << (ok ? "same decisions, counts and yields as the old chains" : "FAILED") << endl;
+  return ok ? 0 : 1;
+}
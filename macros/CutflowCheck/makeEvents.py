@@ -0,0 +1,67 @@
+#!/bin/env python
+#
+# Events for cutflowCheck: the branches the lepton selections of
+# Core/stopUtils.cc read, with every cut value on either side of its
+# threshold.
+#
+#   python3 makeEvents.py 2000 1 fixtures/events.txt
+#
+
+import math
+import random
+import sys
+
+COLUMNS = ('isData weight ngoodlep leptype id1 id2 '
+           'lep1(px py pz E) lep2(px py pz E) pflep1(px py pz E) pflep2(px py pz E) '
+           'isopf1 isopf2 eoverpin eoverpin2 ele27wp80 isomu24 mm me em ee '
+           'pfcandpt5looseZ pfcandptOS10looseZ pfcandid5looseZ pfcandiso5looseZ pfcandisoOS10looseZ')
+
+
+def p4(pt, eta, phi):
+    p = pt * math.cosh(eta)
+    return [pt * math.cos(phi), pt * math.sin(phi), pt * math.sinh(eta), p]
+
+
+def generate(n, seed):
+    rng = random.Random(seed)
+    events = []
+    for ev in range(n):
+        isData = int(rng.random() < 0.3)
+        weight = 1. if isData else rng.uniform(0.1, 3.)
+        ngoodlep = rng.choice([0, 1, 1, 1, 2, 2, 2, 3])
+        leptype = rng.choice([0, 0, 1, 1, 2])
+        flavour = [11, 13][leptype] if leptype < 2 and rng.random() < 0.9 else rng.choice([11, 13])
+        id1 = rng.choice([-1, 1]) * flavour
+        id2 = rng.choice([-1, 1]) * rng.choice([11, 13])
+
+        leps, pfleps, isos = [], [], []
+        for i in range(2):
+            pt = rng.choice([10., 19.99, 20.01, 24.99, 25.01, 29.99, 30.01, 45., 80.])
+            eta = rng.choice([1, -1]) * rng.choice([0.3, 0.9, 1.44, 1.45, 2.09, 2.11, 2.39, 2.41])
+            phi = rng.uniform(-math.pi, math.pi)
+            if i == 1 and rng.random() < 0.1:
+                # close to the first lepton, for the dR cut
+                pt, eta, phi = pt, leps[0][1] + 0.03, leps[0][2] + 0.04
+            leps.append((pt, eta, phi))
+            pfleps.append((max(pt + rng.choice([0., 3., -9.9, 10.1, -12.]), 1.), eta, phi))
+            isos.append(rng.choice([0.01, 4.9 / pt, 5.1 / pt, 0.3]))
+
+        fields = [isData, '%.6f' % weight, ngoodlep, leptype, id1, id2]
+        for pt, eta, phi in leps + pfleps:
+            fields += ['%.9g' % x for x in p4(pt, eta, phi)]
+        fields += ['%.9g' % x for x in isos]
+        fields += [rng.choice([1., 3.99, 4.01, 6.]) for i in range(2)]
+        fields += [int(rng.random() < 0.7), int(rng.random() < 0.7)]
+        fields += [int(rng.random() < 0.35) for i in range(4)]
+        fields += [rng.choice([9999., 7., 15.]), rng.choice([9999., 12., 30.]),
+                   rng.choice([11, -13, 211, 0]), rng.choice([0.1, 0.3]), rng.choice([0.05, 0.2])]
+        events.append(' '.join(str(f) for f in fields))
+    return events
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 4:
+        sys.exit('usage: makeEvents.py <n> <seed> <events>')
+    out = open(sys.argv[3], 'w')
+    out.write('# %s\n' % COLUMNS)
+    out.write(''.join(e + '\n' for e in generate(int(sys.argv[1]), int(sys.argv[2]))))
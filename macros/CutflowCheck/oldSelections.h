@@ -0,0 +1,134 @@
+#ifndef OLDSELECTIONS_H
+#define OLDSELECTIONS_H
+
+// passSingleLeptonSelection, passDileptonSelection and
+//  passLepPlusIsoTrkSelection of Core/stopUtils.cc before they became
+//  Cutflows, for cutflowCheck.cc.  Copied as they were, except for the old
+//  prefix and the reached(k) after the cuts that make up step k of the
+//  Cutflow.  The dilepton isolation and E/p cuts alternate between the two
+//  leptons, so only the count after both (step 7) has a marker.
+
+bool oldPassSingleLeptonSelection(bool isData)
+{
+  //single lepton selection for 8 TeV 53 analysis
+
+  //at least one lepton
+  if ( stopt.ngoodlep() < 1 ) return false;
+  reached(0);
+
+  //lepton flavor - trigger, pt and eta requirements
+  if ( stopt.leptype() == 0 && stopt.lep1().Pt() < 30 )          return false;
+  if ( stopt.leptype() == 1 && stopt.lep1().Pt() < 25 )          return false;
+  reached(1);
+
+  if ( fabs( stopt.pflep1().Pt() - stopt.lep1().Pt() ) > 10. )  return false;
+  reached(2);
+  if ( ( stopt.isopf1() * stopt.lep1().Pt() ) > 5. )  return false;
+  reached(3);
+
+  if ( stopt.leptype() == 0 ) {
+
+    //pass trigger if data - single electron
+    if ( isData && stopt.ele27wp80() != 1 ) return false;
+    //    if ( isData && stopt.trgel1() != 1 )  return false;
+    reached(4);
+
+    //barrel only electrons
+    if ( fabs(stopt.lep1().Eta() ) > 1.4442) return false;
+    reached(5);
+    if ( stopt.eoverpin() > 4. ) return false;
+
+
+  } else if ( stopt.leptype() == 1 ) {
+
+    //pass trigger if data - single muon
+    if ( isData && stopt.isomu24() != 1 ) return false;
+    //    if ( isData && stopt.trgmu1() != 1 )  return false;
+    reached(4);
+
+    if ( fabs(stopt.lep1().Eta() ) > 2.1)  return false;
+
+  }
+  reached(4);
+  reached(5);
+  reached(6);
+
+  return true;
+
+}
+
+bool oldPassDileptonSelection(bool isData)
+{
+  //two lepton selection for 8 TeV 53 analysis
+
+  //exactly 2 leptons
+  if ( stopt.ngoodlep() != 2 ) return false;
+  reached(0);
+
+  //opposite sign
+  if ( stopt.id1()*stopt.id2()>0 ) return false;
+  reached(1);
+
+  //pass trigger if data - dilepton
+  if ( isData && stopt.mm() != 1 && stopt.me() != 1
+       && stopt.em() != 1 && stopt.ee() != 1 ) return false;
+  reached(2);
+
+  //passes pt and eta requirements
+  if ( stopt.lep1().Pt() < 20 )          return false;
+  if ( stopt.lep2().Pt() < 20 )          return false;
+  reached(3);
+  if ( fabs(stopt.lep1().Eta() ) > 2.4)  return false;
+  if ( fabs(stopt.lep2().Eta() ) > 2.4)  return false;
+  reached(4);
+
+  //consistency with pf leptons
+  if ( fabs( stopt.pflep1().Pt() - stopt.lep1().Pt() ) > 10. )  return false;
+  if ( fabs( stopt.pflep2().Pt() - stopt.lep2().Pt() ) > 10. )  return false;
+  reached(5);
+
+  //requirement for leading lepton
+  if ( ( stopt.isopf1() * stopt.lep1().Pt() ) > 5. )  return false;
+  if ( fabs(stopt.id1())==11 && stopt.eoverpin() > 4. ) return false;
+
+  //requirement for trailing lepton
+  if ( ( stopt.isopf2() * stopt.lep2().Pt() ) > 5. )  return false;
+  if ( fabs(stopt.id2())==11 && stopt.eoverpin2() > 4. ) return false;
+  reached(7);
+
+  //barrel only electrons
+  if (fabs(stopt.id1())==11 && fabs(stopt.lep1().Eta() ) > 1.4442) return false;
+  if (fabs(stopt.id2())==11 && fabs(stopt.lep2().Eta() ) > 1.4442) return false;
+  reached(8);
+
+  //if have more than 1 lepton, remove cases where have 2 close together
+  if ( stopt.ngoodlep() > 1 &&
+       dRbetweenVectors( stopt.lep1() ,  stopt.lep2() )<0.1 ) return false;
+  reached(9);
+
+  return true;
+
+}
+
+bool oldPassLepPlusIsoTrkSelection(bool isData)
+{
+  //single lepton plus iso trk selection for 8 TeV 53 analysis
+
+  //at least one lepton
+  if ( !oldPassSingleLeptonSelection(isData) ) return false;
+
+  //pass isolated track requirement
+  //unfortunately changed default value to 9999.
+  //  if ( pfcandpt10() > 9990. || pfcandiso10() > 0.1 ) return false;
+  if ( passIsoTrkVeto_v4() ) return false;
+  reached(7);
+  if ( stopt.pfcandpt5looseZ()  > 9990.) return false;
+  reached(8);
+  if ( stopt.pfcandptOS10looseZ()  > 9990.) return false;
+  reached(9);
+
+  return true;
+
+}
+
+#endif
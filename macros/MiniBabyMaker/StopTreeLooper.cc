@@ -6,8 +6,15 @@
 
 //#include "../Core/STOPT.h"
 #include "../Core/stopUtils.h"
+#include "../Core/VariationCache.h"
+#include "../Core/ScaleFactors.h"
+#include "../Core/BDTForest.h"
+#include "../Core/BinnedTable.h"
+#include "../Core/MassDB.h"
+#include "../Core/NormCache.h"
+#include "../Core/MassIndex.h"
 #include "../Plotting/PlotUtilities.h"
-#include "../../Tools/BTagReshaping/BTagReshaping.h"
+#include "../Core/BTagReshaper.h"
 
 #include "TROOT.h"
 #include "TH1F.h"
@@ -49,6 +56,7 @@ double Reweight_T2bW (double thetaChi_eff, double thetaW_eff, std::vector<SUSYGe
 StopTreeLooper::StopTreeLooper()
 {
     m_outfilename_ = "histos.root";
+    c1n2_xsec_ = 0;
     // t1metphicorr = -9999.;
     // t1metphicorrphi = -9999.;
     // t1metphicorrmt = -9999.;
@@ -76,6 +84,7 @@ StopTreeLooper::StopTreeLooper()
 
 StopTreeLooper::~StopTreeLooper()
 {
+    delete c1n2_xsec_;
 }
 
 void StopTreeLooper::setOutFileName(string filename)
@@ -159,27 +168,19 @@ void StopTreeLooper::loop(TChain *chain, TString name)
     // set csv discriminator reshaping
     //------------------------------------------------------------------------------------------------------
   
-    BTagShapeInterface * nominalShape = new BTagShapeInterface("../../Tools/BTagReshaping/csvdiscr.root",  0.0 ,  0.0);
-    //systematic variations for payloads
-    BTagShapeInterface * upBCShape    = new BTagShapeInterface("../../Tools/BTagReshaping/csvdiscr.root",  1.0 ,  0.0);
-    BTagShapeInterface * downBCShape  = new BTagShapeInterface("../../Tools/BTagReshaping/csvdiscr.root", -1.0 ,  0.0);
-    BTagShapeInterface * upLShape     = new BTagShapeInterface("../../Tools/BTagReshaping/csvdiscr.root",  0.0 ,  1.0);
-    BTagShapeInterface * downLShape   = new BTagShapeInterface("../../Tools/BTagReshaping/csvdiscr.root",  0.0 , -1.0);
+    // shapes of all the payload variations, shared and built once per process
+    BTagReshaper * reshaper = BTagReshaper::get("../../Tools/BTagReshaping/csvdiscr.root");
+    vector<float> csvShapes[BTagReshaper::NVARIATIONS];
 
     //------------------------------------------------
     // set c1n2 cross section file
     //------------------------------------------------
 
-    c1n2_xsec_file = TFile::Open("../../looper/c1n2_xsec.root");
+    // the per-event histogram lookups go through flat copies (BinnedTable)
+    delete c1n2_xsec_;
+    c1n2_xsec_ = new BinnedTable(BinnedTable::load("../../looper/c1n2_xsec.root", "h_c1n2_xsec"));
   
-    if( !c1n2_xsec_file->IsOpen() ){
-      cout << "Error, could not open c1n2 cross section TFile, quitting" << endl;
-      exit(0);
-    }
-  
-    c1n2_xsec_hist        = (TH1F*) c1n2_xsec_file->Get("h_c1n2_xsec");
-  
-    if( c1n2_xsec_hist == 0 ){
+    if( c1n2_xsec_->empty() ){
       cout << "Error, could not retrieve c1n2 cross section hist, quitting" << endl;
       exit(0);
     }
@@ -195,11 +196,28 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
     makeTree(name.Data(), chain);
 
-    TH1F *h_nsig_pmssm;
-    TH2F *h_nsig, *h_nsig25, *h_nsig75 ;
-    TH2F *h_nsig_masslessLSP;
+    BinnedTable nsig_pmssm;
+    BinnedTable nsig, nsig25, nsig75;
+    BinnedTable nsig_masslessLSP;
+
+    // generated events per mass point: from the tables the baby maker
+    // stores in the babies, from the myMassDB files for older babies
+    bool isScan = name.Contains("T2") || name.Contains("TChiWH") || name.Contains("pMSSM");
+    MassDB massdb;
+    if( isScan ){
+      // all babies of a scan carry the table or none do: a mix would
+      // normalize every point to the jobs of the newer babies only
+      int nfiles = chain->GetListOfFiles()->GetEntries();
+      int nfound = massdb.read(chain);
+      if( nfound > 0 && nfound != nfiles ){
+        cout << "[StopTreeLooper::loop] " << nfound << " of " << nfiles
+             << " files have a massdb table, need all or none, QUITTING!!!" << endl;
+        exit(1);
+      }
+    }
+    NormCache normCache(name.Data());
 
-    if( name.Contains("T2") || name.Contains("TChiWH") || name.Contains("pMSSM") ){
+    if( isScan && massdb.empty() ){
         char* h_nsig_filename             = "";
         char* h_nsig_filename_masslessLSP = "";
 
@@ -293,114 +311,72 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	  cout << "[StopTreeLooper::loop] opening nsig TH1 file  " << h_nsig_filename << endl;
 	}
 
-        TFile *f_nsig = TFile::Open(h_nsig_filename);
-
-        assert(f_nsig);
-
 	if( name.Contains("T2") || name.Contains("TChiWH") ){
-	  h_nsig = (TH2F*) f_nsig->Get("masses");
+	  nsig = BinnedTable::load(h_nsig_filename, "masses");
+	  assert(!nsig.empty());
 	}
 
         if( name.Contains("T2bw") ){
-            h_nsig25 = (TH2F*) f_nsig->Get("masses25");
-            h_nsig75 = (TH2F*) f_nsig->Get("masses75");
+            nsig25 = BinnedTable::load(h_nsig_filename, "masses25");
+            nsig75 = BinnedTable::load(h_nsig_filename, "masses75");
+            assert(!nsig25.empty());
+            assert(!nsig75.empty());
         }
 
         if( name.Contains("T2tt") ){
-	  TFile *f_nsig_masslessLSP = TFile::Open(h_nsig_filename_masslessLSP);
-	  h_nsig_masslessLSP = (TH2F*) f_nsig_masslessLSP->Get("masses");
+	  nsig_masslessLSP = BinnedTable::load(h_nsig_filename_masslessLSP, "masses");
+	  assert(!nsig_masslessLSP.empty());
 	}
 
 	if( name.Contains("pMSSM") ){
-	  h_nsig_pmssm = (TH1F*) f_nsig->Get("run");
+	  nsig_pmssm = BinnedTable::load(h_nsig_filename, "run");
+	  assert(!nsig_pmssm.empty());
 	}
 
     }
 
     // retrieve fastsim SF histos
-    TH2D *h_el_fastsimsf, *h_mu_fastsimsf ;
+    BinnedTable el_fastsimsf, mu_fastsimsf;
     if( isfastsim ){
-      TFile* f_el_fastsimsf = TFile::Open("/nfs-7/userdata/stop/fastsim/electron_FastSim_SS.root");
-      h_el_fastsimsf = (TH2D*) f_el_fastsimsf->Get("SF");
-      TFile* f_mu_fastsimsf = TFile::Open("/nfs-7/userdata/stop/fastsim/muon_FastSim_EWKino.root");
-      h_mu_fastsimsf = (TH2D*) f_mu_fastsimsf->Get("SF");
+      el_fastsimsf = BinnedTable::load("/nfs-7/userdata/stop/fastsim/electron_FastSim_SS.root", "SF");
+      mu_fastsimsf = BinnedTable::load("/nfs-7/userdata/stop/fastsim/muon_FastSim_EWKino.root", "SF");
+      assert(!el_fastsimsf.empty());
+      assert(!mu_fastsimsf.empty());
     }
 
     const int NREG_T2tt = 6;
     const int NREG_T2bw = 5;
     const int NREG_TChiWH = 3;
-    TMVA::Reader* reader_T2tt[NREG_T2tt];
-    TMVA::Reader* reader_T2bw[3][NREG_T2bw];
-    TMVA::Reader* reader_TChiWH[NREG_TChiWH];
-
-    TMVA::Reader* reader_T2tt_up[NREG_T2tt];
-    TMVA::Reader* reader_T2bw_up[3][NREG_T2bw];
-
-    TMVA::Reader* reader_T2tt_down[NREG_T2tt];
-    TMVA::Reader* reader_T2bw_down[3][NREG_T2bw];
 
-    TMVA::Reader* reader_T2tt_bup[NREG_T2tt];
-    TMVA::Reader* reader_T2bw_bup[3][NREG_T2bw];
-
-    TMVA::Reader* reader_T2tt_bdown[NREG_T2tt];
-    TMVA::Reader* reader_T2bw_bdown[3][NREG_T2bw];
+    // one BDT per region, all of them evaluated in one call per event on
+    // the inputs for the nominal and the JES and b-tagging variations (the
+    // nominal only for WH+MET)
+    enum { MVA_NOM, MVA_JESUP, MVA_JESDOWN, MVA_BUP, MVA_BDOWN, NMVAVERSIONS };
+    BDTBatch mva( DO_WHMET ? 1 : NMVAVERSIONS );
+    // compare every value with TMVA::Reader
+    mva.debug = false;
+    int bdt_T2tt[NREG_T2tt];
+    int bdt_T2bw[3][NREG_T2bw];
+    int bdt_TChiWH[NREG_TChiWH];
+
+    float* mva_met[NMVAVERSIONS]      = { &met_, &metup_, &metdown_, &met_, &met_ };
+    float* mva_mt2w[NMVAVERSIONS]     = { &mt2w_, &mt2wup_, &mt2wdown_, &mt2wbup_, &mt2wbdown_ };
+    float* mva_chi2[NMVAVERSIONS]     = { &chi2_, &chi2up_, &chi2down_, &chi2bup_, &chi2bdown_ };
+    float* mva_htratiom[NMVAVERSIONS] = { &htratiom_, &htratiomup_, &htratiomdown_, &htratiom_, &htratiom_ };
+    float* mva_pt_b[NMVAVERSIONS]     = { &pt_b_, &pt_b_up_, &pt_b_down_, &pt_b_bup_, &pt_b_bdown_ };
+    float* mva_dRleptB1[NMVAVERSIONS] = { &dRleptB1_, &dRleptB1_, &dRleptB1_, &dRleptB1_bup_, &dRleptB1_bdown_ };
 
     if ( __apply_mva && !DO_WHMET ) {
-        for (int i=1; i < NREG_T2tt ; i++){
-            reader_T2tt[i] = new TMVA::Reader( "!Color:!Silent" );
-            reader_T2tt[i]->AddVariable("mini_met", &met_);
-            reader_T2tt[i]->AddVariable("mini_mt2w", &mt2w_);
-            if ( i != 5 )
-                reader_T2tt[i]->AddVariable("mini_chi2", &chi2_);
-            reader_T2tt[i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiom_);
-            reader_T2tt[i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-            if ( i == 5 )
-                reader_T2tt[i]->AddVariable("mini_pt_b", &pt_b_);
-
-	    // JES up
-	    reader_T2tt_up[i] = new TMVA::Reader( "!Color:!Silent" );
-	    reader_T2tt_up[i]->AddVariable("mini_met", &metup_);
-	    reader_T2tt_up[i]->AddVariable("mini_mt2w", &mt2wup_);
-	    if ( i != 5 )
-	      reader_T2tt_up[i]->AddVariable("mini_chi2", &chi2up_);
-	    reader_T2tt_up[i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiomup_);
-	    reader_T2tt_up[i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-	    if ( i == 5 )
-	      reader_T2tt_up[i]->AddVariable("mini_pt_b", &pt_b_up_);
-
-	    // JES down
-            reader_T2tt_down[i] = new TMVA::Reader( "!Color:!Silent" );
-            reader_T2tt_down[i]->AddVariable("mini_met", &metdown_);
-            reader_T2tt_down[i]->AddVariable("mini_mt2w", &mt2wdown_);
-            if ( i != 5 )
-                reader_T2tt_down[i]->AddVariable("mini_chi2", &chi2down_);
-            reader_T2tt_down[i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiomdown_);
-            reader_T2tt_down[i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-            if ( i == 5 )
-                reader_T2tt_down[i]->AddVariable("mini_pt_b", &pt_b_down_);
-
-	    // btagging up
-	    reader_T2tt_bup[i] = new TMVA::Reader( "!Color:!Silent" );
-	    reader_T2tt_bup[i]->AddVariable("mini_met", &met_);
-	    reader_T2tt_bup[i]->AddVariable("mini_mt2w", &mt2wbup_);
-	    if ( i != 5 )
-	      reader_T2tt_bup[i]->AddVariable("mini_chi2", &chi2bup_);
-	    reader_T2tt_bup[i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiom_);
-	    reader_T2tt_bup[i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-	    if ( i == 5 )
-	      reader_T2tt_bup[i]->AddVariable("mini_pt_b", &pt_b_bup_);
-
-	    // btagging down
-            reader_T2tt_bdown[i] = new TMVA::Reader( "!Color:!Silent" );
-            reader_T2tt_bdown[i]->AddVariable("mini_met", &met_);
-            reader_T2tt_bdown[i]->AddVariable("mini_mt2w", &mt2wbdown_);
-            if ( i != 5 )
-                reader_T2tt_bdown[i]->AddVariable("mini_chi2", &chi2bdown_);
-            reader_T2tt_bdown[i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiom_);
-            reader_T2tt_bdown[i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-            if ( i == 5 )
-                reader_T2tt_bdown[i]->AddVariable("mini_pt_b", &pt_b_bdown_);
+        mva.addVariable("mini_met", mva_met);
+        mva.addVariable("mini_mt2w", mva_mt2w);
+        mva.addVariable("mini_chi2", mva_chi2);
+        mva.addVariable("mini_htssm/(mini_htosm+mini_htssm)", mva_htratiom);
+        mva.addVariable("mini_dphimjmin", &dphimjmin_);
+        mva.addVariable("mini_pt_b", mva_pt_b);
+        mva.addVariable("mini_lep1pt", &lep1pt_);
+        mva.addVariable("mini_dRleptB1", mva_dRleptB1);
 
+        for (int i=1; i < NREG_T2tt ; i++){
             TString dir, prefix;
             dir    = "/home/users/magania/stop/SingleLepton2012/MVA/weights/";
             prefix = "classification_T2tt_";
@@ -408,11 +384,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             prefix += "_BDT";
 
             TString weightfile = dir + prefix + TString(".weights.xml");
-            reader_T2tt[i]      ->BookMVA( "BDT" , weightfile );
-            reader_T2tt_up[i]   ->BookMVA( "BDT" , weightfile );
-            reader_T2tt_down[i] ->BookMVA( "BDT" , weightfile );
-            reader_T2tt_bup[i]  ->BookMVA( "BDT" , weightfile );
-            reader_T2tt_bdown[i]->BookMVA( "BDT" , weightfile );
+            bdt_T2tt[i] = mva.book( weightfile.Data() );
         }
 
         for (int j=0; j < 3; j++){
@@ -425,68 +397,10 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             }
             for (int i=1; i < NREG_T2bw ; i++){
                 if ( j==0 && i==1 ) continue;
-                reader_T2bw[j][i] = new TMVA::Reader( "!Color:!Silent" );
-                reader_T2bw[j][i]->AddVariable("mini_met", &met_);
-                reader_T2bw[j][i]->AddVariable("mini_mt2w", &mt2w_);
-                if ( j!=2 && i==4 )
-                reader_T2bw[j][i]->AddVariable("mini_lep1pt", &lep1pt_);
-                reader_T2bw[j][i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiom_);
-                reader_T2bw[j][i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-                reader_T2bw[j][i]->AddVariable("mini_pt_b", &pt_b_);
-                reader_T2bw[j][i]->AddVariable("mini_dRleptB1", &dRleptB1_);
-
-		// JES up
-                reader_T2bw_up[j][i] = new TMVA::Reader( "!Color:!Silent" );
-                reader_T2bw_up[j][i]->AddVariable("mini_met", &metup_);
-                reader_T2bw_up[j][i]->AddVariable("mini_mt2w", &mt2wup_);
-                if ( j!=2 && i==4 )
-                reader_T2bw_up[j][i]->AddVariable("mini_lep1pt", &lep1pt_);
-                reader_T2bw_up[j][i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiomup_);
-                reader_T2bw_up[j][i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-                reader_T2bw_up[j][i]->AddVariable("mini_pt_b", &pt_b_up_);
-                reader_T2bw_up[j][i]->AddVariable("mini_dRleptB1", &dRleptB1_);
-
-		// JES down
-                reader_T2bw_down[j][i] = new TMVA::Reader( "!Color:!Silent" );
-                reader_T2bw_down[j][i]->AddVariable("mini_met", &metdown_);
-                reader_T2bw_down[j][i]->AddVariable("mini_mt2w", &mt2wdown_);
-                if ( j!=2 && i==4 )
-                reader_T2bw_down[j][i]->AddVariable("mini_lep1pt", &lep1pt_);
-                reader_T2bw_down[j][i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiomdown_);
-                reader_T2bw_down[j][i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-                reader_T2bw_down[j][i]->AddVariable("mini_pt_b", &pt_b_down_);
-                reader_T2bw_down[j][i]->AddVariable("mini_dRleptB1", &dRleptB1_);
-
-		// btagging up
-                reader_T2bw_bup[j][i] = new TMVA::Reader( "!Color:!Silent" );
-                reader_T2bw_bup[j][i]->AddVariable("mini_met", &met_);
-                reader_T2bw_bup[j][i]->AddVariable("mini_mt2w", &mt2wbup_);
-                if ( j!=2 && i==4 )
-                reader_T2bw_bup[j][i]->AddVariable("mini_lep1pt", &lep1pt_);
-                reader_T2bw_bup[j][i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiom_);
-                reader_T2bw_bup[j][i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-                reader_T2bw_bup[j][i]->AddVariable("mini_pt_b", &pt_b_bup_);
-                reader_T2bw_bup[j][i]->AddVariable("mini_dRleptB1", &dRleptB1_bup_);
-
-		// btagging down
-                reader_T2bw_bdown[j][i] = new TMVA::Reader( "!Color:!Silent" );
-                reader_T2bw_bdown[j][i]->AddVariable("mini_met", &met_);
-                reader_T2bw_bdown[j][i]->AddVariable("mini_mt2w", &mt2wbdown_);
-                if ( j!=2 && i==4 )
-                reader_T2bw_bdown[j][i]->AddVariable("mini_lep1pt", &lep1pt_);
-                reader_T2bw_bdown[j][i]->AddVariable("mini_htssm/(mini_htosm+mini_htssm)", &htratiom_);
-                reader_T2bw_bdown[j][i]->AddVariable("mini_dphimjmin", &dphimjmin_);
-                reader_T2bw_bdown[j][i]->AddVariable("mini_pt_b", &pt_b_bdown_);
-                reader_T2bw_bdown[j][i]->AddVariable("mini_dRleptB1", &dRleptB1_bdown_);
-
                 TString dir    = "/home/users/magania/stop/SingleLepton2012/MVA/weights/";
                 TString weightfile = Form("classification_T2bw_%d_%.2f_BDT.weights.xml",i,x);
 
-                reader_T2bw[j][i]      ->BookMVA( "BDT" , dir+weightfile );
-                reader_T2bw_up[j][i]   ->BookMVA( "BDT" , dir+weightfile );
-                reader_T2bw_down[j][i] ->BookMVA( "BDT" , dir+weightfile );
-                reader_T2bw_bup[j][i]  ->BookMVA( "BDT" , dir+weightfile );
-                reader_T2bw_bdown[j][i]->BookMVA( "BDT" , dir+weightfile );
+                bdt_T2bw[j][i] = mva.book( (dir+weightfile).Data() );
             }
 
         }
@@ -495,17 +409,16 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
     else if ( __apply_mva && DO_WHMET ) {
 
-        for (int i=0; i < NREG_TChiWH ; i++){
-            reader_TChiWH[i] = new TMVA::Reader( "!Color:!Silent" );
-            reader_TChiWH[i]->AddVariable("mini_met", &met_);
-            reader_TChiWH[i]->AddVariable("mini_mt", &mt_);
-            reader_TChiWH[i]->AddVariable("mini_mt2bl", &mt2bl_);
-            reader_TChiWH[i]->AddVariable("mini_pt_J1", &pt_J1_);
-            reader_TChiWH[i]->AddVariable("mini_pt_J2", &pt_J2_);
-            reader_TChiWH[i]->AddVariable("mini_bbpt", &bbpt_);
-            reader_TChiWH[i]->AddVariable("mini_bbwdphi", &bbwdphi_);
-            reader_TChiWH[i]->AddVariable("mini_bbdR", &bbdR_);
+        mva.addVariable("mini_met", &met_);
+        mva.addVariable("mini_mt", &mt_);
+        mva.addVariable("mini_mt2bl", &mt2bl_);
+        mva.addVariable("mini_pt_J1", &pt_J1_);
+        mva.addVariable("mini_pt_J2", &pt_J2_);
+        mva.addVariable("mini_bbpt", &bbpt_);
+        mva.addVariable("mini_bbwdphi", &bbwdphi_);
+        mva.addVariable("mini_bbdR", &bbdR_);
 
+        for (int i=0; i < NREG_TChiWH ; i++){
             TString dir, prefix;
             dir    = "/nfs-7/userdata/olivito/MVA/weights/V00-00-01/";
             prefix = "classification_TChiWH_";
@@ -513,7 +426,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             prefix += "_BDT";
 
             TString weightfile = dir + prefix + TString(".weights.xml");
-            reader_TChiWH[i]      ->BookMVA( "BDT" , weightfile );
+            bdt_TChiWH[i] = mva.book( weightfile.Data() );
 	}
     }
 
@@ -549,6 +462,24 @@ void StopTreeLooper::loop(TChain *chain, TString name)
         << " with pT>"<<JET_PT<<" GeV and |eta|<" << JET_ETA
         << endl;
 
+    // chi2 and MT2 for the JES and b-tag variations reuse the nominal
+    // results whenever the variation does not change their inputs
+    VariationCache variations;
+    variations.debug = false;
+
+    // trigger and b-tag scale factors; debug compares with stopUtils
+    ScaleFactors scaleFactors;
+    scaleFactors.debug = false;
+
+    // cutflow table of the single lepton selection, filled while setting pass1l
+    Cutflow& cutflow1l = singleLeptonCutflow();
+    cutflow1l.setAdaptive(10000);
+
+    // mass point and generated events of every entry of a signal scan, to
+    // store the points clustered with an index once the baby is written
+    vector<MassPoint> scanPoints;
+    vector<int> scanNgen;
+
     while (TChainElement *currentFile = (TChainElement*)fileIter.Next()) {
 
         //---------------------------------
@@ -638,6 +569,10 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
 	    x_ = stopt.x();
 
+	    // key of the event in the mass database and the mass index
+	    MassPoint point = { stopt.mg(), stopt.ml(), name.Contains("T2bw") ? x_ : -1.f };
+	    if ( name.Contains("pMSSM") ) { point.mg = stopt.run(); point.ml = -1.; }
+
             if( name.Contains("T2bw") ) {
 	      if( stopt.mg() < -1 || stopt.ml() < -1 || stopt.x() < -1 ){
 		cout << "ERROR! negative SUSY mass! Skip event!" << endl;
@@ -660,11 +595,28 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	    }
 
 
+	    // generated events (and the TChiWH cross section) once per point
+	    PointNorm* norm = isScan ? normCache.find(point) : 0;
+	    if( isScan && !norm ){
+	      norm = &normCache.insert(point);
+	      if( !massdb.empty() ) norm->nevents = massdb.nevents(point);
+	      else if( name.Contains("T2tt") ){
+		int bin = nsig.bin(stopt.mg(),stopt.ml());
+		norm->nevents = stopt.ml() < 10.0 ? nsig_masslessLSP.content(bin) : nsig.content(bin);
+	      }
+	      else if( name.Contains("T2bw") ){
+		if      ( x_ == 0.25 ) norm->nevents = nsig25.value(stopt.mg(),stopt.ml());
+		else if ( x_ == 0.50 ) norm->nevents = nsig.value(stopt.mg(),stopt.ml());
+		else if ( x_ == 0.75 ) norm->nevents = nsig75.value(stopt.mg(),stopt.ml());
+	      }
+	      else if( name.Contains("pMSSM") ) norm->nevents = nsig_pmssm.value(stopt.run());
+	      else if( name.Contains("TChiWH") ) norm->nevents = nsig.value(stopt.mg(),stopt.ml());
+
+	      if( name.Contains("TChiWH") && stopt.mg() > 0. ) norm->xsec = c1n2CrossSection(stopt.mg());
+	    }
+
             if( name.Contains("T2tt") ) {
-                int bin = h_nsig->FindBin(stopt.mg(),stopt.ml());
-                float nevents = h_nsig->GetBinContent(bin);
-		if( stopt.ml() < 10.0 )
-		  nevents = h_nsig_masslessLSP->GetBinContent(bin);
+                float nevents = norm->nevents;
 
 		// skip events with LSP mass = 0 because they're buggy
 		// the fixed slice has LSP mass = 1 GeV
@@ -687,21 +639,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	      // if x is buggy, calculate it by hand using the genparticle masses
 	      //---------------------------------------------------------------------
 
-	      float nevents = 0;
-	      if ( x_ == 0.25 ){
-		int bin = h_nsig25->FindBin(stopt.mg(),stopt.ml());
-		nevents = h_nsig25->GetBinContent(bin);
-	      } 
-
-	      else if ( x_ == 0.50 ){
-		int bin = h_nsig->FindBin(stopt.mg(),stopt.ml());
-		nevents = h_nsig->GetBinContent(bin);
-	      } 
-
-	      else if ( x_ == 0.75 ){
-		int bin = h_nsig75->FindBin(stopt.mg(),stopt.ml());
-		nevents = h_nsig75->GetBinContent(bin);
-	      }
+	      float nevents = norm->nevents;
 
 	      if( nevents == 0 ){
 		cout << __FILE__ << " " << __LINE__ << " ERROR! couldn't get nevents" << endl;
@@ -755,12 +693,11 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             }
 
 	    if ( name.Contains("TChiWH") ) {
-	      int bin = h_nsig->FindBin(stopt.mg(),stopt.ml());
-	      float nevents = h_nsig->GetBinContent(bin);
+	      float nevents = norm->nevents;
 
 	      //NOTE::need to add vtx. reweighting for the signal sample
 	      //	      xsecsusy_    = stopt.xsecsusy();
-	      xsecsusy_  = stopt.mg() > 0. ? c1n2CrossSection(stopt.mg()) * 0.33 * 0.56 : -999;
+	      xsecsusy_  = stopt.mg() > 0. ? norm->xsec * 0.33 * 0.56 : -999;
 	      whweight_  = xsecsusy_ * 1000.0 / nevents * 19.5; 
 	      nsigevents_ = (int) nevents;
 	      mchargino_   = stopt.mg();                   // chargino mass
@@ -768,8 +705,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	    }
 
 	    if ( name.Contains("pMSSM") ) {
-	      int bin = h_nsig_pmssm->FindBin(stopt.run());
-	      float nevents = h_nsig_pmssm->GetBinContent(bin);
+	      float nevents = norm->nevents;
 
 	      //NOTE::need to add vtx. reweighting for the signal sample
 	      whweight_  = stopt.xsecsusy() * 1000.0 / nevents * 19.5; 
@@ -781,9 +717,9 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	    nvtxweight_ = puweight;
 
             sltrigeff_   = isData ? 1. : 
-	      getsltrigweight(stopt.id1(), stopt.lep1().Pt(), stopt.lep1().Eta());
+	      scaleFactors.slTrigWeight(stopt.id1(), stopt.lep1().Pt(), stopt.lep1().Eta()).nominal;
             dltrigeff_ = isData ? 1. : 
-                getdltrigweight(stopt.id1(), stopt.id2());
+                scaleFactors.dlTrigWeight(stopt.id1(), stopt.id2());
 
 	    if (name.Contains("ttbar_") || name.Contains("ttsl_") || name.Contains("ttdl_")) {
 	      // extra factor of 1.01 to preserve total normalization
@@ -799,14 +735,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	      float eta = fabs(stopt.lep1().Eta());
 	      if (abs(stopt.id1()) == 11) {
 		// avoid going out of histo range..
-		if (pt > h_el_fastsimsf->GetXaxis()->GetXmax()) pt = h_el_fastsimsf->GetXaxis()->GetXmax()-0.5;
-		int bin = h_el_fastsimsf->FindBin(pt, eta);
-		lepfastsimsf_ = h_el_fastsimsf->GetBinContent(bin);
+		if (pt > el_fastsimsf.xaxis().max()) pt = el_fastsimsf.xaxis().max()-0.5;
+		lepfastsimsf_ = el_fastsimsf.value(pt, eta);
 	      } else if (abs(stopt.id1()) == 13) {
 		// avoid going out of histo range..
-		if (pt > h_mu_fastsimsf->GetXaxis()->GetXmax()) pt = h_mu_fastsimsf->GetXaxis()->GetXmax()-0.5;
-		int bin = h_mu_fastsimsf->FindBin(pt, eta);
-		lepfastsimsf_ = h_mu_fastsimsf->GetBinContent(bin);
+		if (pt > mu_fastsimsf.xaxis().max()) pt = mu_fastsimsf.xaxis().max()-0.5;
+		lepfastsimsf_ = mu_fastsimsf.value(pt, eta);
 	      }
 	    } 
 
@@ -929,7 +863,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             nb_downBCShape_ = 0;
             nb_upLShape_ = 0;
             nb_downLShape_ = 0;
-	    btagsf_ = 1.;
+	    vector<int> bjets_idx;
 	    nnonbjets_ = 0;
 	    tobtecveto_ = 0;
 
@@ -947,51 +881,28 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	    int nb_bup   = 0;
 	    int nb_bdown = 0;
 
+	    // b-tagging information: reshaped csv of all jets and variations
+	    if (isData) {
+	      for (int v = 0; v < BTagReshaper::NVARIATIONS; ++v) csvShapes[v] = stopt.pfjets_csv();
+	    } else {
+	      reshaper->reshapeJets( stopt.pfjets(), stopt.pfjets_csv(), stopt.pfjets_mcflavorAlgo(), csvShapes );
+	    }
+
             for (unsigned int i =0; i<stopt.pfjets().size(); i++){
 
 	      bool passTightPUid = passMVAJetId(stopt.pfjets().at(i).pt(), stopt.pfjets().at(i).eta(),stopt.pfjets_mva5xPUid().at(i),0);
 
 	      float dPhiM = getdphi( metphi, stopt.pfjets().at(i).phi() );
 
-	      // b-tagging information
-	       
-	      //float csv_nominal=(isData || name.Contains("T2")) ? stopt.pfjets_csv().at(i)
-	      float csv_nominal=(!DO_CSV_RESHAPING || isData) ? stopt.pfjets_csv().at(i)
-		: nominalShape->reshape( stopt.pfjets().at(i).eta(),
-					 stopt.pfjets().at(i).pt(),
-					 stopt.pfjets_csv().at(i),
-					 stopt.pfjets_mcflavorAlgo().at(i) ); 
+	      float csv_nominal     = csvShapes[BTagReshaper::NOMINAL].at(i);
+	      float csv_upBCShape   = csvShapes[BTagReshaper::UPBC].at(i);
+	      float csv_downBCShape = csvShapes[BTagReshaper::DOWNBC].at(i);
+	      float csv_upLShape    = csvShapes[BTagReshaper::UPL].at(i);
+	      float csv_downLShape  = csvShapes[BTagReshaper::DOWNL].at(i);
+	      if (!DO_CSV_RESHAPING) csv_nominal = stopt.pfjets_csv().at(i);
 
 	      pfjets_csvreshape_.push_back( csv_nominal );
 
-	      //float csv_upBCShape=(isData || name.Contains("T2")) ? stopt.pfjets_csv().at(i)
-	      float csv_upBCShape=(isData) ? stopt.pfjets_csv().at(i)
-		: upBCShape->reshape( stopt.pfjets().at(i).eta(),
-					 stopt.pfjets().at(i).pt(),
-					 stopt.pfjets_csv().at(i),
-					 stopt.pfjets_mcflavorAlgo().at(i) );
-
-	      //float csv_downBCShape=(isData || name.Contains("T2")) ? stopt.pfjets_csv().at(i)
-	      float csv_downBCShape=(isData) ? stopt.pfjets_csv().at(i)
-		: downBCShape->reshape( stopt.pfjets().at(i).eta(),
-					 stopt.pfjets().at(i).pt(),
-					 stopt.pfjets_csv().at(i),
-					 stopt.pfjets_mcflavorAlgo().at(i) );
-
-	      //float csv_upLShape=(isData || name.Contains("T2")) ? stopt.pfjets_csv().at(i)
-	      float csv_upLShape=(isData) ? stopt.pfjets_csv().at(i)
-		: upLShape->reshape( stopt.pfjets().at(i).eta(),
-					 stopt.pfjets().at(i).pt(),
-					 stopt.pfjets_csv().at(i),
-					 stopt.pfjets_mcflavorAlgo().at(i) );
-
-	      //float csv_downLShape=(isData || name.Contains("T2")) ? stopt.pfjets_csv().at(i)
-	      float csv_downLShape=(isData) ? stopt.pfjets_csv().at(i)
-		: downLShape->reshape( stopt.pfjets().at(i).eta(),
-					 stopt.pfjets().at(i).pt(),
-					 stopt.pfjets_csv().at(i),
-					 stopt.pfjets_mcflavorAlgo().at(i) );
-
 	      // jets with up and down variations
 	      //float unc     = stopt.pfjets_uncertainty().at(i);
 	      float unc = 0.0;
@@ -1074,7 +985,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 				      stopt.pfjets().at(i).phi() , 
 				      stopt.lep1().eta(), stopt.lep1().phi());
 		}
-		btagsf_ *= getBtagSF(stopt.pfjets().at(i).pt(),stopt.pfjets().at(i).eta(),stopt.pfjets_mcflavorAlgo().at(i),isfastsim);
+		bjets_idx.push_back(i);
 	      }
 
 	      else{
@@ -1147,6 +1058,9 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
             }
 
+	    // b-tag SF: product over the tagged jets
+	    btagsf_ = scaleFactors.btagWeight(stopt.pfjets(), stopt.pfjets_mcflavorAlgo(), bjets_idx, isfastsim).nominal;
+
 	    // store events with >=4 jets with JES up
 	    if ( njets_up_ < NJETS_CUT ) continue; 
 
@@ -1167,35 +1081,36 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             mt_     = (float)getMT(stopt.lep1().pt(), stopt.lep1().phi(), met_     , metphi     );
             mtup_   = (float)getMT(stopt.lep1().pt(), stopt.lep1().phi(), metup_   , metupphi   );
             mtdown_ = (float)getMT(stopt.lep1().pt(), stopt.lep1().phi(), metdown_ , metdownphi );
-            mt2b_   = (float)calculateMT2w(jets, jets_btag, stopt.lep1(), met_, metphi, MT2b);
-            mt2bl_  = (float)calculateMT2w(jets, jets_btag, stopt.lep1(), met_, metphi, MT2bl);
-            mt2w_   = (float)calculateMT2w(jets, jets_btag, stopt.lep1(), met_, metphi, MT2w);
+            variations.newEvent(stopt.lep1());
+            mt2b_   = (float)variations.getMT2w(jets, jets_btag, met_, metphi, MT2b);
+            mt2bl_  = (float)variations.getMT2w(jets, jets_btag, met_, metphi, MT2bl);
+            mt2w_   = (float)variations.getMT2w(jets, jets_btag, met_, metphi, MT2w);
 
 	    // only calculate chi2, varied MT2W for stop case, not WH+MET
 	    if (!DO_WHMET) {
-	      chi2_   = (float)calculateChi2SNT(jets, jets_sigma, jets_btag);
+	      chi2_   = (float)variations.getChi2SNT(jets, jets_sigma, jets_btag);
 
 	      // chi2 with JES up/down
-	      chi2up_    = (float)calculateChi2SNT(jets_up   , jets_up_sigma   , jets_up_btag  );
-	      chi2down_  = (float)calculateChi2SNT(jets_down , jets_down_sigma , jets_down_btag);
+	      chi2up_    = (float)variations.getChi2SNT(jets_up   , jets_up_sigma   , jets_up_btag  );
+	      chi2down_  = (float)variations.getChi2SNT(jets_down , jets_down_sigma , jets_down_btag);
 
 	      // chi2 with btagging up/down
-	      chi2bup_   = (float)calculateChi2SNT(jets, jets_sigma, jets_bup_btag  );
-	      chi2bdown_ = (float)calculateChi2SNT(jets, jets_sigma, jets_bdown_btag);
+	      chi2bup_   = (float)variations.getChi2SNT(jets, jets_sigma, jets_bup_btag  );
+	      chi2bdown_ = (float)variations.getChi2SNT(jets, jets_sigma, jets_bdown_btag);
 
 	      // MT2W with JES up/down
-	      mt2wup_   = (float)calculateMT2w(jets_up   , jets_up_btag   , stopt.lep1() , metup_   , metupphi   , MT2w);
-	      mt2wdown_ = (float)calculateMT2w(jets_down , jets_down_btag , stopt.lep1() , metdown_ , metdownphi , MT2w);
+	      mt2wup_   = (float)variations.getMT2w(jets_up   , jets_up_btag   , metup_   , metupphi   , MT2w);
+	      mt2wdown_ = (float)variations.getMT2w(jets_down , jets_down_btag , metdown_ , metdownphi , MT2w);
 
 	      // MT2W with btagging up/down
-	      mt2wbup_  = (float)calculateMT2w(jets, jets_bup_btag   , stopt.lep1(), met_, metphi, MT2w);
-	      mt2wbdown_= (float)calculateMT2w(jets, jets_bdown_btag , stopt.lep1(), met_, metphi, MT2w);
+	      mt2wbup_  = (float)variations.getMT2w(jets, jets_bup_btag   , met_, metphi, MT2w);
+	      mt2wbdown_= (float)variations.getMT2w(jets, jets_bdown_btag , met_, metphi, MT2w);
 	    }
 	    // WH+MET case: calculate varied MT2bl
 	    else {
 	      // MT2bl with JES up/down
-	      mt2blup_   = (float)calculateMT2w(jets_up   , jets_up_btag   , stopt.lep1() , metup_   , metupphi   , MT2bl);
-	      mt2bldown_ = (float)calculateMT2w(jets_down , jets_down_btag , stopt.lep1() , metdown_ , metdownphi , MT2bl);
+	      mt2blup_   = (float)variations.getMT2w(jets_up   , jets_up_btag   , metup_   , metupphi   , MT2bl);
+	      mt2bldown_ = (float)variations.getMT2w(jets_down , jets_down_btag , metdown_ , metdownphi , MT2bl);
 	    }
 
             // for WH+MET ntuple
@@ -1325,7 +1240,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             //------------------------------------------ 
 
             // single lepton selection
-            pass1l_       = passSingleLeptonSelection(isData) ? 1 : 0; 
+            pass1l_       = cutflow1l.pass(isData, weight_) ? 1 : 0; 
             // isolated track veto selection
             passisotrk_   = passIsoTrkVeto_v4() ? 1 : 0; 
             // tau veto selection 
@@ -1441,6 +1356,8 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	    if( isrboost > 150.0 && isrboost < 250.0 ) isrweight_ = 0.90;
 	    if( isrboost > 250.0                     ) isrweight_ = 0.80;
 
+	    if ( __apply_mva ) mva.evaluate();
+
 	    if (!DO_WHMET) {
 	      for ( int i=0; i < NREG_T2tt; i++){
 
@@ -1451,11 +1368,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 		float bdtvalbdown = 0;
 
 		if ( __apply_mva && i>0 ){
-		  bdtval      = reader_T2tt[i]      ->EvaluateMVA( "BDT" );
-		  bdtvalup    = reader_T2tt_up[i]   ->EvaluateMVA( "BDT" );
-		  bdtvaldown  = reader_T2tt_down[i] ->EvaluateMVA( "BDT" );
-		  bdtvalbup   = reader_T2tt_bup[i]  ->EvaluateMVA( "BDT" );
-		  bdtvalbdown = reader_T2tt_bdown[i]->EvaluateMVA( "BDT" );
+		  const double* bdtvals = mva.values( bdt_T2tt[i] );
+		  bdtval      = bdtvals[MVA_NOM];
+		  bdtvalup    = bdtvals[MVA_JESUP];
+		  bdtvaldown  = bdtvals[MVA_JESDOWN];
+		  bdtvalbup   = bdtvals[MVA_BUP];
+		  bdtvalbdown = bdtvals[MVA_BDOWN];
 		}
 
 		bdt_     .push_back(bdtval);
@@ -1475,11 +1393,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 		  float bdtvalbdown = 0;
 
 		  if ( __apply_mva && i>0 && !(j==0&&i==1) ){
-		    bdtval      = reader_T2bw[j][i]      ->EvaluateMVA( "BDT" );
-		    bdtvalup    = reader_T2bw_up[j][i]   ->EvaluateMVA( "BDT" );
-		    bdtvaldown  = reader_T2bw_down[j][i] ->EvaluateMVA( "BDT" );
-		    bdtvalbup   = reader_T2bw_bup[j][i]  ->EvaluateMVA( "BDT" );
-		    bdtvalbdown = reader_T2bw_bdown[j][i]->EvaluateMVA( "BDT" );
+		    const double* bdtvals = mva.values( bdt_T2bw[j][i] );
+		    bdtval      = bdtvals[MVA_NOM];
+		    bdtvalup    = bdtvals[MVA_JESUP];
+		    bdtvaldown  = bdtvals[MVA_JESDOWN];
+		    bdtvalbup   = bdtvals[MVA_BUP];
+		    bdtvalbdown = bdtvals[MVA_BDOWN];
 		  }
 
 		  bdt_     .push_back(bdtval);
@@ -1500,7 +1419,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 		float bdtvaldown = 0;
 
 		if ( __apply_mva ){
-		  bdtval      = reader_TChiWH[i]      ->EvaluateMVA( "BDT" );
+		  bdtval      = mva.values( bdt_TChiWH[i] )[MVA_NOM];
 		  // bdtvalup    = reader_TChiWH_up[i]   ->EvaluateMVA( "BDT" );
 		  // bdtvaldown  = reader_TChiWH_down[i] ->EvaluateMVA( "BDT" );
 		}
@@ -1516,6 +1435,11 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             nEventsPass++;
             outTree_->Fill();
 
+	    if ( isScan ) {
+	      scanPoints.push_back(point);
+	      scanNgen.push_back(nsigevents_);
+	    }
+
 
             } // end event loop
 
@@ -1527,12 +1451,19 @@ void StopTreeLooper::loop(TChain *chain, TString name)
         //-------------------------
 
         cout << "[StopTreeLooper::loop] saving mini-baby with total entries " << nEventsPass << endl;
+        variations.printSummary();
+        if ( isScan ) normCache.printSummary();
+        cutflow1l.print();
 
+        string outFileName = outFile_->GetName();
         outFile_->cd();
         outTree_->Write();
+        if ( !massdb.empty() ) massdb.write(outFile_);
         outFile_->Close();
         delete outFile_;
 
+        if ( isScan ) MassIndex::cluster(outFileName.c_str(), scanPoints, scanNgen);
+
         already_seen.clear();
 
         gROOT->cd();
@@ -2153,8 +2084,7 @@ double Reweight_T2bW (double thetaChi_eff, double thetaW_eff, std::vector<SUSYGe
 
 float StopTreeLooper::c1n2CrossSection( float c1mass ){
 
-  int   bin  = c1n2_xsec_hist->FindBin(c1mass);
-  float xsec = c1n2_xsec_hist->GetBinContent(bin);
+  float xsec = c1n2_xsec_->value(c1mass);
   return xsec;
 
 }
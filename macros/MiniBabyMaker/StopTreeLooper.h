@@ -40,6 +40,7 @@ const bool __SORT = true;
 
 
 class StopTree;
+class BinnedTable;
 
 class StopTreeLooper {
 
@@ -271,8 +272,7 @@ class StopTreeLooper {
     static const bool __mini_branches = true;
     static const bool __add_babies = true; 
 
-	TH1F*   c1n2_xsec_hist;
-	TFile*  c1n2_xsec_file;
+	BinnedTable* c1n2_xsec_;
 
 };
 
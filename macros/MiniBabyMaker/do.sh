@@ -13,21 +13,13 @@ XPATH=/nfs-7/userdata/stop/output_V00-02-24_2012_4jskim
 #XPATH=/nfs-3/userdata/stop/cms2V05-03-25_stoplooperV00-02-18/T2bw_coarse/
 #XPATH=/nfs-3/userdata/stop/cms2V05-03-18_stoplooperV00-02-07/crabT2bw_3/
 
+# one task per input file, cost = file size so the largest start first;
+# ../runTasks.py -h for the concurrency, memory and retry options
+MANIFEST=output/log/tasks.txt
+mkdir -p output/log
+: > $MANIFEST
 for tag in `ls -1 $XPATH | grep root |  cut -d'.' -f1`;
- do echo root -b -q -l doFile.C\(\"$XPATH\",\"$tag\"\)
- nohup root -b -q -l doFile.C\(\"${XPATH}\",\"${tag}\"\) > output/log/${tag}.log &
+ do echo "${tag} `stat -L -c %s ${XPATH}/${tag}.root` - root -b -q -l doFile.C\(\\\"${XPATH}\\\",\\\"${tag}\\\"\)" >> $MANIFEST
 done
 
-#let "FAIL=0"
-
-#for job in `jobs -p`
-#do echo $job
-#   wait $job || let "FAIL+=1"
-#done
-
-#echo $FAIL
-
-#if [ "$FAIL" == "0" ];
-# then echo "YAY!"
-# else echo "FAIL! ($FAIL)"
-#fi
+../runTasks.py -l output/log $MANIFEST
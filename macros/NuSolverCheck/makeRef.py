@@ -0,0 +1,101 @@
+#!/bin/env python
+#
+# Events and python reference for nuSolverCheck.
+#
+#   python makeRef.py gen <n> <seed> fixtures/events.txt
+#   python makeRef.py ref fixtures/events.txt fixtures/python.ref
+#
+# gen: dilepton ttbar at parton level (on-shell t and W, b mass 4.8 GeV),
+# with the b energies smeared by 10% and the MET by 15 GeV in every other
+# event, so both exact and closest-approach cases come up.
+# ref: doubleNeutrinoSolutionsCheckLinAlg of ../TopAFBLooper/nuSolutions.py
+# through loadBetchart.py, as StopTreeLooper's crossCheckNuSolver does; needs
+# PyROOT, so python 2 with the ROOT of the loopers.
+#
+
+import math
+import os
+import sys
+
+import numpy as np
+
+
+def boost(p, b):
+    b = np.asarray(b)
+    b2 = b.dot(b)
+    if b2 == 0: return p
+    g = 1 / math.sqrt(1 - b2)
+    bp = b.dot(p[1:])
+    return np.concatenate([[g * (p[0] + bp)], p[1:] + (g - 1) / b2 * bp * b + g * b * p[0]])
+
+
+def decay(rng, M, m1, m2):
+    '''two-body decay at rest, isotropic'''
+    pm = math.sqrt((M * M - (m1 + m2) ** 2) * (M * M - (m1 - m2) ** 2)) / (2 * M)
+    c = rng.uniform(-1, 1)
+    s = math.sqrt(1 - c * c)
+    ph = rng.uniform(0, 2 * math.pi)
+    d = pm * np.array([s * math.cos(ph), s * math.sin(ph), c])
+    return (np.concatenate([[math.sqrt(pm * pm + m1 * m1)], d]),
+            np.concatenate([[math.sqrt(pm * pm + m2 * m2)], -d]))
+
+
+def ptetaphie(p):
+    pt = math.hypot(p[1], p[2])
+    return pt, math.asinh(p[3] / pt), math.atan2(p[2], p[1]), p[0]
+
+
+def generate(n, seed, mt=172.5, mw=80.385, mb=4.8):
+    rng = np.random.RandomState(seed)
+    events = []
+    for ev in range(n):
+        # ttbar system, boosted along z and a little in the transverse plane
+        t1, t2 = decay(rng, rng.uniform(2 * mt + 1, 800), mt, mt)
+        bst = np.array([rng.normal(0, 0.05), rng.normal(0, 0.05), rng.uniform(-0.6, 0.6)])
+        parts = []
+        for t in (t1, t2):
+            t = boost(t, bst)
+            b, W = decay(rng, mt, mb, mw)
+            l, nu = decay(rng, mw, 0, 0)
+            l, nu = boost(l, W[1:] / W[0]), boost(nu, W[1:] / W[0])
+            parts.append([boost(x, t[1:] / t[0]) for x in (b, l, nu)])
+        (b1, l1, n1), (b2, l2, n2) = parts
+        met = n1[1:3] + n2[1:3]
+        if ev % 2:
+            b1 = b1 * rng.normal(1, 0.1)
+            b2 = b2 * rng.normal(1, 0.1)
+            met = met + rng.normal(0, 15, 2)
+        events.append(list(ptetaphie(b1)) + list(ptetaphie(b2)) +
+                      list(ptetaphie(l1)) + list(ptetaphie(l2)) + [met[0], met[1]])
+    return events
+
+
+def readEvents(filename):
+    return [[float(x) for x in line.split()] for line in open(filename) if line.strip()]
+
+
+def writeReference(events, out, lv, solve):
+    '''one line per event and pairing: event pairing ok n, then n x 6 momenta'''
+    for iev, v in enumerate(events):
+        b, b_, l, l_ = [lv(*v[i:i + 4]) for i in (0, 4, 8, 12)]
+        for pairing, bb in enumerate([(b, b_), (b_, b)]):
+            dns = solve(bb, (l, l_), (v[16], v[17])).dns
+            sols = [] if dns == 0 else [list(nu) + list(nu_) for nu, nu_ in dns.nunu_s]
+            fields = [iev, pairing, int(dns != 0), len(sols)] + ['%.17g' % x for s in sols for x in s]
+            out.write(' '.join(str(f) for f in fields) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) == 5 and sys.argv[1] == 'gen':
+        events = generate(int(sys.argv[2]), int(sys.argv[3]))
+        open(sys.argv[4], 'w').write(''.join(' '.join('%.8f' % x for x in v) + '\n' for v in events))
+    elif len(sys.argv) == 4 and sys.argv[1] == 'ref':
+        events = readEvents(sys.argv[2])
+        out = open(sys.argv[3], 'w')
+        # loadBetchart.py compiles vecUtils.h from the working directory
+        os.chdir(os.path.join(os.path.dirname(os.path.abspath(__file__)), '../TopAFBLooper'))
+        sys.path.insert(0, '.')
+        import loadBetchart
+        writeReference(events, out, loadBetchart.lv, loadBetchart.doubleNeutrinoSolutionsCheckLinAlg)
+    else:
+        sys.exit('usage: makeRef.py gen <n> <seed> <events> | ref <events> <reference>')
@@ -0,0 +1,160 @@
+//
+// Regression of the native double-neutrino solver (TopAFBLooper/nuSolutions)
+// against the python it replaced (nuSolutions.py), on committed events.
+//
+//   nuSolverCheck                                        check the committed fixture
+//   nuSolverCheck <events> <reference> [-tol x] [-multistart]
+//
+// Each event is solved for both b-lepton pairings and compared with the
+// python's solutions through nuSolutions::sameSolutions: same number of
+// solutions (or LinAlgError in both), each python solution within tol GeV
+// (default 0.1) of a native one, and for a closest approach a native point
+// at least as close to the measured MET.  Exits nonzero on any mismatch.
+// The reference is written by makeRef.py (see README).
+//
+
+#include "../TopAFBLooper/nuSolutions.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// b, b_, lepton, lepton_ as pt, eta, phi, E, then the MET x and y
+struct NuEvent {
+  double v[18];
+};
+
+static bool readEvents(const char* filename, vector<NuEvent>& events){
+  FILE* f = fopen(filename, "r");
+  if (!f) {
+    cout << "[nuSolverCheck] cannot open " << filename << endl;
+    return false;
+  }
+  NuEvent ev;
+  while (true) {
+    int i = 0;
+    while (i < 18 && fscanf(f, "%lf", &ev.v[i]) == 1) ++i;
+    if (i == 0) break;
+    if (i < 18) {
+      cout << "[nuSolverCheck] truncated event " << events.size() << " in " << filename << endl;
+      fclose(f);
+      return false;
+    }
+    events.push_back(ev);
+  }
+  fclose(f);
+  cout << "[nuSolverCheck] " << events.size() << " events from " << filename << endl;
+  return !events.empty();
+}
+
+// float components, like loadBetchart's lv and the native LV
+static TLorentzVector lorentz(const double* v){
+  TLorentzVector p;
+  p.SetPtEtaPhiE((float)v[0], (float)v[1], (float)v[2], (float)v[3]);
+  return p;
+}
+
+static void print(const char* what, const nuSolutions::nunuSolutions& s){
+  printf("    %-6s ok %d n %d%s\n", what, s.ok, s.n, s.closestApproach ? " (closest approach)" : "");
+  for (int i = 0; i < s.n; ++i)
+    printf("      (%.4f, %.4f, %.4f) (%.4f, %.4f, %.4f)\n", s.nu[i][0][0], s.nu[i][0][1], s.nu[i][0][2],
+	   s.nu[i][1][0], s.nu[i][1][1], s.nu[i][1][2]);
+}
+
+//--------------------------------------------------------------------
+static int check(const char* eventfile, const char* reffile, double tol, bool multiStart){
+
+  vector<NuEvent> events;
+  if (!readEvents(eventfile, events)) return 1;
+
+  FILE* f = fopen(reffile, "r");
+  if (!f) {
+    cout << "[nuSolverCheck] cannot open " << reffile << endl;
+    return 1;
+  }
+
+  // one line per event and pairing: event pairing ok n, then n x 6 momenta
+  vector<bool> seen(2 * events.size(), false);
+  int nexact = 0, nclosest = 0, nlinalg = 0, nfailed = 0;
+  unsigned int iev;
+  int pairing, ok;
+  nuSolutions::nunuSolutions ref;
+  while (fscanf(f, "%u %d %d %d", &iev, &pairing, &ok, &ref.n) == 4) {
+    if (iev >= events.size() || pairing < 0 || pairing > 1 || ref.n < 0 || ref.n > nuSolutions::nunuSolutions::MAXSOL) {
+      cout << "[nuSolverCheck] reference does not match the events: event " << iev << " pairing " << pairing << endl;
+      fclose(f);
+      return 1;
+    }
+    ref.ok = ok != 0;
+    ref.closestApproach = false;
+    for (int is = 0; is < ref.n; ++is)
+      for (int inu = 0; inu < 2; ++inu)
+	for (int ix = 0; ix < 3; ++ix)
+	  if (fscanf(f, "%lf", &ref.nu[is][inu][ix]) != 1) {
+	    cout << "[nuSolverCheck] truncated reference at event " << iev << endl;
+	    fclose(f);
+	    return 1;
+	  }
+    seen[2 * iev + pairing] = true;
+
+    const double* v = events[iev].v;
+    TLorentzVector b = lorentz(v), b_ = lorentz(v + 4), mu = lorentz(v + 8), mu_ = lorentz(v + 12);
+    nuSolutions::nunuSolutions sols;
+    if (pairing == 0) nuSolutions::doubleNeutrinoSolutions(b, b_, mu, mu_, v[16], v[17], sols, nuSolutions::mW * nuSolutions::mW, nuSolutions::mT * nuSolutions::mT, multiStart);
+    else nuSolutions::doubleNeutrinoSolutions(b_, b, mu, mu_, v[16], v[17], sols, nuSolutions::mW * nuSolutions::mW, nuSolutions::mT * nuSolutions::mT, multiStart);
+
+    if (!ref.ok) ++nlinalg;
+    else if (sols.closestApproach) ++nclosest;
+    else ++nexact;
+
+    if (nuSolutions::sameSolutions(ref, sols, v[16], v[17], tol)) continue;
+    if (nfailed < 10) {
+      printf("  event %u pairing %d differs\n", iev, pairing);
+      print("python", ref);
+      print("native", sols);
+    }
+    ++nfailed;
+  }
+  fclose(f);
+
+  int nmissing = 0;
+  for (unsigned int i = 0; i < seen.size(); ++i)
+    if (!seen[i]) ++nmissing;
+
+  cout << "[nuSolverCheck] " << nexact << " exact, " << nclosest << " closest approach, " << nlinalg
+       << " LinAlgError; " << nfailed << " mismatches (tol " << tol << " GeV), "
+       << nmissing << " without reference" << endl;
+  return (nfailed || nmissing) ? 2 : 0;
+}
+
+//--------------------------------------------------------------------
+int main(int argc, char** argv){
+
+  const char* eventfile = "fixtures/events.txt";
+  const char* reffile = "fixtures/python.ref";
+  double tol = 0.1;
+  bool multiStart = false;
+
+  int iarg = 1;
+  if (argc >= 3 && argv[1][0] != '-') {
+    eventfile = argv[1];
+    reffile = argv[2];
+    iarg = 3;
+  }
+  for (; iarg < argc; ++iarg) {
+    if (!strcmp(argv[iarg], "-tol") && iarg + 1 < argc) tol = atof(argv[++iarg]);
+    else if (!strcmp(argv[iarg], "-multistart")) multiStart = true;
+    else {
+      cout << "usage: nuSolverCheck [<events> <reference>] [-tol x] [-multistart]" << endl;
+      return 1;
+    }
+  }
+
+  int status = check(eventfile, reffile, tol, multiStart);
+  cout << "[nuSolverCheck] " << (status ? "FAILED" : "native and python agree") << endl;
+  return status;
+}
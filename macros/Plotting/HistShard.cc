@@ -0,0 +1,139 @@
+#include "HistShard.h"
+
+#include <cmath>
+#include <cstdlib>
+
+void HistShard::fill(const string& name, float xval, double weight, int numbinsx, float xmin, float xmax)
+{
+    std::map<string, Hist>::iterator iter = hists_.find(name);
+    if (iter == hists_.end()) { //no histo for this yet, so make a new one
+        Hist h;
+        h.numbinsx = numbinsx;
+        h.xmin = xmin;
+        h.xmax = xmax;
+        h.sumw.assign(numbinsx + 2, 0.);
+        h.sumw2.assign(numbinsx + 2, 0.);
+        h.entries = 0.;
+        for (int i = 0; i < 4; ++i) h.stats[i] = 0.;
+        iter = hists_.insert(std::pair<string, Hist>(name, h)).first;
+    }
+    Hist& h = iter->second;
+
+    // same as TAxis::FindFixBin
+    double x = xval;
+    int bin;
+    if (x < h.xmin) bin = 0;
+    else if (!(x < h.xmax)) bin = h.numbinsx + 1;
+    else bin = 1 + int(h.numbinsx * (x - h.xmin) / (double(h.xmax) - h.xmin));
+
+    h.sumw[bin] += weight;
+    h.sumw2[bin] += weight * weight;
+    h.entries += 1.;
+    if (bin > 0 && bin <= h.numbinsx) {
+        h.stats[0] += weight;
+        h.stats[1] += weight * weight;
+        h.stats[2] += weight * x;
+        h.stats[3] += weight * x * x;
+    }
+}
+
+void HistShard::add(const HistShard& other)
+{
+    std::map<string, Hist>::const_iterator it;
+    for (it = other.hists_.begin(); it != other.hists_.end(); it++) {
+        std::map<string, Hist>::iterator mine = hists_.find(it->first);
+        if (mine == hists_.end()) {
+            hists_.insert(*it);
+            continue;
+        }
+        Hist& h = mine->second;
+        const Hist& o = it->second;
+        if (h.numbinsx != o.numbinsx || h.xmin != o.xmin || h.xmax != o.xmax) {
+            printf("[HistShard] %s booked with two different binnings\n", it->first.c_str());
+            exit(1);
+        }
+        for (int bin = 0; bin <= h.numbinsx + 1; ++bin) {
+            h.sumw[bin] += o.sumw[bin];
+            h.sumw2[bin] += o.sumw2[bin];
+        }
+        h.entries += o.entries;
+        for (int i = 0; i < 4; ++i) h.stats[i] += o.stats[i];
+    }
+}
+
+//--------------------------------------------------------------------
+
+bool HistShard::write(FILE* out) const
+{
+    unsigned int nhists = hists_.size();
+    if (fwrite(&nhists, sizeof(nhists), 1, out) != 1) return false;
+
+    std::map<string, Hist>::const_iterator it;
+    for (it = hists_.begin(); it != hists_.end(); it++) {
+        const Hist& h = it->second;
+        unsigned int length = it->first.size();
+        unsigned int nbins = h.numbinsx + 2;
+        if (fwrite(&length, sizeof(length), 1, out) != 1) return false;
+        if (fwrite(it->first.data(), 1, length, out) != length) return false;
+        if (fwrite(&h.numbinsx, sizeof(h.numbinsx), 1, out) != 1) return false;
+        if (fwrite(&h.xmin, sizeof(h.xmin), 1, out) != 1) return false;
+        if (fwrite(&h.xmax, sizeof(h.xmax), 1, out) != 1) return false;
+        if (fwrite(&h.entries, sizeof(h.entries), 1, out) != 1) return false;
+        if (fwrite(h.stats, sizeof(double), 4, out) != 4) return false;
+        if (fwrite(&h.sumw[0], sizeof(double), nbins, out) != nbins) return false;
+        if (fwrite(&h.sumw2[0], sizeof(double), nbins, out) != nbins) return false;
+    }
+    return true;
+}
+
+bool HistShard::read(FILE* in)
+{
+    clear();
+    unsigned int nhists;
+    if (fread(&nhists, sizeof(nhists), 1, in) != 1) return false;
+
+    for (unsigned int i = 0; i < nhists; ++i) {
+        unsigned int length;
+        if (fread(&length, sizeof(length), 1, in) != 1) return false;
+        string name(length, ' ');
+        if (length && fread(&name[0], 1, length, in) != length) return false;
+
+        Hist h;
+        if (fread(&h.numbinsx, sizeof(h.numbinsx), 1, in) != 1) return false;
+        if (fread(&h.xmin, sizeof(h.xmin), 1, in) != 1) return false;
+        if (fread(&h.xmax, sizeof(h.xmax), 1, in) != 1) return false;
+        if (fread(&h.entries, sizeof(h.entries), 1, in) != 1) return false;
+        if (fread(h.stats, sizeof(double), 4, in) != 4) return false;
+        if (h.numbinsx <= 0) return false;
+        unsigned int nbins = h.numbinsx + 2;
+        h.sumw.resize(nbins);
+        h.sumw2.resize(nbins);
+        if (fread(&h.sumw[0], sizeof(double), nbins, in) != nbins) return false;
+        if (fread(&h.sumw2[0], sizeof(double), nbins, in) != nbins) return false;
+        hists_.insert(std::pair<string, Hist>(name, h));
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------
+
+void HistShard::makeHists(std::map<string, TH1F*>& allhistos, const string& prefix) const
+{
+    std::map<string, Hist>::const_iterator it;
+    for (it = hists_.lower_bound(prefix); it != hists_.end(); it++) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) break;
+        string name = it->first.substr(prefix.size());
+        const Hist& h = it->second;
+        TH1F* currentHisto = new TH1F(name.c_str(), name.c_str(), h.numbinsx, h.xmin, h.xmax);
+        currentHisto->Sumw2();
+        for (int bin = 0; bin <= h.numbinsx + 1; ++bin) {
+            currentHisto->SetBinContent(bin, h.sumw[bin]);
+            currentHisto->SetBinError(bin, sqrt(h.sumw2[bin]));
+        }
+        // SetBinContent drops the statistics, put back the unbinned ones
+        double stats[4] = { h.stats[0], h.stats[1], h.stats[2], h.stats[3] };
+        currentHisto->PutStats(stats);
+        currentHisto->SetEntries(h.entries);
+        allhistos.insert(std::pair<string, TH1F*>(name, currentHisto));
+    }
+}
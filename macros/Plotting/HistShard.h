@@ -0,0 +1,65 @@
+#ifndef HISTSHARD_H
+#define HISTSHARD_H
+
+#include "TH1F.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//
+// 1D histograms kept as plain arrays of sums, so that pieces of a sample
+// can be filled separately (e.g. one shard per file, in worker processes)
+// and combined afterwards.
+//
+// fill() books a histogram by name on its first use, like plot1D, and adds
+// the weight and weight squared in double precision.  add() sums another
+// shard into this one bin by bin.  The result of a chain of add() calls
+// only depends on the shards and their order, not on who filled them, so
+// merging per-file shards in file order gives the same bits whether the
+// files were read by one process or by many.
+//
+// Besides the bins, the shard keeps the sums TH1::Fill uses for the mean
+// and RMS (in range fills only), so makeHists() gives the TH1Fs the same
+// statistics plot1D would have, up to the order of the additions.
+//
+// makeHists() turns the shard into TH1Fs for savePlots / savePlotsDir.
+//
+class HistShard {
+
+public:
+    // same binning and under/overflow as plot1D
+    void fill(const string& name, float xval, double weight, int numbinsx, float xmin, float xmax);
+
+    // histograms missing here are copied, a binning mismatch is fatal
+    void add(const HistShard& other);
+    void clear() { hists_.clear(); }
+    bool empty() const { return hists_.empty(); }
+
+    // raw dump for passing shards between processes
+    bool write(FILE* out) const;
+    bool read(FILE* in);
+
+    // adds a new TH1F per histogram to the map, owned by the caller; with a
+    // prefix, only the histograms whose name starts with it, prefix removed
+    void makeHists(std::map<string, TH1F*>& allhistos, const string& prefix = "") const;
+
+private:
+    struct Hist {
+        int numbinsx;
+        float xmin, xmax;
+        // bins 0 and numbinsx+1 are under- and overflow
+        vector<double> sumw;
+        vector<double> sumw2;
+        double entries;
+        // sum of w, w^2, w*x, w*x^2 as in TH1::PutStats
+        double stats[4];
+    };
+
+    std::map<string, Hist> hists_;
+};
+
+#endif
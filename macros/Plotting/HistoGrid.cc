@@ -0,0 +1,101 @@
+#include "HistoGrid.h"
+
+#include <cassert>
+#include <iostream>
+
+HistoGrid::HistoGrid(std::map<string, TH1F*>& allhistos, bool detached)
+    : allhistos_(allhistos), ncells_(1), detached_(detached), booked_(false)
+{
+}
+
+int HistoGrid::addAxis(const string& tags)
+{
+    // the layout can't change once histograms are handed out
+    assert(!booked_);
+    assert((int)axes_.size() < MAXAXES);
+
+    vector<string> axis;
+    string::size_type begin = 0, end;
+    do {
+        end = tags.find(',', begin);
+        axis.push_back(tags.substr(begin, end == string::npos ? string::npos : end - begin));
+        begin = end + 1;
+    } while (end != string::npos);
+
+    axes_.push_back(axis);
+    resize();
+    return axes_.size() - 1;
+}
+
+int HistoGrid::addVariable(const string& name, int numbinsx, float xmin, float xmax)
+{
+    assert(!booked_);
+
+    Variable v;
+    v.name = name;
+    v.numbinsx = numbinsx;
+    v.xmin = xmin;
+    v.xmax = xmax;
+    v.disabled = false;
+    variables_.push_back(v);
+    resize();
+    return variables_.size() - 1;
+}
+
+int HistoGrid::addVariable(const string& name)
+{
+    return addVariable(name, 0, 0., 0.);
+}
+
+void HistoGrid::resize()
+{
+    // last axis varies fastest
+    strides_.assign(MAXAXES, 0);
+    ncells_ = 1;
+    for (int a = axes_.size() - 1; a >= 0; --a) {
+        strides_[a] = ncells_;
+        ncells_ *= axes_[a].size();
+    }
+    histos_.assign(variables_.size() * ncells_, (TH1F*)0);
+}
+
+int HistoGrid::cell(int i0, int i1, int i2, int i3, int i4, int i5) const
+{
+    return i0 * strides_[0] + i1 * strides_[1] + i2 * strides_[2]
+        + i3 * strides_[3] + i4 * strides_[4] + i5 * strides_[5];
+}
+
+string HistoGrid::name(int var, int cell) const
+{
+    string title = variables_[var].name;
+    for (unsigned int a = 0; a < axes_.size(); ++a)
+        title += axes_[a][(cell / strides_[a]) % axes_[a].size()];
+    return title;
+}
+
+TH1F* HistoGrid::book(int var, int cell)
+{
+    const Variable& v = variables_[var];
+    // a variable without a binning is filled with one
+    assert(v.numbinsx > 0);
+    return book(var, cell, v.numbinsx, v.xmin, v.xmax);
+}
+
+TH1F* HistoGrid::book(int var, int cell, int numbinsx, float xmin, float xmax)
+{
+    if (variables_[var].disabled) return 0;
+    booked_ = true;
+
+    // same as plot1D: reuse a histogram of that name if there is one
+    string title = name(var, cell);
+    std::map<string, TH1F*>::iterator iter = allhistos_.find(title);
+    if (iter != allhistos_.end()) return iter->second;
+
+    Bool_t addStatus = TH1::AddDirectoryStatus();
+    if (detached_) TH1::AddDirectory(kFALSE);
+    TH1F* currentHisto = new TH1F(title.c_str(), title.c_str(), numbinsx, xmin, xmax);
+    TH1::AddDirectory(addStatus);
+    currentHisto->Sumw2();
+    allhistos_.insert(std::pair<string, TH1F*>(title, currentHisto));
+    return currentHisto;
+}
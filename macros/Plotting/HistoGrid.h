@@ -0,0 +1,92 @@
+#ifndef HISTOGRID_H
+#define HISTOGRID_H
+
+#include "TH1F.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//
+// Pre-registered histograms addressed by integer handles.
+//
+// A grid is the product of a set of variables (name + binning) and up to
+// MAXAXES axes of name segments (selection tags, njets / K-factor bins,
+// flavours, ...).  The histogram for variable v and axis indices
+// (i0, i1, ...) is called  name(v) + tag(0, i0) + tag(1, i1) + ...,
+// exactly what plot1D would be given for the concatenated string.
+//
+// Declare the axes and variables up front, compute the cell index once
+// per event with cell(), then fill() only does an array lookup: no string
+// is built and no map is searched in the event loop.  Histograms are still
+// created on their first fill and inserted in the std::map passed to the
+// constructor, so the map (and therefore the output file written from it)
+// holds the same histograms as with plot1D.
+//
+// A variable added without a binning is booked with the one given to its
+// first fill, as with plot1D.  Variables switched off with disable() are
+// never booked or filled.  A detached grid books its histograms outside of
+// any directory (gDirectory may be an input file); the map owns them.
+//
+class HistoGrid {
+
+public:
+    static const int MAXAXES = 6;
+
+    HistoGrid(std::map<string, TH1F*>& allhistos, bool detached = false);
+
+    // comma separated name segments, e.g. ",_K3,_K4"; returns the axis number
+    int addAxis(const string& tags);
+    // returns the variable handle, counting from 0
+    int addVariable(const string& name, int numbinsx, float xmin, float xmax);
+    // binning given by the fills
+    int addVariable(const string& name);
+    void disable(int var) { variables_[var].disabled = true; }
+
+    int cell(int i0, int i1 = 0, int i2 = 0, int i3 = 0, int i4 = 0, int i5 = 0) const;
+
+    void fill(int var, int cell, float xval, double weight) {
+        TH1F*& h = histos_[var * ncells_ + cell];
+        if (!h) h = book(var, cell);
+        if (h) h->Fill(xval, weight);
+    }
+
+    void fill(int var, int cell, float xval, double weight, int numbinsx, float xmin, float xmax) {
+        TH1F* h = get(var, cell, numbinsx, xmin, xmax);
+        if (h) h->Fill(xval, weight);
+    }
+
+    // the histogram, booked if needed; 0 if the variable is disabled
+    TH1F* get(int var, int cell, int numbinsx, float xmin, float xmax) {
+        TH1F*& h = histos_[var * ncells_ + cell];
+        if (!h) h = book(var, cell, numbinsx, xmin, xmax);
+        return h;
+    }
+
+    string name(int var, int cell) const;
+
+private:
+    TH1F* book(int var, int cell);
+    TH1F* book(int var, int cell, int numbinsx, float xmin, float xmax);
+    void resize();
+
+    struct Variable {
+        string name;
+        int numbinsx;
+        float xmin, xmax;
+        bool disabled;
+    };
+
+    std::map<string, TH1F*>& allhistos_;
+    vector< vector<string> > axes_;
+    vector<Variable> variables_;
+    vector<int> strides_;
+    int ncells_;
+    bool detached_;
+    bool booked_;
+    vector<TH1F*> histos_;
+};
+
+#endif
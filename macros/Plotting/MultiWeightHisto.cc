@@ -0,0 +1,97 @@
+#include "MultiWeightHisto.h"
+
+#include <cassert>
+#include <cmath>
+
+MultiWeightHisto::MultiWeightHisto(const string& name, int numbinsx, double xmin, double xmax,
+                                   const vector<string>& suffixes, bool underOverFlow)
+    : name_(name), numbinsx_(numbinsx), xmin_(xmin), xmax_(xmax),
+      suffixes_(suffixes), underOverFlow_(underOverFlow),
+      sumw_((numbinsx + 2) * suffixes.size(), 0.),
+      sumw2_((numbinsx + 2) * suffixes.size(), 0.),
+      entries_(0.)
+{
+    assert(numbinsx > 0 && xmax > xmin);
+    assert(!suffixes.empty());
+}
+
+int MultiWeightHisto::findBin(double xval) const
+{
+    // same as TAxis::FindFixBin
+    if (xval < xmin_) return 0;
+    if (!(xval < xmax_)) return numbinsx_ + 1;
+    return 1 + int(numbinsx_ * (xval - xmin_) / (xmax_ - xmin_));
+}
+
+void MultiWeightHisto::fill(double xval, const double* weights)
+{
+    if (underOverFlow_) {
+        // same as plot1DUnderOverFlow
+        if (xval >= xmax_) xval = xmax_ - (xmax_ - xmin_) / double(numbinsx_) / 1000.;
+        if (xval <= xmin_) xval = xmin_ + (xmax_ - xmin_) / double(numbinsx_) / 1000.;
+    }
+
+    unsigned int nvar = suffixes_.size();
+    unsigned int offset = findBin(xval) * nvar;
+    double* w = &sumw_[offset];
+    double* w2 = &sumw2_[offset];
+    for (unsigned int v = 0; v < nvar; ++v) {
+        w[v] += weights[v];
+        w2[v] += weights[v] * weights[v];
+    }
+    entries_ += 1.;
+}
+
+void MultiWeightHisto::fill(double xval, const vector<double>& weights)
+{
+    assert(weights.size() == suffixes_.size());
+    fill(xval, &weights[0]);
+}
+
+TH1D* MultiWeightHisto::makeHist(int variation) const
+{
+    string title = name_ + suffixes_[variation];
+    TH1D* h = new TH1D(title.c_str(), title.c_str(), numbinsx_, xmin_, xmax_);
+    h->Sumw2();
+
+    unsigned int nvar = suffixes_.size();
+    for (int bin = 0; bin <= numbinsx_ + 1; ++bin) {
+        h->SetBinContent(bin, sumw_[bin * nvar + variation]);
+        h->SetBinError(bin, sqrt(sumw2_[bin * nvar + variation]));
+    }
+    h->ResetStats();
+    h->SetEntries(entries_);
+    return h;
+}
+
+void MultiWeightHisto::write() const
+{
+    for (int v = 0; v < nVariations(); ++v) {
+        TH1D* h = makeHist(v);
+        h->Write();
+        delete h;
+    }
+}
+
+//--------------------------------------------------------------------
+
+void plot1DMultiWeight(string title, double xval, const vector<double>& weights,
+                       std::map<string, MultiWeightHisto*>& allhistos, const vector<string>& suffixes,
+                       int numbinsx, double xmin, double xmax)
+{
+    std::map<string, MultiWeightHisto*>::iterator iter = allhistos.find(title);
+    if (iter == allhistos.end()) //no histo for this yet, so make a new one
+        iter = allhistos.insert(std::pair<string, MultiWeightHisto*>(title,
+                   new MultiWeightHisto(title, numbinsx, xmin, xmax, suffixes, true))).first;
+    iter->second->fill(xval, weights);
+}
+
+void saveMultiWeightHistos(std::map<string, MultiWeightHisto*>& allhistos)
+{
+    std::map<string, MultiWeightHisto*>::iterator it;
+    for (it = allhistos.begin(); it != allhistos.end(); it++) {
+        it->second->write();
+        delete it->second;
+    }
+    allhistos.clear();
+}
@@ -0,0 +1,65 @@
+#ifndef MULTIWEIGHTHISTO_H
+#define MULTIWEIGHTHISTO_H
+
+#include "TH1D.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//
+// One variable filled with a whole vector of event weights at once.
+//
+// Each variation (nominal, PU up/down, PDF members, ...) gets its own sum of
+// weights and sum of weights squared per bin.  The bin is found once per
+// fill and the variations of a bin are stored next to each other, so a fill
+// is one bin lookup and a contiguous loop over the weights.
+//
+// write() makes a standard TH1D per variation, called name + suffix, with
+// the bin contents and Sumw2 errors that filling a TH1D directly would have
+// given.  The first suffix is normally "" for the nominal weight.
+//
+class MultiWeightHisto {
+
+public:
+    MultiWeightHisto(const string& name, int numbinsx, double xmin, double xmax,
+                     const vector<string>& suffixes, bool underOverFlow = false);
+
+    // one weight per variation, in the order of the suffixes
+    void fill(double xval, const double* weights);
+    void fill(double xval, const vector<double>& weights);
+
+    int nVariations() const { return suffixes_.size(); }
+    const string& name() const { return name_; }
+
+    // caller owns the histogram
+    TH1D* makeHist(int variation) const;
+    // writes all variations to the current directory
+    void write() const;
+
+private:
+    int findBin(double xval) const;
+
+    string name_;
+    int numbinsx_;
+    double xmin_, xmax_;
+    vector<string> suffixes_;
+    bool underOverFlow_;
+
+    // [bin][variation], bins 0 and numbinsx+1 are under- and overflow
+    vector<double> sumw_;
+    vector<double> sumw2_;
+    double entries_;
+};
+
+// like plot1DUnderOverFlow, with a weight per variation
+void plot1DMultiWeight(string title, double xval, const vector<double>& weights,
+                       std::map<string, MultiWeightHisto*>& allhistos, const vector<string>& suffixes,
+                       int numbinsx, double xmin, double xmax);
+
+// writes every variation to the current directory and deletes the histograms
+void saveMultiWeightHistos(std::map<string, MultiWeightHisto*>& allhistos);
+
+#endif
@@ -0,0 +1,2504 @@
+#ifndef OLDCUTFLOWS_H
+#define OLDCUTFLOWS_H
+
+// The hand-written cut flows and output dirs of WHLooper::loop before the
+//  regions went through RegionSelector, for regionCheck.cc.  Copied as they
+//  were, except that each fillHists1DWrapper(h_1d_X,w,"X") is now fill("X",w)
+//  and the lines that only computed plotting variables (pseudo met, MT2
+//  recalculation, dumpEventInfo, fillHists2D) are dropped.
+
+static void oldCutFlows() {
+
+      if ( doInclusive
+	   && passSingleLeptonSelection(isData) 
+	   && (njets_ >= 2)
+	   && (met_ > CUT_MET_PRESEL_) ) {
+
+        fill("inc_presel",evtweight1l);
+
+	if ( (njetsall_ == 2) ) {
+	  fill("inc_2j",evtweight1l);
+	}
+
+	if (doInclusiveMTTail) {
+	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) ) {
+	    fill("inc_2j_mt",evtweight1l);
+	  }
+
+	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) && (met_ > 100.) ) {
+	    fill("inc_2j_mt_met100",evtweight1l);
+	  }
+
+	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) && (met_ > 150.) ) {
+	    fill("inc_2j_mt_met150",evtweight1l);
+	  }
+
+	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) && (met_ > CUT_MET_) ) {
+	    fill("inc_2j_mt_metcut",evtweight1l);
+	  }
+	}
+
+	bool fail = false;
+	if ( !fail && (nbjets_ >= 1) ) {
+	  fill("inc_1b",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (nbjets_ >= 2 ) ) {
+	  fill("inc_2b",evtweight1l);
+	}
+	else fail = true;
+      }
+
+      // -------------------------------------------
+      // *** presel for signal region:
+      //   == 1 lepton, iso track veto
+      //   >= 2 bjets
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      // *** signal region:
+      //   == 1 lepton, iso track veto
+      //   == 2 jets, all eta
+      //   == 2 bjets
+      //   100 < m(bb) < 150
+      //   met > 175 (cut at 50 for presel)
+      //   mt > 100
+      //   mt2bl > 200
+
+      if ( doSignal
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) 
+	   && (!isData || !blindSignal) ) {
+
+        fill("sig_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("sig_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak before cutting on met
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("sig_mtpeak_nomet",evtweight1l);
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("sig_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak after cutting on met
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("sig_mtpeak_met",evtweight1l);
+	}
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("sig_final",evtweight1l);
+	}
+
+      } // signal region sel
+
+      // -------------------------------------------
+      // *** signal region, but applying m(bb) cut last
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 2 bjets
+      //   met > 50
+
+      if ( doSignalMassLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+	   //	   && (!isData || !blindSignal) ) {
+
+	// for data: remove mass window, so we can compare bb mass shape outside signal region as cuts are applied
+	bool fail = false;
+	if (isData && blindSignal && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_CR1_LOW_) ) fail = true;
+
+        if (!fail) fill("sig_bbmasslast_presel",evtweight1l);
+
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("sig_bbmasslast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak before cutting on met/mt/mt2bl
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("sig_bbmasslast_mtpeak",evtweight1l);
+	}
+
+	// plots for bbmass after each of the major cuts done separately
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_bbmasslast_mtcut",evtweight1l);
+	  if (!fail && (met_ > 100.) ) {
+	    if (doNM1Plots) fill("sig_bbmasslast_mtcut_met100",evtweight1l);
+	  }
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("sig_bbmasslast_metcut",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("sig_bbmasslast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (doMetBinRegions) {
+
+	  if (!fail && (met_ > 50.) && (met_ <= 75.) ) {
+	    fill("sig_bbmasslast_nomt_met50",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 75.) && (met_ <= 100.) ) {
+	    fill("sig_bbmasslast_nomt_met75",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 100.) && (met_ <= 125.) ) {
+	    fill("sig_bbmasslast_nomt_met100",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 125.) && (met_ <= 150.) ) {
+	    fill("sig_bbmasslast_nomt_met125",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 137.) ) {
+	    fill("sig_bbmasslast_nomt_met137",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 150.) && (met_ <= 175.) ) {
+	    fill("sig_bbmasslast_nomt_met150",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 162.) ) {
+	    fill("sig_bbmasslast_nomt_met162",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 175.) ) {
+	    fill("sig_bbmasslast_nomt_met175",evtweight1l);
+	  }
+	}
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_bbmasslast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  fill("sig_bbmasslast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  fill("sig_bbmasslast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  fill("sig_bbmasslast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("sig_bbmasslast_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  fill("sig_bbmasslast_final",evtweight1l);
+	}
+
+      } // signal region sel (bbmass last)
+
+      // -------------------------------------------
+      // *** signal region, but applying met cut last
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 2 bjets
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      if ( doSignalMETLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) 
+	   && (!isData || !blindSignal) ) {
+
+        fill("sig_metlast_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("sig_metlast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_metlast_mtfirst",evtweight1l);
+	}
+
+	if (doMetBinRegions) {
+
+	  if (!fail && (met_ > 100.) ) {
+	    if (doNM1Plots) fill("sig_metlast_nomt_met100",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 150.) ) {
+	    if (doNM1Plots) fill("sig_metlast_nomt_met150",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 175.) ) {
+	    if (doNM1Plots) fill("sig_metlast_nomt_met175",evtweight1l);
+	  }
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("sig_metlast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_metlast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("sig_metlast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	//	if (!fail) dumpEventInfo("signal region event");
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("sig_metlast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("sig_metlast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("sig_metlast_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // signal region sel, met last
+
+      // -------------------------------------------
+      // *** signal region, 2 loose btags
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 2 loose bjets
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      if ( doSignal2Loose
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjetsl_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) 
+	   && (!isData || !blindSignal) ) {
+
+        fill("sig_2loose_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("sig_2loose_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("sig_2loose_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_2loose_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("sig_2loose_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("sig_2loose_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("sig_2loose_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // signal region sel, 2 loose btags
+
+      // -------------------------------------------
+      // *** signal region, 1 med btag
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 1 med btags
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      if ( doSignal1Med
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 1)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) 
+	   && (!isData || !blindSignal) ) {
+
+        fill("sig_1med_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("sig_1med_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("sig_1med_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_1med_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("sig_1med_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("sig_1med_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("sig_1med_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // signal region sel, 1 med btag
+
+      // -------------------------------------------
+      // *** signal region, 1 med 1 loose btag
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 1 med btags
+      //   >= 2 loose btags
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      if ( doSignal1Med1Loose
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 1)
+	   && (nbjetsl_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) 
+	   && (!isData || !blindSignal) ) {
+
+        fill("sig_1med1loose_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("sig_1med1loose_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("sig_1med1loose_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("sig_1med1loose_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("sig_1med1loose_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("sig_1med1loose_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("sig_1med1loose_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // signal region sel, 1 med 1loose btag
+
+      // -------------------------------------------
+      // *** signal region with SMWH cuts:
+      //   == 1 lepton, iso track veto
+      //   == 2 jets, all eta
+      //   == 2 bjets
+      //   100 < m(bb) < 150
+      //   met > 45
+      //   mt > 100
+      //   mt2bl > 200
+
+      if ( doSignalSMWH
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (nbjetst_ >= 1)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > 45.) 
+	   && (!isData || !blindSignal) ) {
+
+        fill("sigsmwh_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  //	  if (doNM1Plots) fill("sig_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bb_.pt() > 100.) ) {
+	  //	  if (doNM1Plots) fill("sig_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bbwdphi_ > 2.95) ) {
+	  //	  if (doNM1Plots) fill("sig_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (wpt_ > 180.) ) {
+	  //	  if (doNM1Plots) fill("sig_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (lepmetdphi_ < TMath::Pi()/2.) ) {
+	  fill("sigsmwh_final",evtweight1l);
+	}
+
+      } // signal region sel
+
+      // -------------------------------------------
+      // *** CR1: 150 < m(bb) < 250 
+      //  otherwise same as signal region
+
+      if ( doCR1
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr1_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr1_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	//	if (!fail && isData && (met_ > 420.)) dumpEventInfo("CR1 high MET event");
+
+	// mt peak before cutting on met
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("cr1_mtpeak_nomet",evtweight1l);
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr1_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak after cutting on met
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("cr1_mtpeak_met",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr1_mtlast_mt2bl_nm1",evtweight1l);
+	}
+	// else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr1_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr1_final",evtweight1l);
+	}
+
+      } // CR1 region sel
+
+
+      // -------------------------------------------
+      // *** CR1, MET last: 150 < m(bb) < 250 
+      //  otherwise same as signal region
+
+      if ( doCR1METLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr1_metlast_presel",evtweight1l);
+
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr1_metlast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr1_metlast_mtfirst",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr1_metlast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr1_metlast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr1_metlast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr1_metlast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr1_metlast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr1_metlast_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR1 region sel
+
+
+      // -------------------------------------------
+      // *** CR2: 1 lepton + iso track, i.e. inverted iso track (or tau) veto, require exactly 1 lep
+      //   otherwise same as signal region
+
+      if ( doCR2
+	   && passLepPlusIsoTrkSelectionWHMet(isData)
+	   // && ( (passSingleLeptonSelection(isData) && !passisotrk)
+	   // // && passLepPlusIsoTrkSelection(isData) 
+	   // 	|| passLepPlusTauSelection(isData) )
+	   //	   && (stopt.ngoodlep() == 1) 
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr2_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr2_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  if (doNM1Plots) fill("cr2_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr2_mt2blfirst",evtweight1l);
+	}
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr2_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	//	if (!fail && isData && (met_ > 250. || mt2bl_ > 250.)) dumpEventInfo("CR2, high MET/MT2bl event");
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr2_mt2blcut",evtweight1l);
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr2_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr2_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR2 region sel
+
+
+      // -------------------------------------------
+      // *** CR3: 2 leptons, Z mass veto for same flavor, no iso track veto
+      //   otherwise same as signal region
+      //   !!! pesudo MET/MT etc defs to emulate losing 2nd lepton
+
+      if ( doCR3
+	   && passDileptonSelection(isData) 
+	   //	   && (abs(stopt.id1()) != abs(stopt.id2()) || fabs( stopt.dilmass() - 91.) > 15. )
+	   && (nbjets_ >= 2) ) {
+	//	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+
+	// tight 3rd track veto used by stop people -- necessary?
+	//	      if ( (stopt.trkpt10loose() <0.0001 || stopt.trkreliso10loose() > 0.1) 
+
+	//calculate pseudo met and mt
+	//find positive lepton - this is the one that is combined with the pseudomet to form the mT
+		
+	//recalculate met
+		
+	//recalculate the MET with the positive lepton
+		
+		
+	//recalculate the MT with the negative lepton
+	//dphi between met and lepton
+
+	// recalculate mt2 vars also..
+
+
+	bool fail = false;
+	//	if ( pseudomet_lep_ > CUT_MET_PRESEL_ ) {
+	if ( met_ > CUT_MET_PRESEL_ ) {
+          fill("cr3_presel",evtweight2l);
+	}
+	else fail = true;
+
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr3_bbmass_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	if ( !fail &&  (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  if (doNM1Plots) fill("cr3_mt_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr3_mt2blfirst",evtweight1l);
+	}
+
+	//	if (!fail && (pseudomt_lep_ > CUT_MT_) ) {
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr3_met_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr3_mt2blcut",evtweight2l);
+	}
+
+	//	if (!fail && (pseudomet_lep_ > CUT_MET_) ) {
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr3_mt2bl_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	//	if (!fail && isData && met_ > 270.) dumpEventInfo("CR3, high MET event");
+
+	//	if (!fail && (pseudomt2bl_ > CUT_MT2BL_) ) {
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr3_final",evtweight2l);
+	}
+	else fail = true;
+
+      } // CR3 region sel
+
+
+      // -------------------------------------------
+      // *** CR23: 1 lepton + iso track OR 2 lepton
+      //   otherwise same as signal region
+
+      if ( doCR23
+	   && ( passLepPlusIsoTrkSelectionWHMet(isData)
+	   //	   && ( ( passSingleLeptonSelection(isData) && !passisotrk && (stopt.ngoodlep() == 1) ) 
+	   // && passLepPlusIsoTrkSelection(isData) 
+		//		|| ( passLepPlusTauSelection(isData) && (stopt.ngoodlep() == 1) )
+		|| ( passDileptonSelection(isData) ) )
+		     //&& (abs(stopt.id1()) != abs(stopt.id2()) || fabs( stopt.dilmass() - 91.) > 15. ) ) )
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr23_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr23_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  if (doNM1Plots) fill("cr23_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr23_mt2blfirst",evtweight1l);
+	}
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr23_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr23_metcut",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr23_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr23_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr23_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr23_met150",evtweight1l);
+	}
+	else fail = true;
+
+	//	if (!fail && isData && (met_ > 250. || mt2bl_ > 250.)) dumpEventInfo("CR23, high MET/MT2bl event");
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr23_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR23 region sel
+
+
+      // -------------------------------------------
+      // *** CR23, mass last: 1 lepton + iso track OR 2 lepton
+      //   otherwise same as signal region
+
+      if ( doCR23MassLast
+	   && ( passLepPlusIsoTrkSelectionWHMet(isData)
+		|| ( passDileptonSelection(isData) ) )
+	   && (nbjets_ >= 2)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr23_bbmasslast_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr23_bbmasslast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  if (doNM1Plots) fill("cr23_bbmasslast_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR23 region sel
+
+
+      // -------------------------------------------
+      // *** CR4: 2 leptons, Z mass veto for same flavor, no iso track veto
+      //   high mass: 150 < m(bb) < 250
+      //   otherwise same as signal region
+      //   !!! modified MET/MT etc defs to emulate losing 2nd lepton
+
+      if ( doCR4
+	   && passDileptonSelection(isData) 
+	   && (abs(stopt.id1()) != abs(stopt.id2()) || fabs( stopt.dilmass() - 91.) > 15. )
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) ) {
+
+	// tight 3rd track veto used by stop people -- necessary?
+	//	      if ( (stopt.trkpt10loose() <0.0001 || stopt.trkreliso10loose() > 0.1) 
+
+	//calculate pseudo met and mt
+	//find positive lepton - this is the one that is combined with the pseudomet to form the mT
+		
+	//recalculate met
+		
+	//recalculate the MET with the positive lepton
+		
+		
+	//recalculate the MT with the negative lepton
+	//dphi between met and lepton
+
+	// recalculate mt2 vars also..
+
+
+	bool fail = false;
+	//	if ( pseudomet_lep_ > CUT_MET_PRESEL_ ) {
+	if ( met_ > CUT_MET_PRESEL_ ) {
+          fill("cr4_presel",evtweight2l);
+	}
+	else fail = true;
+
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr4_mt2bl_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	//	if (!fail && isData && met_ > 320.) dumpEventInfo("CR4, high MET event");
+
+	//	if (!fail && (pseudomt2bl_ > CUT_MT2BL_) ) {
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr4_met_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	//	if (!fail && (pseudomet_lep_ > CUT_MET_) ) {
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr4_mt_nm1",evtweight2l);
+	}
+	else fail = true;
+
+	//	if (!fail && (pseudomt_lep_ > CUT_MT_) ) {
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr4_final",evtweight2l);
+	}
+	else fail = true;
+
+      } // CR4 region sel
+
+
+      // -------------------------------------------
+      // *** CR5: require exactly 0 btags
+      //  otherwise same as signal
+
+      if ( doCR5
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr5_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr5_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if ( !fail && ((bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)) ) {
+	  if (doNM1Plots) fill("cr5_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr5_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr5_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr5_final",evtweight1l);
+	}
+
+      } // CR5 region sel
+
+      // -------------------------------------------
+      // *** CR5 loose: require exactly 0 btags
+      //  no jet veto, no MT2bl, then MET > 500
+
+      if ( doCR5Loose
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr5_loose_presel",evtweight1l);
+
+	bool fail = false;
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_loose_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 500.) ) {
+	  fill("cr5_loose_final",evtweight1l);
+	}
+
+      } // CR5 loose region sel
+
+      // -------------------------------------------
+      // *** CR5, met last: require exactly 0 btags
+      //  otherwise same as signal
+
+      if ( doCR5METLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr5_metlast_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr5_metlast_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if ( !fail && ((bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)) ) {
+	  if (doNM1Plots) fill("cr5_metlast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_metlast_mtfirst",evtweight1l);
+	}
+
+	if (doMetBinRegions) {
+	  if (!fail && (met_ > 100.) ) {
+	    if (doNM1Plots) fill("cr5_metlast_nomt_met100",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 150.) ) {
+	    if (doNM1Plots) fill("cr5_metlast_nomt_met150",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 175.) ) {
+	    if (doNM1Plots) fill("cr5_metlast_nomt_met175",evtweight1l);
+	  }
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr5_metlast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_metlast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	//	if (isData && !fail && (met_ > 500.)) dumpEventInfo("cr5 high met event");
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr5_metlast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr5_metlast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr5_metlast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr5_metlast_final",evtweight1l);
+	}
+
+      } // CR5 region sel
+
+      // -------------------------------------------
+      // *** CR5, inverted mass: require exactly 0 btags
+      //  otherwise same as signal
+
+      if ( doCR5InvMass
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr5_invmass_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr5_invmass_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if ( !fail && ((bb_.M() < CUT_BBMASS_LOW_) || (bb_.M() > CUT_BBMASS_HIGH_)) ) {
+	  if (doNM1Plots) fill("cr5_invmass_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_invmass_mtfirst",evtweight1l);
+	}
+
+	if (doMetBinRegions) {
+	  if (!fail && (met_ > 100.) ) {
+	    if (doNM1Plots) fill("cr5_invmass_nomt_met100",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 150.) ) {
+	    if (doNM1Plots) fill("cr5_invmass_nomt_met150",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 175.) ) {
+	    if (doNM1Plots) fill("cr5_invmass_nomt_met175",evtweight1l);
+	  }
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr5_invmass_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_invmass_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	//	if (isData && !fail && (met_ > 500.)) dumpEventInfo("cr5 high met event");
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr5_invmass_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr5_invmass_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr5_invmass_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr5_invmass_final",evtweight1l);
+	}
+
+      } // CR5 region sel
+
+      // -------------------------------------------
+      // *** CR5, high mass, met last: require exactly 0 btags
+      //  otherwise same as signal
+
+      if ( doCR5HighMass
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr5_highmass_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr5_highmass_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_highmass_mtfirst",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr5_highmass_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_highmass_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr5_highmass_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr5_highmass_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr5_highmass_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr5_highmass_final",evtweight1l);
+	}
+
+      } // CR5 region sel
+
+
+      // -------------------------------------------
+      // *** CR5, low mass, met last: require exactly 0 btags
+      //  otherwise same as signal
+
+      if ( doCR5LowMass
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr5_lowmass_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_mtfirst",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr5_lowmass_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr5_lowmass_final",evtweight1l);
+	}
+
+      } // CR5 region sel
+
+      // -------------------------------------------
+      // *** CR5 (bveto), but applying m(bb) cut last
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   == 0 bjets
+      //   met > 50
+
+      if ( doCR5MassLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+	bool fail = false;
+        if (!fail) fill("cr5_bbmasslast_presel",evtweight1l);
+
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr5_bbmasslast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak before cutting on met/mt/mt2bl
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("cr5_bbmasslast_mtpeak",evtweight1l);
+	}
+
+	// plots for bbmass after each of the major cuts done separately
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_bbmasslast_mtcut",evtweight1l);
+	  if (!fail && (met_ > 100.) ) {
+	    if (doNM1Plots) fill("cr5_bbmasslast_mtcut_met100",evtweight1l);
+	  }
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr5_bbmasslast_metcut",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr5_bbmasslast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (doMetBinRegions) {
+
+	  if (!fail && (met_ > 50.) && (met_ <= 75.) ) {
+	    fill("cr5_bbmasslast_nomt_met50",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 75.) && (met_ <= 100.) ) {
+	    fill("cr5_bbmasslast_nomt_met75",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 100.) && (met_ <= 125.) ) {
+	    fill("cr5_bbmasslast_nomt_met100",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 125.) && (met_ <= 150.) ) {
+	    fill("cr5_bbmasslast_nomt_met125",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 137.) ) {
+	    fill("cr5_bbmasslast_nomt_met137",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 150.) && (met_ <= 175.) ) {
+	    fill("cr5_bbmasslast_nomt_met150",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 162.) ) {
+	    fill("cr5_bbmasslast_nomt_met162",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 175.) ) {
+	    fill("cr5_bbmasslast_nomt_met175",evtweight1l);
+	  }
+	}
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr5_bbmasslast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  fill("cr5_bbmasslast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  fill("cr5_bbmasslast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  fill("cr5_bbmasslast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 500.) ) {
+	  fill("cr5_bbmasslast_met500",evtweight1l);
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr5_bbmasslast_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  fill("cr5_bbmasslast_final",evtweight1l);
+	}
+
+      } // CR5 sel (bbmass last)
+
+      // -------------------------------------------
+      // *** CR6: require exactly 1 btag
+      //  veto on 2nd loose btag
+      //  otherwise same as signal
+
+      if ( doCR6
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 1)
+	   && (nbjetsl_ == 1)
+	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) ) {
+
+	// compute MT2 vars for 1 b events passing this presel
+
+        fill("cr6_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr6_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr6_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr6_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr6_final",evtweight1l);
+	}
+
+      } // CR6 region sel
+
+
+      // -------------------------------------------
+      // *** CR6, met last: require exactly 1 btag
+      //  veto on 2nd loose btag
+      //  otherwise same as signal
+
+      if ( doCR6METLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 1)
+	   && (nbjetsl_ == 1)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr6_metlast_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr6_metlast_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if ( !fail && ((bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)) ) {
+	  if (doNM1Plots) fill("cr6_metlast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr6_metlast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr6_metlast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr6_metlast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr6_metlast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr6_metlast_final",evtweight1l);
+	}
+
+      } // CR6 region sel
+
+
+      // -------------------------------------------
+      // *** CR7: 150 < m(bb) < 250, exactly 3 jets
+      //  otherwise same as signal region
+
+      if ( doCR7
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr7_presel",evtweight1l);
+
+	bool fail = false;
+	//	if ( !fail && (njetsall_ == 3) && (nbjets_ == 2) ) {
+	if ( !fail && (njetsall_ == 3) ) {
+	  if (doNM1Plots) fill("cr7_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr7_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr7_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr7_final",evtweight1l);
+	}
+
+      } // CR7 region sel
+
+
+      // -------------------------------------------
+      // *** CR8: 50 < m(bb) < 100 
+      //  otherwise same as signal region
+
+      if ( doCR8
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_CR8_LOW_) && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr8_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr8_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr8_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr8_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr8_final",evtweight1l);
+	}
+
+      } // CR8 region sel
+
+
+      // -------------------------------------------
+      // *** CR8, MET last: 50 < m(bb) < 100 
+      //  otherwise same as signal region
+
+      if ( doCR8METLast
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_CR8_LOW_) && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
+	   && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr8_metlast_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr8_metlast_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr8_metlast_mtfirst",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr8_metlast_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr8_metlast_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr8_metlast_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr8_metlast_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr8_metlast_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr8_metlast_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR8 region sel
+
+
+      // -------------------------------------------
+      // *** CR idea: signal mass window, at least 3 jets, then exactly 3 jets
+      //  otherwise same as signal region
+      //  !! need to check to make sure signal contribution isn't too large..
+      //  -- after final selection, bg ~3, sig ~2 => don't use this region!
+
+
+      // -------------------------------------------
+      // *** CR9: 150 < m(bb) < 200 
+      //  otherwise same as signal region
+      //  to study met shape disagreement in CR1
+
+      if ( doCR9
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < 200.) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr9_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr9_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak before cutting on met
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("cr9_mtpeak_nomet",evtweight1l);
+	}
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr9_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	// mt peak after cutting on met
+	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
+	  if (doNM1Plots) fill("cr9_mtpeak_met",evtweight1l);
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr9_mtlast_mt2bl_nm1",evtweight1l);
+	}
+	// else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr9_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr9_final",evtweight1l);
+	}
+
+      } // CR9 region sel
+
+
+      // -------------------------------------------
+      // *** CR10: 200 < m(bb) < 250 
+      //  otherwise same as signal region
+      //  to study met shape disagreement in CR1
+
+      if ( doCR10
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && (bb_.M() > 200.) && (bb_.M() < 250.) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr10_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr10_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr10_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr10_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr10_final",evtweight1l);
+	}
+
+      } // CR10 region sel
+
+
+      // -------------------------------------------
+      // *** CR11: require exactly 0 btags, 150 < m(bb) < 250
+      //  otherwise same as signal
+
+      if ( doCR11
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ == 0)
+	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+	// compute MT2 vars for 0 b events passing this presel
+
+        fill("cr11_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr11_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr11_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr11_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr11_final",evtweight1l);
+	}
+
+      } // CR11 region sel
+
+      // -------------------------------------------
+      // *** CR12: 150 < m(bb) < 250, at least 4 jets
+      //  otherwise same as signal region
+
+      if ( doCR12
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (njetsall_ >= 4)
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr12_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) ) {
+	  if (doNM1Plots) fill("cr12_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr12_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  if (doNM1Plots) fill("cr12_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  fill("cr12_final",evtweight1l);
+	}
+
+      } // CR12 region sel
+
+
+      // -------------------------------------------
+      // *** CR13: MT peak region
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 2 bjets
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      if ( doCR13
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_CR13_LOW_) && (mt_ <= CUT_MT_CR13_HIGH_) ) {
+
+        fill("cr13_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr13_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if ( !fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  if (doNM1Plots) fill("cr13_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr13_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr13_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr13_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr13_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR13 region sel
+
+
+      // -------------------------------------------
+      // *** CR13: MT peak region, inverted mbb
+      //  - presel:
+      //   == 1 lepton, iso track veto
+      //   >= 2 bjets
+      //   100 < m(bb) < 150
+      //   met > 50
+
+      if ( doCR13
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_CR13_LOW_) && (mt_ <= CUT_MT_CR13_HIGH_) ) {
+
+        fill("cr13_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr13_bbmass_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if ( !fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
+	  if (doNM1Plots) fill("cr13_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr13_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr13_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr13_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  fill("cr13_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR13 region sel
+
+
+      // -------------------------------------------
+      // *** CR14: inverted m(bb) cut
+      //  otherwise same as signal region
+
+      if ( doCR14
+	   && passSingleLeptonSelection(isData) 
+	   && passisotrk 
+	   && (nbjets_ >= 2)
+	   && ((bb_.M() < CUT_BBMASS_LOW_) || (bb_.M() > CUT_BBMASS_HIGH_)) 
+	   && (met_ > CUT_MET_PRESEL_) 
+	   && (mt_ > CUT_MT_PRESEL_) ) {
+
+        fill("cr14_presel",evtweight1l);
+
+	bool fail = false;
+	if ( !fail && (njetsall_ == 2) ) {
+	  if (doNM1Plots) fill("cr14_mt2bl_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr14_mtfirst",evtweight1l);
+	}
+
+	if (doMetBinRegions) {
+
+	  if (!fail && (met_ > 100.) ) {
+	    if (doNM1Plots) fill("cr14_nomt_met100",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 150.) ) {
+	    if (doNM1Plots) fill("cr14_nomt_met150",evtweight1l);
+	  }
+
+	  if (!fail && (met_ > 175.) ) {
+	    if (doNM1Plots) fill("cr14_nomt_met175",evtweight1l);
+	  }
+	}
+
+	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
+	  if (doNM1Plots) fill("cr14_mt_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (mt_ > CUT_MT_) ) {
+	  fill("cr14_met_nm1",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 100.) ) {
+	  if (doNM1Plots) fill("cr14_met100",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 125.) ) {
+	  if (doNM1Plots) fill("cr14_met125",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > 150.) ) {
+	  if (doNM1Plots) fill("cr14_met150",evtweight1l);
+	}
+	else fail = true;
+
+	if (!fail && (met_ > CUT_MET_) ) {
+	  if (doNM1Plots) fill("cr14_final",evtweight1l);
+	}
+	else fail = true;
+
+      } // CR14 region sel
+
+
+      // -------------------------------------------
+      // *** Stop Presel region
+      //   >= 1 lepton
+      //   >= 4 jets
+      //   blind data (includes stop signal region)
+
+      // *** Stop Presel comparison region
+      //   >= 1 lepton
+      //   iso track veto v4
+      //   >= 4 jets
+      //   >= 1 bjet
+      //   met > 150
+      //   mt > 120
+      //   tau veto
+      //   blind data (includes stop signal region)
+
+      if ( doStopSel
+	   && passSingleLeptonSelection(isData) 
+	   && (njets_ >= 4)
+	   && !isData ) {
+
+	float weight = evtweight_novtxweight;
+	//	float weight = evtweight1l;
+
+        fill("stop_presel",weight);
+
+	bool fail = false;
+	if ( !fail && (nbjets_ >= 1) ) {
+	  fill("stop_met_nm1",weight);
+	} 
+	else fail = true;
+
+	if ( !fail && (met_ >= 150.) ) {
+	  fill("stop_mt_nm1",weight);
+	} 
+	else fail = true;
+
+	if ( !fail && (mt_ > 120.) ) {
+	  fill("stop_isotrk_nm1",weight);
+	} 
+	else fail = true;
+
+	if ( !fail && passIsoTrkVeto_v4() ) {
+	  fill("stop_tauveto_nm1",weight);
+	} 
+	else fail = true;
+
+	if ( !fail && passTauVeto() ) {
+	  fill("stop_comp",weight);
+	} 
+	else fail = true;
+
+      } // stop region sel
+
+}
+
+static void oldDirs() {
+
+  if (doInclusive) {
+    dir("inc_presel");
+    dir("inc_2j");
+    if (doInclusiveMTTail) {
+      dir("inc_2j_mt");
+      dir("inc_2j_mt_met100");
+      dir("inc_2j_mt_met150");
+      dir("inc_2j_mt_metcut");
+    }
+    dir("inc_1b");
+    dir("inc_2b");
+  }
+
+  if (doSignal) {
+    dir("sig_presel");
+    if (doNM1Plots) {
+      dir("sig_met_nm1");
+      dir("sig_mtpeak_nomet");
+      dir("sig_mt_nm1");
+      dir("sig_mtpeak_met");
+      dir("sig_mt2bl_nm1");
+    }
+    dir("sig_final");
+  }
+
+  if (doSignalMassLast) {
+    dir("sig_bbmasslast_presel");
+    if (doNM1Plots) {
+      dir("sig_bbmasslast_mt2bl_nm1");
+      dir("sig_bbmasslast_mtpeak");
+      dir("sig_bbmasslast_mtcut");
+      dir("sig_bbmasslast_mtcut_met100");
+      dir("sig_bbmasslast_metcut");
+      dir("sig_bbmasslast_mt_nm1");
+      if (doMetBinRegions) {
+	dir("sig_bbmasslast_nomt_met50");
+	dir("sig_bbmasslast_nomt_met75");
+	dir("sig_bbmasslast_nomt_met100");
+	dir("sig_bbmasslast_nomt_met125");
+	dir("sig_bbmasslast_nomt_met137");
+	dir("sig_bbmasslast_nomt_met150");
+	dir("sig_bbmasslast_nomt_met162");
+	dir("sig_bbmasslast_nomt_met175");
+      }
+      dir("sig_bbmasslast_met_nm1");
+      dir("sig_bbmasslast_met100");
+      dir("sig_bbmasslast_met125");
+      dir("sig_bbmasslast_met150");
+      dir("sig_bbmasslast_bbmass_nm1");
+    }
+    dir("sig_bbmasslast_final");
+  }
+
+  if (doSignalMETLast) {
+    dir("sig_metlast_presel");
+    if (doNM1Plots) {
+      dir("sig_metlast_mt2bl_nm1");
+      dir("sig_metlast_mtfirst");
+      if (doMetBinRegions) {
+	dir("sig_metlast_nomt_met100");
+	dir("sig_metlast_nomt_met150");
+	dir("sig_metlast_nomt_met175");
+      }
+      dir("sig_metlast_mt_nm1");
+      dir("sig_metlast_met_nm1");
+      dir("sig_metlast_met100");
+      dir("sig_metlast_met125");
+      dir("sig_metlast_met150");
+    }
+    dir("sig_metlast_final");
+  }
+
+  if (doSignal2Loose) {
+    dir("sig_2loose_presel");
+    if (doNM1Plots) {
+      dir("sig_2loose_mt2bl_nm1");
+      dir("sig_2loose_mt_nm1");
+      dir("sig_2loose_met_nm1");
+      dir("sig_2loose_met100");
+      dir("sig_2loose_met150");
+    }
+    dir("sig_2loose_final");
+  }
+
+  if (doSignal1Med) {
+    dir("sig_1med_presel");
+    if (doNM1Plots) {
+      dir("sig_1med_mt2bl_nm1");
+      dir("sig_1med_mt_nm1");
+      dir("sig_1med_met_nm1");
+      dir("sig_1med_met100");
+      dir("sig_1med_met150");
+    }
+    dir("sig_1med_final");
+  }
+
+  if (doSignal1Med1Loose) {
+    dir("sig_1med1loose_presel");
+    if (doNM1Plots) {
+      dir("sig_1med1loose_mt2bl_nm1");
+      dir("sig_1med1loose_mt_nm1");
+      dir("sig_1med1loose_met_nm1");
+      dir("sig_1med1loose_met100");
+      dir("sig_1med1loose_met150");
+    }
+    dir("sig_1med1loose_final");
+  }
+
+  if (doSignalSMWH) {
+    dir("sigsmwh_presel");
+    // if (doNM1Plots) {
+    //   dir("sig_met_nm1");
+    //   dir("sig_mtpeak_nomet");
+    //   dir("sig_mt_nm1");
+    //   dir("sig_mtpeak_met");
+    //   dir("sig_mt2bl_nm1");
+    // }
+    dir("sigsmwh_final");
+  }
+
+  if (doCR1) {
+    dir("cr1_presel");
+    if (doNM1Plots) {
+      dir("cr1_met_nm1");
+      dir("cr1_mtpeak_nomet");
+      dir("cr1_mt_nm1");
+      dir("cr1_mtpeak_met");
+      dir("cr1_mt2bl_nm1");
+      dir("cr1_mtlast_mt2bl_nm1");
+    }
+    dir("cr1_final");
+  }
+
+  if (doCR1METLast) {
+    dir("cr1_metlast_presel");
+    if (doNM1Plots) {
+      dir("cr1_metlast_mt2bl_nm1");
+      dir("cr1_metlast_mtfirst");
+      dir("cr1_metlast_mt_nm1");
+      dir("cr1_metlast_met_nm1");
+      dir("cr1_metlast_met100");
+      dir("cr1_metlast_met125");
+      dir("cr1_metlast_met150");
+    }
+    dir("cr1_metlast_final");
+  }
+
+  if (doCR2) {
+    dir("cr2_presel");
+    if (doNM1Plots) {
+      dir("cr2_bbmass_nm1");
+      dir("cr2_mt_nm1");
+      dir("cr2_mt2blfirst");
+      dir("cr2_met_nm1");
+      dir("cr2_mt2blcut");
+      dir("cr2_mt2bl_nm1");
+    }
+    dir("cr2_final");
+  }
+
+  if (doCR3) {
+    dir("cr3_presel");
+    if (doNM1Plots) {
+      dir("cr3_bbmass_nm1");
+      dir("cr3_mt_nm1");
+      dir("cr3_mt2blfirst");
+      dir("cr3_met_nm1");
+      dir("cr3_mt2blcut");
+      dir("cr3_mt2bl_nm1");
+    }
+    dir("cr3_final");
+  }
+
+  if (doCR23) {
+    dir("cr23_presel");
+    if (doNM1Plots) {
+      dir("cr23_bbmass_nm1");
+      dir("cr23_mt_nm1");
+      dir("cr23_mt2blfirst");
+      dir("cr23_mt2bl_nm1");
+      dir("cr23_metcut");
+      dir("cr23_met_nm1");
+      dir("cr23_met100");
+      dir("cr23_met125");
+      dir("cr23_met150");
+    }
+    dir("cr23_final");
+  }
+
+  if (doCR23MassLast) {
+    dir("cr23_bbmasslast_presel");
+    if (doNM1Plots) {
+      dir("cr23_bbmasslast_mt_nm1");
+      dir("cr23_bbmasslast_mt2bl_nm1");
+      dir("cr23_bbmasslast_met_nm1");
+      dir("cr23_bbmasslast_met100");
+      dir("cr23_bbmasslast_met125");
+      dir("cr23_bbmasslast_met150");
+      dir("cr23_bbmasslast_bbmass_nm1");
+    }
+    dir("cr23_bbmasslast_final");
+  }
+
+  if (doCR4) {
+    dir("cr4_presel");
+    if (doNM1Plots) {
+      dir("cr4_mt2bl_nm1");
+      dir("cr4_met_nm1");
+      dir("cr4_mt_nm1");
+    }
+    dir("cr4_final");
+  }
+
+  if (doCR5) {
+    dir("cr5_presel");
+    if (doNM1Plots) {
+      dir("cr5_bbmass_nm1");
+      dir("cr5_met_nm1");
+      dir("cr5_met100");
+      dir("cr5_mt_nm1");
+      dir("cr5_mt2bl_nm1");
+    }
+    dir("cr5_final");
+  }
+
+  if (doCR5Loose) {
+    dir("cr5_loose_presel");
+    if (doNM1Plots) {
+      dir("cr5_loose_met_nm1");
+    }
+    dir("cr5_loose_final");
+  }
+
+  if (doCR5METLast) {
+    dir("cr5_metlast_presel");
+    if (doNM1Plots) {
+      dir("cr5_metlast_bbmass_nm1");
+      dir("cr5_metlast_mt2bl_nm1");
+      dir("cr5_metlast_mtfirst");
+      if (doMetBinRegions) {
+	dir("cr5_metlast_nomt_met100");
+	dir("cr5_metlast_nomt_met150");
+	dir("cr5_metlast_nomt_met175");
+      }
+      dir("cr5_metlast_mt_nm1");
+      dir("cr5_metlast_met_nm1");
+      dir("cr5_metlast_met100");
+      dir("cr5_metlast_met125");
+      dir("cr5_metlast_met150");
+    }
+    dir("cr5_metlast_final");
+  }
+
+  if (doCR5InvMass) {
+    dir("cr5_invmass_presel");
+    if (doNM1Plots) {
+      dir("cr5_invmass_bbmass_nm1");
+      dir("cr5_invmass_mt2bl_nm1");
+      dir("cr5_invmass_mtfirst");
+      if (doMetBinRegions) {
+	dir("cr5_invmass_nomt_met100");
+	dir("cr5_invmass_nomt_met150");
+	dir("cr5_invmass_nomt_met175");
+      }
+      dir("cr5_invmass_mt_nm1");
+      dir("cr5_invmass_met_nm1");
+      dir("cr5_invmass_met100");
+      dir("cr5_invmass_met125");
+      dir("cr5_invmass_met150");
+    }
+    dir("cr5_invmass_final");
+  }
+
+  if (doCR5HighMass) {
+    dir("cr5_highmass_presel");
+    if (doNM1Plots) {
+      dir("cr5_highmass_mt2bl_nm1");
+      dir("cr5_highmass_mtfirst");
+      dir("cr5_highmass_mt_nm1");
+      dir("cr5_highmass_met_nm1");
+      dir("cr5_highmass_met100");
+      dir("cr5_highmass_met125");
+      dir("cr5_highmass_met150");
+    }
+    dir("cr5_highmass_final");
+  }
+
+  if (doCR5LowMass) {
+    dir("cr5_lowmass_presel");
+    if (doNM1Plots) {
+      dir("cr5_lowmass_mt2bl_nm1");
+      dir("cr5_lowmass_mtfirst");
+      dir("cr5_lowmass_mt_nm1");
+      dir("cr5_lowmass_met_nm1");
+      dir("cr5_lowmass_met100");
+      dir("cr5_lowmass_met125");
+      dir("cr5_lowmass_met150");
+    }
+    dir("cr5_lowmass_final");
+  }
+
+  if (doCR5MassLast) {
+    dir("cr5_bbmasslast_presel");
+    if (doNM1Plots) {
+      dir("cr5_bbmasslast_mt2bl_nm1");
+      dir("cr5_bbmasslast_mtpeak");
+      dir("cr5_bbmasslast_mtcut");
+      dir("cr5_bbmasslast_mtcut_met100");
+      dir("cr5_bbmasslast_metcut");
+      dir("cr5_bbmasslast_mt_nm1");
+      if (doMetBinRegions) {
+	dir("cr5_bbmasslast_nomt_met50");
+	dir("cr5_bbmasslast_nomt_met75");
+	dir("cr5_bbmasslast_nomt_met100");
+	dir("cr5_bbmasslast_nomt_met125");
+	dir("cr5_bbmasslast_nomt_met137");
+	dir("cr5_bbmasslast_nomt_met150");
+	dir("cr5_bbmasslast_nomt_met162");
+	dir("cr5_bbmasslast_nomt_met175");
+      }
+      dir("cr5_bbmasslast_met_nm1");
+      dir("cr5_bbmasslast_met100");
+      dir("cr5_bbmasslast_met125");
+      dir("cr5_bbmasslast_met150");
+      dir("cr5_bbmasslast_met500");
+      dir("cr5_bbmasslast_bbmass_nm1");
+    }
+    dir("cr5_bbmasslast_final");
+  }
+
+  if (doCR6) {
+    dir("cr6_presel");
+    if (doNM1Plots) {
+      dir("cr6_met_nm1");
+      dir("cr6_mt_nm1");
+      dir("cr6_mt2bl_nm1");
+    }
+    dir("cr6_final");
+  }
+
+  if (doCR6METLast) {
+    dir("cr6_metlast_presel");
+    if (doNM1Plots) {
+      dir("cr6_metlast_bbmass_nm1");
+      dir("cr6_metlast_mt2bl_nm1");
+      dir("cr6_metlast_mt_nm1");
+      dir("cr6_metlast_met_nm1");
+      dir("cr6_metlast_met100");
+      dir("cr6_metlast_met150");
+    }
+    dir("cr6_metlast_final");
+  }
+
+  if (doCR7) {
+    dir("cr7_presel");
+    if (doNM1Plots) {
+      dir("cr7_met_nm1");
+      dir("cr7_mt_nm1");
+      dir("cr7_mt2bl_nm1");
+    }
+    dir("cr7_final");
+  }
+
+  if (doCR8) {
+    dir("cr8_presel");
+    if (doNM1Plots) {
+      dir("cr8_met_nm1");
+      dir("cr8_mt_nm1");
+      dir("cr8_mt2bl_nm1");
+    }
+    dir("cr8_final");
+  }
+
+  if (doCR8METLast) {
+    dir("cr8_metlast_presel");
+    if (doNM1Plots) {
+      dir("cr8_metlast_mt2bl_nm1");
+      dir("cr8_metlast_mtfirst");
+      dir("cr8_metlast_mt_nm1");
+      dir("cr8_metlast_met_nm1");
+      dir("cr8_metlast_met100");
+      dir("cr8_metlast_met125");
+      dir("cr8_metlast_met150");
+    }
+    dir("cr8_metlast_final");
+  }
+
+  if (doCR9) {
+    dir("cr9_presel");
+    if (doNM1Plots) {
+      dir("cr9_met_nm1");
+      dir("cr9_mtpeak_nomet");
+      dir("cr9_mt_nm1");
+      dir("cr9_mtpeak_met");
+      dir("cr9_mt2bl_nm1");
+      dir("cr9_mtlast_mt2bl_nm1");
+    }
+    dir("cr9_final");
+  }
+
+  if (doCR10) {
+    dir("cr10_presel");
+    if (doNM1Plots) {
+      dir("cr10_met_nm1");
+      dir("cr10_mt_nm1");
+      dir("cr10_mt2bl_nm1");
+    }
+    dir("cr10_final");
+  }
+
+  if (doCR11) {
+    dir("cr11_presel");
+    if (doNM1Plots) {
+      dir("cr11_met_nm1");
+      dir("cr11_mt_nm1");
+      dir("cr11_mt2bl_nm1");
+    }
+    dir("cr11_final");
+  }
+
+  if (doCR12) {
+    dir("cr12_presel");
+    if (doNM1Plots) {
+      dir("cr12_met_nm1");
+      dir("cr12_mt_nm1");
+      dir("cr12_mt2bl_nm1");
+    }
+    dir("cr12_final");
+  }
+
+  if (doCR13) {
+    dir("cr13_presel");
+    if (doNM1Plots) {
+      dir("cr13_bbmass_nm1");
+      dir("cr13_mt2bl_nm1");
+      dir("cr13_met_nm1");
+      dir("cr13_met100");
+      dir("cr13_met150");
+    }
+    dir("cr13_final");
+  }
+
+  if (doCR14) {
+    dir("cr14_presel");
+    if (doNM1Plots) {
+      dir("cr14_mt2bl_nm1");
+      dir("cr14_mtfirst");
+      if (doMetBinRegions) {
+	dir("cr14_nomt_met100");
+	dir("cr14_nomt_met150");
+	dir("cr14_nomt_met175");
+      }
+      dir("cr14_mt_nm1");
+      dir("cr14_met_nm1");
+      dir("cr14_met100");
+      dir("cr14_met125");
+      dir("cr14_met150");
+    }
+    dir("cr14_final");
+  }
+
+  if (doStopSel) {
+    dir("stop_presel");
+    dir("stop_met_nm1");
+    dir("stop_mt_nm1");
+    dir("stop_isotrk_nm1");
+    dir("stop_tauveto_nm1");
+    dir("stop_comp");
+  }
+
+}
+
+#endif
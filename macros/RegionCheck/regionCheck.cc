@@ -0,0 +1,250 @@
+// Checks that the regions of WHLooper/WHRegions.cc select and fill what the
+//  hand-written cut flows they replaced did (oldCutFlows.h), event by event,
+//  for random events with every cut value on and around its threshold.
+//  Exits nonzero on the first configuration that differs.
+
+#include "../Core/RegionSelector.h"
+#include "../WHLooper/WHRegions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// what the old cut flows read, under the names of the WHLooper members
+static WHRegionInputs in;
+static bool isData, passisotrk;
+static float met_, mt_, mt2bl_, bbwdphi_, wpt_, lepmetdphi_;
+static int njets_, njetsall_, nbjets_, nbjetsl_, nbjetst_;
+
+struct BBStub {
+  float M() const { return in.bbmass; }
+  float pt() const { return in.bbpt; }
+} bb_;
+
+struct StoptStub {
+  int id1() const { return in.id1; }
+  int id2() const { return in.id2; }
+  float dilmass() const { return in.dilmass; }
+} stopt;
+
+namespace TMath { double Pi() { return M_PI; } }
+
+static bool passSingleLeptonSelection(bool) { return in.lep1; }
+static bool passLepPlusIsoTrkSelectionWHMet(bool) { return in.lepisotrk; }
+static bool passDileptonSelection(bool) { return in.dilep; }
+static bool passIsoTrkVeto_v4() { return in.isotrkv4; }
+static bool passTauVeto() { return in.tauveto; }
+
+const float CUT_BBMASS_LOW_ = CUT_BBMASS_LOW;
+const float CUT_BBMASS_HIGH_ = CUT_BBMASS_HIGH;
+const float CUT_BBMASS_CR1_LOW_ = CUT_BBMASS_CR1_LOW;
+const float CUT_BBMASS_CR1_HIGH_ = CUT_BBMASS_CR1_HIGH;
+const float CUT_BBMASS_CR8_LOW_ = CUT_BBMASS_CR8_LOW;
+const float CUT_BBMASS_CR8_HIGH_ = CUT_BBMASS_CR8_HIGH;
+const float CUT_MET_PRESEL_ = CUT_MET_PRESEL;
+const float CUT_MET_ = CUT_MET;
+const float CUT_MT_PRESEL_ = CUT_MT_PRESEL;
+const float CUT_MT_ = CUT_MT;
+const float CUT_MT_CR13_LOW_ = CUT_MT_CR13_LOW;
+const float CUT_MT_CR13_HIGH_ = CUT_MT_CR13_HIGH;
+const float CUT_MT2BL_ = CUT_MT2BL;
+
+// the weights stand for themselves
+const int evtweight1l = RW_1L;
+const int evtweight2l = RW_2L;
+const int evtweight_novtxweight = RW_NOVTX;
+
+typedef pair<string, int> Fill;
+static vector<Fill> oldFills;
+static set<string> oldDirNames;
+
+static void fill(const char* name, float weight) { oldFills.push_back(Fill(name, int(weight))); }
+static void dir(const char* name) { oldDirNames.insert(name); }
+
+#include "oldCutFlows.h"
+
+//--------------------------------------------------------------------
+
+static float pick(const float* values, int n) { return values[rand() % n]; }
+
+static void randomEvent() {
+  // thresholds of the cuts and the floats on either side of them
+  static const float mets[] = { 40., 45., 50., 75., 100., 125., 137., 150., 162., 175., 300., 500., 600. };
+  static const float mts[] = { 0., 30., 50., 65., 80., 100., 120., 150. };
+  static const float mt2bls[] = { 100., 200., 300. };
+  static const float bbmasses[] = { 30., 50., 75., 100., 125., 150., 175., 200., 225., 250., 300. };
+  static const float dilmasses[] = { 50., 76., 91., 106., 120. };
+  static const int ids[] = { 11, -11, 13, -13 };
+  const int nmets = sizeof(mets)/sizeof(float), nmts = sizeof(mts)/sizeof(float);
+  const int nmt2bls = sizeof(mt2bls)/sizeof(float), nbbmasses = sizeof(bbmasses)/sizeof(float);
+  const int ndilmasses = sizeof(dilmasses)/sizeof(float);
+
+  in.isData = rand() % 2;
+  in.lep1 = rand() % 4 != 0;
+  in.isotrk = rand() % 4 != 0;
+  in.lepisotrk = rand() % 2;
+  in.dilep = rand() % 2;
+  in.isotrkv4 = rand() % 2;
+  in.tauveto = rand() % 2;
+  in.id1 = ids[rand() % 4];
+  in.id2 = ids[rand() % 4];
+  in.njets = rand() % 7;
+  in.njetsall = in.njets + rand() % 3;
+  in.nbjets = rand() % 4;
+  in.nbjetsl = rand() % 4;
+  in.nbjetst = rand() % 3;
+
+  const float eps[3] = { -0.01, 0., 0.01 };
+  in.met = pick(mets, nmets) + eps[rand() % 3];
+  in.mt = pick(mts, nmts) + eps[rand() % 3];
+  in.mt2bl = pick(mt2bls, nmt2bls) + eps[rand() % 3];
+  in.bbmass = pick(bbmasses, nbbmasses) + eps[rand() % 3];
+  in.dilmass = pick(dilmasses, ndilmasses) + eps[rand() % 3];
+  in.bbpt = 100. + 10. * eps[rand() % 3] * 100.;
+  in.bbwdphi = 2.95 + eps[rand() % 3];
+  in.wpt = 180. + eps[rand() % 3] * 100.;
+  in.lepmetdphi = M_PI/2. + eps[rand() % 3];
+
+  isData = in.isData;
+  passisotrk = in.isotrk;
+  met_ = in.met;
+  mt_ = in.mt;
+  mt2bl_ = in.mt2bl;
+  bbwdphi_ = in.bbwdphi;
+  wpt_ = in.wpt;
+  lepmetdphi_ = in.lepmetdphi;
+  njets_ = in.njets;
+  njetsall_ = in.njetsall;
+  nbjets_ = in.nbjets;
+  nbjetsl_ = in.nbjetsl;
+  nbjetst_ = in.nbjetst;
+}
+
+// names in the order of their first fill
+static vector<string> firstFills(const vector<Fill>& fills) {
+  vector<string> names;
+  for (unsigned int i = 0; i < fills.size(); ++i)
+    if (find(names.begin(), names.end(), fills[i].first) == names.end()) names.push_back(fills[i].first);
+  return names;
+}
+
+static void printFills(const char* what, const vector<Fill>& fills) {
+  printf("  %s:", what);
+  for (unsigned int i = 0; i < fills.size(); ++i) printf(" %s/%d", fills[i].first.c_str(), fills[i].second);
+  printf("\n");
+}
+
+static bool checkConfig(const char* label, int nEvents) {
+
+  RegionSelector regions;
+  vector<WHRegionInfo> info;
+  declareRegions(regions, info);
+
+  oldDirNames.clear();
+  oldDirs();
+
+  set<string> declared, oldFilled;
+  for (int r = 0; r < regions.nRegions(); ++r) declared.insert(regions.name(r));
+
+  for (int ievt = 0; ievt < nEvents; ++ievt) {
+    randomEvent();
+
+    oldFills.clear();
+    oldCutFlows();
+
+    setRegionCuts(regions, in);
+    const vector<int>& passed = regions.select();
+    vector<Fill> newFills;
+    for (unsigned int i = 0; i < passed.size(); ++i) {
+      int r = passed[i];
+      if (info[r].nm1Only && !doNM1Plots) continue;
+      for (int f = 0; f < info[r].fills; ++f) newFills.push_back(Fill(regions.name(r), info[r].weight));
+    }
+
+    vector<Fill> oldSorted(oldFills), newSorted(newFills);
+    sort(oldSorted.begin(), oldSorted.end());
+    sort(newSorted.begin(), newSorted.end());
+    if (oldSorted != newSorted || firstFills(oldFills) != firstFills(newFills)) {
+      printf("[regionCheck] %s: event %d filled differently\n", label, ievt);
+      printf("  met %.2f mt %.2f mt2bl %.2f m(bb) %.2f njets %d/%d nb %d/%d/%d isData %d\n",
+             in.met, in.mt, in.mt2bl, in.bbmass, in.njets, in.njetsall, in.nbjets, in.nbjetsl, in.nbjetst, in.isData);
+      printFills("old", oldFills);
+      printFills("new", newFills);
+      return false;
+    }
+    for (unsigned int i = 0; i < oldFills.size(); ++i) oldFilled.insert(oldFills[i].first);
+  }
+
+  // every old dir is a region, and the only new ones are regions the old
+  //  code filled without making their dir
+  bool ok = true;
+  for (set<string>::const_iterator it = oldDirNames.begin(); it != oldDirNames.end(); ++it) {
+    if (declared.count(*it)) continue;
+    printf("[regionCheck] %s: dir %s is not a region\n", label, it->c_str());
+    ok = false;
+  }
+  vector<string> restored;
+  for (set<string>::const_iterator it = declared.begin(); it != declared.end(); ++it) {
+    if (oldDirNames.count(*it)) continue;
+    if (oldFilled.count(*it)) {
+      restored.push_back(*it);
+      continue;
+    }
+    printf("[regionCheck] %s: region %s is neither an old dir nor filled by the old code\n", label, it->c_str());
+    ok = false;
+  }
+  if (!ok) return false;
+
+  printf("[regionCheck] %s: %d events, %d regions, same fills\n", label, nEvents, regions.nRegions());
+  if (!restored.empty()) {
+    printf("  filled before without a dir, now saved:");
+    for (unsigned int i = 0; i < restored.size(); ++i) printf(" %s", restored[i].c_str());
+    printf("\n");
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------
+
+static void setAllRegions(bool on) {
+  bool* flags[] = { &doInclusive, &doSignal, &doSignalMassLast, &doSignalMETLast, &doCR5METLast,
+                    &doCR5InvMass, &doCR5MassLast, &doCR14, &doCR1METLast, &doCR23, &doCR23MassLast,
+                    &doCR5HighMass, &doCR5LowMass, &doCR8METLast, &doInclusiveMTTail, &doSignal2Loose,
+                    &doSignal1Med, &doSignal1Med1Loose, &doSignalSMWH, &doCR1, &doCR2, &doCR3, &doCR4,
+                    &doCR5, &doCR5Loose, &doCR6, &doCR6METLast, &doCR7, &doCR8, &doCR9, &doCR10,
+                    &doCR11, &doCR12, &doCR13, &doStopSel };
+  for (unsigned int i = 0; i < sizeof(flags)/sizeof(flags[0]); ++i) *flags[i] = on;
+}
+
+int main() {
+
+  const int nEvents = 200000;
+  srand(12345);
+
+  bool ok = checkConfig("default regions", nEvents);
+
+  setAllRegions(true);
+  for (int nm1 = 1; nm1 >= 0; --nm1) {
+    for (int metBins = 0; metBins < 2; ++metBins) {
+      doNM1Plots = nm1;
+      doMetBinRegions = metBins;
+      char label[100];
+      sprintf(label, "all regions, doNM1Plots %d, doMetBinRegions %d", nm1, metBins);
+      ok = checkConfig(label, nEvents) && ok;
+    }
+  }
+
+  if (!ok) {
+    printf("[regionCheck] FAILED\n");
+    return 1;
+  }
+  printf("[regionCheck] OK\n");
+  return 0;
+}
@@ -0,0 +1,130 @@
+//
+// Parity check of Core/ScaleFactors against the stopUtils functions it
+// replaces.  Every pt and |eta| bin edge of the old if/else chains, the
+// floats on either side of each edge, every bin midpoint and a few values
+// outside the tables are swept, with both eta signs, for every function,
+// lepton id, jet flavour and fastsim setting.
+//
+//   sfCheck        exits nonzero if any value is not bit-identical
+//
+
+#include "../Core/ScaleFactors.h"
+#include "../Core/stopUtils.h"
+
+#include <math.h>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+//--------------------------------------------------------------------
+// sweep points
+
+// the edges of getsltrigweight, getideffweight, getisoeffweight and getBtagSF
+static const float ptEdges[] = {20, 22, 24, 26, 28, 30, 32, 34, 36, 38, 40, 50, 60, 70, 80, 100,
+                                120, 150, 160, 200, 210, 260, 300, 320, 400, 500, 670};
+static const float ptOutside[] = {-10, 0, 5, 1000, 10000};
+static const float etaEdges[] = {0, 0.8, 1.4442, 1.5, 1.6, 2.1, 2.4};
+static const float etaOutside[] = {3, 5};
+
+// edges, their neighbouring floats, midpoints and the outside values
+static vector<float> sweep(const float* edges, int nedges, const float* outside, int noutside, bool bothSigns) {
+  set<float> points(outside, outside + noutside);
+  for (int i = 0; i < nedges; ++i) {
+    points.insert(edges[i]);
+    points.insert(nextafterf(edges[i], -1e30f));
+    points.insert(nextafterf(edges[i], 1e30f));
+    if (i + 1 < nedges) points.insert(0.5f * (edges[i] + edges[i + 1]));
+  }
+  if (bothSigns) {
+    vector<float> positive(points.begin(), points.end());
+    for (unsigned int i = 0; i < positive.size(); ++i) points.insert(-positive[i]);
+  }
+  return vector<float>(points.begin(), points.end());
+}
+
+//--------------------------------------------------------------------
+// comparison
+
+struct Tally {
+  const char* what;
+  int nchecked, nfailed;
+};
+
+static int nprinted = 0;
+
+static void compare(Tally& tally, float value, float reference, int id, float pt, float eta, int fastsim = -1) {
+  ++tally.nchecked;
+  if (value == reference) return;
+  ++tally.nfailed;
+  if (nprinted++ < 20)
+    printf("[sfCheck] %s id %d pt %.9g eta %.9g fastsim %d: %a, stopUtils gives %a\n",
+           tally.what, id, pt, eta, fastsim, value, reference);
+}
+
+static int report(const Tally& tally) {
+  printf("[sfCheck] %-14s %7d points, %d different\n", tally.what, tally.nchecked, tally.nfailed);
+  return tally.nfailed;
+}
+
+//--------------------------------------------------------------------
+
+int main() {
+
+  vector<float> pts = sweep(ptEdges, sizeof(ptEdges) / sizeof(float), ptOutside, sizeof(ptOutside) / sizeof(float), false);
+  vector<float> etas = sweep(etaEdges, sizeof(etaEdges) / sizeof(float), etaOutside, sizeof(etaOutside) / sizeof(float), true);
+
+  const int leptonIds[] = {11, -11, 13, -13, 15, 0};
+  const int nleptonIds = sizeof(leptonIds) / sizeof(int);
+  const int flavours[] = {0, 1, 2, 3, 21, 4, -4, 5, -5};
+  const int nflavours = sizeof(flavours) / sizeof(int);
+
+  ScaleFactors sf;
+
+  // both sides print a warning for unknown ids and out-of-range jets
+  ostringstream warnings;
+  streambuf* coutbuf = cout.rdbuf(warnings.rdbuf());
+
+  Tally sltrig = {"slTrigWeight", 0, 0};
+  Tally ideff = {"idEffWeight", 0, 0};
+  Tally isoeff = {"isoEffWeight", 0, 0};
+  Tally dltrig = {"dlTrigWeight", 0, 0};
+  Tally btag = {"btagSF", 0, 0};
+
+  for (unsigned int ipt = 0; ipt < pts.size(); ++ipt) {
+    float pt = pts[ipt];
+    for (unsigned int ieta = 0; ieta < etas.size(); ++ieta) {
+      float eta = etas[ieta];
+      for (int i = 0; i < nleptonIds; ++i) {
+        int id = leptonIds[i];
+        compare(sltrig, sf.slTrigWeight(id, pt, eta).nominal, getsltrigweight(id, pt, eta), id, pt, eta);
+        compare(ideff, sf.idEffWeight(id, pt, eta).nominal, getideffweight(id, pt, eta), id, pt, eta);
+        compare(isoeff, sf.isoEffWeight(id, pt, eta).nominal, getisoeffweight(id, pt, eta), id, pt, eta);
+      }
+      for (int i = 0; i < nflavours; ++i) {
+        for (int fastsim = 0; fastsim < 2; ++fastsim) {
+          int flavour = flavours[i];
+          compare(btag, sf.btagSF(pt, eta, flavour, fastsim).nominal, getBtagSF(pt, eta, flavour, fastsim),
+                  flavour, pt, eta, fastsim);
+        }
+      }
+    }
+  }
+  for (int i = 0; i < nleptonIds; ++i)
+    for (int j = 0; j < nleptonIds; ++j)
+      compare(dltrig, sf.dlTrigWeight(leptonIds[i], leptonIds[j]), getdltrigweight(leptonIds[i], leptonIds[j]),
+              leptonIds[i] * 100 + leptonIds[j], 0., 0.);  // id1*100 + id2
+
+  cout.rdbuf(coutbuf);
+
+  int nfailed = report(sltrig) + report(ideff) + report(isoeff) + report(dltrig) + report(btag);
+  if (nfailed) {
+    printf("[sfCheck] FAILED: %d values differ from stopUtils\n", nfailed);
+    return 1;
+  }
+  printf("[sfCheck] all values identical to stopUtils\n");
+  return 0;
+}
@@ -0,0 +1,215 @@
+#include "BenchEvent.h"
+
+#include "../Core/STOPT.h"
+#include "../Core/stopUtils.h"
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace Stop;
+
+static const float JET_PT  = 30.;
+static const float JET_ETA = 2.5;
+static const int   NJETS_CUT = 4;
+
+//--------------------------------------------------------------------
+bool writeFixture(const string& filename, const BENCHEVENTS& events, const string& comment){
+
+  FILE* f = fopen(filename.c_str(), "w");
+  if (!f) {
+    cout << "[writeFixture] cannot open " << filename << endl;
+    return false;
+  }
+
+  fprintf(f, "# SolverBench fixture, %u events\n", (unsigned int)events.size());
+  if (comment.size()) fprintf(f, "# %s\n", comment.c_str());
+
+  for (unsigned int i = 0; i < events.size(); ++i) {
+    const BenchEvent& ev = events[i];
+    fprintf(f, "%u %u %u %d %.9g %.9g %.9g %.9g %.9g %.9g %u",
+	    ev.run, ev.lumi, ev.event, ev.isData ? 1 : 0, ev.met, ev.metphi,
+	    ev.lep.Px(), ev.lep.Py(), ev.lep.Pz(), ev.lep.E(), (unsigned int)ev.jets.size());
+    for (unsigned int j = 0; j < ev.jets.size(); ++j)
+      fprintf(f, "  %.9g %.9g %.9g %.9g %.9g %.9g %d",
+	      ev.jets[j].Px(), ev.jets[j].Py(), ev.jets[j].Pz(), ev.jets[j].E(),
+	      ev.btag[j], ev.sigma[j], ev.mc.size() ? ev.mc[j] : 0);
+    fprintf(f, "\n");
+  }
+
+  fclose(f);
+  return true;
+}
+
+//--------------------------------------------------------------------
+bool readFixture(const string& filename, BENCHEVENTS& events){
+
+  ifstream in(filename.c_str());
+  if (!in) {
+    cout << "[readFixture] cannot open " << filename << endl;
+    return false;
+  }
+
+  string line;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    istringstream is(line);
+
+    BenchEvent ev;
+    int isData;
+    float px, py, pz, e;
+    unsigned int njets;
+    is >> ev.run >> ev.lumi >> ev.event >> isData >> ev.met >> ev.metphi >> px >> py >> pz >> e >> njets;
+    ev.isData = isData;
+    ev.lep = LorentzVector(px, py, pz, e);
+
+    for (unsigned int j = 0; j < njets; ++j) {
+      float csv, sigma;
+      int mc;
+      is >> px >> py >> pz >> e >> csv >> sigma >> mc;
+      ev.jets.push_back(LorentzVector(px, py, pz, e));
+      ev.btag.push_back(csv);
+      ev.sigma.push_back(sigma);
+      if (!ev.isData) ev.mc.push_back(mc);
+    }
+
+    if (is.fail()) {
+      cout << "[readFixture] malformed line in " << filename << ": " << line << endl;
+      return false;
+    }
+    events.push_back(ev);
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------
+int extractFixture(const vector<string>& babies, BENCHEVENTS& events, int maxEvents){
+
+  int nAdded = 0;
+
+  for (unsigned int ifile = 0; ifile < babies.size() && nAdded < maxEvents; ++ifile) {
+
+    TFile *file = TFile::Open(babies[ifile].c_str());
+    if (!file || file->IsZombie()) {
+      cout << "[extractFixture] cannot open " << babies[ifile] << endl;
+      continue;
+    }
+    TTree *tree = (TTree*)file->Get("t");
+    stopt.Init(tree);
+
+    ULong64_t nEvents = tree->GetEntries();
+    for (ULong64_t event = 0; event < nEvents && nAdded < maxEvents; ++event) {
+      stopt.GetEntry(event);
+
+      if ( stopt.ngoodlep() < 1 ) continue;
+      if ( stopt.lep1().pt() < 30 ) continue;
+
+      BenchEvent ev;
+      ev.run    = stopt.run();
+      ev.lumi   = stopt.lumi();
+      ev.event  = stopt.event();
+      ev.isData = stopt.isdata();
+      ev.lep    = stopt.lep1();
+      ev.met    = stopt.t1metphicorr();
+      ev.metphi = stopt.t1metphicorrphi();
+
+      int nb = 0;
+      for (unsigned int i = 0; i < stopt.pfjets().size(); ++i) {
+	if ( stopt.pfjets().at(i).pt() < JET_PT ) continue;
+	if ( fabs(stopt.pfjets().at(i).eta()) > JET_ETA ) continue;
+	ev.jets.push_back(stopt.pfjets().at(i));
+	ev.btag.push_back(stopt.pfjets_csv().at(i));
+	ev.sigma.push_back(stopt.pfjets_sigma().at(i));
+	if (!ev.isData) ev.mc.push_back(stopt.pfjets_mc3().at(i));
+	if (stopt.pfjets_csv().at(i) > BTAG_MED) ++nb;
+      }
+      if ( (int)ev.jets.size() < NJETS_CUT || nb < 1 ) continue;
+
+      events.push_back(ev);
+      ++nAdded;
+    }
+
+    file->Close();
+    delete file;
+  }
+
+  return nAdded;
+}
+
+//--------------------------------------------------------------------
+static LorentzVector makeP4(TRandom3& rnd, float pt, float etamax, float mmin, float mmax){
+  float eta  = rnd.Uniform(-etamax, etamax);
+  float phi  = rnd.Uniform(-TMath::Pi(), TMath::Pi());
+  float mass = rnd.Uniform(mmin, mmax);
+  float px = pt * cos(phi), py = pt * sin(phi), pz = pt * sinh(eta);
+  return LorentzVector(px, py, pz, sqrt(px*px + py*py + pz*pz + mass*mass));
+}
+
+static bool comparePt(const pair<float, int>& a, const pair<float, int>& b){
+  return a.first > b.first;
+}
+
+int generateFixture(const string& type, int nEvents, unsigned int seed, BENCHEVENTS& events){
+
+  bool ttbar = (type == "ttbar"), manyjets = (type == "manyjets");
+  bool boosted = (type == "boosted"), edge = (type == "edge");
+  if (!ttbar && !manyjets && !boosted && !edge) {
+    cout << "[generateFixture] unknown type " << type << endl;
+    return 0;
+  }
+
+  static const int mcCodes[7] = { 0, 1, -1, 2, -2, 5, -5 };
+  TRandom3 rnd(seed);
+
+  for (int iev = 0; iev < nEvents; ++iev) {
+
+    BenchEvent ev;
+    ev.run = 1; ev.lumi = seed; ev.event = iev;
+    ev.isData = false;
+
+    int njets = ttbar ? 4 + rnd.Integer(3) : manyjets ? 6 + rnd.Integer(7) : boosted ? 4 + rnd.Integer(2) : 2 + rnd.Integer(2);
+    int nb    = edge ? rnd.Integer(3) : 1 + rnd.Integer(2);
+
+    ev.lep    = makeP4(rnd, boosted ? 100 + rnd.Exp(150) : 30 + rnd.Exp(50), 2.1, 0.0005, 0.106);
+    ev.met    = boosted ? 300 + rnd.Exp(200) : edge ? (rnd.Rndm() < 0.3 ? 0. : rnd.Exp(30)) : 50 + rnd.Exp(80);
+    ev.metphi = rnd.Uniform(-TMath::Pi(), TMath::Pi());
+    if (boosted) ev.metphi = ev.lep.phi() + rnd.Gaus(0, 0.3);
+
+    vector< pair<float, int> > order;
+    vector<LorentzVector> p4s;
+    for (int j = 0; j < njets; ++j) {
+      float pt = boosted ? 50 + rnd.Exp(200) : 30 + rnd.Exp(60);
+      LorentzVector p4 = makeP4(rnd, pt, 2.5, 4, 20);
+      if (boosted && j > 0) {
+	// collimate with the leading jet
+	float eta = p4s[0].eta() + rnd.Gaus(0, 0.3), phi = p4s[0].phi() + rnd.Gaus(0, 0.3);
+	float px = pt * cos(phi), py = pt * sin(phi), pz = pt * sinh(eta);
+	p4 = LorentzVector(px, py, pz, sqrt(px*px + py*py + pz*pz + p4.M2()));
+      }
+      p4s.push_back(p4);
+      order.push_back(make_pair(pt, j));
+    }
+    sort(order.begin(), order.end(), comparePt);
+
+    for (int j = 0; j < njets; ++j) {
+      ev.jets.push_back(p4s[order[j].second]);
+      bool isb = rnd.Integer(njets) < (unsigned int)nb;
+      ev.btag.push_back(isb ? rnd.Uniform(BTAG_MED, 1.) : rnd.Uniform(0., BTAG_MED));
+      ev.sigma.push_back(rnd.Uniform(0.08, 0.25));
+      ev.mc.push_back(mcCodes[rnd.Integer(7)]);
+    }
+
+    events.push_back(ev);
+  }
+
+  return nEvents;
+}
@@ -0,0 +1,49 @@
+#ifndef BENCHEVENT_H
+#define BENCHEVENT_H
+
+#include "Math/LorentzVector.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
+
+//
+// Kinematics of one event as the solvers see it: the leading lepton, the
+// selected jets (pT > 30, |eta| < 2.5, pT-ordered) with CSV, resolution and
+// MC match, and the type-1 phi-corrected MET.
+//
+struct BenchEvent {
+  unsigned int run, lumi, event;
+  bool isData;
+  LorentzVector lep;
+  float met, metphi;
+  vector<LorentzVector> jets;
+  vector<float> btag;
+  vector<float> sigma;
+  vector<int> mc;
+};
+
+typedef vector<BenchEvent> BENCHEVENTS;
+
+// Fixture files are plain text, one event per line:
+//   run lumi event isData met metphi lepPx lepPy lepPz lepE njets
+//   [px py pz E csv sigma mc] x njets
+// floats are written with 9 significant digits so they read back bit for bit.
+bool writeFixture(const string& filename, const BENCHEVENTS& events, const string& comment = "");
+bool readFixture(const string& filename, BENCHEVENTS& events);
+
+// Golden events from stop babies: apply the usual 1-lepton preselection
+// (>= 4 jets, >= 1 CSVM) and keep up to maxEvents of them.
+int extractFixture(const vector<string>& babies, BENCHEVENTS& events, int maxEvents = 1000);
+
+// Synthetic events for stress cases, reproducible from the seed:
+//   "ttbar"    - 4-6 jets, 1-2 b-tags, realistic spectra
+//   "manyjets" - 6-12 jets, exercises the combinatorics
+//   "boosted"  - hard MET and collimated jets, slow bisections
+//   "edge"     - 2-3 jets, soft or zero MET, degenerate kinematics
+int generateFixture(const string& type, int nEvents, unsigned int seed, BENCHEVENTS& events);
+
+#endif
@@ -0,0 +1,356 @@
+//
+// Golden-event regression and micro-benchmark for the kinematic solvers.
+//
+//   solverBench gen     <type> <n> <seed> <fixture>    synthetic fixture
+//   solverBench extract <fixture> <n> <baby> [baby..]  golden events from babies
+//   solverBench ref     <fixture> <reference>          write solver outputs
+//   solverBench check   <fixture> <reference> [-tol x] compare against reference
+//   solverBench bench   <fixture> [-n repeat] [-only solver]
+//   solverBench                                        check the committed fixtures
+//
+// Reference values are written as hex floats (%a) so check is bit-exact by
+// default; -tol allows a relative tolerance instead. A reference must have
+// every solver for every event of its fixture. bench reports ns/call,
+// calls/s and heap allocations per call for every solver.
+//
+
+#include "BenchEvent.h"
+
+#include "../Core/stopUtils.h"
+#include "../Core/MT2.h"
+#include "../Core/PartonCombinatorics.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <new>
+
+using namespace std;
+
+//--------------------------------------------------------------------
+// heap allocation counter
+
+static unsigned long long nAllocs = 0;
+
+// dynamic exception specifications are gone in C++17
+#if __cplusplus >= 201103L
+#define BENCH_THROW_BADALLOC noexcept(false)
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_THROW_BADALLOC throw(std::bad_alloc)
+#define BENCH_NOTHROW throw()
+#endif
+
+void* operator new(size_t size) BENCH_THROW_BADALLOC {
+  ++nAllocs;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t size) BENCH_THROW_BADALLOC {
+  ++nAllocs;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) BENCH_NOTHROW { free(p); }
+void operator delete[](void* p) BENCH_NOTHROW { free(p); }
+
+//--------------------------------------------------------------------
+// solvers under test; each fills nout doubles for one event
+
+static const int MAXOUT = 10;
+
+static void runMT2wWrapper(BenchEvent& ev, double* out){
+  if (ev.jets.size() < 2) { out[0] = out[1] = out[2] = -1.; return; }
+  out[0] = mt2wWrapper(ev.lep, ev.jets[0], ev.jets[1], ev.met, ev.metphi, MT2w);
+  out[1] = mt2wWrapper(ev.lep, ev.jets[0], ev.jets[1], ev.met, ev.metphi, MT2bl);
+  out[2] = mt2wWrapper(ev.lep, ev.jets[0], ev.jets[1], ev.met, ev.metphi, MT2b);
+}
+
+static void runMT2(BenchEvent& ev, double* out){
+  out[0] = ev.jets.size() ? MT2(ev.met, ev.metphi, ev.lep, ev.jets[0]) : -1.;
+}
+
+static void runCalculateMT2w(BenchEvent& ev, double* out){
+  out[0] = calculateMT2w(ev.jets, ev.btag, ev.lep, ev.met, ev.metphi, MT2w);
+}
+
+static void runChi2SNT(BenchEvent& ev, double* out){
+  out[0] = calculateChi2SNT(ev.jets, ev.sigma, ev.btag);
+}
+
+static PartonCombinatorics pc;
+
+static void runPartonCombinatorics(BenchEvent& ev, double* out){
+  pc.compute(ev.jets, ev.btag, ev.sigma, ev.mc, ev.lep, ev.met, ev.metphi, ev.isData);
+  MT2CHI2 r = pc.getMt2Chi2();
+  out[0] = r.one_chi2;
+  out[1] = r.two_mt2b;   out[2] = r.two_mt2bl;   out[3] = r.two_mt2w;
+  out[4] = r.three_mt2b; out[5] = r.three_mt2bl; out[6] = r.three_mt2w;
+  out[7] = r.four_chi2b; out[8] = r.four_chi2bl; out[9] = r.four_chi2w;
+}
+
+static void runThetaStar(BenchEvent& ev, double* out){
+  out[0] = ev.jets.size() ? getThetaStar(ev.lep, ev.jets[0]) : -1.;
+}
+
+struct Solver {
+  const char* name;
+  int nout;
+  void (*fn)(BenchEvent&, double*);
+};
+
+static const Solver solvers[] = {
+  { "mt2wWrapper",         3,  runMT2wWrapper },
+  { "MT2",                 1,  runMT2 },
+  { "calculateMT2w",       1,  runCalculateMT2w },
+  { "calculateChi2SNT",    1,  runChi2SNT },
+  { "PartonCombinatorics", 10, runPartonCombinatorics },
+  { "getThetaStar",        1,  runThetaStar }
+};
+static const int NSOLVERS = sizeof(solvers) / sizeof(Solver);
+
+//--------------------------------------------------------------------
+static double now(){
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static bool loadFixture(const char* filename, BENCHEVENTS& events){
+  if (!readFixture(filename, events)) return false;
+  if (events.empty()) {
+    cout << "[solverBench] no events in " << filename << endl;
+    return false;
+  }
+  cout << "[solverBench] " << events.size() << " events from " << filename << endl;
+  return true;
+}
+
+//--------------------------------------------------------------------
+static int writeReference(BENCHEVENTS& events, const char* filename){
+
+  FILE* f = fopen(filename, "w");
+  if (!f) {
+    cout << "[solverBench] cannot open " << filename << endl;
+    return 1;
+  }
+
+  double out[MAXOUT];
+  for (unsigned int i = 0; i < events.size(); ++i)
+    for (int s = 0; s < NSOLVERS; ++s) {
+      solvers[s].fn(events[i], out);
+      fprintf(f, "%u %s", i, solvers[s].name);
+      for (int k = 0; k < solvers[s].nout; ++k) fprintf(f, " %a", out[k]);
+      fprintf(f, "\n");
+    }
+
+  fclose(f);
+  cout << "[solverBench] wrote reference for " << NSOLVERS << " solvers to " << filename << endl;
+  return 0;
+}
+
+//--------------------------------------------------------------------
+static int checkReference(BENCHEVENTS& events, const char* filename, double tol){
+
+  FILE* f = fopen(filename, "r");
+  if (!f) {
+    cout << "[solverBench] cannot open " << filename << endl;
+    return 1;
+  }
+
+  int nchecked = 0, nfailed[NSOLVERS] = { 0 }, nmissing[NSOLVERS] = { 0 };
+  vector<bool> seen(events.size() * NSOLVERS, false);
+  double out[MAXOUT], ref[MAXOUT];
+  unsigned int iev;
+  char name[128];
+
+  while (fscanf(f, "%u %127s", &iev, name) == 2) {
+    int s = 0;
+    while (s < NSOLVERS && strcmp(solvers[s].name, name)) ++s;
+    if (s == NSOLVERS || iev >= events.size()) {
+      cout << "[solverBench] reference does not match fixture: event " << iev << " solver " << name << endl;
+      fclose(f);
+      return 1;
+    }
+    for (int k = 0; k < solvers[s].nout; ++k)
+      if (fscanf(f, "%la", &ref[k]) != 1) {
+	cout << "[solverBench] truncated reference at event " << iev << endl;
+	fclose(f);
+	return 1;
+      }
+
+    solvers[s].fn(events[iev], out);
+    seen[iev * NSOLVERS + s] = true;
+    ++nchecked;
+
+    for (int k = 0; k < solvers[s].nout; ++k) {
+      bool same = tol > 0. ? fabs(out[k] - ref[k]) <= tol * max(fabs(ref[k]), 1.) : !memcmp(&out[k], &ref[k], sizeof(double));
+      if (same) continue;
+      if (nfailed[s] < 10)
+	printf("  %-20s event %5u (%u:%u:%u) output %d: got %.9g (%a) expected %.9g (%a)\n",
+	       name, iev, events[iev].run, events[iev].lumi, events[iev].event, k, out[k], out[k], ref[k], ref[k]);
+      ++nfailed[s];
+      break;
+    }
+  }
+  fclose(f);
+
+  for (unsigned int i = 0; i < seen.size(); ++i)
+    if (!seen[i]) ++nmissing[i % NSOLVERS];
+
+  int ntotal = 0, nnoref = 0;
+  for (int s = 0; s < NSOLVERS; ++s) {
+    printf("  %-20s %6d mismatches %6d events without reference\n", solvers[s].name, nfailed[s], nmissing[s]);
+    ntotal += nfailed[s];
+    nnoref += nmissing[s];
+  }
+  cout << "[solverBench] checked " << nchecked << " solver calls, " << ntotal << " mismatches"
+       << (tol > 0. ? " (relative tolerance)" : " (bit-exact)") << ", " << nnoref << " without reference" << endl;
+  return (ntotal || nnoref) ? 2 : 0;
+}
+
+//--------------------------------------------------------------------
+// MT2CHI2 of PartonCombinatorics against the sorted-list calculation it
+// replaced, on every event
+static int checkMT2CHI2(BENCHEVENTS& events){
+
+  int nfailed = 0;
+  for (unsigned int i = 0; i < events.size(); ++i) {
+    BenchEvent& ev = events[i];
+    pc.compute(ev.jets, ev.btag, ev.sigma, ev.mc, ev.lep, ev.met, ev.metphi, ev.isData);
+    if (pc.checkMT2CHI2Calculator()) continue;
+    if (nfailed < 10)
+      printf("  %-20s event %5u (%u:%u:%u) differs from MT2CHI2Reference\n",
+	     "PartonCombinatorics", i, ev.run, ev.lumi, ev.event);
+    ++nfailed;
+  }
+  cout << "[solverBench] MT2CHI2 on " << events.size() << " events, " << nfailed << " mismatches" << endl;
+  return nfailed ? 2 : 0;
+}
+
+//--------------------------------------------------------------------
+// Fixtures checked by a run without arguments, all of them required. The
+// golden one is extracted from babies (make fixtures, see README).
+struct Fixture {
+  const char* events;
+  const char* reference;
+};
+
+static const Fixture fixtures[] = {
+  { "fixtures/synthetic.txt", "fixtures/synthetic.ref" },
+  { "fixtures/golden.txt",    "fixtures/golden.ref" }
+};
+static const int NFIXTURES = sizeof(fixtures) / sizeof(Fixture);
+
+static int checkFixtures(){
+
+  int status = 0;
+  for (int i = 0; i < NFIXTURES; ++i) {
+    FILE* f = fopen(fixtures[i].events, "r");
+    if (!f) {
+      cout << "[solverBench] " << fixtures[i].events << " not found" << endl;
+      status = 1;
+      continue;
+    }
+    fclose(f);
+
+    BENCHEVENTS events;
+    if (!loadFixture(fixtures[i].events, events)) { status = 1; continue; }
+    if (int s = checkReference(events, fixtures[i].reference, 0.)) status = max(status, s);
+    if (int s = checkMT2CHI2(events)) status = max(status, s);
+  }
+
+  cout << "[solverBench] " << (status ? "FAILED" : "all fixtures agree") << endl;
+  return status;
+}
+
+//--------------------------------------------------------------------
+static int runBenchmark(BenchEvent* begin, BenchEvent* end, int nrepeat, const char* only){
+
+  double out[MAXOUT];
+  int nev = end - begin;
+
+  printf("  %-20s %12s %12s %12s\n", "solver", "ns/call", "calls/s", "allocs/call");
+  for (int s = 0; s < NSOLVERS; ++s) {
+    if (only && strcmp(only, solvers[s].name)) continue;
+
+    // warm up caches and any reusable buffers
+    for (BenchEvent* ev = begin; ev != end; ++ev) solvers[s].fn(*ev, out);
+
+    unsigned long long allocs0 = nAllocs;
+    double t0 = now();
+    for (int r = 0; r < nrepeat; ++r)
+      for (BenchEvent* ev = begin; ev != end; ++ev) solvers[s].fn(*ev, out);
+    double dt = now() - t0;
+    unsigned long long allocs = nAllocs - allocs0;
+
+    double ncalls = (double)nrepeat * nev;
+    printf("  %-20s %12.1f %12.0f %12.2f\n", solvers[s].name, 1e9 * dt / ncalls, ncalls / dt, allocs / ncalls);
+  }
+  return 0;
+}
+
+//--------------------------------------------------------------------
+static void usage(){
+  cout << "usage: solverBench" << endl
+       << "       solverBench gen     <ttbar|manyjets|boosted|edge> <n> <seed> <fixture>" << endl
+       << "       solverBench extract <fixture> <n> <baby> [baby...]" << endl
+       << "       solverBench ref     <fixture> <reference>" << endl
+       << "       solverBench check   <fixture> <reference> [-tol x]" << endl
+       << "       solverBench bench   <fixture> [-n repeat] [-only solver]" << endl;
+}
+
+int main(int argc, char** argv){
+
+  if (argc == 1) return checkFixtures();
+  if (argc < 3) { usage(); return 1; }
+  string mode = argv[1];
+  BENCHEVENTS events;
+
+  if (mode == "gen" && argc == 6) {
+    generateFixture(argv[2], atoi(argv[3]), atoi(argv[4]), events);
+    if (events.empty()) return 1;
+    char comment[256];
+    sprintf(comment, "generated: type %s seed %s", argv[2], argv[4]);
+    return writeFixture(argv[5], events, comment) ? 0 : 1;
+  }
+
+  if (mode == "extract" && argc >= 5) {
+    vector<string> babies(argv + 4, argv + argc);
+    int n = extractFixture(babies, events, atoi(argv[3]));
+    cout << "[solverBench] extracted " << n << " events" << endl;
+    string comment = "extracted from";
+    for (unsigned int i = 0; i < babies.size(); ++i) comment += " " + babies[i];
+    return n && writeFixture(argv[2], events, comment) ? 0 : 1;
+  }
+
+  if (mode == "ref" && argc == 4) {
+    if (!loadFixture(argv[2], events)) return 1;
+    return writeReference(events, argv[3]);
+  }
+
+  if (mode == "check" && (argc == 4 || argc == 6)) {
+    if (!loadFixture(argv[2], events)) return 1;
+    double tol = (argc == 6 && !strcmp(argv[4], "-tol")) ? atof(argv[5]) : 0.;
+    return checkReference(events, argv[3], tol);
+  }
+
+  if (mode == "bench") {
+    if (!loadFixture(argv[2], events)) return 1;
+    int nrepeat = 10;
+    const char* only = 0;
+    for (int i = 3; i + 1 < argc; i += 2) {
+      if (!strcmp(argv[i], "-n")) nrepeat = atoi(argv[i + 1]);
+      else if (!strcmp(argv[i], "-only")) only = argv[i + 1];
+    }
+    return runBenchmark(&events[0], &events[0] + events.size(), nrepeat, only);
+  }
+
+  usage();
+  return 1;
+}
@@ -2,6 +2,7 @@
 #include "StopTreeLooper.h"
 #include "Core/StopTree.h"
 #include "Plotting/PlotUtilities.h"
+#include "Plotting/HistoGrid.h"
 
 #include "TROOT.h"
 #include "TH1F.h"
@@ -17,6 +18,108 @@
 #include <map>
 #include <set>
 
+//
+// histogram grids filled in the event loop
+//
+
+//met requirements: default, then met > 50, 100, ... 400 GeV
+static const int NMETCUTS = 9;
+static const float metcuts[NMETCUTS] = { 0., 50., 100., 150., 200., 250., 300., 350., 400. };
+static const char* TAGS_MET   = ",_met50,_met100,_met150,_met200,_met250,_met300,_met350,_met400";
+static const char* TAGS_NJETS = ",_nj0,_nj1,_nj2,_nj3,_nj4";
+static const char* TAGS_KBIN  = ",_K3,_K4";
+static const char* TAGS_FLAV_SL = "_muo,_ele,_mysterysl";
+
+//variables, in the order they are added to the grid
+enum { SIG_MET, SIG_LEPPT, SIG_DPHI_METLEP, SIG_MT, SIG_MT_COUNT };
+enum { CR1_NJETS, CR1_NJETS_ALL, CR1_MET, CR1_LEPPT, CR1_LEPPHI, CR1_METPHI, CR1_DPHI_METLEP, CR1_MT, CR1_MT_COUNT };
+enum { CR2_MET, CR2_PSEUDOMET, CR2_LEPPT, CR2_DPHI_PSEUDOMETLEP, CR2_PSEUDOMT, CR2_PSEUDOMT_COUNT };
+enum { CR4_MET, CR4_LEPPT, CR4_LEPETA, CR4_SUBLEADLEPPT, CR4_DPHI_METLEP, CR4_MT, CR4_MT_COUNT, CR4_DPHI_DILEP, CR4_DR_DILEP };
+enum { CR5_MET, CR5_LEPPT, CR5_ISOTRKPT, CR5_DPHI_METLEP, CR5_MT, CR5_MT_COUNT, CR5_DPHI_LEPTRK, CR5_DR_LEPTRK };
+
+//axes: isotrk, btag, met, truetrk, kbin, flavour
+static void bookSIGPlots( HistoGrid &h )
+{
+  h.addAxis(",_wisotrk");
+  h.addAxis("_prebtag,,_bveto");
+  h.addAxis(TAGS_MET);
+  h.addAxis(",_wtruetrk,_notruetrk");
+  h.addAxis(TAGS_KBIN);
+  h.addAxis(TAGS_FLAV_SL);
+
+  h.addVariable("h_sig_met",         45, 50., 500.);
+  h.addVariable("h_sig_leppt",       50, 0., 500.);
+  h.addVariable("h_sig_dphi_metlep", 15, 0., TMath::Pi());
+  h.addVariable("h_sig_mt",          30, 0., 300.);
+  h.addVariable("h_sig_mt_count",     2, 0., 2.);
+}
+
+//axes for the control regions: selection, met, njets, kbin, flavour
+static void bookCRAxes( HistoGrid &h, const char *tags_selection, const char *tags_flav )
+{
+  h.addAxis(tags_selection);
+  h.addAxis(TAGS_MET);
+  h.addAxis(TAGS_NJETS);
+  h.addAxis(TAGS_KBIN);
+  h.addAxis(tags_flav);
+}
+
+static void bookCR1Plots( HistoGrid &h, const char *tags_selection )
+{
+  bookCRAxes(h, tags_selection, TAGS_FLAV_SL);
+
+  h.addVariable("h_cr1_njets",        5, 0., 5.);
+  h.addVariable("h_cr1_njets_all",   10, 0., 10.);
+  h.addVariable("h_cr1_met",         45, 50., 500.);
+  h.addVariable("h_cr1_leppt",       50, 0., 500.);
+  h.addVariable("h_cr1_lepphi",      30, -1.*TMath::Pi(), TMath::Pi());
+  h.addVariable("h_cr1_metphi",      30, -1.*TMath::Pi(), TMath::Pi());
+  h.addVariable("h_cr1_dphi_metlep", 15, 0., TMath::Pi());
+  h.addVariable("h_cr1_mt",          30, 0., 300.);
+  h.addVariable("h_cr1_mt_count",     2, 0., 2.);
+}
+
+static void bookCR2Plots( HistoGrid &h, const char *tags_selection )
+{
+  bookCRAxes(h, tags_selection, "_dimu,_diel,_mueg,_mysterydl");
+
+  h.addVariable("h_cr2_met",               30, 0., 300.);
+  h.addVariable("h_cr2_pseudomet",         30, 0., 300.);
+  h.addVariable("h_cr2_leppt",             30, 0., 300.);
+  h.addVariable("h_cr2_dphi_pseudometlep", 15, 0., TMath::Pi());
+  h.addVariable("h_cr2_pseudomt",          30, 0., 300.);
+  h.addVariable("h_cr2_pseudomt_count",     2, 0., 2.);
+}
+
+static void bookCR4Plots( HistoGrid &h, const char *tags_selection )
+{
+  bookCRAxes(h, tags_selection, "_dimu,_diel,_muel,_elmu,_mysterydl");
+
+  h.addVariable("h_cr4_met",          45, 50., 500.);
+  h.addVariable("h_cr4_leppt",        50, 0., 500.);
+  h.addVariable("h_cr4_lepeta",       21, -2.1, 2.1);
+  h.addVariable("h_cr4_subleadleppt", 50, 0., 500.);
+  h.addVariable("h_cr4_dphi_metlep",  15, 0., TMath::Pi());
+  h.addVariable("h_cr4_mt",           30, 0., 300.);
+  h.addVariable("h_cr4_mt_count",      2, 0., 2.);
+  h.addVariable("h_cr4_dphi_dilep",   15, 0., TMath::Pi());
+  h.addVariable("h_cr4_dR_dilep",     15, 0., 5.);
+}
+
+static void bookCR5Plots( HistoGrid &h, const char *tags_selection )
+{
+  bookCRAxes(h, tags_selection, TAGS_FLAV_SL);
+
+  h.addVariable("h_cr5_met",         45, 50., 500.);
+  h.addVariable("h_cr5_leppt",       50, 0., 500.);
+  h.addVariable("h_cr5_isotrkpt",    50, 0., 500.);
+  h.addVariable("h_cr5_dphi_metlep", 15, 0., TMath::Pi());
+  h.addVariable("h_cr5_mt",          30, 0., 300.);
+  h.addVariable("h_cr5_mt_count",     2, 0., 2.);
+  h.addVariable("h_cr5_dphi_leptrk", 15, 0., TMath::Pi());
+  h.addVariable("h_cr5_dR_leptrk",   15, 0., 5.);
+}
+
 
 float StopTreeLooper::vtxweight_n( const int nvertices, TH1F *hist, bool isData ) 
 {
@@ -196,6 +299,20 @@ void StopTreeLooper::loop(TChain *chain, TString name)
   //z sample for yields etc
   std::map<std::string, TH1F*> h_1d_z;
 
+  //histograms filled in the event loop, declared up front
+  HistoGrid h_sig(h_1d_sig);
+  bookSIGPlots(h_sig);
+  HistoGrid h_cr1(h_1d_cr1);
+  bookCR1Plots(h_cr1, "_prebveto,");
+  HistoGrid h_cr1_preveto(h_1d_cr5);
+  bookCR1Plots(h_cr1_preveto, "_preveto");
+  HistoGrid h_cr2(h_1d_cr2);
+  bookCR2Plots(h_cr2, "_prebveto,");
+  HistoGrid h_cr4(h_1d_cr4);
+  bookCR4Plots(h_cr4, "");
+  HistoGrid h_cr5(h_1d_cr5);
+  bookCR5Plots(h_cr5, "_all,");
+
   // TFile* vtx_file = TFile::Open("vtxreweight/vtxreweight_Summer12_DR53X-PU_S10_9p7ifb_Zselection.root");
   // if( vtx_file == 0 ){
   //   cout << "vtxreweight error, couldn't open vtx file. Quitting!"<< endl;
@@ -295,10 +412,11 @@ void StopTreeLooper::loop(TChain *chain, TString name)
       // histogram tags
       //jet multiplicity
       string tag_njets = Form("_nj%i", (tree->npfjets30_<4) ? tree->npfjets30_ : 4);
-      //b-tagging
-      string tag_btag = (tree->nbtagscsvm_<1) ? "_bveto" : "";
-      //iso-trk-veto
-      string tag_isotrk = passIsoTrkVeto(tree) ? "" : "_wisotrk";
+      int i_njets = 1 + ((tree->npfjets30_<4) ? tree->npfjets30_ : 4);
+      //b-tagging: "_prebtag", "", "_bveto"
+      int i_btag   = (tree->nbtagscsvm_<1) ? 2 : 1;
+      //iso-trk-veto: "", "_wisotrk"
+      int i_isotrk = passIsoTrkVeto(tree) ? 0 : 1;
       //z-peak/veto
       string tag_zcut;
       if ( fabs( tree->dilmass_ - 91.) > 15. ) tag_zcut = "_zveto";
@@ -315,7 +433,8 @@ void StopTreeLooper::loop(TChain *chain, TString name)
       } 
      //to make plots for the two Kfactor bins
      //note this is to be used for the case where njets>=4
-     string tag_kbin = (njets_corr<4) ? "_K3" : "_K4";
+     //"", "_K3", "_K4"
+     int i_kbin = (njets_corr<4) ? 1 : 2;
 
      //event with true truth-level track
      bool hastruetrk = false;
@@ -329,13 +448,15 @@ void StopTreeLooper::loop(TChain *chain, TString name)
          if (tree->mcdecay2_==1 && tree->mcndec2_==1) hastruetrk = true;
        }
      }
-     string tag_truetrk = hastruetrk ? "_wtruetrk" : "_notruetrk";
+     //"", "_wtruetrk", "_notruetrk"
+     int i_truetrk = hastruetrk ? 1 : 2;
 
       //flavor types
-      string flav_tag_sl;
-      if ( abs(tree->id1_)==13 ) flav_tag_sl = "_muo";
-      else if ( abs(tree->id1_)==11 ) flav_tag_sl = "_ele";
-      else flav_tag_sl = "_mysterysl";
+      //"_muo", "_ele", "_mysterysl"
+      int i_flav_sl;
+      if ( abs(tree->id1_)==13 ) i_flav_sl = 0;
+      else if ( abs(tree->id1_)==11 ) i_flav_sl = 1;
+      else i_flav_sl = 2;
       string flav_tag_dl;
       if      ( abs(tree->id1_) == abs(tree->id2_) && abs(tree->id1_) == 13 ) flav_tag_dl = "_dimu";
       else if ( abs(tree->id1_) == abs(tree->id2_) && abs(tree->id1_) == 11 ) flav_tag_dl = "_diel";
@@ -344,6 +465,16 @@ void StopTreeLooper::loop(TChain *chain, TString name)
       else flav_tag_dl = "_mysterydl";
       string basic_flav_tag_dl = flav_tag_dl;
       if ( abs(tree->id1_) != abs(tree->id2_) ) basic_flav_tag_dl = "_mueg";
+      //same flavour tags as indices along the HistoGrid axes
+      //"_dimu", "_diel", "_muel", "_elmu", "_mysterydl"
+      int i_flav_dl;
+      if      ( abs(tree->id1_) == abs(tree->id2_) && abs(tree->id1_) == 13 ) i_flav_dl = 0;
+      else if ( abs(tree->id1_) == abs(tree->id2_) && abs(tree->id1_) == 11 ) i_flav_dl = 1;
+      else if ( abs(tree->id1_) != abs(tree->id2_) && abs(tree->id1_) == 13 ) i_flav_dl = 2;
+      else if ( abs(tree->id1_) != abs(tree->id2_) && abs(tree->id1_) == 11 ) i_flav_dl = 3;
+      else i_flav_dl = 4;
+      //"_dimu", "_diel", "_mueg", "_mysterydl"
+      int i_flav_dlbasic = ( abs(tree->id1_) != abs(tree->id2_) ) ? 2 : (i_flav_dl == 4 ? 3 : i_flav_dl);
 
       //Apply the MET phi corrections to the type1 met ---- this will eventually be updated in the babies
       pair<float, float> p_t1metphicorr = 
@@ -362,60 +493,14 @@ void StopTreeLooper::loop(TChain *chain, TString name)
       if ( passSingleLeptonSelection(tree, isData) && tree->npfjets30_>=4 )
 	{
 	  float trigweight = isData ? 1. : getsltrigweight(tree->id1_, tree->lep1_.Pt(), tree->lep1_.Eta());
-	  //default 
-	  makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag", 	    tag_kbin, flav_tag_sl, 150. );
-	  makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag,   	    tag_kbin, flav_tag_sl, 150. );
-	  makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+tag_truetrk, tag_kbin, flav_tag_sl, 150. );
-
-	  //met > 50 GeV requirement 
-	  if ( t1metphicorr > 50. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met50",  	       tag_kbin, flav_tag_sl, 150. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met50", 	       tag_kbin, flav_tag_sl, 150. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met50"+tag_truetrk, tag_kbin, flav_tag_sl, 150. );
-	  }
-	  //met > 100 GeV requirement 
-	  if ( t1metphicorr > 100. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met100",  		tag_kbin, flav_tag_sl, 150. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met100", 		tag_kbin, flav_tag_sl, 150. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met100"+tag_truetrk, tag_kbin, flav_tag_sl, 150. );
-	  }
-	  //met > 150 GeV requirement 
-	  if ( t1metphicorr > 150. ) { 
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met150",  		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met150", 		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met150"+tag_truetrk, tag_kbin, flav_tag_sl, 120. );
-	  }
-	  //met > 200 GeV requirement 
-	  if ( t1metphicorr > 200. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met200",  		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met200", 		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met200"+tag_truetrk, tag_kbin, flav_tag_sl, 120. );
+	  //default, then met > 50, 100, ... 400 GeV requirement
+	  for ( int m = 0; m < NMETCUTS; ++m ) {
+	    if ( m > 0 && !(t1metphicorr > metcuts[m]) ) break;
+	    float mtcut = metcuts[m] < 150. ? 150. : 120.;
+	    makeSIGPlots( tree, evtweight*trigweight, h_sig, i_isotrk, 0,      m, 0,         i_kbin, i_flav_sl, mtcut );
+	    makeSIGPlots( tree, evtweight*trigweight, h_sig, i_isotrk, i_btag, m, 0,         i_kbin, i_flav_sl, mtcut );
+	    makeSIGPlots( tree, evtweight*trigweight, h_sig, i_isotrk, i_btag, m, i_truetrk, i_kbin, i_flav_sl, mtcut );
 	  }
-	  //met > 250 GeV requirement 
-	  if ( t1metphicorr > 250. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met250",  		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met250", 		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met250"+tag_truetrk, tag_kbin, flav_tag_sl, 120. );
-	  }
-	  //met > 300 GeV requirement 
-	  if ( t1metphicorr > 300. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met300",  		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met300", 		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met300"+tag_truetrk, tag_kbin, flav_tag_sl, 120. );
-	  }
-	  //met > 350 GeV requirement 
-	  if ( t1metphicorr > 350. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met350",  		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met350", 		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met350"+tag_truetrk, tag_kbin, flav_tag_sl, 120. );
-	  }
-	  //met > 400 GeV requirement 
-	  if ( t1metphicorr > 400. ) {
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+"_prebtag_met400",  		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met400", 		tag_kbin, flav_tag_sl, 120. );
-	    makeSIGPlots( tree, evtweight*trigweight, h_1d_sig, tag_isotrk+tag_btag+"_met400"+tag_truetrk, tag_kbin, flav_tag_sl, 120. );
-	  }
-
 	}
 
       //
@@ -428,62 +513,14 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	{
 
 	  float trigweight = isData ? 1. : getsltrigweight(tree->id1_, tree->lep1_.Pt(), tree->lep1_.Eta());
-	  //default 
-	  makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto", tag_njets, tag_kbin, flav_tag_sl, 150. );
-	  //met > 50 GeV requirement 
-	  if ( t1metphicorr > 50. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met50", tag_njets, tag_kbin, flav_tag_sl, 150. );
-	  //met > 100 GeV requirement 
-	  if ( t1metphicorr > 100. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met100", tag_njets, tag_kbin, flav_tag_sl, 150. );
-	  //met > 150 GeV requirement 
-	  if ( t1metphicorr > 150. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met150", tag_njets, tag_kbin, flav_tag_sl, 120. );
-	  //met > 200 GeV requirement 
-	  if ( t1metphicorr > 200. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met200", tag_njets, tag_kbin, flav_tag_sl, 120. );
-	  //met > 250 GeV requirement 
-	  if ( t1metphicorr > 250. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met250", tag_njets, tag_kbin, flav_tag_sl, 120. );
-	  //met > 300 GeV requirement 
-	  if ( t1metphicorr > 300. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met300", tag_njets, tag_kbin, flav_tag_sl, 120. );
-	  //met > 350 GeV requirement 
-	  if ( t1metphicorr > 350. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met350", tag_njets, tag_kbin, flav_tag_sl, 120. );
-	  //met > 400 GeV requirement 
-	  if ( t1metphicorr > 400. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_prebveto_met400", tag_njets, tag_kbin, flav_tag_sl, 120. );
-	  
-	  if ( tree->nbtagscsvm_==0 ) {
-
-	    //default 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	    //met > 50 GeV requirement 
-	    if ( t1metphicorr > 50. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met50", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	    //met > 100 GeV requirement 
-	    if ( t1metphicorr > 100. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met100", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	    //met > 150 GeV requirement 
-	    if ( t1metphicorr > 150. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met150", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 200 GeV requirement 
-	    if ( t1metphicorr > 200. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met200", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 250 GeV requirement 
-	    if ( t1metphicorr > 250. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met250", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 300 GeV requirement 
-	    if ( t1metphicorr > 300. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met300", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 350 GeV requirement 
-	    if ( t1metphicorr > 350. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met350", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 400 GeV requirement 
-	    if ( t1metphicorr > 400. ) 
-	      makeCR1Plots( tree, evtweight*trigweight, h_1d_cr1, "_met400", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-
+	  //default, then met > 50, 100, ... 400 GeV requirement
+	  for ( int m = 0; m < NMETCUTS; ++m ) {
+	    if ( m > 0 && !(t1metphicorr > metcuts[m]) ) break;
+	    float mtcut = metcuts[m] < 150. ? 150. : 120.;
+	    //before b-tag veto
+	    makeCR1Plots( tree, evtweight*trigweight, h_cr1, 0, m, i_njets, i_kbin, i_flav_sl, mtcut );
+	    if ( tree->nbtagscsvm_==0 ) 
+	      makeCR1Plots( tree, evtweight*trigweight, h_cr1, 1, m, i_njets, i_kbin, i_flav_sl, mtcut );
 	  }
 	}
 
@@ -529,60 +566,14 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 		
 		float t1metphicorr_lep    = sqrt(metx*metx + mety*mety);
 		
-		//default 
-		makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto", tag_njets,  tag_kbin, basic_flav_tag_dl, 150. );
-		//pseudomet > 50 GeV requirement 
-		if ( t1metphicorr_lep > 50. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met50", tag_njets,  tag_kbin, basic_flav_tag_dl, 150. );
-		//pseudomet > 100 GeV requirement 
-		if ( t1metphicorr_lep > 100. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met100", tag_njets,  tag_kbin, basic_flav_tag_dl, 150. );
-		//pseudomet > 150 GeV requirement 
-		if ( t1metphicorr_lep > 150. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met150", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		//pseudomet > 200 GeV requirement 
-		if ( t1metphicorr_lep > 200. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met200", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		//pseudomet > 250 GeV requirement 
-		if ( t1metphicorr_lep > 250. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met250", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		//pseudomet > 300 GeV requirement 
-		if ( t1metphicorr_lep > 300. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met300", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		//pseudomet > 350 GeV requirement 
-		if ( t1metphicorr_lep > 350. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met350", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		//pseudomet > 400 GeV requirement 
-		if ( t1metphicorr_lep > 400. ) 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_prebveto_met400", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-
-		if ( tree->nbtagscsvm_==0) {
-		  //default 
-		  makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "", tag_njets,  tag_kbin, basic_flav_tag_dl, 150. );
-		  //pseudomet > 50 GeV requirement 
-		  if ( t1metphicorr_lep > 50. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_met50", tag_njets,  tag_kbin, basic_flav_tag_dl, 150. );
-		  //pseudomet > 100 GeV requirement 
-		  if ( t1metphicorr_lep > 100. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_met100", tag_njets,  tag_kbin, basic_flav_tag_dl, 150. );
-		  //pseudomet > 150 GeV requirement 
-		  if ( t1metphicorr_lep > 150. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_met150", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		  //pseudomet > 200 GeV requirement 
-		  if ( t1metphicorr_lep > 200. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_met200", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		  //pseudomet > 250 GeV requirement 
-		  if ( t1metphicorr_lep > 250. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2, "_met250", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		  //pseudomet > 300 GeV requirement 
-		  if ( t1metphicorr_lep > 300. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2,"_met300", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		  //pseudomet > 350 GeV requirement 
-		  if ( t1metphicorr_lep > 350. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2,"_met350", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
-		  //pseudomet > 400 GeV requirement 
-		  if ( t1metphicorr_lep > 400. ) 
-		    makeCR2Plots( tree, evtweight*trigweight, h_1d_cr2,"_met400", tag_njets,  tag_kbin, basic_flav_tag_dl, 120. );
+		//default, then pseudomet > 50, 100, ... 400 GeV requirement
+		for ( int m = 0; m < NMETCUTS; ++m ) {
+		  if ( m > 0 && !(t1metphicorr_lep > metcuts[m]) ) break;
+		  float mtcut = metcuts[m] < 150. ? 150. : 120.;
+		  //before b-tag veto
+		  makeCR2Plots( tree, evtweight*trigweight, h_cr2, 0, m, i_njets, i_kbin, i_flav_dlbasic, mtcut );
+		  if ( tree->nbtagscsvm_==0 ) 
+		    makeCR2Plots( tree, evtweight*trigweight, h_cr2, 1, m, i_njets, i_kbin, i_flav_dlbasic, mtcut );
 		}
 	      }
 	    }
@@ -630,33 +621,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
 	  if ( tree->npfjets30_ < 2 ) continue; 
 	  
-	  //default 
-	  makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "", tag_njets,  tag_kbin, flav_tag_dl, 150. );
-	  //met > 50 GeV requirement 
-	  if ( t1metphicorr > 50. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met50", tag_njets,  tag_kbin, flav_tag_dl, 150. );
-	  //met > 100 GeV requirement 
-	  if ( t1metphicorr > 100. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met100", tag_njets,  tag_kbin, flav_tag_dl, 150. );
-	  //met > 150 GeV requirement 
-	  if ( t1metphicorr > 150. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met150", tag_njets,  tag_kbin, flav_tag_dl, 120. );
-	  //met > 200 GeV requirement 
-	  if ( t1metphicorr > 200. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met200", tag_njets,  tag_kbin, flav_tag_dl, 120. );
-	  //met > 250 GeV requirement 
-	  if ( t1metphicorr > 250. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met250", tag_njets,  tag_kbin, flav_tag_dl, 120. );
-	  //met > 300 GeV requirement 
-	  if ( t1metphicorr > 300. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met300", tag_njets,  tag_kbin, flav_tag_dl, 120. );
-	  //met > 350 GeV requirement 
-	  if ( t1metphicorr > 350. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met350", tag_njets,  tag_kbin, flav_tag_dl, 120. );
-	  //met > 400 GeV requirement 
-	  if ( t1metphicorr > 400. ) 
-	    makeCR4Plots( tree, evtweight*trigweight, h_1d_cr4, "_met400", tag_njets,  tag_kbin, flav_tag_dl, 120. );
-	  
+	  //default, then met > 50, 100, ... 400 GeV requirement
+	  for ( int m = 0; m < NMETCUTS; ++m ) {
+	    if ( m > 0 && !(t1metphicorr > metcuts[m]) ) break;
+	    float mtcut = metcuts[m] < 150. ? 150. : 120.;
+	    makeCR4Plots( tree, evtweight*trigweight, h_cr4, 0, m, i_njets, i_kbin, i_flav_dl, mtcut );
+	  }
 	}
 
       ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -675,32 +645,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	{
 	  float trigweight = isData ? 1. : getsltrigweight(tree->id1_, tree->lep1_.Pt(), tree->lep1_.Eta());
 	  //inclusive sample
-	  //default 
-	  makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	  //met > 50 GeV requirement 
-	  if ( t1metphicorr > 50. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met50", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	  //met > 100 GeV requirement 
-	  if ( t1metphicorr > 100. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met100", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	  //met > 150 GeV requirement 
-	  if ( t1metphicorr > 150. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met150", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 200 GeV requirement 
-	  if ( t1metphicorr > 200. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met200", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 250 GeV requirement 
-	  if ( t1metphicorr > 250. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met250", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 300 GeV requirement 
-	  if ( t1metphicorr > 300. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met300", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 350 GeV requirement 
-	  if ( t1metphicorr > 350. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met350", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 400 GeV requirement 
-	  if ( t1metphicorr > 400. ) 
-	    makeCR1Plots( tree, evtweight*trigweight, h_1d_cr5, "_preveto_met400", tag_njets,  tag_kbin, flav_tag_sl, 120. );
+	  //default, then met > 50, 100, ... 400 GeV requirement
+	  for ( int m = 0; m < NMETCUTS; ++m ) {
+	    if ( m > 0 && !(t1metphicorr > metcuts[m]) ) break;
+	    float mtcut = metcuts[m] < 150. ? 150. : 120.;
+	    makeCR1Plots( tree, evtweight*trigweight, h_cr1_preveto, 0, m, i_njets, i_kbin, i_flav_sl, mtcut );
+	  }
 	}
       
       //
@@ -713,64 +663,15 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 	   && tree->nbtagscsvm_>0 ) 
 	{
 	  float trigweight = isData ? 1. : getsltrigweight(tree->id1_, tree->lep1_.Pt(), tree->lep1_.Eta());
-	  //inclusive sample
-	  //default 
-	  makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	  //met > 50 GeV requirement 
-	  if ( t1metphicorr > 50. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met50", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	  //met > 100 GeV requirement 
-	  if ( t1metphicorr > 100. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met100", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	  //met > 150 GeV requirement 
-	  if ( t1metphicorr > 150. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met150", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 200 GeV requirement 
-	  if ( t1metphicorr > 200. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met200", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 250 GeV requirement 
-	  if ( t1metphicorr > 250. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met250", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 300 GeV requirement 
-	  if ( t1metphicorr > 300. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met300", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 350 GeV requirement 
-	  if ( t1metphicorr > 350. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met350", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	  //met > 400 GeV requirement 
-	  if ( t1metphicorr > 400. ) 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_all_met400", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-
-	  // sample with only 1 lepton - this is the true CR5
-	  if ( tree->ngoodlep_ == 1 ) {
-
-	    //default 
-	    makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	    //met > 50 GeV requirement 
-	    if ( t1metphicorr > 50. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met50", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	    //met > 100 GeV requirement 
-	    if ( t1metphicorr > 100. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met100", tag_njets,  tag_kbin, flav_tag_sl, 150. );
-	    //met > 150 GeV requirement 
-	    if ( t1metphicorr > 150. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met150", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 200 GeV requirement 
-	    if ( t1metphicorr > 200. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met200", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 250 GeV requirement 
-	    if ( t1metphicorr > 250. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met250", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 300 GeV requirement 
-	    if ( t1metphicorr > 300. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met300", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 350 GeV requirement 
-	    if ( t1metphicorr > 350. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met350", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-	    //met > 400 GeV requirement 
-	    if ( t1metphicorr > 400. ) 
-	      makeCR5Plots( tree, evtweight*trigweight, h_1d_cr5, "_met400", tag_njets,  tag_kbin, flav_tag_sl, 120. );
-
+	  //default, then met > 50, 100, ... 400 GeV requirement
+	  for ( int m = 0; m < NMETCUTS; ++m ) {
+	    if ( m > 0 && !(t1metphicorr > metcuts[m]) ) break;
+	    float mtcut = metcuts[m] < 150. ? 150. : 120.;
+	    //inclusive sample
+	    makeCR5Plots( tree, evtweight*trigweight, h_cr5, 0, m, i_njets, i_kbin, i_flav_sl, mtcut );
+	    // sample with only 1 lepton - this is the true CR5
+	    if ( tree->ngoodlep_ == 1 ) 
+	      makeCR5Plots( tree, evtweight*trigweight, h_cr5, 1, m, i_njets, i_kbin, i_flav_sl, mtcut );
 	  }
 	}
 
@@ -1046,8 +947,8 @@ bool StopTreeLooper::passLepPlusIsoTrkSelection(const StopTree *sTree, bool isDa
 
 }
 
-void StopTreeLooper::makeCR2Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-				   string tag_selection, string tag_njets, string tag_kbin, string flav_tag_dl, float mtcut ) 
+void StopTreeLooper::makeCR2Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+				   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut ) 
 {
 
   //find positive lepton - this is the one that is combined with the pseudomet to form the mT
@@ -1069,252 +970,181 @@ void StopTreeLooper::makeCR2Plots( const StopTree *sTree, float evtweight, std::
     getMT( sTree->lep2_.Pt() , sTree->lep2_.Phi() , t1met10_lep , t1met10phi_lep ) :
     getMT( sTree->lep1_.Pt() , sTree->lep1_.Phi() , t1met10_lep , t1met10phi_lep );
 
-  //binning for mT plots
-  int nbins = 30;
-  float h_xmin = 0.;
-  float h_xmax = 300.;
-  float x_ovflw = h_xmax-0.001;
+  //overflow for the 300 GeV plots
+  float x_ovflw = 300.-0.001;
   
   float pseudomt_count = -1.;
   if ( t1met10mt_lep > min_mtpeak
        && t1met10mt_lep < max_mtpeak )    pseudomt_count = 0.5;
   else if ( t1met10mt_lep > mtcut ) pseudomt_count = 1.5;
-  
-  //default met
-  plot1D("h_cr2_met"+tag_selection          +flav_tag_dl, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_met"+tag_selection+tag_njets+flav_tag_dl, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_met"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  //pseudo-met
-  plot1D("h_cr2_pseudomet"+tag_selection	  +flav_tag_dl, min(t1met10_lep, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_pseudomet"+tag_selection+tag_njets+flav_tag_dl, min(t1met10_lep, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_pseudomet"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(t1met10_lep, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
+
+  //inclusive, njets bin, njets and kbin
+  int cells[3] = { h.cell(i_selection, i_met, 0, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, i_kbin, i_flav) };
+
   //positive lepton pt - enters mT calculation
   float leppt = isfirstp ? sTree->lep1_.Pt() : sTree->lep2_.Pt();
-  plot1D("h_cr2_leppt"+tag_selection          +flav_tag_dl, min(leppt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_leppt"+tag_selection+tag_njets+flav_tag_dl, min(leppt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_leppt"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(leppt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
   //angle between pos-lep and pseudopseudomet
   float dphi_pseudometlep = isfirstp ?
     getdphi( sTree->lep2_.Phi() , t1met10phi_lep ) :
     getdphi( sTree->lep1_.Phi() , t1met10phi_lep );
-  plot1D("h_cr2_dphi_pseudometlep"+tag_selection          +flav_tag_dl, dphi_pseudometlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr2_dphi_pseudometlep"+tag_selection+tag_njets+flav_tag_dl, dphi_pseudometlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr2_dphi_pseudometlep"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, dphi_pseudometlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  //pseudo-mt
-  plot1D("h_cr2_pseudomt"      +tag_selection          +flav_tag_dl, min(t1met10mt_lep, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_pseudomt"      +tag_selection+tag_njets+flav_tag_dl, min(t1met10mt_lep, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_pseudomt"      +tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(t1met10mt_lep, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr2_pseudomt_count"+tag_selection          +flav_tag_dl, pseudomt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr2_pseudomt_count"+tag_selection+tag_njets+flav_tag_dl, pseudomt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr2_pseudomt_count"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, pseudomt_count, evtweight, h_1d, 2, 0, 2);
+
+  for ( int c = 0; c < 3; ++c ) {
+    //default met
+    h.fill(CR2_MET,               cells[c], min(t1metphicorr, x_ovflw), evtweight);
+    //pseudo-met
+    h.fill(CR2_PSEUDOMET,         cells[c], min(t1met10_lep, x_ovflw), evtweight);
+    h.fill(CR2_LEPPT,             cells[c], min(leppt, x_ovflw), evtweight);
+    h.fill(CR2_DPHI_PSEUDOMETLEP, cells[c], dphi_pseudometlep, evtweight);
+    //pseudo-mt
+    h.fill(CR2_PSEUDOMT,          cells[c], min(t1met10mt_lep, x_ovflw), evtweight);
+    h.fill(CR2_PSEUDOMT_COUNT,    cells[c], pseudomt_count, evtweight);
+  }
 
 }
 
-void StopTreeLooper::makeCR4Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-				   string tag_selection, string tag_njets, string tag_kbin, string flav_tag_dl, float mtcut ) 
+void StopTreeLooper::makeCR4Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+				   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut ) 
 {
-  int nbins = 50;
-  float h_xmin = 0.;
-  float h_xmax = 500.;
-  float x_ovflw = h_xmax-0.001;
+  //overflow for the 500 GeV and the mT plots
+  float x_ovflw    = 500.-0.001;
+  float x_ovflw_mt = 300.-0.001;
   
   float mt_count = -1.;
   if ( t1metphicorrmt > min_mtpeak 
        && t1metphicorrmt < max_mtpeak )    mt_count = 0.5;
   else if ( t1metphicorrmt > mtcut ) mt_count = 1.5;
-  
-  //default met
-  plot1D("h_cr4_met"+tag_selection                   +flav_tag_dl, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  plot1D("h_cr4_met"+tag_selection+tag_njets         +flav_tag_dl, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  plot1D("h_cr4_met"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  //leading lepton pt - enters mT calculation
-  plot1D("h_cr4_leppt"+tag_selection                   +flav_tag_dl, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_leppt"+tag_selection+tag_njets         +flav_tag_dl, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_leppt"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  //leading lepton eta
-  plot1D("h_cr4_lepeta"+tag_selection                   +flav_tag_dl, sTree->lep1_.Eta(), evtweight, h_1d, 21, -2.1, 2.1);
-  plot1D("h_cr4_lepeta"+tag_selection+tag_njets         +flav_tag_dl, sTree->lep1_.Eta(), evtweight, h_1d, 21, -2.1, 2.1);
-  plot1D("h_cr4_lepeta"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, sTree->lep1_.Eta(), evtweight, h_1d, 21, -2.1, 2.1);
-  //subleading lepton pt
-  plot1D("h_cr4_subleadleppt"+tag_selection                   +flav_tag_dl, min(sTree->lep2_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_subleadleppt"+tag_selection+tag_njets         +flav_tag_dl, min(sTree->lep2_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_subleadleppt"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(sTree->lep2_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
+
   //angle between lead-lep and met
   float dphi_metlep = getdphi( sTree->lep1_.Phi() , t1metphicorrphi );
-  plot1D("h_cr4_dphi_metlep"+tag_selection                   +flav_tag_dl, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr4_dphi_metlep"+tag_selection+tag_njets         +flav_tag_dl, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr4_dphi_metlep"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  //MT
-  //binning for mT plots
-  nbins = 30;
-  h_xmin = 0.;
-  h_xmax = 300.;
-  x_ovflw = h_xmax-0.001;
-  plot1D("h_cr4_mt"+tag_selection                   +flav_tag_dl, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_mt"+tag_selection+tag_njets         +flav_tag_dl, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_mt"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr4_mt_count"+tag_selection                   +flav_tag_dl, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr4_mt_count"+tag_selection+tag_njets         +flav_tag_dl, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr4_mt_count"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, mt_count, evtweight, h_1d, 2, 0, 2);
-
-  //Plot more angles between various objects
   //angle between 2 leptons
   float dphi_dilep = getdphi( sTree->lep1_.Phi() ,  sTree->lep2_.Phi() );
-  plot1D("h_cr4_dphi_dilep"+tag_selection                   +flav_tag_dl, dphi_dilep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr4_dphi_dilep"+tag_selection+tag_njets         +flav_tag_dl, dphi_dilep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr4_dphi_dilep"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, dphi_dilep, evtweight, h_1d, 15, 0., TMath::Pi());
   //dR between 2 leptons
   float dR_dilep = dRbetweenVectors( sTree->lep1_ ,  sTree->lep2_ );
-  plot1D("h_cr4_dR_dilep"+tag_selection                   +flav_tag_dl, min(dR_dilep, (float)4.999), evtweight, h_1d, 15, 0., 5.);
-  plot1D("h_cr4_dR_dilep"+tag_selection+tag_njets         +flav_tag_dl, min(dR_dilep, (float)4.999), evtweight, h_1d, 15, 0., 5.);
-  plot1D("h_cr4_dR_dilep"+tag_selection+tag_njets+tag_kbin+flav_tag_dl, min(dR_dilep, (float)4.999), evtweight, h_1d, 15, 0., 5.);
+
+  //inclusive, njets bin, njets and kbin
+  int cells[3] = { h.cell(i_selection, i_met, 0, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, i_kbin, i_flav) };
+
+  for ( int c = 0; c < 3; ++c ) {
+    h.fill(CR4_MET,            cells[c], min(t1metphicorr, x_ovflw), evtweight);
+    //leading lepton pt - enters mT calculation
+    h.fill(CR4_LEPPT,          cells[c], min(sTree->lep1_.Pt(), x_ovflw), evtweight);
+    h.fill(CR4_LEPETA,         cells[c], sTree->lep1_.Eta(), evtweight);
+    h.fill(CR4_SUBLEADLEPPT,   cells[c], min(sTree->lep2_.Pt(), x_ovflw), evtweight);
+    h.fill(CR4_DPHI_METLEP,    cells[c], dphi_metlep, evtweight);
+    h.fill(CR4_MT,             cells[c], min(t1metphicorrmt, x_ovflw_mt), evtweight);
+    h.fill(CR4_MT_COUNT,       cells[c], mt_count, evtweight);
+    h.fill(CR4_DPHI_DILEP,     cells[c], dphi_dilep, evtweight);
+    h.fill(CR4_DR_DILEP,       cells[c], min(dR_dilep, (float)4.999), evtweight);
+  }
 
 }
 
-void StopTreeLooper::makeCR5Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-				   string tag_selection, string tag_njets, string tag_kbin, string flav_tag, float mtcut ) 
+void StopTreeLooper::makeCR5Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+				   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut ) 
 {
-
-  int nbins = 50;
-  float h_xmin = 0.;
-  float h_xmax = 500.;
-  float x_ovflw = h_xmax-0.001;
+  //overflow for the 500 GeV and the mT plots
+  float x_ovflw    = 500.-0.001;
+  float x_ovflw_mt = 300.-0.001;
   
   float mt_count = -1.;
   if ( t1metphicorrmt > min_mtpeak 
        && t1metphicorrmt < max_mtpeak )    mt_count = 0.5;
   else if ( t1metphicorrmt > mtcut ) mt_count = 1.5;
-  
-  //default met
-  plot1D("h_cr5_met"+tag_selection                   +flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  plot1D("h_cr5_met"+tag_selection+tag_njets         +flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  plot1D("h_cr5_met"+tag_selection+tag_njets+tag_kbin+flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  //leading lepton pt - enters mT calculation
-  plot1D("h_cr5_leppt"+tag_selection                   +flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_leppt"+tag_selection+tag_njets         +flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_leppt"+tag_selection+tag_njets+tag_kbin+flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  //isolated track pt
-  plot1D("h_cr5_isotrkpt"+tag_selection                   +flav_tag, min(sTree->pfcand10_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_isotrkpt"+tag_selection+tag_njets         +flav_tag, min(sTree->pfcand10_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_isotrkpt"+tag_selection+tag_njets+tag_kbin+flav_tag, min(sTree->pfcand10_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
+
   //angle between lead-lep and met
   float dphi_metlep = getdphi( sTree->lep1_.Phi() , t1metphicorrphi );
-  plot1D("h_cr5_dphi_metlep"+tag_selection                   +flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr5_dphi_metlep"+tag_selection+tag_njets         +flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr5_dphi_metlep"+tag_selection+tag_njets+tag_kbin+flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  //MT
-  //binning for mT plots
-  nbins = 30;
-  h_xmin = 0.;
-  h_xmax = 300.;
-  x_ovflw = h_xmax-0.001;
-  plot1D("h_cr5_mt"+tag_selection                   +flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_mt"+tag_selection+tag_njets         +flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_mt"+tag_selection+tag_njets+tag_kbin+flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr5_mt_count"+tag_selection                   +flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr5_mt_count"+tag_selection+tag_njets         +flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr5_mt_count"+tag_selection+tag_njets+tag_kbin+flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
-
-  //Plot more angles between various objects
   //angle between lepton and isolated track
   float dphi_leptrk = getdphi( sTree->lep1_.Phi() ,  sTree->pfcand10_.Phi() );
-  plot1D("h_cr5_dphi_leptrk"+tag_selection                   +flav_tag, dphi_leptrk, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr5_dphi_leptrk"+tag_selection+tag_njets         +flav_tag, dphi_leptrk, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr5_dphi_leptrk"+tag_selection+tag_njets+tag_kbin+flav_tag, dphi_leptrk, evtweight, h_1d, 15, 0., TMath::Pi());
   //dR between lepton and isolated track
   float dR_leptrk = dRbetweenVectors( sTree->lep1_ ,  sTree->pfcand10_ );
-  plot1D("h_cr5_dR_leptrk"+tag_selection                   +flav_tag, min(dR_leptrk, (float)4.999), evtweight, h_1d, 15, 0., 5.);
-  plot1D("h_cr5_dR_leptrk"+tag_selection+tag_njets         +flav_tag, min(dR_leptrk, (float)4.999), evtweight, h_1d, 15, 0., 5.);
-  plot1D("h_cr5_dR_leptrk"+tag_selection+tag_njets+tag_kbin+flav_tag, min(dR_leptrk, (float)4.999), evtweight, h_1d, 15, 0., 5.);
+
+  //inclusive, njets bin, njets and kbin
+  int cells[3] = { h.cell(i_selection, i_met, 0, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, i_kbin, i_flav) };
+
+  for ( int c = 0; c < 3; ++c ) {
+    h.fill(CR5_MET,            cells[c], min(t1metphicorr, x_ovflw), evtweight);
+    //leading lepton pt - enters mT calculation
+    h.fill(CR5_LEPPT,          cells[c], min(sTree->lep1_.Pt(), x_ovflw), evtweight);
+    h.fill(CR5_ISOTRKPT,       cells[c], min(sTree->pfcand10_.Pt(), x_ovflw), evtweight);
+    h.fill(CR5_DPHI_METLEP,    cells[c], dphi_metlep, evtweight);
+    h.fill(CR5_MT,             cells[c], min(t1metphicorrmt, x_ovflw_mt), evtweight);
+    h.fill(CR5_MT_COUNT,       cells[c], mt_count, evtweight);
+    h.fill(CR5_DPHI_LEPTRK,    cells[c], dphi_leptrk, evtweight);
+    h.fill(CR5_DR_LEPTRK,      cells[c], min(dR_leptrk, (float)4.999), evtweight);
+  }
 
 }
 
-void StopTreeLooper::makeSIGPlots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-				   string tag_selection, string tag_kbin, string flav_tag, float mtcut ) 
+void StopTreeLooper::makeSIGPlots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+				   int i_isotrk, int i_btag, int i_met, int i_truetrk, int i_kbin, int i_flav, float mtcut ) 
 {
-
-  int nbins = 50;
-  float h_xmin = 0.;
-  float h_xmax = 500.;
-  float x_ovflw = h_xmax-0.001;
+  //overflow for the 500 GeV and the mT plots
+  float x_ovflw    = 500.-0.001;
+  float x_ovflw_mt = 300.-0.001;
   
   float mt_count = -1.;
   if ( t1metphicorrmt > min_mtpeak 
        && t1metphicorrmt < max_mtpeak )    mt_count = 0.5;
   else if ( t1metphicorrmt > mtcut ) mt_count = 1.5;
-  
-  //default met
-  plot1D("h_sig_met"+tag_selection         +flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50, h_xmax);
-  plot1D("h_sig_met"+tag_selection+tag_kbin+flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50, h_xmax);
-  //lepton pt - enters mT calculation
-  plot1D("h_sig_leppt"+tag_selection         +flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_sig_leppt"+tag_selection+tag_kbin+flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
+
   //angle between lepton and met
   float dphi_metlep = getdphi( sTree->lep1_.Phi() , t1metphicorrphi );
-  plot1D("h_sig_dphi_metlep"+tag_selection         +flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_sig_dphi_metlep"+tag_selection+tag_kbin+flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  //MT
-  //binning for mT plots
-  nbins = 30;
-  h_xmin = 0.;
-  h_xmax = 300.;
-  x_ovflw = h_xmax-0.001;
-  plot1D("h_sig_mt"+tag_selection         +flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_sig_mt"+tag_selection+tag_kbin+flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_sig_mt_count"+tag_selection         +flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_sig_mt_count"+tag_selection+tag_kbin+flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
+
+  //inclusive, kbin
+  int cells[2] = { h.cell(i_isotrk, i_btag, i_met, i_truetrk, 0, i_flav),
+		   h.cell(i_isotrk, i_btag, i_met, i_truetrk, i_kbin, i_flav) };
+
+  for ( int c = 0; c < 2; ++c ) {
+    h.fill(SIG_MET,         cells[c], min(t1metphicorr, x_ovflw), evtweight);
+    //lepton pt - enters mT calculation
+    h.fill(SIG_LEPPT,       cells[c], min(sTree->lep1_.Pt(), x_ovflw), evtweight);
+    h.fill(SIG_DPHI_METLEP, cells[c], dphi_metlep, evtweight);
+    h.fill(SIG_MT,          cells[c], min(t1metphicorrmt, x_ovflw_mt), evtweight);
+    h.fill(SIG_MT_COUNT,    cells[c], mt_count, evtweight);
+  }
 
 }
 
-void StopTreeLooper::makeCR1Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-				   string tag_selection, string tag_njets, string tag_kbin, string flav_tag, float mtcut ) 
+void StopTreeLooper::makeCR1Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+				   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut ) 
 {
-
-  int nbins = 50;
-  float h_xmin = 0.;
-  float h_xmax = 500.;
-  float x_ovflw = h_xmax-0.001;
+  //overflow for the 500 GeV and the mT plots
+  float x_ovflw    = 500.-0.001;
+  float x_ovflw_mt = 300.-0.001;
 
   float mt_count = -1.;
   if ( t1metphicorrmt > min_mtpeak 
        && t1metphicorrmt < max_mtpeak )    mt_count = 0.5;
   else if ( t1metphicorrmt > mtcut ) mt_count = 1.5;
-  
-  plot1D("h_cr1_njets"    +tag_selection+flav_tag, min(sTree->npfjets30_,4),  evtweight, h_1d, 5,0,5);
-  plot1D("h_cr1_njets_all"+tag_selection+flav_tag, min(sTree->npfjets30_,9),  evtweight, h_1d, 10, 0, 10);
-  //default met
-  plot1D("h_cr1_met"+tag_selection                   +flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  plot1D("h_cr1_met"+tag_selection+tag_njets         +flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  plot1D("h_cr1_met"+tag_selection+tag_njets+tag_kbin+flav_tag, min(t1metphicorr, x_ovflw), evtweight, h_1d, nbins-5, 50., h_xmax);
-  //lepton pt - enters mT calculation
-  plot1D("h_cr1_leppt"+tag_selection                   +flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr1_leppt"+tag_selection+tag_njets         +flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr1_leppt"+tag_selection+tag_njets+tag_kbin+flav_tag, min(sTree->lep1_.Pt(), x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  //lepton phi
-  plot1D("h_cr1_lepphi"+tag_selection                   +flav_tag, sTree->lep1_.Phi(), evtweight, h_1d, 30, -1.*TMath::Pi(), TMath::Pi());
-  plot1D("h_cr1_lepphi"+tag_selection+tag_njets         +flav_tag, sTree->lep1_.Phi(), evtweight, h_1d, 30, -1.*TMath::Pi(), TMath::Pi());
-  plot1D("h_cr1_lepphi"+tag_selection+tag_njets+tag_kbin+flav_tag, sTree->lep1_.Phi(), evtweight, h_1d, 30, -1.*TMath::Pi(), TMath::Pi());
-  //met phi
-  plot1D("h_cr1_metphi"+tag_selection                   +flav_tag, t1metphicorrphi, evtweight, h_1d, 30, -1.*TMath::Pi(), TMath::Pi());
-  plot1D("h_cr1_metphi"+tag_selection+tag_njets         +flav_tag, t1metphicorrphi, evtweight, h_1d, 30, -1.*TMath::Pi(), TMath::Pi());
-  plot1D("h_cr1_metphi"+tag_selection+tag_njets+tag_kbin+flav_tag, t1metphicorrphi, evtweight, h_1d, 30, -1.*TMath::Pi(), TMath::Pi());
+
   //angle between lepton and met
   float dphi_metlep = getdphi( sTree->lep1_.Phi() , t1metphicorrphi );
-  plot1D("h_cr1_dphi_metlep"+tag_selection                   +flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr1_dphi_metlep"+tag_selection+tag_njets         +flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  plot1D("h_cr1_dphi_metlep"+tag_selection+tag_njets+tag_kbin+flav_tag, dphi_metlep, evtweight, h_1d, 15, 0., TMath::Pi());
-  //MT
-  //binning for mT plots
-  nbins = 30;
-  h_xmin = 0.;
-  h_xmax = 300.;
-  x_ovflw = h_xmax-0.001;
-  plot1D("h_cr1_mt"+tag_selection                   +flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr1_mt"+tag_selection+tag_njets         +flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr1_mt"+tag_selection+tag_njets+tag_kbin+flav_tag, min(t1metphicorrmt, x_ovflw), evtweight, h_1d, nbins, h_xmin, h_xmax);
-  plot1D("h_cr1_mt_count"+tag_selection                   +flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr1_mt_count"+tag_selection+tag_njets         +flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
-  plot1D("h_cr1_mt_count"+tag_selection+tag_njets+tag_kbin+flav_tag, mt_count, evtweight, h_1d, 2, 0, 2);
+
+  //inclusive, njets bin, njets and kbin
+  int cells[3] = { h.cell(i_selection, i_met, 0, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, 0, i_flav),
+		   h.cell(i_selection, i_met, i_njets, i_kbin, i_flav) };
+
+  //jet multiplicity, inclusive only
+  h.fill(CR1_NJETS,     cells[0], min(sTree->npfjets30_,4), evtweight);
+  h.fill(CR1_NJETS_ALL, cells[0], min(sTree->npfjets30_,9), evtweight);
+
+  for ( int c = 0; c < 3; ++c ) {
+    h.fill(CR1_MET,         cells[c], min(t1metphicorr, x_ovflw), evtweight);
+    //lepton pt - enters mT calculation
+    h.fill(CR1_LEPPT,       cells[c], min(sTree->lep1_.Pt(), x_ovflw), evtweight);
+    h.fill(CR1_LEPPHI,      cells[c], sTree->lep1_.Phi(), evtweight);
+    h.fill(CR1_METPHI,      cells[c], t1metphicorrphi, evtweight);
+    h.fill(CR1_DPHI_METLEP, cells[c], dphi_metlep, evtweight);
+    h.fill(CR1_MT,          cells[c], min(t1metphicorrmt, x_ovflw_mt), evtweight);
+    h.fill(CR1_MT_COUNT,    cells[c], mt_count, evtweight);
+  }
 
 }
 
@@ -15,6 +15,7 @@
 using namespace std;
 
 class StopTree;
+class HistoGrid;
 
 class StopTreeLooper {
 
@@ -37,16 +38,16 @@ class StopTreeLooper {
 	bool passIsoTrkVeto(const StopTree *sTree);
 
 	//plotting
-	void makeSIGPlots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-			   string tag_selection, string tag_kbin, string flav_tag, float mtcut ); 
-	void makeCR1Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-			   string tag_selection, string tag_njets, string tag_kbin, string flav_tag, float mtcut ); 
-	void makeCR2Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-			   string tag_selection, string tag_njets, string tag_kbin, string flav_tag_dl, float mtcut );
-	void makeCR4Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-			   string tag_selection, string tag_njets, string tag_kbin, string flav_tag_dl, float mtcut );
-	void makeCR5Plots( const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
-			   string tag_selection, string tag_njets, string tag_kbin, string flav_tag_dl, float mtcut );
+	void makeSIGPlots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+			   int i_isotrk, int i_btag, int i_met, int i_truetrk, int i_kbin, int i_flav, float mtcut ); 
+	void makeCR1Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+			   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut ); 
+	void makeCR2Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+			   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut );
+	void makeCR4Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+			   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut );
+	void makeCR5Plots( const StopTree *sTree, float evtweight, HistoGrid &h, 
+			   int i_selection, int i_met, int i_njets, int i_kbin, int i_flav, float mtcut );
 	void makeNJPlots(  const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
 			   string tag_selection, string flav_tag ); 
 	void makeZPlots(   const StopTree *sTree, float evtweight, std::map<std::string, TH1F*> &h_1d, 
@@ -5,7 +5,10 @@
 #pragma link off all classes;
 #pragma link C++ all functions;
 
-#pragma link C++ class StopTreeLooper;
+#pragma link C++ struct TrainEvent;
+#pragma link C++ class TrainAnalyzer;
+#pragma link C++ class AnalysisTrain;
+#pragma link C++ class CRLooper;
 #pragma link C++ class Candidate;
 #pragma link C++ class vector<Candidate>;
 
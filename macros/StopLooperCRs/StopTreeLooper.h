@@ -1,5 +1,5 @@
-#ifndef STOPTREELOOPER_H
-#define STOPTREELOOPER_H
+#ifndef CRLOOPER_H
+#define CRLOOPER_H
 
 #include "TChain.h"
 #include "TFile.h"
@@ -13,38 +13,52 @@
 #include <cmath>
 #include <map>
 
+#include "../Core/AnalysisTrain.h"
+
 using namespace std;
 
-class StopTreeLooper {
+class BTagShapeInterface;
+
+// runs on its own with loop(), or as one analyzer of an AnalysisTrain
+class CRLooper : public TrainAnalyzer {
 
     public:
   typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
 
-        StopTreeLooper();
-        ~StopTreeLooper();
+        CRLooper();
+        ~CRLooper();
  
         void setOutFileName(string filename); 
         void loop(TChain *chain, TString name);
 
+	void begin(const TString& sample, bool isData);
+	void analyze(const TrainEvent& evt);
+	void end();
+	bool mergeable() const { return true; }
+
 	//plotting
-	void makeSIGPlots(float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeSIGPlots(float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag, float mtcut ); 
-	void makeCR1Plots(float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeCR1Plots(float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag, float mtcut ); 
-	void makeCR2Plots(float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeCR2Plots(float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag_dl, float mtcut );
-	void makeCR4Plots(float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeCR4Plots(float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag_dl, float mtcut );
-	void makeCR5Plots(float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeCR5Plots(float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag_dl, float mtcut );
-	void makeNJPlots( float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeNJPlots( float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag ); 
-	void makeZPlots(  float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeZPlots(  float evtweight, const string& prefix, 
 			   string tag_selection, string flav_tag );
 
     private:
 
 	string m_outfilename_;
+	TString m_sample_;
+	// csv reshaping and true pu weights, loaded once
+	BTagShapeInterface * nominalShape;
+	TH1F* h_pu_wgt;
 	// njets requirement
 	int min_njets;
 	//for phi corrected met
@@ -1,5 +1,5 @@
-#ifndef STOPTREELOOPER_H
-#define STOPTREELOOPER_H
+#ifndef HIGGSLOOPER_H
+#define HIGGSLOOPER_H
 
 #include "TChain.h"
 #include "TFile.h"
@@ -13,23 +13,33 @@
 #include <cmath>
 #include <map>
 
+#include "../Core/AnalysisTrain.h"
+
 using namespace std;
 
-class StopTreeLooper {
+class BTagShapeInterface;
+
+// runs on its own with loop(), or as one analyzer of an AnalysisTrain
+class HiggsLooper : public TrainAnalyzer {
 
     public:
   typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
 
-        StopTreeLooper();
-        ~StopTreeLooper();
+        HiggsLooper();
+        ~HiggsLooper();
  
         void setOutFileName(string filename); 
         void loop(TChain *chain, TString name);
 
+	void begin(const TString& sample, bool isData);
+	void analyze(const TrainEvent& evt);
+	void end();
+	bool mergeable() const { return true; }
+
 	//plotting
-	void makeSIGPlots(float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeSIGPlots(float evtweight, 
 			  string tag_selection, string flav_tag, float mtcut ); 
-	void makeMinSIGPlots( float evtweight, std::map<std::string, TH1F*> &h_1d, 
+	void makeMinSIGPlots( float evtweight, 
 			      string tag_selection, string flav_tag, 
 			      float mtcut, float mbbval );
 	//calculate mbb
@@ -39,6 +49,15 @@ class StopTreeLooper {
     private:
 
 	string m_outfilename_;
+	TString m_sample_;
+	bool isttbar;
+	// csv reshaping and its variations, true pu weights, loaded once
+	BTagShapeInterface * nominalShape;
+	BTagShapeInterface * upBCShape;
+	BTagShapeInterface * downBCShape;
+	BTagShapeInterface * upLShape;
+	BTagShapeInterface * downLShape;
+	TH1F* h_pu_wgt;
 	// njets requirement
 	int min_njets;
 	int min_nbjets;
@@ -5,6 +5,9 @@
 #pragma link off all classes;
 #pragma link C++ all functions;
 
+#pragma link C++ struct TrainEvent;
+#pragma link C++ class TrainAnalyzer;
+#pragma link C++ class AnalysisTrain;
 #pragma link C++ class StopTreeLooper;
 #pragma link C++ class Candidate;
 #pragma link C++ class vector<Candidate>;
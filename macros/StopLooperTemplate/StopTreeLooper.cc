@@ -15,7 +15,6 @@
 #include "TROOT.h"
 #include "TH1F.h"
 #include "TH2F.h"
-#include "TChainElement.h"
 #include "TFile.h"
 #include "TMath.h"
 #include "TChain.h"
@@ -29,11 +28,8 @@
 
 using namespace Stop;
 
-std::set<DorkyEventIdentifier> already_seen; 
-std::set<DorkyEventIdentifier> events_lasercalib; 
-std::set<DorkyEventIdentifier> events_hcallasercalib; 
-
 StopTreeLooper::StopTreeLooper()
+  : TrainAnalyzer("StopLooperTemplate")
 {
   m_outfilename_ = "histos.root";
   t1metphicorr = -9999.;
@@ -57,22 +53,20 @@ void StopTreeLooper::setOutFileName(string filename)
 
 void StopTreeLooper::loop(TChain *chain, TString name)
 {
+  // the file loop, duplicate removal and event weight live in AnalysisTrain
+  AnalysisTrain train;
+  train.add(this);
+  train.run(chain, name);
+}
 
-  //------------------------------
-  // check for valid chain
-  //------------------------------
+//--------------------------------------------------------------------
 
-  printf("[StopTreeLooper::loop] %s\n", name.Data());
+void StopTreeLooper::begin(const TString& sample, bool isData)
+{
 
-  load_badlaserevents("../Core/badlaser_events.txt", events_lasercalib);
-  load_badlaserevents("../Core/badhcallaser_events.txt", events_hcallasercalib);
+  printf("[StopTreeLooper::begin] %s\n", sample.Data());
 
-  TObjArray *listOfFiles = chain->GetListOfFiles();
-  TIter fileIter(listOfFiles);
-  if (listOfFiles->GetEntries() == 0) {
-    cout << "[StopTreeLooper::loop] no files in chain" << endl;
-    return;
-  }
+  m_sample_ = sample;
 
   //------------------------------
   // set up histograms
@@ -80,9 +74,8 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
   gROOT->cd();
 
-  cout << "[StopTreeLooper::loop] setting up histos" << endl;
-
-  std::map<std::string, TH1F*> h_1d;
+  // histograms are filled with hists(), which lets the train split the
+  // files among workers; anything kept outside of it needs mergeable() false
 
   //------------------------------
   // vtx reweighting
@@ -97,120 +90,60 @@ void StopTreeLooper::loop(TChain *chain, TString name)
   // TH1F* h_vtx_wgt = (TH1F*)vtx_file->Get("hratio");
   // h_vtx_wgt->SetName("h_vtx_wgt");
 
-  //------------------------------
-  // file loop
-  //------------------------------
+}
 
-  unsigned int nEventsChain=0;
-  unsigned int nEvents = chain->GetEntries();
-  nEventsChain = nEvents;
-  ULong64_t nEventsTotal = 0;
-  //  ULong64_t i_permille_old = 0;
-
-  bool isData = name.Contains("data") ? true : false;
-
-  while (TChainElement *currentFile = (TChainElement*)fileIter.Next()) {
-
-    //----------------------------
-    // load the stop baby tree
-    //----------------------------
-
-    TFile *file = new TFile( currentFile->GetTitle() );
-    TTree *tree = (TTree*)file->Get("t");
-    stopt.Init(tree);
-
-    //----------------------------
-    // event loop
-    //----------------------------
-
-    ULong64_t nEvents = tree->GetEntriesFast();
-    for(ULong64_t event = 0; event < nEvents; ++event) {
-      stopt.GetEntry(event);
-
-      //----------------------------
-      // increment counters
-      //----------------------------
-
-      ++nEventsTotal;
-      if (nEventsTotal%10000==0) {
-	ULong64_t i_permille = (int)floor(1000 * nEventsTotal / float(nEventsChain));
-	//if (i_permille != i_permille_old) {//this prints too often!
-	// xterm magic from L. Vacavant and A. Cerri
-	if (isatty(1)) {
-	  printf("\015\033[32m ---> \033[1m\033[31m%4.1f%%"
-		 "\033[0m\033[32m <---\033[0m\015", i_permille/10.);
-	  fflush(stdout);
-	}
-	//	i_permille_old = i_permille;
-      }
-
-      //---------------------
-      // skip duplicates
-      //---------------------
-
-      if( isData ) {
-        DorkyEventIdentifier id = {stopt.run(), stopt.event(), stopt.lumi() };
-        if (is_duplicate(id, already_seen) ){
-          continue;
-        }
-	if (is_badLaserEvent(id,events_lasercalib) ){
-	  //std::cout<< "Removed bad laser calibration event:" << run << "   " << event<<"\n";
-	  continue;
-	}
-	if (is_badLaserEvent(id,events_hcallasercalib) ){
-	  //std::cout<< "Removed bad hcal laser calibration event:" << run << "   " << event<<"\n";
-	  continue;
-	}
-      }
-
-      //---------------------------------------------------------------------------- 
-      // determine event weight
-      // make 2 example histograms of nvtx and corresponding weight
-      //---------------------------------------------------------------------------- 
-
-      float evtweight = isData ? 1. : ( stopt.weight() * 19.5 * stopt.nvtxweight() * stopt.mgcor() );
-      // to reweight from file - also need to comment stuff before
-      //      float vtxweight = vtxweight_n( nvtx, h_vtx_wgt, isData );
-
-      plot1D("h_vtx",       stopt.nvtx(),       evtweight, h_1d, 40, 0, 40);
-      plot1D("h_vtxweight", stopt.nvtxweight(), evtweight, h_1d, 41, -4., 4.);
-
-      //----------------------------------------------------------------------------
-      // apply preselection:
-      // rho 0-40 GeV, MET filters, >=1 good lepton, veto 2 leptons dR < 0.1
-      //----------------------------------------------------------------------------
-
-      if ( !passEvtSelection(name) ) continue;
-
-      //----------------------------------------------------------------------------
-      // Function to perform MET phi corrections on-the-fly
-      // Default branches are: tree->t1metphicorr_ and tree->t1metphicorrmt_
-      //----------------------------------------------------------------------------
-
-      // pair<float, float> p_t1metphicorr = 
-      // 	getPhiCorrMET( stopt.t1met10(), stopt.t1met10phi(), stopt.nvtx(), !isData);
-      // t1metphicorr    = p_t1metphicorr.first;
-      // t1metphicorrphi = p_t1metphicorr.second;
-      // t1metphicorrmt  = getMT( stopt.lep1().Pt() , stopt.lep1().Phi() , t1metphicorr , t1metphicorrphi );  
-
-
-      //----------------------------------------------------------------------------
-      // ADD CODE BELOW THIS LINE
-      //----------------------------------------------------------------------------
-
-
-    } // end event loop
-
-    // delete tree;
-    
-  } // end file loop
-  
-    //
-    // finish
-    //
+//--------------------------------------------------------------------
+
+void StopTreeLooper::analyze(const TrainEvent& evt)
+{
+
+  //---------------------------------------------------------------------------- 
+  // event weight: 1 for data, weight * 19.5/fb * nvtxweight * mgcor for MC
+  // make 2 example histograms of nvtx and corresponding weight
+  //---------------------------------------------------------------------------- 
+
+  float evtweight = evt.weight;
+  // to reweight from file - also need to comment stuff before
+  //      float vtxweight = vtxweight_n( nvtx, h_vtx_wgt, evt.isData );
+
+  hists().fill("h_vtx",       stopt.nvtx(),       evtweight, 40, 0, 40);
+  hists().fill("h_vtxweight", stopt.nvtxweight(), evtweight, 41, -4., 4.);
+
+  //----------------------------------------------------------------------------
+  // apply preselection:
+  // rho 0-40 GeV, MET filters, >=1 good lepton, veto 2 leptons dR < 0.1
+  //----------------------------------------------------------------------------
+
+  if ( !passEvtSelection(m_sample_) ) return;
+
+  //----------------------------------------------------------------------------
+  // Function to perform MET phi corrections on-the-fly
+  // Default branches are: tree->t1metphicorr_ and tree->t1metphicorrmt_
+  //----------------------------------------------------------------------------
+
+  // pair<float, float> p_t1metphicorr = 
+  // 	getPhiCorrMET( stopt.t1met10(), stopt.t1met10phi(), stopt.nvtx(), !evt.isData);
+  // t1metphicorr    = p_t1metphicorr.first;
+  // t1metphicorrphi = p_t1metphicorr.second;
+  // t1metphicorrmt  = getMT( stopt.lep1().Pt() , stopt.lep1().Phi() , t1metphicorr , t1metphicorrphi );  
+
+
+  //----------------------------------------------------------------------------
+  // ADD CODE BELOW THIS LINE
+  //----------------------------------------------------------------------------
+
+}
+
+//--------------------------------------------------------------------
+
+void StopTreeLooper::end()
+{
   
+  std::map<std::string, TH1F*> h_1d;
+  mergedHists().makeHists(h_1d);
+
   TFile outfile(m_outfilename_.c_str(),"RECREATE") ; 
-  printf("[StopTreeLooper::loop] Saving histograms to %s\n", m_outfilename_.c_str());
+  printf("[StopTreeLooper::end] Saving histograms to %s\n", m_outfilename_.c_str());
   
   std::map<std::string, TH1F*>::iterator it1d;
   for(it1d=h_1d.begin(); it1d!=h_1d.end(); it1d++) {
@@ -221,9 +154,6 @@ void StopTreeLooper::loop(TChain *chain, TString name)
   outfile.Write();
   outfile.Close();
 
-  already_seen.clear();
-
   gROOT->cd();
 
 }
-
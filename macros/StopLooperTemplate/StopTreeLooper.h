@@ -13,9 +13,12 @@
 #include <cmath>
 #include <map>
 
+#include "../Core/AnalysisTrain.h"
+
 using namespace std;
 
-class StopTreeLooper {
+// runs on its own with loop(), or as one analyzer of an AnalysisTrain
+class StopTreeLooper : public TrainAnalyzer {
 
     public:
   typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float> > LorentzVector;
@@ -26,9 +29,15 @@ class StopTreeLooper {
         void setOutFileName(string filename); 
         void loop(TChain *chain, TString name);
 
+	void begin(const TString& sample, bool isData);
+	void analyze(const TrainEvent& evt);
+	void end();
+	bool mergeable() const { return true; }
+
     private:
 
 	string m_outfilename_;
+	TString m_sample_;
 	//for phi corrected met
 	float t1metphicorr;
 	float t1metphicorrphi;
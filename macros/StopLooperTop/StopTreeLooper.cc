@@ -411,7 +411,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
 			// get list of candidates
 			PartonCombinatorics pc (jets, btag, sigma_jets, mc, *lep, met, metphi, isData);
-			list<Candidate> allcandidates = pc.candidates_;
+			const CANDIDATES& allcandidates = pc.candidates_;
 
 
 			assert( jets.size() == btag.size() );
@@ -442,7 +442,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
 			plot1D("h_ncand", Min((int)allcandidates.size(),49) , evtweight , h_1d , 50, 0, 50);
 
-			list<Candidate>::iterator candIter;
+			CANDIDATES::const_iterator candIter;
 			for(candIter = allcandidates.begin() ; candIter != allcandidates.end() ; candIter++ ){
 
 				float cand_mt2w = candIter->mt2w;
@@ -462,12 +462,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
 
 			//require at least 1 btag
 			if (tree->nbtagscsvm_<1) continue;
-			list<Candidate> candidates = pc.b_candidates_;
+			const CANDIDATES& candidates = pc.b_candidates_;
 			MT2CHI2 mc = pc.getMt2Chi2();
 
 			plot1D("h_nbcand", Min((int)candidates.size(),49) , evtweight , h_1d , 50, 0, 50);
 
-			list<Candidate>::iterator candIterB;
+			CANDIDATES::const_iterator candIterB;
 			for(candIterB = candidates.begin() ; candIterB != candidates.end() ; candIterB++ ){
 
 				float cand_mt2w = candIterB->mt2w;
@@ -5,7 +5,12 @@ RPATH=/nfs-3/userdata/stop/output_V00-02-04_2012_4jskim
 #declare -a Samples=(T2tt_250_0 T2tt_350_0 T2tt_450_0 T2tt_300_5 T2tt_300_100 ttdl_powheg ttsl_powheg w1to4jets data_muo data_ele data_diel data_dimu ttV diboson triboson tW data_mueg DYStitchtot)
 declare -a Samples=(T2tt_250_0 T2tt_350_0 T2tt_450_0 T2tt_300_5 T2tt_300_100 ttdl_powheg ttsl_powheg)
 
+# one task per sample, cost = input size so the largest start first;
+# ../runTasks.py -h for the concurrency, memory and retry options
+mkdir -p log
+: > log/tasks.txt
 for SAMPLE in ${Samples[@]}
-  do root -b -q -l do.C\(\"$RPATH\",\"$SAMPLE\"\) &
+  do echo "${SAMPLE} `du -cbL $RPATH/${SAMPLE}*.root 2>/dev/null | tail -1 | cut -f1` - root -b -q -l do.C\(\\\"$RPATH\\\",\\\"$SAMPLE\\\"\)" >> log/tasks.txt
 done
-wait
+
+../runTasks.py -l log log/tasks.txt
@@ -9,8 +9,11 @@
 #include "STOPT.h"
 #include "stopUtils.h"
 #include "../Plotting/PlotUtilities.h"
+#include "../Plotting/MultiWeightHisto.h"
 #include "../../Tools/BTagReshaping/BTagReshaping.h"
 #include "LHAPDF/LHAPDF.h"
+#include "nuSolutions.h"
+#include "pdfLuminosity.h"
 
 #include "TROOT.h"
 #include "TH1D.h"
@@ -38,6 +41,8 @@ std::set<DorkyEventIdentifier> already_seen;
 std::set<DorkyEventIdentifier> events_lasercalib;
 std::set<DorkyEventIdentifier> events_hcallasercalib;
 
+PDFLuminosityCache pdfLuminosity;
+
 struct indCSV{
     float CSVdisc;
     int ind;
@@ -78,8 +83,12 @@ bool systidisoeffweighting = false;
 
 bool weighttaudecay = false;
 bool calculatePDFsystweights = false;
+bool fillWeightVariations = false; //fill the weight-only systematics (PU, top pT, id/iso, PDF members) for the SIG asymmetry plots in the same pass, written to SYST<outfile>; set by the systematics jobs through setFillWeightVariations
+bool usePDFLuminosityCache = true; //interpolate the AMWT PDF weight from a table made at startup instead of calling LHAPDF per solution; off if the table fails its check against LHAPDF
+bool crossCheckNuSolver = false; //also run nuSolutions.py through TPython and compare with the native solver (slow)
+bool nuSolverMultiStart = false; //closest approach: start the least-squares search from 4 points instead of the python's single (0,0)
 
-//these values are also hard-coded in nuSolutions.py
+//these values are also hard-coded in nuSolutions.py and nuSolutions.h
 const double mb_solver = 4.8;
 const double mW_solver = 80.385;
 const double mt_solver = 172.5;
@@ -127,6 +136,11 @@ void StopTreeLooper::setOutFileName(string filename)
 
 }
 
+void StopTreeLooper::setFillWeightVariations(bool fill)
+{
+    fillWeightVariations = fill;
+}
+
 void StopTreeLooper::loop(TChain *chain, TString name)
 {
 
@@ -160,16 +174,18 @@ void StopTreeLooper::loop(TChain *chain, TString name)
     }
 
     //------------------------------------------------------------------------------------------------------
-    // load Betchart solver, and PDFs for AMWT weight
+    // load Betchart solver (python reference only needed for the cross-check), and PDFs for AMWT weight
     //------------------------------------------------------------------------------------------------------
 
-    TPython::LoadMacro("loadBetchart.py");
+    if (crossCheckNuSolver) TPython::LoadMacro("loadBetchart.py");
     //LHAPDF::initPDFSet("pdfs/cteq6mE.LHgrid");
 
 
     LHAPDF::initPDFSetM(1,"pdfs/cteq6mE.LHgrid");
     LHAPDF::initPDFM(1, 0);
     LHAPDF::initPDFSetM(2,"pdfs/cteq6mE.LHgrid");
+    //fall back to direct LHAPDF calls if the table is off by more than the tolerance
+    if (usePDFLuminosityCache && !pdfLuminosity.isInitialized() && !pdfLuminosity.init(1, mt_solver)) usePDFLuminosityCache = false;
 
 
     //------------------------------------------------------------------------------------------------------
@@ -201,6 +217,19 @@ void StopTreeLooper::loop(TChain *chain, TString name)
     std::map<std::string, TH1D *> h_1d_nj;
     //z sample for yields etc
     std::map<std::string, TH1D *> h_1d_z;
+    //signal region with all weight variations per histogram
+    std::map<std::string, MultiWeightHisto *> h_1d_syst;
+    vector<string> syst_suffixes;
+    syst_suffixes.push_back("");
+    syst_suffixes.push_back("_PUup");
+    syst_suffixes.push_back("_PUdown");
+    syst_suffixes.push_back("_TopPtWeightOn");
+    syst_suffixes.push_back("_TopPtWeightOff");
+    syst_suffixes.push_back("_IdIsoEffOn");
+    syst_suffixes.push_back("_IdIsoEffOff");
+    const int nPDFsyst = calculatePDFsystweights ? 41 : 0;
+    for (int i = 0; i < nPDFsyst; ++i) syst_suffixes.push_back(Form("_PDF%i", i));
+    vector<double> systweights(syst_suffixes.size());
 
     //-----------------------------------
     // PU reweighting based on true PU
@@ -378,6 +407,12 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             if (systupPUShape) puweight = vtxweight_n( stopt.ntruepu(), h_pu_wgt_systup, isData );
             if (systdownPUShape) puweight = vtxweight_n( stopt.ntruepu(), h_pu_wgt_systdown, isData );
             if (systnoPUReweighting) puweight = 1.;
+            //PU shape variations relative to the weight actually applied
+            float puweight_up = 1., puweight_down = 1.;
+            if ( fillWeightVariations && !isData && puweight > 0. ) {
+                puweight_up   = vtxweight_n( stopt.ntruepu(), h_pu_wgt_systup, isData ) / puweight;
+                puweight_down = vtxweight_n( stopt.ntruepu(), h_pu_wgt_systdown, isData ) / puweight;
+            }
 
 
             float evtweight = isData ? 1. :
@@ -1135,16 +1170,18 @@ void StopTreeLooper::loop(TChain *chain, TString name)
             float trigweight_dl = isData ? 1. : getdltrigweight_pteta(stopt.id1(), stopt.lep1().Pt(), stopt.lep1().Eta(), stopt.id2(), stopt.lep2().Pt(), stopt.lep2().Eta());
 
 
-            if ( applyTopPtWeighting && (name.Contains("ttdl") || name.Contains("ttsl") || name.Contains("ttfake")) )
+            double topptweight = 1.;
+            if ( (applyTopPtWeighting || fillWeightVariations) && (name.Contains("ttdl") || name.Contains("ttsl") || name.Contains("ttfake")) )
             {
 
                 float pT_topplus_gen = stopt.t().Pt();
                 float pT_topminus_gen = stopt.tbar().Pt();
-                evtweight *= sqrt( TopPtWeight(pT_topplus_gen) * TopPtWeight(pT_topminus_gen) );
+                topptweight = sqrt( TopPtWeight(pT_topplus_gen) * TopPtWeight(pT_topminus_gen) );
+                if ( applyTopPtWeighting ) evtweight *= topptweight;
             }
 
-            if ( systidisoeffweighting ) {
-                double idisoweight = 1.;
+            double idisoweight = 1.;
+            if ( systidisoeffweighting || fillWeightVariations ) {
                 float lep1eta_temp = fabs(stopt.lep1().Eta());
                 if ( abs(stopt.id1())==11 )  lep1eta_temp = lep1eta_temp > 1.44 ? 1.44 : lep1eta_temp;
                 if ( abs(stopt.id1())==13 )  lep1eta_temp = lep1eta_temp > 2.09 ? 2.09 : lep1eta_temp;
@@ -1158,7 +1195,7 @@ void StopTreeLooper::loop(TChain *chain, TString name)
                 idisoweight *= getideffweight( stopt.id1(), stopt.lep1().Pt(), lep1eta_temp );
                 idisoweight *= getideffweight( stopt.id2(), stopt.lep2().Pt(), lep2eta_temp );
 
-                evtweight*=idisoweight;
+                if ( systidisoeffweighting ) evtweight*=idisoweight;
                 //cout<<idisoweight<<endl;
             }
 
@@ -1210,6 +1247,24 @@ void StopTreeLooper::loop(TChain *chain, TString name)
                 makeSIGPlots( weight, h_1d_sig,  tag_btag  , basic_flav_tag_dl , "h_sig");
                 makeSIGPlots( weight, h_1d_sig,  tag_btag  , "_all" , "h_sig");
 
+                if ( fillWeightVariations ) {
+                    //weights relative to the nominal without the optional top pT and id/iso reweighting
+                    double weight_notoppt  = applyTopPtWeighting ? weight / topptweight : weight;
+                    double weight_noidiso  = systidisoeffweighting ? weight / idisoweight : weight;
+                    systweights[0] = weight;
+                    systweights[1] = weight * puweight_up;
+                    systweights[2] = weight * puweight_down;
+                    systweights[3] = weight_notoppt * topptweight;
+                    systweights[4] = weight_notoppt;
+                    systweights[5] = weight_noidiso * idisoweight;
+                    systweights[6] = weight_noidiso;
+                    for (int i = 0; i < nPDFsyst; ++i)
+                        systweights[7 + i] = i < int(PDFsystweights.size()) ? weight * PDFsystweights.at(i) : weight;
+
+                    makeSystPlots( systweights, syst_suffixes, h_1d_syst, tag_btag , basic_flav_tag_dl , "h_sig");
+                    makeSystPlots( systweights, syst_suffixes, h_1d_syst, tag_btag , "_all" , "h_sig");
+                }
+
                 if ( name.Contains("ttdl") )
                 {
                     //gen-level flavour
@@ -1482,6 +1537,14 @@ void StopTreeLooper::loop(TChain *chain, TString name)
     outfile_sig.Write();
     outfile_sig.Close();
 
+    if ( fillWeightVariations ) {
+      TFile outfile_syst(Form("SYST%s", m_outfilename_.c_str()), "RECREATE") ;
+      printf("[StopTreeLooper::loop] Saving SIG histograms with %i weight variations to SYST%s\n", int(syst_suffixes.size()), m_outfilename_.c_str());
+      saveMultiWeightHistos(h_1d_syst);
+      outfile_syst.Write();
+      outfile_syst.Close();
+    }
+
       //control regions
       //h_1d_cr*
 
@@ -1873,6 +1936,38 @@ void StopTreeLooper::makeSIGPlots( float evtweight, std::map<std::string, TH1D *
 
 }
 
+void StopTreeLooper::makeSystPlots( const vector<double> &weights, const vector<string> &suffixes, std::map<std::string, MultiWeightHisto *> &h_1d,
+                                    string tag_selection, string flav_tag, string hist_tag)
+{
+    //the main asymmetry variables of makeSIGPlots, filled once for every weight variation
+    int nbins = 80;
+
+    plot1DMultiWeight(hist_tag+"_lep_charge_asymmetry" + tag_selection + flav_tag, lep_charge_asymmetry , weights, h_1d, suffixes, nbins, -4, 4);
+    plot1DMultiWeight(hist_tag+"_lep_azimuthal_asymmetry" + tag_selection + flav_tag, lep_azimuthal_asymmetry , weights, h_1d, suffixes, nbins, -TMath::Pi(), TMath::Pi());
+    plot1DMultiWeight(hist_tag+"_lep_azimuthal_asymmetry2" + tag_selection + flav_tag, lep_azimuthal_asymmetry2 , weights, h_1d, suffixes, nbins, 0, TMath::Pi());
+
+    if (m_top > 0)
+    {
+        plot1DMultiWeight(hist_tag+"_top_rapiditydiff_cms" + tag_selection + flav_tag, top_rapiditydiff_cms , weights, h_1d, suffixes, nbins, -4, 4);
+        plot1DMultiWeight(hist_tag+"_top_pseudorapiditydiff_cms" + tag_selection + flav_tag, top_pseudorapiditydiff_cms , weights, h_1d, suffixes, nbins, -4, 4);
+        plot1DMultiWeight(hist_tag+"_top_rapiditydiff_Marco" + tag_selection + flav_tag, top_rapiditydiff_Marco , weights, h_1d, suffixes, nbins, -4, 4);
+        plot1DMultiWeight(hist_tag+"_top_costheta_cms" + tag_selection + flav_tag, top_costheta_cms , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_lepPlus_costheta_cms" + tag_selection + flav_tag, lepPlus_costheta_cms , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_lepMinus_costheta_cms" + tag_selection + flav_tag, lepMinus_costheta_cms , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_lep_costheta_cms" + tag_selection + flav_tag, lepPlus_costheta_cms , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_lep_costheta_cms" + tag_selection + flav_tag, lepMinus_costheta_cms , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_top_spin_correlation" + tag_selection + flav_tag, top_spin_correlation , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_lep_cos_opening_angle" + tag_selection + flav_tag, lep_cos_opening_angle , weights, h_1d, suffixes, nbins, -1, 1);
+        plot1DMultiWeight(hist_tag+"_tt_mass" + tag_selection + flav_tag, tt_mass , weights, h_1d, suffixes, nbins, 0, 1600);
+        plot1DMultiWeight(hist_tag+"_ttRapidity2" + tag_selection + flav_tag, ttRapidity2 , weights, h_1d, suffixes, nbins, -4, 4);
+        plot1DMultiWeight(hist_tag+"_tt_pT" + tag_selection + flav_tag, tt_pT , weights, h_1d, suffixes, nbins, 0, 400);
+    }
+
+    //channel histograms to be used for yields tables
+    plot1DMultiWeight(hist_tag+"_channel" + tag_selection + flav_tag, channel, weights, h_1d, suffixes, 4 , 0, 4);
+    plot1DMultiWeight(hist_tag+"_channel" + tag_selection + flav_tag, 3, weights, h_1d, suffixes, 4 , 0, 4);
+}
+
 
 
 void StopTreeLooper::makeAccPlots( float evtweight, std::map<std::string, TH1D *> &h_1d, std::map<std::string, TH2D *> &h_2d,
@@ -2336,66 +2431,30 @@ void StopTreeLooper::solvettbar()
     //double met_x = t1metphicorr * cos(t1metphicorrphi);
     //double met_y = t1metphicorr * sin(t1metphicorrphi);
 
-    //create lines of python code to transmit the input values
-    TString l0 = Form("l0 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", lepPlus.Pt(), lepPlus.Eta(), lepPlus.Phi(), lepPlus.E());
-    TString l1 = Form("l1 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", lepMinus.Pt(), lepMinus.Eta(), lepMinus.Phi(), lepMinus.E());
-    TString j0 = Form("j0 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", jet1.Pt(), jet1.Eta(), jet1.Phi(), jet1.E());
-    TString j1 = Form("j1 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", jet2.Pt(), jet2.Eta(), jet2.Phi(), jet2.E());
-    TString metxy = Form("metx, mety = %0.8f, %0.8f", met_x, met_y);
-
-    //cout<<l0<<endl;
-    //cout<<l1<<endl;
-    //cout<<j0<<endl;
-    //cout<<j1<<endl;
-    //cout<<metxy<<endl;
-
-    TPython::Exec(l0);
-    TPython::Exec(l1);
-    TPython::Exec(j0);
-    TPython::Exec(j1);
-    TPython::Exec(metxy);
-
     int ncombo0 = 0;
     int ncombo1 = 0;
     int num_err_sols[2] = {0, 0};
 
     for (int icombo = 0; icombo < 2; ++icombo)
     {
-        if (icombo == 0) TPython::Exec("dnsC = doubleNeutrinoSolutionsCheckLinAlg((j0, j1), (l0, l1), (metx, mety))");
-        if (icombo == 1) TPython::Exec("dnsC = doubleNeutrinoSolutionsCheckLinAlg((j1, j0), (l0, l1), (metx, mety))");
-        TPython::Exec("dns = dnsC.dns");
-        //TPython::Exec("dns = doubleNeutrinoSolutions((j0, j1), (l0, l1), (metx, mety))");
-        TPython::Exec("soltest = 1");
-        TPython::Exec("if dns==0: soltest = 0");
-        //TPython::Exec("print soltest");
-        int soltest  = TPython::Eval("soltest");
+        TLorentzVector &b1 = (icombo == 0) ? jet1 : jet2;
+        TLorentzVector &b2 = (icombo == 0) ? jet2 : jet1;
 
+        nuSolutions::nunuSolutions dns;
+        nuSolutions::doubleNeutrinoSolutions(b1, b2, lepPlus, lepMinus, met_x, met_y, dns, mW_solver * mW_solver, mt_solver * mt_solver, nuSolverMultiStart);
+        if (crossCheckNuSolver) nuSolutions::crossCheckWithPython(b1, b2, lepPlus, lepMinus, met_x, met_y, dns);
 
-        if (soltest)
+        if (dns.ok)
         {
-            TPython::Exec("solutions = dns.nunu_s");
-            //TPython::Exec("print solutions");
-            TPython::Exec("nSolB = len(solutions)");
-
-            const int nSolB  = TPython::Eval("nSolB");
+            const int nSolB = dns.n;
             //cout<<"nSolB: "<<nSolB<<endl;
-            double nusols[nSolB][2][3];
 
             for (int is = 0; is < nSolB; ++is)
             {
-                for (int inu = 0; inu < 2; ++inu)
-                {
-                    for (int ix = 0; ix < 3; ++ix)
-                    {
-                        TString sols = Form("solutions[%0d][%0d][%0d]", is, inu, ix);
-                        //cout<<sols<<endl;
-                        nusols[is][inu][ix]  = TPython::Eval(sols);
-                        //if(nusols[is][inu][ix] == -1) cout<<nusols[is][inu][ix]<<endl;
-                    }
-                }
+                const double (&nusols)[2][3] = dns.nu[is];
                 TLorentzVector nu1_vec , nu2_vec, lvTop1, lvTop2;
-                nu1_vec.SetXYZM( nusols[is][0][0] , nusols[is][0][1] , nusols[is][0][2] , 0 );
-                nu2_vec.SetXYZM( nusols[is][1][0] , nusols[is][1][1] , nusols[is][1][2] , 0 );
+                nu1_vec.SetXYZM( nusols[0][0] , nusols[0][1] , nusols[0][2] , 0 );
+                nu2_vec.SetXYZM( nusols[1][0] , nusols[1][1] , nusols[1][2] , 0 );
 
                 //calculate t and tbar solutions and weights. The dalitz weight only distinguishes between the two combos, while the PDF weight is different for each solution.
                 double sol_weight = -1;
@@ -2419,7 +2478,7 @@ void StopTreeLooper::solvettbar()
                 TLorentzVector lvW2 = lepMinus + nu2_vec;
                 //cout<<"combo "<<icombo<<" solution "<<is<<" weight "<<sol_weight<<" masses: "<<lvTop1.M()<<" "<<lvTop2.M()<<" "<<lvW1.M()<<" "<<lvW2.M()<<endl;
 
-                //don't use solutions with numerical error in solution (output masses don't match input). The input masses used are hard-coded in nuSolutions.py.
+                //don't use solutions with numerical error in solution (output masses don't match input). The input masses used are hard-coded in nuSolutions.h.
                 if (  (fabs(mt_solver - lvTop1.M()) > 1.0 || fabs(mt_solver - lvTop2.M()) > 1.0) )
                 {
                     num_err_sols[icombo]++;
@@ -2548,6 +2607,8 @@ double StopTreeLooper::get_pdf_weight( TLorentzVector &t1, TLorentzVector &t2 )
     double x1 = ( t1.E() + t2.E() + t1.Pz() + t2.Pz() ) / e_com;
     double x2 = ( t1.E() + t2.E() - t1.Pz() - t2.Pz() ) / e_com;
 
+    if (usePDFLuminosityCache) return pdfLuminosity.luminosity(x1, x2);
+
     vector <double> f1, f2;
 
     f1 = LHAPDF::xfxM(1, x1, mt_solver);
@@ -16,6 +16,8 @@
 
 using namespace std;
 
+class MultiWeightHisto;
+
 class StopTreeLooper
 {
 
@@ -26,11 +28,15 @@ public:
     ~StopTreeLooper();
 
     void setOutFileName(string filename);
+    //weight-only systematics to SYST<outfile>, off by default; see dosyst.sh
+    void setFillWeightVariations(bool fill);
     void loop(TChain *chain, TString name);
 
     //plotting
     void makeSIGPlots(float evtweight, std::map<std::string, TH1D *> &h_1d,
                       string tag_selection, string flav_tag , string hist_tag);
+    void makeSystPlots(const vector<double> &weights, const vector<string> &suffixes, std::map<std::string, MultiWeightHisto *> &h_1d,
+                      string tag_selection, string flav_tag , string hist_tag);
     void makettPlots(float evtweight, std::map<std::string, TH1D *> &h_1d, std::map<std::string, TH2D *> &h_2d,
                      string tag_selection, string flav_tag );
     void makeAccPlots(float evtweight, std::map<std::string, TH1D *> &h_1d, std::map<std::string, TH2D *> &h_2d,
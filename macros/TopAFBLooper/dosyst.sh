@@ -7,4 +7,12 @@ for SAMPLE in ${ttbarSamples[@]}
   do root -b -q -l do.C\(\"$RPATHttbar\",\"$SAMPLE\"\) &
 done
 
+# weight-only systematics (PU, top pT, id/iso, PDF members) of the nominal ttbar, to SYSToutput/
+declare -a weightSystSamples=(ttdl_mcatnlo ttsl_mcatnlo ttfake_mcatnlo)
+mkdir -p SYSToutput
+
+for SAMPLE in ${weightSystSamples[@]}
+  do root -b -q -l do.C\(\"$RPATHttbar\",\"$SAMPLE\",true\) &
+done
+
 wait
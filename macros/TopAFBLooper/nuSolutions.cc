@@ -0,0 +1,1101 @@
+#include "nuSolutions.h"
+
+#include "Math/VectorUtil.h"
+#include "TPython.h"
+#include "TString.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <complex>
+#include <iostream>
+
+using namespace std;
+
+namespace nuSolutions
+{
+
+//------------------------------------------------------------------------------
+// 3x3 linear algebra helpers
+//------------------------------------------------------------------------------
+
+static mat3 zeros()
+{
+    mat3 m;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            m.a[i][j] = 0.;
+    return m;
+}
+
+static mat3 diag(double d0, double d1, double d2)
+{
+    mat3 m = zeros();
+    m.a[0][0] = d0;
+    m.a[1][1] = d1;
+    m.a[2][2] = d2;
+    return m;
+}
+
+static mat3 dot(const mat3 &x, const mat3 &y)
+{
+    mat3 m;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            m.a[i][j] = x.a[i][0] * y.a[0][j] + x.a[i][1] * y.a[1][j] + x.a[i][2] * y.a[2][j];
+    return m;
+}
+
+static void dot(const mat3 &x, const double v[3], double out[3])
+{
+    for (int i = 0; i < 3; ++i)
+        out[i] = x.a[i][0] * v[0] + x.a[i][1] * v[1] + x.a[i][2] * v[2];
+}
+
+static mat3 transpose(const mat3 &x)
+{
+    mat3 m;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            m.a[i][j] = x.a[j][i];
+    return m;
+}
+
+static double det(const mat3 &x)
+{
+    return x.a[0][0] * (x.a[1][1] * x.a[2][2] - x.a[1][2] * x.a[2][1])
+           - x.a[0][1] * (x.a[1][0] * x.a[2][2] - x.a[1][2] * x.a[2][0])
+           + x.a[0][2] * (x.a[1][0] * x.a[2][1] - x.a[1][1] * x.a[2][0]);
+}
+
+// Cofactor[i,j] of 3x3 matrix A
+static double cofactor(const mat3 &A, int i, int j)
+{
+    int r0 = (i == 0) ? 1 : 0, r1 = (i == 2) ? 1 : 2;
+    int c0 = (j == 0) ? 1 : 0, c1 = (j == 2) ? 1 : 2;
+    double minor = A.a[r0][c0] * A.a[r1][c1] - A.a[r1][c0] * A.a[r0][c1];
+    return ((i + j) % 2 ? -1. : 1.) * minor;
+}
+
+// LU inverse with partial pivoting; like numpy.linalg.inv it only fails on an
+// exactly zero pivot
+static bool inv(const mat3 &x, mat3 &out)
+{
+    double lu[3][3];
+    int perm[3] = {0, 1, 2};
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            lu[i][j] = x.a[i][j];
+
+    for (int k = 0; k < 3; ++k)
+    {
+        int p = k;
+        for (int i = k + 1; i < 3; ++i)
+            if (fabs(lu[i][k]) > fabs(lu[p][k])) p = i;
+        if (lu[p][k] == 0.) return false;
+        if (p != k)
+        {
+            for (int j = 0; j < 3; ++j) swap(lu[p][j], lu[k][j]);
+            swap(perm[p], perm[k]);
+        }
+        for (int i = k + 1; i < 3; ++i)
+        {
+            lu[i][k] /= lu[k][k];
+            for (int j = k + 1; j < 3; ++j)
+                lu[i][j] -= lu[i][k] * lu[k][j];
+        }
+    }
+
+    for (int col = 0; col < 3; ++col)
+    {
+        double y[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            y[i] = (perm[i] == col) ? 1. : 0.;
+            for (int j = 0; j < i; ++j) y[i] -= lu[i][j] * y[j];
+        }
+        for (int i = 2; i >= 0; --i)
+        {
+            for (int j = i + 1; j < 3; ++j) y[i] -= lu[i][j] * y[j];
+            y[i] /= lu[i][i];
+        }
+        for (int i = 0; i < 3; ++i) out.a[i][col] = y[i];
+    }
+    return true;
+}
+
+// Rotation matrix about x(0),y(1), or z(2) axis
+static mat3 R(int axis, double angle)
+{
+    double c = cos(angle), s = sin(angle);
+    mat3 m = diag(c, c, c);
+    for (int i = -1; i <= 1; ++i)
+        m.a[(axis - i + 3) % 3][(axis + i + 3) % 3] = i * s + (1 - i * i);
+    return m;
+}
+
+//------------------------------------------------------------------------------
+// eigenvalues of a general 3x3 matrix as numpy.linalg.eigvals finds them
+// (LAPACK dgeev: dgebal, dgehrd, dlahqr, dlanv2), in the same order, since
+// intersections_ellipses takes the first real one like the python does
+//------------------------------------------------------------------------------
+
+// |a| with the sign of b, as Fortran SIGN
+static double fsign(double a, double b)
+{
+    return (b >= 0.) ? fabs(a) : -fabs(a);
+}
+
+// sqrt(a^2 + b^2) without overflow (dlapy2)
+static double pythag(double a, double b)
+{
+    double w = max(fabs(a), fabs(b)), z = min(fabs(a), fabs(b));
+    if (z == 0.) return w;
+    return w * sqrt(1. + (z / w) * (z / w));
+}
+
+// balance by powers of 2 (dgebal; nothing to permute for dense matrices)
+static void balance(double h[3][3])
+{
+    const double sclfac = 2., factor = 0.95;
+    bool noconv = true;
+    while (noconv)
+    {
+        noconv = false;
+        for (int i = 0; i < 3; ++i)
+        {
+            double c = 0., r = 0.;
+            for (int j = 0; j < 3; ++j)
+            {
+                c = pythag(c, h[j][i]);
+                r = pythag(r, h[i][j]);
+            }
+            if (c == 0. || r == 0.) continue;
+            double g = r / sclfac, f = 1., s = c + r;
+            while (c < g)
+            {
+                f *= sclfac; c *= sclfac; r /= sclfac; g /= sclfac;
+            }
+            g = c / sclfac;
+            while (g >= r)
+            {
+                f /= sclfac; c /= sclfac; g /= sclfac; r *= sclfac;
+            }
+            if (c + r >= factor * s) continue;
+            for (int j = 0; j < 3; ++j)
+            {
+                h[i][j] *= 1. / f;
+                h[j][i] *= f;
+            }
+            noconv = true;
+        }
+    }
+}
+
+// Householder reflector (dlarfg) of v[0..n-1]: v[0] becomes beta, v[1..]
+// the reflector; returns tau
+static double reflector(int n, double v[3])
+{
+    double xnorm = (n == 3) ? pythag(v[1], v[2]) : fabs(v[1]);
+    if (xnorm == 0.) return 0.;
+    double beta = -fsign(pythag(v[0], xnorm), v[0]);
+    double tau = (beta - v[0]) / beta;
+    double scal = 1. / (v[0] - beta);
+    for (int j = 1; j < n; ++j) v[j] *= scal;
+    v[0] = beta;
+    return tau;
+}
+
+// eigenvalues of the 2x2 block [a b; c d] in dlanv2's order
+static void eigenvalues2(double a, double b, double c, double d, complex<double> &rt1, complex<double> &rt2)
+{
+    const double eps = DBL_EPSILON;
+    if (c == 0.)
+    {
+    }
+    else if (b == 0.)
+    {
+        swap(a, d);
+        b = -c;
+        c = 0.;
+    }
+    else if (a - d == 0. && fsign(1., b) != fsign(1., c))
+    {
+    }
+    else
+    {
+        double temp = a - d, p = 0.5 * temp;
+        double bcmax = max(fabs(b), fabs(c));
+        double bcmis = min(fabs(b), fabs(c)) * fsign(1., b) * fsign(1., c);
+        double scale = max(fabs(p), bcmax);
+        double z = (p / scale) * p + (bcmax / scale) * bcmis;
+        if (z >= 4. * eps)
+        {
+            // real eigenvalues
+            z = p + fsign(sqrt(scale) * sqrt(z), p);
+            a = d + z;
+            d = d - (bcmax / z) * bcmis;
+            c = 0.;
+        }
+        else
+        {
+            // complex or nearly equal: make the diagonal equal
+            double sigma = b + c;
+            double tau = pythag(sigma, temp);
+            double cs = sqrt(0.5 * (1. + fabs(sigma) / tau));
+            double sn = -(p / (tau * cs)) * fsign(1., sigma);
+            double aa = a * cs + b * sn, bb = -a * sn + b * cs;
+            double cc = c * cs + d * sn, dd = -c * sn + d * cs;
+            b = bb * cs + dd * sn;
+            c = -aa * sn + cc * cs;
+            temp = 0.5 * ((aa * cs + cc * sn) + (-bb * sn + dd * cs));
+            a = temp;
+            d = temp;
+            if (c != 0.)
+            {
+                if (b != 0.)
+                {
+                    if (fsign(1., b) == fsign(1., c))
+                    {
+                        double q = fsign(sqrt(fabs(b)) * sqrt(fabs(c)), c);
+                        a = temp + q;
+                        d = temp - q;
+                        c = 0.;
+                    }
+                }
+                else
+                {
+                    b = -c;
+                    c = 0.;
+                }
+            }
+        }
+    }
+
+    double im = (c == 0.) ? 0. : sqrt(fabs(b)) * sqrt(fabs(c));
+    rt1 = complex<double>(a, im);
+    rt2 = complex<double>(d, -im);
+}
+
+static void eigenvalues(const mat3 &M, complex<double> ev[3])
+{
+    double h[3][3];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            h[i][j] = M.a[i][j];
+
+    balance(h);
+
+    // Hessenberg form (dgehd2)
+    double u[3] = { h[1][0], h[2][0], 0. };
+    double tau = reflector(2, u);
+    if (tau != 0.)
+    {
+        double v2 = u[1];
+        for (int r = 0; r < 3; ++r)
+        {
+            double s = h[r][1] + v2 * h[r][2];
+            h[r][1] -= tau * s;
+            h[r][2] -= tau * s * v2;
+        }
+        for (int c = 1; c < 3; ++c)
+        {
+            double s = h[1][c] + v2 * h[2][c];
+            h[1][c] -= tau * s;
+            h[2][c] -= tau * s * v2;
+        }
+    }
+    h[1][0] = u[0];
+    h[2][0] = 0.;
+
+    // double-shift QR (dlahqr, eigenvalues only)
+    const double dat1 = 0.75, dat2 = -0.4375;
+    const int kexsh = 10, itmax = 300;
+    const double ulp = DBL_EPSILON, smlnum = DBL_MIN * (3. / ulp);
+
+    int kdefl = 0;
+    for (int i = 2; i >= 0; )
+    {
+        int l = 0;
+        bool converged = false;
+        for (int its = 0; its <= itmax; ++its)
+        {
+            // look for a single small subdiagonal element
+            int k;
+            for (k = i; k > l; --k)
+            {
+                if (fabs(h[k][k - 1]) <= smlnum) break;
+                double tst = fabs(h[k - 1][k - 1]) + fabs(h[k][k]);
+                if (tst == 0.)
+                {
+                    if (k - 2 >= 0) tst += fabs(h[k - 1][k - 2]);
+                    if (k + 1 <= 2) tst += fabs(h[k + 1][k]);
+                }
+                if (fabs(h[k][k - 1]) <= ulp * tst)
+                {
+                    double ab = max(fabs(h[k][k - 1]), fabs(h[k - 1][k]));
+                    double ba = min(fabs(h[k][k - 1]), fabs(h[k - 1][k]));
+                    double aa = max(fabs(h[k][k]), fabs(h[k - 1][k - 1] - h[k][k]));
+                    double bb = min(fabs(h[k][k]), fabs(h[k - 1][k - 1] - h[k][k]));
+                    double s = aa + ab;
+                    if (ba * (ab / s) <= max(smlnum, ulp * (bb * (aa / s)))) break;
+                }
+            }
+            l = k;
+            if (l > 0) h[l][l - 1] = 0.;
+            if (l >= i - 1)
+            {
+                converged = true;
+                break;
+            }
+            ++kdefl;
+
+            // shifts
+            double h11, h12, h21, h22;
+            if (kdefl % (2 * kexsh) == 0)
+            {
+                double s = fabs(h[i][i - 1]) + fabs(h[i - 1][i - 2]);
+                h11 = dat1 * s + h[i][i]; h12 = dat2 * s; h21 = s; h22 = h11;
+            }
+            else if (kdefl % kexsh == 0)
+            {
+                double s = fabs(h[l + 1][l]) + fabs(h[l + 2][l + 1]);
+                h11 = dat1 * s + h[l][l]; h12 = dat2 * s; h21 = s; h22 = h11;
+            }
+            else
+            {
+                h11 = h[i - 1][i - 1]; h21 = h[i][i - 1]; h12 = h[i - 1][i]; h22 = h[i][i];
+            }
+            double rt1r = 0., rt1i = 0., rt2r = 0., rt2i = 0.;
+            double s = fabs(h11) + fabs(h12) + fabs(h21) + fabs(h22);
+            if (s != 0.)
+            {
+                h11 /= s; h21 /= s; h12 /= s; h22 /= s;
+                double tr = (h11 + h22) / 2.;
+                double det = (h11 - tr) * (h22 - tr) - h12 * h21;
+                double rtdisc = sqrt(fabs(det));
+                if (det >= 0.)
+                {
+                    rt1r = tr * s; rt2r = rt1r; rt1i = rtdisc * s; rt2i = -rt1i;
+                }
+                else
+                {
+                    // real shifts: use only the one closer to h22
+                    rt1r = tr + rtdisc;
+                    rt2r = tr - rtdisc;
+                    if (fabs(rt1r - h22) <= fabs(rt2r - h22)) rt2r = rt1r = rt1r * s;
+                    else rt1r = rt2r = rt2r * s;
+                }
+            }
+
+            // look for two consecutive small subdiagonal elements
+            int m;
+            double v[3];
+            for (m = i - 2; m >= l; --m)
+            {
+                double h21s = h[m + 1][m];
+                double s = fabs(h[m][m] - rt2r) + fabs(rt2i) + fabs(h21s);
+                h21s = h[m + 1][m] / s;
+                v[0] = h21s * h[m][m + 1] + (h[m][m] - rt1r) * ((h[m][m] - rt2r) / s) - rt1i * (rt2i / s);
+                v[1] = h21s * (h[m][m] + h[m + 1][m + 1] - rt1r - rt2r);
+                v[2] = h21s * h[m + 2][m + 1];
+                s = fabs(v[0]) + fabs(v[1]) + fabs(v[2]);
+                v[0] /= s; v[1] /= s; v[2] /= s;
+                if (m == l) break;
+                double h00 = fabs(h[m][m - 1]) * (fabs(v[1]) + fabs(v[2]));
+                double h01 = ulp * fabs(v[0]) * (fabs(h[m - 1][m - 1]) + fabs(h[m][m]) + fabs(h[m + 1][m + 1]));
+                if (h00 <= h01) break;
+            }
+
+            // double-shift QR step on the active block l..i
+            for (int k = m; k <= i - 1; ++k)
+            {
+                int nr = min(3, i - k + 1);
+                if (k > m)
+                    for (int j = 0; j < nr; ++j) v[j] = h[k + j][k - 1];
+                double t1 = reflector(nr, v);
+                if (k > m)
+                {
+                    h[k][k - 1] = v[0];
+                    h[k + 1][k - 1] = 0.;
+                    if (k < i - 1) h[k + 2][k - 1] = 0.;
+                }
+                else if (m > l)
+                {
+                    h[k][k - 1] *= 1. - t1;
+                }
+                double v2 = v[1], t2 = t1 * v2;
+                if (nr == 3)
+                {
+                    double v3 = v[2], t3 = t1 * v3;
+                    for (int j = k; j <= i; ++j)
+                    {
+                        double sum = h[k][j] + v2 * h[k + 1][j] + v3 * h[k + 2][j];
+                        h[k][j] -= sum * t1;
+                        h[k + 1][j] -= sum * t2;
+                        h[k + 2][j] -= sum * t3;
+                    }
+                    for (int j = l; j <= min(k + 3, i); ++j)
+                    {
+                        double sum = h[j][k] + v2 * h[j][k + 1] + v3 * h[j][k + 2];
+                        h[j][k] -= sum * t1;
+                        h[j][k + 1] -= sum * t2;
+                        h[j][k + 2] -= sum * t3;
+                    }
+                }
+                else
+                {
+                    for (int j = k; j <= i; ++j)
+                    {
+                        double sum = h[k][j] + v2 * h[k + 1][j];
+                        h[k][j] -= sum * t1;
+                        h[k + 1][j] -= sum * t2;
+                    }
+                    for (int j = l; j <= i; ++j)
+                    {
+                        double sum = h[j][k] + v2 * h[j][k + 1];
+                        h[j][k] -= sum * t1;
+                        h[j][k + 1] -= sum * t2;
+                    }
+                }
+            }
+        }
+
+        // no convergence (LAPACK gives up too): take the diagonal as it is
+        if (!converged) l = i;
+
+        if (l == i) ev[i] = h[i][i];
+        else eigenvalues2(h[i - 1][i - 1], h[i - 1][i], h[i][i - 1], h[i][i], ev[i - 1], ev[i]);
+        kdefl = 0;
+        i = l - 1;
+    }
+}
+
+// eigenvector for eigenvalue ev: the largest cross product of two rows of
+// (M - ev I), scaled like LAPACK (unit norm, largest component real)
+static bool eigenvector(const mat3 &M, complex<double> ev, complex<double> v[3])
+{
+    complex<double> S[3][3];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            S[i][j] = M.a[i][j] - ((i == j) ? ev : 0.);
+
+    double best = 0.;
+    for (int p = 0; p < 3; ++p)
+    {
+        const complex<double> *x = S[p];
+        const complex<double> *y = S[(p + 1) % 3];
+        complex<double> c[3] = { x[1] * y[2] - x[2] * y[1],
+                                 x[2] * y[0] - x[0] * y[2],
+                                 x[0] * y[1] - x[1] * y[0]
+                               };
+        double n2 = norm(c[0]) + norm(c[1]) + norm(c[2]);
+        if (n2 > best)
+        {
+            best = n2;
+            for (int i = 0; i < 3; ++i) v[i] = c[i];
+        }
+    }
+    if (best == 0.) return false;
+
+    int imax = 0;
+    for (int i = 1; i < 3; ++i)
+        if (abs(v[i]) > abs(v[imax])) imax = i;
+    complex<double> scale = conj(v[imax]) / (abs(v[imax]) * sqrt(best));
+    for (int i = 0; i < 3; ++i) v[i] *= scale;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// nuSolutionSet: definitions for nu analytic solution, t->b,mu,nu
+//------------------------------------------------------------------------------
+
+nuSolutionSet::nuSolutionSet(const LV &b, const LV &mu, double mW2_, double mT2, double mN2)
+{
+    mW2 = mW2_;
+    c = (float)ROOT::Math::VectorUtil::CosTheta(b, mu);
+    s = sqrt(1 - c * c);
+
+    x0p = - (mT2 - mW2 - b.M2()) / (2 * b.E());
+    x0 = - (mW2 - mu.M2() - mN2) / (2 * mu.E());
+
+    double Bb = b.Beta(), Bm = mu.Beta();
+
+    Sx = (x0 * Bm - mu.P() * (1 - Bm * Bm)) / (Bm * Bm);
+    Sy = (x0p / Bb - c * Sx) / s;
+
+    w = (Bm / Bb - c) / s;
+    w_ = (-Bm / Bb - c) / s;
+
+    Om2 = w * w + 1 - Bm * Bm;
+    eps2 = (mW2 - mN2) * (1 - Bm * Bm);
+    x1 = Sx - (Sx + w * Sy) / Om2;
+    y1 = Sy - (Sx + w * Sy) * w / Om2;
+    double Z2 = x1 * x1 * Om2 - (Sy - w * Sx) * (Sy - w * Sx) - (mW2 - x0 * x0 - eps2);
+    Z = sqrt(max(0., Z2));
+
+    // H_tilde: transformation of t=[c,s,1] to p_nu, F coord.
+    double Om = sqrt(Om2), p = mu.P();
+    mat3 H_tilde = zeros();
+    H_tilde.a[0][0] = Z / Om;     H_tilde.a[0][2] = x1 - p;
+    H_tilde.a[1][0] = w * Z / Om; H_tilde.a[1][2] = y1;
+    H_tilde.a[2][1] = Z;
+
+    H = dot(R_T(b, mu), H_tilde);
+
+    H_perp = H;
+    H_perp.a[2][0] = 0.; H_perp.a[2][1] = 0.; H_perp.a[2][2] = 1.;
+
+    mat3 HpInv;
+    ok = inv(H_perp, HpInv);
+    if (ok) N = dot(dot(transpose(HpInv), diag(1, 1, -1)), HpInv);
+    else N = zeros();
+}
+
+// rotation from F coord. to laboratory coord.
+mat3 nuSolutionSet::R_T(const LV &b, const LV &mu) const
+{
+    double b_xyz[3] = { b.x(), b.y(), b.z() };
+    mat3 R_z = R(2, -mu.phi());
+    mat3 R_y = R(1, 0.5 * M_PI - mu.theta());
+    double b_rot[3];
+    dot(dot(R_y, R_z), b_xyz, b_rot);
+    mat3 R_x = R(0, -atan2(b_rot[2], b_rot[1]));
+    return dot(transpose(R_z), dot(transpose(R_y), transpose(R_x)));
+}
+
+//------------------------------------------------------------------------------
+// conic intersections
+//------------------------------------------------------------------------------
+
+// Linear factors of degenerate quadratic polynomial
+int factor_degenerate(mat3 G, double lines[2][3], double zero)
+{
+    if (G.a[0][0] == 0 && G.a[1][1] == 0)
+    {
+        lines[0][0] = G.a[0][1]; lines[0][1] = 0;        lines[0][2] = G.a[1][2];
+        lines[1][0] = 0;        lines[1][1] = G.a[0][1]; lines[1][2] = G.a[0][2] - G.a[1][2];
+        return 2;
+    }
+
+    bool swapXY = fabs(G.a[0][0]) > fabs(G.a[1][1]);
+    mat3 Q = G;
+    if (swapXY)
+    {
+        const int idx[3] = {1, 0, 2};
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                Q.a[i][j] = G.a[idx[i]][idx[j]];
+    }
+    double q11 = Q.a[1][1];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            Q.a[i][j] /= q11;
+    double q22 = cofactor(Q, 2, 2);
+
+    double L[2][3];
+    int n = 0;
+    if (-q22 <= zero)
+    {
+        double y = -cofactor(Q, 0, 0);
+        if (y >= 0)
+        {
+            double r = sqrt(y);
+            double roots[2] = { -r, r };
+            int nroots = (y == 0) ? 1 : 2;
+            for (int k = 0; k < nroots; ++k)
+            {
+                L[n][0] = Q.a[0][1];
+                L[n][1] = Q.a[1][1];
+                L[n][2] = Q.a[1][2] + ((y == 0) ? 0. : roots[k]);
+                ++n;
+            }
+        }
+    }
+    else
+    {
+        double x0 = cofactor(Q, 0, 2) / q22;
+        double y0 = cofactor(Q, 1, 2) / q22;
+        double r = sqrt(-q22);
+        double roots[2] = { -r, r };
+        for (int k = 0; k < 2; ++k)
+        {
+            double m = Q.a[0][1] + roots[k];
+            L[n][0] = m;
+            L[n][1] = Q.a[1][1];
+            L[n][2] = -Q.a[1][1] * y0 - m * x0;
+            ++n;
+        }
+    }
+
+    for (int k = 0; k < n; ++k)
+    {
+        lines[k][0] = L[k][swapXY ? 1 : 0];
+        lines[k][1] = L[k][swapXY ? 0 : 1];
+        lines[k][2] = L[k][2];
+    }
+    return n;
+}
+
+// Points of intersection between ellipse and line
+int intersections_ellipse_line(const mat3 &ellipse, const double line[3], double points[2][3], double zero)
+{
+    // np.cross(line, ellipse).T
+    mat3 M;
+    for (int r = 0; r < 3; ++r)
+    {
+        const double *e = ellipse.a[r];
+        M.a[0][r] = line[1] * e[2] - line[2] * e[1];
+        M.a[1][r] = line[2] * e[0] - line[0] * e[2];
+        M.a[2][r] = line[0] * e[1] - line[1] * e[0];
+    }
+
+    complex<double> ev[3];
+    eigenvalues(M, ev);
+
+    // like numpy, all three eigenvectors are tried through their real part
+    double sols[3][3], ks[3];
+    int nsol = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        complex<double> vc[3];
+        if (!eigenvector(M, ev[i], vc)) continue;
+        double v[3] = { vc[0].real(), vc[1].real(), vc[2].real() };
+        double lv = line[0] * v[0] + line[1] * v[1] + line[2] * v[2];
+        double Ev[3];
+        dot(ellipse, v, Ev);
+        double vEv = v[0] * Ev[0] + v[1] * Ev[1] + v[2] * Ev[2];
+        for (int j = 0; j < 3; ++j) sols[nsol][j] = v[j] / v[2];
+        ks[nsol] = lv * lv + vEv * vEv;
+        ++nsol;
+    }
+
+    // keep the (up to) two best, in increasing k
+    int order[3] = {0, 1, 2};
+    for (int i = 0; i < nsol; ++i)
+        for (int j = i + 1; j < nsol; ++j)
+            if (ks[order[j]] < ks[order[i]]) swap(order[i], order[j]);
+
+    int n = 0;
+    for (int i = 0; i < min(nsol, 2); ++i)
+    {
+        if (!(ks[order[i]] < zero)) continue;
+        for (int j = 0; j < 3; ++j) points[n][j] = sols[order[i]][j];
+        ++n;
+    }
+    return n;
+}
+
+// Points of intersection between two ellipses
+int intersections_ellipses(mat3 A, mat3 B, double points[4][3])
+{
+    if (fabs(det(B)) > fabs(det(A))) swap(A, B);
+
+    mat3 Ainv;
+    if (!inv(A, Ainv)) return -1;
+
+    // any real eigenvalue of inv(A).B makes B - e A degenerate, but only
+    // some give real lines through the points: take numpy's first
+    complex<double> ev[3];
+    eigenvalues(dot(Ainv, B), ev);
+    int ie = 0;
+    while (ie < 2 && ev[ie].imag() != 0.) ++ie;
+    double e = ev[ie].real();
+
+    mat3 G;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            G.a[i][j] = B.a[i][j] - e * A.a[i][j];
+
+    double lines[2][3];
+    int nlines = factor_degenerate(G, lines);
+
+    int n = 0;
+    for (int l = 0; l < nlines; ++l)
+    {
+        double p[2][3];
+        int np = intersections_ellipse_line(A, lines[l], p);
+        for (int k = 0; k < np; ++k)
+        {
+            for (int j = 0; j < 3; ++j) points[n][j] = p[k][j];
+            ++n;
+        }
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+// closest approach when the ellipses do not intersect: minimise
+// |nu(t) + nu_(t_) - met| over the two ellipse parameters with
+// Levenberg-Marquardt, as scipy.optimize.leastsq(ftol=5e-5, epsfcn=0.01)
+// does in the python
+//------------------------------------------------------------------------------
+
+static void nus(const mat3 &e, const mat3 &e_, const double t[2], double nu[3], double nu_[3])
+{
+    double v[3] = { cos(t[0]), sin(t[0]), 1. };
+    double v_[3] = { cos(t[1]), sin(t[1]), 1. };
+    dot(e, v, nu);
+    dot(e_, v_, nu_);
+}
+
+static void residuals(const mat3 &e, const mat3 &e_, double metX, double metY, const double t[2], double f[2])
+{
+    double nu[3], nu_[3];
+    nus(e, e_, t, nu, nu_);
+    f[0] = nu[0] + nu_[0] - metX;
+    f[1] = nu[1] + nu_[1] - metY;
+}
+
+// (J^T J + par D^2) x = J^T f; returns false if singular
+static bool lmsolve(const double JtJ[2][2], const double Jtf[2], const double D[2], double par, double x[2])
+{
+    double a00 = JtJ[0][0] + par * D[0] * D[0], a11 = JtJ[1][1] + par * D[1] * D[1], a01 = JtJ[0][1];
+    double d = a00 * a11 - a01 * a01;
+    if (d == 0.) return false;
+    x[0] = ( a11 * Jtf[0] - a01 * Jtf[1]) / d;
+    x[1] = (-a01 * Jtf[0] + a00 * Jtf[1]) / d;
+    return true;
+}
+
+// w^T (J^T J + par D^2)^-1 w
+static double lmnorm2(const double JtJ[2][2], const double D[2], double par, const double w[2])
+{
+    double x[2];
+    double Jtw[2] = { w[0], w[1] };
+    if (!lmsolve(JtJ, Jtw, D, par, x)) return 0.;
+    return w[0] * x[0] + w[1] * x[1];
+}
+
+// MINPACK lmpar for two parameters: the Levenberg-Marquardt parameter for
+// which |D x| is within 10% of delta, and the step x (to be subtracted)
+static void lmpar(const double JtJ[2][2], const double Jtf[2], const double D[2], double delta,
+                  double &par, double x[2])
+{
+    const double dwarf = DBL_MIN;
+
+    // Gauss-Newton direction
+    bool fullRank = lmsolve(JtJ, Jtf, D, 0., x);
+    if (!fullRank) x[0] = x[1] = 0.;
+    double dxnorm = sqrt(pow(D[0] * x[0], 2) + pow(D[1] * x[1], 2));
+    double fp = dxnorm - delta;
+    if (fullRank && fp <= 0.1 * delta)
+    {
+        par = 0.;
+        return;
+    }
+
+    double parl = 0.;
+    if (fullRank)
+    {
+        double w[2] = { D[0] * D[0] * x[0] / dxnorm, D[1] * D[1] * x[1] / dxnorm };
+        parl = fp / delta / lmnorm2(JtJ, D, 0., w);
+    }
+    double gnorm = sqrt(pow(Jtf[0] / D[0], 2) + pow(Jtf[1] / D[1], 2));
+    double paru = gnorm / delta;
+    if (paru == 0.) paru = dwarf / min(delta, 0.1);
+
+    par = min(max(par, parl), paru);
+    if (par == 0.) par = gnorm / dxnorm;
+
+    for (int iter = 1; ; ++iter)
+    {
+        if (par == 0.) par = max(dwarf, 0.001 * paru);
+        lmsolve(JtJ, Jtf, D, par, x);
+        dxnorm = sqrt(pow(D[0] * x[0], 2) + pow(D[1] * x[1], 2));
+        double temp = fp;
+        fp = dxnorm - delta;
+        if (fabs(fp) <= 0.1 * delta || (parl == 0. && fp <= temp && temp < 0.) || iter == 10) return;
+
+        double w[2] = { D[0] * D[0] * x[0] / dxnorm, D[1] * D[1] * x[1] / dxnorm };
+        double parc = fp / delta / lmnorm2(JtJ, D, par, w);
+        if (fp > 0.) parl = max(parl, par);
+        if (fp < 0.) paru = min(paru, par);
+        par = max(parl, par + parc);
+    }
+}
+
+// MINPACK lmdif, which scipy.optimize.leastsq calls, for two parameters with
+// the python's ftol=5e-5, epsfcn=0.01 and the scipy defaults otherwise;
+// forward-difference jacobian and trust region as there, so that it ends in
+// the same local minimum.  Returns the final squared residual; t is the
+// starting point on input
+static double leastsq(const mat3 &e, const mat3 &e_, double metX, double metY, double t[2])
+{
+    const double ftol = 5e-5, xtol = 1.49012e-08, epsfcn = 0.01, factor = 100.;
+    const double epsmch = DBL_EPSILON;
+    const int maxfev = 600;
+
+    double f[2];
+    residuals(e, e_, metX, metY, t, f);
+    int nfev = 1;
+    double fnorm = sqrt(f[0] * f[0] + f[1] * f[1]);
+
+    double D[2] = { 0., 0. }, delta = 0., xnorm = 0., par = 0.;
+    for (int iter = 1; ; )
+    {
+        // forward-difference jacobian d f_i / d t_j
+        double J[2][2];
+        const double eps = sqrt(max(epsfcn, epsmch));
+        for (int j = 0; j < 2; ++j)
+        {
+            double temp = t[j], h = eps * fabs(temp);
+            if (h == 0.) h = eps;
+            t[j] = temp + h;
+            double fh[2];
+            residuals(e, e_, metX, metY, t, fh);
+            t[j] = temp;
+            for (int i = 0; i < 2; ++i) J[i][j] = (fh[i] - f[i]) / h;
+        }
+        nfev += 2;
+
+        double JtJ[2][2], Jtf[2], colnorm[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            Jtf[i] = J[0][i] * f[0] + J[1][i] * f[1];
+            for (int j = 0; j < 2; ++j)
+                JtJ[i][j] = J[0][i] * J[0][j] + J[1][i] * J[1][j];
+            colnorm[i] = sqrt(JtJ[i][i]);
+        }
+
+        if (iter == 1)
+        {
+            for (int j = 0; j < 2; ++j) D[j] = (colnorm[j] == 0.) ? 1. : colnorm[j];
+            xnorm = sqrt(pow(D[0] * t[0], 2) + pow(D[1] * t[1], 2));
+            delta = factor * xnorm;
+            if (delta == 0.) delta = factor;
+        }
+
+        // scaled cosine of the angle between f and the columns of J
+        double gnorm = 0.;
+        if (fnorm != 0.)
+            for (int j = 0; j < 2; ++j)
+                if (colnorm[j] != 0.) gnorm = max(gnorm, fabs(Jtf[j] / fnorm) / colnorm[j]);
+        if (gnorm == 0.) return fnorm * fnorm;
+
+        for (int j = 0; j < 2; ++j) D[j] = max(D[j], colnorm[j]);
+
+        double ratio = 0.;
+        do
+        {
+            double x[2];
+            lmpar(JtJ, Jtf, D, delta, par, x);
+            double p[2] = { -x[0], -x[1] };
+            double tn[2] = { t[0] + p[0], t[1] + p[1] };
+            double pnorm = sqrt(pow(D[0] * p[0], 2) + pow(D[1] * p[1], 2));
+            if (iter == 1) delta = min(delta, pnorm);
+
+            double fn[2];
+            residuals(e, e_, metX, metY, tn, fn);
+            ++nfev;
+            double fnorm1 = sqrt(fn[0] * fn[0] + fn[1] * fn[1]);
+
+            double actred = -1.;
+            if (0.1 * fnorm1 < fnorm) actred = 1. - pow(fnorm1 / fnorm, 2);
+            double Jp[2] = { J[0][0] * p[0] + J[0][1] * p[1], J[1][0] * p[0] + J[1][1] * p[1] };
+            double temp1 = sqrt(Jp[0] * Jp[0] + Jp[1] * Jp[1]) / fnorm;
+            double temp2 = sqrt(par) * pnorm / fnorm;
+            double prered = temp1 * temp1 + temp2 * temp2 / 0.5;
+            double dirder = -(temp1 * temp1 + temp2 * temp2);
+            ratio = (prered != 0.) ? actred / prered : 0.;
+
+            // update the step bound
+            if (ratio <= 0.25)
+            {
+                double temp = (actred >= 0.) ? 0.5 : 0.5 * dirder / (dirder + 0.5 * actred);
+                if (0.1 * fnorm1 >= fnorm || temp < 0.1) temp = 0.1;
+                delta = temp * min(delta, pnorm / 0.1);
+                par /= temp;
+            }
+            else if (par == 0. || ratio >= 0.75)
+            {
+                delta = pnorm / 0.5;
+                par *= 0.5;
+            }
+
+            if (ratio >= 1e-4)
+            {
+                t[0] = tn[0]; t[1] = tn[1];
+                f[0] = fn[0]; f[1] = fn[1];
+                xnorm = sqrt(pow(D[0] * t[0], 2) + pow(D[1] * t[1], 2));
+                fnorm = fnorm1;
+                ++iter;
+            }
+
+            if (fabs(actred) <= ftol && prered <= ftol && 0.5 * ratio <= 1.) return fnorm * fnorm;
+            if (delta <= xtol * xnorm) return fnorm * fnorm;
+            if (nfev >= maxfev) return fnorm * fnorm;
+            if ((fabs(actred) <= epsmch && prered <= epsmch && 0.5 * ratio <= 1.) ||
+                delta <= epsmch * xnorm || gnorm <= epsmch) return fnorm * fnorm;
+        }
+        while (ratio < 1e-4);
+    }
+}
+
+// python starts only from (0,0); with multiStart also try the opposite
+// points of both ellipses and keep the best, which avoids some poor local
+// minima but no longer follows the reference
+static void closestApproach(const mat3 &e, const mat3 &e_, double metX, double metY, double t[2], bool multiStart)
+{
+    double best = -1.;
+    for (int start = 0; start < (multiStart ? 4 : 1); ++start)
+    {
+        double ts[2] = { (start & 1) ? M_PI : 0., (start & 2) ? M_PI : 0. };
+        double cost = leastsq(e, e_, metX, metY, ts);
+        if (best < 0. || cost < best)
+        {
+            best = cost;
+            t[0] = ts[0]; t[1] = ts[1];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Solution pairs of neutrino momenta, tt -> leptons
+//------------------------------------------------------------------------------
+
+void doubleNeutrinoSolutions(const TLorentzVector &b_in, const TLorentzVector &b__in,
+                             const TLorentzVector &mu_in, const TLorentzVector &mu__in,
+                             double metX, double metY, nunuSolutions &sols,
+                             double mW2, double mT2, bool multiStart)
+{
+    sols.ok = false;
+    sols.closestApproach = false;
+    sols.n = 0;
+
+    LV b  (b_in.Pt(),   b_in.Eta(),   b_in.Phi(),   b_in.E());
+    LV b_ (b__in.Pt(),  b__in.Eta(),  b__in.Phi(),  b__in.E());
+    LV mu (mu_in.Pt(),  mu_in.Eta(),  mu_in.Phi(),  mu_in.E());
+    LV mu_(mu__in.Pt(), mu__in.Eta(), mu__in.Phi(), mu__in.E());
+
+    nuSolutionSet ss(b, mu, mW2, mT2);
+    nuSolutionSet ss_(b_, mu_, mW2, mT2);
+    if (!ss.ok || !ss_.ok) return;
+
+    // S = V0 - UnitCircle
+    mat3 S = diag(-1, -1, 1);
+    S.a[0][2] = metX;
+    S.a[1][2] = metY;
+
+    mat3 n_ = dot(dot(transpose(S), ss_.N), S);
+
+    double v[4][3];
+    int nv = intersections_ellipses(ss.N, n_, v);
+    if (nv < 0) return;
+
+    double perp[4][3], perp_[4][3];
+    for (int i = 0; i < nv; ++i)
+    {
+        for (int j = 0; j < 3; ++j) perp[i][j] = v[i][j];
+        dot(S, v[i], perp_[i]);
+    }
+
+    if (nv == 0)
+    {
+        double ts[2];
+        closestApproach(ss.H_perp, ss_.H_perp, metX, metY, ts, multiStart);
+        nus(ss.H_perp, ss_.H_perp, ts, perp[0], perp_[0]);
+        nv = 1;
+        sols.closestApproach = true;
+    }
+
+    // nunu_s
+    mat3 HpInv, HpInv_;
+    inv(ss.H_perp, HpInv);
+    inv(ss_.H_perp, HpInv_);
+    mat3 K = dot(ss.H, HpInv);
+    mat3 K_ = dot(ss_.H, HpInv_);
+
+    for (int i = 0; i < nv && i < nunuSolutions::MAXSOL; ++i)
+    {
+        dot(K, perp[i], sols.nu[i][0]);
+        dot(K_, perp_[i], sols.nu[i][1]);
+    }
+    sols.n = min(nv, (int)nunuSolutions::MAXSOL);
+    sols.ok = true;
+}
+
+//------------------------------------------------------------------------------
+// cross-check against nuSolutions.py
+//------------------------------------------------------------------------------
+
+bool sameSolutions(const nunuSolutions &ref, const nunuSolutions &sols,
+                   double metX, double metY, double tol)
+{
+    if (ref.ok != sols.ok || ref.n != sols.n) return false;
+
+    for (int is = 0; is < ref.n; ++is)
+    {
+        const double (*py)[3] = ref.nu[is];
+
+        // leastsq(epsfcn=0.01) stops well before convergence, so for the
+        // closest approach only require the native point to be at least as
+        // close to the measured MET
+        if (sols.closestApproach)
+        {
+            double dpy = sqrt(pow(py[0][0] + py[1][0] - metX, 2) + pow(py[0][1] + py[1][1] - metY, 2));
+            double dnat = sqrt(pow(sols.nu[0][0][0] + sols.nu[0][1][0] - metX, 2) + pow(sols.nu[0][0][1] + sols.nu[0][1][1] - metY, 2));
+            if (dnat > dpy + tol) return false;
+            continue;
+        }
+
+        // solutions may come out in a different order: match each python
+        // solution to the closest native one
+        double best = 1e99;
+        for (int jn = 0; jn < sols.n; ++jn)
+        {
+            double dmax = 0.;
+            for (int inu = 0; inu < 2; ++inu)
+                for (int ix = 0; ix < 3; ++ix)
+                    dmax = max(dmax, fabs(py[inu][ix] - sols.nu[jn][inu][ix]));
+            best = min(best, dmax);
+        }
+        if (best > tol) return false;
+    }
+
+    return true;
+}
+
+bool crossCheckWithPython(const TLorentzVector &b, const TLorentzVector &b_,
+                          const TLorentzVector &mu, const TLorentzVector &mu_,
+                          double metX, double metY, const nunuSolutions &sols, double tol)
+{
+    TPython::Exec(Form("l0 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", mu.Pt(), mu.Eta(), mu.Phi(), mu.E()));
+    TPython::Exec(Form("l1 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", mu_.Pt(), mu_.Eta(), mu_.Phi(), mu_.E()));
+    TPython::Exec(Form("j0 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", b.Pt(), b.Eta(), b.Phi(), b.E()));
+    TPython::Exec(Form("j1 = lv(%0.8f,%0.8f,%0.8f,%0.8f)", b_.Pt(), b_.Eta(), b_.Phi(), b_.E()));
+    TPython::Exec(Form("metx, mety = %0.8f, %0.8f", metX, metY));
+    TPython::Exec("dns = doubleNeutrinoSolutionsCheckLinAlg((j0, j1), (l0, l1), (metx, mety)).dns");
+    TPython::Exec("soltest = 0 if dns==0 else 1");
+
+    nunuSolutions py;
+    py.ok = (int)TPython::Eval("soltest") != 0;
+    py.closestApproach = false;
+    py.n = 0;
+    if (py.ok)
+    {
+        TPython::Exec("solutions = dns.nunu_s");
+        py.n = min((int)TPython::Eval("len(solutions)"), (int)nunuSolutions::MAXSOL);
+    }
+    for (int is = 0; is < py.n; ++is)
+        for (int inu = 0; inu < 2; ++inu)
+            for (int ix = 0; ix < 3; ++ix)
+                py.nu[is][inu][ix] = TPython::Eval(Form("solutions[%0d][%0d][%0d]", is, inu, ix));
+
+    bool same = sameSolutions(py, sols, metX, metY, tol);
+
+    if (!same)
+    {
+        cout << "[nuSolutions::crossCheckWithPython] mismatch: python ok " << py.ok << " nsol " << py.n
+             << ", native ok " << sols.ok << " nsol " << sols.n
+             << (sols.closestApproach ? " (closest approach)" : "") << endl;
+        for (int jn = 0; jn < sols.n; ++jn)
+            cout << "  native " << jn << ": (" << sols.nu[jn][0][0] << ", " << sols.nu[jn][0][1] << ", " << sols.nu[jn][0][2]
+                 << ") (" << sols.nu[jn][1][0] << ", " << sols.nu[jn][1][1] << ", " << sols.nu[jn][1][2] << ")" << endl;
+        TPython::Exec("print '  python:', solutions if dns != 0 else 'LinAlgError'");
+    }
+
+    return same;
+}
+
+}
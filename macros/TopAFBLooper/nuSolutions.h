@@ -0,0 +1,100 @@
+#ifndef NUSOLUTIONS_H
+#define NUSOLUTIONS_H
+
+//
+// Native C++ port of the analytic neutrino solver in nuSolutions.py
+// (B. Betchart, arXiv:1305.1878): nuSolutionSet, factor_degenerate,
+// intersections_ellipse_line, intersections_ellipses and
+// doubleNeutrinoSolutions(CheckLinAlg). Function and member names follow the
+// python so the two can be read side by side.
+//
+// Inputs are converted to PtEtaPhiE float Lorentz vectors exactly as
+// loadBetchart.py does, so the results agree with the python reference up to
+// the eigen-solver and least-squares implementations.
+//
+
+#include "Math/LorentzVector.h"
+#include "TLorentzVector.h"
+
+namespace nuSolutions
+{
+
+//these values are also hard-coded in StopTreeLooper.cc
+const double mT = 172.5;   // GeV : top quark mass
+const double mW = 80.385;  // GeV : W boson mass
+const double mN = 0.;      // GeV : neutrino mass
+
+typedef ROOT::Math::LorentzVector<ROOT::Math::PtEtaPhiE4D<float> > LV;
+
+struct mat3
+{
+    double a[3][3];
+};
+
+//
+// Solution pairs of neutrino momenta for one lepton-jet pairing.
+// ok is false where the python raises LinAlgError (dnsC.dns == 0).
+// closestApproach is set when no exact solution exists and the
+// least-squares point closest to the measured MET is returned instead.
+//
+struct nunuSolutions
+{
+    static const int MAXSOL = 4;
+
+    bool ok;
+    bool closestApproach;
+    int n;
+    double nu[MAXSOL][2][3];   // [solution][nu, nu_][x, y, z]
+};
+
+class nuSolutionSet
+{
+public:
+    nuSolutionSet(const LV &b, const LV &mu,
+                  double mW2 = mW * mW, double mT2 = mT * mT, double mN2 = mN * mN);
+
+    bool ok;        // false if H_perp is singular
+    mat3 H;         // t=[c,s,1] -> p_nu, lab coord.
+    mat3 H_perp;    // t=[c,s,1] -> pT_nu, lab coord.
+    mat3 N;         // solution ellipse of pT_nu, lab coord.
+
+    double c, s, x0, x0p, Sx, Sy, w, w_, x1, y1, Z, Om2, eps2, mW2;
+
+private:
+    mat3 R_T(const LV &b, const LV &mu) const;
+};
+
+// linear factors of a degenerate conic; returns the number of lines (0-2)
+int factor_degenerate(mat3 G, double lines[2][3], double zero = 0.);
+
+// points (homogeneous, z=1) where the line crosses the ellipse; returns 0-2
+int intersections_ellipse_line(const mat3 &ellipse, const double line[3], double points[2][3], double zero = 1e-12);
+
+// points where two ellipses cross; returns 0-4, or -1 if A and B are singular
+int intersections_ellipses(mat3 A, mat3 B, double points[4][3]);
+
+// doubleNeutrinoSolutionsCheckLinAlg((b, b_), (mu, mu_), (metX, metY)).nunu_s
+// The closest approach starts from (0,0) like the python; multiStart also
+// starts from the opposite points of both ellipses and keeps the best.
+void doubleNeutrinoSolutions(const TLorentzVector &b, const TLorentzVector &b_,
+                             const TLorentzVector &mu, const TLorentzVector &mu_,
+                             double metX, double metY, nunuSolutions &sols,
+                             double mW2 = mW * mW, double mT2 = mT * mT, bool multiStart = false);
+
+// sols against the python's ref for the same inputs: same ok and number of
+// solutions, each python solution within tol GeV of a native one in every
+// component; for a closest approach the native point only has to be as
+// close to the measured MET, within tol
+bool sameSolutions(const nunuSolutions &ref, const nunuSolutions &sols,
+                   double metX, double metY, double tol = 0.1);
+
+// run the python reference (loadBetchart.py must have been loaded through
+// TPython) on the same inputs and compare with sameSolutions; returns false
+// and prints both if they differ
+bool crossCheckWithPython(const TLorentzVector &b, const TLorentzVector &b_,
+                          const TLorentzVector &mu, const TLorentzVector &mu_,
+                          double metX, double metY, const nunuSolutions &sols, double tol = 0.1);
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "pdfLuminosity.h"
+
+#include "LHAPDF/LHAPDF.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// position of each cached flavour in the 13-element LHAPDF::xfx output
+//    -t  -b  -c  -s  -u  -d   g   d   u   s   c   b   t
+//     0   1   2   3   4   5   6   7   8   9   10  11  12
+static const int lhapdfIndex[PDFLuminosityCache::NFLAV] = { 3, 4, 5, 6, 7, 8, 9 };
+
+const double PDFLuminosityCache::XMAX = 0.5;
+
+PDFLuminosityCache::PDFLuminosityCache()
+    : initialized_(false), nset_(1), Q_(0.), xmin_(0.), lnxmin_(0.), invh_(0.)
+{
+}
+
+bool PDFLuminosityCache::init(int nset, double Q, double tolerance)
+{
+    nset_ = nset;
+    Q_ = Q;
+
+    xmin_ = max(LHAPDF::getXminM(nset, 0), 1e-6);
+    lnxmin_ = log(xmin_);
+    invh_ = (NNODES - 1) / (0. - lnxmin_);
+
+    for (int i = 0; i < NNODES; ++i)
+    {
+        double x = exp(lnxmin_ + i / invh_);
+        if (i == NNODES - 1) x = 1.;
+        xfxDirect(x, table_[i]);
+    }
+
+    double maxdev = validate();
+    initialized_ = maxdev <= tolerance;
+
+    cout << "[PDFLuminosityCache::init] tabulated " << NNODES << " nodes for x in [" << xmin_ << ", 1] at Q = " << Q
+         << ", max relative deviation from LHAPDF " << maxdev << " for x up to " << XMAX << endl;
+    if (!initialized_)
+        cout << "[PDFLuminosityCache::init] above the tolerance " << tolerance << ", not using the table" << endl;
+    return initialized_;
+}
+
+void PDFLuminosityCache::xfxDirect(double x, double f[NFLAV]) const
+{
+    vector<double> all = LHAPDF::xfxM(nset_, x, Q_);
+    for (int k = 0; k < NFLAV; ++k) f[k] = all[lhapdfIndex[k]];
+}
+
+void PDFLuminosityCache::xfx(double x, double f[NFLAV]) const
+{
+    double u = (log(x) - lnxmin_) * invh_;
+    int i = (int)u - 1;                           // first of the 4 nodes
+    i = min(max(i, 0), NNODES - 4);
+    double t = u - i;                             // in [0,3] away from the edges
+
+    double w0 = -(t - 1.) * (t - 2.) * (t - 3.) / 6.;
+    double w1 =  t * (t - 2.) * (t - 3.) / 2.;
+    double w2 = -t * (t - 1.) * (t - 3.) / 2.;
+    double w3 =  t * (t - 1.) * (t - 2.) / 6.;
+
+    const double *n0 = table_[i];
+    const double *n1 = table_[i + 1];
+    const double *n2 = table_[i + 2];
+    const double *n3 = table_[i + 3];
+    for (int k = 0; k < NFLAV; ++k)
+        f[k] = w0 * n0[k] + w1 * n1[k] + w2 * n2[k] + w3 * n3[k];
+}
+
+double PDFLuminosityCache::combine(const double f1[NFLAV], const double f2[NFLAV])
+{
+    //Should glue-glue be doubled? Probably not, but plot histo later
+    return (f1[U] * f2[UBAR] + f2[U] * f1[UBAR] +
+            f1[D] * f2[DBAR] + f2[D] * f1[DBAR] +
+            f1[S] * f2[SBAR] + f2[S] * f1[SBAR] +
+            f1[G] * f2[G]);
+}
+
+double PDFLuminosityCache::luminosity(double x1, double x2) const
+{
+    double f1[NFLAV], f2[NFLAV];
+    if (x1 >= xmin_ && x1 <= XMAX) xfx(x1, f1);
+    else xfxDirect(x1, f1);
+    if (x2 >= xmin_ && x2 <= XMAX) xfx(x2, f2);
+    else xfxDirect(x2, f2);
+
+    return combine(f1, f2);
+}
+
+double PDFLuminosityCache::validate(double xmin, double xmax, int nsteps) const
+{
+    // midpoints between nodes are where the interpolation is worst
+    vector<double> xs;
+    double lnlo = log(max(xmin, xmin_)), lnhi = log(xmax);
+    for (int i = 0; i < nsteps; ++i)
+    {
+        double lnx = lnlo + (lnhi - lnlo) * i / (nsteps - 1);
+        double node = floor((lnx - lnxmin_) * invh_);
+        xs.push_back(exp(lnxmin_ + (node + 0.5) / invh_));
+    }
+
+    vector< vector<double> > direct(xs.size(), vector<double>(NFLAV)), cached(xs.size(), vector<double>(NFLAV));
+    for (unsigned int i = 0; i < xs.size(); ++i)
+    {
+        xfxDirect(xs[i], &direct[i][0]);
+        xfx(xs[i], &cached[i][0]);
+    }
+
+    double maxdev = 0.;
+    for (unsigned int i = 0; i < xs.size(); ++i)
+        for (unsigned int j = 0; j < xs.size(); ++j)
+        {
+            double ref = combine(&direct[i][0], &direct[j][0]);
+            if (ref <= 0.) continue;
+            double dev = fabs(combine(&cached[i][0], &cached[j][0]) / ref - 1.);
+            maxdev = max(maxdev, dev);
+        }
+    return maxdev;
+}
@@ -0,0 +1,64 @@
+#ifndef PDFLUMINOSITY_H
+#define PDFLUMINOSITY_H
+
+//
+// Tabulated parton luminosity for the AMWT solution weight.
+//
+// StopTreeLooper::get_pdf_weight only needs the seven light flavours
+// (sbar ubar dbar g d u s) of one PDF member at one fixed scale, so they are
+// tabulated once at startup on a grid uniform in log(x) and interpolated
+// with 4-point Lagrange polynomials. A lookup is one log() and 28
+// multiply-adds per x, with no allocation.
+//
+// Accuracy (NNODES = 1000 between xmin and 1, spacing h = 0.0115 in ln x):
+// the interpolation error is ~0.023 h^4 |d^4(xf)/d(ln x)^4|, which for
+// CTEQ6-like shapes is below 1e-5 relative for x < 0.5 and below 1e-3 for
+// x < 0.9. ttbar at 8 TeV has x1*x2 >= 0.0019 and x is rarely above 0.5, so
+// the table is only used in [xmin, XMAX]; outside it the lookup falls back to
+// LHAPDF, and results there are identical to before.
+// init() measures the maximum deviation of the luminosity against direct
+// LHAPDF calls with validate() and refuses the table (returns false) if it
+// is above the tolerance; the caller then stays on LHAPDF.
+//
+
+class PDFLuminosityCache
+{
+public:
+    PDFLuminosityCache();
+
+    // tabulate member 0 of LHAPDF set nset (already initialised) at scale Q;
+    // false, and not initialised, if validate() is above tolerance
+    bool init(int nset, double Q, double tolerance = 1e-4);
+    bool isInitialized() const { return initialized_; }
+
+    // u1 ubar2 + u2 ubar1 + d1 dbar2 + d2 dbar1 + s1 sbar2 + s2 sbar1 + g1 g2
+    double luminosity(double x1, double x2) const;
+
+    // maximum relative deviation of luminosity() from direct LHAPDF calls,
+    // scanned over x1, x2 in [xmin, xmax] at the midpoints between nodes
+    double validate(double xmin = 1e-4, double xmax = XMAX, int nsteps = 200) const;
+
+    static const int NFLAV = 7;      // sbar ubar dbar g d u s
+    static const int NNODES = 1000;
+    static const double XMAX;        // table used up to here
+
+private:
+    enum { SBAR = 0, UBAR, DBAR, G, D, U, S };
+
+    // x f(x) for the seven flavours, interpolated from the table
+    void xfx(double x, double f[NFLAV]) const;
+    // x f(x) for the seven flavours, straight from LHAPDF
+    void xfxDirect(double x, double f[NFLAV]) const;
+
+    static double combine(const double f1[NFLAV], const double f2[NFLAV]);
+
+    bool initialized_;
+    int nset_;
+    double Q_;
+    double xmin_;
+    double lnxmin_;
+    double invh_;
+    double table_[NNODES][NFLAV];
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "CutflowAnalyzer.h"
+
+#include "../Core/STOPT.h"
+#include "../Core/stopUtils.h"
+#include "../Core/Cutflow.h"
+
+#include <cstdio>
+
+CutflowAnalyzer::CutflowAnalyzer()
+	: TrainAnalyzer("Cutflow")
+{
+}
+
+CutflowAnalyzer::~CutflowAnalyzer()
+{
+	clear();
+}
+
+void CutflowAnalyzer::clear(){
+	for (unsigned int i = 0; i < cutflows_.size(); ++i) delete cutflows_[i];
+	cutflows_.clear();
+}
+
+//--------------------------------------------------------------------
+
+void CutflowAnalyzer::begin(const TString& sample, bool isData){
+	m_sample_ = sample;
+
+	// fresh copies, so every sample gets its own counts
+	clear();
+	cutflows_.push_back(new Cutflow(singleLeptonCutflow()));
+	cutflows_.push_back(new Cutflow(dileptonCutflow()));
+	cutflows_.push_back(new Cutflow(lepPlusIsoTrkCutflow()));
+}
+
+void CutflowAnalyzer::analyze(const TrainEvent& evt){
+	if (!passEvtSelection(m_sample_)) return;
+	for (unsigned int i = 0; i < cutflows_.size(); ++i)
+		cutflows_[i]->pass(evt.isData, evt.weight);
+}
+
+void CutflowAnalyzer::end(){
+	FILE* out = stdout;
+	if (!m_outfilename_.empty()) {
+		out = fopen(m_outfilename_.c_str(), "w");
+		if (!out) {
+			printf("[CutflowAnalyzer::end] cannot open %s, printing here\n", m_outfilename_.c_str());
+			out = stdout;
+		}
+	}
+
+	fprintf(out, "%s\n", m_sample_.Data());
+	for (unsigned int i = 0; i < cutflows_.size(); ++i) {
+		cutflows_[i]->print(out);
+		fprintf(out, "\n");
+	}
+
+	if (out != stdout) {
+		fclose(out);
+		printf("[CutflowAnalyzer::end] cutflows written to %s\n", m_outfilename_.c_str());
+	}
+}
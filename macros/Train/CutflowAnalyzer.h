@@ -0,0 +1,35 @@
+#ifndef CUTFLOWANALYZER_H
+#define CUTFLOWANALYZER_H
+
+#include "../Core/AnalysisTrain.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Cutflow;
+
+// weighted cutflow tables of the lepton selections, after passEvtSelection
+class CutflowAnalyzer : public TrainAnalyzer {
+
+public:
+	CutflowAnalyzer();
+	~CutflowAnalyzer();
+
+	// tables go to stdout if no file is set
+	void setOutFileName(string filename) { m_outfilename_ = filename; }
+
+	void begin(const TString& sample, bool isData);
+	void analyze(const TrainEvent& evt);
+	void end();
+
+private:
+	void clear();
+
+	string m_outfilename_;
+	TString m_sample_;
+	vector<Cutflow*> cutflows_;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#include "../Core/AnalysisTrain.h"
+#include "../StopLooperTemplate/StopTreeLooper.h"
+#include "../StopLooperHiggs/StopTreeLooper.h"
+#include "CutflowAnalyzer.h"
+
+#ifdef __CINT__
+#pragma link off all globals;
+#pragma link off all classes;
+#pragma link C++ all functions;
+
+#pragma link C++ struct TrainEvent;
+#pragma link C++ class TrainAnalyzer;
+#pragma link C++ class AnalysisTrain;
+#pragma link C++ class StopTreeLooper;
+#pragma link C++ class HiggsLooper;
+#pragma link C++ class CutflowAnalyzer;
+#pragma link C++ class Candidate;
+#pragma link C++ class vector<Candidate>;
+
+#endif
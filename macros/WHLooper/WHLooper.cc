@@ -6,8 +6,13 @@
 
 #include "../Core/STOPT.h"
 #include "../Core/stopUtils.h"
+#include "../Core/RegionSelector.h"
+#include "WHRegions.h"
 #include "../Plotting/PlotUtilities.h"
-#include "../../Tools/BTagReshaping/BTagReshaping.h"
+#include "../Plotting/HistoGrid.h"
+#include "../Core/BTagReshaper.h"
+#include "../Core/ScaleFactors.h"
+#include "../Core/BDTForest.h"
 // #include "../Core/MT2Utility.h"
 // #include "../Core/mt2bl_bisect.h"
 // #include "../Core/mt2w_bisect.h"
@@ -30,11 +35,12 @@
 #include <map>
 #include <set>
 #include <list>
+#include <fstream>
+#include <cctype>
 
 using namespace Stop;
 
 // selections
-const bool blindSignal = false;
 const bool doTrkVeto = true;
 const bool doTauVeto = true;
 const bool doLep2Veto = true;
@@ -59,54 +65,39 @@ const bool doWbbNLO = false;
 const bool doLepFastSimSFs = true;
 const bool doUpdateSigXsec = true;
 
-// plotting options
-const bool doFlavorPlots = true;
-const bool doNM1Plots = true;
-const bool doWJetsPlots = false;
-const bool doNvtxSplit = false;
-const bool doJetAccPlots = false;
-const bool doMetBinRegions = false;
-
-// regions to do: need for signal region prediction/plots etc
-const bool doInclusive = true;
-const bool doSignal = true;
-const bool doSignalMassLast = true;
-const bool doSignalMETLast = true;
-const bool doCR5METLast = true; // bveto
-const bool doCR5InvMass = true; // bveto, inverted m(bb)
-const bool doCR5MassLast = true; // bveto, mass last
-const bool doCR14 = true; // inverted mbb region
-
-// regions to do: need for CR results/plots
-const bool doCR1METLast = false; // high m(bb), met cut last
-const bool doCR23 = false; // dilep + (lep+track)
-const bool doCR23MassLast = false; // dilep + (lep+track)
-const bool doCR5HighMass = false; // bveto, high mass
-const bool doCR5LowMass = false; // bveto, low mass
-const bool doCR8METLast = false; // low m(bb)
-
-// regions not really used
-const bool doInclusiveMTTail = false;
-const bool doSignal2Loose = false;
-const bool doSignal1Med = false;
-const bool doSignal1Med1Loose = false;
-const bool doSignalSMWH = false;
-const bool doCR1 = false; // high m(bb)
-const bool doCR2 = false; // lep + track
-const bool doCR3 = false; // dilep
-const bool doCR4 = false; // dilep, high m(bb)
-const bool doCR5 = false; // bveto
-const bool doCR5Loose = false; // bveto, looser
-const bool doCR6 = false; // 1 btag -- not used
-const bool doCR6METLast = false; // 1 btag -- not used
-const bool doCR7 = false; // high m(bb), 3 jets
-const bool doCR8 = false; // low m(bb)
-const bool doCR9 = false; // high m(bb), 150-200
-const bool doCR10 = false; // high m(bb), 200-250
-const bool doCR11 = false; // bveto, high m(bb)
-const bool doCR12 = false; // high m(bb), 4+ jets
-const bool doCR13 = false; // mt bulk
-const bool doStopSel = false;
+// plotting options and histogram groups: defaults, which a run config given
+//  to WHLooper::readConfig can change (see configFlags below); the region
+//  flags, doNM1Plots and doMetBinRegions are in WHRegions.cc
+bool doFlavorPlots = true;
+bool doWJetsPlots = false;
+bool doNvtxSplit = false;
+bool doJetAccPlots = false; // fillJetAccHists
+
+// histogram groups filled for each region
+bool doHists1D = true; // fillHists1D
+bool doFlavorHists1D = true; // fillFlavorHists1D; h_events is always filled
+bool doHists2D = true; // fillHists2D
+
+// keys of the run config
+struct ConfigFlag { const char* name; bool* flag; };
+const ConfigFlag configFlags[] = {
+  { "doFlavorPlots", &doFlavorPlots }, { "doNM1Plots", &doNM1Plots }, { "doWJetsPlots", &doWJetsPlots },
+  { "doNvtxSplit", &doNvtxSplit }, { "doJetAccPlots", &doJetAccPlots }, { "doMetBinRegions", &doMetBinRegions },
+  { "doHists1D", &doHists1D }, { "doFlavorHists1D", &doFlavorHists1D }, { "doHists2D", &doHists2D },
+  { "doInclusive", &doInclusive }, { "doSignal", &doSignal }, { "doSignalMassLast", &doSignalMassLast },
+  { "doSignalMETLast", &doSignalMETLast }, { "doCR5METLast", &doCR5METLast }, { "doCR5InvMass", &doCR5InvMass },
+  { "doCR5MassLast", &doCR5MassLast }, { "doCR14", &doCR14 }, { "doCR1METLast", &doCR1METLast },
+  { "doCR23", &doCR23 }, { "doCR23MassLast", &doCR23MassLast }, { "doCR5HighMass", &doCR5HighMass },
+  { "doCR5LowMass", &doCR5LowMass }, { "doCR8METLast", &doCR8METLast }, { "doInclusiveMTTail", &doInclusiveMTTail },
+  { "doSignal2Loose", &doSignal2Loose }, { "doSignal1Med", &doSignal1Med }, { "doSignal1Med1Loose", &doSignal1Med1Loose },
+  { "doSignalSMWH", &doSignalSMWH }, { "doCR1", &doCR1 }, { "doCR2", &doCR2 },
+  { "doCR3", &doCR3 }, { "doCR4", &doCR4 }, { "doCR5", &doCR5 },
+  { "doCR5Loose", &doCR5Loose }, { "doCR6", &doCR6 }, { "doCR6METLast", &doCR6METLast },
+  { "doCR7", &doCR7 }, { "doCR8", &doCR8 }, { "doCR9", &doCR9 },
+  { "doCR10", &doCR10 }, { "doCR11", &doCR11 }, { "doCR12", &doCR12 },
+  { "doCR13", &doCR13 }, { "doStopSel", &doStopSel },
+};
+const int nConfigFlags = sizeof(configFlags) / sizeof(configFlags[0]);
 
 std::set<DorkyEventIdentifier> already_seen; 
 std::set<DorkyEventIdentifier> events_lasercalib; 
@@ -132,6 +123,102 @@ bool replace(std::string& str, const std::string& from, const std::string& to) {
 
 //--------------------------------------------------------------------
 
+// 1D variables of the region histogram sets (fillHists1D, fillFlavorHists1D,
+//  fillJetAccHists), in order of appearance there
+enum WHVar {
+  WV_NJETS, WV_NJETSFWD, WV_NJETS20, WV_NJETSALL, WV_NBJETS, WV_NBJETSL,
+  WV_PFMETCALOMETDPHI_MET100, WV_PFMETCALOMETDPHI_MET150, WV_PFMETCALOMETDPHI_MET175, WV_METDIFF,
+  WV_METPHIDIFF, WV_BBMASS, WV_BBPT, WV_BBLEP1DR, WV_BBLEP1DPHI, WV_BBWDPHI, WV_BBWDPT,
+  WV_JETSMEARCORRS, WV_GENB1PT, WV_GENB2PT, WV_LEP1MT_LOWPU, WV_MET_LOWPU, WV_MT2BL_LOWPU,
+  WV_LEP1MT_HIGHPU, WV_MET_HIGHPU, WV_MT2BL_HIGHPU, WV_PASSTAUVETO, WV_NBS, WV_JET1FLAVOR_0B,
+  WV_JET2FLAVOR_0B, WV_JET1FLAVOR_1B, WV_JET2FLAVOR_1B, WV_JET1FLAVOR_2B, WV_JET2FLAVOR_2B,
+  WV_GENBJET1PT_1B, WV_GENBJET1PT, WV_GENBJET2PT, WV_BJET1PT, WV_BJET2PT, WV_BJET1ETA, WV_BJET2ETA,
+  WV_BJET1PUMVA, WV_BJET2PUMVA, WV_BJET1METDPHI, WV_BJET2METDPHI, WV_BBDR, WV_BBDPHI, WV_BBDETA,
+  WV_LEP1BJET1DR, WV_LEP1BJET2DR, WV_LEP1BJETMINDR, WV_LBBPT, WV_BBMDRPT, WV_LBBPT_LOWPU,
+  WV_LBBPT_HIGHPU, WV_BJET1ETA_LOWPT, WV_BJET2ETA_LOWPT, WV_BBDR_LOWPT, WV_BBDETA_LOWPT,
+  WV_BJET1ETA_HIGHPT, WV_BJET2ETA_HIGHPT, WV_BBDR_HIGHPT, WV_BBDETA_HIGHPT, WV_BJET1LEP1MASS,
+  WV_BJET1LEP1DPHI, WV_BJET2LEP1MASS, WV_BJET2LEP1DPHI, WV_BJETLEP1MINDPHI, WV_BJET1MC3,
+  WV_BJET2MC3, WV_BJET1FLAVOR, WV_BJET2FLAVOR, WV_JET1PT, WV_JET2PT, WV_JET1ETA, WV_JET2ETA,
+  WV_JET1METDPHI, WV_JET2METDPHI, WV_JJDR, WV_JJDPHI, WV_JJMDRPT, WV_JET1CSV, WV_JET2CSV,
+  WV_JETCSV_PT0, WV_JETCSV_PT1, WV_JETCSV_PT2, WV_JETCSV_PT3, WV_JETCSV_PT4, WV_JETCSV_PT5,
+  WV_JETCSV_PT6, WV_JETCSV_PT7, WV_JETCSV_PT8, WV_JETCSV_PT9, WV_JET1PUMVA, WV_JET2PUMVA,
+  WV_JET1CHMNEUDIFF, WV_JET2CHMNEUDIFF, WV_JET1TOBTECMULT, WV_JET1TOBTECMULTFRAC,
+  WV_JET1TOBTECFRAC, WV_JET2TOBTECMULT, WV_JET2TOBTECMULTFRAC, WV_JET2TOBTECFRAC,
+  WV_JET1CHMNEUDIFF_BADETA, WV_JET1TOBTECMULT_BADETA, WV_JET1TOBTECMULTFRAC_BADETA,
+  WV_JET1TOBTECFRAC_BADETA, WV_JET1CHMNEUDIFF_GOODETA, WV_JET1TOBTECMULT_GOODETA,
+  WV_JET1TOBTECMULTFRAC_GOODETA, WV_JET1TOBTECFRAC_GOODETA, WV_JET2CHMNEUDIFF_BADETA,
+  WV_JET2TOBTECMULT_BADETA, WV_JET2TOBTECMULTFRAC_BADETA, WV_JET2TOBTECFRAC_BADETA,
+  WV_JET2CHMNEUDIFF_GOODETA, WV_JET2TOBTECMULT_GOODETA, WV_JET2TOBTECMULTFRAC_GOODETA,
+  WV_JET2TOBTECFRAC_GOODETA, WV_JET1PUMVA_LOWBETA, WV_JET1PUMVA_HIGHBETA, WV_JET2PUMVA_LOWBETA,
+  WV_JET2PUMVA_HIGHBETA, WV_JET1PUMVA_CENTRAL, WV_JET1PUMVA_FORWARD, WV_JET2PUMVA_CENTRAL,
+  WV_JET2PUMVA_FORWARD, WV_JET1FLAVOR, WV_JET2FLAVOR, WV_JET3PT, WV_JET3ETA, WV_JET4PT, WV_JET4ETA,
+  WV_FWDJET1PT, WV_FWDJET1ETA, WV_FWDJET1PUMVA, WV_FWDJET2PT, WV_FWDJET2ETA, WV_FWDJET2PUMVA,
+  WV_NVTX, WV_VTXWEIGHT, WV_RHOVOR, WV_JET3CSV, WV_JET3FLAVOR, WV_BJET3PT, WV_BJET3ETA,
+  WV_BJET3FLAVOR, WV_GENTPT, WV_GENTBARPT, WV_GENTTBARPT, WV_TOPPTWEIGHT, WV_GENMT2BL,
+  WV_GENMTGENMET, WV_GENMTLN, WV_GENMLN, WV_NONRECO_GENJETPT, WV_NONRECO_GENJETETA,
+  WV_NGENJETS_OUTSIDEPT, WV_NGENJETS_OUTSIDEETA, WV_NGENJETS_OUTSIDEPTETA, WV_NMISSEDGENJETS,
+  WV_NGENQGS_OUTSIDEPT, WV_NGENQGS_OUTSIDEETA, WV_NGENQGS_OUTSIDEPTETA, WV_MHT15, WV_TRKMET_MHT15,
+  WV_METTLJ15, WV_MTTLJ15, WV_GENWPT, WV_GENHPT, WV_MG, WV_ML, WV_INITSTATEPT, WV_BDT0, WV_BDT1,
+  WV_BDT2, WV_BDT3, WV_BDT4, WV_LJETSPT, WV_LEP1PT, WV_LEP1ETA, WV_LEP1MT, WV_LEP1ISOPF, WV_MET,
+  WV_SUMET, WV_SUMET_SOFT, WV_HT, WV_HTLEP, WV_METSIG, WV_METSIGNIF, WV_PFMET, WV_T1MET10,
+  WV_TRKMET, WV_MET_SOFT, WV_GENMET, WV_GENMET_MINUS_PFMET, WV_GENMET_MINUS_PFMET_DIV_GENMET,
+  WV_PFSUMET, WV_PFMETSIG, WV_NGOODLEP, WV_WPT, WV_LEP1METDPHI, WV_MT2B, WV_MT2BL, WV_MT2W, WV_MCT,
+  WV_LEP2ID, WV_LEPPT, WV_PSEUDOMT_LEP, WV_PSEUDOMET_LEP, WV_DPHI_PSEUDOMET_LEP, WV_PSEUDOMT2B,
+  WV_PSEUDOMT2BL, WV_PSEUDOMT2W, WV_ISOTRKPT, WV_ISOTRKETA, WV_LEP1ISOTRKDPHI, WV_LEPCANDPT,
+  WV_LEPCANDETA, WV_LEP1LEPCANDDPHI, WV_LEP2PT, WV_LEP2ETA, WV_DILDPHI, WV_DILMASS, WV_DILPT,
+  WV_JETSIGMADIFF, WV_LEPOLAPDR, WV_EVENTS, WV_LOSTJETS, NWHVARS };
+
+const char* whVarNames[NWHVARS] = {
+  "h_njets", "h_njetsfwd", "h_njets20", "h_njetsall", "h_nbjets", "h_nbjetsl",
+  "h_pfmetcalometdphi_met100", "h_pfmetcalometdphi_met150", "h_pfmetcalometdphi_met175",
+  "h_metdiff", "h_metphidiff", "h_bbmass", "h_bbpt", "h_bblep1dr", "h_bblep1dphi", "h_bbwdphi",
+  "h_bbwdpt", "h_jetsmearcorrs", "h_genb1pt", "h_genb2pt", "h_lep1mt_lowpu", "h_met_lowpu",
+  "h_mt2bl_lowpu", "h_lep1mt_highpu", "h_met_highpu", "h_mt2bl_highpu", "h_passtauveto", "h_nbs",
+  "h_jet1flavor_0b", "h_jet2flavor_0b", "h_jet1flavor_1b", "h_jet2flavor_1b", "h_jet1flavor_2b",
+  "h_jet2flavor_2b", "h_genbjet1pt_1b", "h_genbjet1pt", "h_genbjet2pt", "h_bjet1pt", "h_bjet2pt",
+  "h_bjet1eta", "h_bjet2eta", "h_bjet1pumva", "h_bjet2pumva", "h_bjet1metdphi", "h_bjet2metdphi",
+  "h_bbdr", "h_bbdphi", "h_bbdeta", "h_lep1bjet1dr", "h_lep1bjet2dr", "h_lep1bjetmindr", "h_lbbpt",
+  "h_bbmdrpt", "h_lbbpt_lowpu", "h_lbbpt_highpu", "h_bjet1eta_lowpt", "h_bjet2eta_lowpt",
+  "h_bbdr_lowpt", "h_bbdeta_lowpt", "h_bjet1eta_highpt", "h_bjet2eta_highpt", "h_bbdr_highpt",
+  "h_bbdeta_highpt", "h_bjet1lep1mass", "h_bjet1lep1dphi", "h_bjet2lep1mass", "h_bjet2lep1dphi",
+  "h_bjetlep1mindphi", "h_bjet1mc3", "h_bjet2mc3", "h_bjet1flavor", "h_bjet2flavor", "h_jet1pt",
+  "h_jet2pt", "h_jet1eta", "h_jet2eta", "h_jet1metdphi", "h_jet2metdphi", "h_jjdr", "h_jjdphi",
+  "h_jjmdrpt", "h_jet1csv", "h_jet2csv", "h_jetcsv_pt0", "h_jetcsv_pt1", "h_jetcsv_pt2",
+  "h_jetcsv_pt3", "h_jetcsv_pt4", "h_jetcsv_pt5", "h_jetcsv_pt6", "h_jetcsv_pt7", "h_jetcsv_pt8",
+  "h_jetcsv_pt9", "h_jet1pumva", "h_jet2pumva", "h_jet1chmneudiff", "h_jet2chmneudiff",
+  "h_jet1tobtecmult", "h_jet1tobtecmultfrac", "h_jet1tobtecfrac", "h_jet2tobtecmult",
+  "h_jet2tobtecmultfrac", "h_jet2tobtecfrac", "h_jet1chmneudiff_badeta", "h_jet1tobtecmult_badeta",
+  "h_jet1tobtecmultfrac_badeta", "h_jet1tobtecfrac_badeta", "h_jet1chmneudiff_goodeta",
+  "h_jet1tobtecmult_goodeta", "h_jet1tobtecmultfrac_goodeta", "h_jet1tobtecfrac_goodeta",
+  "h_jet2chmneudiff_badeta", "h_jet2tobtecmult_badeta", "h_jet2tobtecmultfrac_badeta",
+  "h_jet2tobtecfrac_badeta", "h_jet2chmneudiff_goodeta", "h_jet2tobtecmult_goodeta",
+  "h_jet2tobtecmultfrac_goodeta", "h_jet2tobtecfrac_goodeta", "h_jet1pumva_lowbeta",
+  "h_jet1pumva_highbeta", "h_jet2pumva_lowbeta", "h_jet2pumva_highbeta", "h_jet1pumva_central",
+  "h_jet1pumva_forward", "h_jet2pumva_central", "h_jet2pumva_forward", "h_jet1flavor",
+  "h_jet2flavor", "h_jet3pt", "h_jet3eta", "h_jet4pt", "h_jet4eta", "h_fwdjet1pt", "h_fwdjet1eta",
+  "h_fwdjet1pumva", "h_fwdjet2pt", "h_fwdjet2eta", "h_fwdjet2pumva", "h_nvtx", "h_vtxweight",
+  "h_rhovor", "h_jet3csv", "h_jet3flavor", "h_bjet3pt", "h_bjet3eta", "h_bjet3flavor", "h_gentpt",
+  "h_gentbarpt", "h_genttbarpt", "h_topptweight", "h_genmt2bl", "h_genmtgenmet", "h_genmtln",
+  "h_genmln", "h_nonreco_genjetpt", "h_nonreco_genjeteta", "h_ngenjets_outsidept",
+  "h_ngenjets_outsideeta", "h_ngenjets_outsidepteta", "h_nmissedgenjets", "h_ngenqgs_outsidept",
+  "h_ngenqgs_outsideeta", "h_ngenqgs_outsidepteta", "h_mht15", "h_trkmet_mht15", "h_mettlj15",
+  "h_mttlj15", "h_genwpt", "h_genhpt", "h_mg", "h_ml", "h_initstatept", "h_bdt0", "h_bdt1",
+  "h_bdt2", "h_bdt3", "h_bdt4", "h_ljetspt", "h_lep1pt", "h_lep1eta", "h_lep1mt", "h_lep1isopf",
+  "h_met", "h_sumet", "h_sumet_soft", "h_ht", "h_htlep", "h_metsig", "h_metsignif", "h_pfmet",
+  "h_t1met10", "h_trkmet", "h_met_soft", "h_genmet", "h_genmet_minus_pfmet",
+  "h_genmet_minus_pfmet_div_genmet", "h_pfsumet", "h_pfmetsig", "h_ngoodlep", "h_wpt",
+  "h_lep1metdphi", "h_mt2b", "h_mt2bl", "h_mt2w", "h_mct", "h_lep2id", "h_leppt", "h_pseudomt_lep",
+  "h_pseudomet_lep", "h_dphi_pseudomet_lep", "h_pseudomt2b", "h_pseudomt2bl", "h_pseudomt2w",
+  "h_isotrkpt", "h_isotrketa", "h_lep1isotrkdphi", "h_lepcandpt", "h_lepcandeta",
+  "h_lep1lepcanddphi", "h_lep2pt", "h_lep2eta", "h_dildphi", "h_dilmass", "h_dilpt",
+  "h_jetsigmadiff", "h_lepolapdr", "h_events", "h_lostjets" };
+
+// name suffixes of the histograms of a region: the cells of its grid
+enum WHSuffix { SUF_NONE, SUF_E, SUF_M, SUF_EE, SUF_MM, SUF_EM, SUF_0GENB, SUF_1GENB, SUF_2GENB, NWHSUFFIXES };
+const char* whSuffixTags = ",_e,_m,_ee,_mm,_em,_0genb,_1genb,_2genb";
+
+//--------------------------------------------------------------------
+
 WHLooper::WHLooper()
 {
   m_outfilename_ = "histos.root";
@@ -139,22 +226,7 @@ WHLooper::WHLooper()
   t1metphicorrphi = -9999.;
   t1metphicorrmt = -9999.;
 
-  CUT_BBMASS_LOW_ = 100.0;
-  //  CUT_BBMASS_HIGH_ = 140.0;
-  CUT_BBMASS_HIGH_ = 150.0;
-  CUT_BBMASS_CR1_LOW_ = 150.0;
-  CUT_BBMASS_CR1_HIGH_ = 250.0;
-  CUT_BBMASS_CR8_LOW_ = 50.0;
-  CUT_BBMASS_CR8_HIGH_ = 100.0;
-  CUT_MET_PRESEL_ = 50.0;
-  //  CUT_MET_PRESEL_ = 100.0;
-  CUT_MET_ = 175.0;
-  //  CUT_MT_PRESEL_ = 50.0;
-  CUT_MT_PRESEL_ = 0.0;
-  CUT_MT_ = 100.0;
-  CUT_MT_CR13_LOW_ = 50.0;
-  CUT_MT_CR13_HIGH_ = 100.0;
-  CUT_MT2BL_ = 200.0;
+  haveDefaultVars_ = false;
 
 }
 
@@ -174,6 +246,112 @@ void WHLooper::setOutFileName(string filename)
 
 //--------------------------------------------------------------------
 
+// comma or space separated list, sorted for the lookups in setupRegionHists
+static std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  std::string item;
+  for (unsigned int i = 0; i <= list.size(); ++i) {
+    if (i == list.size() || list[i] == ',' || isspace(list[i])) {
+      if (!item.empty()) items.push_back(item);
+      item.clear();
+    } else {
+      item += list[i];
+    }
+  }
+  std::sort(items.begin(), items.end());
+  return items;
+}
+
+static std::string trim(const std::string& str) {
+  size_t first = str.find_first_not_of(" \t\r");
+  if (first == std::string::npos) return "";
+  size_t last = str.find_last_not_of(" \t\r");
+  return str.substr(first, last - first + 1);
+}
+
+void WHLooper::readConfig(const string& filename)
+{
+  // one setting per line, # starts a comment:
+  //   doCR23 = true            any flag of configFlags
+  //   vars = h_met h_mt        1D variables for all regions
+  //   vars.sig_final = h_met   1D variables for one region
+  ifstream in(filename.c_str());
+  if (!in.good()) {
+    cout << "[WHLooper::readConfig] cannot open " << filename << ", quitting" << endl;
+    exit(1);
+  }
+
+  cout << "[WHLooper::readConfig] " << filename << endl;
+
+  // any region a flag of the config can turn on
+  const std::vector<std::string> regionNames = allRegionNames();
+
+  std::string line;
+  int nline = 0;
+  while (std::getline(in, line)) {
+    ++nline;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    if (trim(line).empty()) continue;
+
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+      cout << "[WHLooper::readConfig] line " << nline << ": expected key = value, quitting" << endl;
+      exit(1);
+    }
+    std::string key = trim(line.substr(0, eq));
+    std::string value = trim(line.substr(eq + 1));
+
+    if (key == "vars" || key.compare(0, 5, "vars.") == 0) {
+      std::vector<std::string> vars = splitList(value);
+      for (unsigned int v = 0; v < vars.size(); ++v) {
+	if (std::find(whVarNames, whVarNames + NWHVARS, vars[v]) != whVarNames + NWHVARS) continue;
+	cout << "[WHLooper::readConfig] line " << nline << ": unknown variable " << vars[v] << ", quitting" << endl;
+	exit(1);
+      }
+      if (key == "vars") {
+	defaultVars_ = vars;
+	haveDefaultVars_ = true;
+	continue;
+      }
+      std::string region = key.substr(5);
+      if (!std::binary_search(regionNames.begin(), regionNames.end(), region)) {
+	cout << "[WHLooper::readConfig] line " << nline << ": unknown region " << region << ", quitting" << endl;
+	exit(1);
+      }
+      regionVars_[region] = vars;
+      continue;
+    }
+
+    bool found = false;
+    for (int i = 0; i < nConfigFlags; ++i) {
+      if (key != configFlags[i].name) continue;
+      if (value == "true" || value == "1") *configFlags[i].flag = true;
+      else if (value == "false" || value == "0") *configFlags[i].flag = false;
+      else {
+        cout << "[WHLooper::readConfig] line " << nline << ": " << key << " needs true or false, quitting" << endl;
+        exit(1);
+      }
+      found = true;
+      break;
+    }
+    if (!found) {
+      cout << "[WHLooper::readConfig] line " << nline << ": unknown key " << key << ", quitting" << endl;
+      exit(1);
+    }
+  }
+
+  for (int i = 0; i < nConfigFlags; ++i)
+    cout << "  " << configFlags[i].name << " = " << (*configFlags[i].flag ? "true" : "false") << endl;
+  if (haveDefaultVars_) cout << "  vars: " << defaultVars_.size() << " variables" << endl;
+  std::map<std::string, std::vector<std::string> >::const_iterator it;
+  for (it = regionVars_.begin(); it != regionVars_.end(); it++)
+    cout << "  vars." << it->first << ": " << it->second.size() << " variables" << endl;
+
+}
+
+//--------------------------------------------------------------------
+
 void WHLooper::loop(TChain *chain, TString name) {
 
   // Benchmark
@@ -348,7 +526,10 @@ void WHLooper::loop(TChain *chain, TString name) {
     return;
   }
 
-  BTagShapeInterface * nominalShape = new BTagShapeInterface("../../Tools/BTagReshaping/csvdiscr.root", 0.0, 0.0);
+  // shared with any other looper in the session, built once
+  BTagReshaper * reshaper = BTagReshaper::get("../../Tools/BTagReshaping/csvdiscr.root");
+  // trigger and b-tag scale factors
+  ScaleFactors scaleFactors;
 
   //------------------------------
   // set up signal nevents hist
@@ -398,19 +579,19 @@ void WHLooper::loop(TChain *chain, TString name) {
 
   const int NREG_TChiWH = 3;
   //  const int NREG_TChiWH = 5;
-  TMVA::Reader* reader_TChiWH[NREG_TChiWH];
+  BDTReader* bdt_TChiWH[NREG_TChiWH];
   if ( doEvalBDT ) {
     for (int i=0; i < NREG_TChiWH ; i++){
-      reader_TChiWH[i] = new TMVA::Reader( "!Color:!Silent" );
-      reader_TChiWH[i]->AddVariable("mini_met", &met_);
-      reader_TChiWH[i]->AddVariable("mini_mt", &mt_);
-      reader_TChiWH[i]->AddVariable("mini_mt2bl", &mt2bl_);
-      reader_TChiWH[i]->AddVariable("mini_lep1pt", &lep1pt_);
-      // reader_TChiWH[i]->AddVariable("mini_pt_J1", &pt_J1_);
-      // reader_TChiWH[i]->AddVariable("mini_pt_J2", &pt_J2_);
-      reader_TChiWH[i]->AddVariable("mini_bbpt", &bbpt_);
-      reader_TChiWH[i]->AddVariable("mini_bbwdphi", &bbwdphi_);
-      reader_TChiWH[i]->AddVariable("mini_bbdR", &bbdR_);
+      bdt_TChiWH[i] = new BDTReader();
+      bdt_TChiWH[i]->addVariable("mini_met", &met_);
+      bdt_TChiWH[i]->addVariable("mini_mt", &mt_);
+      bdt_TChiWH[i]->addVariable("mini_mt2bl", &mt2bl_);
+      bdt_TChiWH[i]->addVariable("mini_lep1pt", &lep1pt_);
+      // bdt_TChiWH[i]->addVariable("mini_pt_J1", &pt_J1_);
+      // bdt_TChiWH[i]->addVariable("mini_pt_J2", &pt_J2_);
+      bdt_TChiWH[i]->addVariable("mini_bbpt", &bbpt_);
+      bdt_TChiWH[i]->addVariable("mini_bbwdphi", &bbwdphi_);
+      bdt_TChiWH[i]->addVariable("mini_bbdR", &bbdR_);
 
       TString dir, prefix;
       //      dir    = "/nfs-7/userdata/olivito/MVA/weights/V00-00-01/";
@@ -421,7 +602,7 @@ void WHLooper::loop(TChain *chain, TString name) {
       prefix += "_BDT";
 
       TString weightfile = dir + prefix + TString(".weights.xml");
-      reader_TChiWH[i]      ->BookMVA( "BDT" , weightfile );
+      bdt_TChiWH[i]->book( weightfile.Data() );
     }
   }
 
@@ -439,659 +620,34 @@ void WHLooper::loop(TChain *chain, TString name) {
 
   cout << "[WHLooper::loop] setting up histos" << endl;
 
-  // inclusive region hists
-  std::map<std::string, TH1F*> h_1d_inc_presel, h_1d_inc_2j, h_1d_inc_1b, h_1d_inc_2b, h_1d_inc_2j_mt, h_1d_inc_2j_mt_met100, h_1d_inc_2j_mt_met150, h_1d_inc_2j_mt_metcut;
-
-  // signal region hists
-  std::map<std::string, TH1F*> h_1d_sig_presel, h_1d_sig_final;
-  // signal region nm1 hists
-  std::map<std::string, TH1F*> h_1d_sig_met_nm1, h_1d_sig_mt_nm1, h_1d_sig_mt2bl_nm1;
-  // signal mtpeak hists
-  std::map<std::string, TH1F*> h_1d_sig_mtpeak_nomet, h_1d_sig_mtpeak_met;
-
-  // signal region hists
-  std::map<std::string, TH1F*> h_1d_sig_bbmasslast_presel, h_1d_sig_bbmasslast_final;
-  // signal region nm1 hists
-  std::map<std::string, TH1F*> h_1d_sig_bbmasslast_met_nm1, h_1d_sig_bbmasslast_mt_nm1, h_1d_sig_bbmasslast_mt2bl_nm1,h_1d_sig_bbmasslast_bbmass_nm1;
-  // signal region nm1 hists
-  std::map<std::string, TH1F*> h_1d_sig_bbmasslast_mtpeak, h_1d_sig_bbmasslast_mtcut, h_1d_sig_bbmasslast_mtcut_met100, h_1d_sig_bbmasslast_metcut, h_1d_sig_bbmasslast_met100, h_1d_sig_bbmasslast_met125, h_1d_sig_bbmasslast_met150, h_1d_sig_bbmasslast_nomt_met50, h_1d_sig_bbmasslast_nomt_met75, h_1d_sig_bbmasslast_nomt_met100, h_1d_sig_bbmasslast_nomt_met125, h_1d_sig_bbmasslast_nomt_met150, h_1d_sig_bbmasslast_nomt_met137, h_1d_sig_bbmasslast_nomt_met162, h_1d_sig_bbmasslast_nomt_met175;
-
-  // signal region hists
-  std::map<std::string, TH1F*> h_1d_sig_metlast_presel, h_1d_sig_metlast_final;
-  // signal region nm1 hists
-  std::map<std::string, TH1F*> h_1d_sig_metlast_met_nm1, h_1d_sig_metlast_mtfirst, h_1d_sig_metlast_mt_nm1, h_1d_sig_metlast_mt2bl_nm1, h_1d_sig_metlast_met100, h_1d_sig_metlast_met125, h_1d_sig_metlast_met125_mt120, h_1d_sig_metlast_met150, h_1d_sig_metlast_nomt_met100, h_1d_sig_metlast_nomt_met150, h_1d_sig_metlast_nomt_met175;
+  // one set of hists per region of declareRegions
+  RegionSelector regions;
+  std::vector<WHRegionInfo> regionInfo;
+  declareRegions(regions, regionInfo);
+  std::vector<std::map<std::string, TH1F*> > h_1d_regions(regions.nRegions());
+
+  // no-selection and top pt weight plots go with the presel regions
+  std::map<std::string, TH1F*> h_1d_unsaved;
+  const int r_inc_presel = regions.find("inc_presel");
+  const int r_sig_presel = regions.find("sig_presel");
+  std::map<std::string, TH1F*>& h_1d_inc_presel = (r_inc_presel >= 0) ? h_1d_regions[r_inc_presel] : h_1d_unsaved;
+  std::map<std::string, TH1F*>& h_1d_sig_presel = (r_sig_presel >= 0) ? h_1d_regions[r_sig_presel] : h_1d_unsaved;
+  const int r_sig_metlast_mt2bl_nm1 = regions.find("sig_metlast_mt2bl_nm1");
+  // regions with more to do than filling: see the event loop
+  const int r_cr1_metlast_presel = regions.find("cr1_metlast_presel");
+  const int r_cr3_presel = regions.find("cr3_presel");
+  const int r_cr4_presel = regions.find("cr4_presel");
+  const int r_cr6_presel = regions.find("cr6_presel");
+  const int r_cr11_presel = regions.find("cr11_presel");
+
   // 2d hists for correlations
   std::map<std::string, TH2F*> h_2d_sig_metlast_mt2bl_nm1;
 
-  // signal region hists, 2 loose
-  std::map<std::string, TH1F*> h_1d_sig_2loose_presel, h_1d_sig_2loose_final;
-  // signal region nm1 hists, 2 loose
-  std::map<std::string, TH1F*> h_1d_sig_2loose_met_nm1, h_1d_sig_2loose_mtfirst, h_1d_sig_2loose_mt_nm1, h_1d_sig_2loose_mt2bl_nm1, h_1d_sig_2loose_met100, h_1d_sig_2loose_met150;
-
-  // signal region hists, 1 med
-  std::map<std::string, TH1F*> h_1d_sig_1med_presel, h_1d_sig_1med_final;
-  // signal region nm1 hists, 1 med
-  std::map<std::string, TH1F*> h_1d_sig_1med_met_nm1, h_1d_sig_1med_mtfirst, h_1d_sig_1med_mt_nm1, h_1d_sig_1med_mt2bl_nm1, h_1d_sig_1med_met100, h_1d_sig_1med_met150;
-
-  // signal region hists, 1 med 1 loose
-  std::map<std::string, TH1F*> h_1d_sig_1med1loose_presel, h_1d_sig_1med1loose_final;
-  // signal region nm1 hists, 1 med 1 loose
-  std::map<std::string, TH1F*> h_1d_sig_1med1loose_met_nm1, h_1d_sig_1med1loose_mtfirst, h_1d_sig_1med1loose_mt_nm1, h_1d_sig_1med1loose_mt2bl_nm1, h_1d_sig_1med1loose_met100, h_1d_sig_1med1loose_met150;
-
-  // signal SMWH region hists
-  std::map<std::string, TH1F*> h_1d_sigsmwh_presel, h_1d_sigsmwh_final;
-  // // signal region nm1 hists
-  // std::map<std::string, TH1F*> h_1d_sig_met_nm1, h_1d_sig_mt_nm1, h_1d_sig_mt2bl_nm1;
-  // // signal mtpeak hists
-  // std::map<std::string, TH1F*> h_1d_sig_mtpeak_nomet, h_1d_sig_mtpeak_met;
-
-  // cr1 hists
-  std::map<std::string, TH1F*> h_1d_cr1_presel, h_1d_cr1_final;
-  // cr1 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr1_met_nm1, h_1d_cr1_mt_nm1, h_1d_cr1_mt2bl_nm1;
-  // cr1 mtpeak hists
-  std::map<std::string, TH1F*> h_1d_cr1_mtpeak_nomet, h_1d_cr1_mtpeak_met, h_1d_cr1_mtlast_mt2bl_nm1;
-
-  // cr1, met last hists
-  std::map<std::string, TH1F*> h_1d_cr1_metlast_presel, h_1d_cr1_metlast_final;
-  // cr1, met last nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr1_metlast_mt_nm1, h_1d_cr1_metlast_mtfirst, h_1d_cr1_metlast_mt2bl_nm1, h_1d_cr1_metlast_met_nm1, h_1d_cr1_metlast_met100, h_1d_cr1_metlast_met125, h_1d_cr1_metlast_met150;
-
-  // cr2 hists
-  std::map<std::string, TH1F*> h_1d_cr2_presel, h_1d_cr2_final;
-  // cr2 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr2_bbmass_nm1, h_1d_cr2_met_nm1, h_1d_cr2_mt_nm1, h_1d_cr2_mt2blfirst, h_1d_cr2_mt2blcut, h_1d_cr2_mt2bl_nm1;
-
-  // cr3 hists
-  std::map<std::string, TH1F*> h_1d_cr3_presel, h_1d_cr3_final;
-  // cr3 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr3_bbmass_nm1, h_1d_cr3_met_nm1, h_1d_cr3_mt_nm1, h_1d_cr3_mt2blfirst, h_1d_cr3_mt2blcut, h_1d_cr3_mt2bl_nm1;
-
-  // cr23 hists
-  std::map<std::string, TH1F*> h_1d_cr23_presel, h_1d_cr23_final;
-  // cr23 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr23_bbmass_nm1, h_1d_cr23_met_nm1, h_1d_cr23_mt_nm1, h_1d_cr23_mt2blfirst, h_1d_cr23_metcut, h_1d_cr23_met100, h_1d_cr23_met125, h_1d_cr23_met150, h_1d_cr23_mt2bl_nm1;
-
-  // cr23 mass last region hists
-  std::map<std::string, TH1F*> h_1d_cr23_bbmasslast_presel, h_1d_cr23_bbmasslast_final;
-  // cr23 mass last region nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr23_bbmasslast_met_nm1, h_1d_cr23_bbmasslast_mt_nm1, h_1d_cr23_bbmasslast_mt2bl_nm1,h_1d_cr23_bbmasslast_bbmass_nm1;
-  // cr23 mass last region nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr23_bbmasslast_met100, h_1d_cr23_bbmasslast_met125, h_1d_cr23_bbmasslast_met150;
-
-  // cr4 hists
-  std::map<std::string, TH1F*> h_1d_cr4_presel, h_1d_cr4_final;
-  // cr4 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr4_met_nm1, h_1d_cr4_mt_nm1, h_1d_cr4_mt2bl_nm1;
-
-  // cr5 hists
-  std::map<std::string, TH1F*> h_1d_cr5_presel, h_1d_cr5_final;
-  // cr5 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_bbmass_nm1, h_1d_cr5_met_nm1, h_1d_cr5_met100, h_1d_cr5_mt_nm1, h_1d_cr5_mt2bl_nm1;
-
-  // cr5 loose hists
-  std::map<std::string, TH1F*> h_1d_cr5_loose_presel, h_1d_cr5_loose_final;
-  // cr5 loose nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_loose_met_nm1;
-
-  // cr5, met last hists
-  std::map<std::string, TH1F*> h_1d_cr5_metlast_presel, h_1d_cr5_metlast_final;
-  // cr5, met last nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_metlast_bbmass_nm1, h_1d_cr5_metlast_mtfirst, h_1d_cr5_metlast_mt_nm1, h_1d_cr5_metlast_mt2bl_nm1, h_1d_cr5_metlast_met_nm1, h_1d_cr5_metlast_met100, h_1d_cr5_metlast_met125, h_1d_cr5_metlast_met150, h_1d_cr5_metlast_nomt_met100, h_1d_cr5_metlast_nomt_met150, h_1d_cr5_metlast_nomt_met175;
-
-  // cr5, inv mass hists
-  std::map<std::string, TH1F*> h_1d_cr5_invmass_presel, h_1d_cr5_invmass_final;
-  // cr5, inv mass nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_invmass_bbmass_nm1, h_1d_cr5_invmass_mtfirst, h_1d_cr5_invmass_mt_nm1, h_1d_cr5_invmass_mt2bl_nm1, h_1d_cr5_invmass_met_nm1, h_1d_cr5_invmass_met100, h_1d_cr5_invmass_met125, h_1d_cr5_invmass_met150, h_1d_cr5_invmass_nomt_met100, h_1d_cr5_invmass_nomt_met150, h_1d_cr5_invmass_nomt_met175;
-
-  // cr5, high mass met last hists
-  std::map<std::string, TH1F*> h_1d_cr5_highmass_presel, h_1d_cr5_highmass_final;
-  // cr5, high mass met last nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_highmass_mtfirst, h_1d_cr5_highmass_mt_nm1, h_1d_cr5_highmass_mt2bl_nm1, h_1d_cr5_highmass_met_nm1, h_1d_cr5_highmass_met100, h_1d_cr5_highmass_met125, h_1d_cr5_highmass_met150;
-
-  // cr5, low mass met last hists
-  std::map<std::string, TH1F*> h_1d_cr5_lowmass_presel, h_1d_cr5_lowmass_final;
-  // cr5, low mass met last nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_lowmass_mtfirst, h_1d_cr5_lowmass_mt_nm1, h_1d_cr5_lowmass_mt2bl_nm1, h_1d_cr5_lowmass_met_nm1, h_1d_cr5_lowmass_met100, h_1d_cr5_lowmass_met125, h_1d_cr5_lowmass_met150;
-
-  // cr5 mass last region hists
-  std::map<std::string, TH1F*> h_1d_cr5_bbmasslast_presel, h_1d_cr5_bbmasslast_final;
-  // cr5 mass last region nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_bbmasslast_met_nm1, h_1d_cr5_bbmasslast_mt_nm1, h_1d_cr5_bbmasslast_mt2bl_nm1,h_1d_cr5_bbmasslast_bbmass_nm1;
-  // cr5 mass last region nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr5_bbmasslast_mtpeak, h_1d_cr5_bbmasslast_mtcut, h_1d_cr5_bbmasslast_mtcut_met100, h_1d_cr5_bbmasslast_metcut, h_1d_cr5_bbmasslast_met100, h_1d_cr5_bbmasslast_met125, h_1d_cr5_bbmasslast_met150, h_1d_cr5_bbmasslast_met500, h_1d_cr5_bbmasslast_nomt_met50, h_1d_cr5_bbmasslast_nomt_met75, h_1d_cr5_bbmasslast_nomt_met100, h_1d_cr5_bbmasslast_nomt_met125, h_1d_cr5_bbmasslast_nomt_met150, h_1d_cr5_bbmasslast_nomt_met137, h_1d_cr5_bbmasslast_nomt_met162, h_1d_cr5_bbmasslast_nomt_met175;
-
-  // cr6 hists
-  std::map<std::string, TH1F*> h_1d_cr6_presel, h_1d_cr6_final;
-  // cr6 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr6_met_nm1, h_1d_cr6_mt_nm1, h_1d_cr6_mt2bl_nm1;
-
-  // cr6, met last hists
-  std::map<std::string, TH1F*> h_1d_cr6_metlast_presel, h_1d_cr6_metlast_final;
-  // cr6, met last nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr6_metlast_bbmass_nm1, h_1d_cr6_metlast_mt_nm1, h_1d_cr6_metlast_mt2bl_nm1, h_1d_cr6_metlast_met_nm1, h_1d_cr6_metlast_met100, h_1d_cr6_metlast_met150;
-
-  // cr7 hists
-  std::map<std::string, TH1F*> h_1d_cr7_presel, h_1d_cr7_final;
-  // cr7 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr7_met_nm1, h_1d_cr7_mt_nm1, h_1d_cr7_mt2bl_nm1;
-
-  // cr8 hists
-  std::map<std::string, TH1F*> h_1d_cr8_presel, h_1d_cr8_final;
-  // cr8 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr8_met_nm1, h_1d_cr8_mt_nm1, h_1d_cr8_mt2bl_nm1;
-
-  // cr8, met last hists
-  std::map<std::string, TH1F*> h_1d_cr8_metlast_presel, h_1d_cr8_metlast_final;
-  // cr8, met last nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr8_metlast_mt_nm1, h_1d_cr8_metlast_mtfirst, h_1d_cr8_metlast_mt2bl_nm1, h_1d_cr8_metlast_met_nm1, h_1d_cr8_metlast_met100, h_1d_cr8_metlast_met125, h_1d_cr8_metlast_met150;
-
-  // cr9 hists
-  std::map<std::string, TH1F*> h_1d_cr9_presel, h_1d_cr9_final;
-  // cr9 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr9_met_nm1, h_1d_cr9_mt_nm1, h_1d_cr9_mt2bl_nm1;
-  // cr9 mtpeak hists
-  std::map<std::string, TH1F*> h_1d_cr9_mtpeak_nomet, h_1d_cr9_mtpeak_met, h_1d_cr9_mtlast_mt2bl_nm1;
-
-  // cr10 hists
-  std::map<std::string, TH1F*> h_1d_cr10_presel, h_1d_cr10_final;
-  // cr10 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr10_met_nm1, h_1d_cr10_mt_nm1, h_1d_cr10_mt2bl_nm1;
-
-  // cr11 hists
-  std::map<std::string, TH1F*> h_1d_cr11_presel, h_1d_cr11_final;
-  // cr11 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr11_met_nm1, h_1d_cr11_mt_nm1, h_1d_cr11_mt2bl_nm1;
-
-  // cr12 hists
-  std::map<std::string, TH1F*> h_1d_cr12_presel, h_1d_cr12_final;
-  // cr12 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr12_bbmass_nm1, h_1d_cr12_met_nm1, h_1d_cr12_mt_nm1, h_1d_cr12_mt2bl_nm1;
-
-  // cr13 hists
-  std::map<std::string, TH1F*> h_1d_cr13_presel, h_1d_cr13_final;
-  // cr13 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr13_bbmass_nm1, h_1d_cr13_mt2bl_nm1, h_1d_cr13_met_nm1, h_1d_cr13_met100, h_1d_cr13_met150;
-
-  // cr14 hists
-  std::map<std::string, TH1F*> h_1d_cr14_presel, h_1d_cr14_final;
-  // cr14 nm1 hists
-  std::map<std::string, TH1F*> h_1d_cr14_mt_nm1, h_1d_cr14_mtfirst, h_1d_cr14_mt2bl_nm1, h_1d_cr14_met_nm1, h_1d_cr14_met100, h_1d_cr14_met125, h_1d_cr14_met150, h_1d_cr14_nomt_met100, h_1d_cr14_nomt_met150, h_1d_cr14_nomt_met175;
-
-  // stop region hists
-  std::map<std::string, TH1F*> h_1d_stop_presel, h_1d_stop_comp;
-  std::map<std::string, TH1F*> h_1d_stop_met_nm1, h_1d_stop_mt_nm1, h_1d_stop_isotrk_nm1, h_1d_stop_tauveto_nm1 ;
-
-  if (doInclusive) {
-    outfile_->mkdir("inc_presel");
-    outfile_->mkdir("inc_2j");
-    if (doInclusiveMTTail) {
-      outfile_->mkdir("inc_2j_mt");
-      outfile_->mkdir("inc_2j_mt_met100");
-      outfile_->mkdir("inc_2j_mt_met150");
-      outfile_->mkdir("inc_2j_mt_metcut");
-    }
-    outfile_->mkdir("inc_1b");
-    outfile_->mkdir("inc_2b");
-  }
-
-  if (doSignal) {
-    outfile_->mkdir("sig_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("sig_met_nm1");
-      outfile_->mkdir("sig_mtpeak_nomet");
-      outfile_->mkdir("sig_mt_nm1");
-      outfile_->mkdir("sig_mtpeak_met");
-      outfile_->mkdir("sig_mt2bl_nm1");
-    }
-    outfile_->mkdir("sig_final");
-  }
-
-  if (doSignalMassLast) {
-    outfile_->mkdir("sig_bbmasslast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("sig_bbmasslast_mt2bl_nm1");
-      outfile_->mkdir("sig_bbmasslast_mtpeak");
-      outfile_->mkdir("sig_bbmasslast_mtcut");
-      outfile_->mkdir("sig_bbmasslast_mtcut_met100");
-      outfile_->mkdir("sig_bbmasslast_metcut");
-      outfile_->mkdir("sig_bbmasslast_mt_nm1");
-      if (doMetBinRegions) {
-	outfile_->mkdir("sig_bbmasslast_nomt_met50");
-	outfile_->mkdir("sig_bbmasslast_nomt_met75");
-	outfile_->mkdir("sig_bbmasslast_nomt_met100");
-	outfile_->mkdir("sig_bbmasslast_nomt_met125");
-	outfile_->mkdir("sig_bbmasslast_nomt_met137");
-	outfile_->mkdir("sig_bbmasslast_nomt_met150");
-	outfile_->mkdir("sig_bbmasslast_nomt_met162");
-	outfile_->mkdir("sig_bbmasslast_nomt_met175");
-      }
-      outfile_->mkdir("sig_bbmasslast_met_nm1");
-      outfile_->mkdir("sig_bbmasslast_met100");
-      outfile_->mkdir("sig_bbmasslast_met125");
-      outfile_->mkdir("sig_bbmasslast_met150");
-      outfile_->mkdir("sig_bbmasslast_bbmass_nm1");
-    }
-    outfile_->mkdir("sig_bbmasslast_final");
-  }
-
-  if (doSignalMETLast) {
-    outfile_->mkdir("sig_metlast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("sig_metlast_mt2bl_nm1");
-      outfile_->mkdir("sig_metlast_mtfirst");
-      if (doMetBinRegions) {
-	outfile_->mkdir("sig_metlast_nomt_met100");
-	outfile_->mkdir("sig_metlast_nomt_met150");
-	outfile_->mkdir("sig_metlast_nomt_met175");
-      }
-      outfile_->mkdir("sig_metlast_mt_nm1");
-      outfile_->mkdir("sig_metlast_met_nm1");
-      outfile_->mkdir("sig_metlast_met100");
-      outfile_->mkdir("sig_metlast_met125");
-      outfile_->mkdir("sig_metlast_met150");
-    }
-    outfile_->mkdir("sig_metlast_final");
-  }
-
-  if (doSignal2Loose) {
-    outfile_->mkdir("sig_2loose_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("sig_2loose_mt2bl_nm1");
-      outfile_->mkdir("sig_2loose_mt_nm1");
-      outfile_->mkdir("sig_2loose_met_nm1");
-      outfile_->mkdir("sig_2loose_met100");
-      outfile_->mkdir("sig_2loose_met150");
-    }
-    outfile_->mkdir("sig_2loose_final");
-  }
-
-  if (doSignal1Med) {
-    outfile_->mkdir("sig_1med_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("sig_1med_mt2bl_nm1");
-      outfile_->mkdir("sig_1med_mt_nm1");
-      outfile_->mkdir("sig_1med_met_nm1");
-      outfile_->mkdir("sig_1med_met100");
-      outfile_->mkdir("sig_1med_met150");
-    }
-    outfile_->mkdir("sig_1med_final");
-  }
-
-  if (doSignal1Med1Loose) {
-    outfile_->mkdir("sig_1med1loose_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("sig_1med1loose_mt2bl_nm1");
-      outfile_->mkdir("sig_1med1loose_mt_nm1");
-      outfile_->mkdir("sig_1med1loose_met_nm1");
-      outfile_->mkdir("sig_1med1loose_met100");
-      outfile_->mkdir("sig_1med1loose_met150");
-    }
-    outfile_->mkdir("sig_1med1loose_final");
-  }
-
-  if (doSignalSMWH) {
-    outfile_->mkdir("sigsmwh_presel");
-    // if (doNM1Plots) {
-    //   outfile_->mkdir("sig_met_nm1");
-    //   outfile_->mkdir("sig_mtpeak_nomet");
-    //   outfile_->mkdir("sig_mt_nm1");
-    //   outfile_->mkdir("sig_mtpeak_met");
-    //   outfile_->mkdir("sig_mt2bl_nm1");
-    // }
-    outfile_->mkdir("sigsmwh_final");
-  }
-
-  if (doCR1) {
-    outfile_->mkdir("cr1_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr1_met_nm1");
-      outfile_->mkdir("cr1_mtpeak_nomet");
-      outfile_->mkdir("cr1_mt_nm1");
-      outfile_->mkdir("cr1_mtpeak_met");
-      outfile_->mkdir("cr1_mt2bl_nm1");
-      outfile_->mkdir("cr1_mtlast_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr1_final");
-  }
-
-  if (doCR1METLast) {
-    outfile_->mkdir("cr1_metlast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr1_metlast_mt2bl_nm1");
-      outfile_->mkdir("cr1_metlast_mtfirst");
-      outfile_->mkdir("cr1_metlast_mt_nm1");
-      outfile_->mkdir("cr1_metlast_met_nm1");
-      outfile_->mkdir("cr1_metlast_met100");
-      outfile_->mkdir("cr1_metlast_met125");
-      outfile_->mkdir("cr1_metlast_met150");
-    }
-    outfile_->mkdir("cr1_metlast_final");
-  }
-
-  if (doCR2) {
-    outfile_->mkdir("cr2_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr2_bbmass_nm1");
-      outfile_->mkdir("cr2_mt_nm1");
-      outfile_->mkdir("cr2_mt2blfirst");
-      outfile_->mkdir("cr2_met_nm1");
-      outfile_->mkdir("cr2_mt2blcut");
-      outfile_->mkdir("cr2_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr2_final");
-  }
-
-  if (doCR3) {
-    outfile_->mkdir("cr3_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr3_bbmass_nm1");
-      outfile_->mkdir("cr3_mt_nm1");
-      outfile_->mkdir("cr3_mt2blfirst");
-      outfile_->mkdir("cr3_met_nm1");
-      outfile_->mkdir("cr3_mt2blcut");
-      outfile_->mkdir("cr3_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr3_final");
-  }
-
-  if (doCR23) {
-    outfile_->mkdir("cr23_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr23_bbmass_nm1");
-      outfile_->mkdir("cr23_mt_nm1");
-      outfile_->mkdir("cr23_mt2blfirst");
-      outfile_->mkdir("cr23_mt2bl_nm1");
-      outfile_->mkdir("cr23_metcut");
-      outfile_->mkdir("cr23_met_nm1");
-      outfile_->mkdir("cr23_met100");
-      outfile_->mkdir("cr23_met125");
-      outfile_->mkdir("cr23_met150");
-    }
-    outfile_->mkdir("cr23_final");
-  }
-
-  if (doCR23MassLast) {
-    outfile_->mkdir("cr23_bbmasslast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr23_bbmasslast_mt_nm1");
-      outfile_->mkdir("cr23_bbmasslast_mt2bl_nm1");
-      outfile_->mkdir("cr23_bbmasslast_met_nm1");
-      outfile_->mkdir("cr23_bbmasslast_met100");
-      outfile_->mkdir("cr23_bbmasslast_met125");
-      outfile_->mkdir("cr23_bbmasslast_met150");
-      outfile_->mkdir("cr23_bbmasslast_bbmass_nm1");
-    }
-    outfile_->mkdir("cr23_bbmasslast_final");
-  }
-
-  if (doCR4) {
-    outfile_->mkdir("cr4_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr4_mt2bl_nm1");
-      outfile_->mkdir("cr4_met_nm1");
-      outfile_->mkdir("cr4_mt_nm1");
-    }
-    outfile_->mkdir("cr4_final");
-  }
-
-  if (doCR5) {
-    outfile_->mkdir("cr5_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_bbmass_nm1");
-      outfile_->mkdir("cr5_met_nm1");
-      outfile_->mkdir("cr5_met100");
-      outfile_->mkdir("cr5_mt_nm1");
-      outfile_->mkdir("cr5_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr5_final");
-  }
-
-  if (doCR5Loose) {
-    outfile_->mkdir("cr5_loose_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_loose_met_nm1");
-    }
-    outfile_->mkdir("cr5_loose_final");
-  }
-
-  if (doCR5METLast) {
-    outfile_->mkdir("cr5_metlast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_metlast_bbmass_nm1");
-      outfile_->mkdir("cr5_metlast_mt2bl_nm1");
-      outfile_->mkdir("cr5_metlast_mtfirst");
-      if (doMetBinRegions) {
-	outfile_->mkdir("cr5_metlast_nomt_met100");
-	outfile_->mkdir("cr5_metlast_nomt_met150");
-	outfile_->mkdir("cr5_metlast_nomt_met175");
-      }
-      outfile_->mkdir("cr5_metlast_mt_nm1");
-      outfile_->mkdir("cr5_metlast_met_nm1");
-      outfile_->mkdir("cr5_metlast_met100");
-      outfile_->mkdir("cr5_metlast_met125");
-      outfile_->mkdir("cr5_metlast_met150");
-    }
-    outfile_->mkdir("cr5_metlast_final");
-  }
-
-  if (doCR5InvMass) {
-    outfile_->mkdir("cr5_invmass_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_invmass_bbmass_nm1");
-      outfile_->mkdir("cr5_invmass_mt2bl_nm1");
-      outfile_->mkdir("cr5_invmass_mtfirst");
-      if (doMetBinRegions) {
-	outfile_->mkdir("cr5_invmass_nomt_met100");
-	outfile_->mkdir("cr5_invmass_nomt_met150");
-	outfile_->mkdir("cr5_invmass_nomt_met175");
-      }
-      outfile_->mkdir("cr5_invmass_mt_nm1");
-      outfile_->mkdir("cr5_invmass_met_nm1");
-      outfile_->mkdir("cr5_invmass_met100");
-      outfile_->mkdir("cr5_invmass_met125");
-      outfile_->mkdir("cr5_invmass_met150");
-    }
-    outfile_->mkdir("cr5_invmass_final");
-  }
-
-  if (doCR5HighMass) {
-    outfile_->mkdir("cr5_highmass_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_highmass_mt2bl_nm1");
-      outfile_->mkdir("cr5_highmass_mtfirst");
-      outfile_->mkdir("cr5_highmass_mt_nm1");
-      outfile_->mkdir("cr5_highmass_met_nm1");
-      outfile_->mkdir("cr5_highmass_met100");
-      outfile_->mkdir("cr5_highmass_met125");
-      outfile_->mkdir("cr5_highmass_met150");
-    }
-    outfile_->mkdir("cr5_highmass_final");
-  }
-
-  if (doCR5LowMass) {
-    outfile_->mkdir("cr5_lowmass_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_lowmass_mt2bl_nm1");
-      outfile_->mkdir("cr5_lowmass_mtfirst");
-      outfile_->mkdir("cr5_lowmass_mt_nm1");
-      outfile_->mkdir("cr5_lowmass_met_nm1");
-      outfile_->mkdir("cr5_lowmass_met100");
-      outfile_->mkdir("cr5_lowmass_met125");
-      outfile_->mkdir("cr5_lowmass_met150");
-    }
-    outfile_->mkdir("cr5_lowmass_final");
-  }
-
-  if (doCR5MassLast) {
-    outfile_->mkdir("cr5_bbmasslast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr5_bbmasslast_mt2bl_nm1");
-      outfile_->mkdir("cr5_bbmasslast_mtpeak");
-      outfile_->mkdir("cr5_bbmasslast_mtcut");
-      outfile_->mkdir("cr5_bbmasslast_mtcut_met100");
-      outfile_->mkdir("cr5_bbmasslast_metcut");
-      outfile_->mkdir("cr5_bbmasslast_mt_nm1");
-      if (doMetBinRegions) {
-	outfile_->mkdir("cr5_bbmasslast_nomt_met50");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met75");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met100");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met125");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met137");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met150");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met162");
-	outfile_->mkdir("cr5_bbmasslast_nomt_met175");
-      }
-      outfile_->mkdir("cr5_bbmasslast_met_nm1");
-      outfile_->mkdir("cr5_bbmasslast_met100");
-      outfile_->mkdir("cr5_bbmasslast_met125");
-      outfile_->mkdir("cr5_bbmasslast_met150");
-      outfile_->mkdir("cr5_bbmasslast_met500");
-      outfile_->mkdir("cr5_bbmasslast_bbmass_nm1");
-    }
-    outfile_->mkdir("cr5_bbmasslast_final");
-  }
-
-  if (doCR6) {
-    outfile_->mkdir("cr6_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr6_met_nm1");
-      outfile_->mkdir("cr6_mt_nm1");
-      outfile_->mkdir("cr6_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr6_final");
-  }
-
-  if (doCR6METLast) {
-    outfile_->mkdir("cr6_metlast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr6_metlast_bbmass_nm1");
-      outfile_->mkdir("cr6_metlast_mt2bl_nm1");
-      outfile_->mkdir("cr6_metlast_mt_nm1");
-      outfile_->mkdir("cr6_metlast_met_nm1");
-      outfile_->mkdir("cr6_metlast_met100");
-      outfile_->mkdir("cr6_metlast_met150");
-    }
-    outfile_->mkdir("cr6_metlast_final");
-  }
-
-  if (doCR7) {
-    outfile_->mkdir("cr7_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr7_met_nm1");
-      outfile_->mkdir("cr7_mt_nm1");
-      outfile_->mkdir("cr7_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr7_final");
-  }
-
-  if (doCR8) {
-    outfile_->mkdir("cr8_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr8_met_nm1");
-      outfile_->mkdir("cr8_mt_nm1");
-      outfile_->mkdir("cr8_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr8_final");
-  }
-
-  if (doCR8METLast) {
-    outfile_->mkdir("cr8_metlast_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr8_metlast_mt2bl_nm1");
-      outfile_->mkdir("cr8_metlast_mtfirst");
-      outfile_->mkdir("cr8_metlast_mt_nm1");
-      outfile_->mkdir("cr8_metlast_met_nm1");
-      outfile_->mkdir("cr8_metlast_met100");
-      outfile_->mkdir("cr8_metlast_met125");
-      outfile_->mkdir("cr8_metlast_met150");
-    }
-    outfile_->mkdir("cr8_metlast_final");
-  }
-
-  if (doCR9) {
-    outfile_->mkdir("cr9_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr9_met_nm1");
-      outfile_->mkdir("cr9_mtpeak_nomet");
-      outfile_->mkdir("cr9_mt_nm1");
-      outfile_->mkdir("cr9_mtpeak_met");
-      outfile_->mkdir("cr9_mt2bl_nm1");
-      outfile_->mkdir("cr9_mtlast_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr9_final");
-  }
-
-  if (doCR10) {
-    outfile_->mkdir("cr10_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr10_met_nm1");
-      outfile_->mkdir("cr10_mt_nm1");
-      outfile_->mkdir("cr10_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr10_final");
-  }
-
-  if (doCR11) {
-    outfile_->mkdir("cr11_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr11_met_nm1");
-      outfile_->mkdir("cr11_mt_nm1");
-      outfile_->mkdir("cr11_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr11_final");
-  }
-
-  if (doCR12) {
-    outfile_->mkdir("cr12_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr12_met_nm1");
-      outfile_->mkdir("cr12_mt_nm1");
-      outfile_->mkdir("cr12_mt2bl_nm1");
-    }
-    outfile_->mkdir("cr12_final");
-  }
-
-  if (doCR13) {
-    outfile_->mkdir("cr13_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr13_bbmass_nm1");
-      outfile_->mkdir("cr13_mt2bl_nm1");
-      outfile_->mkdir("cr13_met_nm1");
-      outfile_->mkdir("cr13_met100");
-      outfile_->mkdir("cr13_met150");
-    }
-    outfile_->mkdir("cr13_final");
-  }
-
-  if (doCR14) {
-    outfile_->mkdir("cr14_presel");
-    if (doNM1Plots) {
-      outfile_->mkdir("cr14_mt2bl_nm1");
-      outfile_->mkdir("cr14_mtfirst");
-      if (doMetBinRegions) {
-	outfile_->mkdir("cr14_nomt_met100");
-	outfile_->mkdir("cr14_nomt_met150");
-	outfile_->mkdir("cr14_nomt_met175");
-      }
-      outfile_->mkdir("cr14_mt_nm1");
-      outfile_->mkdir("cr14_met_nm1");
-      outfile_->mkdir("cr14_met100");
-      outfile_->mkdir("cr14_met125");
-      outfile_->mkdir("cr14_met150");
-    }
-    outfile_->mkdir("cr14_final");
-  }
-
-  if (doStopSel) {
-    outfile_->mkdir("stop_presel");
-    outfile_->mkdir("stop_met_nm1");
-    outfile_->mkdir("stop_mt_nm1");
-    outfile_->mkdir("stop_isotrk_nm1");
-    outfile_->mkdir("stop_tauveto_nm1");
-    outfile_->mkdir("stop_comp");
+  std::vector<RegionHists> regionHists(regions.nRegions());
+  for (int r = 0; r < regions.nRegions(); ++r) {
+    outfile_->mkdir(regions.name(r).c_str());
+    setupRegionHists(regionHists[r], h_1d_regions[r], regions.name(r));
   }
-
   outfile_->cd();
 
   //------------------------------
@@ -1359,9 +915,9 @@ void WHLooper::loop(TChain *chain, TString name) {
 
       // trigger effs
       float sltrigeff = isData ? 1. : 
-	getsltrigweight(stopt.id1(), stopt.lep1().Pt(), stopt.lep1().Eta());
+	scaleFactors.slTrigWeight(stopt.id1(), stopt.lep1().Pt(), stopt.lep1().Eta()).nominal;
       float dltrigeff = isData ? 1. : 
-	getdltrigweight(stopt.id1(), stopt.id2());
+	scaleFactors.dlTrigWeight(stopt.id1(), stopt.id2());
 
       float evtweight1l = evtweight * sltrigeff;
       float evtweight2l = evtweight * dltrigeff;
@@ -1482,10 +1038,10 @@ void WHLooper::loop(TChain *chain, TString name) {
 	//RESHAPING -- requires babies V20 or higher
 	//  -- may need to validate for non-b-jets
 	if (doCSVReshaping && !isData && !isTChiwh_) {
-	  csv_nominal = nominalShape->reshape( thisjet.eta(),
-					       thisjet.pt(),
-					       stopt.pfjets_csv().at(i),
-					       stopt.pfjets_mcflavorAlgo().at(i) ); 
+	  csv_nominal = reshaper->reshape( thisjet.eta(),
+					   thisjet.pt(),
+					   stopt.pfjets_csv().at(i),
+					   stopt.pfjets_mcflavorAlgo().at(i) ); 
 	}
 
 	jets_csv_.push_back( csv_nominal );
@@ -1501,7 +1057,7 @@ void WHLooper::loop(TChain *chain, TString name) {
 	  }
 	  // apply SF if requested
 	  if (doBtagSFs && !isData && !isTChiwh_) {
-	    float sf = getBtagSF(thisjet.pt(),thisjet.eta(),stopt.pfjets_mcflavorAlgo().at(i),isTChiwh_ || isWino_ || isTChiWHMG_);
+	    float sf = scaleFactors.btagSF(thisjet.pt(),thisjet.eta(),stopt.pfjets_mcflavorAlgo().at(i),isTChiwh_ || isWino_ || isTChiWHMG_).nominal;
 	    evtweight1l *= sf;
 	    evtweight2l *= sf;
 	  }
@@ -1635,7 +1191,7 @@ void WHLooper::loop(TChain *chain, TString name) {
       // evaluate BDTs for this event
       if ( doEvalBDT && (njets_ >= 2) ) {
       	for (int i=0; i < NREG_TChiWH ; i++){
-      	  bdtvals_.push_back(reader_TChiWH[i]->EvaluateMVA( "BDT" ));
+      	  bdtvals_.push_back(bdt_TChiWH[i]->evaluate());
       	}
       }
 
@@ -1693,7 +1249,7 @@ void WHLooper::loop(TChain *chain, TString name) {
       if (pt_J1_ < 50.) continue;
 
       // require minimum MET
-      if (met_ <= CUT_MET_PRESEL_) continue;
+      if (met_ <= CUT_MET_PRESEL) continue;
 
       if (doTobTecVeto && tobtecveto_) continue;
       ++nPass_PreselCuts;
@@ -1702,2696 +1258,268 @@ void WHLooper::loop(TChain *chain, TString name) {
       //      if ( stopt.isopf1() > 0.1 ) continue;
 
       // -------------------------------------------
-      // *** inclusive preselection:
-      //   >= 1 lepton
-      //   >= 2 (central) jets
-      //   met > 50
-      //
-      //   then add btags
-
-      if ( doInclusive
-	   && passSingleLeptonSelection(isData) 
-	   && (njets_ >= 2)
-	   && (met_ > CUT_MET_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_inc_presel,evtweight1l,"inc_presel");
-
-	if ( (njetsall_ == 2) ) {
-	  fillHists1DWrapper(h_1d_inc_2j,evtweight1l,"inc_2j");
-	}
+      // *** regions of declareRegions:
+      //   evaluate each cut once, then fill every passing region
+
+      WHRegionInputs in;
+      in.isData = isData;
+      in.lep1 = passSingleLeptonSelection(isData);
+      in.isotrk = passisotrk;
+      in.lepisotrk = passLepPlusIsoTrkSelectionWHMet(isData);
+      in.dilep = passDileptonSelection(isData);
+      in.isotrkv4 = passIsoTrkVeto_v4();
+      in.tauveto = passTauVeto();
+      in.id1 = stopt.id1();
+      in.id2 = stopt.id2();
+      in.dilmass = stopt.dilmass();
+      in.njets = njets_;
+      in.njetsall = njetsall_;
+      in.nbjets = nbjets_;
+      in.nbjetsl = nbjetsl_;
+      in.nbjetst = nbjetst_;
+      in.bbmass = bb_.M();
+      in.bbpt = bb_.pt();
+      in.bbwdphi = bbwdphi_;
+      in.wpt = wpt_;
+      in.lepmetdphi = lepmetdphi_;
+      in.met = met_;
+      in.mt = mt_;
+      in.mt2bl = mt2bl_;
+      setRegionCuts(regions, in);
+
+      const std::vector<int>& passedRegions = regions.select();
+      for (unsigned int i = 0; i < passedRegions.size(); ++i) {
+	int r = passedRegions[i];
+
+	if (r == r_cr1_metlast_presel && isData && (stopt.ngoodlep() >= 2)) dumpEventInfo("CR1 2lep event");
+	// pseudo met etc for the dilepton regions
+	if (r == r_cr3_presel || r == r_cr4_presel) calculatePseudoMET();
+	// compute MT2 vars for 1 b (CR6) and 0 b (CR11) events passing the presel;
+	//  the regions after these see them too
+	if (r == r_cr6_presel || r == r_cr11_presel) {
+	  mt2b_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2b);
+	  mt2bl_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2bl);
+	  mt2w_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2w);
+	}
+
+	const WHRegionInfo& ri = regionInfo[r];
+	if (ri.nm1Only && !doNM1Plots) continue;
+	float weight = evtweight1l;
+	if (ri.weight == RW_2L) weight = evtweight2l;
+	else if (ri.weight == RW_NOVTX) weight = evtweight_novtxweight;
+	for (int f = 0; f < ri.fills; ++f) fillHists1DWrapper(regionHists[r],weight);
+	if (doHists2D && r == r_sig_metlast_mt2bl_nm1) fillHists2D(h_2d_sig_metlast_mt2bl_nm1,evtweight1l,"sig_metlast_mt2bl_nm1");
+      }
 
-	if (doInclusiveMTTail) {
-	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) ) {
-	    fillHists1DWrapper(h_1d_inc_2j_mt,evtweight1l,"inc_2j_mt");
-	  }
+      // end regions ----------------------------------------
+      // ----------------------------------------------------
 
-	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) && (met_ > 100.) ) {
-	    fillHists1DWrapper(h_1d_inc_2j_mt_met100,evtweight1l,"inc_2j_mt_met100");
-	  }
+      ++nEventsPass;
 
-	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) && (met_ > 150.) ) {
-	    fillHists1DWrapper(h_1d_inc_2j_mt_met150,evtweight1l,"inc_2j_mt_met150");
-	  }
+    } // end event loop
 
-	  if ( (njetsall_ == 2) && (mt_ > CUT_MT_) && (met_ > CUT_MET_) ) {
-	    fillHists1DWrapper(h_1d_inc_2j_mt_metcut,evtweight1l,"inc_2j_mt_metcut");
-	  }
-	}
+    // delete tree;
+    
+  } // end file loop
+  
+    //
+    // finish
+    //
 
-	bool fail = false;
-	if ( !fail && (nbjets_ >= 1) ) {
-	  fillHists1DWrapper(h_1d_inc_1b,evtweight1l,"inc_1b");
-	}
-	else fail = true;
+  for (int r = 0; r < regions.nRegions(); ++r) {
+    savePlotsDir(h_1d_regions[r],outfile_,(char*)regions.name(r).c_str());
+  }
+  if (r_sig_metlast_mt2bl_nm1 >= 0) {
+    savePlots2Dir(h_2d_sig_metlast_mt2bl_nm1,outfile_,"sig_metlast_mt2bl_nm1");
+  }
+  regions.printSummary();
 
-	if (!fail && (nbjets_ >= 2 ) ) {
-	  fillHists1DWrapper(h_1d_inc_2b,evtweight1l,"inc_2b");
-	}
-	else fail = true;
-      }
+  // the histograms were in the region maps and are written and deleted by now
+  for (int r = 0; r < regions.nRegions(); ++r) delete regionHists[r].grid;
 
-      // -------------------------------------------
-      // *** presel for signal region:
-      //   == 1 lepton, iso track veto
-      //   >= 2 bjets
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      // *** signal region:
-      //   == 1 lepton, iso track veto
-      //   == 2 jets, all eta
-      //   == 2 bjets
-      //   100 < m(bb) < 150
-      //   met > 175 (cut at 50 for presel)
-      //   mt > 100
-      //   mt2bl > 200
-
-      if ( doSignal
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) 
-	   && (!isData || !blindSignal) ) {
-
-        fillHists1DWrapper(h_1d_sig_presel,evtweight1l,"sig_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_met_nm1,evtweight1l,"sig_met_nm1");
-	}
-	else fail = true;
+  outfile_->Write();
+  outfile_->Close();
+  delete outfile_;
 
-	// mt peak before cutting on met
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mtpeak_nomet,evtweight1l,"sig_mtpeak_nomet");
-	}
+  already_seen.clear();
 
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mt_nm1,evtweight1l,"sig_mt_nm1");
-	}
-	else fail = true;
+  gROOT->cd();
 
-	// mt peak after cutting on met
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mtpeak_met,evtweight1l,"sig_mtpeak_met");
-	}
+  bmark->Stop("benchmark");
+  cout << endl;
+  cout << nEventsTotal << " Events Processed" << endl;
+  cout << nPass_EventCuts << " Events Passing basic event cuts" << endl;
+  cout << nPass_PreselCuts << " Events Passing basic presel cuts" << endl;
+  if (!isData)  cout << nEventsPass << " Events Passed" << endl;
+  cout << "------------------------------" << endl;
+  cout << "CPU  Time:	" << Form( "%.01f s", bmark->GetCpuTime("benchmark")  ) << ", Rate: " << Form( "%.1f Hz", float(nEventsTotal)/bmark->GetCpuTime("benchmark")) << endl;
+  cout << "Real Time:	" << Form( "%.01f s", bmark->GetRealTime("benchmark") ) << ", Rate: " << Form( "%.1f Hz", float(nEventsTotal)/bmark->GetRealTime("benchmark")) << endl;
+  cout << endl;
+  delete bmark;
 
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mt2bl_nm1,evtweight1l,"sig_mt2bl_nm1");
-	}
-	else fail = true;
+}
 
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_sig_final,evtweight1l,"sig_final");
-	}
+//--------------------------------------------------------------------
 
-      } // signal region sel
+float WHLooper::getCSVCut(const csvpoint csv) {
+  float csvcut = 10.;
+  if (csv == WHLooper::CSVM) csvcut = 0.679;
+  else if (csv == WHLooper::CSVL) csvcut = 0.244;
+  else if (csv == WHLooper::CSVT) csvcut = 0.898;
 
-      // -------------------------------------------
-      // *** signal region, but applying m(bb) cut last
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 2 bjets
-      //   met > 50
-
-      if ( doSignalMassLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-	   //	   && (!isData || !blindSignal) ) {
-
-	// for data: remove mass window, so we can compare bb mass shape outside signal region as cuts are applied
-	bool fail = false;
-	if (isData && blindSignal && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_CR1_LOW_) ) fail = true;
-
-        if (!fail) fillHists1DWrapper(h_1d_sig_bbmasslast_presel,evtweight1l,"sig_bbmasslast_presel");
-
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_mt2bl_nm1,evtweight1l,"sig_bbmasslast_mt2bl_nm1");
-	}
-	else fail = true;
+  return csvcut;
+}
 
-	// mt peak before cutting on met/mt/mt2bl
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_mtpeak,evtweight1l,"sig_bbmasslast_mtpeak");
-	}
+//--------------------------------------------------------------------
 
-	// plots for bbmass after each of the major cuts done separately
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_mtcut,evtweight1l,"sig_bbmasslast_mtcut");
-	  if (!fail && (met_ > 100.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_mtcut_met100,evtweight1l,"sig_bbmasslast_mtcut_met100");
-	  }
-	}
+void WHLooper::fillHists1DWrapper(const RegionHists& rh, const float evtweight) {
 
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_metcut,evtweight1l,"sig_bbmasslast_metcut");
-	}
+  HistoGrid& h = *rh.grid;
+  if (doHists1D) fillHists1D(rh, SUF_NONE, evtweight);
+  if (doFlavorHists1D) {
+    fillFlavorHists1D(rh, SUF_NONE, evtweight);
+  } else {
+    // events histogram for the yields: bin 1: raw, bin 2: weighted
+    h.fill(WV_EVENTS, SUF_NONE,       0.5,       1., 2, 0., 2.);
+    h.fill(WV_EVENTS, SUF_NONE,       1.5,       evtweight, 2, 0., 2.);
+  }
+  if (doFlavorHists1D && doFlavorPlots) {
+    // single lepton regions: separate into e, m
+    if (!rh.dilep) {
+      if (stopt.leptype() == 0) fillFlavorHists1D(rh,SUF_E,evtweight);
+      else if (stopt.leptype() == 1) fillFlavorHists1D(rh,SUF_M,evtweight);
+    }
 
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_mt_nm1,evtweight1l,"sig_bbmasslast_mt_nm1");
-	}
-	else fail = true;
+    // for dilepton regions (cr3/4), separate into ee, mm, em
+    else {
+      int id1 = fabs(stopt.id1());
+      int id2 = fabs(stopt.id2());
+      if (id1 == 11 && id2 == 11) fillFlavorHists1D(rh,SUF_EE,evtweight);
+      else if (id1 == 11 && id2 == 13) fillFlavorHists1D(rh,SUF_MM,evtweight);
+      else fillFlavorHists1D(rh,SUF_EM,evtweight);
+    }
+  }
 
-	if (doMetBinRegions) {
+  if (doHists1D && doWJetsPlots && isWjets_ && rh.inc) {
+    if (stopt.nbs() == 0) fillHists1D(rh,SUF_0GENB,evtweight);
+    else if (stopt.nbs() == 1) fillHists1D(rh,SUF_1GENB,evtweight);
+    else if (stopt.nbs() == 2) fillHists1D(rh,SUF_2GENB,evtweight);
+  }
 
-	  if (!fail && (met_ > 50.) && (met_ <= 75.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met50,evtweight1l,"sig_bbmasslast_nomt_met50");
-	  }
+}
 
-	  if (!fail && (met_ > 75.) && (met_ <= 100.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met75,evtweight1l,"sig_bbmasslast_nomt_met75");
-	  }
+//--------------------------------------------------------------------
 
-	  if (!fail && (met_ > 100.) && (met_ <= 125.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met100,evtweight1l,"sig_bbmasslast_nomt_met100");
-	  }
+void WHLooper::setupRegionHists(RegionHists& rh, std::map<std::string, TH1F*>& h_1d, const std::string& dir) {
 
-	  if (!fail && (met_ > 125.) && (met_ <= 150.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met125,evtweight1l,"sig_bbmasslast_nomt_met125");
-	  }
+  rh.grid = new HistoGrid(h_1d, true);
+  rh.grid->addAxis(whSuffixTags);
+  for (int v = 0; v < NWHVARS; ++v) rh.grid->addVariable(whVarNames[v]);
 
-	  if (!fail && (met_ > 137.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met137,evtweight1l,"sig_bbmasslast_nomt_met137");
-	  }
+  // variable list of the run config for this region, if any
+  const std::vector<std::string>* vars = 0;
+  std::map<std::string, std::vector<std::string> >::const_iterator it = regionVars_.find(dir);
+  if (it != regionVars_.end()) vars = &it->second;
+  else if (haveDefaultVars_) vars = &defaultVars_;
+  if (vars) {
+    for (int v = 0; v < NWHVARS; ++v)
+      if (v != WV_EVENTS && !std::binary_search(vars->begin(), vars->end(), std::string(whVarNames[v])))
+	rh.grid->disable(v);
+  }
 
-	  if (!fail && (met_ > 150.) && (met_ <= 175.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met150,evtweight1l,"sig_bbmasslast_nomt_met150");
-	  }
+  rh.dilep = (dir.find("cr3_") != std::string::npos) || (dir.find("cr4_") != std::string::npos);
+  rh.inc = dir.find("inc_") != std::string::npos;
+  rh.cr2 = dir.find("cr2") != std::string::npos;
+  rh.cr7 = dir.find("cr7") != std::string::npos;
+}
 
-	  if (!fail && (met_ > 162.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met162,evtweight1l,"sig_bbmasslast_nomt_met162");
-	  }
+//--------------------------------------------------------------------
 
-	  if (!fail && (met_ > 175.) ) {
-	    fillHists1DWrapper(h_1d_sig_bbmasslast_nomt_met175,evtweight1l,"sig_bbmasslast_nomt_met175");
-	  }
-	}
+void WHLooper::fillHists1D(const RegionHists& rh, int cell, const float evtweight) {
 
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_bbmasslast_met_nm1,evtweight1l,"sig_bbmasslast_met_nm1");
-	}
-	else fail = true;
+  HistoGrid& h = *rh.grid;
 
-	if (!fail && (met_ > 100.) ) {
-	  fillHists1DWrapper(h_1d_sig_bbmasslast_met100,evtweight1l,"sig_bbmasslast_met100");
-	}
-	else fail = true;
+  TVector2 lep(stopt.lep1().px(),stopt.lep1().py());
+  TVector2 met;
+  met.SetMagPhi(met_, metphi_);
+  TVector2 trkmet;
+  met.SetMagPhi(stopt.trkmet(), stopt.trkmetphi());
+  TVector2 w = lep+met; 
+  TVector2 trkmet_nolep = trkmet + lep;
 
-	if (!fail && (met_ > 125.) ) {
-	  fillHists1DWrapper(h_1d_sig_bbmasslast_met125,evtweight1l,"sig_bbmasslast_met125");
-	}
-	else fail = true;
+  h.fill(WV_NJETS, cell,        njets_,           evtweight, 10, 0., 10.);
+  h.fill(WV_NJETSFWD, cell,     njetsfwd_,        evtweight, 10, 0., 10.);
+  h.fill(WV_NJETS20, cell,      njets20_,         evtweight, 10, 0., 10.);
+  h.fill(WV_NJETSALL, cell,     njetsall_,        evtweight, 10, 0., 10.);
+  h.fill(WV_NBJETS, cell,       nbjets_,    evtweight, 5, 0., 5.);
+  h.fill(WV_NBJETSL, cell,      nbjetsl_,   evtweight, 5, 0., 5.);
 
-	if (!fail && (met_ > 150.) ) {
-	  fillHists1DWrapper(h_1d_sig_bbmasslast_met150,evtweight1l,"sig_bbmasslast_met150");
-	}
-	else fail = true;
+  if (met_ > 100.) {
+    h.fill(WV_PFMETCALOMETDPHI_MET100, cell,getdphi(stopt.t1metphicorrphi(), stopt.calometphi()),  evtweight, 50, 0., TMath::Pi());
+  }
+  if (met_ > 150.) {
+    h.fill(WV_PFMETCALOMETDPHI_MET150, cell,getdphi(stopt.t1metphicorrphi(), stopt.calometphi()),  evtweight, 50, 0., TMath::Pi());
+  }
+  if (met_ > 175.) {
+    h.fill(WV_PFMETCALOMETDPHI_MET175, cell,getdphi(stopt.t1metphicorrphi(), stopt.calometphi()),  evtweight, 50, 0., TMath::Pi());
+  }
 
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_sig_bbmasslast_bbmass_nm1,evtweight1l,"sig_bbmasslast_bbmass_nm1");
-	}
-	else fail = true;
+  // phi cor met validation
+  // h.fill(WV_METDIFF, cell,        met_ - stopt.pfmet(),    evtweight, 500, -250., 250.);
+  // h.fill(WV_METPHIDIFF, cell,  fabs(TVector2::Phi_mpi_pi(metphi_ - stopt.pfmetphi())),    evtweight,  50, 0., TMath::Pi());
 
-	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  fillHists1DWrapper(h_1d_sig_bbmasslast_final,evtweight1l,"sig_bbmasslast_final");
-	}
+  h.fill(WV_BBMASS, cell,       bb_.M(),       evtweight, 1000, 0., 1000.);
+  h.fill(WV_BBPT, cell,       bb_.pt(),       evtweight, 500, 0., 500.);
+  // h.fill(WV_BBLEP1DR, cell,  ROOT::Math::VectorUtil::DeltaR( bb_ , stopt.lep1() ), evtweight, 100, 0., 2.*TMath::Pi());
+  // h.fill(WV_BBLEP1DPHI, cell,  fabs(TVector2::Phi_mpi_pi(bb_.phi() - stopt.lep1().phi())), evtweight, 50, 0., TMath::Pi());
 
-      } // signal region sel (bbmass last)
+  //  h.fill(WV_BBWDPHI, cell,  fabs(TVector2::Phi_mpi_pi(bb_.phi() - w.Phi())), evtweight, 50, 0., TMath::Pi());
+  h.fill(WV_BBWDPHI, cell,  bbwdphi_, evtweight, 50, 0., TMath::Pi());
+  // h.fill(WV_BBWDPT, cell,   bb_.pt() - w.Mod(),       evtweight, 500, -250., 250.);
 
-      // -------------------------------------------
-      // *** signal region, but applying met cut last
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 2 bjets
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      if ( doSignalMETLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) 
-	   && (!isData || !blindSignal) ) {
-
-        fillHists1DWrapper(h_1d_sig_metlast_presel,evtweight1l,"sig_metlast_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_mt2bl_nm1,evtweight1l,"sig_metlast_mt2bl_nm1");
-	  if (doNM1Plots) fillHists2D(h_2d_sig_metlast_mt2bl_nm1,evtweight1l,"sig_metlast_mt2bl_nm1");
-	}
-	else fail = true;
+  // jet smearing corrs
+  for (unsigned int i=0; i < jets_smearcorrs_.size(); ++i) {
+    h.fill(WV_JETSMEARCORRS, cell,   jets_smearcorrs_.at(i),  evtweight, 100, 0., 2.);
+  }
 
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_mtfirst,evtweight1l,"sig_metlast_mtfirst");
-	}
+  if (isWjets_ && (stopt.nbs() == 2)) {
+    h.fill(WV_GENB1PT, cell,       stopt.genbs().at(0).pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_GENB2PT, cell,       stopt.genbs().at(1).pt(),       evtweight, 1000, 0., 1000.);
+  }
 
-	if (doMetBinRegions) {
-
-	  if (!fail && (met_ > 100.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_nomt_met100,evtweight1l,"sig_metlast_nomt_met100");
-	  }
-
-	  if (!fail && (met_ > 150.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_nomt_met150,evtweight1l,"sig_metlast_nomt_met150");
-	  }
-
-	  if (!fail && (met_ > 175.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_nomt_met175,evtweight1l,"sig_metlast_nomt_met175");
-	  }
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_mt_nm1,evtweight1l,"sig_metlast_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_met_nm1,evtweight1l,"sig_metlast_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_met100,evtweight1l,"sig_metlast_met100");
-	}
-	else fail = true;
-
-	//	if (!fail) dumpEventInfo("signal region event");
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_met125,evtweight1l,"sig_metlast_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_metlast_met150,evtweight1l,"sig_metlast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_sig_metlast_final,evtweight1l,"sig_metlast_final");
-	}
-	else fail = true;
-
-      } // signal region sel, met last
-
-      // -------------------------------------------
-      // *** signal region, 2 loose btags
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 2 loose bjets
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      if ( doSignal2Loose
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjetsl_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) 
-	   && (!isData || !blindSignal) ) {
-
-        fillHists1DWrapper(h_1d_sig_2loose_presel,evtweight1l,"sig_2loose_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_2loose_mt2bl_nm1,evtweight1l,"sig_2loose_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_2loose_mt_nm1,evtweight1l,"sig_2loose_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_2loose_met_nm1,evtweight1l,"sig_2loose_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_2loose_met100,evtweight1l,"sig_2loose_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_2loose_met150,evtweight1l,"sig_2loose_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_sig_2loose_final,evtweight1l,"sig_2loose_final");
-	}
-	else fail = true;
-
-      } // signal region sel, 2 loose btags
-
-      // -------------------------------------------
-      // *** signal region, 1 med btag
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 1 med btags
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      if ( doSignal1Med
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 1)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) 
-	   && (!isData || !blindSignal) ) {
-
-        fillHists1DWrapper(h_1d_sig_1med_presel,evtweight1l,"sig_1med_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med_mt2bl_nm1,evtweight1l,"sig_1med_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med_mt_nm1,evtweight1l,"sig_1med_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med_met_nm1,evtweight1l,"sig_1med_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med_met100,evtweight1l,"sig_1med_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med_met150,evtweight1l,"sig_1med_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_sig_1med_final,evtweight1l,"sig_1med_final");
-	}
-	else fail = true;
-
-      } // signal region sel, 1 med btag
-
-      // -------------------------------------------
-      // *** signal region, 1 med 1 loose btag
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 1 med btags
-      //   >= 2 loose btags
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      if ( doSignal1Med1Loose
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 1)
-	   && (nbjetsl_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) 
-	   && (!isData || !blindSignal) ) {
-
-        fillHists1DWrapper(h_1d_sig_1med1loose_presel,evtweight1l,"sig_1med1loose_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med1loose_mt2bl_nm1,evtweight1l,"sig_1med1loose_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med1loose_mt_nm1,evtweight1l,"sig_1med1loose_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med1loose_met_nm1,evtweight1l,"sig_1med1loose_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med1loose_met100,evtweight1l,"sig_1med1loose_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_1med1loose_met150,evtweight1l,"sig_1med1loose_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_sig_1med1loose_final,evtweight1l,"sig_1med1loose_final");
-	}
-	else fail = true;
-
-      } // signal region sel, 1 med 1loose btag
-
-      // -------------------------------------------
-      // *** signal region with SMWH cuts:
-      //   == 1 lepton, iso track veto
-      //   == 2 jets, all eta
-      //   == 2 bjets
-      //   100 < m(bb) < 150
-      //   met > 45
-      //   mt > 100
-      //   mt2bl > 200
-
-      if ( doSignalSMWH
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (nbjetst_ >= 1)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > 45.) 
-	   && (!isData || !blindSignal) ) {
-
-        fillHists1DWrapper(h_1d_sigsmwh_presel,evtweight1l,"sigsmwh_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  //	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_met_nm1,evtweight1l,"sig_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (bb_.pt() > 100.) ) {
-	  //	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mt_nm1,evtweight1l,"sig_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (bbwdphi_ > 2.95) ) {
-	  //	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mt_nm1,evtweight1l,"sig_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (wpt_ > 180.) ) {
-	  //	  if (doNM1Plots) fillHists1DWrapper(h_1d_sig_mt_nm1,evtweight1l,"sig_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (lepmetdphi_ < TMath::Pi()/2.) ) {
-	  fillHists1DWrapper(h_1d_sigsmwh_final,evtweight1l,"sigsmwh_final");
-	}
-
-      } // signal region sel
-
-      // -------------------------------------------
-      // *** CR1: 150 < m(bb) < 250 
-      //  otherwise same as signal region
-
-      if ( doCR1
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr1_presel,evtweight1l,"cr1_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_met_nm1,evtweight1l,"cr1_met_nm1");
-	}
-	else fail = true;
-
-	//	if (!fail && isData && (met_ > 420.)) dumpEventInfo("CR1 high MET event");
-
-	// mt peak before cutting on met
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_mtpeak_nomet,evtweight1l,"cr1_mtpeak_nomet");
-	}
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_mt_nm1,evtweight1l,"cr1_mt_nm1");
-	}
-	else fail = true;
-
-	// mt peak after cutting on met
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_mtpeak_met,evtweight1l,"cr1_mtpeak_met");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_mtlast_mt2bl_nm1,evtweight1l,"cr1_mtlast_mt2bl_nm1");
-	}
-	// else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_mt2bl_nm1,evtweight1l,"cr1_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr1_final,evtweight1l,"cr1_final");
-	}
-
-      } // CR1 region sel
-
-
-      // -------------------------------------------
-      // *** CR1, MET last: 150 < m(bb) < 250 
-      //  otherwise same as signal region
-
-      if ( doCR1METLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr1_metlast_presel,evtweight1l,"cr1_metlast_presel");
-
-	if (isData && (stopt.ngoodlep() >= 2)) dumpEventInfo("CR1 2lep event");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_metlast_mt2bl_nm1,evtweight1l,"cr1_metlast_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr1_metlast_mtfirst,evtweight1l,"cr1_metlast_mtfirst");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_metlast_mt_nm1,evtweight1l,"cr1_metlast_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr1_metlast_met_nm1,evtweight1l,"cr1_metlast_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_metlast_met100,evtweight1l,"cr1_metlast_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_metlast_met125,evtweight1l,"cr1_metlast_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_metlast_met150,evtweight1l,"cr1_metlast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr1_metlast_final,evtweight1l,"cr1_metlast_final");
-	}
-	else fail = true;
-
-      } // CR1 region sel
-
-
-      // -------------------------------------------
-      // *** CR2: 1 lepton + iso track, i.e. inverted iso track (or tau) veto, require exactly 1 lep
-      //   otherwise same as signal region
-
-      if ( doCR2
-	   && passLepPlusIsoTrkSelectionWHMet(isData)
-	   // && ( (passSingleLeptonSelection(isData) && !passisotrk)
-	   // // && passLepPlusIsoTrkSelection(isData) 
-	   // 	|| passLepPlusTauSelection(isData) )
-	   //	   && (stopt.ngoodlep() == 1) 
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr2_presel,evtweight1l,"cr2_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr2_bbmass_nm1,evtweight1l,"cr2_bbmass_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr2_mt_nm1,evtweight1l,"cr2_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr2_mt2blfirst,evtweight1l,"cr2_mt2blfirst");
-	}
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr2_met_nm1,evtweight1l,"cr2_met_nm1");
-	}
-	else fail = true;
-
-	//	if (!fail && isData && (met_ > 250. || mt2bl_ > 250.)) dumpEventInfo("CR2, high MET/MT2bl event");
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr2_mt2blcut,evtweight1l,"cr2_mt2blcut");
-	}
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr2_mt2bl_nm1,evtweight1l,"cr2_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr2_final,evtweight1l,"cr2_final");
-	}
-	else fail = true;
-
-      } // CR2 region sel
-
-
-      // -------------------------------------------
-      // *** CR3: 2 leptons, Z mass veto for same flavor, no iso track veto
-      //   otherwise same as signal region
-      //   !!! pesudo MET/MT etc defs to emulate losing 2nd lepton
-
-      if ( doCR3
-	   && passDileptonSelection(isData) 
-	   //	   && (abs(stopt.id1()) != abs(stopt.id2()) || fabs( stopt.dilmass() - 91.) > 15. )
-	   && (nbjets_ >= 2) ) {
-	//	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-
-	// tight 3rd track veto used by stop people -- necessary?
-	//	      if ( (stopt.trkpt10loose() <0.0001 || stopt.trkreliso10loose() > 0.1) 
-
-	//calculate pseudo met and mt
-	//find positive lepton - this is the one that is combined with the pseudomet to form the mT
-	bool isfirstp = (stopt.id1() > 0) ? true : false;
-	lep_ = isfirstp ? stopt.lep1() : stopt.lep2();
-		
-	//recalculate met
-	float metx = met_ * cos( metphi_ );
-	float mety = met_ * sin( metphi_ );
-		
-	//recalculate the MET with the positive lepton
-	metx += isfirstp ? stopt.lep1().px() : stopt.lep2().px();
-	mety += isfirstp ? stopt.lep1().py() : stopt.lep2().py();
-		
-	pseudomet_lep_    = sqrt(metx*metx + mety*mety);
-	pseudometphi_lep_ = atan2( mety , metx );
-		
-	//recalculate the MT with the negative lepton
-	pseudomt_lep_ = getMT( lep_.pt() , lep_.phi() , pseudomet_lep_ , pseudometphi_lep_ );
-	//dphi between met and lepton
-	dphi_pseudomet_lep_ = TVector2::Phi_mpi_pi( lep_.phi() - pseudometphi_lep_ );
-
-	// recalculate mt2 vars also..
-	pseudomt2b_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2b);
-	pseudomt2bl_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2bl);
-	pseudomt2w_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2w);
-
-
-	bool fail = false;
-	//	if ( pseudomet_lep_ > CUT_MET_PRESEL_ ) {
-	if ( met_ > CUT_MET_PRESEL_ ) {
-          fillHists1DWrapper(h_1d_cr3_presel,evtweight2l,"cr3_presel");
-	}
-	else fail = true;
-
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr3_bbmass_nm1,evtweight2l,"cr3_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail &&  (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr3_mt_nm1,evtweight2l,"cr3_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr3_mt2blfirst,evtweight1l,"cr3_mt2blfirst");
-	}
-
-	//	if (!fail && (pseudomt_lep_ > CUT_MT_) ) {
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr3_met_nm1,evtweight2l,"cr3_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr3_mt2blcut,evtweight2l,"cr3_mt2blcut");
-	}
-
-	//	if (!fail && (pseudomet_lep_ > CUT_MET_) ) {
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr3_mt2bl_nm1,evtweight2l,"cr3_mt2bl_nm1");
-	}
-	else fail = true;
-
-	//	if (!fail && isData && met_ > 270.) dumpEventInfo("CR3, high MET event");
-
-	//	if (!fail && (pseudomt2bl_ > CUT_MT2BL_) ) {
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr3_final,evtweight2l,"cr3_final");
-	}
-	else fail = true;
-
-      } // CR3 region sel
-
-
-      // -------------------------------------------
-      // *** CR23: 1 lepton + iso track OR 2 lepton
-      //   otherwise same as signal region
-
-      if ( doCR23
-	   && ( passLepPlusIsoTrkSelectionWHMet(isData)
-	   //	   && ( ( passSingleLeptonSelection(isData) && !passisotrk && (stopt.ngoodlep() == 1) ) 
-	   // && passLepPlusIsoTrkSelection(isData) 
-		//		|| ( passLepPlusTauSelection(isData) && (stopt.ngoodlep() == 1) )
-		|| ( passDileptonSelection(isData) ) )
-		     //&& (abs(stopt.id1()) != abs(stopt.id2()) || fabs( stopt.dilmass() - 91.) > 15. ) ) )
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr23_presel,evtweight1l,"cr23_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmass_nm1,evtweight1l,"cr23_bbmass_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_mt_nm1,evtweight1l,"cr23_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_mt2blfirst,evtweight1l,"cr23_mt2blfirst");
-	}
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_mt2bl_nm1,evtweight1l,"cr23_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_metcut,evtweight1l,"cr23_metcut");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr23_met_nm1,evtweight1l,"cr23_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_met100,evtweight1l,"cr23_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_met125,evtweight1l,"cr23_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_met150,evtweight1l,"cr23_met150");
-	}
-	else fail = true;
-
-	//	if (!fail && isData && (met_ > 250. || mt2bl_ > 250.)) dumpEventInfo("CR23, high MET/MT2bl event");
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_final,evtweight1l,"cr23_final");
-	}
-	else fail = true;
-
-      } // CR23 region sel
-
-
-      // -------------------------------------------
-      // *** CR23, mass last: 1 lepton + iso track OR 2 lepton
-      //   otherwise same as signal region
-
-      if ( doCR23MassLast
-	   && ( passLepPlusIsoTrkSelectionWHMet(isData)
-		|| ( passDileptonSelection(isData) ) )
-	   && (nbjets_ >= 2)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr23_bbmasslast_presel,evtweight1l,"cr23_bbmasslast_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_mt_nm1,evtweight1l,"cr23_bbmasslast_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_mt2bl_nm1,evtweight1l,"cr23_bbmasslast_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr23_bbmasslast_met_nm1,evtweight1l,"cr23_bbmasslast_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_met100,evtweight1l,"cr23_bbmasslast_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_met125,evtweight1l,"cr23_bbmasslast_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_met150,evtweight1l,"cr23_bbmasslast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_bbmass_nm1,evtweight1l,"cr23_bbmasslast_bbmass_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr23_bbmasslast_final,evtweight1l,"cr23_bbmasslast_final");
-	}
-	else fail = true;
-
-      } // CR23 region sel
-
-
-      // -------------------------------------------
-      // *** CR4: 2 leptons, Z mass veto for same flavor, no iso track veto
-      //   high mass: 150 < m(bb) < 250
-      //   otherwise same as signal region
-      //   !!! modified MET/MT etc defs to emulate losing 2nd lepton
-
-      if ( doCR4
-	   && passDileptonSelection(isData) 
-	   && (abs(stopt.id1()) != abs(stopt.id2()) || fabs( stopt.dilmass() - 91.) > 15. )
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) ) {
-
-	// tight 3rd track veto used by stop people -- necessary?
-	//	      if ( (stopt.trkpt10loose() <0.0001 || stopt.trkreliso10loose() > 0.1) 
-
-	//calculate pseudo met and mt
-	//find positive lepton - this is the one that is combined with the pseudomet to form the mT
-	bool isfirstp = (stopt.id1() > 0) ? true : false;
-	lep_ = isfirstp ? stopt.lep1() : stopt.lep2();
-		
-	//recalculate met
-	float metx = met_ * cos( metphi_ );
-	float mety = met_ * sin( metphi_ );
-		
-	//recalculate the MET with the positive lepton
-	metx += isfirstp ? stopt.lep1().px() : stopt.lep2().px();
-	mety += isfirstp ? stopt.lep1().py() : stopt.lep2().py();
-		
-	pseudomet_lep_    = sqrt(metx*metx + mety*mety);
-	pseudometphi_lep_ = atan2( mety , metx );
-		
-	//recalculate the MT with the negative lepton
-	pseudomt_lep_ = getMT( lep_.pt() , lep_.phi() , pseudomet_lep_ , pseudometphi_lep_ );
-	//dphi between met and lepton
-	dphi_pseudomet_lep_ = TVector2::Phi_mpi_pi( lep_.phi() - pseudometphi_lep_ );
-
-	// recalculate mt2 vars also..
-	pseudomt2b_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2b);
-	pseudomt2bl_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2bl);
-	pseudomt2w_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2w);
-
-
-	bool fail = false;
-	//	if ( pseudomet_lep_ > CUT_MET_PRESEL_ ) {
-	if ( met_ > CUT_MET_PRESEL_ ) {
-          fillHists1DWrapper(h_1d_cr4_presel,evtweight2l,"cr4_presel");
-	}
-	else fail = true;
-
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr4_mt2bl_nm1,evtweight2l,"cr4_mt2bl_nm1");
-	}
-	else fail = true;
-
-	//	if (!fail && isData && met_ > 320.) dumpEventInfo("CR4, high MET event");
-
-	//	if (!fail && (pseudomt2bl_ > CUT_MT2BL_) ) {
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr4_met_nm1,evtweight2l,"cr4_met_nm1");
-	}
-	else fail = true;
-
-	//	if (!fail && (pseudomet_lep_ > CUT_MET_) ) {
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr4_mt_nm1,evtweight2l,"cr4_mt_nm1");
-	}
-	else fail = true;
-
-	//	if (!fail && (pseudomt_lep_ > CUT_MT_) ) {
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr4_final,evtweight2l,"cr4_final");
-	}
-	else fail = true;
-
-      } // CR4 region sel
-
-
-      // -------------------------------------------
-      // *** CR5: require exactly 0 btags
-      //  otherwise same as signal
-
-      if ( doCR5
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr5_presel,evtweight1l,"cr5_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmass_nm1,evtweight1l,"cr5_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail && ((bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_met_nm1,evtweight1l,"cr5_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_met100,evtweight1l,"cr5_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_mt_nm1,evtweight1l,"cr5_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_mt2bl_nm1,evtweight1l,"cr5_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr5_final,evtweight1l,"cr5_final");
-	}
-
-      } // CR5 region sel
-
-      // -------------------------------------------
-      // *** CR5 loose: require exactly 0 btags
-      //  no jet veto, no MT2bl, then MET > 500
-
-      if ( doCR5Loose
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr5_loose_presel,evtweight1l,"cr5_loose_presel");
-
-	bool fail = false;
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_loose_met_nm1,evtweight1l,"cr5_loose_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 500.) ) {
-	  fillHists1DWrapper(h_1d_cr5_loose_final,evtweight1l,"cr5_loose_final");
-	}
-
-      } // CR5 loose region sel
-
-      // -------------------------------------------
-      // *** CR5, met last: require exactly 0 btags
-      //  otherwise same as signal
-
-      if ( doCR5METLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr5_metlast_presel,evtweight1l,"cr5_metlast_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_bbmass_nm1,evtweight1l,"cr5_metlast_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail && ((bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_mt2bl_nm1,evtweight1l,"cr5_metlast_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_mtfirst,evtweight1l,"cr5_metlast_mtfirst");
-	}
-
-	if (doMetBinRegions) {
-	  if (!fail && (met_ > 100.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_nomt_met100,evtweight1l,"cr5_metlast_nomt_met100");
-	  }
-
-	  if (!fail && (met_ > 150.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_nomt_met150,evtweight1l,"cr5_metlast_nomt_met150");
-	  }
-
-	  if (!fail && (met_ > 175.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_nomt_met175,evtweight1l,"cr5_metlast_nomt_met175");
-	  }
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_mt_nm1,evtweight1l,"cr5_metlast_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_met_nm1,evtweight1l,"cr5_metlast_met_nm1");
-	}
-	else fail = true;
-
-	//	if (isData && !fail && (met_ > 500.)) dumpEventInfo("cr5 high met event");
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_met100,evtweight1l,"cr5_metlast_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_met125,evtweight1l,"cr5_metlast_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_metlast_met150,evtweight1l,"cr5_metlast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr5_metlast_final,evtweight1l,"cr5_metlast_final");
-	}
-
-      } // CR5 region sel
-
-      // -------------------------------------------
-      // *** CR5, inverted mass: require exactly 0 btags
-      //  otherwise same as signal
-
-      if ( doCR5InvMass
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr5_invmass_presel,evtweight1l,"cr5_invmass_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_bbmass_nm1,evtweight1l,"cr5_invmass_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail && ((bb_.M() < CUT_BBMASS_LOW_) || (bb_.M() > CUT_BBMASS_HIGH_)) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_mt2bl_nm1,evtweight1l,"cr5_invmass_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_mtfirst,evtweight1l,"cr5_invmass_mtfirst");
-	}
-
-	if (doMetBinRegions) {
-	  if (!fail && (met_ > 100.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_nomt_met100,evtweight1l,"cr5_invmass_nomt_met100");
-	  }
-
-	  if (!fail && (met_ > 150.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_nomt_met150,evtweight1l,"cr5_invmass_nomt_met150");
-	  }
-
-	  if (!fail && (met_ > 175.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_nomt_met175,evtweight1l,"cr5_invmass_nomt_met175");
-	  }
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_mt_nm1,evtweight1l,"cr5_invmass_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_met_nm1,evtweight1l,"cr5_invmass_met_nm1");
-	}
-	else fail = true;
-
-	//	if (isData && !fail && (met_ > 500.)) dumpEventInfo("cr5 high met event");
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_met100,evtweight1l,"cr5_invmass_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_met125,evtweight1l,"cr5_invmass_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_invmass_met150,evtweight1l,"cr5_invmass_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr5_invmass_final,evtweight1l,"cr5_invmass_final");
-	}
-
-      } // CR5 region sel
-
-      // -------------------------------------------
-      // *** CR5, high mass, met last: require exactly 0 btags
-      //  otherwise same as signal
-
-      if ( doCR5HighMass
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr5_highmass_presel,evtweight1l,"cr5_highmass_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_mt2bl_nm1,evtweight1l,"cr5_highmass_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_mtfirst,evtweight1l,"cr5_highmass_mtfirst");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_mt_nm1,evtweight1l,"cr5_highmass_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_met_nm1,evtweight1l,"cr5_highmass_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_met100,evtweight1l,"cr5_highmass_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_met125,evtweight1l,"cr5_highmass_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_highmass_met150,evtweight1l,"cr5_highmass_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr5_highmass_final,evtweight1l,"cr5_highmass_final");
-	}
-
-      } // CR5 region sel
-
-
-      // -------------------------------------------
-      // *** CR5, low mass, met last: require exactly 0 btags
-      //  otherwise same as signal
-
-      if ( doCR5LowMass
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr5_lowmass_presel,evtweight1l,"cr5_lowmass_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_mt2bl_nm1,evtweight1l,"cr5_lowmass_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_mtfirst,evtweight1l,"cr5_lowmass_mtfirst");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_mt_nm1,evtweight1l,"cr5_lowmass_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_met_nm1,evtweight1l,"cr5_lowmass_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_met100,evtweight1l,"cr5_lowmass_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_met125,evtweight1l,"cr5_lowmass_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_lowmass_met150,evtweight1l,"cr5_lowmass_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr5_lowmass_final,evtweight1l,"cr5_lowmass_final");
-	}
-
-      } // CR5 region sel
-
-      // -------------------------------------------
-      // *** CR5 (bveto), but applying m(bb) cut last
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   == 0 bjets
-      //   met > 50
-
-      if ( doCR5MassLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-	bool fail = false;
-        if (!fail) fillHists1DWrapper(h_1d_cr5_bbmasslast_presel,evtweight1l,"cr5_bbmasslast_presel");
-
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_mt2bl_nm1,evtweight1l,"cr5_bbmasslast_mt2bl_nm1");
-	}
-	else fail = true;
-
-	// mt peak before cutting on met/mt/mt2bl
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_mtpeak,evtweight1l,"cr5_bbmasslast_mtpeak");
-	}
-
-	// plots for bbmass after each of the major cuts done separately
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_mtcut,evtweight1l,"cr5_bbmasslast_mtcut");
-	  if (!fail && (met_ > 100.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_mtcut_met100,evtweight1l,"cr5_bbmasslast_mtcut_met100");
-	  }
-	}
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_metcut,evtweight1l,"cr5_bbmasslast_metcut");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_mt_nm1,evtweight1l,"cr5_bbmasslast_mt_nm1");
-	}
-	else fail = true;
-
-	if (doMetBinRegions) {
-
-	  if (!fail && (met_ > 50.) && (met_ <= 75.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met50,evtweight1l,"cr5_bbmasslast_nomt_met50");
-	  }
-
-	  if (!fail && (met_ > 75.) && (met_ <= 100.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met75,evtweight1l,"cr5_bbmasslast_nomt_met75");
-	  }
-
-	  if (!fail && (met_ > 100.) && (met_ <= 125.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met100,evtweight1l,"cr5_bbmasslast_nomt_met100");
-	  }
-
-	  if (!fail && (met_ > 125.) && (met_ <= 150.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met125,evtweight1l,"cr5_bbmasslast_nomt_met125");
-	  }
-
-	  if (!fail && (met_ > 137.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met137,evtweight1l,"cr5_bbmasslast_nomt_met137");
-	  }
-
-	  if (!fail && (met_ > 150.) && (met_ <= 175.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met150,evtweight1l,"cr5_bbmasslast_nomt_met150");
-	  }
-
-	  if (!fail && (met_ > 162.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met162,evtweight1l,"cr5_bbmasslast_nomt_met162");
-	  }
-
-	  if (!fail && (met_ > 175.) ) {
-	    fillHists1DWrapper(h_1d_cr5_bbmasslast_nomt_met175,evtweight1l,"cr5_bbmasslast_nomt_met175");
-	  }
-	}
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr5_bbmasslast_met_nm1,evtweight1l,"cr5_bbmasslast_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  fillHists1DWrapper(h_1d_cr5_bbmasslast_met100,evtweight1l,"cr5_bbmasslast_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  fillHists1DWrapper(h_1d_cr5_bbmasslast_met125,evtweight1l,"cr5_bbmasslast_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  fillHists1DWrapper(h_1d_cr5_bbmasslast_met150,evtweight1l,"cr5_bbmasslast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 500.) ) {
-	  fillHists1DWrapper(h_1d_cr5_bbmasslast_met500,evtweight1l,"cr5_bbmasslast_met500");
-	}
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr5_bbmasslast_bbmass_nm1,evtweight1l,"cr5_bbmasslast_bbmass_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  fillHists1DWrapper(h_1d_cr5_bbmasslast_final,evtweight1l,"cr5_bbmasslast_final");
-	}
-
-      } // CR5 sel (bbmass last)
-
-      // -------------------------------------------
-      // *** CR6: require exactly 1 btag
-      //  veto on 2nd loose btag
-      //  otherwise same as signal
-
-      if ( doCR6
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 1)
-	   && (nbjetsl_ == 1)
-	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) ) {
-
-	// compute MT2 vars for 1 b events passing this presel
-	mt2b_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2b);
-	mt2bl_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2bl);
-	mt2w_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2w);
-
-        fillHists1DWrapper(h_1d_cr6_presel,evtweight1l,"cr6_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_met_nm1,evtweight1l,"cr6_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_mt_nm1,evtweight1l,"cr6_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_mt2bl_nm1,evtweight1l,"cr6_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr6_final,evtweight1l,"cr6_final");
-	}
-
-      } // CR6 region sel
-
-
-      // -------------------------------------------
-      // *** CR6, met last: require exactly 1 btag
-      //  veto on 2nd loose btag
-      //  otherwise same as signal
-
-      if ( doCR6METLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 1)
-	   && (nbjetsl_ == 1)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr6_metlast_presel,evtweight1l,"cr6_metlast_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_metlast_bbmass_nm1,evtweight1l,"cr6_metlast_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail && ((bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_metlast_mt2bl_nm1,evtweight1l,"cr6_metlast_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_metlast_mt_nm1,evtweight1l,"cr6_metlast_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_metlast_met_nm1,evtweight1l,"cr6_metlast_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_metlast_met100,evtweight1l,"cr6_metlast_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr6_metlast_met150,evtweight1l,"cr6_metlast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr6_metlast_final,evtweight1l,"cr6_metlast_final");
-	}
-
-      } // CR6 region sel
-
-
-      // -------------------------------------------
-      // *** CR7: 150 < m(bb) < 250, exactly 3 jets
-      //  otherwise same as signal region
-
-      if ( doCR7
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr7_presel,evtweight1l,"cr7_presel");
-
-	bool fail = false;
-	//	if ( !fail && (njetsall_ == 3) && (nbjets_ == 2) ) {
-	if ( !fail && (njetsall_ == 3) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr7_met_nm1,evtweight1l,"cr7_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr7_mt_nm1,evtweight1l,"cr7_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr7_mt2bl_nm1,evtweight1l,"cr7_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr7_final,evtweight1l,"cr7_final");
-	}
-
-      } // CR7 region sel
-
-
-      // -------------------------------------------
-      // *** CR8: 50 < m(bb) < 100 
-      //  otherwise same as signal region
-
-      if ( doCR8
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_CR8_LOW_) && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr8_presel,evtweight1l,"cr8_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_met_nm1,evtweight1l,"cr8_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_mt_nm1,evtweight1l,"cr8_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_mt2bl_nm1,evtweight1l,"cr8_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr8_final,evtweight1l,"cr8_final");
-	}
-
-      } // CR8 region sel
-
-
-      // -------------------------------------------
-      // *** CR8, MET last: 50 < m(bb) < 100 
-      //  otherwise same as signal region
-
-      if ( doCR8METLast
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_CR8_LOW_) && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
-	   && (bb_.M() < CUT_BBMASS_CR8_HIGH_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr8_metlast_presel,evtweight1l,"cr8_metlast_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_metlast_mt2bl_nm1,evtweight1l,"cr8_metlast_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr8_metlast_mtfirst,evtweight1l,"cr8_metlast_mtfirst");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_metlast_mt_nm1,evtweight1l,"cr8_metlast_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr8_metlast_met_nm1,evtweight1l,"cr8_metlast_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_metlast_met100,evtweight1l,"cr8_metlast_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_metlast_met125,evtweight1l,"cr8_metlast_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_metlast_met150,evtweight1l,"cr8_metlast_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr8_metlast_final,evtweight1l,"cr8_metlast_final");
-	}
-	else fail = true;
-
-      } // CR8 region sel
-
-
-      // -------------------------------------------
-      // *** CR idea: signal mass window, at least 3 jets, then exactly 3 jets
-      //  otherwise same as signal region
-      //  !! need to check to make sure signal contribution isn't too large..
-      //  -- after final selection, bg ~3, sig ~2 => don't use this region!
-
-
-      // -------------------------------------------
-      // *** CR9: 150 < m(bb) < 200 
-      //  otherwise same as signal region
-      //  to study met shape disagreement in CR1
-
-      if ( doCR9
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < 200.) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr9_presel,evtweight1l,"cr9_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr9_met_nm1,evtweight1l,"cr9_met_nm1");
-	}
-	else fail = true;
-
-	// mt peak before cutting on met
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr9_mtpeak_nomet,evtweight1l,"cr9_mtpeak_nomet");
-	}
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr9_mt_nm1,evtweight1l,"cr9_mt_nm1");
-	}
-	else fail = true;
-
-	// mt peak after cutting on met
-	if (!fail && (mt_ > 50.) && (mt_ < 80.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr9_mtpeak_met,evtweight1l,"cr9_mtpeak_met");
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr9_mtlast_mt2bl_nm1,evtweight1l,"cr9_mtlast_mt2bl_nm1");
-	}
-	// else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr9_mt2bl_nm1,evtweight1l,"cr9_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr9_final,evtweight1l,"cr9_final");
-	}
-
-      } // CR9 region sel
-
-
-      // -------------------------------------------
-      // *** CR10: 200 < m(bb) < 250 
-      //  otherwise same as signal region
-      //  to study met shape disagreement in CR1
-
-      if ( doCR10
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && (bb_.M() > 200.) && (bb_.M() < 250.) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr10_presel,evtweight1l,"cr10_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr10_met_nm1,evtweight1l,"cr10_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr10_mt_nm1,evtweight1l,"cr10_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr10_mt2bl_nm1,evtweight1l,"cr10_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr10_final,evtweight1l,"cr10_final");
-	}
-
-      } // CR10 region sel
-
-
-      // -------------------------------------------
-      // *** CR11: require exactly 0 btags, 150 < m(bb) < 250
-      //  otherwise same as signal
-
-      if ( doCR11
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ == 0)
-	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-	// compute MT2 vars for 0 b events passing this presel
-	mt2b_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2b);
-	mt2bl_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2bl);
-	mt2w_ = calculateMT2w(jets_, jets_csv_, stopt.lep1(), met_, metphi_, MT2w);
-
-        fillHists1DWrapper(h_1d_cr11_presel,evtweight1l,"cr11_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr11_met_nm1,evtweight1l,"cr11_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr11_mt_nm1,evtweight1l,"cr11_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr11_mt2bl_nm1,evtweight1l,"cr11_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr11_final,evtweight1l,"cr11_final");
-	}
-
-      } // CR11 region sel
-
-      // -------------------------------------------
-      // *** CR12: 150 < m(bb) < 250, at least 4 jets
-      //  otherwise same as signal region
-
-      if ( doCR12
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (njetsall_ >= 4)
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr12_presel,evtweight1l,"cr12_presel");
-
-	bool fail = false;
-	if ( !fail && (bb_.M() > CUT_BBMASS_CR1_LOW_) && (bb_.M() < CUT_BBMASS_CR1_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr12_met_nm1,evtweight1l,"cr12_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr12_mt_nm1,evtweight1l,"cr12_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr12_mt2bl_nm1,evtweight1l,"cr12_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  fillHists1DWrapper(h_1d_cr12_final,evtweight1l,"cr12_final");
-	}
-
-      } // CR12 region sel
-
-
-      // -------------------------------------------
-      // *** CR13: MT peak region
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 2 bjets
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      if ( doCR13
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_CR13_LOW_) && (mt_ <= CUT_MT_CR13_HIGH_) ) {
-
-        fillHists1DWrapper(h_1d_cr13_presel,evtweight1l,"cr13_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_bbmass_nm1,evtweight1l,"cr13_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_mt2bl_nm1,evtweight1l,"cr13_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_met_nm1,evtweight1l,"cr13_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_met100,evtweight1l,"cr13_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_met150,evtweight1l,"cr13_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr13_final,evtweight1l,"cr13_final");
-	}
-	else fail = true;
-
-      } // CR13 region sel
-
-
-      // -------------------------------------------
-      // *** CR13: MT peak region, inverted mbb
-      //  - presel:
-      //   == 1 lepton, iso track veto
-      //   >= 2 bjets
-      //   100 < m(bb) < 150
-      //   met > 50
-
-      if ( doCR13
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   //	   && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_)
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_CR13_LOW_) && (mt_ <= CUT_MT_CR13_HIGH_) ) {
-
-        fillHists1DWrapper(h_1d_cr13_presel,evtweight1l,"cr13_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_bbmass_nm1,evtweight1l,"cr13_bbmass_nm1");
-	}
-	else fail = true;
-
-	if ( !fail && (bb_.M() > CUT_BBMASS_LOW_) && (bb_.M() < CUT_BBMASS_HIGH_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_mt2bl_nm1,evtweight1l,"cr13_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_met_nm1,evtweight1l,"cr13_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_met100,evtweight1l,"cr13_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr13_met150,evtweight1l,"cr13_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  fillHists1DWrapper(h_1d_cr13_final,evtweight1l,"cr13_final");
-	}
-	else fail = true;
-
-      } // CR13 region sel
-
-
-      // -------------------------------------------
-      // *** CR14: inverted m(bb) cut
-      //  otherwise same as signal region
-
-      if ( doCR14
-	   && passSingleLeptonSelection(isData) 
-	   && passisotrk 
-	   && (nbjets_ >= 2)
-	   && ((bb_.M() < CUT_BBMASS_LOW_) || (bb_.M() > CUT_BBMASS_HIGH_)) 
-	   && (met_ > CUT_MET_PRESEL_) 
-	   && (mt_ > CUT_MT_PRESEL_) ) {
-
-        fillHists1DWrapper(h_1d_cr14_presel,evtweight1l,"cr14_presel");
-
-	bool fail = false;
-	if ( !fail && (njetsall_ == 2) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_mt2bl_nm1,evtweight1l,"cr14_mt2bl_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr14_mtfirst,evtweight1l,"cr14_mtfirst");
-	}
-
-	if (doMetBinRegions) {
-
-	  if (!fail && (met_ > 100.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_nomt_met100,evtweight1l,"cr14_nomt_met100");
-	  }
-
-	  if (!fail && (met_ > 150.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_nomt_met150,evtweight1l,"cr14_nomt_met150");
-	  }
-
-	  if (!fail && (met_ > 175.) ) {
-	    if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_nomt_met175,evtweight1l,"cr14_nomt_met175");
-	  }
-	}
-
-	if (!fail && (mt2bl_ > CUT_MT2BL_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_mt_nm1,evtweight1l,"cr14_mt_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (mt_ > CUT_MT_) ) {
-	  fillHists1DWrapper(h_1d_cr14_met_nm1,evtweight1l,"cr14_met_nm1");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 100.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_met100,evtweight1l,"cr14_met100");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 125.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_met125,evtweight1l,"cr14_met125");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > 150.) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_met150,evtweight1l,"cr14_met150");
-	}
-	else fail = true;
-
-	if (!fail && (met_ > CUT_MET_) ) {
-	  if (doNM1Plots) fillHists1DWrapper(h_1d_cr14_final,evtweight1l,"cr14_final");
-	}
-	else fail = true;
-
-      } // CR14 region sel
-
-
-      // -------------------------------------------
-      // *** Stop Presel region
-      //   >= 1 lepton
-      //   >= 4 jets
-      //   blind data (includes stop signal region)
-
-      // *** Stop Presel comparison region
-      //   >= 1 lepton
-      //   iso track veto v4
-      //   >= 4 jets
-      //   >= 1 bjet
-      //   met > 150
-      //   mt > 120
-      //   tau veto
-      //   blind data (includes stop signal region)
-
-      if ( doStopSel
-	   && passSingleLeptonSelection(isData) 
-	   && (njets_ >= 4)
-	   && !isData ) {
-
-	float weight = evtweight_novtxweight;
-	//	float weight = evtweight1l;
-
-        fillHists1DWrapper(h_1d_stop_presel,weight,"stop_presel");
-
-	bool fail = false;
-	if ( !fail && (nbjets_ >= 1) ) {
-	  fillHists1DWrapper(h_1d_stop_met_nm1,weight,"stop_met_nm1");
-	} 
-	else fail = true;
-
-	if ( !fail && (met_ >= 150.) ) {
-	  fillHists1DWrapper(h_1d_stop_mt_nm1,weight,"stop_mt_nm1");
-	} 
-	else fail = true;
-
-	if ( !fail && (mt_ > 120.) ) {
-	  fillHists1DWrapper(h_1d_stop_isotrk_nm1,weight,"stop_isotrk_nm1");
-	} 
-	else fail = true;
-
-	if ( !fail && passIsoTrkVeto_v4() ) {
-	  fillHists1DWrapper(h_1d_stop_tauveto_nm1,weight,"stop_tauveto_nm1");
-	} 
-	else fail = true;
-
-	if ( !fail && passTauVeto() ) {
-	  fillHists1DWrapper(h_1d_stop_comp,weight,"stop_comp");
-	} 
-	else fail = true;
-
-      } // stop region sel
-
-      // end regions ----------------------------------------
-      // ----------------------------------------------------
-
-      ++nEventsPass;
-
-    } // end event loop
-
-    // delete tree;
-    
-  } // end file loop
-  
-    //
-    // finish
-    //
-
-  if (doInclusive) {
-    savePlotsDir(h_1d_inc_presel,outfile_,"inc_presel");
-    savePlotsDir(h_1d_inc_2j,outfile_,"inc_2j");
-    if (doInclusiveMTTail) {
-      savePlotsDir(h_1d_inc_2j_mt,outfile_,"inc_2j_mt");
-      savePlotsDir(h_1d_inc_2j_mt_met100,outfile_,"inc_2j_mt_met100");
-      savePlotsDir(h_1d_inc_2j_mt_met150,outfile_,"inc_2j_mt_met150");
-      savePlotsDir(h_1d_inc_2j_mt_metcut,outfile_,"inc_2j_mt_metcut");
-    }
-    savePlotsDir(h_1d_inc_1b,outfile_,"inc_1b");
-    savePlotsDir(h_1d_inc_2b,outfile_,"inc_2b");
-  }
-
-  if (doSignal) {
-    savePlotsDir(h_1d_sig_presel,outfile_,"sig_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_sig_met_nm1,outfile_,"sig_met_nm1");
-      savePlotsDir(h_1d_sig_mtpeak_nomet,outfile_,"sig_mtpeak_nomet");
-      savePlotsDir(h_1d_sig_mt_nm1,outfile_,"sig_mt_nm1");
-      savePlotsDir(h_1d_sig_mtpeak_met,outfile_,"sig_mtpeak_met");
-      savePlotsDir(h_1d_sig_mt2bl_nm1,outfile_,"sig_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_sig_final,outfile_,"sig_final");
-  }
-
-  if (doSignalMassLast) {
-    savePlotsDir(h_1d_sig_bbmasslast_presel,outfile_,"sig_bbmasslast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_sig_bbmasslast_mt2bl_nm1,outfile_,"sig_bbmasslast_mt2bl_nm1");
-      savePlotsDir(h_1d_sig_bbmasslast_mtpeak,outfile_,"sig_bbmasslast_mtpeak");
-      savePlotsDir(h_1d_sig_bbmasslast_mtcut,outfile_,"sig_bbmasslast_mtcut");
-      savePlotsDir(h_1d_sig_bbmasslast_mtcut_met100,outfile_,"sig_bbmasslast_mtcut_met100");
-      savePlotsDir(h_1d_sig_bbmasslast_metcut,outfile_,"sig_bbmasslast_metcut");
-      savePlotsDir(h_1d_sig_bbmasslast_mt_nm1,outfile_,"sig_bbmasslast_mt_nm1");
-      if (doMetBinRegions) {
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met50,outfile_,"sig_bbmasslast_nomt_met50");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met75,outfile_,"sig_bbmasslast_nomt_met75");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met100,outfile_,"sig_bbmasslast_nomt_met100");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met125,outfile_,"sig_bbmasslast_nomt_met125");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met137,outfile_,"sig_bbmasslast_nomt_met137");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met150,outfile_,"sig_bbmasslast_nomt_met150");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met162,outfile_,"sig_bbmasslast_nomt_met162");
-	savePlotsDir(h_1d_sig_bbmasslast_nomt_met175,outfile_,"sig_bbmasslast_nomt_met175");
-      }
-      savePlotsDir(h_1d_sig_bbmasslast_met_nm1,outfile_,"sig_bbmasslast_met_nm1");
-      savePlotsDir(h_1d_sig_bbmasslast_met100,outfile_,"sig_bbmasslast_met100");
-      savePlotsDir(h_1d_sig_bbmasslast_met125,outfile_,"sig_bbmasslast_met125");
-      savePlotsDir(h_1d_sig_bbmasslast_met150,outfile_,"sig_bbmasslast_met150");
-      savePlotsDir(h_1d_sig_bbmasslast_bbmass_nm1,outfile_,"sig_bbmasslast_bbmass_nm1");
-    }
-    savePlotsDir(h_1d_sig_bbmasslast_final,outfile_,"sig_bbmasslast_final");
-  }
-
-  if (doSignalMETLast) {
-    savePlotsDir(h_1d_sig_metlast_presel,outfile_,"sig_metlast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_sig_metlast_mt2bl_nm1,outfile_,"sig_metlast_mt2bl_nm1");
-      savePlots2Dir(h_2d_sig_metlast_mt2bl_nm1,outfile_,"sig_metlast_mt2bl_nm1");
-      savePlotsDir(h_1d_sig_metlast_mtfirst,outfile_,"sig_metlast_mtfirst");
-      if (doMetBinRegions) {
-	savePlotsDir(h_1d_sig_metlast_nomt_met100,outfile_,"sig_metlast_nomt_met100");
-	savePlotsDir(h_1d_sig_metlast_nomt_met150,outfile_,"sig_metlast_nomt_met150");
-	savePlotsDir(h_1d_sig_metlast_nomt_met175,outfile_,"sig_metlast_nomt_met175");
-      }
-      savePlotsDir(h_1d_sig_metlast_mt_nm1,outfile_,"sig_metlast_mt_nm1");
-      savePlotsDir(h_1d_sig_metlast_met_nm1,outfile_,"sig_metlast_met_nm1");
-      savePlotsDir(h_1d_sig_metlast_met100,outfile_,"sig_metlast_met100");
-      savePlotsDir(h_1d_sig_metlast_met125,outfile_,"sig_metlast_met125");
-      savePlotsDir(h_1d_sig_metlast_met150,outfile_,"sig_metlast_met150");
-    }
-    savePlotsDir(h_1d_sig_metlast_final,outfile_,"sig_metlast_final");
-  }
-
-  if (doSignal2Loose) {
-    savePlotsDir(h_1d_sig_2loose_presel,outfile_,"sig_2loose_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_sig_2loose_mt2bl_nm1,outfile_,"sig_2loose_mt2bl_nm1");
-      savePlotsDir(h_1d_sig_2loose_mt_nm1,outfile_,"sig_2loose_mt_nm1");
-      savePlotsDir(h_1d_sig_2loose_met_nm1,outfile_,"sig_2loose_met_nm1");
-      savePlotsDir(h_1d_sig_2loose_met100,outfile_,"sig_2loose_met100");
-      savePlotsDir(h_1d_sig_2loose_met150,outfile_,"sig_2loose_met150");
-    }
-    savePlotsDir(h_1d_sig_2loose_final,outfile_,"sig_2loose_final");
-  }
-
-  if (doSignal1Med) {
-    savePlotsDir(h_1d_sig_1med_presel,outfile_,"sig_1med_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_sig_1med_mt2bl_nm1,outfile_,"sig_1med_mt2bl_nm1");
-      savePlotsDir(h_1d_sig_1med_mt_nm1,outfile_,"sig_1med_mt_nm1");
-      savePlotsDir(h_1d_sig_1med_met_nm1,outfile_,"sig_1med_met_nm1");
-      savePlotsDir(h_1d_sig_1med_met100,outfile_,"sig_1med_met100");
-      savePlotsDir(h_1d_sig_1med_met150,outfile_,"sig_1med_met150");
-    }
-    savePlotsDir(h_1d_sig_1med_final,outfile_,"sig_1med_final");
-  }
-
-  if (doSignal1Med1Loose) {
-    savePlotsDir(h_1d_sig_1med1loose_presel,outfile_,"sig_1med1loose_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_sig_1med1loose_mt2bl_nm1,outfile_,"sig_1med1loose_mt2bl_nm1");
-      savePlotsDir(h_1d_sig_1med1loose_mt_nm1,outfile_,"sig_1med1loose_mt_nm1");
-      savePlotsDir(h_1d_sig_1med1loose_met_nm1,outfile_,"sig_1med1loose_met_nm1");
-      savePlotsDir(h_1d_sig_1med1loose_met100,outfile_,"sig_1med1loose_met100");
-      savePlotsDir(h_1d_sig_1med1loose_met150,outfile_,"sig_1med1loose_met150");
-    }
-    savePlotsDir(h_1d_sig_1med1loose_final,outfile_,"sig_1med1loose_final");
-  }
-
-  if (doSignalSMWH) {
-    savePlotsDir(h_1d_sigsmwh_presel,outfile_,"sigsmwh_presel");
-    // if (doNM1Plots) {
-    //   savePlotsDir(h_1d_sig_met_nm1,outfile_,"sig_met_nm1");
-    //   savePlotsDir(h_1d_sig_mtpeak_nomet,outfile_,"sig_mtpeak_nomet");
-    //   savePlotsDir(h_1d_sig_mt_nm1,outfile_,"sig_mt_nm1");
-    //   savePlotsDir(h_1d_sig_mtpeak_met,outfile_,"sig_mtpeak_met");
-    //   savePlotsDir(h_1d_sig_mt2bl_nm1,outfile_,"sig_mt2bl_nm1");
-    // }
-    savePlotsDir(h_1d_sigsmwh_final,outfile_,"sigsmwh_final");
-  }
-
-  if (doCR1) {
-    savePlotsDir(h_1d_cr1_presel,outfile_,"cr1_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr1_met_nm1,outfile_,"cr1_met_nm1");
-      savePlotsDir(h_1d_cr1_mtpeak_nomet,outfile_,"cr1_mtpeak_nomet");
-      savePlotsDir(h_1d_cr1_mt_nm1,outfile_,"cr1_mt_nm1");
-      savePlotsDir(h_1d_cr1_mtpeak_met,outfile_,"cr1_mtpeak_met");
-      savePlotsDir(h_1d_cr1_mt2bl_nm1,outfile_,"cr1_mt2bl_nm1");
-      savePlotsDir(h_1d_cr1_mtlast_mt2bl_nm1,outfile_,"cr1_mtlast_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr1_final,outfile_,"cr1_final");
-  }
-
-  if (doCR1METLast) {
-    savePlotsDir(h_1d_cr1_metlast_presel,outfile_,"cr1_metlast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr1_metlast_mt2bl_nm1,outfile_,"cr1_metlast_mt2bl_nm1");
-      savePlotsDir(h_1d_cr1_metlast_mtfirst,outfile_,"cr1_metlast_mtfirst");
-      savePlotsDir(h_1d_cr1_metlast_mt_nm1,outfile_,"cr1_metlast_mt_nm1");
-      savePlotsDir(h_1d_cr1_metlast_met_nm1,outfile_,"cr1_metlast_met_nm1");
-      savePlotsDir(h_1d_cr1_metlast_met100,outfile_,"cr1_metlast_met100");
-      savePlotsDir(h_1d_cr1_metlast_met125,outfile_,"cr1_metlast_met125");
-      savePlotsDir(h_1d_cr1_metlast_met150,outfile_,"cr1_metlast_met150");
-    }
-    savePlotsDir(h_1d_cr1_metlast_final,outfile_,"cr1_metlast_final");
-  }
-
-  if (doCR2) {
-    savePlotsDir(h_1d_cr2_presel,outfile_,"cr2_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr2_bbmass_nm1,outfile_,"cr2_bbmass_nm1");
-      savePlotsDir(h_1d_cr2_mt_nm1,outfile_,"cr2_mt_nm1");
-      savePlotsDir(h_1d_cr2_mt2blfirst,outfile_,"cr2_mt2blfirst");
-      savePlotsDir(h_1d_cr2_met_nm1,outfile_,"cr2_met_nm1");
-      savePlotsDir(h_1d_cr2_mt2blcut,outfile_,"cr2_mt2blcut");
-      savePlotsDir(h_1d_cr2_mt2bl_nm1,outfile_,"cr2_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr2_final,outfile_,"cr2_final");
-  }
-
-  if (doCR3) {
-    savePlotsDir(h_1d_cr3_presel,outfile_,"cr3_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr3_bbmass_nm1,outfile_,"cr3_bbmass_nm1");
-      savePlotsDir(h_1d_cr3_mt_nm1,outfile_,"cr3_mt_nm1");
-      savePlotsDir(h_1d_cr3_mt2blfirst,outfile_,"cr3_mt2blfirst");
-      savePlotsDir(h_1d_cr3_met_nm1,outfile_,"cr3_met_nm1");
-      savePlotsDir(h_1d_cr3_mt2blcut,outfile_,"cr3_mt2blcut");
-      savePlotsDir(h_1d_cr3_mt2bl_nm1,outfile_,"cr3_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr3_final,outfile_,"cr3_final");
-  }
-
-  if (doCR23) {
-    savePlotsDir(h_1d_cr23_presel,outfile_,"cr23_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr23_bbmass_nm1,outfile_,"cr23_bbmass_nm1");
-      savePlotsDir(h_1d_cr23_mt_nm1,outfile_,"cr23_mt_nm1");
-      savePlotsDir(h_1d_cr23_mt2blfirst,outfile_,"cr23_mt2blfirst");
-      savePlotsDir(h_1d_cr23_mt2bl_nm1,outfile_,"cr23_mt2bl_nm1");
-      savePlotsDir(h_1d_cr23_metcut,outfile_,"cr23_metcut");
-      savePlotsDir(h_1d_cr23_met_nm1,outfile_,"cr23_met_nm1");
-      savePlotsDir(h_1d_cr23_met100,outfile_,"cr23_met100");
-      savePlotsDir(h_1d_cr23_met125,outfile_,"cr23_met125");
-      savePlotsDir(h_1d_cr23_met150,outfile_,"cr23_met150");
-    }
-    savePlotsDir(h_1d_cr23_final,outfile_,"cr23_final");
-  }
-
-  if (doCR23MassLast) {
-    savePlotsDir(h_1d_cr23_bbmasslast_presel,outfile_,"cr23_bbmasslast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr23_bbmasslast_mt_nm1,outfile_,"cr23_bbmasslast_mt_nm1");
-      savePlotsDir(h_1d_cr23_bbmasslast_mt2bl_nm1,outfile_,"cr23_bbmasslast_mt2bl_nm1");
-      savePlotsDir(h_1d_cr23_bbmasslast_met_nm1,outfile_,"cr23_bbmasslast_met_nm1");
-      savePlotsDir(h_1d_cr23_bbmasslast_met100,outfile_,"cr23_bbmasslast_met100");
-      savePlotsDir(h_1d_cr23_bbmasslast_met125,outfile_,"cr23_bbmasslast_met125");
-      savePlotsDir(h_1d_cr23_bbmasslast_met150,outfile_,"cr23_bbmasslast_met150");
-      savePlotsDir(h_1d_cr23_bbmasslast_bbmass_nm1,outfile_,"cr23_bbmasslast_bbmass_nm1");
-    }
-    savePlotsDir(h_1d_cr23_bbmasslast_final,outfile_,"cr23_bbmasslast_final");
-  }
-
-  if (doCR4) {
-    savePlotsDir(h_1d_cr4_presel,outfile_,"cr4_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr4_met_nm1,outfile_,"cr4_met_nm1");
-      savePlotsDir(h_1d_cr4_mt_nm1,outfile_,"cr4_mt_nm1");
-      savePlotsDir(h_1d_cr4_mt2bl_nm1,outfile_,"cr4_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr4_final,outfile_,"cr4_final");
-  }
-
-  if (doCR5) {
-    savePlotsDir(h_1d_cr5_presel,outfile_,"cr5_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_bbmass_nm1,outfile_,"cr5_bbmass_nm1");
-      savePlotsDir(h_1d_cr5_met_nm1,outfile_,"cr5_met_nm1");
-      savePlotsDir(h_1d_cr5_met100,outfile_,"cr5_met100");
-      savePlotsDir(h_1d_cr5_mt_nm1,outfile_,"cr5_mt_nm1");
-      savePlotsDir(h_1d_cr5_mt2bl_nm1,outfile_,"cr5_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr5_final,outfile_,"cr5_final");
-  }
-
-  if (doCR5Loose) {
-    savePlotsDir(h_1d_cr5_loose_presel,outfile_,"cr5_loose_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_loose_met_nm1,outfile_,"cr5_loose_met_nm1");
-    }
-    savePlotsDir(h_1d_cr5_loose_final,outfile_,"cr5_loose_final");
-  }
-
-  if (doCR5METLast) {
-    savePlotsDir(h_1d_cr5_metlast_presel,outfile_,"cr5_metlast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_metlast_mt2bl_nm1,outfile_,"cr5_metlast_mt2bl_nm1");
-      savePlotsDir(h_1d_cr5_metlast_mtfirst,outfile_,"cr5_metlast_mtfirst");
-      if (doMetBinRegions) {
-	savePlotsDir(h_1d_cr5_metlast_nomt_met100,outfile_,"cr5_metlast_nomt_met100");
-	savePlotsDir(h_1d_cr5_metlast_nomt_met150,outfile_,"cr5_metlast_nomt_met150");
-	savePlotsDir(h_1d_cr5_metlast_nomt_met175,outfile_,"cr5_metlast_nomt_met175");
-      }
-      savePlotsDir(h_1d_cr5_metlast_mt_nm1,outfile_,"cr5_metlast_mt_nm1");
-      savePlotsDir(h_1d_cr5_metlast_met_nm1,outfile_,"cr5_metlast_met_nm1");
-      savePlotsDir(h_1d_cr5_metlast_met100,outfile_,"cr5_metlast_met100");
-      savePlotsDir(h_1d_cr5_metlast_met125,outfile_,"cr5_metlast_met125");
-      savePlotsDir(h_1d_cr5_metlast_met150,outfile_,"cr5_metlast_met150");
-    }
-    savePlotsDir(h_1d_cr5_metlast_final,outfile_,"cr5_metlast_final");
-  }
-
-  if (doCR5InvMass) {
-    savePlotsDir(h_1d_cr5_invmass_presel,outfile_,"cr5_invmass_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_invmass_mt2bl_nm1,outfile_,"cr5_invmass_mt2bl_nm1");
-      savePlotsDir(h_1d_cr5_invmass_mtfirst,outfile_,"cr5_invmass_mtfirst");
-      if (doMetBinRegions) {
-	savePlotsDir(h_1d_cr5_invmass_nomt_met100,outfile_,"cr5_invmass_nomt_met100");
-	savePlotsDir(h_1d_cr5_invmass_nomt_met150,outfile_,"cr5_invmass_nomt_met150");
-	savePlotsDir(h_1d_cr5_invmass_nomt_met175,outfile_,"cr5_invmass_nomt_met175");
-      }
-      savePlotsDir(h_1d_cr5_invmass_mt_nm1,outfile_,"cr5_invmass_mt_nm1");
-      savePlotsDir(h_1d_cr5_invmass_met_nm1,outfile_,"cr5_invmass_met_nm1");
-      savePlotsDir(h_1d_cr5_invmass_met100,outfile_,"cr5_invmass_met100");
-      savePlotsDir(h_1d_cr5_invmass_met125,outfile_,"cr5_invmass_met125");
-      savePlotsDir(h_1d_cr5_invmass_met150,outfile_,"cr5_invmass_met150");
-    }
-    savePlotsDir(h_1d_cr5_invmass_final,outfile_,"cr5_invmass_final");
-  }
-
-  if (doCR5HighMass) {
-    savePlotsDir(h_1d_cr5_highmass_presel,outfile_,"cr5_highmass_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_highmass_mt2bl_nm1,outfile_,"cr5_highmass_mt2bl_nm1");
-      savePlotsDir(h_1d_cr5_highmass_mtfirst,outfile_,"cr5_highmass_mtfirst");
-      savePlotsDir(h_1d_cr5_highmass_mt_nm1,outfile_,"cr5_highmass_mt_nm1");
-      savePlotsDir(h_1d_cr5_highmass_met_nm1,outfile_,"cr5_highmass_met_nm1");
-      savePlotsDir(h_1d_cr5_highmass_met100,outfile_,"cr5_highmass_met100");
-      savePlotsDir(h_1d_cr5_highmass_met125,outfile_,"cr5_highmass_met125");
-      savePlotsDir(h_1d_cr5_highmass_met150,outfile_,"cr5_highmass_met150");
-    }
-    savePlotsDir(h_1d_cr5_highmass_final,outfile_,"cr5_highmass_final");
-  }
-
-  if (doCR5LowMass) {
-    savePlotsDir(h_1d_cr5_lowmass_presel,outfile_,"cr5_lowmass_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_lowmass_mt2bl_nm1,outfile_,"cr5_lowmass_mt2bl_nm1");
-      savePlotsDir(h_1d_cr5_lowmass_mtfirst,outfile_,"cr5_lowmass_mtfirst");
-      savePlotsDir(h_1d_cr5_lowmass_mt_nm1,outfile_,"cr5_lowmass_mt_nm1");
-      savePlotsDir(h_1d_cr5_lowmass_met_nm1,outfile_,"cr5_lowmass_met_nm1");
-      savePlotsDir(h_1d_cr5_lowmass_met100,outfile_,"cr5_lowmass_met100");
-      savePlotsDir(h_1d_cr5_lowmass_met125,outfile_,"cr5_lowmass_met125");
-      savePlotsDir(h_1d_cr5_lowmass_met150,outfile_,"cr5_lowmass_met150");
-    }
-    savePlotsDir(h_1d_cr5_lowmass_final,outfile_,"cr5_lowmass_final");
-  }
-
-  if (doCR5MassLast) {
-    savePlotsDir(h_1d_cr5_bbmasslast_presel,outfile_,"cr5_bbmasslast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr5_bbmasslast_mt2bl_nm1,outfile_,"cr5_bbmasslast_mt2bl_nm1");
-      savePlotsDir(h_1d_cr5_bbmasslast_mtpeak,outfile_,"cr5_bbmasslast_mtpeak");
-      savePlotsDir(h_1d_cr5_bbmasslast_mtcut,outfile_,"cr5_bbmasslast_mtcut");
-      savePlotsDir(h_1d_cr5_bbmasslast_mtcut_met100,outfile_,"cr5_bbmasslast_mtcut_met100");
-      savePlotsDir(h_1d_cr5_bbmasslast_metcut,outfile_,"cr5_bbmasslast_metcut");
-      savePlotsDir(h_1d_cr5_bbmasslast_mt_nm1,outfile_,"cr5_bbmasslast_mt_nm1");
-      if (doMetBinRegions) {
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met50,outfile_,"cr5_bbmasslast_nomt_met50");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met75,outfile_,"cr5_bbmasslast_nomt_met75");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met100,outfile_,"cr5_bbmasslast_nomt_met100");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met125,outfile_,"cr5_bbmasslast_nomt_met125");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met137,outfile_,"cr5_bbmasslast_nomt_met137");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met150,outfile_,"cr5_bbmasslast_nomt_met150");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met162,outfile_,"cr5_bbmasslast_nomt_met162");
-	savePlotsDir(h_1d_cr5_bbmasslast_nomt_met175,outfile_,"cr5_bbmasslast_nomt_met175");
-      }
-      savePlotsDir(h_1d_cr5_bbmasslast_met_nm1,outfile_,"cr5_bbmasslast_met_nm1");
-      savePlotsDir(h_1d_cr5_bbmasslast_met100,outfile_,"cr5_bbmasslast_met100");
-      savePlotsDir(h_1d_cr5_bbmasslast_met125,outfile_,"cr5_bbmasslast_met125");
-      savePlotsDir(h_1d_cr5_bbmasslast_met150,outfile_,"cr5_bbmasslast_met150");
-      savePlotsDir(h_1d_cr5_bbmasslast_met500,outfile_,"cr5_bbmasslast_met500");
-      savePlotsDir(h_1d_cr5_bbmasslast_bbmass_nm1,outfile_,"cr5_bbmasslast_bbmass_nm1");
-    }
-    savePlotsDir(h_1d_cr5_bbmasslast_final,outfile_,"cr5_bbmasslast_final");
-  }
-
-  if (doCR6) {
-    savePlotsDir(h_1d_cr6_presel,outfile_,"cr6_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr6_met_nm1,outfile_,"cr6_met_nm1");
-      savePlotsDir(h_1d_cr6_mt_nm1,outfile_,"cr6_mt_nm1");
-      savePlotsDir(h_1d_cr6_mt2bl_nm1,outfile_,"cr6_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr6_final,outfile_,"cr6_final");
-  }
-
-  if (doCR6METLast) {
-    savePlotsDir(h_1d_cr6_metlast_presel,outfile_,"cr6_metlast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr6_metlast_mt2bl_nm1,outfile_,"cr6_metlast_mt2bl_nm1");
-      savePlotsDir(h_1d_cr6_metlast_mt_nm1,outfile_,"cr6_metlast_mt_nm1");
-      savePlotsDir(h_1d_cr6_metlast_met_nm1,outfile_,"cr6_metlast_met_nm1");
-      savePlotsDir(h_1d_cr6_metlast_met100,outfile_,"cr6_metlast_met100");
-      savePlotsDir(h_1d_cr6_metlast_met150,outfile_,"cr6_metlast_met150");
-    }
-    savePlotsDir(h_1d_cr6_metlast_final,outfile_,"cr6_metlast_final");
-  }
-
-  if (doCR7) {
-    savePlotsDir(h_1d_cr7_presel,outfile_,"cr7_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr7_met_nm1,outfile_,"cr7_met_nm1");
-      savePlotsDir(h_1d_cr7_mt_nm1,outfile_,"cr7_mt_nm1");
-      savePlotsDir(h_1d_cr7_mt2bl_nm1,outfile_,"cr7_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr7_final,outfile_,"cr7_final");
-  }
-
-  if (doCR8) {
-    savePlotsDir(h_1d_cr8_presel,outfile_,"cr8_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr8_met_nm1,outfile_,"cr8_met_nm1");
-      savePlotsDir(h_1d_cr8_mt_nm1,outfile_,"cr8_mt_nm1");
-      savePlotsDir(h_1d_cr8_mt2bl_nm1,outfile_,"cr8_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr8_final,outfile_,"cr8_final");
-  }
-
-  if (doCR8METLast) {
-    savePlotsDir(h_1d_cr8_metlast_presel,outfile_,"cr8_metlast_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr8_metlast_mt2bl_nm1,outfile_,"cr8_metlast_mt2bl_nm1");
-      savePlotsDir(h_1d_cr8_metlast_mtfirst,outfile_,"cr8_metlast_mtfirst");
-      savePlotsDir(h_1d_cr8_metlast_mt_nm1,outfile_,"cr8_metlast_mt_nm1");
-      savePlotsDir(h_1d_cr8_metlast_met_nm1,outfile_,"cr8_metlast_met_nm1");
-      savePlotsDir(h_1d_cr8_metlast_met100,outfile_,"cr8_metlast_met100");
-      savePlotsDir(h_1d_cr8_metlast_met125,outfile_,"cr8_metlast_met125");
-      savePlotsDir(h_1d_cr8_metlast_met150,outfile_,"cr8_metlast_met150");
-    }
-    savePlotsDir(h_1d_cr8_metlast_final,outfile_,"cr8_metlast_final");
-  }
-
-  if (doCR9) {
-    savePlotsDir(h_1d_cr9_presel,outfile_,"cr9_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr9_met_nm1,outfile_,"cr9_met_nm1");
-      savePlotsDir(h_1d_cr9_mtpeak_nomet,outfile_,"cr9_mtpeak_nomet");
-      savePlotsDir(h_1d_cr9_mt_nm1,outfile_,"cr9_mt_nm1");
-      savePlotsDir(h_1d_cr9_mtpeak_met,outfile_,"cr9_mtpeak_met");
-      savePlotsDir(h_1d_cr9_mt2bl_nm1,outfile_,"cr9_mt2bl_nm1");
-      savePlotsDir(h_1d_cr9_mtlast_mt2bl_nm1,outfile_,"cr9_mtlast_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr9_final,outfile_,"cr9_final");
-  }
-
-  if (doCR10) {
-    savePlotsDir(h_1d_cr10_presel,outfile_,"cr10_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr10_met_nm1,outfile_,"cr10_met_nm1");
-      savePlotsDir(h_1d_cr10_mt_nm1,outfile_,"cr10_mt_nm1");
-      savePlotsDir(h_1d_cr10_mt2bl_nm1,outfile_,"cr10_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr10_final,outfile_,"cr10_final");
-  }
-
-  if (doCR11) {
-    savePlotsDir(h_1d_cr11_presel,outfile_,"cr11_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr11_met_nm1,outfile_,"cr11_met_nm1");
-      savePlotsDir(h_1d_cr11_mt_nm1,outfile_,"cr11_mt_nm1");
-      savePlotsDir(h_1d_cr11_mt2bl_nm1,outfile_,"cr11_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr11_final,outfile_,"cr11_final");
-  }
-
-  if (doCR12) {
-    savePlotsDir(h_1d_cr12_presel,outfile_,"cr12_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr12_met_nm1,outfile_,"cr12_met_nm1");
-      savePlotsDir(h_1d_cr12_mt_nm1,outfile_,"cr12_mt_nm1");
-      savePlotsDir(h_1d_cr12_mt2bl_nm1,outfile_,"cr12_mt2bl_nm1");
-    }
-    savePlotsDir(h_1d_cr12_final,outfile_,"cr12_final");
-  }
-
-  if (doCR13) {
-    savePlotsDir(h_1d_cr13_presel,outfile_,"cr13_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr13_mt2bl_nm1,outfile_,"cr13_mt2bl_nm1");
-      savePlotsDir(h_1d_cr13_met_nm1,outfile_,"cr13_met_nm1");
-      savePlotsDir(h_1d_cr13_met100,outfile_,"cr13_met100");
-      savePlotsDir(h_1d_cr13_met150,outfile_,"cr13_met150");
-    }
-    savePlotsDir(h_1d_cr13_final,outfile_,"cr13_final");
-  }
-
-  if (doCR14) {
-    savePlotsDir(h_1d_cr14_presel,outfile_,"cr14_presel");
-    if (doNM1Plots) {
-      savePlotsDir(h_1d_cr14_mt2bl_nm1,outfile_,"cr14_mt2bl_nm1");
-      savePlotsDir(h_1d_cr14_mtfirst,outfile_,"cr14_mtfirst");
-      if (doMetBinRegions) {
-	savePlotsDir(h_1d_cr14_nomt_met100,outfile_,"cr14_nomt_met100");
-	savePlotsDir(h_1d_cr14_nomt_met150,outfile_,"cr14_nomt_met150");
-	savePlotsDir(h_1d_cr14_nomt_met175,outfile_,"cr14_nomt_met175");
-      }
-      savePlotsDir(h_1d_cr14_mt_nm1,outfile_,"cr14_mt_nm1");
-      savePlotsDir(h_1d_cr14_met_nm1,outfile_,"cr14_met_nm1");
-      savePlotsDir(h_1d_cr14_met100,outfile_,"cr14_met100");
-      savePlotsDir(h_1d_cr14_met125,outfile_,"cr14_met125");
-      savePlotsDir(h_1d_cr14_met150,outfile_,"cr14_met150");
-    }
-    savePlotsDir(h_1d_cr14_final,outfile_,"cr14_final");
-  }
-
-  if (doStopSel) {
-    savePlotsDir(h_1d_stop_presel,outfile_,"stop_presel");
-    savePlotsDir(h_1d_stop_met_nm1,outfile_,"stop_met_nm1");
-    savePlotsDir(h_1d_stop_mt_nm1,outfile_,"stop_mt_nm1");
-    savePlotsDir(h_1d_stop_isotrk_nm1,outfile_,"stop_isotrk_nm1");
-    savePlotsDir(h_1d_stop_tauveto_nm1,outfile_,"stop_tauveto_nm1");
-    savePlotsDir(h_1d_stop_comp,outfile_,"stop_comp");
-  }
-
-  outfile_->Write();
-  outfile_->Close();
-  delete outfile_;
-
-  already_seen.clear();
-
-  gROOT->cd();
-
-  bmark->Stop("benchmark");
-  cout << endl;
-  cout << nEventsTotal << " Events Processed" << endl;
-  cout << nPass_EventCuts << " Events Passing basic event cuts" << endl;
-  cout << nPass_PreselCuts << " Events Passing basic presel cuts" << endl;
-  if (!isData)  cout << nEventsPass << " Events Passed" << endl;
-  cout << "------------------------------" << endl;
-  cout << "CPU  Time:	" << Form( "%.01f s", bmark->GetCpuTime("benchmark")  ) << ", Rate: " << Form( "%.1f Hz", float(nEventsTotal)/bmark->GetCpuTime("benchmark")) << endl;
-  cout << "Real Time:	" << Form( "%.01f s", bmark->GetRealTime("benchmark") ) << ", Rate: " << Form( "%.1f Hz", float(nEventsTotal)/bmark->GetRealTime("benchmark")) << endl;
-  cout << endl;
-  delete bmark;
-
-}
-
-//--------------------------------------------------------------------
-
-float WHLooper::getCSVCut(const csvpoint csv) {
-  float csvcut = 10.;
-  if (csv == WHLooper::CSVM) csvcut = 0.679;
-  else if (csv == WHLooper::CSVL) csvcut = 0.244;
-  else if (csv == WHLooper::CSVT) csvcut = 0.898;
-
-  return csvcut;
-}
-
-//--------------------------------------------------------------------
-
-void WHLooper::fillHists1DWrapper(std::map<std::string, TH1F*>& h_1d, const float evtweight, const std::string& dir) {
-
-  fillHists1D(h_1d, evtweight, dir);
-  fillFlavorHists1D(h_1d, evtweight, dir);
-  if (doFlavorPlots) {
-    // single lepton regions: separate into e, m
-    if ((dir.find("cr3_") == std::string::npos) && (dir.find("cr4_") == std::string::npos)) {
-      if (stopt.leptype() == 0) fillFlavorHists1D(h_1d,evtweight,dir,"_e");
-      else if (stopt.leptype() == 1) fillFlavorHists1D(h_1d,evtweight,dir,"_m");
-    }
-
-    // for dilepton regions (cr3/4), separate into ee, mm, em
-    else {
-      int id1 = fabs(stopt.id1());
-      int id2 = fabs(stopt.id2());
-      if (id1 == 11 && id2 == 11) fillFlavorHists1D(h_1d,evtweight,dir,"_ee");
-      else if (id1 == 11 && id2 == 13) fillFlavorHists1D(h_1d,evtweight,dir,"_mm");
-      else fillFlavorHists1D(h_1d,evtweight,dir,"_em");
-    }
-  }
-
-  if (doWJetsPlots && isWjets_ && (dir.find("inc_") != std::string::npos)) {
-    if (stopt.nbs() == 0) fillHists1D(h_1d,evtweight,dir,"_0genb");
-    else if (stopt.nbs() == 1) fillHists1D(h_1d,evtweight,dir,"_1genb");
-    else if (stopt.nbs() == 2) fillHists1D(h_1d,evtweight,dir,"_2genb");
-  }
-
-}
-
-//--------------------------------------------------------------------
-
-void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtweight, const std::string& dir, const std::string& suffix) {
-
-  outfile_->cd(dir.c_str());
-
-  TVector2 lep(stopt.lep1().px(),stopt.lep1().py());
-  TVector2 met;
-  met.SetMagPhi(met_, metphi_);
-  TVector2 trkmet;
-  met.SetMagPhi(stopt.trkmet(), stopt.trkmetphi());
-  TVector2 w = lep+met; 
-  TVector2 trkmet_nolep = trkmet + lep;
-
-  plot1D("h_njets"+suffix,        njets_,           evtweight, h_1d, 10, 0., 10.);
-  plot1D("h_njetsfwd"+suffix,     njetsfwd_,        evtweight, h_1d, 10, 0., 10.);
-  plot1D("h_njets20"+suffix,      njets20_,         evtweight, h_1d, 10, 0., 10.);
-  plot1D("h_njetsall"+suffix,     njetsall_,        evtweight, h_1d, 10, 0., 10.);
-  plot1D("h_nbjets"+suffix,       nbjets_,    evtweight, h_1d, 5, 0., 5.);
-  plot1D("h_nbjetsl"+suffix,      nbjetsl_,   evtweight, h_1d, 5, 0., 5.);
-
-  if (met_ > 100.) {
-    plot1D("h_pfmetcalometdphi_met100"+suffix,getdphi(stopt.t1metphicorrphi(), stopt.calometphi()),  evtweight, h_1d, 50, 0., TMath::Pi());
-  }
-  if (met_ > 150.) {
-    plot1D("h_pfmetcalometdphi_met150"+suffix,getdphi(stopt.t1metphicorrphi(), stopt.calometphi()),  evtweight, h_1d, 50, 0., TMath::Pi());
-  }
-  if (met_ > 175.) {
-    plot1D("h_pfmetcalometdphi_met175"+suffix,getdphi(stopt.t1metphicorrphi(), stopt.calometphi()),  evtweight, h_1d, 50, 0., TMath::Pi());
-  }
-
-  // phi cor met validation
-  // plot1D("h_metdiff"+suffix,        met_ - stopt.pfmet(),    evtweight, h_1d, 500, -250., 250.);
-  // plot1D("h_metphidiff"+suffix,  fabs(TVector2::Phi_mpi_pi(metphi_ - stopt.pfmetphi())),    evtweight, h_1d,  50, 0., TMath::Pi());
-
-  plot1D("h_bbmass"+suffix,       bb_.M(),       evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_bbpt"+suffix,       bb_.pt(),       evtweight, h_1d, 500, 0., 500.);
-  // plot1D("h_bblep1dr"+suffix,  ROOT::Math::VectorUtil::DeltaR( bb_ , stopt.lep1() ), evtweight, h_1d, 100, 0., 2.*TMath::Pi());
-  // plot1D("h_bblep1dphi"+suffix,  fabs(TVector2::Phi_mpi_pi(bb_.phi() - stopt.lep1().phi())), evtweight, h_1d, 50, 0., TMath::Pi());
-
-  //  plot1D("h_bbwdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(bb_.phi() - w.Phi())), evtweight, h_1d, 50, 0., TMath::Pi());
-  plot1D("h_bbwdphi"+suffix,  bbwdphi_, evtweight, h_1d, 50, 0., TMath::Pi());
-  // plot1D("h_bbwdpt"+suffix,   bb_.pt() - w.Mod(),       evtweight, h_1d, 500, -250., 250.);
-
-  // jet smearing corrs
-  for (unsigned int i=0; i < jets_smearcorrs_.size(); ++i) {
-    plot1D("h_jetsmearcorrs"+suffix,   jets_smearcorrs_.at(i),  evtweight, h_1d, 100, 0., 2.);
-  }
-
-  if (isWjets_ && (stopt.nbs() == 2)) {
-    plot1D("h_genb1pt"+suffix,       stopt.genbs().at(0).pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_genb2pt"+suffix,       stopt.genbs().at(1).pt(),       evtweight, h_1d, 1000, 0., 1000.);
-  }
-
-  // plots split by nvtx
-  if (doNvtxSplit) {
-    if (stopt.nvtx() < 15.) {
-      plot1D("h_lep1mt_lowpu"+suffix,       mt_,       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_met_lowpu"+suffix,          met_,    evtweight, h_1d, 500, 0., 500.);
-      plot1D("h_mt2bl_lowpu"+suffix,  mt2bl_, evtweight, h_1d, 1000, 0., 1000.);
-    } else {
-      plot1D("h_lep1mt_highpu"+suffix,       mt_,       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_met_highpu"+suffix,          met_,    evtweight, h_1d, 500, 0., 500.);
-      plot1D("h_mt2bl_highpu"+suffix,  mt2bl_, evtweight, h_1d, 1000, 0., 1000.);
-    }
-  } // if doNvtxSplit
+  // plots split by nvtx
+  if (doNvtxSplit) {
+    if (stopt.nvtx() < 15.) {
+      h.fill(WV_LEP1MT_LOWPU, cell,       mt_,       evtweight, 1000, 0., 1000.);
+      h.fill(WV_MET_LOWPU, cell,          met_,    evtweight, 500, 0., 500.);
+      h.fill(WV_MT2BL_LOWPU, cell,  mt2bl_, evtweight, 1000, 0., 1000.);
+    } else {
+      h.fill(WV_LEP1MT_HIGHPU, cell,       mt_,       evtweight, 1000, 0., 1000.);
+      h.fill(WV_MET_HIGHPU, cell,          met_,    evtweight, 500, 0., 500.);
+      h.fill(WV_MT2BL_HIGHPU, cell,  mt2bl_, evtweight, 1000, 0., 1000.);
+    }
+  } // if doNvtxSplit
 
   // plot tau veto result
-  plot1D("h_passtauveto"+suffix,  (int)passTauVeto(),  evtweight, h_1d, 2, 0., 2.);
+  h.fill(WV_PASSTAUVETO, cell,  (int)passTauVeto(),  evtweight, 2, 0., 2.);
 
-  plot1D("h_nbs",       stopt.nbs(),       evtweight, h_1d, 5, 0, 5);
+  h.fill(WV_NBS, SUF_NONE,       stopt.nbs(),       evtweight, 5, 0, 5);
 
   if (doWJetsPlots && isWjets_) {
     // requires babies V20 or higher
     if (stopt.nbs() == 0) {
-      plot1D("h_jet1flavor_0b"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, h_1d, 23, -1., 22.);
-      plot1D("h_jet2flavor_0b"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, h_1d, 23, -1., 22.);
+      h.fill(WV_JET1FLAVOR_0B, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, 23, -1., 22.);
+      h.fill(WV_JET2FLAVOR_0B, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, 23, -1., 22.);
     } else if (stopt.nbs() == 1) {
-      plot1D("h_jet1flavor_1b"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, h_1d, 23, -1., 22.);
-      plot1D("h_jet2flavor_1b"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, h_1d, 23, -1., 22.);
+      h.fill(WV_JET1FLAVOR_1B, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, 23, -1., 22.);
+      h.fill(WV_JET2FLAVOR_1B, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, 23, -1., 22.);
     } else if (stopt.nbs() == 2) {
-      plot1D("h_jet1flavor_2b"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, h_1d, 23, -1., 22.);
-      plot1D("h_jet2flavor_2b"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, h_1d, 23, -1., 22.);
+      h.fill(WV_JET1FLAVOR_2B, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, 23, -1., 22.);
+      h.fill(WV_JET2FLAVOR_2B, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, 23, -1., 22.);
     }
 
     // requires babies V21 or higher
-    // if (stopt.nbs() == 1) plot1D("h_genbjet1pt_1b"+suffix,       stopt.genbs().at(0).pt(),       evtweight, h_1d, 1000, 0., 1000.);
+    // if (stopt.nbs() == 1) h.fill(WV_GENBJET1PT_1B, cell,       stopt.genbs().at(0).pt(),       evtweight, 1000, 0., 1000.);
     // if (stopt.nbs() == 2) {
     //   // the genbs vector in the babies isn't presorted by pt..
     //   float genb1pt = stopt.genbs().at(0).pt();
@@ -4402,48 +1530,48 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
     //   } else {
     // 	genb2pt = stopt.genbs().at(1).pt();
     //   }
-    //   plot1D("h_genbjet1pt"+suffix,       genb1pt,       evtweight, h_1d, 1000, 0., 1000.);
-    //   plot1D("h_genbjet2pt"+suffix,       genb2pt,       evtweight, h_1d, 1000, 0., 1000.);
+    //   h.fill(WV_GENBJET1PT, cell,       genb1pt,       evtweight, 1000, 0., 1000.);
+    //   h.fill(WV_GENBJET2PT, cell,       genb2pt,       evtweight, 1000, 0., 1000.);
     // }
   } // wjets plots
 
   // bjets and bbbar plots
   if (nbjets_ >= 2) {
-    plot1D("h_bjet1pt"+suffix,       bjets_[0].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_bjet2pt"+suffix,       bjets_[1].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_bjet1eta"+suffix,       bjets_[0].eta(),       evtweight, h_1d, 100, -3., 3.);
-    plot1D("h_bjet2eta"+suffix,       bjets_[1].eta(),       evtweight, h_1d, 100, -3., 3.);
+    h.fill(WV_BJET1PT, cell,       bjets_[0].pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_BJET2PT, cell,       bjets_[1].pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_BJET1ETA, cell,       bjets_[0].eta(),       evtweight, 100, -3., 3.);
+    h.fill(WV_BJET2ETA, cell,       bjets_[1].eta(),       evtweight, 100, -3., 3.);
 
     // // need V00-02-21 or higher babies for these vars
-    // plot1D("h_bjet1pumva"+suffix, stopt.pfjets_mva5xPUid().at(bjets_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
-    // plot1D("h_bjet2pumva"+suffix, stopt.pfjets_mva5xPUid().at(bjets_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+    // h.fill(WV_BJET1PUMVA, cell, stopt.pfjets_mva5xPUid().at(bjets_idx_.at(0)) , evtweight, 100, -1., 1.);
+    // h.fill(WV_BJET2PUMVA, cell, stopt.pfjets_mva5xPUid().at(bjets_idx_.at(1)) , evtweight, 100, -1., 1.);
 
-    plot1D("h_bjet1metdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(bjets_[0].phi() - metphi_)),  evtweight, h_1d, 50, 0., TMath::Pi());
-    plot1D("h_bjet2metdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(bjets_[1].phi() - metphi_)),  evtweight, h_1d, 50, 0., TMath::Pi());
+    h.fill(WV_BJET1METDPHI, cell,  fabs(TVector2::Phi_mpi_pi(bjets_[0].phi() - metphi_)),  evtweight, 50, 0., TMath::Pi());
+    h.fill(WV_BJET2METDPHI, cell,  fabs(TVector2::Phi_mpi_pi(bjets_[1].phi() - metphi_)),  evtweight, 50, 0., TMath::Pi());
 
     float bbdr = ROOT::Math::VectorUtil::DeltaR( bjets_.at(0) , bjets_.at(1) );
-    plot1D("h_bbdr"+suffix,  bbdr, evtweight, h_1d, 100, 0., 2.*TMath::Pi());
-    plot1D("h_bbdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(bjets_[0].phi() - bjets_[1].phi())), evtweight, h_1d, 50, 0., TMath::Pi());
-    plot1D("h_bbdeta"+suffix,  bjets_.at(0).eta() - bjets_.at(1).eta() , evtweight, h_1d, 100, -6., 6.);
+    h.fill(WV_BBDR, cell,  bbdr, evtweight, 100, 0., 2.*TMath::Pi());
+    h.fill(WV_BBDPHI, cell,  fabs(TVector2::Phi_mpi_pi(bjets_[0].phi() - bjets_[1].phi())), evtweight, 50, 0., TMath::Pi());
+    h.fill(WV_BBDETA, cell,  bjets_.at(0).eta() - bjets_.at(1).eta() , evtweight, 100, -6., 6.);
 
     float lep1bjet1dr = ROOT::Math::VectorUtil::DeltaR( stopt.lep1(), bjets_.at(0) );
     float lep1bjet2dr = ROOT::Math::VectorUtil::DeltaR( stopt.lep1(), bjets_.at(1) );
-    plot1D("h_lep1bjet1dr"+suffix, lep1bjet1dr , evtweight, h_1d, 100, 0., 2.*TMath::Pi());
-    plot1D("h_lep1bjet2dr"+suffix, lep1bjet2dr , evtweight, h_1d, 100, 0., 2.*TMath::Pi());
+    h.fill(WV_LEP1BJET1DR, cell, lep1bjet1dr , evtweight, 100, 0., 2.*TMath::Pi());
+    h.fill(WV_LEP1BJET2DR, cell, lep1bjet2dr , evtweight, 100, 0., 2.*TMath::Pi());
 
-    plot1D("h_lep1bjetmindr"+suffix, TMath::Min(lep1bjet1dr,lep1bjet2dr) , evtweight, h_1d, 100, 0., 2.*TMath::Pi());
+    h.fill(WV_LEP1BJETMINDR, cell, TMath::Min(lep1bjet1dr,lep1bjet2dr) , evtweight, 100, 0., 2.*TMath::Pi());
 
     LorentzVector lbb = stopt.lep1() + bjets_.at(0) + bjets_.at(1);
-    plot1D("h_lbbpt"+suffix,          lbb.pt(),    evtweight, h_1d, 500, 0., 500.);
+    h.fill(WV_LBBPT, cell,          lbb.pt(),    evtweight, 500, 0., 500.);
 
     // maria variable: M(bb) * dR(bb) / pt(bb)
-    plot1D("h_bbmdrpt"+suffix, bb_.M() * bbdr / bb_.pt(), evtweight, h_1d, 200, 0., 2.*TMath::Pi());
+    h.fill(WV_BBMDRPT, cell, bb_.M() * bbdr / bb_.pt(), evtweight, 200, 0., 2.*TMath::Pi());
 
     if (doNvtxSplit) {
       if (stopt.nvtx() < 15.) {
-	plot1D("h_lbbpt_lowpu"+suffix,          lbb.pt(),    evtweight, h_1d, 500, 0., 500.);
+	h.fill(WV_LBBPT_LOWPU, cell,          lbb.pt(),    evtweight, 500, 0., 500.);
       } else {
-	plot1D("h_lbbpt_highpu"+suffix,          lbb.pt(),    evtweight, h_1d, 500, 0., 500.);
+	h.fill(WV_LBBPT_HIGHPU, cell,          lbb.pt(),    evtweight, 500, 0., 500.);
       }
     } // if doNvtxSplit
 
@@ -4451,151 +1579,151 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
     // // plots for low pt jets: leading pt < 100
     // //  to investigate data/MC disagreement
     // if (bjets_[0].pt() < 100.) {
-    //   plot1D("h_bjet1eta_lowpt"+suffix,       bjets_[0].eta(),       evtweight, h_1d, 100, -3., 3.);
-    //   plot1D("h_bjet2eta_lowpt"+suffix,       bjets_[1].eta(),       evtweight, h_1d, 100, -3., 3.);
+    //   h.fill(WV_BJET1ETA_LOWPT, cell,       bjets_[0].eta(),       evtweight, 100, -3., 3.);
+    //   h.fill(WV_BJET2ETA_LOWPT, cell,       bjets_[1].eta(),       evtweight, 100, -3., 3.);
 
-    //   plot1D("h_bbdr_lowpt"+suffix,  ROOT::Math::VectorUtil::DeltaR( bjets_.at(0) , bjets_.at(1) ), evtweight, h_1d, 100, 0., 2.*TMath::Pi());
-    //   plot1D("h_bbdeta_lowpt"+suffix,  bjets_.at(0).eta() - bjets_.at(1).eta() , evtweight, h_1d, 100, -6., 6.);
+    //   h.fill(WV_BBDR_LOWPT, cell,  ROOT::Math::VectorUtil::DeltaR( bjets_.at(0) , bjets_.at(1) ), evtweight, 100, 0., 2.*TMath::Pi());
+    //   h.fill(WV_BBDETA_LOWPT, cell,  bjets_.at(0).eta() - bjets_.at(1).eta() , evtweight, 100, -6., 6.);
     // }
 
     // else {
-    //   plot1D("h_bjet1eta_highpt"+suffix,       bjets_[0].eta(),       evtweight, h_1d, 100, -3., 3.);
-    //   plot1D("h_bjet2eta_highpt"+suffix,       bjets_[1].eta(),       evtweight, h_1d, 100, -3., 3.);
+    //   h.fill(WV_BJET1ETA_HIGHPT, cell,       bjets_[0].eta(),       evtweight, 100, -3., 3.);
+    //   h.fill(WV_BJET2ETA_HIGHPT, cell,       bjets_[1].eta(),       evtweight, 100, -3., 3.);
 
-    //   plot1D("h_bbdr_highpt"+suffix,  ROOT::Math::VectorUtil::DeltaR( bjets_.at(0) , bjets_.at(1) ), evtweight, h_1d, 100, 0., 2.*TMath::Pi());
-    //   plot1D("h_bbdeta_highpt"+suffix,  bjets_.at(0).eta() - bjets_.at(1).eta() , evtweight, h_1d, 100, -6., 6.);
+    //   h.fill(WV_BBDR_HIGHPT, cell,  ROOT::Math::VectorUtil::DeltaR( bjets_.at(0) , bjets_.at(1) ), evtweight, 100, 0., 2.*TMath::Pi());
+    //   h.fill(WV_BBDETA_HIGHPT, cell,  bjets_.at(0).eta() - bjets_.at(1).eta() , evtweight, 100, -6., 6.);
     // }
 
     // LorentzVector b1lep1 = bjets_.at(0) + stopt.lep1();
-    // plot1D("h_bjet1lep1mass"+suffix,       b1lep1.M(),       evtweight, h_1d, 1000, 0., 1000.);
+    // h.fill(WV_BJET1LEP1MASS, cell,       b1lep1.M(),       evtweight, 1000, 0., 1000.);
     // float bjet1lep1dphi = fabs(TVector2::Phi_mpi_pi(bjets_[0].phi() - stopt.lep1().phi()));
-    // plot1D("h_bjet1lep1dphi"+suffix,  bjet1lep1dphi, evtweight, h_1d, 50, 0., TMath::Pi());
+    // h.fill(WV_BJET1LEP1DPHI, cell,  bjet1lep1dphi, evtweight, 50, 0., TMath::Pi());
     // LorentzVector b2lep1 = bjets_.at(1) + stopt.lep1();
-    // plot1D("h_bjet2lep1mass"+suffix,       b2lep1.M(),       evtweight, h_1d, 1000, 0., 1000.);
+    // h.fill(WV_BJET2LEP1MASS, cell,       b2lep1.M(),       evtweight, 1000, 0., 1000.);
     // float bjet2lep1dphi = fabs(TVector2::Phi_mpi_pi(bjets_[1].phi() - stopt.lep1().phi()));
-    // plot1D("h_bjet2lep1dphi"+suffix,  bjet2lep1dphi, evtweight, h_1d, 50, 0., TMath::Pi());
+    // h.fill(WV_BJET2LEP1DPHI, cell,  bjet2lep1dphi, evtweight, 50, 0., TMath::Pi());
 
-    // plot1D("h_bjetlep1mindphi"+suffix,  TMath::Min(bjet1lep1dphi,bjet2lep1dphi), evtweight, h_1d, 50, 0., TMath::Pi());
+    // h.fill(WV_BJETLEP1MINDPHI, cell,  TMath::Min(bjet1lep1dphi,bjet2lep1dphi), evtweight, 50, 0., TMath::Pi());
 
     // use loose btags here in case i plot before requiring 2 med
     // std::vector<int> bjetIdx = getBJetIndex(WHLooper::CSVL,-1,-1);
-    // plot1D("h_bjet1mc3"+suffix, stopt.pfjets_mc3().at(bjetIdx.at(0)) , evtweight, h_1d, 40, -20., 20.);
-    // plot1D("h_bjet2mc3"+suffix, stopt.pfjets_mc3().at(bjetIdx.at(1)) , evtweight, h_1d, 40, -20., 20.);
+    // h.fill(WV_BJET1MC3, cell, stopt.pfjets_mc3().at(bjetIdx.at(0)) , evtweight, 40, -20., 20.);
+    // h.fill(WV_BJET2MC3, cell, stopt.pfjets_mc3().at(bjetIdx.at(1)) , evtweight, 40, -20., 20.);
 
     // need V00-02-20 or higher babies for these vars
-    // plot1D("h_bjet1flavor"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(bjetIdx.at(0))) , evtweight, h_1d, 23, -1., 22.);
-    // plot1D("h_bjet2flavor"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(bjetIdx.at(1))) , evtweight, h_1d, 23, -1., 22.);
+    // h.fill(WV_BJET1FLAVOR, cell, abs(stopt.pfjets_mcflavorAlgo().at(bjetIdx.at(0))) , evtweight, 23, -1., 22.);
+    // h.fill(WV_BJET2FLAVOR, cell, abs(stopt.pfjets_mcflavorAlgo().at(bjetIdx.at(1))) , evtweight, 23, -1., 22.);
   } // if nbjets >= 2
 
   if (njets_ >= 2) {
-    plot1D("h_jet1pt"+suffix,       jets_[0].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_jet2pt"+suffix,       jets_[1].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_jet1eta"+suffix,      jets_[0].eta(),      evtweight, h_1d, 100, -3., 3.);
-    plot1D("h_jet2eta"+suffix,      jets_[1].eta(),      evtweight, h_1d, 100, -3., 3.);
+    h.fill(WV_JET1PT, cell,       jets_[0].pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_JET2PT, cell,       jets_[1].pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_JET1ETA, cell,      jets_[0].eta(),      evtweight, 100, -3., 3.);
+    h.fill(WV_JET2ETA, cell,      jets_[1].eta(),      evtweight, 100, -3., 3.);
 
-    plot1D("h_jet1metdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(jets_[0].phi() - metphi_)),  evtweight, h_1d, 50, 0., TMath::Pi());
-    plot1D("h_jet2metdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(jets_[1].phi() - metphi_)),  evtweight, h_1d, 50, 0., TMath::Pi());
+    h.fill(WV_JET1METDPHI, cell,  fabs(TVector2::Phi_mpi_pi(jets_[0].phi() - metphi_)),  evtweight, 50, 0., TMath::Pi());
+    h.fill(WV_JET2METDPHI, cell,  fabs(TVector2::Phi_mpi_pi(jets_[1].phi() - metphi_)),  evtweight, 50, 0., TMath::Pi());
 
     float jjdr = ROOT::Math::VectorUtil::DeltaR( jets_.at(0) , jets_.at(1) );
-    plot1D("h_jjdr"+suffix,  jjdr, evtweight, h_1d, 100, 0., 2.*TMath::Pi());
-    plot1D("h_jjdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(jets_[0].phi() - jets_[1].phi())), evtweight, h_1d, 50, 0., TMath::Pi());
+    h.fill(WV_JJDR, cell,  jjdr, evtweight, 100, 0., 2.*TMath::Pi());
+    h.fill(WV_JJDPHI, cell,  fabs(TVector2::Phi_mpi_pi(jets_[0].phi() - jets_[1].phi())), evtweight, 50, 0., TMath::Pi());
 
     // maria variable: M(jj) * dR(jj) / pt(jj)
     LorentzVector jj = jets_.at(0) + jets_.at(1);
-    plot1D("h_jjmdrpt"+suffix, jj.M() * jjdr / jj.pt(), evtweight, h_1d, 200, 0., 2.*TMath::Pi());
+    h.fill(WV_JJMDRPT, cell, jj.M() * jjdr / jj.pt(), evtweight, 200, 0., 2.*TMath::Pi());
 
-    plot1D("h_jet1csv"+suffix,      jets_csv_.at(0),      evtweight, h_1d, 100, 0., 1.);
-    plot1D("h_jet2csv"+suffix,      jets_csv_.at(1),      evtweight, h_1d, 100, 0., 1.);
+    h.fill(WV_JET1CSV, cell,      jets_csv_.at(0),      evtweight, 100, 0., 1.);
+    h.fill(WV_JET2CSV, cell,      jets_csv_.at(1),      evtweight, 100, 0., 1.);
 
     // // plot csv in bins of jet pt
     // for (unsigned int ijet = 0; ijet < jets_.size(); ++ijet) {
-    //   if (jets_[ijet].pt() < 50.)          plot1D("h_jetcsv_pt0"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 60.)     plot1D("h_jetcsv_pt1"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 70.)     plot1D("h_jetcsv_pt2"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 80.)     plot1D("h_jetcsv_pt3"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 90.)     plot1D("h_jetcsv_pt4"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 100.)    plot1D("h_jetcsv_pt5"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 120.)    plot1D("h_jetcsv_pt6"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 150.)    plot1D("h_jetcsv_pt7"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else if (jets_[ijet].pt() < 200.)    plot1D("h_jetcsv_pt8"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
-    //   else                                 plot1D("h_jetcsv_pt9"+suffix,      jets_csv_.at(ijet),      evtweight, h_1d, 100, 0., 1.);
+    //   if (jets_[ijet].pt() < 50.)          h.fill(WV_JETCSV_PT0, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 60.)     h.fill(WV_JETCSV_PT1, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 70.)     h.fill(WV_JETCSV_PT2, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 80.)     h.fill(WV_JETCSV_PT3, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 90.)     h.fill(WV_JETCSV_PT4, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 100.)    h.fill(WV_JETCSV_PT5, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 120.)    h.fill(WV_JETCSV_PT6, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 150.)    h.fill(WV_JETCSV_PT7, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else if (jets_[ijet].pt() < 200.)    h.fill(WV_JETCSV_PT8, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
+    //   else                                 h.fill(WV_JETCSV_PT9, cell,      jets_csv_.at(ijet),      evtweight, 100, 0., 1.);
     // }
 
     // need V00-02-21 or higher babies for these vars
-    plot1D("h_jet1pumva"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
-    plot1D("h_jet2pumva"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+    h.fill(WV_JET1PUMVA, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, 100, -1., 1.);
+    h.fill(WV_JET2PUMVA, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, 100, -1., 1.);
 
-    plot1D("h_jet1chmneudiff"+suffix, stopt.pfjets_chm().at(jets_idx_.at(0)) - stopt.pfjets_neu().at(jets_idx_.at(0)) , evtweight, h_1d, 200, -50, 150);
-    plot1D("h_jet2chmneudiff"+suffix, stopt.pfjets_chm().at(jets_idx_.at(1)) - stopt.pfjets_neu().at(jets_idx_.at(1)) , evtweight, h_1d, 200, -50, 150);
+    h.fill(WV_JET1CHMNEUDIFF, cell, stopt.pfjets_chm().at(jets_idx_.at(0)) - stopt.pfjets_neu().at(jets_idx_.at(0)) , evtweight, 200, -50, 150);
+    h.fill(WV_JET2CHMNEUDIFF, cell, stopt.pfjets_chm().at(jets_idx_.at(1)) - stopt.pfjets_neu().at(jets_idx_.at(1)) , evtweight, 200, -50, 150);
 
     // // requires babies V28 or higher
-    // plot1D("h_jet1tobtecmult"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) , evtweight, h_1d, 100, 0, 100);
-    // plot1D("h_jet1tobtecmultfrac"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) / stopt.pfjets_chm().at(jets_idx_.at(0)) , evtweight, h_1d, 50, 0., 1.);
-    // plot1D("h_jet1tobtecfrac"+suffix, stopt.pfjets_tobtecfrac().at(jets_idx_.at(0)) , evtweight, h_1d, 50, 0., 1.);
-    // plot1D("h_jet2tobtecmult"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) , evtweight, h_1d, 100, 0, 100);
-    // plot1D("h_jet2tobtecmultfrac"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) / stopt.pfjets_chm().at(jets_idx_.at(1)) , evtweight, h_1d, 50, 0., 1.);
-    // plot1D("h_jet2tobtecfrac"+suffix, stopt.pfjets_tobtecfrac().at(jets_idx_.at(1)) , evtweight, h_1d, 50, 0., 1.);
+    // h.fill(WV_JET1TOBTECMULT, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) , evtweight, 100, 0, 100);
+    // h.fill(WV_JET1TOBTECMULTFRAC, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) / stopt.pfjets_chm().at(jets_idx_.at(0)) , evtweight, 50, 0., 1.);
+    // h.fill(WV_JET1TOBTECFRAC, cell, stopt.pfjets_tobtecfrac().at(jets_idx_.at(0)) , evtweight, 50, 0., 1.);
+    // h.fill(WV_JET2TOBTECMULT, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) , evtweight, 100, 0, 100);
+    // h.fill(WV_JET2TOBTECMULTFRAC, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) / stopt.pfjets_chm().at(jets_idx_.at(1)) , evtweight, 50, 0., 1.);
+    // h.fill(WV_JET2TOBTECFRAC, cell, stopt.pfjets_tobtecfrac().at(jets_idx_.at(1)) , evtweight, 50, 0., 1.);
 
 
     // if ( (fabs(jets_[0].eta()) > 0.9) && (fabs(jets_[0].eta()) < 1.9) ) {
-    //   plot1D("h_jet1chmneudiff_badeta"+suffix, stopt.pfjets_chm().at(jets_idx_.at(0)) - stopt.pfjets_neu().at(jets_idx_.at(0)) , evtweight, h_1d, 200, -50, 150);
-    //   plot1D("h_jet1tobtecmult_badeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) , evtweight, h_1d, 100, 0, 100);
-    //   plot1D("h_jet1tobtecmultfrac_badeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) / stopt.pfjets_chm().at(jets_idx_.at(0)) , evtweight, h_1d, 50, 0., 1.);
-    //   plot1D("h_jet1tobtecfrac_badeta"+suffix, stopt.pfjets_tobtecfrac().at(jets_idx_.at(0)) , evtweight, h_1d, 50, 0., 1.);
+    //   h.fill(WV_JET1CHMNEUDIFF_BADETA, cell, stopt.pfjets_chm().at(jets_idx_.at(0)) - stopt.pfjets_neu().at(jets_idx_.at(0)) , evtweight, 200, -50, 150);
+    //   h.fill(WV_JET1TOBTECMULT_BADETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) , evtweight, 100, 0, 100);
+    //   h.fill(WV_JET1TOBTECMULTFRAC_BADETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) / stopt.pfjets_chm().at(jets_idx_.at(0)) , evtweight, 50, 0., 1.);
+    //   h.fill(WV_JET1TOBTECFRAC_BADETA, cell, stopt.pfjets_tobtecfrac().at(jets_idx_.at(0)) , evtweight, 50, 0., 1.);
     // } else {
-    //   plot1D("h_jet1chmneudiff_goodeta"+suffix, stopt.pfjets_chm().at(jets_idx_.at(0)) - stopt.pfjets_neu().at(jets_idx_.at(0)) , evtweight, h_1d, 200, -50, 150);
-    //   plot1D("h_jet1tobtecmult_goodeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) , evtweight, h_1d, 100, 0, 100);
-    //   plot1D("h_jet1tobtecmultfrac_goodeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) / stopt.pfjets_chm().at(jets_idx_.at(0)) , evtweight, h_1d, 50, 0., 1.);
-    //   plot1D("h_jet1tobtecfrac_goodeta"+suffix, stopt.pfjets_tobtecfrac().at(jets_idx_.at(0)) , evtweight, h_1d, 50, 0., 1.);
+    //   h.fill(WV_JET1CHMNEUDIFF_GOODETA, cell, stopt.pfjets_chm().at(jets_idx_.at(0)) - stopt.pfjets_neu().at(jets_idx_.at(0)) , evtweight, 200, -50, 150);
+    //   h.fill(WV_JET1TOBTECMULT_GOODETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) , evtweight, 100, 0, 100);
+    //   h.fill(WV_JET1TOBTECMULTFRAC_GOODETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(0)) / stopt.pfjets_chm().at(jets_idx_.at(0)) , evtweight, 50, 0., 1.);
+    //   h.fill(WV_JET1TOBTECFRAC_GOODETA, cell, stopt.pfjets_tobtecfrac().at(jets_idx_.at(0)) , evtweight, 50, 0., 1.);
     // }
 
     // if ( (fabs(jets_[1].eta()) > 0.9) && (fabs(jets_[1].eta()) < 1.9) ) {
-    //   plot1D("h_jet2chmneudiff_badeta"+suffix, stopt.pfjets_chm().at(jets_idx_.at(1)) - stopt.pfjets_neu().at(jets_idx_.at(1)) , evtweight, h_1d, 200, -50, 150);
-    //   plot1D("h_jet2tobtecmult_badeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) , evtweight, h_1d, 100, 0, 100);
-    //   plot1D("h_jet2tobtecmultfrac_badeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) / stopt.pfjets_chm().at(jets_idx_.at(1)) , evtweight, h_1d, 50, 0., 1.);
-    //   plot1D("h_jet2tobtecfrac_badeta"+suffix, stopt.pfjets_tobtecfrac().at(jets_idx_.at(1)) , evtweight, h_1d, 50, 0., 1.);
+    //   h.fill(WV_JET2CHMNEUDIFF_BADETA, cell, stopt.pfjets_chm().at(jets_idx_.at(1)) - stopt.pfjets_neu().at(jets_idx_.at(1)) , evtweight, 200, -50, 150);
+    //   h.fill(WV_JET2TOBTECMULT_BADETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) , evtweight, 100, 0, 100);
+    //   h.fill(WV_JET2TOBTECMULTFRAC_BADETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) / stopt.pfjets_chm().at(jets_idx_.at(1)) , evtweight, 50, 0., 1.);
+    //   h.fill(WV_JET2TOBTECFRAC_BADETA, cell, stopt.pfjets_tobtecfrac().at(jets_idx_.at(1)) , evtweight, 50, 0., 1.);
     // } else {
-    //   plot1D("h_jet2chmneudiff_goodeta"+suffix, stopt.pfjets_chm().at(jets_idx_.at(1)) - stopt.pfjets_neu().at(jets_idx_.at(1)) , evtweight, h_1d, 200, -50, 150);
-    //   plot1D("h_jet2tobtecmult_goodeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) , evtweight, h_1d, 100, 0, 100);
-    //   plot1D("h_jet2tobtecmultfrac_goodeta"+suffix, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) / stopt.pfjets_chm().at(jets_idx_.at(1)) , evtweight, h_1d, 50, 0., 1.);
-    //   plot1D("h_jet2tobtecfrac_goodeta"+suffix, stopt.pfjets_tobtecfrac().at(jets_idx_.at(1)) , evtweight, h_1d, 50, 0., 1.);
+    //   h.fill(WV_JET2CHMNEUDIFF_GOODETA, cell, stopt.pfjets_chm().at(jets_idx_.at(1)) - stopt.pfjets_neu().at(jets_idx_.at(1)) , evtweight, 200, -50, 150);
+    //   h.fill(WV_JET2TOBTECMULT_GOODETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) , evtweight, 100, 0, 100);
+    //   h.fill(WV_JET2TOBTECMULTFRAC_GOODETA, cell, stopt.pfjets_tobtecmult().at(jets_idx_.at(1)) / stopt.pfjets_chm().at(jets_idx_.at(1)) , evtweight, 50, 0., 1.);
+    //   h.fill(WV_JET2TOBTECFRAC_GOODETA, cell, stopt.pfjets_tobtecfrac().at(jets_idx_.at(1)) , evtweight, 50, 0., 1.);
     // }
 
     // if ( stopt.pfjets_beta2_0p5().at(jets_idx_.at(0)) < 0.2 ) {
-    //   plot1D("h_jet1pumva_lowbeta"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET1PUMVA_LOWBETA, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, 100, -1., 1.);
     // } else {
-    //   plot1D("h_jet1pumva_highbeta"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET1PUMVA_HIGHBETA, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, 100, -1., 1.);
     // }
 
     // if ( stopt.pfjets_beta2_0p5().at(jets_idx_.at(1)) < 0.2 ) {
-    //   plot1D("h_jet2pumva_lowbeta"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET2PUMVA_LOWBETA, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, 100, -1., 1.);
     // } else {
-    //   plot1D("h_jet2pumva_highbeta"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET2PUMVA_HIGHBETA, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, 100, -1., 1.);
     // }
 
     // if ( fabs(jets_[0].eta()) < 2.5 ) {
-    //   plot1D("h_jet1pumva_central"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET1PUMVA_CENTRAL, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, 100, -1., 1.);
     // } else {
-    //   plot1D("h_jet1pumva_forward"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET1PUMVA_FORWARD, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(0)) , evtweight, 100, -1., 1.);
     // }
 
     // if ( fabs(jets_[1].eta()) < 2.5 ) {
-    //   plot1D("h_jet2pumva_central"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET2PUMVA_CENTRAL, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, 100, -1., 1.);
     // } else {
-    //   plot1D("h_jet2pumva_forward"+suffix, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+    //   h.fill(WV_JET2PUMVA_FORWARD, cell, stopt.pfjets_mva5xPUid().at(jets_idx_.at(1)) , evtweight, 100, -1., 1.);
     // }
 
     // need V00-02-20 or higher babies for these vars
-    plot1D("h_jet1flavor"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, h_1d, 23, -1., 22.);
-    plot1D("h_jet2flavor"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, h_1d, 23, -1., 22.);
+    h.fill(WV_JET1FLAVOR, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(0))) , evtweight, 23, -1., 22.);
+    h.fill(WV_JET2FLAVOR, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(1))) , evtweight, 23, -1., 22.);
 
     // plots for 3rd, 4th jet
     if (njets_ >= 3) {
-      plot1D("h_jet3pt"+suffix,       jets_[2].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_jet3eta"+suffix,      jets_[2].eta(),      evtweight, h_1d, 100, -3., 3.);
+      h.fill(WV_JET3PT, cell,       jets_[2].pt(),       evtweight, 1000, 0., 1000.);
+      h.fill(WV_JET3ETA, cell,      jets_[2].eta(),      evtweight, 100, -3., 3.);
       if (njets_ >= 4) {
-	plot1D("h_jet4pt"+suffix,       jets_[3].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-	plot1D("h_jet4eta"+suffix,      jets_[3].eta(),      evtweight, h_1d, 100, -3., 3.);
+	h.fill(WV_JET4PT, cell,       jets_[3].pt(),       evtweight, 1000, 0., 1000.);
+	h.fill(WV_JET4ETA, cell,      jets_[3].eta(),      evtweight, 100, -3., 3.);
       }
     }
 
@@ -4603,14 +1731,14 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
   } // central jets
 
   if (jets_fwd_.size() > 0) {
-    plot1D("h_fwdjet1pt"+suffix,       jets_fwd_[0].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_fwdjet1eta"+suffix,      jets_fwd_[0].eta(),      evtweight, h_1d, 200, -6., 6.);
-    plot1D("h_fwdjet1pumva"+suffix, stopt.pfjets_mva5xPUid().at(jets_fwd_idx_.at(0)) , evtweight, h_1d, 100, -1., 1.);
+    h.fill(WV_FWDJET1PT, cell,       jets_fwd_[0].pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_FWDJET1ETA, cell,      jets_fwd_[0].eta(),      evtweight, 200, -6., 6.);
+    h.fill(WV_FWDJET1PUMVA, cell, stopt.pfjets_mva5xPUid().at(jets_fwd_idx_.at(0)) , evtweight, 100, -1., 1.);
 
     if (jets_fwd_.size() > 1) {
-      plot1D("h_fwdjet2pt"+suffix,       jets_fwd_[1].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_fwdjet2eta"+suffix,      jets_fwd_[1].eta(),      evtweight, h_1d, 200, -6., 6.);
-      plot1D("h_fwdjet2pumva"+suffix, stopt.pfjets_mva5xPUid().at(jets_fwd_idx_.at(1)) , evtweight, h_1d, 100, -1., 1.);
+      h.fill(WV_FWDJET2PT, cell,       jets_fwd_[1].pt(),       evtweight, 1000, 0., 1000.);
+      h.fill(WV_FWDJET2ETA, cell,      jets_fwd_[1].eta(),      evtweight, 200, -6., 6.);
+      h.fill(WV_FWDJET2PUMVA, cell, stopt.pfjets_mva5xPUid().at(jets_fwd_idx_.at(1)) , evtweight, 100, -1., 1.);
     }
   } // fwd jets
 
@@ -4618,47 +1746,47 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
 
   // }
 
-  plot1D("h_nvtx",      stopt.nvtx(),       evtweight, h_1d, 40, 0, 40);
-  plot1D("h_vtxweight", stopt.nvtxweight(), evtweight, h_1d, 41, -4., 4.);
-  plot1D("h_rhovor",    stopt.rhovor(),     evtweight, h_1d, 500, 0, 50);
+  h.fill(WV_NVTX, SUF_NONE,      stopt.nvtx(),       evtweight, 40, 0, 40);
+  h.fill(WV_VTXWEIGHT, SUF_NONE, stopt.nvtxweight(), evtweight, 41, -4., 4.);
+  h.fill(WV_RHOVOR, SUF_NONE,    stopt.rhovor(),     evtweight, 500, 0, 50);
 
 
   // plots for CR7 (high mass + 3 jets)
-  if (dir.find("cr7") != std::string::npos) {
+  if (rh.cr7) {
     if (njets_ >= 3) {
-      plot1D("h_jet3pt"+suffix,       jets_[2].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_jet3eta"+suffix,      jets_[2].eta(),      evtweight, h_1d, 100, -3., 3.);
-      plot1D("h_jet3csv"+suffix,      jets_csv_.at(2),      evtweight, h_1d, 100, 0., 1.);
-      plot1D("h_jet3flavor"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(2))) , evtweight, h_1d, 23, -1., 22.);
+      h.fill(WV_JET3PT, cell,       jets_[2].pt(),       evtweight, 1000, 0., 1000.);
+      h.fill(WV_JET3ETA, cell,      jets_[2].eta(),      evtweight, 100, -3., 3.);
+      h.fill(WV_JET3CSV, cell,      jets_csv_.at(2),      evtweight, 100, 0., 1.);
+      h.fill(WV_JET3FLAVOR, cell, abs(stopt.pfjets_mcflavorAlgo().at(jets_idx_.at(2))) , evtweight, 23, -1., 22.);
       if (nbjets_ >= 3) {
-	plot1D("h_bjet3pt"+suffix,       bjets_[2].pt(),       evtweight, h_1d, 1000, 0., 1000.);
-	plot1D("h_bjet3eta"+suffix,       bjets_[2].eta(),       evtweight, h_1d, 100, -3., 3.);
-        plot1D("h_bjet3flavor"+suffix, abs(stopt.pfjets_mcflavorAlgo().at(bjets_idx_.at(2))) , evtweight, h_1d, 23, -1., 22.);
+	h.fill(WV_BJET3PT, cell,       bjets_[2].pt(),       evtweight, 1000, 0., 1000.);
+	h.fill(WV_BJET3ETA, cell,       bjets_[2].eta(),       evtweight, 100, -3., 3.);
+        h.fill(WV_BJET3FLAVOR, cell, abs(stopt.pfjets_mcflavorAlgo().at(bjets_idx_.at(2))) , evtweight, 23, -1., 22.);
       }
     }
   }
 
   // ttbar plots
   if (isttsl_ || isttdl_) {
-    plot1D("h_gentpt"+suffix,     stopt.ptt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_gentbarpt"+suffix,     stopt.pttbar(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_genttbarpt"+suffix,     stopt.ptttbar(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_topptweight"+suffix,     TopPtWeight(stopt.ptt()),       1., h_1d, 100, 0., 2.);
+    h.fill(WV_GENTPT, cell,     stopt.ptt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_GENTBARPT, cell,     stopt.pttbar(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_GENTTBARPT, cell,     stopt.ptttbar(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_TOPPTWEIGHT, cell,     TopPtWeight(stopt.ptt()),       1., 100, 0., 2.);
   }
 
   // gen mt2bl plot
   if (isttsl_ || isttdl_ || (isWjets_ && stopt.genbs().size() >= 2)) {
     // use lep1 for genmt (and MT2bl) for tt2l..
-    plot1D("h_genmt2bl"+suffix,     genmt2bl_,       evtweight, h_1d, 1000, 0., 1000.);
+    h.fill(WV_GENMT2BL, cell,     genmt2bl_,       evtweight, 1000, 0., 1000.);
   }
 
   // gen level mt plots
   if (isttsl_ || isttdl_ || istsl_ || istdl_ || isWjets_) {
-    plot1D("h_genmtgenmet"+suffix,     getMT( stopt.mclep1().pt() , stopt.mclep1().phi() , stopt.genmet(), stopt.genmetphi() ),  evtweight, h_1d, 1000, 0., 1000.);
+    h.fill(WV_GENMTGENMET, cell,     getMT( stopt.mclep1().pt() , stopt.mclep1().phi() , stopt.genmet(), stopt.genmetphi() ),  evtweight, 1000, 0., 1000.);
     // single lepton backgrounds: mt(lep,nu)
     if (isttsl_ || istsl_ || isWjets_) {
-      plot1D("h_genmtln"+suffix,     stopt.mcmtln(),       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_genmln"+suffix,     stopt.mcmln(),       evtweight, h_1d, 1000, 0., 1000.);
+      h.fill(WV_GENMTLN, cell,     stopt.mcmtln(),       evtweight, 1000, 0., 1000.);
+      h.fill(WV_GENMLN, cell,     stopt.mcmln(),       evtweight, 1000, 0., 1000.);
     }
   }
 
@@ -4691,8 +1819,8 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
 
   //     // draw pt, eta distributions for gen jets with pt > 25 that aren't selected at reco level
 
-  //     plot1D("h_nonreco_genjetpt"+suffix, stopt.genjets()[i].pt(), evtweight, h_1d, 500, 0., 500.);
-  //     plot1D("h_nonreco_genjeteta"+suffix,      stopt.genjets()[i].eta(),      evtweight, h_1d, 100, -3., 3.);
+  //     h.fill(WV_NONRECO_GENJETPT, cell, stopt.genjets()[i].pt(), evtweight, 500, 0., 500.);
+  //     h.fill(WV_NONRECO_GENJETETA, cell,      stopt.genjets()[i].eta(),      evtweight, 100, -3., 3.);
 
   //     if (stopt.genjets()[i].pt() < 30.) ++njets_outsidept;
   //     if (fabs(stopt.genjets()[i].eta()) > 4.7) ++njets_outsideeta;
@@ -4704,10 +1832,10 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
   //     }
 
   //   }
-  //   plot1D("h_ngenjets_outsidept"+suffix, njets_outsidept, evtweight, h_1d, 5, 0., 5.);
-  //   plot1D("h_ngenjets_outsideeta"+suffix, njets_outsideeta, evtweight, h_1d, 5, 0., 5.);
-  //   plot1D("h_ngenjets_outsidepteta"+suffix, njets_outsidepteta, evtweight, h_1d, 5, 0., 5.);
-  //   plot1D("h_nmissedgenjets"+suffix, ngenjets - njets_lepolap - njets_outsidepteta, evtweight, h_1d, 5, 0., 5.);
+  //   h.fill(WV_NGENJETS_OUTSIDEPT, cell, njets_outsidept, evtweight, 5, 0., 5.);
+  //   h.fill(WV_NGENJETS_OUTSIDEETA, cell, njets_outsideeta, evtweight, 5, 0., 5.);
+  //   h.fill(WV_NGENJETS_OUTSIDEPTETA, cell, njets_outsidepteta, evtweight, 5, 0., 5.);
+  //   h.fill(WV_NMISSEDGENJETS, cell, ngenjets - njets_lepolap - njets_outsidepteta, evtweight, 5, 0., 5.);
 
 
   //   int nqgs_outsidept = 0;
@@ -4718,50 +1846,50 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
   //     if (fabs(stopt.genqgs()[i].eta()) > 4.7) ++nqgs_outsideeta;
   //     if ((stopt.genqgs()[i].pt() < 30.) || (fabs(stopt.genqgs()[i].eta()) > 4.7) )  ++nqgs_outsidepteta;
   //   }
-  //   plot1D("h_ngenqgs_outsidept"+suffix, nqgs_outsidept, evtweight, h_1d, 5, 0., 5.);
-  //   plot1D("h_ngenqgs_outsideeta"+suffix, nqgs_outsideeta, evtweight, h_1d, 5, 0., 5.);
-  //   plot1D("h_ngenqgs_outsidepteta"+suffix, nqgs_outsidepteta, evtweight, h_1d, 5, 0., 5.);
+  //   h.fill(WV_NGENQGS_OUTSIDEPT, cell, nqgs_outsidept, evtweight, 5, 0., 5.);
+  //   h.fill(WV_NGENQGS_OUTSIDEETA, cell, nqgs_outsideeta, evtweight, 5, 0., 5.);
+  //   h.fill(WV_NGENQGS_OUTSIDEPTETA, cell, nqgs_outsidepteta, evtweight, 5, 0., 5.);
 
   // }
 
   // // require babies V27 or higher
-  // plot1D("h_mht15"+suffix,          stopt.mht15(),    evtweight, h_1d, 500, 0., 500.);
-  // plot1D("h_trkmet_mht15"+suffix,          stopt.trkmet_mht15(),    evtweight, h_1d, 500, 0., 500.);
-  // plot1D("h_mettlj15"+suffix,          stopt.mettlj15(),    evtweight, h_1d, 500, 0., 500.);
-  // plot1D("h_mttlj15"+suffix, getMT(stopt.lep1().pt(),stopt.lep1().phi(),stopt.mettlj15(),stopt.mettlj15phi()),    evtweight, h_1d, 1000, 0., 1000.);
+  // h.fill(WV_MHT15, cell,          stopt.mht15(),    evtweight, 500, 0., 500.);
+  // h.fill(WV_TRKMET_MHT15, cell,          stopt.trkmet_mht15(),    evtweight, 500, 0., 500.);
+  // h.fill(WV_METTLJ15, cell,          stopt.mettlj15(),    evtweight, 500, 0., 500.);
+  // h.fill(WV_MTTLJ15, cell, getMT(stopt.lep1().pt(),stopt.lep1().phi(),stopt.mettlj15(),stopt.mettlj15phi()),    evtweight, 1000, 0., 1000.);
 
   // plot true pt of W, Higgs
   if (isTChiwh_) {
     LorentzVector genw = stopt.mclep() + stopt.mcnu();
-    plot1D("h_genwpt"+suffix,       genw.pt(),       evtweight, h_1d, 1000, 0., 1000.);
+    h.fill(WV_GENWPT, cell,       genw.pt(),       evtweight, 1000, 0., 1000.);
     if (stopt.genbs().size() == 2) {
       LorentzVector genh = stopt.genbs().at(0) + stopt.genbs().at(1);
-      plot1D("h_genhpt"+suffix,       genh.pt(),       evtweight, h_1d, 1000, 0., 1000.);
+      h.fill(WV_GENHPT, cell,       genh.pt(),       evtweight, 1000, 0., 1000.);
     }
   }
 
   if (isTChiwh_ && isScan_) {
-    plot1D("h_mg"+suffix,       stopt.mg(),       evtweight, h_1d, 21, 0., 525);
-    plot1D("h_ml"+suffix,       stopt.ml(),       evtweight, h_1d, 21, 0., 525);
+    h.fill(WV_MG, cell,       stopt.mg(),       evtweight, 21, 0., 525);
+    h.fill(WV_ML, cell,       stopt.ml(),       evtweight, 21, 0., 525);
   }
 
   if (isTChihhwwbb_) {
-    plot1D("h_mg"+suffix,       stopt.mg(),       evtweight, h_1d, 500, 0., 500.);
+    h.fill(WV_MG, cell,       stopt.mg(),       evtweight, 500, 0., 500.);
   }
 
   if (isWino_ || isTChiWHMG_) {
     float initstate_pt = (stopt.genc1() + stopt.genn2()).pt();
-    plot1D("h_initstatept"+suffix,       initstate_pt,       evtweight, h_1d, 1000, 0., 1000.);
+    h.fill(WV_INITSTATEPT, cell,       initstate_pt,       evtweight, 1000, 0., 1000.);
   }
 
-  if (doJetAccPlots && (njetsall_ == 2)) fillJetAccHists(h_1d,evtweight,dir,suffix);
+  if (doJetAccPlots && (njetsall_ == 2)) fillJetAccHists(h,cell,evtweight);
 
   if (doEvalBDT) {
-    plot1D("h_bdt0"+suffix,       bdtvals_.at(0),       evtweight, h_1d, 200, -1., 1.);
-    plot1D("h_bdt1"+suffix,       bdtvals_.at(1),       evtweight, h_1d, 200, -1., 1.);
-    plot1D("h_bdt2"+suffix,       bdtvals_.at(2),       evtweight, h_1d, 200, -1., 1.);
-    // plot1D("h_bdt3"+suffix,       bdtvals_.at(3),       evtweight, h_1d, 200, -1., 1.);
-    // plot1D("h_bdt4"+suffix,       bdtvals_.at(4),       evtweight, h_1d, 200, -1., 1.);
+    h.fill(WV_BDT0, cell,       bdtvals_.at(0),       evtweight, 200, -1., 1.);
+    h.fill(WV_BDT1, cell,       bdtvals_.at(1),       evtweight, 200, -1., 1.);
+    h.fill(WV_BDT2, cell,       bdtvals_.at(2),       evtweight, 200, -1., 1.);
+    // h.fill(WV_BDT3, cell,       bdtvals_.at(3),       evtweight, 200, -1., 1.);
+    // h.fill(WV_BDT4, cell,       bdtvals_.at(4),       evtweight, 200, -1., 1.);
   }
 
   return;
@@ -4770,13 +1898,13 @@ void WHLooper::fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtwe
 //--------------------------------------------------------------------
 // hists to fill separate versions based on lepton flavor
 
-void WHLooper::fillFlavorHists1D(std::map<std::string, TH1F*>& h_1d, const float evtweight, const std::string& dir, const std::string& suffix) {
+void WHLooper::fillFlavorHists1D(const RegionHists& rh, int cell, const float evtweight) {
 
-  outfile_->cd(dir.c_str());
+  HistoGrid& h = *rh.grid;
 
   // events histogram: bin 1: raw, bin 2: weighted
-  plot1D("h_events"+suffix,       0.5,       1., h_1d, 2, 0., 2.);
-  plot1D("h_events"+suffix,       1.5,       evtweight, h_1d, 2, 0., 2.);
+  h.fill(WV_EVENTS, cell,       0.5,       1., 2, 0., 2.);
+  h.fill(WV_EVENTS, cell,       1.5,       evtweight, 2, 0., 2.);
 
   TVector2 lep(stopt.lep1().px(),stopt.lep1().py());
   TVector2 met;
@@ -4790,72 +1918,72 @@ void WHLooper::fillFlavorHists1D(std::map<std::string, TH1F*>& h_1d, const float
   for (unsigned int i = 0; i < jets_.size(); ++i) {
     ljets += jets_.at(i);
   }
-  plot1D("h_ljetspt"+suffix,  ljets.pt(),    evtweight, h_1d, 500, 0., 500.);
-
-  plot1D("h_lep1pt"+suffix,       stopt.lep1().pt(),       evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_lep1eta"+suffix,      stopt.lep1().eta(),       evtweight, h_1d, 100, -3., 3.);
-  plot1D("h_lep1mt"+suffix,       mt_,       evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_lep1isopf"+suffix,    stopt.isopf1(),       evtweight, h_1d, 100, 0., 0.5);
-  plot1D("h_met"+suffix,          met_,    evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_sumet"+suffix,        sumet_,   evtweight, h_1d, 3000, 0., 3000.);
-  plot1D("h_sumet_soft"+suffix,   sumet_soft_,   evtweight, h_1d, 3000, 0., 3000.);
-  plot1D("h_ht"+suffix,           ht_,   evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_htlep"+suffix,        ht_ + stopt.lep1().pt(),   evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_metsig"+suffix,       met_/sqrt(sumet_),   evtweight, h_1d, 500, 0., 25.);
-  //  plot1D("h_metsignif"+suffix,    stopt.pfmetsignif(),    evtweight, h_1d, 500, 0., 500.);
-  plot1D("h_pfmet"+suffix,        stopt.pfmet(),    evtweight, h_1d, 500, 0., 500.);
-  plot1D("h_t1met10"+suffix,      stopt.t1met10(),    evtweight, h_1d, 500, 0., 500.);
-  plot1D("h_trkmet"+suffix,       stopt.trkmet(),    evtweight, h_1d, 500, 0., 500.);
-  plot1D("h_met_soft"+suffix,     met_soft_,    evtweight, h_1d, 500, 0., 500.);
-  plot1D("h_genmet"+suffix,       stopt.genmet(),    evtweight, h_1d, 500, 0., 500.);
-  // plot1D("h_genmet_minus_pfmet"+suffix,       stopt.genmet() - met_,    evtweight, h_1d, 500, -250., 250.);
-  // plot1D("h_genmet_minus_pfmet_div_genmet"+suffix,       (stopt.genmet() - met_)/stopt.genmet(),    evtweight, h_1d, 500, -5.0, 5.0);
-  // plot1D("h_pfsumet"+suffix,      stopt.pfsumet(),    evtweight, h_1d, 1500, 0., 1500.);
-  // plot1D("h_pfmetsig"+suffix,     stopt.pfmet()/sqrt(stopt.pfsumet()),   evtweight, h_1d, 500, 0., 20.);
-  plot1D("h_ngoodlep"+suffix,       stopt.ngoodlep(),    evtweight, h_1d, 5, 0., 5.);
-  plot1D("h_wpt"+suffix,          wpt_,       evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_lep1metdphi"+suffix,  lepmetdphi_,  evtweight, h_1d, 50, 0., TMath::Pi());
-
-  plot1D("h_mt2b"+suffix,   mt2b_,  evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_mt2bl"+suffix,  mt2bl_, evtweight, h_1d, 1000, 0., 1000.);
-  plot1D("h_mt2w"+suffix,   mt2w_,  evtweight, h_1d, 1000, 0., 1000.);
-
-  plot1D("h_mct"+suffix,  mct_, evtweight, h_1d, 1000, 0., 1000.);
+  h.fill(WV_LJETSPT, cell,  ljets.pt(),    evtweight, 500, 0., 500.);
+
+  h.fill(WV_LEP1PT, cell,       stopt.lep1().pt(),       evtweight, 1000, 0., 1000.);
+  h.fill(WV_LEP1ETA, cell,      stopt.lep1().eta(),       evtweight, 100, -3., 3.);
+  h.fill(WV_LEP1MT, cell,       mt_,       evtweight, 1000, 0., 1000.);
+  h.fill(WV_LEP1ISOPF, cell,    stopt.isopf1(),       evtweight, 100, 0., 0.5);
+  h.fill(WV_MET, cell,          met_,    evtweight, 1000, 0., 1000.);
+  h.fill(WV_SUMET, cell,        sumet_,   evtweight, 3000, 0., 3000.);
+  h.fill(WV_SUMET_SOFT, cell,   sumet_soft_,   evtweight, 3000, 0., 3000.);
+  h.fill(WV_HT, cell,           ht_,   evtweight, 1000, 0., 1000.);
+  h.fill(WV_HTLEP, cell,        ht_ + stopt.lep1().pt(),   evtweight, 1000, 0., 1000.);
+  h.fill(WV_METSIG, cell,       met_/sqrt(sumet_),   evtweight, 500, 0., 25.);
+  //  h.fill(WV_METSIGNIF, cell,    stopt.pfmetsignif(),    evtweight, 500, 0., 500.);
+  h.fill(WV_PFMET, cell,        stopt.pfmet(),    evtweight, 500, 0., 500.);
+  h.fill(WV_T1MET10, cell,      stopt.t1met10(),    evtweight, 500, 0., 500.);
+  h.fill(WV_TRKMET, cell,       stopt.trkmet(),    evtweight, 500, 0., 500.);
+  h.fill(WV_MET_SOFT, cell,     met_soft_,    evtweight, 500, 0., 500.);
+  h.fill(WV_GENMET, cell,       stopt.genmet(),    evtweight, 500, 0., 500.);
+  // h.fill(WV_GENMET_MINUS_PFMET, cell,       stopt.genmet() - met_,    evtweight, 500, -250., 250.);
+  // h.fill(WV_GENMET_MINUS_PFMET_DIV_GENMET, cell,       (stopt.genmet() - met_)/stopt.genmet(),    evtweight, 500, -5.0, 5.0);
+  // h.fill(WV_PFSUMET, cell,      stopt.pfsumet(),    evtweight, 1500, 0., 1500.);
+  // h.fill(WV_PFMETSIG, cell,     stopt.pfmet()/sqrt(stopt.pfsumet()),   evtweight, 500, 0., 20.);
+  h.fill(WV_NGOODLEP, cell,       stopt.ngoodlep(),    evtweight, 5, 0., 5.);
+  h.fill(WV_WPT, cell,          wpt_,       evtweight, 1000, 0., 1000.);
+  h.fill(WV_LEP1METDPHI, cell,  lepmetdphi_,  evtweight, 50, 0., TMath::Pi());
+
+  h.fill(WV_MT2B, cell,   mt2b_,  evtweight, 1000, 0., 1000.);
+  h.fill(WV_MT2BL, cell,  mt2bl_, evtweight, 1000, 0., 1000.);
+  h.fill(WV_MT2W, cell,   mt2w_,  evtweight, 1000, 0., 1000.);
+
+  h.fill(WV_MCT, cell,  mct_, evtweight, 1000, 0., 1000.);
 
   if (stopt.ngoodlep() >= 2) {
-    plot1D("h_lep2id"+suffix,   abs(stopt.id2()),  evtweight, h_1d, 3, 11, 14);
+    h.fill(WV_LEP2ID, cell,   abs(stopt.id2()),  evtweight, 3, 11, 14);
   }
 
   // // plots for CR3/CR4 (2 leptons)
   // if ((dir.find("cr3") != std::string::npos) || (dir.find("cr4") != std::string::npos)) {
-  //   plot1D("h_leppt"+suffix,       lep_.pt(),       evtweight, h_1d, 1000, 0., 1000.);
-  //   plot1D("h_pseudomt_lep"+suffix,       pseudomt_lep_,       evtweight, h_1d, 1000, 0., 1000.);
-  //   plot1D("h_pseudomet_lep"+suffix,        pseudomet_lep_,    evtweight, h_1d, 500, 0., 500.);
-  //   plot1D("h_dphi_pseudomet_lep"+suffix,  fabs(dphi_pseudomet_lep_),  evtweight, h_1d, 50, 0., TMath::Pi());
-  //   plot1D("h_pseudomt2b"+suffix,   pseudomt2b_,  evtweight, h_1d, 1000, 0., 1000.);
-  //   plot1D("h_pseudomt2bl"+suffix,  pseudomt2bl_, evtweight, h_1d, 1000, 0., 1000.);
-  //   plot1D("h_pseudomt2w"+suffix,   pseudomt2w_,  evtweight, h_1d, 1000, 0., 1000.);
+  //   h.fill(WV_LEPPT, cell,       lep_.pt(),       evtweight, 1000, 0., 1000.);
+  //   h.fill(WV_PSEUDOMT_LEP, cell,       pseudomt_lep_,       evtweight, 1000, 0., 1000.);
+  //   h.fill(WV_PSEUDOMET_LEP, cell,        pseudomet_lep_,    evtweight, 500, 0., 500.);
+  //   h.fill(WV_DPHI_PSEUDOMET_LEP, cell,  fabs(dphi_pseudomet_lep_),  evtweight, 50, 0., TMath::Pi());
+  //   h.fill(WV_PSEUDOMT2B, cell,   pseudomt2b_,  evtweight, 1000, 0., 1000.);
+  //   h.fill(WV_PSEUDOMT2BL, cell,  pseudomt2bl_, evtweight, 1000, 0., 1000.);
+  //   h.fill(WV_PSEUDOMT2W, cell,   pseudomt2w_,  evtweight, 1000, 0., 1000.);
   // }
 
   // plots for CR2 (1 lepton + iso track/pfcand)
-  if (dir.find("cr2") != std::string::npos) {
-    plot1D("h_isotrkpt"+suffix,       stopt.pfcandOS10looseZ().pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_isotrketa"+suffix,      stopt.pfcandOS10looseZ().eta(),       evtweight, h_1d, 100, -3., 3.);
-    plot1D("h_lep1isotrkdphi"+suffix,  fabs(TVector2::Phi_mpi_pi(stopt.lep1().phi() - stopt.pfcandOS10looseZ().phi())),  evtweight, h_1d, 50, 0., TMath::Pi());
+  if (rh.cr2) {
+    h.fill(WV_ISOTRKPT, cell,       stopt.pfcandOS10looseZ().pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_ISOTRKETA, cell,      stopt.pfcandOS10looseZ().eta(),       evtweight, 100, -3., 3.);
+    h.fill(WV_LEP1ISOTRKDPHI, cell,  fabs(TVector2::Phi_mpi_pi(stopt.lep1().phi() - stopt.pfcandOS10looseZ().phi())),  evtweight, 50, 0., TMath::Pi());
     if (stopt.pfcandpt5looseZ()  <9998.) {
-      plot1D("h_lepcandpt"+suffix,       stopt.pfcand5looseZ().pt(),       evtweight, h_1d, 1000, 0., 1000.);
-      plot1D("h_lepcandeta"+suffix,      stopt.pfcand5looseZ().eta(),       evtweight, h_1d, 100, -3., 3.);
-      plot1D("h_lep1lepcanddphi"+suffix,  fabs(TVector2::Phi_mpi_pi(stopt.lep1().phi() - stopt.pfcand5looseZ().phi())),  evtweight, h_1d, 50, 0., TMath::Pi());
+      h.fill(WV_LEPCANDPT, cell,       stopt.pfcand5looseZ().pt(),       evtweight, 1000, 0., 1000.);
+      h.fill(WV_LEPCANDETA, cell,      stopt.pfcand5looseZ().eta(),       evtweight, 100, -3., 3.);
+      h.fill(WV_LEP1LEPCANDDPHI, cell,  fabs(TVector2::Phi_mpi_pi(stopt.lep1().phi() - stopt.pfcand5looseZ().phi())),  evtweight, 50, 0., TMath::Pi());
     }
   }
 
   // plots for 2 lep events (large overlap with cr3 above, obviously)
   if (stopt.ngoodlep() >= 2) {
-    plot1D("h_lep2pt"+suffix,       stopt.lep2().pt(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_lep2eta"+suffix,      stopt.lep2().eta(),       evtweight, h_1d, 100, -3., 3.);
-    plot1D("h_dildphi"+suffix,  fabs(TVector2::Phi_mpi_pi(stopt.lep1().phi() - stopt.lep2().phi())),  evtweight, h_1d, 50, 0., TMath::Pi());
-    plot1D("h_dilmass"+suffix,       stopt.dilmass(),       evtweight, h_1d, 1000, 0., 1000.);
-    plot1D("h_dilpt"+suffix,       stopt.dilpt(),       evtweight, h_1d, 1000, 0., 1000.);
+    h.fill(WV_LEP2PT, cell,       stopt.lep2().pt(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_LEP2ETA, cell,      stopt.lep2().eta(),       evtweight, 100, -3., 3.);
+    h.fill(WV_DILDPHI, cell,  fabs(TVector2::Phi_mpi_pi(stopt.lep1().phi() - stopt.lep2().phi())),  evtweight, 50, 0., TMath::Pi());
+    h.fill(WV_DILMASS, cell,       stopt.dilmass(),       evtweight, 1000, 0., 1000.);
+    h.fill(WV_DILPT, cell,       stopt.dilpt(),       evtweight, 1000, 0., 1000.);
   }
 
   return;
@@ -4876,7 +2004,7 @@ void WHLooper::fillHists2D(std::map<std::string, TH2F*>& h_2d, const float evtwe
 
 //--------------------------------------------------------------------
 
-void WHLooper::fillJetAccHists(std::map<std::string, TH1F*>& h_1d, const float evtweight, const std::string& dir, const std::string& suffix) {
+void WHLooper::fillJetAccHists(HistoGrid& h, int cell, const float evtweight) {
 
   int nptacc = 0;
   int netaacc = 0;
@@ -4966,7 +2094,7 @@ void WHLooper::fillJetAccHists(std::map<std::string, TH1F*>& h_1d, const float e
 	  // check for resolution effects: (genjet pt - reco pt)/sigma, using jet sigma
 	  float pterr = stopt.pfjets_sigma().at(ijet) * stopt.pfjets().at(ijet).pt();
 	  float sigmadiff = (stopt.genjets().at(igen).pt() - stopt.pfjets().at(ijet).pt()) / pterr;
-	  plot1D("h_jetsigmadiff"+suffix,      sigmadiff,    evtweight, h_1d, 100, -6., 6.);
+	  h.fill(WV_JETSIGMADIFF, cell,      sigmadiff,    evtweight, 100, -6., 6.);
 
 	  if ( fabs(sigmadiff) > 2.0 ) {
 	    ++nrestails;
@@ -5013,21 +2141,23 @@ void WHLooper::fillJetAccHists(std::map<std::string, TH1F*>& h_1d, const float e
 
   enum lostjet { PTACC = 0, ETAACC = 1, LEPOLAP = 2, JETID = 3, PUMEDID = 4, PUTIGHTID = 5, RESCORE = 6, RESTAILS = 7, NORECOUNDER30 = 8, NORECO = 9, MERGED = 10 };
 
-  TH1F* h_lostjets = getHist1D("h_lostjets"+suffix, h_1d, 11, 0., 11.);
-  if (nptacc) h_lostjets->Fill(PTACC,evtweight*nptacc);
-  if (netaacc) h_lostjets->Fill(ETAACC,evtweight*netaacc);
-  if (nlepolap) h_lostjets->Fill(LEPOLAP,evtweight*nlepolap);
-  if (njetid) h_lostjets->Fill(JETID,evtweight*njetid);
-  if (npumedid) h_lostjets->Fill(PUMEDID,evtweight*npumedid);
-  if (nputightid) h_lostjets->Fill(PUTIGHTID,evtweight*nputightid);
-  if (nrescore) h_lostjets->Fill(RESCORE,evtweight*nrescore);
-  if (nrestails) h_lostjets->Fill(RESTAILS,evtweight*nrestails);
-  if (nnorecounder30) h_lostjets->Fill(NORECOUNDER30,evtweight*nnorecounder30);
-  if (nnoreco) h_lostjets->Fill(NORECO,evtweight*nnoreco);
-  if (nmerged) h_lostjets->Fill(MERGED,evtweight*nmerged);
+  TH1F* h_lostjets = h.get(WV_LOSTJETS, cell, 11, 0., 11.);
+  if (h_lostjets) {
+    if (nptacc) h_lostjets->Fill(PTACC,evtweight*nptacc);
+    if (netaacc) h_lostjets->Fill(ETAACC,evtweight*netaacc);
+    if (nlepolap) h_lostjets->Fill(LEPOLAP,evtweight*nlepolap);
+    if (njetid) h_lostjets->Fill(JETID,evtweight*njetid);
+    if (npumedid) h_lostjets->Fill(PUMEDID,evtweight*npumedid);
+    if (nputightid) h_lostjets->Fill(PUTIGHTID,evtweight*nputightid);
+    if (nrescore) h_lostjets->Fill(RESCORE,evtweight*nrescore);
+    if (nrestails) h_lostjets->Fill(RESTAILS,evtweight*nrestails);
+    if (nnorecounder30) h_lostjets->Fill(NORECOUNDER30,evtweight*nnorecounder30);
+    if (nnoreco) h_lostjets->Fill(NORECO,evtweight*nnoreco);
+    if (nmerged) h_lostjets->Fill(MERGED,evtweight*nmerged);
+  }
 
   if (nlepolap) {
-    plot1D("h_lepolapdr"+suffix,          lepolapdr,    evtweight, h_1d, 100, 0., 2.*TMath::Pi());
+    h.fill(WV_LEPOLAPDR, cell,          lepolapdr,    evtweight, 100, 0., 2.*TMath::Pi());
   }
 
   // this can happen from ISR jets added by pythia, etc. not necessarily useful
@@ -5059,6 +2189,37 @@ void WHLooper::dumpEventInfo(const std::string& comment) {
 
 //--------------------------------------------------------------------
 
+void WHLooper::calculatePseudoMET() {
+
+  //find positive lepton - this is the one that is combined with the pseudomet to form the mT
+  bool isfirstp = (stopt.id1() > 0) ? true : false;
+  lep_ = isfirstp ? stopt.lep1() : stopt.lep2();
+
+  //recalculate met
+  float metx = met_ * cos( metphi_ );
+  float mety = met_ * sin( metphi_ );
+
+  //recalculate the MET with the positive lepton
+  metx += isfirstp ? stopt.lep1().px() : stopt.lep2().px();
+  mety += isfirstp ? stopt.lep1().py() : stopt.lep2().py();
+
+  pseudomet_lep_    = sqrt(metx*metx + mety*mety);
+  pseudometphi_lep_ = atan2( mety , metx );
+
+  //recalculate the MT with the negative lepton
+  pseudomt_lep_ = getMT( lep_.pt() , lep_.phi() , pseudomet_lep_ , pseudometphi_lep_ );
+  //dphi between met and lepton
+  dphi_pseudomet_lep_ = TVector2::Phi_mpi_pi( lep_.phi() - pseudometphi_lep_ );
+
+  // recalculate mt2 vars also..
+  pseudomt2b_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2b);
+  pseudomt2bl_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2bl);
+  pseudomt2w_ = calculateMT2w(jets_, jets_csv_, lep_, pseudomet_lep_, pseudometphi_lep_, MT2w);
+
+}
+
+//--------------------------------------------------------------------
+
 float WHLooper::c1n2CrossSection( float c1mass ){
 
   int   bin  = c1n2_xsec_hist->FindBin(c1mass);
@@ -22,6 +22,8 @@
 
 using namespace std;
 
+class HistoGrid;
+
 class WHLooper {
 
  public:
@@ -33,43 +35,49 @@ class WHLooper {
   ~WHLooper();
 
   void setOutFileName(string filename); 
+  // regions, histogram groups and per-region variables, see README
+  void readConfig(const string& filename);
   void loop(TChain *chain, TString name);
 
  private:
 
-  void fillHists1DWrapper(std::map<std::string, TH1F*>& h_1d, const float evtweight = 1., const std::string& dir = "");
-  void fillHists1D(std::map<std::string, TH1F*>& h_1d, const float evtweight = 1., const std::string& dir = "", const std::string& suffix = "");
+  // histograms of a region, one grid cell per name suffix, and the plots its
+  //  name asks for; set up once per region by setupRegionHists
+  struct RegionHists {
+    HistoGrid* grid;
+    bool dilep; // cr3_, cr4_: ee, mm, em instead of e, m plots
+    bool inc;   // inc_: W+jets plots per number of gen b's
+    bool cr2;   // iso track plots
+    bool cr7;   // 3rd jet plots
+  };
+
+  // grid of the variables of the run config for that region
+  void setupRegionHists(RegionHists& rh, std::map<std::string, TH1F*>& h_1d, const std::string& dir);
+  void fillHists1DWrapper(const RegionHists& rh, const float evtweight = 1.);
+  // cell: the suffix; the no-suffix plots go to cell 0
+  void fillHists1D(const RegionHists& rh, int cell, const float evtweight = 1.);
   void fillHists2D(std::map<std::string, TH2F*>& h_2d, const float evtweight = 1., const std::string& dir = "", const std::string& suffix = "");
-  void fillFlavorHists1D(std::map<std::string, TH1F*>& h_1d, const float evtweight = 1., const std::string& dir = "", const std::string& suffix = "");
-  void fillJetAccHists(std::map<std::string, TH1F*>& h_1d, const float evtweight = 1., const std::string& dir = "", const std::string& suffix = "");
+  void fillFlavorHists1D(const RegionHists& rh, int cell, const float evtweight = 1.);
+  void fillJetAccHists(HistoGrid& h, int cell, const float evtweight = 1.);
 
   float getCSVCut(const csvpoint csv = WHLooper::CSVM);
   float c1n2CrossSection( float c1mass );
 
   void dumpEventInfo(const std::string& comment);
+  // pseudo met and mt etc of a dilepton event, emulating the loss of the 2nd lepton
+  void calculatePseudoMET();
 
   string m_outfilename_;
   TFile* outfile_;
+  // variable lists from the run config, sorted: per region and for all others
+  std::map<std::string, std::vector<std::string> > regionVars_;
+  std::vector<std::string> defaultVars_;
+  bool haveDefaultVars_;
   //for phi corrected met
   float t1metphicorr;
   float t1metphicorrphi;
   float t1metphicorrmt;
 
-  // store main cut values
-  float CUT_BBMASS_LOW_;
-  float CUT_BBMASS_HIGH_;
-  float CUT_BBMASS_CR1_LOW_;
-  float CUT_BBMASS_CR1_HIGH_;
-  float CUT_BBMASS_CR8_LOW_;
-  float CUT_BBMASS_CR8_HIGH_;
-  float CUT_MET_PRESEL_;
-  float CUT_MET_;
-  float CUT_MT_PRESEL_;
-  float CUT_MT_;
-  float CUT_MT_CR13_LOW_;
-  float CUT_MT_CR13_HIGH_;
-  float CUT_MT2BL_;
-
   // internal vars to store
   std::vector<LorentzVector> jets_;
   std::vector<LorentzVector> bjets_;
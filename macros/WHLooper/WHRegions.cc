@@ -0,0 +1,592 @@
+#include "WHRegions.h"
+
+#include "../Core/RegionSelector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+bool doNM1Plots = true;
+bool doMetBinRegions = false;
+
+bool doInclusive = true;
+bool doSignal = true;
+bool doSignalMassLast = true;
+bool doSignalMETLast = true;
+bool doCR5METLast = true;
+bool doCR5InvMass = true;
+bool doCR5MassLast = true;
+bool doCR14 = true;
+
+bool doCR1METLast = false;
+bool doCR23 = false;
+bool doCR23MassLast = false;
+bool doCR5HighMass = false;
+bool doCR5LowMass = false;
+bool doCR8METLast = false;
+
+bool doInclusiveMTTail = false;
+bool doSignal2Loose = false;
+bool doSignal1Med = false;
+bool doSignal1Med1Loose = false;
+bool doSignalSMWH = false;
+bool doCR1 = false;
+bool doCR2 = false;
+bool doCR3 = false;
+bool doCR4 = false;
+bool doCR5 = false;
+bool doCR5Loose = false;
+bool doCR6 = false;
+bool doCR6METLast = false;
+bool doCR7 = false;
+bool doCR8 = false;
+bool doCR9 = false;
+bool doCR10 = false;
+bool doCR11 = false;
+bool doCR12 = false;
+bool doCR13 = false;
+bool doStopSel = false;
+
+// cuts of the region selector, in the order of regionCutNames
+enum RegionCut { RC_LEP1, RC_ISOTRK, RC_NJETS2, RC_NB0, RC_NB1, RC_NB2,
+		 RC_BBWIN, RC_BBINV, RC_UNBLIND, RC_BBUNBLIND, RC_METPRESEL, RC_MTPRESEL,
+		 RC_NJ2, RC_MTPEAK, RC_MT, RC_MET, RC_MT2BL,
+		 RC_MET100, RC_MET125, RC_MET137, RC_MET150, RC_MET162, RC_MET175,
+		 RC_MET50TO75, RC_MET75TO100, RC_MET100TO125, RC_MET125TO150, RC_MET150TO175,
+		 RC_NBEQ1, RC_NBLEQ1, RC_NBL2, RC_NBT1,
+		 RC_BBCR1, RC_BBHIGH, RC_BBLOW, RC_BBCR8, RC_BBCR9, RC_BBCR10,
+		 RC_LEPISOTRK, RC_DILEP, RC_LEPISOTRKORDILEP, RC_ZVETO,
+		 RC_NJ3, RC_NJ4, RC_MET45, RC_SMWH, RC_MET500, RC_MTCR13,
+		 RC_MC, RC_NJETS4, RC_MET150GE, RC_MT120, RC_ISOTRKV4, RC_TAUVETO,
+		 NREGIONCUTS };
+
+const char* regionCutNames[NREGIONCUTS] = { "lep1", "isotrk", "njets2", "nb0", "nb1", "nb2",
+					    "bbwin", "bbinv", "unblind", "bbunblind", "metpresel", "mtpresel",
+					    "nj2", "mtpeak", "mt", "met", "mt2bl",
+					    "met100", "met125", "met137", "met150", "met162", "met175",
+					    "met50to75", "met75to100", "met100to125", "met125to150", "met150to175",
+					    "nbeq1", "nbleq1", "nbl2", "nbt1",
+					    "bbcr1", "bbhigh", "bblow", "bbcr8", "bbcr9", "bbcr10",
+					    "lepisotrk", "dilep", "lepisotrkordilep", "zveto",
+					    "nj3", "nj4", "met45", "smwh", "met500", "mtcr13",
+					    "mc", "njets4", "met150ge", "mt120", "isotrkv4", "tauveto" };
+
+//--------------------------------------------------------------------
+
+static void addRegion(RegionSelector& regions, std::vector<WHRegionInfo>& info, int g, const std::string& name,
+		      const std::string& cuts = "", bool nm1Only = false, WHRegionWeight weight = RW_1L) {
+  regions.addRegion(g, name, cuts);
+  WHRegionInfo ri = { weight, nm1Only, 1 };
+  info.push_back(ri);
+}
+
+// met cut last: mt2bl and mt n-1, then met > 100, 125, 150 and the final met cut,
+//  on top of the cuts m.  Some families filled mtfirst and met_nm1 without the
+//  n-1 plots (mtAlways), and their final region only with them (finalNM1Only).
+static void addMETLast(RegionSelector& regions, std::vector<WHRegionInfo>& info, int g, const std::string& d,
+		       const std::string& m, bool metBins, bool mtAlways, bool finalNM1Only) {
+  if (doNM1Plots) addRegion(regions, info, g, d + "mt2bl_nm1", m);
+  if (doNM1Plots || mtAlways) addRegion(regions, info, g, d + "mtfirst", m + ",mt");
+  if (doNM1Plots && metBins && doMetBinRegions) {
+    addRegion(regions, info, g, d + "nomt_met100", m + ",met100");
+    addRegion(regions, info, g, d + "nomt_met150", m + ",met150");
+    addRegion(regions, info, g, d + "nomt_met175", m + ",met175");
+  }
+  if (doNM1Plots) addRegion(regions, info, g, d + "mt_nm1", m + ",mt2bl");
+  if (doNM1Plots || mtAlways) addRegion(regions, info, g, d + "met_nm1", m + ",mt2bl,mt");
+  if (doNM1Plots) {
+    addRegion(regions, info, g, d + "met100", m + ",mt2bl,mt,met100");
+    addRegion(regions, info, g, d + "met125", m + ",mt2bl,mt,met100,met125");
+    addRegion(regions, info, g, d + "met150", m + ",mt2bl,mt,met100,met125,met150");
+  }
+  addRegion(regions, info, g, d + "final", m + ",mt2bl,mt,met100,met125,met150,met", finalNM1Only);
+}
+
+// m(bb) cut last: n-1 plots after each of the major cuts, then the met cuts
+//  and m(bb); all but the n-1 plots were filled without doNM1Plots
+static void addMassLast(RegionSelector& regions, std::vector<WHRegionInfo>& info, int g, const std::string& d,
+			bool met500) {
+  addRegion(regions, info, g, d + "presel");
+  if (doNM1Plots) {
+    addRegion(regions, info, g, d + "mt2bl_nm1", "nj2");
+    addRegion(regions, info, g, d + "mtpeak", "nj2,mtpeak");
+    addRegion(regions, info, g, d + "mtcut", "nj2,mt");
+    addRegion(regions, info, g, d + "mtcut_met100", "nj2,mt,met100");
+    addRegion(regions, info, g, d + "metcut", "nj2,met");
+    addRegion(regions, info, g, d + "mt_nm1", "nj2,mt2bl");
+  }
+  if (doMetBinRegions) {
+    addRegion(regions, info, g, d + "nomt_met50", "nj2,mt2bl,met50to75");
+    addRegion(regions, info, g, d + "nomt_met75", "nj2,mt2bl,met75to100");
+    addRegion(regions, info, g, d + "nomt_met100", "nj2,mt2bl,met100to125");
+    addRegion(regions, info, g, d + "nomt_met125", "nj2,mt2bl,met125to150");
+    addRegion(regions, info, g, d + "nomt_met137", "nj2,mt2bl,met137");
+    addRegion(regions, info, g, d + "nomt_met150", "nj2,mt2bl,met150to175");
+    addRegion(regions, info, g, d + "nomt_met162", "nj2,mt2bl,met162");
+    addRegion(regions, info, g, d + "nomt_met175", "nj2,mt2bl,met175");
+  }
+  if (doNM1Plots) addRegion(regions, info, g, d + "met_nm1", "nj2,mt2bl,mt");
+  addRegion(regions, info, g, d + "met100", "nj2,mt2bl,mt,met100");
+  addRegion(regions, info, g, d + "met125", "nj2,mt2bl,mt,met100,met125");
+  addRegion(regions, info, g, d + "met150", "nj2,mt2bl,mt,met100,met125,met150");
+  if (met500) addRegion(regions, info, g, d + "met500", "nj2,mt2bl,mt,met100,met125,met150,met500");
+  addRegion(regions, info, g, d + "bbmass_nm1", "nj2,mt2bl,mt,met100,met125,met150,met");
+  addRegion(regions, info, g, d + "final", "nj2,mt2bl,mt,met100,met125,met150,met,bbwin");
+}
+
+// met, mt and mt2bl cuts in turn after the jet cut nj
+static void addMETFirst(RegionSelector& regions, std::vector<WHRegionInfo>& info, int g, const std::string& d,
+			const std::string& nj) {
+  addRegion(regions, info, g, d + "presel");
+  if (doNM1Plots) {
+    addRegion(regions, info, g, d + "met_nm1", nj);
+    addRegion(regions, info, g, d + "mt_nm1", nj + ",met");
+    addRegion(regions, info, g, d + "mt2bl_nm1", nj + ",met,mt");
+  }
+  addRegion(regions, info, g, d + "final", nj + ",met,mt,mt2bl");
+}
+
+// as addMETFirst, with the mt peak before and after the met cut and mt2bl before mt
+static void addMTPeak(RegionSelector& regions, std::vector<WHRegionInfo>& info, int g, const std::string& d) {
+  addRegion(regions, info, g, d + "presel");
+  if (doNM1Plots) {
+    addRegion(regions, info, g, d + "met_nm1", "nj2");
+    addRegion(regions, info, g, d + "mtpeak_nomet", "nj2,mtpeak");
+    addRegion(regions, info, g, d + "mt_nm1", "nj2,met");
+    addRegion(regions, info, g, d + "mtpeak_met", "nj2,met,mtpeak");
+    addRegion(regions, info, g, d + "mtlast_mt2bl_nm1", "nj2,met,mt2bl");
+    addRegion(regions, info, g, d + "mt2bl_nm1", "nj2,met,mt");
+  }
+  addRegion(regions, info, g, d + "final", "nj2,met,mt,mt2bl");
+}
+
+void declareRegions(RegionSelector& regions, std::vector<WHRegionInfo>& info) {
+
+  for (int c = 0; c < NREGIONCUTS; ++c) regions.addCut(regionCutNames[c]);
+  info.clear();
+
+  // *** inclusive preselection:
+  //   >= 1 lepton, >= 2 (central) jets, met > 50, then add btags
+  if (doInclusive) {
+    int g = regions.addGroup("lep1,njets2,metpresel");
+    addRegion(regions, info, g, "inc_presel");
+    addRegion(regions, info, g, "inc_2j", "nj2");
+    if (doInclusiveMTTail) {
+      addRegion(regions, info, g, "inc_2j_mt", "nj2,mt");
+      addRegion(regions, info, g, "inc_2j_mt_met100", "nj2,mt,met100");
+      addRegion(regions, info, g, "inc_2j_mt_met150", "nj2,mt,met150");
+      addRegion(regions, info, g, "inc_2j_mt_metcut", "nj2,mt,met");
+    }
+    addRegion(regions, info, g, "inc_1b", "nb1");
+    addRegion(regions, info, g, "inc_2b", "nb1,nb2");
+  }
+
+  // *** signal region:
+  //   == 1 lepton, iso track veto, == 2 bjets, 100 < m(bb) < 150
+  //   == 2 jets, met > 175, mt > 100, mt2bl > 200
+  if (doSignal) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbwin,metpresel,mtpresel,unblind");
+    addRegion(regions, info, g, "sig_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "sig_met_nm1", "nj2");
+      addRegion(regions, info, g, "sig_mtpeak_nomet", "nj2,mtpeak");
+      addRegion(regions, info, g, "sig_mt_nm1", "nj2,met");
+      addRegion(regions, info, g, "sig_mtpeak_met", "nj2,met,mtpeak");
+      addRegion(regions, info, g, "sig_mt2bl_nm1", "nj2,met,mt");
+    }
+    addRegion(regions, info, g, "sig_final", "nj2,met,mt,mt2bl");
+  }
+
+  // *** signal region, but applying m(bb) cut last
+  //  in data, the mass window is removed so we can compare the bb mass shape
+  //  outside the signal region as cuts are applied
+  if (doSignalMassLast) {
+    int g = regions.addGroup("lep1,isotrk,nb2,metpresel,mtpresel,bbunblind");
+    addMassLast(regions, info, g, "sig_bbmasslast_", false);
+  }
+
+  // *** signal region, but applying met cut last
+  if (doSignalMETLast) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbwin,metpresel,mtpresel,unblind");
+    addRegion(regions, info, g, "sig_metlast_presel");
+    addMETLast(regions, info, g, "sig_metlast_", "nj2", true, false, false);
+  }
+
+  // *** signal region with 2 loose, 1 med and 1 med + 1 loose btags
+  const int nsigb = 3;
+  const bool dosigb[nsigb] = { doSignal2Loose, doSignal1Med, doSignal1Med1Loose };
+  const std::string sigbdir[nsigb] = { "sig_2loose_", "sig_1med_", "sig_1med1loose_" };
+  const std::string sigbtag[nsigb] = { "nbl2", "nb1", "nb1,nbl2" };
+  for (int i = 0; i < nsigb; ++i) {
+    if (!dosigb[i]) continue;
+    int g = regions.addGroup("lep1,isotrk," + sigbtag[i] + ",bbwin,metpresel,mtpresel,unblind");
+    const std::string& d = sigbdir[i];
+    addRegion(regions, info, g, d + "presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, d + "mt2bl_nm1", "nj2");
+      addRegion(regions, info, g, d + "mt_nm1", "nj2,mt2bl");
+      addRegion(regions, info, g, d + "met_nm1", "nj2,mt2bl,mt");
+      addRegion(regions, info, g, d + "met100", "nj2,mt2bl,mt,met100");
+      addRegion(regions, info, g, d + "met150", "nj2,mt2bl,mt,met100,met150");
+    }
+    addRegion(regions, info, g, d + "final", "nj2,mt2bl,mt,met100,met150,met");
+  }
+
+  // *** signal region with SMWH cuts:
+  //   >= 1 tight btag, met > 45, m(bb) window; then == 2 jets, pt(bb) > 100,
+  //   dphi(bb, W) > 2.95, pt(W) > 180, dphi(lep, met) < pi/2
+  if (doSignalSMWH) {
+    int g = regions.addGroup("lep1,isotrk,nb2,nbt1,bbwin,met45,unblind");
+    addRegion(regions, info, g, "sigsmwh_presel");
+    addRegion(regions, info, g, "sigsmwh_final", "nj2,smwh");
+  }
+
+  // *** CR1: 150 < m(bb) < 250
+  if (doCR1) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbcr1,metpresel,mtpresel");
+    addMTPeak(regions, info, g, "cr1_");
+  }
+
+  // *** CR1, MET last: m(bb) > 150
+  if (doCR1METLast) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbhigh,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr1_metlast_presel");
+    addMETLast(regions, info, g, "cr1_metlast_", "nj2", false, true, true);
+  }
+
+  // *** CR2: 1 lepton + iso track, i.e. inverted iso track (or tau) veto
+  if (doCR2) {
+    int g = regions.addGroup("lepisotrk,nb2,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr2_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr2_bbmass_nm1", "nj2");
+      addRegion(regions, info, g, "cr2_mt_nm1", "nj2,bbwin");
+      addRegion(regions, info, g, "cr2_mt2blfirst", "nj2,bbwin,mt2bl");
+    }
+    addRegion(regions, info, g, "cr2_met_nm1", "nj2,bbwin,mt");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr2_mt2blcut", "nj2,bbwin,mt,mt2bl");
+      addRegion(regions, info, g, "cr2_mt2bl_nm1", "nj2,bbwin,mt,met");
+    }
+    addRegion(regions, info, g, "cr2_final", "nj2,bbwin,mt,met,mt2bl", true);
+  }
+
+  // *** CR3: 2 leptons, no iso track veto; dilepton weight but for mt2blfirst
+  if (doCR3) {
+    int g = regions.addGroup("dilep,nb2,metpresel");
+    addRegion(regions, info, g, "cr3_presel", "", false, RW_2L);
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr3_bbmass_nm1", "nj2", false, RW_2L);
+      addRegion(regions, info, g, "cr3_mt_nm1", "nj2,bbwin", false, RW_2L);
+      addRegion(regions, info, g, "cr3_mt2blfirst", "nj2,bbwin,mt2bl");
+    }
+    addRegion(regions, info, g, "cr3_met_nm1", "nj2,bbwin,mt", false, RW_2L);
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr3_mt2blcut", "nj2,bbwin,mt,mt2bl", false, RW_2L);
+      addRegion(regions, info, g, "cr3_mt2bl_nm1", "nj2,bbwin,mt,met", false, RW_2L);
+    }
+    addRegion(regions, info, g, "cr3_final", "nj2,bbwin,mt,met,mt2bl", true, RW_2L);
+  }
+
+  // *** CR23: 1 lepton + iso track OR 2 leptons
+  if (doCR23) {
+    int g = regions.addGroup("lepisotrkordilep,nb2,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr23_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr23_bbmass_nm1", "nj2");
+      addRegion(regions, info, g, "cr23_mt_nm1", "nj2,bbwin");
+      addRegion(regions, info, g, "cr23_mt2blfirst", "nj2,bbwin,mt2bl");
+      addRegion(regions, info, g, "cr23_mt2bl_nm1", "nj2,bbwin,mt");
+      addRegion(regions, info, g, "cr23_metcut", "nj2,bbwin,mt,met");
+    }
+    addRegion(regions, info, g, "cr23_met_nm1", "nj2,bbwin,mt,mt2bl");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr23_met100", "nj2,bbwin,mt,mt2bl,met100");
+      addRegion(regions, info, g, "cr23_met125", "nj2,bbwin,mt,mt2bl,met100,met125");
+      addRegion(regions, info, g, "cr23_met150", "nj2,bbwin,mt,mt2bl,met100,met125,met150");
+    }
+    addRegion(regions, info, g, "cr23_final", "nj2,bbwin,mt,mt2bl,met100,met125,met150,met", true);
+  }
+
+  // *** CR23, mass last
+  if (doCR23MassLast) {
+    int g = regions.addGroup("lepisotrkordilep,nb2,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr23_bbmasslast_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr23_bbmasslast_mt_nm1", "nj2");
+      addRegion(regions, info, g, "cr23_bbmasslast_mt2bl_nm1", "nj2,mt");
+    }
+    addRegion(regions, info, g, "cr23_bbmasslast_met_nm1", "nj2,mt,mt2bl");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr23_bbmasslast_met100", "nj2,mt,mt2bl,met100");
+      addRegion(regions, info, g, "cr23_bbmasslast_met125", "nj2,mt,mt2bl,met100,met125");
+      addRegion(regions, info, g, "cr23_bbmasslast_met150", "nj2,mt,mt2bl,met100,met125,met150");
+      addRegion(regions, info, g, "cr23_bbmasslast_bbmass_nm1", "nj2,mt,mt2bl,met100,met125,met150,met");
+    }
+    addRegion(regions, info, g, "cr23_bbmasslast_final", "nj2,mt,mt2bl,met100,met125,met150,met,bbwin", true);
+  }
+
+  // *** CR4: 2 leptons, Z mass veto for same flavor, 150 < m(bb) < 250
+  if (doCR4) {
+    int g = regions.addGroup("dilep,zveto,nb2,bbcr1,metpresel");
+    addRegion(regions, info, g, "cr4_presel", "", false, RW_2L);
+    if (doNM1Plots) addRegion(regions, info, g, "cr4_mt2bl_nm1", "nj2", false, RW_2L);
+    addRegion(regions, info, g, "cr4_met_nm1", "nj2,mt2bl", false, RW_2L);
+    if (doNM1Plots) addRegion(regions, info, g, "cr4_mt_nm1", "nj2,mt2bl,met", false, RW_2L);
+    addRegion(regions, info, g, "cr4_final", "nj2,mt2bl,met,mt", true, RW_2L);
+  }
+
+  // *** CR5: require exactly 0 btags
+  if (doCR5) {
+    int g = regions.addGroup("lep1,isotrk,nb0,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr5_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr5_bbmass_nm1", "nj2");
+      addRegion(regions, info, g, "cr5_met_nm1", "nj2,bbwin");
+      addRegion(regions, info, g, "cr5_met100", "nj2,bbwin,met100");
+      addRegion(regions, info, g, "cr5_mt_nm1", "nj2,bbwin,met100,met");
+      addRegion(regions, info, g, "cr5_mt2bl_nm1", "nj2,bbwin,met100,met,mt");
+    }
+    addRegion(regions, info, g, "cr5_final", "nj2,bbwin,met100,met,mt,mt2bl");
+  }
+
+  // *** CR5 loose: no jet veto, no MT2bl, then MET > 500
+  if (doCR5Loose) {
+    int g = regions.addGroup("lep1,isotrk,nb0,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr5_loose_presel");
+    if (doNM1Plots) addRegion(regions, info, g, "cr5_loose_met_nm1", "mt");
+    addRegion(regions, info, g, "cr5_loose_final", "mt,met500");
+  }
+
+  // *** CR5, met last (bveto) and CR5, inverted mass: require exactly 0 btags
+  //  otherwise same as signal, met last
+  const int ncr5 = 2;
+  const bool docr5[ncr5] = { doCR5METLast, doCR5InvMass };
+  const std::string cr5dir[ncr5] = { "cr5_metlast_", "cr5_invmass_" };
+  const std::string cr5mass[ncr5] = { "nj2,bbwin", "nj2,bbinv" };
+  for (int i = 0; i < ncr5; ++i) {
+    if (!docr5[i]) continue;
+    int g = regions.addGroup("lep1,isotrk,nb0,metpresel,mtpresel");
+    addRegion(regions, info, g, cr5dir[i] + "presel");
+    if (doNM1Plots) addRegion(regions, info, g, cr5dir[i] + "bbmass_nm1", "nj2");
+    addMETLast(regions, info, g, cr5dir[i], cr5mass[i], true, false, false);
+  }
+
+  // *** CR5, high mass (m(bb) > 150) and low mass (m(bb) < 100), met last
+  const bool docr5m[ncr5] = { doCR5HighMass, doCR5LowMass };
+  const std::string cr5mdir[ncr5] = { "cr5_highmass_", "cr5_lowmass_" };
+  const std::string cr5mcut[ncr5] = { "bbhigh", "bblow" };
+  for (int i = 0; i < ncr5; ++i) {
+    if (!docr5m[i]) continue;
+    int g = regions.addGroup("lep1,isotrk,nb0," + cr5mcut[i] + ",metpresel,mtpresel");
+    addRegion(regions, info, g, cr5mdir[i] + "presel");
+    addMETLast(regions, info, g, cr5mdir[i], "nj2", false, false, false);
+  }
+
+  // *** CR5 (bveto), but applying m(bb) cut last
+  if (doCR5MassLast) {
+    int g = regions.addGroup("lep1,isotrk,nb0,metpresel,mtpresel");
+    addMassLast(regions, info, g, "cr5_bbmasslast_", true);
+  }
+
+  // *** CR6: exactly 1 btag, veto on 2nd loose btag
+  if (doCR6) {
+    int g = regions.addGroup("lep1,isotrk,nbeq1,nbleq1,bbwin,metpresel");
+    addMETFirst(regions, info, g, "cr6_", "nj2");
+  }
+
+  // *** CR6, met last
+  if (doCR6METLast) {
+    int g = regions.addGroup("lep1,isotrk,nbeq1,nbleq1,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr6_metlast_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr6_metlast_bbmass_nm1", "nj2");
+      addRegion(regions, info, g, "cr6_metlast_mt2bl_nm1", "nj2,bbwin");
+      addRegion(regions, info, g, "cr6_metlast_mt_nm1", "nj2,bbwin,mt2bl");
+      addRegion(regions, info, g, "cr6_metlast_met_nm1", "nj2,bbwin,mt2bl,mt");
+      addRegion(regions, info, g, "cr6_metlast_met100", "nj2,bbwin,mt2bl,mt,met100");
+      addRegion(regions, info, g, "cr6_metlast_met150", "nj2,bbwin,mt2bl,mt,met100,met150");
+    }
+    addRegion(regions, info, g, "cr6_metlast_final", "nj2,bbwin,mt2bl,mt,met100,met150,met");
+  }
+
+  // *** CR7: 150 < m(bb) < 250, exactly 3 jets
+  if (doCR7) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbcr1,metpresel,mtpresel");
+    addMETFirst(regions, info, g, "cr7_", "nj3");
+  }
+
+  // *** CR8: 50 < m(bb) < 100
+  if (doCR8) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbcr8,metpresel,mtpresel");
+    addMETFirst(regions, info, g, "cr8_", "nj2");
+  }
+
+  // *** CR8, MET last: m(bb) < 100
+  if (doCR8METLast) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bblow,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr8_metlast_presel");
+    addMETLast(regions, info, g, "cr8_metlast_", "nj2", false, true, true);
+  }
+
+  // *** CR9: 150 < m(bb) < 200, to study met shape disagreement in CR1
+  if (doCR9) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbcr9,metpresel,mtpresel");
+    addMTPeak(regions, info, g, "cr9_");
+  }
+
+  // *** CR10: 200 < m(bb) < 250
+  if (doCR10) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbcr10,metpresel,mtpresel");
+    addMETFirst(regions, info, g, "cr10_", "nj2");
+  }
+
+  // *** CR11: exactly 0 btags, 150 < m(bb) < 250
+  if (doCR11) {
+    int g = regions.addGroup("lep1,isotrk,nb0,bbcr1,metpresel,mtpresel");
+    addMETFirst(regions, info, g, "cr11_", "nj2");
+  }
+
+  // *** CR12: at least 4 jets, then 150 < m(bb) < 250
+  if (doCR12) {
+    int g = regions.addGroup("lep1,isotrk,nj4,nb2,metpresel,mtpresel");
+    addMETFirst(regions, info, g, "cr12_", "bbcr1");
+  }
+
+  // *** CR13: MT peak region, 50 < mt <= 100
+  //  the old code had two identical CR13 cut flows filling the same
+  //  histograms, so every event went in twice
+  if (doCR13) {
+    int g = regions.addGroup("lep1,isotrk,nb2,metpresel,mtcr13");
+    unsigned int first = info.size();
+    addRegion(regions, info, g, "cr13_presel");
+    if (doNM1Plots) {
+      addRegion(regions, info, g, "cr13_bbmass_nm1", "nj2");
+      addRegion(regions, info, g, "cr13_mt2bl_nm1", "nj2,bbwin");
+      addRegion(regions, info, g, "cr13_met_nm1", "nj2,bbwin,mt2bl");
+      addRegion(regions, info, g, "cr13_met100", "nj2,bbwin,mt2bl,met100");
+      addRegion(regions, info, g, "cr13_met150", "nj2,bbwin,mt2bl,met100,met150");
+    }
+    addRegion(regions, info, g, "cr13_final", "nj2,bbwin,mt2bl,met100,met150,met");
+    for (unsigned int r = first; r < info.size(); ++r) info[r].fills = 2;
+  }
+
+  // *** CR14: inverted m(bb) cut
+  //  otherwise same as signal region, met last
+  if (doCR14) {
+    int g = regions.addGroup("lep1,isotrk,nb2,bbinv,metpresel,mtpresel");
+    addRegion(regions, info, g, "cr14_presel");
+    addMETLast(regions, info, g, "cr14_", "nj2", true, true, true);
+  }
+
+  // *** Stop presel region, >= 1 lepton, >= 4 jets, MC only
+  //  then >= 1 bjet, met >= 150, mt > 120, iso track veto v4, tau veto;
+  //  weight without the vertex reweighting
+  if (doStopSel) {
+    int g = regions.addGroup("lep1,njets4,mc");
+    addRegion(regions, info, g, "stop_presel", "", false, RW_NOVTX);
+    addRegion(regions, info, g, "stop_met_nm1", "nb1", false, RW_NOVTX);
+    addRegion(regions, info, g, "stop_mt_nm1", "nb1,met150ge", false, RW_NOVTX);
+    addRegion(regions, info, g, "stop_isotrk_nm1", "nb1,met150ge,mt120", false, RW_NOVTX);
+    addRegion(regions, info, g, "stop_tauveto_nm1", "nb1,met150ge,mt120,isotrkv4", false, RW_NOVTX);
+    addRegion(regions, info, g, "stop_comp", "nb1,met150ge,mt120,isotrkv4,tauveto", false, RW_NOVTX);
+  }
+
+}
+
+//--------------------------------------------------------------------
+
+void setRegionCuts(RegionSelector& regions, const WHRegionInputs& in) {
+
+  const float bbmass = in.bbmass;
+  const float met = in.met;
+  const float mt = in.mt;
+
+  regions.newEvent();
+  regions.set(RC_LEP1, in.lep1);
+  regions.set(RC_ISOTRK, in.isotrk);
+  regions.set(RC_NJETS2, in.njets >= 2);
+  regions.set(RC_NB0, in.nbjets == 0);
+  regions.set(RC_NB1, in.nbjets >= 1);
+  regions.set(RC_NB2, in.nbjets >= 2);
+  regions.set(RC_BBWIN, (bbmass > CUT_BBMASS_LOW) && (bbmass < CUT_BBMASS_HIGH));
+  regions.set(RC_BBINV, (bbmass < CUT_BBMASS_LOW) || (bbmass > CUT_BBMASS_HIGH));
+  regions.set(RC_UNBLIND, !in.isData || !blindSignal);
+  // m(bb) last: remove mass window in data, so we can compare bb mass shape outside signal region as cuts are applied
+  regions.set(RC_BBUNBLIND, !(in.isData && blindSignal && (bbmass > CUT_BBMASS_LOW) && (bbmass < CUT_BBMASS_CR1_LOW)));
+  regions.set(RC_METPRESEL, met > CUT_MET_PRESEL);
+  regions.set(RC_MTPRESEL, mt > CUT_MT_PRESEL);
+  regions.set(RC_NJ2, in.njetsall == 2);
+  regions.set(RC_MTPEAK, (mt > 50.) && (mt < 80.));
+  regions.set(RC_MT, mt > CUT_MT);
+  regions.set(RC_MET, met > CUT_MET);
+  regions.set(RC_MT2BL, in.mt2bl > CUT_MT2BL);
+  regions.set(RC_MET100, met > 100.);
+  regions.set(RC_MET125, met > 125.);
+  regions.set(RC_MET137, met > 137.);
+  regions.set(RC_MET150, met > 150.);
+  regions.set(RC_MET162, met > 162.);
+  regions.set(RC_MET175, met > 175.);
+  regions.set(RC_MET50TO75, (met > 50.) && (met <= 75.));
+  regions.set(RC_MET75TO100, (met > 75.) && (met <= 100.));
+  regions.set(RC_MET100TO125, (met > 100.) && (met <= 125.));
+  regions.set(RC_MET125TO150, (met > 125.) && (met <= 150.));
+  regions.set(RC_MET150TO175, (met > 150.) && (met <= 175.));
+  regions.set(RC_NBEQ1, in.nbjets == 1);
+  regions.set(RC_NBLEQ1, in.nbjetsl == 1);
+  regions.set(RC_NBL2, in.nbjetsl >= 2);
+  regions.set(RC_NBT1, in.nbjetst >= 1);
+  regions.set(RC_BBCR1, (bbmass > CUT_BBMASS_CR1_LOW) && (bbmass < CUT_BBMASS_CR1_HIGH));
+  regions.set(RC_BBHIGH, bbmass > CUT_BBMASS_CR1_LOW);
+  regions.set(RC_BBLOW, bbmass < CUT_BBMASS_CR8_HIGH);
+  regions.set(RC_BBCR8, (bbmass > CUT_BBMASS_CR8_LOW) && (bbmass < CUT_BBMASS_CR8_HIGH));
+  regions.set(RC_BBCR9, (bbmass > CUT_BBMASS_CR1_LOW) && (bbmass < 200.));
+  regions.set(RC_BBCR10, (bbmass > 200.) && (bbmass < 250.));
+  regions.set(RC_LEPISOTRK, in.lepisotrk);
+  regions.set(RC_DILEP, in.dilep);
+  regions.set(RC_LEPISOTRKORDILEP, in.lepisotrk || in.dilep);
+  regions.set(RC_ZVETO, abs(in.id1) != abs(in.id2) || fabs(in.dilmass - 91.) > 15.);
+  regions.set(RC_NJ3, in.njetsall == 3);
+  regions.set(RC_NJ4, in.njetsall >= 4);
+  regions.set(RC_MET45, met > 45.);
+  regions.set(RC_SMWH, (in.bbpt > 100.) && (in.bbwdphi > 2.95) && (in.wpt > 180.) && (in.lepmetdphi < M_PI/2.));
+  regions.set(RC_MET500, met > 500.);
+  regions.set(RC_MTCR13, (mt > CUT_MT_CR13_LOW) && (mt <= CUT_MT_CR13_HIGH));
+  regions.set(RC_MC, !in.isData);
+  regions.set(RC_NJETS4, in.njets >= 4);
+  regions.set(RC_MET150GE, met >= 150.);
+  regions.set(RC_MT120, mt > 120.);
+  regions.set(RC_ISOTRKV4, in.isotrkv4);
+  regions.set(RC_TAUVETO, in.tauveto);
+
+}
+
+//--------------------------------------------------------------------
+
+std::vector<std::string> allRegionNames() {
+
+  bool* flags[] = { &doNM1Plots, &doMetBinRegions, &doInclusive, &doSignal, &doSignalMassLast,
+		    &doSignalMETLast, &doCR5METLast, &doCR5InvMass, &doCR5MassLast, &doCR14,
+		    &doCR1METLast, &doCR23, &doCR23MassLast, &doCR5HighMass, &doCR5LowMass,
+		    &doCR8METLast, &doInclusiveMTTail, &doSignal2Loose, &doSignal1Med,
+		    &doSignal1Med1Loose, &doSignalSMWH, &doCR1, &doCR2, &doCR3, &doCR4, &doCR5,
+		    &doCR5Loose, &doCR6, &doCR6METLast, &doCR7, &doCR8, &doCR9, &doCR10, &doCR11,
+		    &doCR12, &doCR13, &doStopSel };
+  const int nflags = sizeof(flags)/sizeof(flags[0]);
+
+  // declare with all flags on, then put them back
+  std::vector<bool> saved(nflags);
+  for (int i = 0; i < nflags; ++i) {
+    saved[i] = *flags[i];
+    *flags[i] = true;
+  }
+  RegionSelector regions;
+  std::vector<WHRegionInfo> info;
+  declareRegions(regions, info);
+  for (int i = 0; i < nflags; ++i) *flags[i] = saved[i];
+
+  std::vector<std::string> names;
+  for (int r = 0; r < regions.nRegions(); ++r) names.push_back(regions.name(r));
+  std::sort(names.begin(), names.end());
+  return names;
+}
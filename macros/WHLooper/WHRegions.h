@@ -0,0 +1,114 @@
+#ifndef WHREGIONS_H
+#define WHREGIONS_H
+
+#include <string>
+#include <vector>
+
+class RegionSelector;
+
+// regions to do and their n-1 / met bin plots: defaults, which a run config
+//  given to WHLooper::readConfig can change (see configFlags in WHLooper.cc)
+extern bool doNM1Plots;
+extern bool doMetBinRegions;
+
+// regions to do: need for signal region prediction/plots etc
+extern bool doInclusive;
+extern bool doSignal;
+extern bool doSignalMassLast;
+extern bool doSignalMETLast;
+extern bool doCR5METLast; // bveto
+extern bool doCR5InvMass; // bveto, inverted m(bb)
+extern bool doCR5MassLast; // bveto, mass last
+extern bool doCR14; // inverted mbb region
+
+// regions to do: need for CR results/plots
+extern bool doCR1METLast; // high m(bb), met cut last
+extern bool doCR23; // dilep + (lep+track)
+extern bool doCR23MassLast; // dilep + (lep+track)
+extern bool doCR5HighMass; // bveto, high mass
+extern bool doCR5LowMass; // bveto, low mass
+extern bool doCR8METLast; // low m(bb)
+
+// regions not really used
+extern bool doInclusiveMTTail;
+extern bool doSignal2Loose;
+extern bool doSignal1Med;
+extern bool doSignal1Med1Loose;
+extern bool doSignalSMWH;
+extern bool doCR1; // high m(bb)
+extern bool doCR2; // lep + track
+extern bool doCR3; // dilep
+extern bool doCR4; // dilep, high m(bb)
+extern bool doCR5; // bveto
+extern bool doCR5Loose; // bveto, looser
+extern bool doCR6; // 1 btag -- not used
+extern bool doCR6METLast; // 1 btag -- not used
+extern bool doCR7; // high m(bb), 3 jets
+extern bool doCR8; // low m(bb)
+extern bool doCR9; // high m(bb), 150-200
+extern bool doCR10; // high m(bb), 200-250
+extern bool doCR11; // bveto, high m(bb)
+extern bool doCR12; // high m(bb), 4+ jets
+extern bool doCR13; // mt bulk
+extern bool doStopSel;
+
+const bool blindSignal = false;
+
+// main cut values
+const float CUT_BBMASS_LOW = 100.0;
+//  const float CUT_BBMASS_HIGH = 140.0;
+const float CUT_BBMASS_HIGH = 150.0;
+const float CUT_BBMASS_CR1_LOW = 150.0;
+const float CUT_BBMASS_CR1_HIGH = 250.0;
+const float CUT_BBMASS_CR8_LOW = 50.0;
+const float CUT_BBMASS_CR8_HIGH = 100.0;
+const float CUT_MET_PRESEL = 50.0;
+//  const float CUT_MET_PRESEL = 100.0;
+const float CUT_MET = 175.0;
+//  const float CUT_MT_PRESEL = 50.0;
+const float CUT_MT_PRESEL = 0.0;
+const float CUT_MT = 100.0;
+const float CUT_MT_CR13_LOW = 50.0;
+const float CUT_MT_CR13_HIGH = 100.0;
+const float CUT_MT2BL = 200.0;
+
+// what the region cuts look at, filled by WHLooper::loop for each event
+struct WHRegionInputs {
+  bool isData;
+  // passSingleLeptonSelection, passisotrk (iso track, tau and 2nd lepton
+  //  vetoes), passLepPlusIsoTrkSelectionWHMet, passDileptonSelection
+  bool lep1, isotrk, lepisotrk, dilep;
+  // passIsoTrkVeto_v4, passTauVeto
+  bool isotrkv4, tauveto;
+  int id1, id2;
+  float dilmass;
+  int njets, njetsall, nbjets, nbjetsl, nbjetst;
+  // bb_.M(), bb_.pt()
+  float bbmass, bbpt;
+  float bbwdphi, wpt, lepmetdphi;
+  float met, mt, mt2bl;
+};
+
+// weight a region is filled with
+enum WHRegionWeight { RW_1L, RW_2L, RW_NOVTX };
+
+// how the looper fills a region of declareRegions
+struct WHRegionInfo {
+  WHRegionWeight weight;
+  // output dir made and saved, but only filled with the n-1 plots
+  bool nm1Only;
+  // fills per selected event
+  int fills;
+};
+
+// every region of the enabled families, one info per region; each region is
+//  the presel of its family plus the cuts applied before it in the original
+//  cut sequence
+void declareRegions(RegionSelector& regions, std::vector<WHRegionInfo>& info);
+// sets the cuts of declareRegions for one event
+void setRegionCuts(RegionSelector& regions, const WHRegionInputs& in);
+// names of the regions declareRegions makes with every region flag,
+//  doNM1Plots and doMetBinRegions on, sorted
+std::vector<std::string> allRegionNames();
+
+#endif
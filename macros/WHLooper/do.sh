@@ -1,6 +1,8 @@
 #!/bin/bash
 
 OUTDIR=V24_cr5_loose_v2
+# run config with the regions and histograms to make, empty for the defaults in WHLooper.cc
+CONFIG=
 
 #declare -a Samples=(ttsl ttdl tsl tdl wjets wbb others tchiwh data wino ttsl_powheg ttdl_powheg)
 #declare -a Samples=(ttsl ttdl tsl tdl wjets wbb others tchiwhmg)
@@ -26,7 +28,12 @@ declare -a Samples=(ttsl ttdl tsl tdl wjets wbb others data)
 
 mkdir -p output/${OUTDIR}
 
+# one task per sample; ../runTasks.py -h for the concurrency, memory and
+# retry options, logs and the summary go to output/${OUTDIR}/log
+MANIFEST=output/${OUTDIR}/tasks.txt
+: > $MANIFEST
 for SAMPLE in ${Samples[@]};
-  do echo root -b -q -l doAll.C\(\"${SAMPLE}\",\"${OUTDIR}\"\)
-  nohup root -b -q -l doAll.C\(\"${SAMPLE}\",\"${OUTDIR}\"\) > log_${SAMPLE}.txt 2<&1 &
-done
\ No newline at end of file
+  do echo "${SAMPLE} 1 - root -b -q -l doAll.C\(\\\"${SAMPLE}\\\",\\\"${OUTDIR}\\\",\\\"${CONFIG}\\\"\)" >> $MANIFEST
+done
+
+../runTasks.py -l output/${OUTDIR}/log $MANIFEST
@@ -0,0 +1,271 @@
+#!/usr/bin/env python
+#
+# Runs the jobs of a task manifest on the local machine, replacing the
+# "nohup root ... &" loops of the do.sh scripts.
+#
+#   runTasks.py [options] <manifest>
+#
+# One task per manifest line, lines starting with '#' are comments:
+#
+#   <name> <cost> <memory MB or -> <command ...>
+#
+# The cost is anything proportional to the run time (input bytes, events);
+# tasks start largest first, which keeps the slowest jobs from starting
+# last. A task starts when a core is free and its memory fits both in the
+# budget (what the running tasks were declared with) and in the memory
+# the system reports available. Failed tasks are retried. The output of
+# each task goes to <logdir>/<name>.log; wall time, peak RSS and exit code
+# of every attempt go to <logdir>/summary.txt.
+#
+# Each command runs in a shell of its own process group, so compound
+# commands work as typed, and a task that exceeds --timeout, or every
+# running task when runTasks is interrupted, is stopped as a whole group.
+#
+
+from __future__ import print_function
+
+import optparse
+import os
+import signal
+import subprocess
+import sys
+import time
+
+
+def meminfo(key):
+    # kB from /proc/meminfo, None where there is none
+    try:
+        for line in open('/proc/meminfo'):
+            if line.startswith(key + ':'):
+                return int(line.split()[1])
+    except IOError:
+        pass
+    return None
+
+
+def ncores():
+    try:
+        return os.sysconf('SC_NPROCESSORS_ONLN')
+    except (ValueError, OSError, AttributeError):
+        return 1
+
+
+class Task(object):
+    def __init__(self, name, cost, memory, command):
+        self.name = name
+        self.cost = cost
+        self.memory = memory    # MB
+        self.command = command
+        self.attempts = []      # (exit code, wall s, peak RSS MB)
+
+
+def readManifest(filename, defaultMemory):
+    tasks = []
+    names = set()
+    for n, line in enumerate(open(filename)):
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        fields = line.split(None, 3)
+        if len(fields) < 4:
+            sys.exit('[runTasks] %s:%d: expected <name> <cost> <memory> <command>' % (filename, n + 1))
+        name, cost, memory, command = fields
+        if name in names:
+            sys.exit('[runTasks] %s:%d: task %s appears twice' % (filename, n + 1, name))
+        names.add(name)
+        memory = defaultMemory if memory == '-' else float(memory)
+        tasks.append(Task(name, float(cost), memory, command))
+    return tasks
+
+
+class Cancelled(Exception):
+    pass
+
+
+def cancel(signum, frame):
+    raise Cancelled()
+
+
+def start(task, logdir):
+    log = open(os.path.join(logdir, task.name + '.log'), 'a')
+    log.write('### attempt %d: %s\n' % (len(task.attempts) + 1, task.command))
+    log.flush()
+    # the shell leads a new process group, its pid is the group id; wait4
+    # on the shell includes the peak RSS of the commands it waited for
+    if sys.version_info >= (3, 2):
+        session = {'start_new_session': True}
+    else:
+        session = {'preexec_fn': os.setsid}
+    proc = subprocess.Popen(task.command, shell=True, stdout=log, stderr=subprocess.STDOUT, **session)
+    log.close()
+    return proc
+
+
+def exitCode(status):
+    return os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+
+
+def killGroup(proc, sig):
+    try:
+        os.killpg(proc.pid, sig)
+    except OSError:
+        pass    # already gone
+
+
+def run(tasks, options):
+
+    budget = options.memory
+    if budget is None:
+        total = meminfo('MemTotal')
+        budget = 0.9 * total / 1024. if total else float('inf')
+
+    # largest first; stable, so equal costs keep the manifest order
+    queue = sorted(tasks, key=lambda t: -t.cost)
+    for task in queue:
+        if task.memory > budget:
+            sys.exit('[runTasks] task %s needs %.0f MB, the budget is %.0f MB' % (task.name, task.memory, budget))
+
+    # pid -> [task, start time, Popen, time of the timeout kill]; the Popen
+    # is kept so that it is not collected, which would make subprocess reap
+    # the job behind our back
+    running = {}
+    t0 = time.time()
+    print('[runTasks] %d tasks, %d slots, %.0f MB' % (len(queue), options.jobs, budget))
+
+    # also when started in the background, where SIGINT comes ignored
+    signal.signal(signal.SIGINT, cancel)
+    signal.signal(signal.SIGTERM, cancel)
+    try:
+        schedule(queue, running, budget, options)
+    except (Cancelled, KeyboardInterrupt):
+        signal.signal(signal.SIGINT, signal.SIG_IGN)
+        signal.signal(signal.SIGTERM, signal.SIG_IGN)
+        print('[runTasks] cancelled, stopping %d running tasks' % len(running))
+        for job in running.values():
+            killGroup(job[2], signal.SIGTERM)
+        deadline = time.time() + 30
+        while running:
+            pid, status, usage = os.wait4(-1, os.WNOHANG)
+            if pid == 0:
+                if time.time() > deadline:
+                    for job in running.values():
+                        killGroup(job[2], signal.SIGKILL)
+                time.sleep(0.2)
+                continue
+            if pid in running:
+                task, started, proc, killed = running.pop(pid)
+                proc.returncode = exitCode(status)
+                task.attempts.append((proc.returncode, time.time() - started, usage.ru_maxrss / 1024.))
+
+    return time.time() - t0
+
+
+def schedule(queue, running, budget, options):
+
+    # with a timeout the jobs are polled, otherwise waited for
+    waitFlags = os.WNOHANG if options.timeout else 0
+
+    while queue or running:
+
+        # start what fits, in queue order
+        used = sum(r[0].memory for r in running.values())
+        for task in list(queue):
+            if len(running) >= options.jobs:
+                break
+            available = meminfo('MemAvailable')
+            if used + task.memory > budget:
+                continue
+            if available is not None and task.memory > available / 1024. and running:
+                continue
+            queue.remove(task)
+            proc = start(task, options.logdir)
+            running[proc.pid] = [task, time.time(), proc, None]
+            used += task.memory
+            print('[runTasks] start  %-30s (%d running, %d queued)' % (task.name, len(running), len(queue)))
+
+        if not running:
+            break
+
+        pid, status, usage = os.wait4(-1, waitFlags)
+        if pid == 0:
+            checkTimeouts(running, options.timeout)
+            time.sleep(0.5)
+            continue
+        if pid not in running:
+            continue
+        task, started, proc, killed = running.pop(pid)
+        code = exitCode(status)
+        proc.returncode = code
+        wall = time.time() - started
+        rss = usage.ru_maxrss / 1024.    # kB on Linux
+        task.attempts.append((code, wall, rss))
+
+        if code == 0:
+            print('[runTasks] done   %-30s %8.0f s %8.0f MB' % (task.name, wall, rss))
+        elif len(task.attempts) <= options.retries:
+            print('[runTasks] FAILED %-30s exit %d, retrying' % (task.name, code))
+            queue.append(task)
+            queue.sort(key=lambda t: -t.cost)
+        else:
+            print('[runTasks] FAILED %-30s exit %d, giving up' % (task.name, code))
+
+
+def checkTimeouts(running, timeout):
+    # SIGTERM at the timeout, SIGKILL if the group is still there 30 s later
+    now = time.time()
+    for job in running.values():
+        task, started, proc, killed = job
+        if killed is None and now - started > timeout:
+            print('[runTasks] TIMEOUT %-29s after %.0f s, stopping it' % (task.name, now - started))
+            killGroup(proc, signal.SIGTERM)
+            job[3] = now
+        elif killed is not None and now - killed > 30:
+            killGroup(proc, signal.SIGKILL)
+
+
+def summary(tasks, makespan, out):
+    out.write('%-30s %8s %8s %10s %10s\n' % ('task', 'status', 'attempts', 'wall [s]', 'RSS [MB]'))
+    nfailed = 0
+    busy = 0.
+    for task in tasks:
+        ok = task.attempts and task.attempts[-1][0] == 0
+        if not ok:
+            nfailed += 1
+        status = 'ok' if ok else ('not run' if not task.attempts else 'exit %d' % task.attempts[-1][0])
+        wall = sum(a[1] for a in task.attempts)
+        rss = max([a[2] for a in task.attempts] or [0])
+        busy += wall
+        out.write('%-30s %8s %8d %10.0f %10.0f\n' % (task.name, status, len(task.attempts), wall, rss))
+    out.write('\n%d tasks, %d failed, makespan %.0f s, %.0f task-seconds\n' % (len(tasks), nfailed, makespan, busy))
+    return nfailed
+
+
+def main():
+    parser = optparse.OptionParser(usage='%prog [options] <manifest>')
+    parser.add_option('-j', '--jobs', type='int', default=ncores(), help='parallel tasks [number of cores]')
+    parser.add_option('-m', '--memory', type='float', help='memory budget in MB [90% of the machine]')
+    parser.add_option('--task-memory', type='float', default=1000., help='MB for tasks declared with - [%default]')
+    parser.add_option('-r', '--retries', type='int', default=1, help='retries of a failed task [%default]')
+    parser.add_option('-t', '--timeout', type='float', help='seconds before a task is stopped [none]')
+    parser.add_option('-l', '--logdir', default='log', help='task logs and summary [%default]')
+    options, args = parser.parse_args()
+    if len(args) != 1:
+        parser.error('one manifest expected')
+
+    tasks = readManifest(args[0], options.task_memory)
+    if not os.path.isdir(options.logdir):
+        os.makedirs(options.logdir)
+
+    makespan = run(tasks, options)
+
+    filename = os.path.join(options.logdir, 'summary.txt')
+    out = open(filename, 'w')
+    nfailed = summary(tasks, makespan, out)
+    out.close()
+    sys.stdout.write(open(filename).read())
+    print('[runTasks] summary in %s' % filename)
+    return 1 if nfailed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())